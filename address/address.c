@@ -1073,7 +1073,7 @@ size_t mutt_addr_write(struct Buffer *buf, struct Address *addr, bool display)
     }
     else
     {
-      buf_addstr(buf, buf_string(addr->personal));
+      buf_addbuf(buf, addr->personal);
     }
 
     buf_addch(buf, ' ');
@@ -68,6 +68,25 @@ static void address_destroy(const struct ConfigSet *cs, void *var, const struct
   mutt_addr_free(a);
 }
 
+/**
+ * address_equal - Compare two Address objects
+ * @param a First Address
+ * @param b Second Address
+ * @retval true They are identical
+ *
+ * Unlike mutt_addr_cmp(), the personal name matters too - setting the same
+ * mailbox with a different display name is still a change.
+ */
+static bool address_equal(const struct Address *a, const struct Address *b)
+{
+  if (a == b)
+    return true;
+  if (!a || !b)
+    return false;
+
+  return buf_str_equal(a->personal, b->personal) && buf_str_equal(a->mailbox, b->mailbox);
+}
+
 /**
  * address_string_set - Set an Address by string - Implements ConfigSetType::string_set() - @ingroup cfg_type_string_set
  */
@@ -99,6 +118,12 @@ static int address_string_set(const struct ConfigSet *cs, void *var, struct Conf
 
   if (var)
   {
+    if (address_equal(addr, *(struct Address **) var))
+    {
+      address_destroy(cs, &addr, cdef);
+      return rc | CSR_SUC_NO_CHANGE;
+    }
+
     if (cdef->validator)
     {
       rc = cdef->validator(cs, cdef, (intptr_t) addr, err);
@@ -179,6 +204,9 @@ static int address_native_set(const struct ConfigSet *cs, void *var,
                               const struct ConfigDef *cdef, intptr_t value,
                               struct Buffer *err)
 {
+  if (address_equal((const struct Address *) value, *(struct Address **) var))
+    return CSR_SUCCESS | CSR_SUC_NO_CHANGE;
+
   int rc;
 
   if (cdef->validator)
@@ -226,6 +254,14 @@ static int address_reset(const struct ConfigSet *cs, void *var,
 
   int rc = CSR_SUCCESS;
 
+  if (address_equal(a, *(struct Address **) var))
+  {
+    if (!a)
+      rc |= CSR_SUC_EMPTY;
+    address_destroy(cs, &a, cdef);
+    return rc | CSR_SUC_NO_CHANGE;
+  }
+
   if (cdef->validator)
   {
     rc = cdef->validator(cs, cdef, (intptr_t) a, err);
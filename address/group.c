@@ -54,6 +54,7 @@ static void group_free(struct Group **ptr)
   struct Group *g = *ptr;
 
   mutt_addrlist_clear(&g->al);
+  mutt_hash_free(&g->ht);
   mutt_regexlist_free(&g->rs);
   FREE(&g->name);
 
@@ -72,6 +73,7 @@ static struct Group *group_new(const char *pat)
   struct Group *g = mutt_mem_calloc(1, sizeof(struct Group));
 
   g->name = mutt_str_dup(pat);
+  g->ht = mutt_hash_new(127, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
   STAILQ_INIT(&g->rs);
   TAILQ_INIT(&g->al);
 
@@ -233,6 +235,8 @@ static void group_add_addrlist(struct Group *g, const struct AddressList *al)
   {
     TAILQ_REMOVE(&al_new, a, entries);
     mutt_addrlist_append(&g->al, a);
+    if (a->mailbox && !mutt_hash_find_elem(g->ht, buf_string(a->mailbox)))
+      mutt_hash_insert(g->ht, buf_string(a->mailbox), a);
   }
   ASSERT(TAILQ_EMPTY(&al_new));
 }
@@ -298,6 +302,8 @@ int mutt_grouplist_remove_addrlist(struct GroupList *gl, struct AddressList *al)
     struct Address *a = NULL;
     TAILQ_FOREACH(a, al, entries)
     {
+      while (mutt_hash_find_elem(gnp->group->ht, buf_string(a->mailbox)))
+        mutt_hash_delete(gnp->group->ht, buf_string(a->mailbox), NULL);
       mutt_addrlist_remove(&gnp->group->al, buf_string(a->mailbox));
     }
     if (empty_group(gnp->group))
@@ -372,14 +378,11 @@ bool mutt_group_match(struct Group *g, const char *s)
   if (!g || !s)
     return false;
 
+  // Every Address in Group.al is indexed in the hash, so no list walk is needed
+  if (mutt_hash_find_elem(g->ht, s))
+    return true;
   if (mutt_regexlist_match(&g->rs, s))
     return true;
-  struct Address *a = NULL;
-  TAILQ_FOREACH(a, &g->al, entries)
-  {
-    if (a->mailbox && mutt_istr_equal(s, buf_string(a->mailbox)))
-      return true;
-  }
 
   return false;
 }
@@ -38,6 +38,7 @@
 struct Group
 {
   struct AddressList al; ///< List of Addresses
+  struct HashTable *ht;  ///< Hash Table: "mailbox" -> Address, for exact lookups into Group.al
   struct RegexList rs;   ///< Group Regex patterns
   char *name;            ///< Name of Group
 };
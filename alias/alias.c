@@ -57,6 +57,7 @@
 #include "globals.h"
 #include "maillist.h"
 #include "muttlib.h"
+#include "names.h"
 #include "reverse.h"
 
 struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases); ///< List of all the user's email aliases
@@ -509,6 +510,7 @@ retry_name:
   }
 
   alias_reverse_add(alias);
+  alias_names_add(alias);
   TAILQ_INSERT_TAIL(&Aliases, alias, entries);
 
   const char *const c_alias_file = cs_subset_path(sub, "alias_file");
@@ -714,6 +716,7 @@ void aliaslist_clear(struct AliasList *al)
 void alias_init(void)
 {
   alias_reverse_init();
+  alias_names_init();
 }
 
 /**
@@ -727,5 +730,6 @@ void alias_cleanup(void)
     alias_reverse_delete(np);
   }
   aliaslist_clear(&Aliases);
+  alias_names_shutdown();
   alias_reverse_shutdown();
 }
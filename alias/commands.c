@@ -39,6 +39,7 @@
 #include "lib.h"
 #include "parse/lib.h"
 #include "alias.h"
+#include "names.h"
 #include "reverse.h"
 
 /**
@@ -197,6 +198,7 @@ enum CommandResult parse_alias(struct Buffer *buf, struct Buffer *s,
     /* create a new alias */
     tmp = alias_new();
     tmp->name = name;
+    alias_names_add(tmp);
     TAILQ_INSERT_TAIL(&Aliases, tmp, entries);
     event = NT_ALIAS_ADD;
   }
@@ -264,6 +266,7 @@ enum CommandResult parse_unalias(struct Buffer *buf, struct Buffer *s,
       }
 
       aliaslist_clear(&Aliases);
+      alias_names_clear();
       return MUTT_CMD_SUCCESS;
     }
 
@@ -274,6 +277,7 @@ enum CommandResult parse_unalias(struct Buffer *buf, struct Buffer *s,
 
       TAILQ_REMOVE(&Aliases, np, entries);
       alias_reverse_delete(np);
+      alias_names_delete(np);
       alias_free(&np);
       break;
     }
@@ -105,6 +105,9 @@ static struct ConfigDef AliasVars[] = {
   { "sort_alias", DT_SORT|D_SORT_REVERSE, SORT_ALIAS, IP SortAliasMethods, NULL,
     "Sort method for the alias menu"
   },
+  { "query_cache_dir", DT_PATH|D_PATH_DIR, 0, 0, NULL,
+    "Directory for cached $query_command results"
+  },
   { "query_command", DT_STRING|D_STRING_COMMAND, 0, 0, NULL,
     "External command to query and external address book"
   },
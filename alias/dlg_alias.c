@@ -93,6 +93,7 @@
 #include "functions.h"
 #include "gui.h"
 #include "mutt_logging.h"
+#include "names.h"
 
 const struct ExpandoRenderData AliasRenderData[];
 
@@ -450,9 +451,14 @@ int alias_complete(struct Buffer *buf, struct ConfigSubset *sub)
 
   if (buf_at(buf, 0) != '\0')
   {
-    TAILQ_FOREACH(np, &Aliases, entries)
+    /* The name index finds the matches with a binary search,
+     * rather than testing every Alias on every keystroke */
+    size_t first = 0;
+    const size_t matches = alias_names_prefix(buf_string(buf), &first);
+    for (size_t m = 0; m < matches; m++)
     {
-      if (np->name && mutt_strn_equal(np->name, buf_string(buf), buf_len(buf)))
+      np = alias_names_get(first + m);
+      if (mutt_strn_equal(np->name, buf_string(buf), buf_len(buf)))
       {
         if (bestname[0] == '\0') /* init */
         {
@@ -70,10 +70,14 @@
  */
 
 #include "config.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "config/lib.h"
@@ -261,6 +265,151 @@ static int query_tag(struct Menu *menu, int sel, int act)
   return av->is_tagged - ot;
 }
 
+/**
+ * query_parse_line - Parse one line of $query_command output
+ * @param al   Alias list to add to
+ * @param line Line to parse, modified in place
+ *
+ * The line holds address, name and comment, separated by tabs.
+ */
+static void query_parse_line(struct AliasList *al, char *line)
+{
+  char *tok = line;
+  char *next_tok = strchr(tok, '\t');
+  if (next_tok)
+    *next_tok++ = '\0';
+
+  if (*tok == '\0')
+    return;
+
+  struct Alias *alias = alias_new();
+
+  mutt_addrlist_parse(&alias->addr, tok);
+
+  if (next_tok)
+  {
+    tok = next_tok;
+    next_tok = strchr(tok, '\t');
+    if (next_tok)
+      *next_tok++ = '\0';
+
+    alias->name = mutt_str_dup(tok);
+    parse_alias_comments(alias, next_tok);
+  }
+
+  TAILQ_INSERT_TAIL(al, alias, entries);
+}
+
+/**
+ * query_cache_path - Get the cache file for a query
+ * @param[in]  s    Query string
+ * @param[in]  sub  Config items
+ * @param[out] path Buffer for the path
+ * @retval true $query_cache_dir is set and the path was built
+ *
+ * The file is named after a digest of both the query string and
+ * $query_command, so changing the command doesn't serve stale results.
+ */
+static bool query_cache_path(const char *s, const struct ConfigSubset *sub,
+                             struct Buffer *path)
+{
+  const char *const c_query_cache_dir = cs_subset_path(sub, "query_cache_dir");
+  if (!c_query_cache_dir)
+    return false;
+
+  const char *const c_query_command = cs_subset_string(sub, "query_command");
+  if (!c_query_command)
+    return false;
+
+  struct Md5Ctx md5ctx = { 0 };
+  unsigned char digest[16];
+  char hex[33] = { 0 };
+
+  mutt_md5_init_ctx(&md5ctx);
+  mutt_md5_process(c_query_command, &md5ctx);
+  mutt_md5_process("\n", &md5ctx);
+  mutt_md5_process(s, &md5ctx);
+  mutt_md5_finish_ctx(&md5ctx, digest);
+  mutt_md5_toascii(digest, hex);
+
+  buf_printf(path, "%s/%s", c_query_cache_dir, hex);
+  return true;
+}
+
+/**
+ * query_cache_write - Save query results to the cache
+ * @param s    Query string
+ * @param sub  Config items
+ * @param data Result lines, as produced by $query_command
+ *
+ * The file is written next to its final name and renamed into place, so a
+ * parallel NeoMutt never reads a half-written cache.
+ */
+static void query_cache_write(const char *s, const struct ConfigSubset *sub,
+                              const char *data)
+{
+  struct Buffer *path = buf_pool_get();
+  struct Buffer *path_tmp = buf_pool_get();
+
+  if (!query_cache_path(s, sub, path))
+    goto done;
+
+  const char *const c_query_cache_dir = cs_subset_path(sub, "query_cache_dir");
+  if (mutt_file_mkdir(c_query_cache_dir, S_IRWXU) != 0)
+    goto done;
+
+  buf_printf(path_tmp, "%s.tmp", buf_string(path));
+  FILE *fp = mutt_file_fopen(buf_string(path_tmp), "w");
+  if (!fp)
+    goto done;
+
+  fputs(data, fp);
+  if (mutt_file_fclose(&fp) == 0)
+    rename(buf_string(path_tmp), buf_string(path));
+  else
+    unlink(buf_string(path_tmp));
+
+done:
+  buf_pool_release(&path);
+  buf_pool_release(&path_tmp);
+}
+
+/**
+ * query_cache_load - Read cached query results
+ * @param s   Query string
+ * @param al  Alias list to fill
+ * @param sub Config items
+ * @retval true The cache held at least one result
+ */
+static bool query_cache_load(const char *s, struct AliasList *al,
+                             const struct ConfigSubset *sub)
+{
+  struct Buffer *path = buf_pool_get();
+  bool rc = false;
+
+  if (!query_cache_path(s, sub, path))
+    goto done;
+
+  FILE *fp = mutt_file_fopen(buf_string(path), "r");
+  if (!fp)
+    goto done;
+
+  char *line = NULL;
+  size_t linelen = 0;
+  while ((line = mutt_file_read_line(line, &linelen, fp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    query_parse_line(al, line);
+  }
+  FREE(&line);
+  mutt_file_fclose(&fp);
+
+  rc = !TAILQ_EMPTY(al);
+
+done:
+  buf_pool_release(&path);
+  return rc;
+}
+
 /**
  * query_run - Run an external program to find Addresses
  * @param s       String to match
@@ -277,9 +426,8 @@ int query_run(const char *s, bool verbose, struct AliasList *al, const struct Co
   size_t buflen;
   char *msg = NULL;
   size_t msglen = 0;
-  char *tok = NULL;
-  char *next_tok = NULL;
   struct Buffer *cmd = buf_pool_get();
+  struct Buffer raw = { 0 };
 
   const char *const c_query_command = cs_subset_string(sub, "query_command");
   buf_file_expand_fmt_quote(cmd, c_query_command, s);
@@ -301,30 +449,9 @@ int query_run(const char *s, bool verbose, struct AliasList *al, const struct Co
   msg = mutt_file_read_line(msg, &msglen, fp, NULL, MUTT_RL_NO_FLAGS);
   while ((buf = mutt_file_read_line(buf, &buflen, fp, NULL, MUTT_RL_NO_FLAGS)))
   {
-    tok = buf;
-    next_tok = strchr(tok, '\t');
-    if (next_tok)
-      *next_tok++ = '\0';
-
-    if (*tok == '\0')
-      continue;
-
-    struct Alias *alias = alias_new();
-
-    mutt_addrlist_parse(&alias->addr, tok);
-
-    if (next_tok)
-    {
-      tok = next_tok;
-      next_tok = strchr(tok, '\t');
-      if (next_tok)
-        *next_tok++ = '\0';
-
-      alias->name = mutt_str_dup(tok);
-      parse_alias_comments(alias, next_tok);
-    }
-
-    TAILQ_INSERT_TAIL(al, alias, entries);
+    buf_addstr(&raw, buf);
+    buf_addch(&raw, '\n');
+    query_parse_line(al, buf);
   }
 
   FREE(&buf);
@@ -339,8 +466,11 @@ int query_run(const char *s, bool verbose, struct AliasList *al, const struct Co
   {
     if (verbose)
       mutt_message("%s", msg);
+    if (!TAILQ_EMPTY(al))
+      query_cache_write(s, sub, buf_string(&raw));
   }
   FREE(&msg);
+  buf_dealloc(&raw);
 
   return 0;
 }
@@ -407,10 +537,173 @@ static struct MuttWindow *query_dialog_new(struct AliasMenuData *mdata, const ch
   return dlg;
 }
 
+/**
+ * struct QueryRefresh - A background re-run of $query_command
+ *
+ * When cached results are shown, the query is re-run in parallel and its
+ * output collected without blocking, from the dialog's event loop.
+ */
+struct QueryRefresh
+{
+  pid_t pid;          ///< Process running $query_command
+  FILE *fp;           ///< Its stdout, non-blocking; NULL when finished
+  struct Buffer out;  ///< Output collected so far
+};
+
+/**
+ * query_refresh_start - Re-run $query_command in the background
+ * @param qr  Refresh state to fill
+ * @param s   Query string
+ * @param sub Config items
+ */
+static void query_refresh_start(struct QueryRefresh *qr, const char *s,
+                                const struct ConfigSubset *sub)
+{
+  struct Buffer *cmd = buf_pool_get();
+
+  const char *const c_query_command = cs_subset_string(sub, "query_command");
+  buf_file_expand_fmt_quote(cmd, c_query_command, s);
+
+  qr->pid = filter_create(buf_string(cmd), NULL, &qr->fp, NULL, EnvList);
+  buf_pool_release(&cmd);
+  if (qr->pid < 0)
+  {
+    qr->fp = NULL;
+    return;
+  }
+
+  /* The output is drained opportunistically from the dialog's event loop,
+   * so reads mustn't block */
+  const int fd = fileno(qr->fp);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * query_refresh_poll - Collect output from a background query
+ * @param qr Refresh state
+ * @retval true The query has just finished
+ */
+static bool query_refresh_poll(struct QueryRefresh *qr)
+{
+  if (!qr->fp)
+    return false;
+
+  char buf[4096];
+  while (true)
+  {
+    const ssize_t len = read(fileno(qr->fp), buf, sizeof(buf));
+    if (len > 0)
+    {
+      buf_addstr_n(&qr->out, buf, len);
+      continue;
+    }
+    if ((len < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+      return false; /* still running */
+    break; /* EOF, or a read error ends the refresh */
+  }
+
+  mutt_file_fclose(&qr->fp);
+  filter_wait(qr->pid);
+  return true;
+}
+
+/**
+ * query_refresh_abort - Stop caring about a background query
+ * @param qr Refresh state
+ *
+ * Closing the pipe lets a still-running command die on its next write.
+ */
+static void query_refresh_abort(struct QueryRefresh *qr)
+{
+  if (qr->fp)
+  {
+    mutt_file_fclose(&qr->fp);
+    filter_wait(qr->pid);
+  }
+  buf_dealloc(&qr->out);
+}
+
+/**
+ * query_refresh_merge - Replace the displayed results with fresh ones
+ * @param qr    Refresh state holding the complete output
+ * @param mdata Menu data holding Aliases
+ *
+ * The user's tags are carried over to entries with the same addresses.  If
+ * the re-run produced nothing, the cached results stay on display.
+ */
+static void query_refresh_merge(struct QueryRefresh *qr, struct AliasMenuData *mdata)
+{
+  struct AliasList al_new = TAILQ_HEAD_INITIALIZER(al_new);
+
+  /* The first line is the status message of the query protocol */
+  char *data = buf_strdup(&qr->out);
+  char *p = data ? strchr(data, '\n') : NULL;
+  char *line = NULL;
+  while (p)
+  {
+    line = p + 1;
+    p = strchr(line, '\n');
+    if (p)
+      *p = '\0';
+    if (*line != '\0')
+      query_parse_line(&al_new, line);
+  }
+  FREE(&data);
+
+  if (TAILQ_EMPTY(&al_new))
+    return;
+
+  /* remember the tagged addresses */
+  struct ListHead tagged = STAILQ_HEAD_INITIALIZER(tagged);
+  struct Buffer *addr = buf_pool_get();
+  struct AliasView *avp = NULL;
+  ARRAY_FOREACH(avp, &mdata->ava)
+  {
+    if (!avp->is_tagged)
+      continue;
+    buf_reset(addr);
+    mutt_addrlist_write(&avp->alias->addr, addr, false);
+    mutt_list_insert_tail(&tagged, buf_strdup(addr));
+  }
+
+  aliaslist_clear(mdata->al);
+  TAILQ_CONCAT(mdata->al, &al_new, entries);
+
+  ARRAY_FREE(&mdata->ava);
+  struct Alias *np = NULL;
+  TAILQ_FOREACH(np, mdata->al, entries)
+  {
+    alias_array_alias_add(&mdata->ava, np);
+  }
+  alias_array_sort(&mdata->ava, mdata->sub);
+
+  ARRAY_FOREACH(avp, &mdata->ava)
+  {
+    avp->num = ARRAY_FOREACH_IDX;
+    buf_reset(addr);
+    mutt_addrlist_write(&avp->alias->addr, addr, false);
+    if (mutt_list_find(&tagged, buf_string(addr)))
+      avp->is_tagged = true;
+  }
+  buf_pool_release(&addr);
+  mutt_list_free(&tagged);
+
+  struct Menu *menu = mdata->menu;
+  menu->max = ARRAY_SIZE(&mdata->ava);
+  if (menu_get_index(menu) >= menu->max)
+    menu_set_index(menu, menu->max - 1);
+  menu_queue_redraw(menu, MENU_REDRAW_FULL);
+
+  const char *entries = strchr(buf_string(&qr->out), '\n');
+  if (entries)
+    query_cache_write(buf_string(mdata->query), mdata->sub, entries + 1);
+}
+
 /**
  * dlg_query - Get the user to enter an Address Query - @ingroup gui_dlg
  * @param buf   Buffer for the query
  * @param mdata Menu data holding Aliases
+ * @param qr    Background refresh of the query, or NULL
  * @retval true Selection was made
  *
  * The Select Query Dialog is an Address Book.
@@ -418,7 +711,7 @@ static struct MuttWindow *query_dialog_new(struct AliasMenuData *mdata, const ch
  *
  * The user can select addresses to add to an Email.
  */
-static bool dlg_query(struct Buffer *buf, struct AliasMenuData *mdata)
+static bool dlg_query(struct Buffer *buf, struct AliasMenuData *mdata, struct QueryRefresh *qr)
 {
   struct MuttWindow *dlg = query_dialog_new(mdata, buf_string(buf));
   struct Menu *menu = dlg->wdata;
@@ -448,6 +741,8 @@ static bool dlg_query(struct Buffer *buf, struct AliasMenuData *mdata)
 
     op = km_dokey(MENU_QUERY, GETCH_NO_FLAGS);
     mutt_debug(LL_DEBUG1, "Got op %s (%d)\n", opcodes_get_name(op), op);
+    if (qr && query_refresh_poll(qr))
+      query_refresh_merge(qr, mdata);
     if (op < 0)
       continue;
     if (op == OP_NULL)
@@ -481,6 +776,7 @@ int query_complete(struct Buffer *buf, struct ConfigSubset *sub)
 {
   struct AliasMenuData mdata = { ARRAY_HEAD_INITIALIZER, NULL, sub };
   mdata.search_state = search_state_new();
+  struct QueryRefresh qr = { 0 };
 
   struct AliasList al = TAILQ_HEAD_INITIALIZER(al);
   const char *const c_query_command = cs_subset_string(sub, "query_command");
@@ -490,7 +786,9 @@ int query_complete(struct Buffer *buf, struct ConfigSubset *sub)
     goto done;
   }
 
-  query_run(buf_string(buf), true, &al, sub);
+  const bool from_cache = query_cache_load(buf_string(buf), &al, sub);
+  if (!from_cache)
+    query_run(buf_string(buf), true, &al, sub);
   if (TAILQ_EMPTY(&al))
     goto done;
 
@@ -518,7 +816,9 @@ int query_complete(struct Buffer *buf, struct ConfigSubset *sub)
   }
 
   /* multiple results, choose from query menu */
-  if (!dlg_query(buf, &mdata))
+  if (from_cache)
+    query_refresh_start(&qr, buf_string(buf), sub);
+  if (!dlg_query(buf, &mdata, &qr))
     goto done;
 
   buf_reset(buf);
@@ -546,6 +846,7 @@ int query_complete(struct Buffer *buf, struct ConfigSubset *sub)
   }
 
 done:
+  query_refresh_abort(&qr);
   ARRAY_FREE(&mdata.ava);
   FREE(&mdata.title);
   FREE(&mdata.limit);
@@ -572,6 +873,7 @@ void query_index(struct Mailbox *m, struct ConfigSubset *sub)
   struct AliasMenuData mdata = { ARRAY_HEAD_INITIALIZER, NULL, sub };
   mdata.al = &al;
   mdata.search_state = search_state_new();
+  struct QueryRefresh qr = { 0 };
 
   struct Buffer *buf = buf_pool_get();
   if ((mw_get_field(_("Query: "), buf, MUTT_COMP_NO_FLAGS, HC_OTHER, NULL, NULL) != 0) ||
@@ -580,7 +882,9 @@ void query_index(struct Mailbox *m, struct ConfigSubset *sub)
     goto done;
   }
 
-  query_run(buf_string(buf), false, &al, sub);
+  const bool from_cache = query_cache_load(buf_string(buf), &al, sub);
+  if (!from_cache)
+    query_run(buf_string(buf), false, &al, sub);
   if (TAILQ_EMPTY(&al))
     goto done;
 
@@ -590,7 +894,9 @@ void query_index(struct Mailbox *m, struct ConfigSubset *sub)
     alias_array_alias_add(&mdata.ava, np);
   }
 
-  if (!dlg_query(buf, &mdata))
+  if (from_cache)
+    query_refresh_start(&qr, buf_string(buf), sub);
+  if (!dlg_query(buf, &mdata, &qr))
     goto done;
 
   // Prepare the "To:" field of a new email
@@ -614,6 +920,7 @@ void query_index(struct Mailbox *m, struct ConfigSubset *sub)
   mutt_send_message(SEND_REVIEW_TO, e, NULL, m, NULL, sub);
 
 done:
+  query_refresh_abort(&qr);
   ARRAY_FREE(&mdata.ava);
   FREE(&mdata.title);
   FREE(&mdata.limit);
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * Sorted index of Alias names
+ *
+ * @authors
+ * Copyright (C) 2020 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page alias_names Sorted Alias name index
+ *
+ * Keep an Array of Aliases, sorted by name, so that name completion can use a
+ * binary search rather than walking the whole of #Aliases on every keystroke.
+ *
+ * Additions only mark the Array unsorted; it's re-sorted on the next lookup.
+ * Reading a big alias file at startup is then one sort, not a sort per line.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "names.h"
+#include "alias.h"
+
+ARRAY_HEAD(AliasNameArray, struct Alias *);
+
+static struct AliasNameArray AliasNames = ARRAY_HEAD_INITIALIZER; ///< Aliases, sorted by Alias.name
+static bool AliasNamesSorted = true; ///< Is #AliasNames currently in sorted order?
+
+/**
+ * alias_names_sort_name - Compare two Aliases by name - Implements ::sort_t - @ingroup sort_api
+ */
+static int alias_names_sort_name(const void *a, const void *b, void *sdata)
+{
+  const struct Alias *ala = *(struct Alias const *const *) a;
+  const struct Alias *alb = *(struct Alias const *const *) b;
+
+  return mutt_istr_cmp(ala->name, alb->name);
+}
+
+/**
+ * alias_names_ensure_sorted - Re-sort the index if Aliases have been added
+ */
+static void alias_names_ensure_sorted(void)
+{
+  if (AliasNamesSorted)
+    return;
+
+  ARRAY_SORT(&AliasNames, alias_names_sort_name, NULL);
+  AliasNamesSorted = true;
+}
+
+/**
+ * alias_names_lower_bound - Find the first index not sorting before a name
+ * @param name Name to find
+ * @retval num Index of the first Alias whose name is >= name
+ *
+ * If every Alias sorts before @a name, the Array size is returned.
+ */
+static size_t alias_names_lower_bound(const char *name)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&AliasNames);
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    const struct Alias *alias = *ARRAY_GET(&AliasNames, mid);
+    if (mutt_istr_cmp(alias->name, name) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/**
+ * alias_names_init - Set up the Alias name index
+ */
+void alias_names_init(void)
+{
+  ARRAY_INIT(&AliasNames);
+  AliasNamesSorted = true;
+}
+
+/**
+ * alias_names_add - Add an Alias to the name index
+ * @param alias Alias to add
+ */
+void alias_names_add(struct Alias *alias)
+{
+  if (!alias || !alias->name)
+    return;
+
+  ARRAY_ADD(&AliasNames, alias);
+  AliasNamesSorted = false;
+}
+
+/**
+ * alias_names_delete - Remove an Alias from the name index
+ * @param alias Alias to remove
+ */
+void alias_names_delete(struct Alias *alias)
+{
+  if (!alias)
+    return;
+
+  struct Alias **ap = NULL;
+  ARRAY_FOREACH(ap, &AliasNames)
+  {
+    if (*ap == alias)
+    {
+      ARRAY_REMOVE(&AliasNames, ap);
+      return;
+    }
+  }
+}
+
+/**
+ * alias_names_clear - Empty the Alias name index
+ */
+void alias_names_clear(void)
+{
+  ARRAY_SHRINK(&AliasNames, ARRAY_SIZE(&AliasNames));
+  AliasNamesSorted = true;
+}
+
+/**
+ * alias_names_shutdown - Clear up the Alias name index
+ */
+void alias_names_shutdown(void)
+{
+  ARRAY_FREE(&AliasNames);
+  AliasNamesSorted = true;
+}
+
+/**
+ * alias_names_prefix - Find the Aliases whose names start with a prefix
+ * @param[in]  prefix Prefix to match, may be empty
+ * @param[out] first  Index of the first match
+ * @retval num Number of matching Aliases
+ *
+ * The matches are contiguous in the sorted index; retrieve them with
+ * alias_names_get(first), alias_names_get(first + 1), ...
+ */
+size_t alias_names_prefix(const char *prefix, size_t *first)
+{
+  if (!prefix || !first)
+    return 0;
+
+  alias_names_ensure_sorted();
+
+  const size_t plen = mutt_str_len(prefix);
+  const size_t lo = alias_names_lower_bound(prefix);
+  size_t hi = lo;
+
+  struct Alias **ap = NULL;
+  ARRAY_FOREACH_FROM(ap, &AliasNames, lo)
+  {
+    if (mutt_istrn_cmp((*ap)->name, prefix, plen) != 0)
+      break;
+    hi++;
+  }
+
+  *first = lo;
+  return hi - lo;
+}
+
+/**
+ * alias_names_get - Get an Alias from the name index
+ * @param idx Index of the Alias
+ * @retval ptr  Alias
+ * @retval NULL Invalid index
+ */
+struct Alias *alias_names_get(size_t idx)
+{
+  struct Alias **ap = ARRAY_GET(&AliasNames, idx);
+  return ap ? *ap : NULL;
+}
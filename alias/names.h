@@ -0,0 +1,39 @@
+/**
+ * @file
+ * Sorted index of Alias names
+ *
+ * @authors
+ * Copyright (C) 2020 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_ALIAS_NAMES_H
+#define MUTT_ALIAS_NAMES_H
+
+#include <stddef.h>
+
+struct Alias;
+
+void          alias_names_init    (void);
+void          alias_names_add     (struct Alias *alias);
+void          alias_names_delete  (struct Alias *alias);
+void          alias_names_clear   (void);
+void          alias_names_shutdown(void);
+
+size_t        alias_names_prefix  (const char *prefix, size_t *first);
+struct Alias *alias_names_get     (size_t idx);
+
+#endif /* MUTT_ALIAS_NAMES_H */
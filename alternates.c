@@ -30,6 +30,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "email/lib.h"
@@ -41,8 +42,23 @@
 
 static struct RegexList Alternates = STAILQ_HEAD_INITIALIZER(Alternates); ///< List of regexes to match the user's alternate email addresses
 static struct RegexList UnAlternates = STAILQ_HEAD_INITIALIZER(UnAlternates); ///< List of regexes to exclude false matches in Alternates
+static struct HashTable *AlternatesHash = NULL; ///< Hash Table of the plain (non-regex) Alternates, for exact matching
 static struct Notify *AlternatesNotify = NULL; ///< Notifications: #NotifyAlternates
 
+/**
+ * alternates_hashable - Can an alternates pattern be matched exactly?
+ * @param pat Pattern to check
+ * @retval true Pattern is a plain address
+ *
+ * A plain address can be looked up in #AlternatesHash, skipping the regex
+ * scan.  A dot is allowed: it's in almost every address and, as a regex, it
+ * still matches itself.
+ */
+static bool alternates_hashable(const char *pat)
+{
+  return !strpbrk(pat, "^$[]*+?(){}|\\");
+}
+
 /**
  * alternates_cleanup - Free the alternates lists
  */
@@ -50,6 +66,7 @@ void alternates_cleanup(void)
 {
   notify_free(&AlternatesNotify);
 
+  mutt_hash_free(&AlternatesHash);
   mutt_regexlist_free(&Alternates);
   mutt_regexlist_free(&UnAlternates);
 }
@@ -62,6 +79,7 @@ void alternates_init(void)
   if (AlternatesNotify)
     return;
 
+  AlternatesHash = mutt_hash_new(1031, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
   AlternatesNotify = notify_new();
   notify_set_parent(AlternatesNotify, NeoMutt->notify);
 }
@@ -106,6 +124,12 @@ enum CommandResult parse_alternates(struct Buffer *buf, struct Buffer *s,
     if (mutt_regexlist_add(&Alternates, buf->data, REG_ICASE, err) != 0)
       goto bail;
 
+    if (AlternatesHash && alternates_hashable(buf->data) &&
+        !mutt_hash_find_elem(AlternatesHash, buf->data))
+    {
+      mutt_hash_insert(AlternatesHash, buf->data, NULL);
+    }
+
     if (mutt_grouplist_add_regex(&gl, buf->data, REG_ICASE, err) != 0)
       goto bail;
   } while (MoreArgs(s));
@@ -133,6 +157,19 @@ enum CommandResult parse_unalternates(struct Buffer *buf, struct Buffer *s,
     parse_extract_token(buf, s, TOKEN_NO_FLAGS);
     mutt_regexlist_remove(&Alternates, buf->data);
 
+    if (AlternatesHash)
+    {
+      if (mutt_str_equal(buf->data, "*"))
+      {
+        mutt_hash_free(&AlternatesHash);
+        AlternatesHash = mutt_hash_new(1031, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+      }
+      else
+      {
+        mutt_hash_delete(AlternatesHash, buf->data, NULL);
+      }
+    }
+
     if (!mutt_str_equal(buf->data, "*") &&
         (mutt_regexlist_add(&UnAlternates, buf->data, REG_ICASE, err) != 0))
     {
@@ -157,6 +194,16 @@ bool mutt_alternates_match(const char *addr)
   if (!addr)
     return false;
 
+  // An exact match is common - check the hash before scanning the regexes
+  if (AlternatesHash && mutt_hash_find_elem(AlternatesHash, addr))
+  {
+    mutt_debug(LL_DEBUG5, "yes, %s found in alternates hash\n", addr);
+    if (mutt_regexlist_match(&UnAlternates, addr))
+      mutt_debug(LL_DEBUG5, "but, %s matched by unalternates\n", addr);
+    else
+      return true;
+  }
+
   if (mutt_regexlist_match(&Alternates, addr))
   {
     mutt_debug(LL_DEBUG5, "yes, %s matched by alternates\n", addr);
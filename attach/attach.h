@@ -44,6 +44,7 @@ struct AttachPtr
   bool unowned : 1;     ///< Don't unlink on detach
   bool decrypted : 1;   ///< Not part of message as stored in the email->body
   bool collapsed : 1;   ///< Group is collapsed
+  bool unbuilt : 1;     ///< Collapsed group whose children haven't been generated yet
 };
 
 /**
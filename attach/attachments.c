@@ -254,15 +254,10 @@ int mutt_count_body_parts(const struct Mailbox *m, struct Email *e, FILE *fp)
   if (!m || !e)
     return 0;
 
-  bool keep_parts = false;
-
   if (e->attach_valid)
     return e->attach_total;
 
-  if (e->body->parts)
-    keep_parts = true;
-  else
-    mutt_parse_mime_message(e, fp);
+  mutt_parse_mime_message(e, fp);
 
   if (!STAILQ_EMPTY(&AttachAllow) || !STAILQ_EMPTY(&AttachExclude) ||
       !STAILQ_EMPTY(&InlineAllow) || !STAILQ_EMPTY(&InlineExclude))
@@ -276,9 +271,8 @@ int mutt_count_body_parts(const struct Mailbox *m, struct Email *e, FILE *fp)
 
   e->attach_valid = true;
 
-  if (!keep_parts)
-    mutt_body_free(&e->body->parts);
-
+  /* Keep the parsed tree cached on the Email: the pager and attachment menu
+   * will reuse it rather than parsing the message again */
   return e->attach_total;
 }
 
@@ -593,16 +587,28 @@ enum CommandResult parse_unattachments(struct Buffer *buf, struct Buffer *s,
  * mutt_parse_mime_message - Parse a MIME email
  * @param e Email
  * @param fp File to parse
+ *
+ * The parsed part tree is cached on the Email, stamped with the content
+ * generation it was parsed from.  A tree made stale by
+ * email_parts_invalidate() is discarded and re-parsed, unless a view still
+ * holds a reference to it.
  */
 void mutt_parse_mime_message(struct Email *e, FILE *fp)
 {
   const bool right_type = (e->body->type == TYPE_MESSAGE) ||
                           (e->body->type == TYPE_MULTIPART);
-  const bool not_parsed = (e->body->parts == NULL);
+  bool not_parsed = (e->body->parts == NULL);
+
+  if (!not_parsed && (e->parts_gen != e->content_gen) && (e->parts_refs == 0))
+  {
+    mutt_body_free(&e->body->parts);
+    not_parsed = true;
+  }
 
   if (right_type && fp && not_parsed)
   {
     mutt_parse_part(fp, e->body);
+    e->parts_gen = e->content_gen;
     if (WithCrypto)
     {
       e->security = crypt_query(e->body);
@@ -546,6 +546,7 @@ void dlg_attachment(struct ConfigSubset *sub, struct MailboxView *mv,
 
   /* make sure we have parsed this message */
   mutt_parse_mime_message(e, fp);
+  email_parts_ref(e); /* the AttachCtx keeps pointers into the part tree */
   mutt_message_hook(m, e, MUTT_MESSAGE_HOOK);
 
   struct MuttWindow *dlg = simple_dialog_new(MENU_ATTACHMENT, WT_DLG_ATTACHMENT, AttachmentHelp);
@@ -611,6 +612,7 @@ void dlg_attachment(struct ConfigSubset *sub, struct MailboxView *mv,
 
   window_set_focus(old_focus);
   simple_dialog_free(&dlg);
+  email_parts_unref(e);
 }
 
 /**
@@ -140,6 +140,9 @@ static void attach_collapse(struct AttachCtx *actx, struct Menu *menu)
   if (cur_att->collapsed)
     return;
 
+  /* Groups that start off collapsed are generated on first expansion */
+  mutt_attach_build(actx, cur_att);
+
   curlevel = cur_att->level;
   const int index = menu_get_index(menu);
   rindex = actx->v2r[index] + 1;
@@ -398,6 +398,82 @@ static int wait_interactive_filter(pid_t pid)
   return rc;
 }
 
+/**
+ * stream_attachment_to_fifo - Decode an attachment into a named pipe
+ * @param fp   Source file stream.  Can be NULL
+ * @param b    Email Body
+ * @param path Path of the fifo the viewer was given
+ * @retval  0 Success
+ * @retval -1 Error
+ *
+ * The viewer has already been started on @a path.  Wait for it to open the
+ * pipe for reading, then decode the attachment straight into it.  The open is
+ * polled with a timeout so a viewer that never opens the pipe (e.g. a broken
+ * mailcap command line) can't wedge the whole session.
+ */
+static int stream_attachment_to_fifo(FILE *fp, struct Body *b, const char *path)
+{
+  int fd = -1;
+  for (int i = 0; (fd < 0) && (i < 150); i++)
+  {
+    fd = open(path, O_WRONLY | O_NONBLOCK);
+    if ((fd < 0) && (errno != ENXIO))
+      break;
+    if (fd < 0)
+      mutt_date_sleep_ms(100);
+  }
+  if (fd < 0)
+  {
+    /* Unwedge a reader that turns up after we gave up waiting on it */
+    const int fd_nudge = open(path, O_RDWR | O_NONBLOCK);
+    if (fd_nudge >= 0)
+      close(fd_nudge);
+    mutt_debug(LL_DEBUG1, "viewer never opened %s\n", path);
+    return -1;
+  }
+
+  /* the writes must block; only the open was allowed not to */
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+  FILE *fp_out = fdopen(fd, "w");
+  if (!fp_out)
+  {
+    close(fd);
+    return -1;
+  }
+
+  int rc = -1;
+  if (fp)
+  {
+    /* In recv mode, extract from folder and decode */
+    struct State state = { 0 };
+    state.fp_in = fp;
+    state.fp_out = fp_out;
+    if (mutt_file_seek(fp, b->offset, SEEK_SET))
+    {
+#ifdef HAVE_POSIX_FADVISE
+      /* the part will be read front to back */
+      posix_fadvise(fileno(fp), b->offset, b->length, POSIX_FADV_SEQUENTIAL);
+#endif
+      mutt_decode_attachment(b, &state);
+      rc = 0;
+    }
+  }
+  else if (b->filename)
+  {
+    /* In send mode, just copy the file */
+    FILE *fp_old = mutt_file_fopen(b->filename, "r");
+    if (fp_old)
+    {
+      rc = (mutt_file_copy_stream(fp_old, fp_out) < 0) ? -1 : 0;
+      mutt_file_fclose(&fp_old);
+    }
+  }
+
+  mutt_file_fclose(&fp_out);
+  return rc;
+}
+
 /**
  * mutt_view_attachment - View an attachment
  * @param fp     Source file stream. Can be NULL
@@ -421,6 +497,7 @@ int mutt_view_attachment(FILE *fp, struct Body *b, enum ViewAttachMode mode,
 {
   bool use_mailcap = false;
   bool use_pipe = false;
+  bool use_fifo = false;
   bool use_pager = true;
   char type[256] = { 0 };
   char desc[512] = { 0 };
@@ -487,35 +564,50 @@ int mutt_view_attachment(FILE *fp, struct Body *b, enum ViewAttachMode mode,
     mailcap_expand_filename(entry->nametemplate, fname, tmpfile);
     FREE(&fname);
 
-    if (mutt_save_attachment(fp, b, buf_string(tmpfile), 0, NULL) == -1)
-      goto return_error;
-    has_tempfile = true;
-
-    mutt_rfc3676_space_unstuff_attachment(b, buf_string(tmpfile));
+    use_pipe = mailcap_expand_command(b, buf_string(tmpfile), type, cmd);
+    use_pager = entry->copiousoutput;
 
-    /* check for multipart/related and save attachments with b Content-ID */
-    if (mutt_str_equal(type, "text/html"))
+    /* An x-neomutt-stream entry gets a named pipe in place of the temp file:
+     * the viewer is started first and the attachment is decoded into the pipe
+     * while the viewer reads it, overlapping decode with viewer startup.
+     * Entries without a %s read stdin, and flowed or html parts need the
+     * decoded file rewritten in place, so those keep the plain temp file. */
+    use_fifo = entry->xneomuttstream && !use_pipe && !mutt_rfc3676_is_format_flowed(b) &&
+               !mutt_str_equal(type, "text/html") &&
+               (mkfifo(buf_string(tmpfile), 0600) == 0);
+    if (use_fifo)
     {
-      struct Body *related_ancestor = NULL;
-      if (actx->body_idx && (WithCrypto != 0) && (e->security & SEC_ENCRYPT))
-        related_ancestor = attach_body_ancestor(actx->body_idx[0], b, "related");
-      else
-        related_ancestor = attach_body_ancestor(e->body, b, "related");
-      if (related_ancestor)
+      has_tempfile = true;
+    }
+    else
+    {
+      if (mutt_save_attachment(fp, b, buf_string(tmpfile), 0, NULL) == -1)
+        goto return_error;
+      has_tempfile = true;
+
+      mutt_rfc3676_space_unstuff_attachment(b, buf_string(tmpfile));
+
+      /* check for multipart/related and save attachments with b Content-ID */
+      if (mutt_str_equal(type, "text/html"))
       {
-        struct CidMapList cid_map_list = STAILQ_HEAD_INITIALIZER(cid_map_list);
-        mutt_debug(LL_DEBUG2, "viewing text/html attachment in multipart/related group\n");
-        /* save attachments and build cid_map_list Content-ID to filename mapping list */
-        cid_save_attachments(related_ancestor->parts, &cid_map_list);
-        /* replace Content-IDs with filenames */
-        cid_to_filename(tmpfile, &cid_map_list);
-        /* empty Content-ID to filename mapping list */
-        cid_map_list_clear(&cid_map_list);
+        struct Body *related_ancestor = NULL;
+        if (actx->body_idx && (WithCrypto != 0) && (e->security & SEC_ENCRYPT))
+          related_ancestor = attach_body_ancestor(actx->body_idx[0], b, "related");
+        else
+          related_ancestor = attach_body_ancestor(e->body, b, "related");
+        if (related_ancestor)
+        {
+          struct CidMapList cid_map_list = STAILQ_HEAD_INITIALIZER(cid_map_list);
+          mutt_debug(LL_DEBUG2, "viewing text/html attachment in multipart/related group\n");
+          /* save attachments and build cid_map_list Content-ID to filename mapping list */
+          cid_save_attachments(related_ancestor->parts, &cid_map_list);
+          /* replace Content-IDs with filenames */
+          cid_to_filename(tmpfile, &cid_map_list);
+          /* empty Content-ID to filename mapping list */
+          cid_map_list_clear(&cid_map_list);
+        }
       }
     }
-
-    use_pipe = mailcap_expand_command(b, buf_string(tmpfile), type, cmd);
-    use_pager = entry->copiousoutput;
   }
 
   if (use_pager)
@@ -541,7 +633,7 @@ int mutt_view_attachment(FILE *fp, struct Body *b, enum ViewAttachMode mode,
       mutt_endwin();
 
     const bool c_wait_key = cs_subset_bool(NeoMutt->sub, "wait_key");
-    if (use_pager || use_pipe)
+    if (use_pager || use_pipe || use_fifo)
     {
       if (use_pager &&
           ((fd_pager = mutt_file_open(buf_string(pagerfile),
@@ -576,6 +668,9 @@ int mutt_view_attachment(FILE *fp, struct Body *b, enum ViewAttachMode mode,
         goto return_error;
       }
 
+      if (use_fifo && (stream_attachment_to_fifo(fp, b, buf_string(tmpfile)) != 0))
+        mutt_debug(LL_DEBUG1, "streaming into %s failed\n", buf_string(tmpfile));
+
       if (use_pager)
       {
         if (b->description)
@@ -600,6 +695,10 @@ int mutt_view_attachment(FILE *fp, struct Body *b, enum ViewAttachMode mode,
         close(fd_temp);
       if (fd_pager != -1)
         close(fd_pager);
+
+      /* mutt_file_unlink() only removes regular files */
+      if (use_fifo)
+        unlink(buf_string(tmpfile));
     }
     else
     {
@@ -979,6 +1078,10 @@ int mutt_save_attachment(FILE *fp, struct Body *b, const char *path,
         mutt_file_fclose(&state.fp_out);
         return -1;
       }
+#ifdef HAVE_POSIX_FADVISE
+      /* the part will be read front to back */
+      posix_fadvise(fileno(fp), b->offset, b->length, POSIX_FADV_SEQUENTIAL);
+#endif
       mutt_decode_attachment(b, &state);
 
       if (mutt_file_fsync_close(&state.fp_out) != 0)
@@ -1010,6 +1113,21 @@ int mutt_save_attachment(FILE *fp, struct Body *b, const char *path,
       return -1;
     }
 
+    struct stat st_old = { 0 };
+    struct stat st_new = { 0 };
+    if ((fstat(fileno(fp_old), &st_old) == 0) && S_ISREG(st_old.st_mode) &&
+        (st_old.st_size > 0) && (fstat(fileno(fp_new), &st_new) == 0) &&
+        S_ISREG(st_new.st_mode))
+    {
+#ifdef HAVE_POSIX_FADVISE
+      posix_fadvise(fileno(fp_old), 0, st_old.st_size, POSIX_FADV_SEQUENTIAL);
+#endif
+#ifdef HAVE_POSIX_FALLOCATE
+      /* the copy is byte-for-byte, so the target size is already known */
+      posix_fallocate(fileno(fp_new), st_new.st_size, st_old.st_size);
+#endif
+    }
+
     if (mutt_file_copy_stream(fp_old, fp_new) == -1)
     {
       mutt_error(_("Write fault"));
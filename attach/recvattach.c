@@ -52,6 +52,7 @@
 #include "history/lib.h"
 #include "menu/lib.h"
 #include "ncrypt/lib.h"
+#include "progress/lib.h"
 #include "question/lib.h"
 #include "send/lib.h"
 #include "attach.h"
@@ -267,6 +268,241 @@ static int save_attachment_flowed_helper(FILE *fp, struct Body *b, const char *p
   return rc;
 }
 
+/// Cap on decoded attachment bytes queued for the async writers
+#define ATTACH_PIPE_MAX_BYTES (64 << 20)
+
+/**
+ * struct AttachWrite - One decoded attachment queued for an async writer
+ */
+struct AttachWrite
+{
+  char *path;              ///< Destination path
+  char *data;              ///< Decoded attachment bytes
+  size_t dsize;            ///< Number of bytes in data
+  enum SaveAttach opt;     ///< Open disposition, e.g. #MUTT_SAVE_APPEND
+  int rc;                  ///< Result of the write, 0 on success
+  struct AttachPipe *pipe; ///< Owning pipeline
+};
+
+/**
+ * struct AttachPipe - Decode-to-write pipeline for bulk attachment saving
+ *
+ * Saving the tagged attachments of a large digest is a long chain of
+ * decode-write-fsync steps.  The source FILE and the config aren't
+ * thread-safe, so decoding stays on the main thread, but each decoded part
+ * is handed to a worker that does the open, write, fsync and close.
+ * Decoding part n+1 thus overlaps the disk traffic of part n - including
+ * the per-file fsync, which dominates on spinning rust and network mounts.
+ */
+struct AttachPipe
+{
+  struct ThreadPool *tp;        ///< Writer threads
+  struct Progress *progress;    ///< Progress of the completed writes
+  struct ListHead queued_paths; ///< Paths with writes still in flight
+  size_t queued_bytes;          ///< Decoded bytes in flight
+  int total;                    ///< Number of writes handed to the pool
+  int done;                     ///< Number of writes completed
+  int saved;                    ///< ... of which succeeded
+};
+
+/**
+ * attach_write_work - Write one decoded attachment - Implements ::tpool_work_t - @ingroup tpool_work_api
+ * @param wdata AttachWrite to perform
+ */
+static void attach_write_work(void *wdata)
+{
+  struct AttachWrite *aw = wdata;
+
+  FILE *fp = mutt_file_fopen_masked(aw->path, (aw->opt == MUTT_SAVE_APPEND) ? "a" : "w");
+  if (!fp)
+  {
+    aw->rc = -1;
+    return;
+  }
+
+  if (fwrite(aw->data, 1, aw->dsize, fp) != aw->dsize)
+  {
+    mutt_file_fclose(&fp);
+    aw->rc = -1;
+    return;
+  }
+
+  aw->rc = mutt_file_fsync_close(&fp);
+}
+
+/**
+ * attach_write_done - Account for a finished write - Implements ::tpool_done_t - @ingroup tpool_done_api
+ * @param wdata AttachWrite that completed
+ *
+ * Runs on the main thread, so it may update the Progress display.
+ */
+static void attach_write_done(void *wdata)
+{
+  struct AttachWrite *aw = wdata;
+  struct AttachPipe *pipe = aw->pipe;
+
+  pipe->done++;
+  if (aw->rc == 0)
+    pipe->saved++;
+  else
+    mutt_error(_("Could not save %s"), aw->path);
+
+  pipe->queued_bytes -= aw->dsize;
+  progress_update(pipe->progress, pipe->done, -1);
+
+  struct ListNode *np = NULL, *tmp = NULL;
+  STAILQ_FOREACH_SAFE(np, &pipe->queued_paths, entries, tmp)
+  {
+    if (mutt_str_equal(np->data, aw->path))
+    {
+      STAILQ_REMOVE(&pipe->queued_paths, np, ListNode, entries);
+      FREE(&np->data);
+      FREE(&np);
+      break;
+    }
+  }
+
+  FREE(&aw->path);
+  FREE(&aw->data);
+  FREE(&aw);
+}
+
+/**
+ * attach_pipe_flush - Wait until every queued write has finished
+ * @param pipe Pipeline
+ *
+ * Needed before touching a file on the main thread, so a serial save can't
+ * race a writer that's still busy.
+ */
+static void attach_pipe_flush(struct AttachPipe *pipe)
+{
+  if (!pipe || !pipe->tp)
+    return;
+
+  tpool_wait(pipe->tp);
+  tpool_drain(pipe->tp);
+}
+
+/**
+ * attach_pipe_enqueue - Decode an attachment and queue its write
+ * @param pipe Pipeline (may be NULL)
+ * @param fp   File handle to the attachment
+ * @param b    Attachment
+ * @param path Destination path
+ * @param opt  Save option, see #SaveAttach
+ * @retval true  Write was queued; completion is counted by the pipeline
+ * @retval false Part isn't suited to the pipeline; save it serially
+ */
+static bool attach_pipe_enqueue(struct AttachPipe *pipe, FILE *fp,
+                                struct Body *b, const char *path, enum SaveAttach opt)
+{
+  if (!pipe || !pipe->tp || !fp)
+    return false;
+
+  /* Mailbox writes and flowed-text unstuffing stay on the main thread */
+  if (has_a_message(b) || mutt_rfc3676_is_format_flowed(b))
+    return false;
+
+  /* Appends depend on the order of earlier writes */
+  if (opt != MUTT_SAVE_NO_FLAGS)
+    return false;
+
+  /* Two tagged parts may resolve to the same filename */
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &pipe->queued_paths, entries)
+  {
+    if (mutt_str_equal(np->data, path))
+    {
+      attach_pipe_flush(pipe);
+      break;
+    }
+  }
+
+  char *data = NULL;
+  size_t dsize = 0;
+  struct State state = { 0 };
+
+  state.fp_out = open_memstream(&data, &dsize);
+  if (!state.fp_out)
+    return false;
+
+  state.fp_in = fp;
+  if (!mutt_file_seek(fp, b->offset, SEEK_SET))
+  {
+    mutt_file_fclose(&state.fp_out);
+    FREE(&data);
+    return false;
+  }
+  mutt_decode_attachment(b, &state);
+  if (mutt_file_fclose(&state.fp_out) != 0)
+  {
+    FREE(&data);
+    return false;
+  }
+
+  struct AttachWrite *aw = mutt_mem_calloc(1, sizeof(struct AttachWrite));
+  aw->path = mutt_str_dup(path);
+  aw->data = data;
+  aw->dsize = dsize;
+  aw->opt = opt;
+  aw->pipe = pipe;
+
+  mutt_list_insert_tail(&pipe->queued_paths, mutt_str_dup(path));
+  pipe->queued_bytes += dsize;
+  pipe->total++;
+  tpool_submit(pipe->tp, attach_write_work, attach_write_done, aw);
+
+  /* Collect finished writes; stall if too much decoded data is in flight */
+  tpool_drain(pipe->tp);
+  if (pipe->queued_bytes > ATTACH_PIPE_MAX_BYTES)
+    attach_pipe_flush(pipe);
+
+  return true;
+}
+
+/**
+ * attach_pipe_new - Create a pipeline for saving attachments
+ * @param count Number of attachments to be saved
+ * @retval ptr  New pipeline
+ * @retval NULL Too little work to be worth the threads
+ */
+static struct AttachPipe *attach_pipe_new(int count)
+{
+  if (count < 2)
+    return NULL;
+
+  struct ThreadPool *tp = tpool_new(0);
+  if (!tp)
+    return NULL;
+
+  struct AttachPipe *pipe = mutt_mem_calloc(1, sizeof(struct AttachPipe));
+  pipe->tp = tp;
+  STAILQ_INIT(&pipe->queued_paths);
+  pipe->progress = progress_new(MUTT_PROGRESS_WRITE, count);
+  progress_set_message(pipe->progress, _("Saving tagged attachments..."));
+
+  return pipe;
+}
+
+/**
+ * attach_pipe_free - Free a pipeline
+ * @param[out] ptr Pipeline to free
+ *
+ * Waits for the remaining writes and runs their completions.
+ */
+static void attach_pipe_free(struct AttachPipe **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct AttachPipe *pipe = *ptr;
+
+  tpool_free(&pipe->tp);
+  progress_free(&pipe->progress);
+  mutt_list_free(&pipe->queued_paths);
+  FREE(ptr);
+}
+
 /**
  * query_save_attachment - Ask the user if we should save the attachment
  * @param[in]  fp        File handle to the attachment (OPTIONAL)
@@ -374,13 +610,16 @@ cleanup:
 
 /**
  * save_without_prompting - Save the attachment, without prompting each time
- * @param[in]  fp File handle to the attachment (OPTIONAL)
- * @param[in]  b  Attachment
- * @param[in]  e  Email
+ * @param[in]  fp   File handle to the attachment (OPTIONAL)
+ * @param[in]  b    Attachment
+ * @param[in]  e    Email
+ * @param[in]  pipe Pipeline for async writes (OPTIONAL)
+ * @retval  1 Write queued on the pipeline
  * @retval  0 Success
  * @retval -1 Failure
  */
-static int save_without_prompting(FILE *fp, struct Body *b, struct Email *e)
+static int save_without_prompting(FILE *fp, struct Body *b, struct Email *e,
+                                  struct AttachPipe *pipe)
 {
   enum SaveAttach opt = MUTT_SAVE_NO_FLAGS;
   int rc = -1;
@@ -412,6 +651,15 @@ static int save_without_prompting(FILE *fp, struct Body *b, struct Email *e)
       goto cleanup;
   }
 
+  if (attach_pipe_enqueue(pipe, fp, b, buf_string(tfile), opt))
+  {
+    rc = 1; // the pipeline counts the write when it completes
+    goto cleanup;
+  }
+
+  /* A serial save mustn't race a writer that's still busy */
+  attach_pipe_flush(pipe);
+
   rc = save_attachment_flowed_helper(fp, b, buf_string(tfile), opt,
                                      (e || !is_message) ? e : b->email);
 
@@ -446,6 +694,18 @@ void mutt_save_attachment_list(struct AttachCtx *actx, FILE *fp, bool tag,
   const char *const c_attach_sep = cs_subset_string(NeoMutt->sub, "attach_sep");
   const bool c_attach_save_without_prompting = cs_subset_bool(NeoMutt->sub, "attach_save_without_prompting");
 
+  struct AttachPipe *pipe = NULL;
+  if (tag && c_attach_split && c_attach_save_without_prompting)
+  {
+    int tagged = 0;
+    for (int i = 0; i < actx->idxlen; i++)
+    {
+      if (actx->idx[i]->body->tagged)
+        tagged++;
+    }
+    pipe = attach_pipe_new(tagged);
+  }
+
   for (int i = 0; !tag || (i < actx->idxlen); i++)
   {
     if (tag)
@@ -467,9 +727,11 @@ void mutt_save_attachment_list(struct AttachCtx *actx, FILE *fp, bool tag,
         if (c_attach_save_without_prompting)
         {
           // Save each file, with no prompting, using the configured 'AttachSaveDir'
-          rc = save_without_prompting(fp, b, e);
+          rc = save_without_prompting(fp, b, e, pipe);
           if (rc == 0)
             saved_attachments++;
+          else if (rc == 1)
+            rc = 0; // queued; the pipeline counts it on completion
         }
         else
         {
@@ -523,6 +785,15 @@ void mutt_save_attachment_list(struct AttachCtx *actx, FILE *fp, bool tag,
     menu_queue_redraw(menu, MENU_REDRAW_MOTION);
   }
 
+  if (pipe)
+  {
+    attach_pipe_flush(pipe);
+    saved_attachments += pipe->saved;
+    if (pipe->saved != pipe->total)
+      rc = -1; // at least one writer failed; its error is on screen
+    attach_pipe_free(&pipe);
+  }
+
   if (rc == 0)
   {
     if (!c_attach_split)
@@ -1078,6 +1349,74 @@ int mutt_attach_display_loop(struct ConfigSubset *sub, struct Menu *menu, int op
   return op;
 }
 
+/**
+ * attach_starts_collapsed - Will an attachment start off collapsed?
+ * @param actx Attachment context
+ * @param b    Body of attachment
+ * @retval true The attachment will be collapsed by mutt_attach_init()
+ */
+static bool attach_starts_collapsed(struct AttachCtx *actx, struct Body *b)
+{
+  const bool c_digest_collapse = cs_subset_bool(NeoMutt->sub, "digest_collapse");
+  if (!c_digest_collapse)
+    return false;
+
+  if (mutt_istr_equal(actx->email->body->subtype, "digest"))
+    return true;
+
+  return (b->type == TYPE_MULTIPART) && mutt_istr_equal(b->subtype, "digest");
+}
+
+/**
+ * mutt_attach_build - Generate the children of a collapsed attachment
+ * @param actx Attachment context
+ * @param ap   Attachment being expanded
+ *
+ * Attachments that start off collapsed don't have their children generated by
+ * mutt_generate_recvattach_list().  When one is expanded, generate its
+ * subtree and move it into place, so the index stays in depth-first order.
+ */
+void mutt_attach_build(struct AttachCtx *actx, struct AttachPtr *ap)
+{
+  if (!actx || !ap || !ap->unbuilt)
+    return;
+
+  ap->unbuilt = false;
+
+  struct Body *bp = ap->body;
+  const int first = actx->idxlen;
+
+  if (mutt_is_message_type(bp->type, bp->subtype))
+  {
+    mutt_generate_recvattach_list(actx, bp->email, bp->parts, ap->fp, bp->type,
+                                  ap->level + 1, ap->decrypted);
+    actx->email->security |= bp->email->security;
+  }
+  else
+  {
+    mutt_generate_recvattach_list(actx, actx->email, bp->parts, ap->fp,
+                                  bp->type, ap->level + 1, ap->decrypted);
+  }
+
+  const int count = actx->idxlen - first;
+  if (count == 0)
+    return;
+
+  int at = 0;
+  while (actx->idx[at] != ap)
+    at++;
+  if ((at + 1) == first)
+    return; /* the subtree is already in place */
+
+  /* rotate the new block up, directly below its parent */
+  struct AttachPtr **tmp = mutt_mem_malloc(count * sizeof(struct AttachPtr *));
+  memcpy(tmp, &actx->idx[first], count * sizeof(struct AttachPtr *));
+  memmove(&actx->idx[at + 1 + count], &actx->idx[at + 1],
+          (first - at - 1) * sizeof(struct AttachPtr *));
+  memcpy(&actx->idx[at + 1], tmp, count * sizeof(struct AttachPtr *));
+  FREE(&tmp);
+}
+
 /**
  * mutt_generate_recvattach_list - Create a list of attachments
  * @param actx        Attachment context
@@ -1169,6 +1508,15 @@ void mutt_generate_recvattach_list(struct AttachCtx *actx, struct Email *e,
     ap->level = level;
     ap->decrypted = decrypted;
 
+    /* Children of a group that starts off collapsed are only generated when
+     * the group is first expanded; for large digests most never are */
+    if (bp->parts && !need_secured && attach_starts_collapsed(actx, bp))
+    {
+      ap->collapsed = true;
+      ap->unbuilt = true;
+      continue;
+    }
+
     if (mutt_is_message_type(bp->type, bp->subtype))
     {
       mutt_generate_recvattach_list(actx, bp->email, bp->parts, fp, bp->type,
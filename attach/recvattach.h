@@ -27,6 +27,7 @@
 #include <stdio.h>
 
 struct AttachCtx;
+struct AttachPtr;
 struct Body;
 struct BodyArray;
 struct ConfigSubset;
@@ -34,6 +35,7 @@ struct Email;
 struct MailboxView;
 struct Menu;
 
+void mutt_attach_build(struct AttachCtx *actx, struct AttachPtr *ap);
 void mutt_attach_init(struct AttachCtx *actx);
 void mutt_update_tree(struct AttachCtx *actx);
 
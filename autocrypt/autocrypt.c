@@ -131,6 +131,26 @@ void mutt_autocrypt_cleanup(void)
   mutt_autocrypt_db_close();
 }
 
+/**
+ * mutt_autocrypt_batch_begin - Start batching Autocrypt database updates
+ *
+ * Header and gossip processing can write several peer records per message.
+ * Batching the updates from one mailbox open/check into a single transaction
+ * means one fsync per check instead of one per write.
+ */
+void mutt_autocrypt_batch_begin(void)
+{
+  mutt_autocrypt_db_batch_begin();
+}
+
+/**
+ * mutt_autocrypt_batch_end - Commit a batch of Autocrypt database updates
+ */
+void mutt_autocrypt_batch_end(void)
+{
+  mutt_autocrypt_db_batch_end();
+}
+
 /**
  * mutt_autocrypt_account_init - Create a new Autocrypt account
  * @param prompt Prompt the user
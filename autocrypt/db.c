@@ -33,6 +33,7 @@
 #include <sqlite3.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/stat.h>
 #include "private.h"
 #include "mutt/lib.h"
@@ -55,6 +56,13 @@ static sqlite3_stmt *GossipHistoryInsertStmt = NULL; ///< Add to the gossip hist
 /// Handle to the open Autocrypt database
 sqlite3 *AutocryptDB = NULL;
 
+/// Cache of AutocryptPeer records, keyed by normalised email address
+static struct HashTable *PeerCache = NULL;
+/// Number of nested mutt_autocrypt_db_batch_begin() calls
+static int BatchDepth = 0;
+/// Is a batch transaction open on the database?
+static bool BatchOpen = false;
+
 /**
  * autocrypt_db_create - Create an Autocrypt SQLite database
  * @param db_path Path to database file
@@ -157,10 +165,59 @@ void mutt_autocrypt_db_close(void)
   sqlite3_finalize(GossipHistoryInsertStmt);
   GossipHistoryInsertStmt = NULL;
 
+  if (BatchOpen)
+    sqlite3_exec(AutocryptDB, "COMMIT;", NULL, NULL, NULL);
+  BatchOpen = false;
+  BatchDepth = 0;
+
+  mutt_hash_free(&PeerCache);
+
   sqlite3_close_v2(AutocryptDB);
   AutocryptDB = NULL;
 }
 
+/**
+ * autocrypt_db_batch_write - Prepare for a batched database write
+ *
+ * If a batch is active, open its transaction before the first write, so that
+ * all the updates from one mailbox check share a single commit (and fsync).
+ */
+static void autocrypt_db_batch_write(void)
+{
+  if ((BatchDepth == 0) || BatchOpen || !AutocryptDB)
+    return;
+
+  if (sqlite3_exec(AutocryptDB, "BEGIN IMMEDIATE;", NULL, NULL, NULL) == SQLITE_OK)
+    BatchOpen = true;
+}
+
+/**
+ * mutt_autocrypt_db_batch_begin - Start batching Autocrypt database writes
+ *
+ * Calls may be nested.  The transaction is opened lazily by the first write
+ * and committed by the matching mutt_autocrypt_db_batch_end(), so a batch
+ * without writes costs nothing and the write lock is held only briefly.
+ */
+void mutt_autocrypt_db_batch_begin(void)
+{
+  BatchDepth++;
+}
+
+/**
+ * mutt_autocrypt_db_batch_end - Commit a batch of Autocrypt database writes
+ */
+void mutt_autocrypt_db_batch_end(void)
+{
+  if (BatchDepth > 0)
+    BatchDepth--;
+
+  if ((BatchDepth == 0) && BatchOpen)
+  {
+    sqlite3_exec(AutocryptDB, "COMMIT;", NULL, NULL, NULL);
+    BatchOpen = false;
+  }
+}
+
 /**
  * mutt_autocrypt_db_normalize_addr - Normalise an Email Address
  * @param a Address to normalise
@@ -548,6 +605,64 @@ void mutt_autocrypt_db_peer_free(struct AutocryptPeer **ptr)
   FREE(ptr);
 }
 
+/**
+ * peer_copy - Duplicate an AutocryptPeer
+ * @param peer AutocryptPeer to copy
+ * @retval ptr Copy of the peer
+ */
+static struct AutocryptPeer *peer_copy(const struct AutocryptPeer *peer)
+{
+  struct AutocryptPeer *copy = mutt_autocrypt_db_peer_new();
+
+  copy->email_addr = mutt_str_dup(peer->email_addr);
+  copy->last_seen = peer->last_seen;
+  copy->autocrypt_timestamp = peer->autocrypt_timestamp;
+  copy->keyid = mutt_str_dup(peer->keyid);
+  copy->keydata = mutt_str_dup(peer->keydata);
+  copy->prefer_encrypt = peer->prefer_encrypt;
+  copy->gossip_timestamp = peer->gossip_timestamp;
+  copy->gossip_keyid = mutt_str_dup(peer->gossip_keyid);
+  copy->gossip_keydata = mutt_str_dup(peer->gossip_keydata);
+
+  return copy;
+}
+
+/**
+ * peer_cache_free_entry - Free a cached AutocryptPeer - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void peer_cache_free_entry(int type, void *obj, intptr_t data)
+{
+  struct AutocryptPeer *peer = obj;
+  mutt_autocrypt_db_peer_free(&peer);
+}
+
+/**
+ * peer_cache_set - Cache the database record for a peer
+ * @param email_addr Normalised email address (the cache key)
+ * @param peer       AutocryptPeer to cache
+ *
+ * The cache saves re-querying (and re-parsing the keydata of) peers that are
+ * looked up once per message during header and gossip processing.
+ */
+static void peer_cache_set(const char *email_addr, const struct AutocryptPeer *peer)
+{
+  if (!email_addr)
+    return;
+
+  if (!PeerCache)
+  {
+    PeerCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(PeerCache, peer_cache_free_entry, 0);
+  }
+
+  struct AutocryptPeer *copy = peer_copy(peer);
+  if (!copy->email_addr)
+    copy->email_addr = mutt_str_dup(email_addr);
+
+  mutt_hash_delete(PeerCache, email_addr, NULL);
+  mutt_hash_insert(PeerCache, email_addr, copy);
+}
+
 /**
  * mutt_autocrypt_db_peer_get - Get peer info from the Autocrypt database
  * @param[in]  addr Email Address to look up
@@ -563,6 +678,17 @@ int mutt_autocrypt_db_peer_get(struct Address *addr, struct AutocryptPeer **peer
   struct Address *norm_addr = copy_normalize_addr(addr);
   *peer = NULL;
 
+  if (PeerCache)
+  {
+    struct AutocryptPeer *cached = mutt_hash_find(PeerCache, buf_string(norm_addr->mailbox));
+    if (cached)
+    {
+      *peer = peer_copy(cached);
+      mutt_addr_free(&norm_addr);
+      return 1;
+    }
+  }
+
   if (!PeerGetStmt)
   {
     if (sqlite3_prepare_v3(AutocryptDB,
@@ -609,6 +735,8 @@ int mutt_autocrypt_db_peer_get(struct Address *addr, struct AutocryptPeer **peer
   (*peer)->gossip_keyid = strdup_column_text(PeerGetStmt, 7);
   (*peer)->gossip_keydata = strdup_column_text(PeerGetStmt, 8);
 
+  peer_cache_set(buf_string(norm_addr->mailbox), *peer);
+
   rc = 1;
 
 cleanup:
@@ -631,6 +759,8 @@ int mutt_autocrypt_db_peer_insert(struct Address *addr, struct AutocryptPeer *pe
 
   norm_addr = copy_normalize_addr(addr);
 
+  autocrypt_db_batch_write();
+
   if (!PeerInsertStmt)
   {
     if (sqlite3_prepare_v3(AutocryptDB,
@@ -676,6 +806,8 @@ int mutt_autocrypt_db_peer_insert(struct Address *addr, struct AutocryptPeer *pe
   if (sqlite3_step(PeerInsertStmt) != SQLITE_DONE)
     goto cleanup;
 
+  peer_cache_set(buf_string(norm_addr->mailbox), peer);
+
   rc = 0;
 
 cleanup:
@@ -694,6 +826,8 @@ int mutt_autocrypt_db_peer_update(struct AutocryptPeer *peer)
 {
   int rc = -1;
 
+  autocrypt_db_batch_write();
+
   if (!PeerUpdateStmt)
   {
     if (sqlite3_prepare_v3(AutocryptDB,
@@ -735,6 +869,8 @@ int mutt_autocrypt_db_peer_update(struct AutocryptPeer *peer)
   if (sqlite3_step(PeerUpdateStmt) != SQLITE_DONE)
     goto cleanup;
 
+  peer_cache_set(peer->email_addr, peer);
+
   rc = 0;
 
 cleanup:
@@ -781,6 +917,8 @@ int mutt_autocrypt_db_peer_history_insert(struct Address *addr,
 
   struct Address *norm_addr = copy_normalize_addr(addr);
 
+  autocrypt_db_batch_write();
+
   if (!PeerHistoryInsertStmt)
   {
     if (sqlite3_prepare_v3(AutocryptDB,
@@ -863,6 +1001,8 @@ int mutt_autocrypt_db_gossip_history_insert(struct Address *addr,
 
   struct Address *norm_addr = copy_normalize_addr(addr);
 
+  autocrypt_db_batch_write();
+
   if (!GossipHistoryInsertStmt)
   {
     if (sqlite3_prepare_v3(AutocryptDB,
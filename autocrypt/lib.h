@@ -167,6 +167,8 @@ extern char *AutocryptSignAs;
 extern char *AutocryptDefaultKey;
 
 void              dlg_autocrypt                          (void);
+void              mutt_autocrypt_batch_begin             (void);
+void              mutt_autocrypt_batch_end               (void);
 void              mutt_autocrypt_cleanup                 (void);
 int               mutt_autocrypt_generate_gossip_list    (struct Email *e);
 int               mutt_autocrypt_init                    (bool can_create);
@@ -0,0 +1,285 @@
+/**
+ * @file
+ * Run external commands in the background
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_background Run external commands in the background
+ *
+ * Run external commands in the background
+ *
+ * Commands are handed to the ThreadPool, where a worker fork()s a shell and
+ * waits for it, with the command's output collected in a temporary file.  The
+ * UI stays responsive: completions are drained from the main event loop on the
+ * #NT_TIMEOUT tick and any output is shown in the Pager.
+ */
+
+#include "config.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "core/lib.h"
+#include "background.h"
+#include "globals.h"
+#include "muttlib.h"
+#include "pager/lib.h"
+
+/// Number of workers running background commands
+#define BACKGROUND_NUM_WORKERS 2
+
+/**
+ * struct BackgroundCommand - An external command running in the background
+ */
+struct BackgroundCommand
+{
+  char *cmd;      ///< Command line being run
+  char *banner;   ///< Title to use when showing the output
+  char *tempfile; ///< Temporary file collecting stdout and stderr
+  int rc;         ///< Exit status of the command, -1 on error
+};
+
+/// Worker pool running background commands, created on demand
+static struct ThreadPool *BackgroundPool = NULL;
+/// True while a completion callback is on screen, to stop nested drains
+static bool BackgroundDraining = false;
+/// True during shutdown: completions are discarded rather than displayed
+static bool BackgroundShutdown = false;
+
+/**
+ * background_command_free - Free a BackgroundCommand
+ * @param ptr BackgroundCommand to free
+ */
+static void background_command_free(struct BackgroundCommand **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct BackgroundCommand *bc = *ptr;
+
+  FREE(&bc->cmd);
+  FREE(&bc->banner);
+  FREE(&bc->tempfile);
+  FREE(ptr);
+}
+
+/**
+ * background_work - Run a command - Implements ::tpool_work_t - @ingroup tpool_work_api
+ *
+ * Runs on a worker thread.  fork() a shell with stdout and stderr redirected
+ * to the temporary file, then wait for it.
+ */
+static void background_work(void *wdata)
+{
+  struct BackgroundCommand *bc = wdata;
+
+  bc->rc = -1;
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    int fd = open("/dev/null", O_RDONLY);
+    if (fd >= 0)
+    {
+      dup2(fd, STDIN_FILENO);
+      close(fd);
+    }
+    fd = open(bc->tempfile, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd >= 0)
+    {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    mutt_sig_reset_child_signals();
+    execle(EXEC_SHELL, "sh", "-c", bc->cmd, NULL, EnvList);
+    _exit(127); /* execl error */
+  }
+
+  if (pid < 0)
+    return;
+
+  int status = 0;
+  if (waitpid(pid, &status, 0) == pid)
+    bc->rc = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * background_done - Report a finished command - Implements ::tpool_done_t - @ingroup tpool_done_api
+ *
+ * Runs on the main thread, via tpool_drain().  Show the command's output in
+ * the Pager, or just its exit status if it was silent.
+ */
+static void background_done(void *wdata)
+{
+  struct BackgroundCommand *bc = wdata;
+
+  struct stat st = { 0 };
+  const bool have_output = !BackgroundShutdown && (bc->rc >= 0) &&
+                           (stat(bc->tempfile, &st) == 0) && (st.st_size > 0);
+
+  if (have_output)
+  {
+    struct PagerData pdata = { 0 };
+    struct PagerView pview = { &pdata };
+
+    pdata.fname = bc->tempfile;
+
+    pview.banner = bc->banner;
+    pview.flags = MUTT_PAGER_NO_FLAGS;
+    pview.mode = PAGER_MODE_OTHER;
+
+    mutt_do_pager(&pview, NULL); /* deletes the tempfile */
+  }
+  else
+  {
+    unlink(bc->tempfile);
+    if (!BackgroundShutdown)
+    {
+      if (bc->rc < 0)
+        mutt_error(_("Error running \"%s\""), bc->cmd);
+      else
+        mutt_message(_("Command \"%s\" finished (exit %d)"), bc->banner, bc->rc);
+    }
+  }
+
+  background_command_free(&bc);
+}
+
+/**
+ * background_timeout_observer - Notification that a timeout has occurred - Implements ::observer_t - @ingroup observer_api
+ *
+ * The event loop sends #NT_TIMEOUT every second while waiting for a key.
+ * Use the tick to drain finished commands.
+ */
+static int background_timeout_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_TIMEOUT)
+    return 0;
+
+  if (!BackgroundPool || BackgroundDraining)
+    return 0;
+
+  /* background_done() may open the Pager, whose event loop ticks too */
+  BackgroundDraining = true;
+  tpool_drain(BackgroundPool);
+  BackgroundDraining = false;
+
+  return 0;
+}
+
+/**
+ * background_command_run - Run an external command in the background
+ * @param cmd    Command line to run
+ * @param banner Title to use when showing the output
+ * @retval  0 Success, command submitted
+ * @retval -1 Error
+ *
+ * The command runs detached from the terminal: stdin is /dev/null and any
+ * output is collected and shown in the Pager when the command finishes.
+ */
+int background_command_run(const char *cmd, const char *banner)
+{
+  if (!cmd || (*cmd == '\0'))
+    return -1;
+
+  if (!BackgroundPool)
+  {
+    BackgroundPool = tpool_new(BACKGROUND_NUM_WORKERS);
+    if (!BackgroundPool)
+      return -1;
+    notify_observer_add(NeoMutt->notify, NT_TIMEOUT, background_timeout_observer, NULL);
+  }
+
+  struct Buffer *tempfile = buf_pool_get();
+  buf_mktemp(tempfile);
+
+  struct BackgroundCommand *bc = mutt_mem_calloc(1, sizeof(struct BackgroundCommand));
+  bc->cmd = mutt_str_dup(cmd);
+  bc->banner = mutt_str_dup(banner);
+  bc->tempfile = buf_strdup(tempfile);
+  buf_pool_release(&tempfile);
+
+  if (!tpool_submit(BackgroundPool, background_work, background_done, bc))
+  {
+    background_command_free(&bc);
+    return -1;
+  }
+
+  mutt_message(_("Running \"%s\" in the background"), bc->banner);
+  return 0;
+}
+
+/**
+ * background_filter_wait - Responsive wait for a filter process
+ * @param pid Process id of the filter to wait for
+ * @retval num Exit status of the process identified by pid
+ * @retval -1  Error
+ *
+ * A drop-in for filter_wait() that stays interruptible: poll the process
+ * rather than block in waitpid(), so the user can abort a slow filter with
+ * Ctrl-C (the filter is sent SIGTERM).
+ */
+int background_filter_wait(pid_t pid)
+{
+  int status = 0;
+  pid_t wpid;
+
+  /* filter_create() left SIGINT ignored and SIGCHLD blocked */
+  mutt_sig_unblock_system(true);
+  mutt_sig_allow_interrupt(true);
+
+  while ((wpid = waitpid(pid, &status, WNOHANG)) == 0)
+  {
+    if (SigInt)
+    {
+      SigInt = false;
+      kill(pid, SIGTERM);
+    }
+    mutt_date_sleep_ms(50);
+  }
+
+  mutt_sig_allow_interrupt(false);
+
+  if (wpid != pid)
+    return -1;
+
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * background_cleanup - Shut down the background command facility
+ *
+ * Wait for any commands still running; their output is discarded.
+ */
+void background_cleanup(void)
+{
+  if (!BackgroundPool)
+    return;
+
+  BackgroundShutdown = true;
+  notify_observer_remove(NeoMutt->notify, background_timeout_observer, NULL);
+  tpool_free(&BackgroundPool); /* waits, then drains via background_done() */
+}
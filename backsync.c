@@ -0,0 +1,152 @@
+/**
+ * @file
+ * Idle-time flushing of pending flag changes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_backsync Idle-time flushing of pending flag changes
+ *
+ * Flag changes normally accumulate in memory until the user syncs the
+ * mailbox, then they're all written at once - a noticeable stall after a
+ * long triage session.  While the index is idle, flush up to
+ * `$background_sync` changed messages per tick instead, so the final sync
+ * has little left to do.
+ *
+ * Only Maildir mailboxes are flushed: a flag change there is a single
+ * rename, safe to perform piecemeal.  Deletions always wait for an
+ * explicit sync, because purging needs the user's confirmation.
+ */
+
+#include "config.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "email/lib.h"
+#include "backsync.h"
+#include "maildir/hcache.h"
+#include "maildir/shared.h"
+#include "flagjournal.h"
+
+/// Mailbox the resume cursor belongs to
+static struct Mailbox *LastMailbox = NULL;
+/// Index of the next message to examine
+static int Cursor = 0;
+
+/**
+ * backsync_step - Flush a batch of pending flag changes
+ * @param m Mailbox currently open in the index
+ * @retval true Some messages were flushed
+ *
+ * Called when the index is idle.  At most `$background_sync` messages are
+ * written per call; the scan resumes where it left off on the next tick.
+ * Once a full pass finds nothing left to write, the mailbox is marked
+ * unchanged and the flag journal is cleared.
+ */
+bool backsync_step(struct Mailbox *m)
+{
+  const short c_background_sync = cs_subset_number(NeoMutt->sub, "background_sync");
+  if (c_background_sync < 1)
+    return false;
+
+  if (!m || (m->type != MUTT_MAILDIR) || m->readonly || m->dontwrite || !m->changed)
+    return false;
+
+  if (m != LastMailbox)
+  {
+    LastMailbox = m;
+    Cursor = 0;
+  }
+  if (Cursor >= m->msg_count)
+    Cursor = 0;
+
+  /* flags may change behind the cursor between ticks, so the mailbox only
+   * counts as clean after one uninterrupted pass over the whole array */
+  const bool from_start = (Cursor == 0);
+
+  struct HeaderCache *hc = NULL;
+  int dirfd = -1;
+  bool opened = false;
+  bool pending = false;
+  int flushed = 0;
+
+  int i = Cursor;
+  for (; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+
+    /* Deletions need the user's say-so; attachment deletion and an edited
+     * envelope mean rewriting the file - all of those wait for a real sync */
+    if (e->deleted || e->attach_del || e->env->changed)
+    {
+      pending = true;
+      continue;
+    }
+
+    if (!e->changed)
+      continue;
+
+    if (flushed == c_background_sync)
+      break;
+
+    if (!opened)
+    {
+      hc = maildir_hcache_open(m);
+      dirfd = open(mailbox_path(m), O_RDONLY | O_DIRECTORY);
+      opened = true;
+    }
+
+    if (!maildir_sync_mailbox_message(m, e, hc, dirfd))
+    {
+      /* leave e->changed set so a real sync retries and reports the error */
+      pending = true;
+      continue;
+    }
+
+    e->changed = false;
+    flushed++;
+  }
+  Cursor = i;
+
+  if (opened)
+  {
+    if (dirfd >= 0)
+      close(dirfd);
+    maildir_hcache_close(&hc);
+
+    /* our own renames shouldn't look like another program's changes */
+    maildir_update_mtime(m);
+  }
+
+  if (from_start && (i == m->msg_count) && !pending && (m->msg_deleted == 0))
+  {
+    m->changed = false;
+    flag_journal_clear(m);
+  }
+
+  if (flushed > 0)
+    mutt_debug(LL_DEBUG2, "flushed %d of %s\n", flushed, mailbox_path(m));
+
+  return flushed > 0;
+}
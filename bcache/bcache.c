@@ -34,6 +34,7 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <utime.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -41,6 +42,7 @@
 #include "lib.h"
 #include "mutt_account.h"
 #include "muttlib.h"
+#include "sort.h"
 
 struct ConnAccount;
 
@@ -52,6 +54,117 @@ struct BodyCache
   char *path; ///< On-disk path to the file
 };
 
+/**
+ * struct PruneEntry - A cached message that may be evicted
+ */
+struct PruneEntry
+{
+  char *path;  ///< Full path to the cached file
+  off_t size;  ///< Size of the file in bytes
+  time_t used; ///< When the file was last read or written
+};
+ARRAY_HEAD(PruneArray, struct PruneEntry);
+
+/**
+ * prune_sort_used - Compare two PruneEntries by last use - Implements ::sort_t - @ingroup sort_api
+ */
+static int prune_sort_used(const void *a, const void *b, void *sdata)
+{
+  const struct PruneEntry *pa = a;
+  const struct PruneEntry *pb = b;
+
+  return mutt_numeric_cmp(pa->used, pb->used);
+}
+
+/**
+ * bcache_prune_scan - Collect the cached messages below a directory
+ * @param[in]  dir   Directory to scan
+ * @param[out] files Array to add the files to
+ * @param[out] total Running total of the files' sizes
+ */
+static void bcache_prune_scan(const char *dir, struct PruneArray *files, off_t *total)
+{
+  DIR *d = mutt_file_opendir(dir, MUTT_OPENDIR_NONE);
+  if (!d)
+    return;
+
+  struct Buffer *path = buf_pool_get();
+  struct dirent *de = NULL;
+  while ((de = readdir(d)))
+  {
+    if (mutt_str_equal(de->d_name, ".") || mutt_str_equal(de->d_name, ".."))
+      continue;
+
+    buf_printf(path, "%s/%s", dir, de->d_name);
+
+    struct stat st = { 0 };
+    if (stat(buf_string(path), &st) != 0)
+      continue;
+
+    if (S_ISDIR(st.st_mode))
+    {
+      bcache_prune_scan(buf_string(path), files, total);
+    }
+    else if (S_ISREG(st.st_mode))
+    {
+      struct PruneEntry pe = { buf_strdup(path), st.st_size, st.st_mtime };
+      ARRAY_ADD(files, pe);
+      *total += st.st_size;
+    }
+  }
+
+  buf_pool_release(&path);
+  closedir(d);
+}
+
+/**
+ * bcache_prune - Evict least recently used messages over $message_cache_size
+ *
+ * mutt_bcache_get() bumps the mtime of every message it finds, so the mtimes
+ * across the cache give the order of last use.  Scan the whole of
+ * $message_cache_dir (the cap covers all accounts, not just the current one)
+ * and unlink the oldest messages until the rest fit.  Runs at most once per
+ * session, from the first mutt_bcache_open().
+ */
+static void bcache_prune(void)
+{
+  static bool pruned = false;
+  if (pruned)
+    return;
+  pruned = true;
+
+  const long c_message_cache_size = cs_subset_long(NeoMutt->sub, "message_cache_size");
+  const char *const c_message_cache_dir = cs_subset_path(NeoMutt->sub, "message_cache_dir");
+  if ((c_message_cache_size <= 0) || !c_message_cache_dir)
+    return;
+
+  struct PruneArray files = ARRAY_HEAD_INITIALIZER;
+  off_t total = 0;
+  bcache_prune_scan(c_message_cache_dir, &files, &total);
+
+  if (total > c_message_cache_size)
+  {
+    ARRAY_SORT(&files, prune_sort_used, NULL);
+
+    struct PruneEntry *pe = NULL;
+    ARRAY_FOREACH(pe, &files)
+    {
+      if (total <= c_message_cache_size)
+        break;
+      mutt_debug(LL_DEBUG3, "bcache: prune: '%s'\n", pe->path);
+      if (unlink(pe->path) == 0)
+        total -= pe->size;
+    }
+  }
+
+  struct PruneEntry *pe = NULL;
+  ARRAY_FOREACH(pe, &files)
+  {
+    FREE(&pe->path);
+  }
+  ARRAY_FREE(&files);
+}
+
 /**
  * bcache_path - Create the cache path for a given account/mailbox
  * @param account Account info
@@ -157,6 +270,8 @@ struct BodyCache *mutt_bcache_open(struct ConnAccount *account, const char *mail
     return NULL;
   }
 
+  bcache_prune();
+
   return bcache;
 }
 
@@ -194,6 +309,11 @@ FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id)
   buf_addstr(path, id);
 
   FILE *fp = mutt_file_fopen(buf_string(path), "r");
+  if (fp)
+  {
+    // Mark it as recently used, so bcache_prune() evicts it last
+    utime(buf_string(path), NULL);
+  }
 
   mutt_debug(LL_DEBUG3, "bcache: get: '%s': %s\n", buf_string(path), fp ? "yes" : "no");
 
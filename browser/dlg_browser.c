@@ -76,6 +76,7 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <grp.h>
 #include <limits.h>
 #include <locale.h>
@@ -778,6 +779,16 @@ int examine_directory(struct Mailbox *m, struct Menu *menu, struct BrowserState
     struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
     neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
 
+    /* Index the configured mailboxes by path, so each directory entry is a
+     * hash lookup rather than a walk of the whole list */
+    struct HashTable *mb_paths = mutt_hash_new(64, MUTT_HASH_NO_FLAGS);
+    struct MailboxNode *np = NULL;
+    STAILQ_FOREACH(np, &ml, entries)
+    {
+      mutt_hash_insert(mb_paths, mailbox_path(np->mailbox), np->mailbox);
+    }
+
+    const int dfd = dirfd(dir);
     const struct Regex *c_mask = cs_subset_regex(NeoMutt->sub, "mask");
     while ((de = readdir(dir)))
     {
@@ -793,8 +804,8 @@ int examine_directory(struct Mailbox *m, struct Menu *menu, struct BrowserState
         continue;
       }
 
-      buf_concat_path(buf, dirname, de->d_name);
-      if (lstat(buf_string(buf), &st) == -1)
+      /* fstatat() saves the kernel resolving the directory path per entry */
+      if (fstatat(dfd, de->d_name, &st, AT_SYMLINK_NOFOLLOW) == -1)
         continue;
 
       /* No size for directories or symlinks */
@@ -803,20 +814,17 @@ int examine_directory(struct Mailbox *m, struct Menu *menu, struct BrowserState
       else if (!S_ISREG(st.st_mode))
         continue;
 
-      struct MailboxNode *np = NULL;
-      STAILQ_FOREACH(np, &ml, entries)
-      {
-        if (mutt_str_equal(buf_string(buf), mailbox_path(np->mailbox)))
-          break;
-      }
+      buf_concat_path(buf, dirname, de->d_name);
+      struct Mailbox *m_entry = mutt_hash_find(mb_paths, buf_string(buf));
 
-      if (np && m && m->poll_new_mail && mutt_str_equal(np->mailbox->realpath, m->realpath))
+      if (m_entry && m && m->poll_new_mail && mutt_str_equal(m_entry->realpath, m->realpath))
       {
-        np->mailbox->msg_count = m->msg_count;
-        np->mailbox->msg_unread = m->msg_unread;
+        m_entry->msg_count = m->msg_count;
+        m_entry->msg_unread = m->msg_unread;
       }
-      browser_add_folder(menu, state, de->d_name, NULL, &st, np ? np->mailbox : NULL, NULL);
+      browser_add_folder(menu, state, de->d_name, NULL, &st, m_entry, NULL);
     }
+    mutt_hash_free(&mb_paths);
     neomutt_mailboxlist_clear(&ml);
     closedir(dir);
   }
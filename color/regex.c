@@ -62,6 +62,113 @@ struct RegexColorList IndexTagsList;      ///< List of colours applied to the ta
 struct RegexColorList StatusList;         ///< List of colours applied to the status bar
 // clang-format on
 
+/// Bumped whenever a regex colour is added or removed,
+/// so the pager can tell when its cached match results are stale
+static unsigned int RegexColorsGeneration = 1;
+
+/**
+ * regex_colors_generation - Get the generation number of the Regex colours
+ * @retval num Generation number
+ *
+ * The number changes whenever a regex colour is added or removed.
+ */
+unsigned int regex_colors_generation(void)
+{
+  return RegexColorsGeneration;
+}
+
+/**
+ * regex_literal - Extract a literal substring that a regex requires
+ * @param s Regex pattern
+ * @retval ptr  Longest literal substring every match must contain
+ * @retval NULL No usable literal
+ *
+ * A line that doesn't contain the literal can't match the regex, so the
+ * pager can skip regexec() for it.  The analysis is conservative: patterns
+ * using alternation or groups yield no literal, and escapes, classes and
+ * quantifiers just end the current run.
+ */
+static char *regex_literal(const char *s)
+{
+  size_t best_start = 0;
+  size_t best_len = 0;
+  size_t start = 0;
+  size_t len = 0;
+
+  for (size_t i = 0; s[i] != '\0'; i++)
+  {
+    switch (s[i])
+    {
+      case '(':
+      case ')':
+      case '|':
+        return NULL; /* any branch might match without the literal */
+
+      case '*':
+      case '?':
+        if (len > 0) /* the preceding char is optional */
+          len--;
+        break;
+
+      case '{':
+        if (len > 0) /* don't reason about counted repeats */
+          len--;
+        while (s[i] && (s[i] != '}'))
+          i++;
+        if (!s[i])
+          i--;
+        break;
+
+      case '\\':
+        if (s[i + 1])
+          i++;
+        break;
+
+      case '[':
+        i++;
+        if (s[i] == '^')
+          i++;
+        if (s[i] == ']')
+          i++;
+        while (s[i] && (s[i] != ']'))
+          i++;
+        if (!s[i])
+          i--;
+        break;
+
+      case '.':
+      case '^':
+      case '$':
+      case '+': /* one repetition is guaranteed, but the run ends here */
+        break;
+
+      default:
+        if (len == 0)
+          start = i;
+        len++;
+        continue;
+    }
+
+    if (len > best_len)
+    {
+      best_start = start;
+      best_len = len;
+    }
+    len = 0;
+  }
+
+  if (len > best_len)
+  {
+    best_start = start;
+    best_len = len;
+  }
+
+  if (best_len == 0)
+    return NULL;
+
+  return mutt_strn_dup(s + best_start, best_len);
+}
+
 /**
  * regex_colors_init - Initialise the Regex colours
  */
@@ -124,6 +231,7 @@ void regex_color_clear(struct RegexColor *rcol)
 
   attr_color_clear(&rcol->attr_color);
   FREE(&rcol->pattern);
+  FREE(&rcol->literal);
   regfree(&rcol->regex);
   mutt_pattern_free(&rcol->color_pattern);
 }
@@ -140,6 +248,7 @@ void regex_color_free(struct RegexColorList *list, struct RegexColor **ptr)
 
   struct RegexColor *rcol = *ptr;
   regex_color_clear(rcol);
+  RegexColorsGeneration++;
 
   FREE(ptr);
 }
@@ -288,6 +397,8 @@ static enum CommandResult add_pattern(struct RegexColorList *rcl, const char *s,
         regex_color_free(rcl, &rcol);
         return MUTT_CMD_ERROR;
       }
+      rcol->literal = regex_literal(s);
+      rcol->literal_icase = (flags & REG_ICASE);
     }
     rcol->pattern = mutt_str_dup(s);
     rcol->match = match;
@@ -297,6 +408,7 @@ static enum CommandResult add_pattern(struct RegexColorList *rcl, const char *s,
     attr_color_overwrite(ac, ac_val);
 
     STAILQ_INSERT_TAIL(rcl, rcol, entries);
+    RegexColorsGeneration++;
   }
 
   if (is_index)
@@ -39,8 +39,10 @@ struct RegexColor
   regex_t regex;                     ///< Compiled regex
   int match;                         ///< Substring to match, 0 for old behaviour
   struct PatternList *color_pattern; ///< Compiled pattern to speed up index color calculation
+  char *literal;                     ///< Literal substring the regex requires, or NULL
 
   bool stop_matching : 1;            ///< Used by the pager for body patterns, to prevent the color from being retried once it fails
+  bool literal_icase : 1;            ///< Literal must be matched case-insensitively
 
   STAILQ_ENTRY(RegexColor) entries;  ///< Linked list
 };
@@ -51,6 +53,7 @@ void                   regex_color_free(struct RegexColorList *list, struct Rege
 struct RegexColor *    regex_color_new (void);
 
 void                   regex_colors_cleanup(void);
+unsigned int           regex_colors_generation(void);
 struct RegexColorList *regex_colors_get_list(enum ColorId cid);
 void                   regex_colors_init(void);
 
@@ -38,6 +38,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/types.h>
@@ -63,6 +64,7 @@
 #include "globals.h"
 #include "muttlib.h"
 #include "mx.h"
+#include "rccache.h"
 #include "score.h"
 #include "version.h"
 #ifdef USE_INOTIFY
@@ -197,22 +199,69 @@ char *mutt_get_sourced_cwd(void)
   return ret;
 }
 
+/**
+ * source_rc_line - Parse one logical line of an rc file
+ * @param[in]     currentline Line to parse
+ * @param[in]     rcfile      Path of the file, for error messages
+ * @param[in]     lineno      Line number in the file, for error messages
+ * @param[in]     linebuf     Scratch Buffer for the line
+ * @param[in]     token       Scratch Buffer for the parser
+ * @param[in,out] err         Buffer for error messages
+ * @param[in,out] rc          Cumulative result of the file, 0 or an error count
+ * @param[in,out] warnings    Number of warnings so far
+ * @retval true Stop reading the file (`finish`, or too many errors)
+ */
+static bool source_rc_line(const char *currentline, const char *rcfile,
+                           int lineno, struct Buffer *linebuf, struct Buffer *token,
+                           struct Buffer *err, int *rc, int *warnings)
+{
+  buf_strcpy(linebuf, currentline);
+
+  buf_reset(err);
+  enum CommandResult line_rc = parse_rc_buffer(linebuf, token, err);
+  if (line_rc == MUTT_CMD_ERROR)
+  {
+    mutt_error("%s:%d: %s", rcfile, lineno, buf_string(err));
+    if (--(*rc) < -MAX_ERRS)
+      return true;
+  }
+  else if (line_rc == MUTT_CMD_WARNING)
+  {
+    /* Warning */
+    mutt_warning("%s:%d: %s", rcfile, lineno, buf_string(err));
+    (*warnings)++;
+  }
+  else if (line_rc == MUTT_CMD_FINISH)
+  {
+    return true; /* Found "finish" command */
+  }
+  else
+  {
+    if (*rc < 0)
+      *rc = -1;
+  }
+
+  return false;
+}
+
 /**
  * source_rc - Read an initialization file
  * @param rcfile_path Path to initialization file
  * @param err         Buffer for error messages
  * @retval <0 NeoMutt should pause to let the user know
+ *
+ * With `$config_cache` set, the preprocessed lines of the file may be
+ * replayed from the cache instead of reading the file, see @ref neo_rccache.
  */
 int source_rc(const char *rcfile_path, struct Buffer *err)
 {
   int lineno = 0, rc = 0, warnings = 0;
-  enum CommandResult line_rc;
   struct Buffer *token = NULL, *linebuf = NULL;
   char *line = NULL;
   char *currentline = NULL;
   char rcfile[PATH_MAX] = { 0 };
   size_t linelen = 0;
-  pid_t pid;
+  pid_t pid = -1;
 
   mutt_str_copy(rcfile, rcfile_path, sizeof(rcfile));
 
@@ -248,73 +297,85 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
   }
 
   mutt_debug(LL_DEBUG2, "Reading configuration file '%s'\n", rcfile);
+  const uint64_t start_ms = mutt_date_now_ms();
+
+  struct RcFileCache *cached = NULL;
+  struct RcFileCache *record = NULL;
+  FILE *fp = NULL;
 
-  FILE *fp = mutt_open_read(rcfile, &pid);
-  if (!fp)
+  if (!ispipe)
+    cached = rc_cache_find(rcfile);
+
+  if (!cached)
   {
-    buf_printf(err, "%s: %s", rcfile, strerror(errno));
-    return -1;
+    fp = mutt_open_read(rcfile, &pid);
+    if (!fp)
+    {
+      buf_printf(err, "%s: %s", rcfile, strerror(errno));
+      return -1;
+    }
+    if (!ispipe)
+      record = rc_cache_record_start(rcfile);
   }
 
   token = buf_pool_get();
   linebuf = buf_pool_get();
 
-  const char *const c_config_charset = cs_subset_string(NeoMutt->sub, "config_charset");
-  const char *const c_charset = cc_charset();
-  while ((line = mutt_file_read_line(line, &linelen, fp, &lineno, MUTT_RL_CONT)) != NULL)
+  if (cached)
   {
-    const bool conv = c_config_charset && c_charset;
-    if (conv)
+    struct RcCacheLine *cl = NULL;
+    ARRAY_FOREACH(cl, &cached->lines)
     {
-      currentline = mutt_str_dup(line);
-      if (!currentline)
-        continue;
-      mutt_ch_convert_string(&currentline, c_config_charset, c_charset, MUTT_ICONV_NO_FLAGS);
-    }
-    else
-    {
-      currentline = line;
+      if (source_rc_line(cl->text, rcfile, cl->lineno, linebuf, token, err, &rc, &warnings))
+        break;
     }
-
-    buf_strcpy(linebuf, currentline);
-
-    buf_reset(err);
-    line_rc = parse_rc_buffer(linebuf, token, err);
-    if (line_rc == MUTT_CMD_ERROR)
+  }
+  else
+  {
+    const char *const c_config_charset = cs_subset_string(NeoMutt->sub, "config_charset");
+    const char *const c_charset = cc_charset();
+    while ((line = mutt_file_read_line(line, &linelen, fp, &lineno, MUTT_RL_CONT)) != NULL)
     {
-      mutt_error("%s:%d: %s", rcfile, lineno, buf_string(err));
-      if (--rc < -MAX_ERRS)
+      const bool conv = c_config_charset && c_charset;
+      if (conv)
       {
-        if (conv)
-          FREE(&currentline);
-        break;
+        currentline = mutt_str_dup(line);
+        if (!currentline)
+          continue;
+        mutt_ch_convert_string(&currentline, c_config_charset, c_charset, MUTT_ICONV_NO_FLAGS);
       }
-    }
-    else if (line_rc == MUTT_CMD_WARNING)
-    {
-      /* Warning */
-      mutt_warning("%s:%d: %s", rcfile, lineno, buf_string(err));
-      warnings++;
-    }
-    else if (line_rc == MUTT_CMD_FINISH)
-    {
+      else
+      {
+        currentline = line;
+      }
+
+      if (record)
+        rc_cache_record_line(record, lineno, currentline);
+
+      const bool stop = source_rc_line(currentline, rcfile, lineno, linebuf,
+                                       token, err, &rc, &warnings);
       if (conv)
         FREE(&currentline);
-      break; /* Found "finish" command */
+      if (stop)
+        break;
     }
+
+    FREE(&line);
+    mutt_file_fclose(&fp);
+    if (pid != -1)
+      filter_wait(pid);
+  }
+
+  if (record)
+  {
+    if (rc == 0)
+      rc_cache_record_finish(record);
     else
-    {
-      if (rc < 0)
-        rc = -1;
-    }
-    if (conv)
-      FREE(&currentline);
+      rc_cache_record_abort(&record);
   }
 
-  FREE(&line);
-  mutt_file_fclose(&fp);
-  if (pid != -1)
-    filter_wait(pid);
+  mutt_debug(LL_DEBUG1, "Reading '%s' took %llu ms\n", rcfile,
+             (unsigned long long) (mutt_date_now_ms() - start_ms));
 
   if (rc)
   {
@@ -594,6 +655,7 @@ static enum CommandResult parse_lists(struct Buffer *buf, struct Buffer *s,
       goto bail;
 
     mutt_regexlist_remove(&UnMailLists, buf->data);
+    MailListsGeneration++;
 
     if (mutt_regexlist_add(&MailLists, buf->data, REG_ICASE, err) != 0)
       goto bail;
@@ -1208,6 +1270,7 @@ static enum CommandResult parse_subscribe(struct Buffer *buf, struct Buffer *s,
 
     mutt_regexlist_remove(&UnMailLists, buf->data);
     mutt_regexlist_remove(&UnSubscribedLists, buf->data);
+    MailListsGeneration++;
 
     if (mutt_regexlist_add(&MailLists, buf->data, REG_ICASE, err) != 0)
       goto bail;
@@ -1388,6 +1451,7 @@ static enum CommandResult parse_unlists(struct Buffer *buf, struct Buffer *s,
     parse_extract_token(buf, s, TOKEN_NO_FLAGS);
     mutt_regexlist_remove(&SubscribedLists, buf->data);
     mutt_regexlist_remove(&MailLists, buf->data);
+    MailListsGeneration++;
 
     if (!mutt_str_equal(buf->data, "*") &&
         (mutt_regexlist_add(&UnMailLists, buf->data, REG_ICASE, err) != 0))
@@ -1552,6 +1616,7 @@ static enum CommandResult parse_unsubscribe(struct Buffer *buf, struct Buffer *s
   {
     parse_extract_token(buf, s, TOKEN_NO_FLAGS);
     mutt_regexlist_remove(&SubscribedLists, buf->data);
+    MailListsGeneration++;
 
     if (!mutt_str_equal(buf->data, "*") &&
         (mutt_regexlist_add(&UnSubscribedLists, buf->data, REG_ICASE, err) != 0))
@@ -1608,6 +1673,86 @@ enum CommandResult parse_unsubscribe_from(struct Buffer *buf, struct Buffer *s,
   return MUTT_CMD_WARNING;
 }
 
+/**
+ * parse_perf_functions - Parse the 'perf-functions' command - Implements Command::parse() - @ingroup command_parse
+ */
+static enum CommandResult parse_perf_functions(struct Buffer *buf, struct Buffer *s,
+                                               intptr_t data, struct Buffer *err)
+{
+  // silently ignore 'perf-functions' if it's in a config file
+  if (!StartupComplete)
+    return MUTT_CMD_SUCCESS;
+
+  struct Buffer *tempfile = buf_pool_get();
+  buf_mktemp(tempfile);
+
+  FILE *fp_out = mutt_file_fopen(buf_string(tempfile), "w");
+  if (!fp_out)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    buf_printf(err, _("Could not create temporary file %s"), buf_string(tempfile));
+    buf_pool_release(&tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  km_perf_report(fp_out);
+  mutt_file_fclose(&fp_out);
+
+  struct PagerData pdata = { 0 };
+  struct PagerView pview = { &pdata };
+
+  pdata.fname = buf_string(tempfile);
+
+  pview.banner = "perf-functions";
+  pview.flags = MUTT_PAGER_NO_FLAGS;
+  pview.mode = PAGER_MODE_OTHER;
+
+  mutt_do_pager(&pview, NULL);
+  buf_pool_release(&tempfile);
+
+  return MUTT_CMD_SUCCESS;
+}
+
+/**
+ * parse_perf_report - Parse the 'perf-report' command - Implements Command::parse() - @ingroup command_parse
+ */
+static enum CommandResult parse_perf_report(struct Buffer *buf, struct Buffer *s,
+                                            intptr_t data, struct Buffer *err)
+{
+  // silently ignore 'perf-report' if it's in a config file
+  if (!StartupComplete)
+    return MUTT_CMD_SUCCESS;
+
+  struct Buffer *tempfile = buf_pool_get();
+  buf_mktemp(tempfile);
+
+  FILE *fp_out = mutt_file_fopen(buf_string(tempfile), "w");
+  if (!fp_out)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    buf_printf(err, _("Could not create temporary file %s"), buf_string(tempfile));
+    buf_pool_release(&tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  perf_report(fp_out);
+  mutt_file_fclose(&fp_out);
+
+  struct PagerData pdata = { 0 };
+  struct PagerView pview = { &pdata };
+
+  pdata.fname = buf_string(tempfile);
+
+  pview.banner = "perf-report";
+  pview.flags = MUTT_PAGER_NO_FLAGS;
+  pview.mode = PAGER_MODE_OTHER;
+
+  mutt_do_pager(&pview, NULL);
+  buf_pool_release(&tempfile);
+
+  return MUTT_CMD_SUCCESS;
+}
+
 /**
  * parse_version - Parse the 'version' command - Implements Command::parse() - @ingroup command_parse
  */
@@ -1686,6 +1831,8 @@ static const struct Command MuttCommands[] = {
   { "my_hdr",              parse_my_hdr,           0 },
   { "named-mailboxes",     parse_mailboxes,        MUTT_NAMED },
   { "nospam",              parse_nospam,           0 },
+  { "perf-functions",      parse_perf_functions,   0 },
+  { "perf-report",         parse_perf_report,      0 },
   { "push",                mutt_parse_push,        0 },
   { "reset",               parse_set,              MUTT_SET_RESET },
   { "score",               mutt_parse_score,       0 },
@@ -0,0 +1,304 @@
+/**
+ * @file
+ * Built-in compression codecs for compressed mailboxes
+ *
+ * @authors
+ * Copyright (C) 2024 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page compmbox_codec Built-in compression codecs
+ *
+ * Built-in codecs for compressed mailboxes.
+ *
+ * These decompress/recompress a mailbox in-process, instead of shelling out
+ * to the open/close/append-hook commands.  They only handle the compressed
+ * data; the mailbox is still unpacked to a temporary file, because the mbox
+ * parser needs to seek.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+#include "mutt/lib.h"
+#include "codec.h"
+
+/// Size of the copy buffers used by the codecs
+#define CODEC_BUF_SIZE (64 * 1024)
+
+#ifdef USE_ZLIB
+/**
+ * zlib_decompress - Decompress a gzip file - Implements CompCodec::decompress() - @ingroup comp_codec_decompress
+ *
+ * gzread() transparently handles a file of concatenated gzip members, as
+ * produced by compressed-appending.
+ */
+static bool zlib_decompress(const char *src, const char *dst)
+{
+  gzFile gz = gzopen(src, "rb");
+  if (!gz)
+    return false;
+
+  FILE *fp = mutt_file_fopen(dst, "w");
+  if (!fp)
+  {
+    gzclose(gz);
+    return false;
+  }
+
+  bool rc = true;
+  char *buf = mutt_mem_malloc(CODEC_BUF_SIZE);
+  while (true)
+  {
+    const int len = gzread(gz, buf, CODEC_BUF_SIZE);
+    if (len == 0)
+      break;
+    if ((len < 0) || (fwrite(buf, 1, len, fp) != (size_t) len))
+    {
+      rc = false;
+      break;
+    }
+  }
+  FREE(&buf);
+
+  if (mutt_file_fclose(&fp) != 0)
+    rc = false;
+  gzclose(gz);
+  return rc;
+}
+
+/**
+ * zlib_compress - Compress a file with gzip - Implements CompCodec::compress() - @ingroup comp_codec_compress
+ */
+static bool zlib_compress(const char *src, const char *dst, bool append)
+{
+  FILE *fp = mutt_file_fopen(src, "r");
+  if (!fp)
+    return false;
+
+  gzFile gz = gzopen(dst, append ? "ab" : "wb");
+  if (!gz)
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  bool rc = true;
+  char *buf = mutt_mem_malloc(CODEC_BUF_SIZE);
+  while (true)
+  {
+    const size_t len = fread(buf, 1, CODEC_BUF_SIZE, fp);
+    if (len == 0)
+    {
+      rc = !ferror(fp);
+      break;
+    }
+    if (gzwrite(gz, buf, len) != (int) len)
+    {
+      rc = false;
+      break;
+    }
+  }
+  FREE(&buf);
+
+  if (gzclose(gz) != Z_OK)
+    rc = false;
+  mutt_file_fclose(&fp);
+  return rc;
+}
+#endif /* USE_ZLIB */
+
+#ifdef USE_ZSTD
+/**
+ * zstd_decompress - Decompress a zstd file - Implements CompCodec::decompress() - @ingroup comp_codec_decompress
+ *
+ * The streaming decoder resets between frames, so a file grown by
+ * compressed-appending is decompressed in full.
+ */
+static bool zstd_decompress(const char *src, const char *dst)
+{
+  FILE *fp_src = mutt_file_fopen(src, "r");
+  if (!fp_src)
+    return false;
+
+  FILE *fp_dst = mutt_file_fopen(dst, "w");
+  if (!fp_dst)
+  {
+    mutt_file_fclose(&fp_src);
+    return false;
+  }
+
+  ZSTD_DCtx *dctx = ZSTD_createDCtx();
+  const size_t in_size = ZSTD_DStreamInSize();
+  const size_t out_size = ZSTD_DStreamOutSize();
+  char *buf_in = mutt_mem_malloc(in_size);
+  char *buf_out = mutt_mem_malloc(out_size);
+
+  bool rc = true;
+  while (true)
+  {
+    const size_t len = fread(buf_in, 1, in_size, fp_src);
+    if (len == 0)
+    {
+      rc = !ferror(fp_src);
+      break;
+    }
+
+    ZSTD_inBuffer input = { buf_in, len, 0 };
+    while (input.pos < input.size)
+    {
+      ZSTD_outBuffer output = { buf_out, out_size, 0 };
+      const size_t zrc = ZSTD_decompressStream(dctx, &output, &input);
+      if (ZSTD_isError(zrc) ||
+          (fwrite(buf_out, 1, output.pos, fp_dst) != output.pos))
+      {
+        rc = false;
+        break;
+      }
+    }
+    if (!rc)
+      break;
+  }
+
+  FREE(&buf_in);
+  FREE(&buf_out);
+  ZSTD_freeDCtx(dctx);
+
+  if (mutt_file_fclose(&fp_dst) != 0)
+    rc = false;
+  mutt_file_fclose(&fp_src);
+  return rc;
+}
+
+/**
+ * zstd_compress - Compress a file with zstd - Implements CompCodec::compress() - @ingroup comp_codec_compress
+ *
+ * Compression is spread across the available cpus, if the library was built
+ * with multi-threading support.
+ */
+static bool zstd_compress(const char *src, const char *dst, bool append)
+{
+  FILE *fp_src = mutt_file_fopen(src, "r");
+  if (!fp_src)
+    return false;
+
+  FILE *fp_dst = mutt_file_fopen(dst, append ? "a" : "w");
+  if (!fp_dst)
+  {
+    mutt_file_fclose(&fp_src);
+    return false;
+  }
+
+  ZSTD_CCtx *cctx = ZSTD_createCCtx();
+  ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+  /* This fails harmlessly if libzstd was built without ZSTD_MULTITHREAD */
+  const long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (ncpus > 1)
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, ncpus);
+
+  const size_t in_size = ZSTD_CStreamInSize();
+  const size_t out_size = ZSTD_CStreamOutSize();
+  char *buf_in = mutt_mem_malloc(in_size);
+  char *buf_out = mutt_mem_malloc(out_size);
+
+  bool rc = true;
+  bool last = false;
+  while (!last)
+  {
+    const size_t len = fread(buf_in, 1, in_size, fp_src);
+    if (ferror(fp_src))
+    {
+      rc = false;
+      break;
+    }
+    last = (len < in_size);
+
+    ZSTD_inBuffer input = { buf_in, len, 0 };
+    while (true)
+    {
+      ZSTD_outBuffer output = { buf_out, out_size, 0 };
+      const size_t remaining = ZSTD_compressStream2(cctx, &output, &input,
+                                                    last ? ZSTD_e_end : ZSTD_e_continue);
+      if (ZSTD_isError(remaining) ||
+          (fwrite(buf_out, 1, output.pos, fp_dst) != output.pos))
+      {
+        rc = false;
+        break;
+      }
+      if (last ? (remaining == 0) : (input.pos == input.size))
+        break;
+    }
+    if (!rc)
+      break;
+  }
+
+  FREE(&buf_in);
+  FREE(&buf_out);
+  ZSTD_freeCCtx(cctx);
+
+  if (mutt_file_fclose(&fp_dst) != 0)
+    rc = false;
+  mutt_file_fclose(&fp_src);
+  return rc;
+}
+#endif /* USE_ZSTD */
+
+/**
+ * CompCodecs - All the built-in codecs that were compiled in
+ */
+static const struct CompCodec CompCodecs[] = {
+  // clang-format off
+#ifdef USE_ZSTD
+  { "zstd", ".zst", zstd_decompress, zstd_compress },
+#endif
+#ifdef USE_ZLIB
+  { "gzip", ".gz",  zlib_decompress, zlib_compress },
+#endif
+  { NULL, NULL, NULL, NULL },
+  // clang-format on
+};
+
+/**
+ * comp_codec_find - Find a built-in codec for a mailbox path
+ * @param path Mailbox path
+ * @retval ptr  Matching codec
+ * @retval NULL No codec handles this suffix
+ */
+const struct CompCodec *comp_codec_find(const char *path)
+{
+  if (!path)
+    return NULL;
+
+  const size_t plen = mutt_str_len(path);
+  for (const struct CompCodec *codec = CompCodecs; codec->name; codec++)
+  {
+    const size_t slen = mutt_str_len(codec->suffix);
+    if ((plen > slen) && mutt_istr_equal(path + plen - slen, codec->suffix))
+      return codec;
+  }
+
+  return NULL;
+}
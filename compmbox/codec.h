@@ -0,0 +1,68 @@
+/**
+ * @file
+ * Built-in compression codecs for compressed mailboxes
+ *
+ * @authors
+ * Copyright (C) 2024 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_COMPMBOX_CODEC_H
+#define MUTT_COMPMBOX_CODEC_H
+
+#include <stdbool.h>
+
+/**
+ * @defgroup comp_codec_api Compressed Mailbox Codec API
+ *
+ * A built-in compression codec, used instead of the open/close/append-hook
+ * commands when the mailbox suffix is recognised and the library is available.
+ */
+struct CompCodec
+{
+  const char *name;   ///< Codec name, e.g. "zstd"
+  const char *suffix; ///< Mailbox suffix it handles, e.g. ".zst"
+
+  /**
+   * @defgroup comp_codec_decompress decompress()
+   * @ingroup comp_codec_api
+   *
+   * decompress - Decompress a file
+   * @param src Compressed file
+   * @param dst Plaintext file to write
+   * @retval true Success
+   *
+   * All frames/members of the compressed file are decompressed, so a file
+   * grown by compressed-appending reads back as one mailbox.
+   */
+  bool (*decompress)(const char *src, const char *dst);
+
+  /**
+   * @defgroup comp_codec_compress compress()
+   * @ingroup comp_codec_api
+   *
+   * compress - Compress a file
+   * @param src    Plaintext file
+   * @param dst    Compressed file to write
+   * @param append Append to dst as a new frame, rather than replacing it
+   * @retval true Success
+   */
+  bool (*compress)(const char *src, const char *dst, bool append);
+};
+
+const struct CompCodec *comp_codec_find(const char *path);
+
+#endif /* MUTT_COMPMBOX_CODEC_H */
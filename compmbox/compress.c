@@ -49,6 +49,7 @@
 #include "gui/lib.h"
 #include "lib.h"
 #include "expando/lib.h"
+#include "codec.h"
 #include "globals.h"
 #include "hook.h"
 #include "mx.h"
@@ -244,10 +245,15 @@ static struct CompressInfo *set_compress_info(struct Mailbox *m)
   if (m->compress_info)
     return m->compress_info;
 
-  /* Open is compulsory */
+  /* Open is compulsory; hooks take precedence over the built-in codecs */
   const char *o = mutt_find_hook(MUTT_OPEN_HOOK, mailbox_path(m));
+  const struct CompCodec *codec = NULL;
   if (!o)
-    return NULL;
+  {
+    codec = comp_codec_find(mailbox_path(m));
+    if (!codec)
+      return NULL;
+  }
 
   const char *c = mutt_find_hook(MUTT_CLOSE_HOOK, mailbox_path(m));
   const char *a = mutt_find_hook(MUTT_APPEND_HOOK, mailbox_path(m));
@@ -255,6 +261,7 @@ static struct CompressInfo *set_compress_info(struct Mailbox *m)
   struct CompressInfo *ci = mutt_mem_calloc(1, sizeof(struct CompressInfo));
   m->compress_info = ci;
 
+  ci->codec = codec;
   ci->cmd_open = validate_compress_expando(o);
   ci->cmd_close = validate_compress_expando(c);
   ci->cmd_append = validate_compress_expando(a);
@@ -351,6 +358,62 @@ static bool execute_command(struct Mailbox *m, const struct Expando *exp, const
   return rc;
 }
 
+/**
+ * comp_decompress - Decompress the Mailbox.realpath to its temporary file
+ * @param m Mailbox to decompress
+ * @retval true Success
+ *
+ * Use the built-in codec, if there is one, otherwise run the open-hook.
+ */
+static bool comp_decompress(struct Mailbox *m)
+{
+  struct CompressInfo *ci = m->compress_info;
+
+  if (!ci->codec)
+    return execute_command(m, ci->cmd_open, _("Decompressing %s"));
+
+  if (m->verbose)
+    mutt_message(_("Decompressing %s"), m->realpath);
+
+  if (!ci->codec->decompress(m->realpath, mailbox_path(m)))
+  {
+    mutt_error(_("Error decompressing %s"), m->realpath);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * comp_compress - Recompress the temporary file to the Mailbox.realpath
+ * @param m      Mailbox to compress
+ * @param append Append to the compressed file, rather than replacing it
+ * @retval true Success
+ *
+ * Use the built-in codec, if there is one, otherwise run the
+ * append-hook/close-hook.
+ */
+static bool comp_compress(struct Mailbox *m, bool append)
+{
+  struct CompressInfo *ci = m->compress_info;
+
+  const char *msg = append ? _("Compressed-appending to %s...") : _("Compressing %s");
+
+  if (!ci->codec)
+    return execute_command(m, append ? ci->cmd_append : ci->cmd_close, msg);
+
+  if (m->verbose)
+    mutt_message(msg, m->realpath);
+
+  if (!ci->codec->compress(mailbox_path(m), m->realpath, append))
+  {
+    mutt_error(_("Error compressing %s"), m->realpath);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * mutt_comp_can_append - Can we append to this path?
  * @param m Mailbox
@@ -374,7 +437,7 @@ bool mutt_comp_can_append(struct Mailbox *m)
 
   /* We have an open-hook, so to append we need an append-hook,
    * or a close-hook. */
-  if (ci->cmd_append || ci->cmd_close)
+  if (ci->cmd_append || ci->cmd_close || ci->codec)
     return true;
 
   mutt_error(_("Can't append without an append-hook or close-hook : %s"), mailbox_path(m));
@@ -399,7 +462,7 @@ bool mutt_comp_can_read(const char *path)
   if (mutt_find_hook(MUTT_OPEN_HOOK, path))
     return true;
 
-  return false;
+  return comp_codec_find(path) != NULL;
 }
 
 /**
@@ -449,8 +512,8 @@ static enum MxOpenReturns comp_mbox_open(struct Mailbox *m)
   if (!ci)
     return MX_OPEN_ERROR;
 
-  /* If there's no close-hook, or the file isn't writable */
-  if (!ci->cmd_close || (access(mailbox_path(m), W_OK) != 0))
+  /* If there's no close-hook or codec, or the file isn't writable */
+  if ((!ci->cmd_close && !ci->codec) || (access(mailbox_path(m), W_OK) != 0))
     m->readonly = true;
 
   if (setup_paths(m) != 0)
@@ -463,7 +526,7 @@ static enum MxOpenReturns comp_mbox_open(struct Mailbox *m)
     goto cmo_fail;
   }
 
-  if (!execute_command(m, ci->cmd_open, _("Decompressing %s")))
+  if (!comp_decompress(m))
     goto cmo_fail;
 
   unlock_realpath(m);
@@ -507,8 +570,8 @@ static bool comp_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
   if (!ci)
     return false;
 
-  /* To append we need an append-hook or a close-hook */
-  if (!ci->cmd_append && !ci->cmd_close)
+  /* To append we need an append-hook, a close-hook or a codec */
+  if (!ci->cmd_append && !ci->cmd_close && !ci->codec)
   {
     mutt_error(_("Can't append without an append-hook or close-hook : %s"),
                mailbox_path(m));
@@ -526,10 +589,10 @@ static bool comp_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
     goto cmoa_fail2;
   }
 
-  /* Open the existing mailbox, unless we are appending */
-  if (!ci->cmd_append && (mutt_file_get_size(m->realpath) > 0))
+  /* Open the existing mailbox, unless we can append to it directly */
+  if (!ci->cmd_append && !ci->codec && (mutt_file_get_size(m->realpath) > 0))
   {
-    if (!execute_command(m, ci->cmd_open, _("Decompressing %s")))
+    if (!comp_decompress(m))
     {
       mutt_error(_("Compress command failed: %s"), ci->cmd_open->string);
       goto cmoa_fail2;
@@ -601,7 +664,7 @@ static enum MxStatus comp_mbox_check(struct Mailbox *m)
     return MX_STATUS_ERROR;
   }
 
-  bool rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
+  bool rc = comp_decompress(m);
   store_size(m);
   unlock_realpath(m);
   if (!rc)
@@ -623,7 +686,7 @@ static enum MxStatus comp_mbox_sync(struct Mailbox *m)
 
   struct CompressInfo *ci = m->compress_info;
 
-  if (!ci->cmd_close)
+  if (!ci->cmd_close && !ci->codec)
   {
     mutt_error(_("Can't sync a compressed file without a close-hook"));
     return MX_STATUS_ERROR;
@@ -647,7 +710,7 @@ static enum MxStatus comp_mbox_sync(struct Mailbox *m)
   if (check != MX_STATUS_OK)
     goto sync_cleanup;
 
-  if (!execute_command(m, ci->cmd_close, _("Compressing %s")))
+  if (!comp_compress(m, false))
   {
     check = MX_STATUS_ERROR;
     goto sync_cleanup;
@@ -686,22 +749,11 @@ static enum MxStatus comp_mbox_close(struct Mailbox *m)
   /* sync has already been called, so we only need to delete some files */
   if (m->append)
   {
-    const struct Expando *append = NULL;
-    const char *msg = NULL;
-
     /* The file exists and we can append */
-    if ((access(m->realpath, F_OK) == 0) && ci->cmd_append)
-    {
-      append = ci->cmd_append;
-      msg = _("Compressed-appending to %s...");
-    }
-    else
-    {
-      append = ci->cmd_close;
-      msg = _("Compressing %s");
-    }
+    const bool append = (access(m->realpath, F_OK) == 0) &&
+                        (ci->cmd_append || ci->codec);
 
-    if (!execute_command(m, append, msg))
+    if (!comp_compress(m, append))
     {
       mutt_any_key_to_continue(NULL);
       mutt_error(_("Error. Preserving temporary file: %s"), mailbox_path(m));
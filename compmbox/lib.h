@@ -28,6 +28,7 @@
  *
  * | File                | Description                |
  * | :------------------ | :------------------------- |
+ * | compmbox/codec.c    | @subpage compmbox_codec    |
  * | compmbox/compress.c | @subpage compmbox_compress |
  */
 
@@ -59,6 +60,7 @@ struct CompressInfo
   struct Expando *cmd_append;    ///< append-hook command
   struct Expando *cmd_close;     ///< close-hook  command
   struct Expando *cmd_open;      ///< open-hook   command
+  const struct CompCodec *codec; ///< Built-in codec, used when no hooks match
   long size;                     ///< size of the compressed file
   const struct MxOps *child_ops; ///< callbacks of de-compressed file
   bool locked;                   ///< if realpath is locked
@@ -63,6 +63,9 @@ static const struct ExpandoDefinition ComposeFormatDef[] = {
  */
 static struct ConfigDef ComposeVars[] = {
   // clang-format off
+  { "background_ispell", DT_BOOL, false, 0, NULL,
+    "Run $ispell in the background and show its output when it finishes"
+  },
   { "compose_confirm_detach_first", DT_BOOL, true, 0, NULL,
     "Prevent the accidental deletion of the composed message"
   },
@@ -62,6 +62,7 @@
 #include "question/lib.h"
 #include "send/lib.h"
 #include "attach_data.h"
+#include "background.h"
 #include "external.h"
 #include "functions.h"
 #include "globals.h"
@@ -1837,9 +1838,24 @@ static int op_compose_edit_message(struct ComposeSharedData *shared, int op)
  */
 static int op_compose_ispell(struct ComposeSharedData *shared, int op)
 {
-  endwin();
   const char *const c_ispell = cs_subset_string(shared->sub, "ispell");
   char buf[PATH_MAX] = { 0 };
+
+  const bool c_background_ispell = cs_subset_bool(shared->sub, "background_ispell");
+  if (c_background_ispell)
+  {
+    /* For non-interactive checkers, e.g. `aspell list`: the draft isn't
+     * modified and the checker's output is shown when it finishes */
+    snprintf(buf, sizeof(buf), "%s %s", NONULL(c_ispell), shared->email->body->filename);
+    if (background_command_run(buf, "ispell") != 0)
+    {
+      mutt_error(_("Error running \"%s\""), buf);
+      return FR_ERROR;
+    }
+    return FR_SUCCESS;
+  }
+
+  endwin();
   snprintf(buf, sizeof(buf), "%s -x %s", NONULL(c_ispell), shared->email->body->filename);
   if (mutt_system(buf) == -1)
   {
@@ -50,6 +50,7 @@
 #ifndef MUTT_COMPRESS_LIB_H
 #define MUTT_COMPRESS_LIB_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 
 /// Opaque type for compression data
@@ -121,6 +122,40 @@ struct ComprOps
    *       allocated by open(), compress() or decompress()
    */
   void (*close)(ComprHandle **ptr);
+
+  /**
+   * @defgroup compress_dict_load dict_load()
+   * @ingroup compress_api
+   *
+   * dict_load - Load a pre-trained compression dictionary
+   * @param[in] handle Compression handle
+   * @param[in] path   File holding the dictionary
+   * @retval true  Success, later records will use the dictionary
+   * @retval false Otherwise, e.g. the file doesn't exist
+   *
+   * Records compressed without the dictionary stay readable.
+   *
+   * @note Optional - NULL for backends without dictionary support
+   */
+  bool (*dict_load)(ComprHandle *handle, const char *path);
+
+  /**
+   * @defgroup compress_dict_train dict_train()
+   * @ingroup compress_api
+   *
+   * dict_train - Train a compression dictionary on sample records
+   * @param[in] handle  Compression handle
+   * @param[in] path    File to save the dictionary to
+   * @param[in] samples Sample records to train on
+   * @param[in] slens   Lengths of the sample records
+   * @param[in] count   Number of sample records
+   * @retval true  Success, the dictionary was saved to @a path
+   * @retval false Otherwise, e.g. too few samples to train on
+   *
+   * @note Optional - NULL for backends without dictionary support
+   */
+  bool (*dict_train)(ComprHandle *handle, const char *path,
+                     const char **samples, const size_t *slens, size_t count);
 };
 
 extern const struct ComprOps compr_lz4_ops;
@@ -30,7 +30,12 @@
  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zdict.h>
 #include <zstd.h>
 #include "private.h"
 #include "mutt/lib.h"
@@ -39,6 +44,8 @@
 #define MIN_COMP_LEVEL 1  ///< Minimum compression level for zstd
 #define MAX_COMP_LEVEL 22 ///< Maximum compression level for zstd
 
+#define MAX_DICT_SIZE (110 * 1024) ///< Size limit for a trained dictionary
+
 /**
  * struct ZstdComprData - Private Zstandard Compression Data
  */
@@ -49,6 +56,9 @@ struct ZstdComprData
 
   ZSTD_CCtx *cctx; ///< Compression context
   ZSTD_DCtx *dctx; ///< Decompression context
+
+  ZSTD_CDict *cdict; ///< Digested dictionary for compression
+  ZSTD_DDict *ddict; ///< Digested dictionary for decompression
 };
 
 /**
@@ -124,7 +134,11 @@ static void *compr_zstd_compress(ComprHandle *handle, const char *data,
   size_t len = ZSTD_compressBound(dlen);
   mutt_mem_realloc(&cdata->buf, len);
 
-  size_t rc = ZSTD_compressCCtx(cdata->cctx, cdata->buf, len, data, dlen, cdata->level);
+  size_t rc;
+  if (cdata->cdict)
+    rc = ZSTD_compress_usingCDict(cdata->cctx, cdata->buf, len, data, dlen, cdata->cdict);
+  else
+    rc = ZSTD_compressCCtx(cdata->cctx, cdata->buf, len, data, dlen, cdata->level);
   if (ZSTD_isError(rc))
     return NULL; // LCOV_EXCL_LINE
 
@@ -153,13 +167,116 @@ static void *compr_zstd_decompress(ComprHandle *handle, const char *cbuf, size_t
     return NULL; // LCOV_EXCL_LINE
   mutt_mem_realloc(&cdata->buf, len);
 
-  size_t rc = ZSTD_decompressDCtx(cdata->dctx, cdata->buf, len, cbuf, clen);
+  /* The frame records which dictionary, if any, it was compressed with,
+   * so records from before dictionary training remain readable */
+  size_t rc;
+  if (cdata->ddict && (ZSTD_getDictID_fromFrame(cbuf, clen) != 0))
+    rc = ZSTD_decompress_usingDDict(cdata->dctx, cdata->buf, len, cbuf, clen, cdata->ddict);
+  else
+    rc = ZSTD_decompressDCtx(cdata->dctx, cdata->buf, len, cbuf, clen);
   if (ZSTD_isError(rc))
     return NULL; // LCOV_EXCL_LINE
 
   return cdata->buf;
 }
 
+/**
+ * compr_zstd_dict_load - Load a pre-trained compression dictionary - Implements ComprOps::dict_load() - @ingroup compress_dict_load
+ */
+static bool compr_zstd_dict_load(ComprHandle *handle, const char *path)
+{
+  if (!handle || !path)
+    return false;
+
+  // Decloak an opaque pointer
+  struct ZstdComprData *cdata = handle;
+
+  FILE *fp = mutt_file_fopen(path, "r");
+  if (!fp)
+    return false;
+
+  struct stat st = { 0 };
+  if ((fstat(fileno(fp), &st) != 0) || (st.st_size == 0))
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  char *dict = mutt_mem_malloc(st.st_size);
+  size_t len = fread(dict, 1, st.st_size, fp);
+  mutt_file_fclose(&fp);
+  if (len != (size_t) st.st_size)
+  {
+    FREE(&dict);
+    return false;
+  }
+
+  cdata->cdict = ZSTD_createCDict(dict, len, cdata->level);
+  cdata->ddict = ZSTD_createDDict(dict, len);
+  FREE(&dict);
+
+  if (!cdata->cdict || !cdata->ddict)
+  {
+    // LCOV_EXCL_START
+    ZSTD_freeCDict(cdata->cdict);
+    ZSTD_freeDDict(cdata->ddict);
+    cdata->cdict = NULL;
+    cdata->ddict = NULL;
+    return false;
+    // LCOV_EXCL_STOP
+  }
+
+  return true;
+}
+
+/**
+ * compr_zstd_dict_train - Train a compression dictionary on sample records - Implements ComprOps::dict_train() - @ingroup compress_dict_train
+ */
+static bool compr_zstd_dict_train(ComprHandle *handle, const char *path,
+                                  const char **samples, const size_t *slens, size_t count)
+{
+  if (!handle || !path || !samples || !slens || (count == 0))
+    return false;
+
+  // The trainer wants the samples back-to-back in one buffer
+  size_t total = 0;
+  for (size_t i = 0; i < count; i++)
+    total += slens[i];
+
+  char *corpus = mutt_mem_malloc(total);
+  size_t off = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    memcpy(corpus + off, samples[i], slens[i]);
+    off += slens[i];
+  }
+
+  char *dict = mutt_mem_malloc(MAX_DICT_SIZE);
+  size_t dlen = ZDICT_trainFromBuffer(dict, MAX_DICT_SIZE, corpus, slens,
+                                      (unsigned int) count);
+  FREE(&corpus);
+  if (ZDICT_isError(dlen))
+  {
+    mutt_debug(LL_DEBUG1, "ZDICT_trainFromBuffer: %s\n", ZDICT_getErrorName(dlen));
+    FREE(&dict);
+    return false;
+  }
+
+  bool rc = false;
+  unlink(path); // A stale dictionary would make mutt_file_fopen() balk
+  FILE *fp = mutt_file_fopen(path, "w");
+  if (fp)
+  {
+    rc = (fwrite(dict, 1, dlen, fp) == dlen);
+    mutt_file_fclose(&fp);
+    if (!rc)
+      unlink(path); // LCOV_EXCL_LINE - don't leave a truncated dictionary
+  }
+  FREE(&dict);
+
+  return rc;
+}
+
 /**
  * compr_zstd_close - Close a compression context - Implements ComprOps::close() - @ingroup compress_close
  */
@@ -177,7 +294,25 @@ static void compr_zstd_close(ComprHandle **ptr)
   if (cdata->dctx)
     ZSTD_freeDCtx(cdata->dctx);
 
+  if (cdata->cdict)
+    ZSTD_freeCDict(cdata->cdict);
+
+  if (cdata->ddict)
+    ZSTD_freeDDict(cdata->ddict);
+
   zstd_cdata_free((struct ZstdComprData **) ptr);
 }
 
-COMPRESS_OPS(zstd, MIN_COMP_LEVEL, MAX_COMP_LEVEL)
+/* Written out, rather than using COMPRESS_OPS(), as zstd is the only
+ * backend with dictionary support */
+const struct ComprOps compr_zstd_ops = {
+  .name       = "zstd",
+  .min_level  = MIN_COMP_LEVEL,
+  .max_level  = MAX_COMP_LEVEL,
+  .open       = compr_zstd_open,
+  .compress   = compr_zstd_compress,
+  .decompress = compr_zstd_decompress,
+  .close      = compr_zstd_close,
+  .dict_load  = compr_zstd_dict_load,
+  .dict_train = compr_zstd_dict_train,
+};
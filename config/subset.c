@@ -57,6 +57,9 @@ static const struct Mapping ConfigEventNames[] = {
   // clang-format on
 };
 
+/// Incremented on every config change - invalidates all #ConfigMemo handles
+static uint64_t ConfigGeneration = 1;
+
 /**
  * elem_list_sort - Compare two HashElem pointers to config - Implements ::sort_t - @ingroup sort_api
  */
@@ -112,6 +115,8 @@ void cs_subset_free(struct ConfigSubset **ptr)
 
   struct ConfigSubset *sub = *ptr;
 
+  ConfigGeneration++;
+
   struct EventConfig ev_c = { sub, NULL, NULL };
   mutt_debug(LL_NOTIFY, "NT_CONFIG_DELETED: ALL\n");
   notify_send(sub->notify, NT_CONFIG, NT_CONFIG_DELETED, &ev_c);
@@ -240,6 +245,8 @@ void cs_subset_notify_observers(const struct ConfigSubset *sub,
   if (!sub || !he)
     return;
 
+  ConfigGeneration++;
+
   struct HashElem *he_base = cs_get_base(he);
   struct EventConfig ev_c = { sub, he_base->key.strkey, he };
   mutt_debug(LL_NOTIFY, "%s: %s\n",
@@ -247,6 +254,44 @@ void cs_subset_notify_observers(const struct ConfigSubset *sub,
   notify_send(sub->notify, NT_CONFIG, ev, &ev_c);
 }
 
+/**
+ * cs_subset_memo_native_get - Natively get the value of a memoized config item
+ * @param sub  Config Subset
+ * @param memo Memoized handle, see #ConfigMemo
+ * @retval intptr_t Native pointer/value
+ * @retval INT_MIN  Error
+ *
+ * Equivalent to cs_subset_create_inheritance() + cs_subset_he_native_get(),
+ * but the result is cached in the handle until the next config change.
+ */
+intptr_t cs_subset_memo_native_get(const struct ConfigSubset *sub, struct ConfigMemo *memo)
+{
+  if (!sub || !memo)
+    return INT_MIN;
+
+  if ((memo->generation == ConfigGeneration) && (memo->sub == sub))
+    return memo->value;
+
+  struct HashElem *he = cs_subset_create_inheritance(sub, memo->name);
+  memo->value = cs_subset_he_native_get(sub, he, NULL);
+  memo->sub = sub;
+  memo->generation = ConfigGeneration;
+
+  return memo->value;
+}
+
+/**
+ * cs_generation - Get the global config generation counter
+ * @retval num Current generation
+ *
+ * The counter is bumped on every config change.  Callers can use it to
+ * invalidate values derived from config items, cf. #ConfigMemo.
+ */
+uint64_t cs_generation(void)
+{
+  return ConfigGeneration;
+}
+
 /**
  * cs_subset_he_native_get - Natively get the value of a HashElem config item
  * @param sub Config Subset
@@ -452,6 +497,8 @@ int cs_subset_he_delete(const struct ConfigSubset *sub, struct HashElem *he, str
 
   if (CSR_RESULT(rc) == CSR_SUCCESS)
   {
+    ConfigGeneration++;
+
     struct EventConfig ev_c = { sub, name, NULL };
     mutt_debug(LL_NOTIFY, "NT_CONFIG_DELETED: %s\n", name);
     notify_send(sub->notify, NT_CONFIG, NT_CONFIG_DELETED, &ev_c);
@@ -52,6 +52,27 @@ struct ConfigSubset
   struct Notify *notify;       ///< Notifications: #NotifyConfig, #EventConfig
 };
 
+/**
+ * struct ConfigMemo - Memoized handle for a config item
+ *
+ * Cache for the result of resolving a config item in a Subset.  Until the
+ * next config change, repeat reads through cs_subset_memo_native_get() cost a
+ * couple of comparisons instead of hash lookups and an inheritance walk,
+ * making the handle cheap enough for per-message hot paths.
+ *
+ * Initialise with #CONFIG_MEMO_INIT, e.g.
+ * `static struct ConfigMemo FlagCharsMemo = CONFIG_MEMO_INIT("flag_chars");`
+ */
+struct ConfigMemo
+{
+  const char *name;               ///< Name of the config item
+  const struct ConfigSubset *sub; ///< Subset the item was resolved in
+  uint64_t generation;            ///< Config generation of the cached value
+  intptr_t value;                 ///< Cached native value
+};
+
+#define CONFIG_MEMO_INIT(n) { .name = (n) }
+
 /**
  * enum NotifyConfig - Config notification types
  *
@@ -82,6 +103,8 @@ struct HashElem *cs_subset_lookup            (const struct ConfigSubset *sub, co
 void             cs_subset_notify_observers  (const struct ConfigSubset *sub, struct HashElem *he, enum NotifyConfig ev);
 
 intptr_t cs_subset_he_native_get          (const struct ConfigSubset *sub, struct HashElem *he,                    struct Buffer *err);
+intptr_t cs_subset_memo_native_get        (const struct ConfigSubset *sub, struct ConfigMemo *memo);
+uint64_t cs_generation                    (void);
 int      cs_subset_he_native_set          (const struct ConfigSubset *sub, struct HashElem *he, intptr_t value,    struct Buffer *err);
 int      cs_subset_he_reset               (const struct ConfigSubset *sub, struct HashElem *he,                    struct Buffer *err);
 int      cs_subset_he_string_get          (const struct ConfigSubset *sub, struct HashElem *he,                    struct Buffer *result);
@@ -28,8 +28,11 @@
  */
 
 #include "config.h"
+#include <poll.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <time.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "core/lib.h"
@@ -38,6 +41,31 @@
 #include "globals.h"
 #include "mutt_account.h"
 
+/**
+ * struct AccountCmdCache - Cached response of $account_command
+ *
+ * One entry per distinct command line; the line encodes every account field
+ * (host, username, type, TLS), so it doubles as the cache key.  An entry may
+ * carry an in-flight refresh subprocess, started before the entry expires so
+ * that a later lookup finds fresh results waiting instead of running the
+ * command and blocking on it.
+ */
+struct AccountCmdCache
+{
+  char *cmdline;          ///< Command line the results came from (cache key)
+  struct ConnAccount cac; ///< Cached credential fields
+  MuttAccountFlags flags; ///< Which of the fields the command returned
+  time_t expiry;          ///< When the entry expires
+  pid_t refresh_pid;      ///< In-flight refresh subprocess, or 0
+  FILE *refresh_fp;       ///< Output of the refresh subprocess
+
+  STAILQ_ENTRY(AccountCmdCache) entries; ///< Linked list
+};
+STAILQ_HEAD(AccountCmdCacheHead, AccountCmdCache);
+
+/// Cached $account_command responses, controlled by $account_command_ttl
+static struct AccountCmdCacheHead AccountCmdResults = STAILQ_HEAD_INITIALIZER(AccountCmdResults);
+
 /**
  * make_cmd - Build the command line for the external account command
  * @param buf Buffer to fill with a command line
@@ -122,6 +150,28 @@ static MuttAccountFlags parse_one(struct ConnAccount *cac, char *line)
   return MUTT_ACCT_NO_FLAGS;
 }
 
+/**
+ * read_results - Parse the output of the account command
+ * @param cac ConnAccount to write to
+ * @param fp  Output of the command
+ * @retval num #MuttAccountFlags that matched
+ * @retval #MUTT_ACCT_NO_FLAGS Failure
+ */
+static MuttAccountFlags read_results(struct ConnAccount *cac, FILE *fp)
+{
+  MuttAccountFlags rc = MUTT_ACCT_NO_FLAGS;
+
+  size_t len = 0;
+  char *line = NULL;
+  while ((line = mutt_file_read_line(NULL, &len, fp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    rc |= parse_one(cac, line);
+    FREE(&line);
+  }
+
+  return rc;
+}
+
 /**
  * call_cmd - Call the account command
  * @param cac ConnAccount to write to
@@ -133,29 +183,134 @@ static MuttAccountFlags call_cmd(struct ConnAccount *cac, const struct Buffer *c
 {
   ASSERT(cac && cmd);
 
-  MuttAccountFlags rc = MUTT_ACCT_NO_FLAGS;
-
   FILE *fp = NULL;
   pid_t pid = filter_create(buf_string(cmd), NULL, &fp, NULL, EnvList);
   if (pid < 0)
   {
     mutt_perror(_("Unable to run account command"));
-    return rc;
-  }
-
-  size_t len = 0;
-  char *line = NULL;
-  while ((line = mutt_file_read_line(NULL, &len, fp, NULL, MUTT_RL_NO_FLAGS)))
-  {
-    rc |= parse_one(cac, line);
-    FREE(&line);
+    return MUTT_ACCT_NO_FLAGS;
   }
 
+  MuttAccountFlags rc = read_results(cac, fp);
   mutt_file_fclose(&fp);
   filter_wait(pid);
   return rc;
 }
 
+/**
+ * cache_find - Find the cache entry for a command line
+ * @param cmdline Command line to look for
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct AccountCmdCache *cache_find(const char *cmdline)
+{
+  struct AccountCmdCache *e = NULL;
+  STAILQ_FOREACH(e, &AccountCmdResults, entries)
+  {
+    if (mutt_str_equal(e->cmdline, cmdline))
+      return e;
+  }
+
+  return NULL;
+}
+
+/**
+ * cache_apply - Copy cached credentials to a ConnAccount
+ * @param e   Cache entry to read
+ * @param cac ConnAccount to write to
+ */
+static void cache_apply(const struct AccountCmdCache *e, struct ConnAccount *cac)
+{
+  if (e->flags & MUTT_ACCT_LOGIN)
+    mutt_str_copy(cac->login, e->cac.login, sizeof(cac->login));
+  if (e->flags & MUTT_ACCT_PASS)
+    mutt_str_copy(cac->pass, e->cac.pass, sizeof(cac->pass));
+  if (e->flags & MUTT_ACCT_USER)
+    mutt_str_copy(cac->user, e->cac.user, sizeof(cac->user));
+}
+
+/**
+ * cache_store - Remember the results of a command run
+ * @param cmdline Command line that was run
+ * @param cac     ConnAccount holding the results
+ * @param rc      Flags the command returned
+ * @param ttl     Lifetime of the entry, in seconds
+ */
+static void cache_store(const char *cmdline, const struct ConnAccount *cac,
+                        MuttAccountFlags rc, short ttl)
+{
+  if (rc == MUTT_ACCT_NO_FLAGS)
+    return;
+
+  struct AccountCmdCache *e = cache_find(cmdline);
+  if (!e)
+  {
+    e = mutt_mem_calloc(1, sizeof(*e));
+    e->cmdline = mutt_str_dup(cmdline);
+    STAILQ_INSERT_TAIL(&AccountCmdResults, e, entries);
+  }
+
+  e->cac = *cac;
+  e->flags = rc;
+  e->expiry = mutt_date_now() + ttl;
+}
+
+/**
+ * refresh_start - Start refreshing a cache entry in the background
+ * @param e Cache entry to refresh
+ *
+ * Only the fork/exec happens here; the command runs concurrently and its
+ * output is collected later by refresh_finish().
+ */
+static void refresh_start(struct AccountCmdCache *e)
+{
+  FILE *fp = NULL;
+  pid_t pid = filter_create(e->cmdline, NULL, &fp, NULL, EnvList);
+  if (pid < 0)
+    return;
+
+  e->refresh_pid = pid;
+  e->refresh_fp = fp;
+}
+
+/**
+ * refresh_ready - Has an in-flight refresh finished writing?
+ * @param e Cache entry with a refresh subprocess
+ * @retval true The command's output can be read without blocking
+ */
+static bool refresh_ready(const struct AccountCmdCache *e)
+{
+  struct pollfd pfd = { .fd = fileno(e->refresh_fp), .events = POLLIN };
+
+  return (poll(&pfd, 1, 0) > 0) && (pfd.revents & (POLLHUP | POLLERR));
+}
+
+/**
+ * refresh_finish - Collect the results of an in-flight refresh
+ * @param e   Cache entry with a refresh subprocess
+ * @param ttl Lifetime of the refreshed entry, in seconds
+ *
+ * On failure the old results are kept; the entry expires on its own and the
+ * next lookup runs the command synchronously.
+ */
+static void refresh_finish(struct AccountCmdCache *e, short ttl)
+{
+  struct ConnAccount cac = { { 0 } };
+
+  MuttAccountFlags rc = read_results(&cac, e->refresh_fp);
+  mutt_file_fclose(&e->refresh_fp);
+  filter_wait(e->refresh_pid);
+  e->refresh_pid = 0;
+
+  if (rc == MUTT_ACCT_NO_FLAGS)
+    return;
+
+  e->cac = cac;
+  e->flags = rc;
+  e->expiry = mutt_date_now() + ttl;
+}
+
 /**
  * mutt_account_call_external_cmd - Retrieve account credentials via an external command
  * @param cac ConnAccount to fill
@@ -179,9 +334,61 @@ MuttAccountFlags mutt_account_call_external_cmd(struct ConnAccount *cac)
   struct Buffer *cmd_buf = buf_pool_get();
 
   make_cmd(cmd_buf, cac, c_account_command);
+
+  const short c_account_command_ttl = cs_subset_number(NeoMutt->sub, "account_command_ttl");
+  if (c_account_command_ttl <= 0)
+  {
+    rc = call_cmd(cac, cmd_buf);
+    cac->flags |= rc;
+    buf_pool_release(&cmd_buf);
+    return rc;
+  }
+
+  const time_t now = mutt_date_now();
+  struct AccountCmdCache *e = cache_find(buf_string(cmd_buf));
+
+  /* Collect an in-flight refresh if its output is waiting, or if the entry
+   * has expired and we'd have to run the command now anyway */
+  if (e && (e->refresh_pid != 0) && ((e->expiry <= now) || refresh_ready(e)))
+    refresh_finish(e, c_account_command_ttl);
+
+  if (e && (e->expiry > now))
+  {
+    /* Refresh early, so the results never expire while NeoMutt is idle */
+    if ((e->refresh_pid == 0) && ((e->expiry - now) <= (c_account_command_ttl / 2)))
+      refresh_start(e);
+
+    cache_apply(e, cac);
+    rc = e->flags;
+    cac->flags |= rc;
+    buf_pool_release(&cmd_buf);
+    return rc;
+  }
+
   rc = call_cmd(cac, cmd_buf);
   cac->flags |= rc;
+  cache_store(buf_string(cmd_buf), cac, rc, c_account_command_ttl);
 
   buf_pool_release(&cmd_buf);
   return rc;
 }
+
+/**
+ * mutt_account_cmd_cache_cleanup - Free the $account_command cache
+ */
+void mutt_account_cmd_cache_cleanup(void)
+{
+  struct AccountCmdCache *e = NULL;
+  struct AccountCmdCache *tmp = NULL;
+  STAILQ_FOREACH_SAFE(e, &AccountCmdResults, entries, tmp)
+  {
+    if (e->refresh_pid != 0)
+    {
+      mutt_file_fclose(&e->refresh_fp);
+      filter_wait(e->refresh_pid);
+    }
+    FREE(&e->cmdline);
+    FREE(&e);
+  }
+  STAILQ_INIT(&AccountCmdResults);
+}
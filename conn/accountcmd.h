@@ -26,5 +26,6 @@
 #include "connaccount.h"
 
 MuttAccountFlags mutt_account_call_external_cmd(struct ConnAccount *cac);
+void             mutt_account_cmd_cache_cleanup(void);
 
 #endif /* MUTT_CONN_ACCOUNTCMD_H */
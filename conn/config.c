@@ -41,6 +41,9 @@ static struct ConfigDef ConnVars[] = {
   { "account_command", DT_STRING|D_STRING_COMMAND, 0, 0, NULL,
     "Shell command to retrieve account credentials"
   },
+  { "account_command_ttl", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(seconds) How long to cache the results of $account_command (0 to disable)"
+  },
   { "preconnect", DT_STRING, 0, 0, NULL,
     "(socket) External command to run prior to opening a socket"
   },
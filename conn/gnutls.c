@@ -84,6 +84,75 @@ struct TlsSockData
   gnutls_certificate_credentials_t xcred;
 };
 
+/** Cache of TLS session data from recently closed connections, keyed by
+ * "host:port".  Offering one of these to the server on reconnect allows an
+ * abbreviated handshake instead of a full key exchange. */
+static struct HashTable *TlsSessionCache = NULL;
+
+/**
+ * tls_session_free - Free cached TLS session data - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void tls_session_free(int type, void *obj, intptr_t data)
+{
+  gnutls_datum_t *d = obj;
+  gnutls_free(d->data);
+  FREE(&d);
+}
+
+/**
+ * tls_cache_session - Save a Connection's TLS session for later resumption
+ * @param conn    Connection to a server
+ * @param session TLS session being closed
+ */
+static void tls_cache_session(struct Connection *conn, gnutls_session_t session)
+{
+  gnutls_datum_t *d = mutt_mem_calloc(1, sizeof(gnutls_datum_t));
+  if ((gnutls_session_get_data2(session, d) != GNUTLS_E_SUCCESS) || (d->size == 0))
+  {
+    gnutls_free(d->data);
+    FREE(&d);
+    return;
+  }
+
+  if (!TlsSessionCache)
+  {
+    TlsSessionCache = mutt_hash_new(8, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(TlsSessionCache, tls_session_free, 0);
+  }
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%s:%hu", conn->account.host, conn->account.port);
+  gnutls_datum_t *old = mutt_hash_find(TlsSessionCache, buf_string(key));
+  if (old)
+    mutt_hash_delete(TlsSessionCache, buf_string(key), old);
+  mutt_hash_insert(TlsSessionCache, buf_string(key), d);
+  buf_pool_release(&key);
+}
+
+/**
+ * tls_resume_session - Offer a cached TLS session to the server
+ * @param conn    Connection to a server
+ * @param session TLS session, before the handshake
+ *
+ * The cached session is dropped after one use: TLS 1.3 tickets are single-use
+ * and fresh session data is captured when this connection closes.
+ */
+static void tls_resume_session(struct Connection *conn, gnutls_session_t session)
+{
+  if (!TlsSessionCache)
+    return;
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%s:%hu", conn->account.host, conn->account.port);
+  gnutls_datum_t *d = mutt_hash_find(TlsSessionCache, buf_string(key));
+  if (d)
+  {
+    gnutls_session_set_data(session, d->data, d->size); /* takes a copy */
+    mutt_hash_delete(TlsSessionCache, buf_string(key), d);
+  }
+  buf_pool_release(&key);
+}
+
 /**
  * tls_init - Set up Gnu TLS
  * @retval  0 Success
@@ -935,6 +1004,8 @@ static int tls_negotiate(struct Connection *conn)
 
   gnutls_credentials_set(data->session, GNUTLS_CRD_CERTIFICATE, data->xcred);
 
+  tls_resume_session(conn, data->session);
+
   do
   {
     err = gnutls_handshake(data->session);
@@ -954,6 +1025,9 @@ static int tls_negotiate(struct Connection *conn)
     goto fail;
   }
 
+  if (gnutls_session_is_resumed(data->session))
+    mutt_debug(LL_DEBUG2, "resumed TLS session for %s\n", conn->account.host);
+
   if (tls_check_certificate(conn) == 0)
     goto fail;
 
@@ -1012,6 +1086,7 @@ static int tls_socket_close(struct Connection *conn)
      * It is not required for the initiator of the close to wait for the
      * responding close_notify alert before closing the read side of the
      * connection.  */
+    tls_cache_session(conn, data->session);
     gnutls_bye(data->session, GNUTLS_SHUT_WR);
 
     gnutls_certificate_free_credentials(data->xcred);
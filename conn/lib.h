@@ -48,6 +48,7 @@
 
 #include "config.h"
 // IWYU pragma: begin_keep
+#include "accountcmd.h"
 #include "connaccount.h"
 #include "connection.h"
 #include "sasl_plain.h"
@@ -61,6 +62,9 @@
 #ifdef USE_ZLIB
 #include "zstrm.h"
 #endif
+#ifdef USE_ZSTD
+#include "zstdstrm.h"
+#endif
 // IWYU pragma: end_keep
 
 struct Buffer;
@@ -92,6 +92,11 @@ static int SkipModeExDataIndex = -1;
  * open up another connection to the same server in this session */
 static STACK_OF(X509) *SslSessionCerts = NULL;
 
+/** Cache of TLS sessions from recently closed connections, keyed by
+ * "host:port".  Offering one of these to the server on reconnect allows an
+ * abbreviated handshake instead of a full key exchange. */
+static struct HashTable *SslSessionCache = NULL;
+
 static int ssl_socket_close(struct Connection *conn);
 
 /**
@@ -1104,6 +1109,67 @@ static int ssl_verify_callback(int preverify_ok, X509_STORE_CTX *ctx)
   return true;
 }
 
+/**
+ * ssl_session_free - Free a cached TLS session - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void ssl_session_free(int type, void *obj, intptr_t data)
+{
+  SSL_SESSION_free(obj);
+}
+
+/**
+ * ssl_cache_session - Save a Connection's TLS session for later resumption
+ * @param conn Connection to a server
+ * @param ssl  SSL handle being closed
+ *
+ * Called just before the connection is shut down, so that TLS 1.3 session
+ * tickets delivered after the handshake have been seen.
+ */
+static void ssl_cache_session(struct Connection *conn, SSL *ssl)
+{
+  SSL_SESSION *session = SSL_get1_session(ssl);
+  if (!session)
+    return;
+
+  if (!SslSessionCache)
+  {
+    SslSessionCache = mutt_hash_new(8, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(SslSessionCache, ssl_session_free, 0);
+  }
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%s:%hu", conn->account.host, conn->account.port);
+  SSL_SESSION *old = mutt_hash_find(SslSessionCache, buf_string(key));
+  if (old)
+    mutt_hash_delete(SslSessionCache, buf_string(key), old);
+  mutt_hash_insert(SslSessionCache, buf_string(key), session);
+  buf_pool_release(&key);
+}
+
+/**
+ * ssl_resume_session - Offer a cached TLS session to the server
+ * @param conn Connection to a server
+ * @param ssl  SSL handle, before SSL_connect()
+ *
+ * The cached session is dropped after one use: TLS 1.3 tickets are single-use
+ * and a fresh session is captured when this connection closes.
+ */
+static void ssl_resume_session(struct Connection *conn, SSL *ssl)
+{
+  if (!SslSessionCache)
+    return;
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%s:%hu", conn->account.host, conn->account.port);
+  SSL_SESSION *session = mutt_hash_find(SslSessionCache, buf_string(key));
+  if (session)
+  {
+    SSL_set_session(ssl, session); /* takes its own reference */
+    mutt_hash_delete(SslSessionCache, buf_string(key), session);
+  }
+  buf_pool_release(&key);
+}
+
 /**
  * ssl_negotiate - Attempt to negotiate SSL over the wire
  * @param conn    Connection to a server
@@ -1156,6 +1222,8 @@ static int ssl_negotiate(struct Connection *conn, struct SslSockData *ssldata)
     mutt_error(_("Warning: unable to set TLS SNI host name"));
   }
 
+  ssl_resume_session(conn, ssldata->ssl);
+
   ERR_clear_error();
 
 retry:
@@ -1183,6 +1251,9 @@ retry:
     return -1;
   }
 
+  if (SSL_session_reused(ssldata->ssl))
+    mutt_debug(LL_DEBUG2, "resumed TLS session for %s\n", conn->account.host);
+
   return 0;
 }
 
@@ -1401,7 +1472,10 @@ static int ssl_socket_close(struct Connection *conn)
   if (data)
   {
     if (data->isopen && (raw_socket_poll(conn, 0) >= 0))
+    {
+      ssl_cache_session(conn, data->ssl);
       SSL_shutdown(data->ssl);
+    }
 
     SSL_free(data->ssl);
     data->ssl = NULL;
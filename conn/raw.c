@@ -55,8 +55,193 @@
 #endif
 #ifdef HAVE_GETADDRINFO
 #include <stdbool.h>
+#include <stdlib.h>
 #endif
 
+#ifdef HAVE_GETADDRINFO
+/// How long a cached DNS lookup stays valid, in seconds
+#define DNS_CACHE_TTL 300
+/// Delay before the next parallel connection attempt is started, in milliseconds
+#define CONN_ATTEMPT_DELAY_MS 250
+/// Maximum number of simultaneous connection attempts
+#define CONN_ATTEMPT_MAX 8
+
+/**
+ * struct DnsCacheEntry - Cached address lookup for one host
+ */
+struct DnsCacheEntry
+{
+  struct addrinfo *res; ///< Copy of the getaddrinfo() results
+  time_t expiry;        ///< When the entry stops being valid
+};
+
+/// Cache of DNS lookups, keyed by "host:port:family"
+static struct HashTable *DnsCache = NULL;
+
+/**
+ * addrinfo_free_list - Free a copied getaddrinfo() result list
+ * @param[out] ptr List to free
+ */
+static void addrinfo_free_list(struct addrinfo **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct addrinfo *next = NULL;
+  for (struct addrinfo *ai = *ptr; ai; ai = next)
+  {
+    next = ai->ai_next;
+    FREE(&ai->ai_addr);
+    FREE(&ai);
+  }
+  *ptr = NULL;
+}
+
+/**
+ * addrinfo_copy_list - Copy a getaddrinfo() result list
+ * @param res List to copy
+ * @retval ptr Copied list
+ *
+ * The copy can outlive freeaddrinfo() and is freed with addrinfo_free_list().
+ * @note ai_canonname is not copied; nothing here asks for it
+ */
+static struct addrinfo *addrinfo_copy_list(const struct addrinfo *res)
+{
+  struct addrinfo *head = NULL;
+  struct addrinfo **tail = &head;
+
+  for (; res; res = res->ai_next)
+  {
+    struct addrinfo *ai = mutt_mem_calloc(1, sizeof(struct addrinfo));
+    ai->ai_flags = res->ai_flags;
+    ai->ai_family = res->ai_family;
+    ai->ai_socktype = res->ai_socktype;
+    ai->ai_protocol = res->ai_protocol;
+    ai->ai_addrlen = res->ai_addrlen;
+    ai->ai_addr = mutt_mem_malloc(res->ai_addrlen);
+    memcpy(ai->ai_addr, res->ai_addr, res->ai_addrlen);
+
+    *tail = ai;
+    tail = &ai->ai_next;
+  }
+
+  return head;
+}
+
+/**
+ * dns_cache_free_entry - Free a DnsCacheEntry - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void dns_cache_free_entry(int type, void *obj, intptr_t data)
+{
+  struct DnsCacheEntry *entry = obj;
+  addrinfo_free_list(&entry->res);
+  FREE(&entry);
+}
+
+/**
+ * dns_cache_key - Build the cache key for a lookup
+ * @param key    Buffer for the key
+ * @param host   Hostname (ascii form)
+ * @param port   Port number
+ * @param family Address family passed to getaddrinfo()
+ */
+static void dns_cache_key(struct Buffer *key, const char *host, int port, int family)
+{
+  buf_printf(key, "%s:%d:%d", host, port, family);
+}
+
+/**
+ * dns_lookup - Resolve a hostname, using the DNS cache
+ * @param host  Hostname (ascii form)
+ * @param port  Port number
+ * @param serv  Port number as a string, for getaddrinfo()
+ * @param hints Lookup hints for getaddrinfo()
+ * @retval ptr  List of candidate addresses
+ * @retval NULL Lookup failed
+ *
+ * The returned list is owned by the cache; the caller must not free it.
+ * Repeated connections to the same account (e.g. IMAP reconnects, SMTP sends)
+ * skip the resolver round-trip until the entry expires.
+ */
+static struct addrinfo *dns_lookup(const char *host, int port, const char *serv,
+                                   const struct addrinfo *hints)
+{
+  struct addrinfo *ret = NULL;
+  struct Buffer *key = buf_pool_get();
+  dns_cache_key(key, host, port, hints->ai_family);
+
+  if (!DnsCache)
+  {
+    DnsCache = mutt_hash_new(16, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(DnsCache, dns_cache_free_entry, 0);
+  }
+
+  struct DnsCacheEntry *entry = mutt_hash_find(DnsCache, buf_string(key));
+  if (entry)
+  {
+    if (entry->expiry > mutt_date_now())
+    {
+      mutt_debug(LL_DEBUG2, "cached lookup for %s\n", buf_string(key));
+      ret = entry->res;
+      goto done;
+    }
+    mutt_hash_delete(DnsCache, buf_string(key), entry);
+    entry = NULL;
+  }
+
+  struct addrinfo *res = NULL;
+  if (getaddrinfo(host, serv, hints, &res) != 0)
+    goto done;
+
+  entry = mutt_mem_calloc(1, sizeof(struct DnsCacheEntry));
+  entry->res = addrinfo_copy_list(res);
+  entry->expiry = mutt_date_now() + DNS_CACHE_TTL;
+  freeaddrinfo(res);
+
+  mutt_hash_insert(DnsCache, buf_string(key), entry);
+  ret = entry->res;
+
+done:
+  buf_pool_release(&key);
+  return ret;
+}
+
+/**
+ * dns_cache_invalidate - Drop the cached lookup for a host
+ * @param host   Hostname (ascii form)
+ * @param port   Port number
+ * @param family Address family passed to getaddrinfo()
+ *
+ * Called when every cached address failed to connect - the addresses may
+ * simply be stale, so the next attempt should ask the resolver again.
+ */
+static void dns_cache_invalidate(const char *host, int port, int family)
+{
+  if (!DnsCache)
+    return;
+
+  struct Buffer *key = buf_pool_get();
+  dns_cache_key(key, host, port, family);
+
+  struct DnsCacheEntry *entry = mutt_hash_find(DnsCache, buf_string(key));
+  if (entry)
+    mutt_hash_delete(DnsCache, buf_string(key), entry);
+
+  buf_pool_release(&key);
+}
+#endif /* HAVE_GETADDRINFO */
+
+/**
+ * mutt_dns_cache_cleanup - Free the DNS lookup cache
+ */
+void mutt_dns_cache_cleanup(void)
+{
+#ifdef HAVE_GETADDRINFO
+  mutt_hash_free(&DnsCache);
+#endif
+}
+
+#ifndef HAVE_GETADDRINFO
 /**
  * socket_connect - Set up to connect to a socket fd
  * @param fd File descriptor to connect with
@@ -141,6 +326,171 @@ static int socket_connect(int fd, struct sockaddr *sa)
 
   return save_errno;
 }
+#endif /* !HAVE_GETADDRINFO */
+
+#ifdef HAVE_GETADDRINFO
+/**
+ * socket_connect_happy - Connect to a host, racing the candidate addresses
+ * @param conn Connection
+ * @param res  List of candidate addresses
+ * @retval  0 Success, Connection.fd is connected
+ * @retval >0 An errno from the last failed attempt
+ * @retval -1 Error
+ *
+ * "Happy eyeballs" (RFC 8305): start a non-blocking connect to the first
+ * address and, if it hasn't completed within #CONN_ATTEMPT_DELAY_MS, start
+ * the next one in parallel.  The first attempt to complete wins and the rest
+ * are closed, so a dead route delays the connection by a fraction of a
+ * second instead of its full timeout.
+ */
+static int socket_connect_happy(struct Connection *conn, struct addrinfo *res)
+{
+  int pending[CONN_ATTEMPT_MAX];
+  int num_pending = 0;
+  int winner = -1;
+  int last_err = -1;
+
+  const short c_socket_timeout = cs_subset_number(NeoMutt->sub, "socket_timeout");
+  const uint64_t start = mutt_date_now_ms();
+  const uint64_t deadline = (c_socket_timeout > 0) ?
+                                (start + (uint64_t) c_socket_timeout * 1000) :
+                                0;
+  uint64_t next_start = start;
+
+  struct addrinfo *next = res;
+
+  while (winner < 0)
+  {
+    const uint64_t now = mutt_date_now_ms();
+
+    // Start another attempt, staggered behind the previous one
+    if (next && (num_pending < CONN_ATTEMPT_MAX) &&
+        ((num_pending == 0) || (now >= next_start)))
+    {
+      int fd = socket(next->ai_family, next->ai_socktype, next->ai_protocol);
+      if (fd >= 0)
+      {
+        int flags = fcntl(fd, F_GETFL, 0);
+        (void) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        if (connect(fd, next->ai_addr, next->ai_addrlen) == 0)
+        {
+          winner = fd;
+        }
+        else if ((errno == EINPROGRESS) || (errno == EINTR))
+        {
+          pending[num_pending++] = fd;
+        }
+        else
+        {
+          last_err = errno;
+          mutt_debug(LL_DEBUG2, "Connection attempt failed. errno: %d\n", errno);
+          close(fd);
+        }
+      }
+      else
+      {
+        last_err = errno;
+      }
+      next = next->ai_next;
+      next_start = now + CONN_ATTEMPT_DELAY_MS;
+      continue;
+    }
+
+    if (num_pending == 0)
+      break; // every address has been tried
+
+    if (deadline && (now >= deadline))
+    {
+      last_err = ETIMEDOUT;
+      break;
+    }
+
+    // Wait for an attempt to complete, or for the next stagger slot
+    uint64_t wait_until = next ? next_start : (deadline ? deadline : (now + 1000));
+    if (deadline && (deadline < wait_until))
+      wait_until = deadline;
+
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    int maxfd = -1;
+    for (int i = 0; i < num_pending; i++)
+    {
+      FD_SET(pending[i], &wfds);
+      if (pending[i] > maxfd)
+        maxfd = pending[i];
+    }
+
+    const uint64_t wait_ms = (wait_until > now) ? (wait_until - now) : 0;
+    struct timeval tv = { 0 };
+    tv.tv_sec = wait_ms / 1000;
+    tv.tv_usec = (wait_ms % 1000) * 1000;
+
+    mutt_sig_allow_interrupt(true);
+    int rc = select(maxfd + 1, NULL, &wfds, NULL, &tv);
+    mutt_sig_allow_interrupt(false);
+
+    if (SigInt)
+    {
+      SigInt = false;
+      last_err = EINTR;
+      break;
+    }
+
+    if (rc < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      last_err = errno;
+      break;
+    }
+
+    for (int i = 0; i < num_pending; i++)
+    {
+      if (!FD_ISSET(pending[i], &wfds))
+        continue;
+
+      int err = 0;
+      socklen_t errlen = sizeof(err);
+      if (getsockopt(pending[i], SOL_SOCKET, SO_ERROR, &err, &errlen) < 0)
+        err = errno;
+
+      if (err == 0)
+      {
+        winner = pending[i];
+        pending[i] = pending[--num_pending];
+        break;
+      }
+
+      last_err = err;
+      mutt_debug(LL_DEBUG2, "Connection attempt failed. errno: %d\n", err);
+      close(pending[i]);
+      pending[i--] = pending[--num_pending];
+    }
+  }
+
+  for (int i = 0; i < num_pending; i++)
+    close(pending[i]);
+
+  if (winner < 0)
+    return last_err;
+
+  // Restore blocking mode and apply the read/write timeouts
+  int flags = fcntl(winner, F_GETFL, 0);
+  (void) fcntl(winner, F_SETFL, flags & ~O_NONBLOCK);
+
+  if (c_socket_timeout > 0)
+  {
+    const struct timeval tv = { c_socket_timeout, 0 };
+    if (setsockopt(winner, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0)
+      mutt_debug(LL_DEBUG2, "Cannot set socket receive timeout. errno: %d\n", errno);
+    if (setsockopt(winner, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0)
+      mutt_debug(LL_DEBUG2, "Cannot set socket send timeout. errno: %d\n", errno);
+  }
+
+  conn->fd = winner;
+  return 0;
+}
+#endif /* HAVE_GETADDRINFO */
 
 /**
  * raw_socket_open - Open a socket - Implements Connection::open() - @ingroup connection_open
@@ -157,8 +507,6 @@ int raw_socket_open(struct Connection *conn)
   /* "65536\0" */
   char port[6] = { 0 };
   struct addrinfo hints = { 0 };
-  struct addrinfo *res = NULL;
-  struct addrinfo *cur = NULL;
 
   /* we accept v4 or v6 STREAM sockets */
   const bool c_use_ipv6 = cs_subset_bool(NeoMutt->sub, "use_ipv6");
@@ -184,14 +532,12 @@ int raw_socket_open(struct Connection *conn)
   if (!OptNoCurses)
     mutt_message(_("Looking up %s..."), conn->account.host);
 
-  rc = getaddrinfo(host_idna, port, &hints, &res);
-
+  struct addrinfo *res = dns_lookup(host_idna, conn->account.port, port, &hints);
+  if (!res)
+  {
 #ifdef HAVE_LIBIDN
-  FREE(&host_idna);
+    FREE(&host_idna);
 #endif
-
-  if (rc)
-  {
     mutt_error(_("Could not find the host \"%s\""), conn->account.host);
     return -1;
   }
@@ -199,27 +545,20 @@ int raw_socket_open(struct Connection *conn)
   if (!OptNoCurses)
     mutt_message(_("Connecting to %s..."), conn->account.host);
 
-  rc = -1;
-  for (cur = res; cur; cur = cur->ai_next)
+  rc = socket_connect_happy(conn, res);
+  if (rc == 0)
   {
-    int fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
-    if (fd >= 0)
-    {
-      rc = socket_connect(fd, cur->ai_addr);
-      if (rc == 0)
-      {
-        (void) fcntl(fd, F_SETFD, FD_CLOEXEC);
-        conn->fd = fd;
-        break;
-      }
-      else
-      {
-        close(fd);
-      }
-    }
+    (void) fcntl(conn->fd, F_SETFD, FD_CLOEXEC);
+  }
+  else
+  {
+    // The addresses may be stale - resolve afresh on the next attempt
+    dns_cache_invalidate(host_idna, conn->account.port, hints.ai_family);
   }
 
-  freeaddrinfo(res);
+#ifdef HAVE_LIBIDN
+  FREE(&host_idna);
+#endif
 #else
   /* --- IPv4 only --- */
 
@@ -316,6 +655,8 @@ int raw_socket_read(struct Connection *conn, char *buf, size_t count)
     rc = -1;
   }
 
+  if (rc > 0)
+    perf_count(PERF_NET_READ, rc);
   return rc;
 }
 
@@ -346,6 +687,7 @@ int raw_socket_write(struct Connection *conn, const char *buf, size_t count)
   } while ((sent < count) && !SigInt);
 
   mutt_sig_allow_interrupt(false);
+  perf_count(PERF_NET_WRITE, sent);
   return sent;
 }
 
@@ -38,6 +38,7 @@ enum ConnectionType
   MUTT_CONNECTION_SSL,    ///< SSL/TLS-encrypted connection
 };
 
+void               mutt_dns_cache_cleanup(void);
 int                mutt_socket_close   (struct Connection *conn);
 void               mutt_socket_empty   (struct Connection *conn);
 struct Connection *mutt_socket_new     (enum ConnectionType type);
@@ -0,0 +1,263 @@
+/**
+ * @file
+ * Zstandard compression of network traffic
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page conn_zstdstrm Zstandard compression of network traffic
+ *
+ * Zstandard compression of network traffic, for servers offering
+ * `COMPRESS=ZSTD`.  Modelled on the zlib layer in conn/zstrm.c.
+ *
+ * Leftover wire data is consumed in place, using an offset into the read
+ * buffer, so no intermediate copies are made between the socket and the
+ * decompressor.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <zstd.h>
+#include "mutt/lib.h"
+#include "zstdstrm.h"
+#include "connection.h"
+
+/// Compression level for the write stream
+#define ZSTDSTRM_COMP_LEVEL 3
+
+/**
+ * struct ZstdstrmContext - Data compression layer
+ */
+struct ZstdstrmContext
+{
+  ZSTD_CStream *cstream;       ///< Compressor, for writes
+  ZSTD_DStream *dstream;       ///< Decompressor, for reads
+  char *rbuf;                  ///< Buffer of wire data awaiting decompression
+  size_t rlen;                 ///< Size of rbuf
+  size_t roff;                 ///< Offset of the unconsumed data in rbuf
+  size_t rpos;                 ///< Number of unconsumed bytes in rbuf
+  char *wbuf;                  ///< Buffer for compressed data being written
+  size_t wlen;                 ///< Size of wbuf
+  bool conn_eof;               ///< Connection end-of-file reached
+  bool out_full;               ///< Last read filled the caller's buffer
+  uint64_t bytes_in;           ///< Uncompressed bytes passed through the layer
+  uint64_t bytes_wire;         ///< Compressed bytes on the wire
+  struct Connection next_conn; ///< Underlying stream
+};
+
+/**
+ * zstdstrm_open - Open a socket - Implements Connection::open() - @ingroup connection_open
+ * @retval -1 Always
+ *
+ * Cannot open a zstd connection, must wrap an existing one
+ */
+static int zstdstrm_open(struct Connection *conn)
+{
+  return -1;
+}
+
+/**
+ * zstdstrm_close - Close a socket - Implements Connection::close() - @ingroup connection_close
+ */
+static int zstdstrm_close(struct Connection *conn)
+{
+  struct ZstdstrmContext *zctx = conn->sockdata;
+
+  int rc = zctx->next_conn.close(&zctx->next_conn);
+
+  mutt_debug(LL_DEBUG5, "zstd: %lu bytes app, %lu bytes wire (%.1fx)\n",
+             (unsigned long) zctx->bytes_in, (unsigned long) zctx->bytes_wire,
+             (double) zctx->bytes_in / (double) MAX(zctx->bytes_wire, 1));
+
+  // Restore the Connection's original functions
+  conn->sockdata = zctx->next_conn.sockdata;
+  conn->open = zctx->next_conn.open;
+  conn->close = zctx->next_conn.close;
+  conn->read = zctx->next_conn.read;
+  conn->write = zctx->next_conn.write;
+  conn->poll = zctx->next_conn.poll;
+
+  ZSTD_freeCStream(zctx->cstream);
+  ZSTD_freeDStream(zctx->dstream);
+  FREE(&zctx->rbuf);
+  FREE(&zctx->wbuf);
+  FREE(&zctx);
+
+  return rc;
+}
+
+/**
+ * zstdstrm_read - Read compressed data from a socket - Implements Connection::read() - @ingroup connection_read
+ */
+static int zstdstrm_read(struct Connection *conn, char *buf, size_t len)
+{
+  struct ZstdstrmContext *zctx = conn->sockdata;
+  int rc = 0;
+
+retry:
+  /* only touch the underlying stream when the leftover wire data has been
+   * used up, for it might block */
+  if ((zctx->rpos == 0) && !zctx->conn_eof)
+  {
+    zctx->roff = 0;
+    rc = zctx->next_conn.read(&zctx->next_conn, zctx->rbuf, zctx->rlen);
+    mutt_debug(LL_DEBUG5, "consuming data from next stream: %d bytes\n", rc);
+    if (rc < 0)
+      return rc;
+    else if (rc == 0)
+      zctx->conn_eof = true;
+    else
+      zctx->rpos = rc;
+    zctx->bytes_wire += zctx->rpos;
+  }
+
+  ZSTD_inBuffer zin = { zctx->rbuf + zctx->roff, zctx->rpos, 0 };
+  ZSTD_outBuffer zout = { buf, len, 0 };
+
+  const size_t zrc = ZSTD_decompressStream(zctx->dstream, &zout, &zin);
+  if (ZSTD_isError(zrc))
+  {
+    mutt_debug(LL_DEBUG5, "ZSTD_decompressStream: %s. aborting\n", ZSTD_getErrorName(zrc));
+    return -1;
+  }
+
+  /* the unconsumed input stays where it is and is picked up next call */
+  zctx->roff += zin.pos;
+  zctx->rpos -= zin.pos;
+  zctx->out_full = (zout.pos == zout.size);
+
+  mutt_debug(LL_DEBUG5, "consumed %zu/%zu bytes, produced %zu/%zu bytes\n",
+             zin.pos, zin.size, zout.pos, zout.size);
+
+  if (zout.pos == 0)
+  {
+    if (zctx->conn_eof && (zctx->rpos == 0))
+      return 0;
+    goto retry;
+  }
+
+  zctx->bytes_in += zout.pos;
+  perf_count(PERF_NET_INFLATED, zout.pos);
+  return (int) zout.pos;
+}
+
+/**
+ * zstdstrm_poll - Check if any data is waiting on a socket - Implements Connection::poll() - @ingroup connection_poll
+ */
+static int zstdstrm_poll(struct Connection *conn, time_t wait_secs)
+{
+  struct ZstdstrmContext *zctx = conn->sockdata;
+
+  mutt_debug(LL_DEBUG5, "%s\n", zctx->out_full || (zctx->rpos > 0) ?
+                                    "last read wrote full buffer" :
+                                    "falling back on next stream");
+  if (zctx->out_full || (zctx->rpos > 0))
+    return 1;
+
+  return zctx->next_conn.poll(&zctx->next_conn, wait_secs);
+}
+
+/**
+ * zstdstrm_write - Write compressed data to a socket - Implements Connection::write() - @ingroup connection_write
+ */
+static int zstdstrm_write(struct Connection *conn, const char *buf, size_t count)
+{
+  struct ZstdstrmContext *zctx = conn->sockdata;
+
+  ZSTD_inBuffer zin = { buf, count, 0 };
+  size_t remaining = 0;
+
+  do
+  {
+    ZSTD_outBuffer zout = { zctx->wbuf, zctx->wlen, 0 };
+
+    /* flush, so the server can act on what we sent */
+    remaining = ZSTD_compressStream2(zctx->cstream, &zout, &zin, ZSTD_e_flush);
+    if (ZSTD_isError(remaining))
+    {
+      mutt_debug(LL_DEBUG5, "ZSTD_compressStream2: %s. aborting\n",
+                 ZSTD_getErrorName(remaining));
+      return -1;
+    }
+
+    /* push out produced data to the underlying stream */
+    char *wbufp = zctx->wbuf;
+    size_t pos = zout.pos;
+    zctx->bytes_wire += pos;
+    while (pos > 0)
+    {
+      const int rc = zctx->next_conn.write(&zctx->next_conn, wbufp, pos);
+      mutt_debug(LL_DEBUG5, "next stream wrote: %d bytes\n", rc);
+      if (rc < 0)
+        return -1; /* we can't recover from write failure */
+
+      wbufp += rc;
+      pos -= rc;
+    }
+  } while ((zin.pos < zin.size) || (remaining != 0));
+
+  zctx->bytes_in += count;
+  perf_count(PERF_NET_DEFLATED, count);
+
+  const int rc = (int) count;
+  return (rc <= 0) ? 1 : rc; /* avoid wrong behaviour due to overflow */
+}
+
+/**
+ * mutt_zstdstrm_wrap_conn - Wrap a compression layer around a Connection
+ * @param conn Connection to wrap
+ *
+ * Replace the read/write functions with our compression functions.
+ * After reading from the socket, we decompress and pass on the data.
+ * Before writing to a socket, we compress the data.
+ */
+void mutt_zstdstrm_wrap_conn(struct Connection *conn)
+{
+  struct ZstdstrmContext *zctx = mutt_mem_calloc(1, sizeof(struct ZstdstrmContext));
+
+  /* store wrapped stream as next stream */
+  zctx->next_conn.fd = conn->fd;
+  zctx->next_conn.sockdata = conn->sockdata;
+  zctx->next_conn.open = conn->open;
+  zctx->next_conn.close = conn->close;
+  zctx->next_conn.read = conn->read;
+  zctx->next_conn.write = conn->write;
+  zctx->next_conn.poll = conn->poll;
+
+  /* replace connection with our wrappers, where appropriate */
+  conn->sockdata = zctx;
+  conn->open = zstdstrm_open;
+  conn->read = zstdstrm_read;
+  conn->write = zstdstrm_write;
+  conn->close = zstdstrm_close;
+  conn->poll = zstdstrm_poll;
+
+  /* allocate (de)compression buffers and streams */
+  zctx->rlen = 8192;
+  zctx->rbuf = mutt_mem_malloc(zctx->rlen);
+  zctx->wlen = 8192;
+  zctx->wbuf = mutt_mem_malloc(zctx->wlen);
+
+  zctx->cstream = ZSTD_createCStream();
+  ZSTD_initCStream(zctx->cstream, ZSTDSTRM_COMP_LEVEL);
+  zctx->dstream = ZSTD_createDStream();
+  ZSTD_initDStream(zctx->dstream);
+}
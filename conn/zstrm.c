@@ -47,6 +47,7 @@ struct ZstrmDirection
   char *buf;           ///< Buffer for data being (de-)compressed
   unsigned int len;    ///< Length of data
   unsigned int pos;    ///< Current position
+  unsigned int off;    ///< Offset of unconsumed data in buf
   bool conn_eof : 1;   ///< Connection end-of-file reached
   bool stream_eof : 1; ///< Stream end-of-file reached
 };
@@ -144,6 +145,7 @@ retry:
    * read on the underlying stream in that case (for it might block) */
   if ((zctx->read.pos == 0) && !zctx->read.conn_eof)
   {
+    zctx->read.off = 0;
     rc = zctx->next_conn.read(&zctx->next_conn, zctx->read.buf, zctx->read.len);
     mutt_debug(LL_DEBUG5, "consuming data from next stream: %d bytes\n", rc);
     if (rc < 0)
@@ -155,7 +157,7 @@ retry:
   }
 
   zctx->read.z.avail_in = (uInt) zctx->read.pos;
-  zctx->read.z.next_in = (Bytef *) zctx->read.buf;
+  zctx->read.z.next_in = (Bytef *) (zctx->read.buf + zctx->read.off);
   zctx->read.z.avail_out = (uInt) len;
   zctx->read.z.next_out = (Bytef *) buf;
 
@@ -164,12 +166,9 @@ retry:
              zrc, zctx->read.pos - zctx->read.z.avail_in, zctx->read.pos,
              len - zctx->read.z.avail_out, len);
 
-  /* shift any remaining input data to the front of the buffer */
-  if ((Bytef *) zctx->read.buf != zctx->read.z.next_in)
-  {
-    memmove(zctx->read.buf, zctx->read.z.next_in, zctx->read.z.avail_in);
-    zctx->read.pos = zctx->read.z.avail_in;
-  }
+  /* any remaining input data stays in place and is consumed next call */
+  zctx->read.off += zctx->read.pos - zctx->read.z.avail_in;
+  zctx->read.pos = zctx->read.z.avail_in;
 
   switch (zrc)
   {
@@ -205,6 +204,8 @@ retry:
       break;
   }
 
+  if (zrc > 0)
+    perf_count(PERF_NET_INFLATED, zrc);
   return zrc;
 }
 
@@ -276,6 +277,7 @@ static int zstrm_write(struct Connection *conn, const char *buf, size_t count)
     }
   } while (true);
 
+  perf_count(PERF_NET_DEFLATED, count);
   rc = (int) count;
   return (rc <= 0) ? 1 : rc; /* avoid wrong behaviour due to overflow */
 }
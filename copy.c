@@ -51,6 +51,7 @@
 #include "globals.h"
 #include "handler.h"
 #include "hdrline.h"
+#include "maildir/hcache.h"
 #include "mx.h"
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
@@ -745,7 +746,7 @@ int mutt_copy_message_fp(FILE *fp_out, FILE *fp_in, struct Email *e,
         body->offset = new_offset;
 
         body->length = new_length;
-        mutt_body_free(&body->parts);
+        email_parts_invalidate(e);
       }
 
       rc_attach_del = 0;
@@ -882,7 +883,7 @@ int mutt_copy_message_fp(FILE *fp_out, FILE *fp_in, struct Email *e,
       (new_offset != -1))
   {
     body->offset = new_offset;
-    mutt_body_free(&body->parts);
+    email_parts_invalidate(e);
   }
 
 done:
@@ -964,6 +965,13 @@ static int append_message(struct Mailbox *dest, FILE *fp_in, struct Mailbox *src
     nm_update_filename(src, NULL, msg->committed_path, e);
 #endif
 
+  /* a verbatim maildir-to-maildir copy can take its cache record along */
+  if ((rc == 0) && msg->committed_path && (cmflags == MUTT_CM_NO_FLAGS) &&
+      (dest->type == MUTT_MAILDIR) && (src->type == MUTT_MAILDIR))
+  {
+    maildir_hcache_copy(src, e, dest, msg->committed_path);
+  }
+
   mx_msg_close(dest, &msg);
   return rc;
 }
@@ -133,6 +133,7 @@ void mailbox_free(struct Mailbox **ptr)
   FREE(&m->realpath);
   FREE(&m->emails);
   FREE(&m->v2r);
+  FREE(&m->tagged);
   notify_free(&m->notify);
   mailbox_gc_run();
 
@@ -261,6 +262,53 @@ void mailbox_size_sub(struct Mailbox *m, const struct Email *e)
   m->size -= email_size(e);
 }
 
+/**
+ * mailbox_tagged_add - Add an Email to the set of tagged Emails
+ * @param m Mailbox
+ * @param e Email that was tagged
+ *
+ * The set lets tagged operations enumerate the tagged messages directly,
+ * instead of scanning the whole mailbox.  Mailbox::msg_tagged is its size:
+ * resetting the count empties the set.
+ */
+void mailbox_tagged_add(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e)
+    return;
+
+  if (m->msg_tagged >= m->tagged_max)
+  {
+    m->tagged_max = MAX(m->tagged_max * 2, 32);
+    mutt_mem_realloc(&m->tagged, m->tagged_max * sizeof(struct Email *));
+  }
+
+  m->tagged[m->msg_tagged++] = e;
+}
+
+/**
+ * mailbox_tagged_remove - Remove an Email from the set of tagged Emails
+ * @param m Mailbox
+ * @param e Email that was untagged
+ *
+ * Nothing happens if the Email isn't in the set.
+ */
+void mailbox_tagged_remove(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e)
+    return;
+
+  for (int i = 0; i < m->msg_tagged; i++)
+  {
+    if (m->tagged[i] != e)
+      continue;
+
+    m->msg_tagged--;
+    memmove(&m->tagged[i], &m->tagged[i + 1],
+            (m->msg_tagged - i) * sizeof(struct Email *));
+    break;
+  }
+}
+
 /**
  * mailbox_set_subset - Set a Mailbox's Config Subset
  * @param m   Mailbox
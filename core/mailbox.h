@@ -98,11 +98,15 @@ struct Mailbox
   int *v2r;                           ///< Mapping from virtual to real msgno
   int vcount;                         ///< The number of virtual messages
 
+  struct Email **tagged;              ///< Set of tagged Emails, the first #Mailbox::msg_tagged entries
+  int tagged_max;                     ///< Size of `tagged` array
+
   bool notified;                      ///< User has been notified
   enum MailboxType type;              ///< Mailbox type
   bool newly_created;                 ///< Mbox or mmdf just popped into existence
   struct timespec last_visited;       ///< Time of last exit from this mailbox
   time_t last_checked;                ///< Last time we checked this mailbox for new mail
+  time_t last_stats_check;            ///< Last time we counted this mailbox's messages
 
   const struct MxOps *mx_ops;         ///< MXAPI callback functions
 
@@ -209,6 +213,8 @@ struct Mailbox *mailbox_new       (void);
 bool            mailbox_set_subset(struct Mailbox *m, struct ConfigSubset *sub);
 void            mailbox_size_add  (struct Mailbox *m, const struct Email *e);
 void            mailbox_size_sub  (struct Mailbox *m, const struct Email *e);
+void            mailbox_tagged_add   (struct Mailbox *m, struct Email *e);
+void            mailbox_tagged_remove(struct Mailbox *m, struct Email *e);
 void            mailbox_update    (struct Mailbox *m);
 void            mailbox_gc_add    (struct Email *e);
 void            mailbox_gc_run    (void);
@@ -32,6 +32,7 @@
 struct Account;
 struct Buffer;
 struct Email;
+struct EmailArray;
 struct Message;
 struct stat;
 
@@ -261,6 +262,28 @@ struct MxOps
    */
   int (*msg_close)(struct Mailbox *m, struct Message *msg);
 
+  /**
+   * @defgroup mx_msg_copy_batch msg_copy_batch()
+   * @ingroup mx_api
+   *
+   * msg_copy_batch - Copy a set of messages to another Mailbox
+   * @param m_src Source Mailbox
+   * @param ea    Array of Emails to copy
+   * @param m_dst Destination Mailbox, opened for appending
+   * @retval  0 Success
+   * @retval  1 This pair of Mailboxes isn't supported, copy them one at a time
+   * @retval -1 Failure
+   *
+   * An optional fast path for copying many messages at once, e.g. by linking
+   * the files of two Maildirs on the same filesystem.  The copy must be
+   * equivalent to appending the messages individually.
+   *
+   * @pre m_src is not NULL
+   * @pre ea    is not NULL
+   * @pre m_dst is not NULL
+   */
+  int (*msg_copy_batch)(struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst);
+
   /**
    * @defgroup mx_msg_padding_size msg_padding_size()
    * @ingroup mx_api
@@ -215,7 +215,7 @@ void dump_email(const struct Email *e)
 
   buf_pool_release(&buf);
 
-  mutt_debug(LL_DEBUG1, "\tnum_hidden: %ld\n", e->num_hidden);
+  mutt_debug(LL_DEBUG1, "\tnum_hidden: %d\n", e->num_hidden);
   mutt_debug(LL_DEBUG1, "\trecipient: %d\n", e->recipient);
   mutt_debug(LL_DEBUG1, "\toffset: %ld\n", e->offset);
   mutt_debug(LL_DEBUG1, "\tlines: %d\n", e->lines);
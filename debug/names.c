@@ -115,6 +115,7 @@ const char *name_notify_type(enum NotifyType type)
     DEBUG_NAME(NT_SCORE);
     DEBUG_NAME(NT_SUBJRX);
     DEBUG_NAME(NT_TIMEOUT);
+    DEBUG_NAME(NT_TPOOL);
     DEBUG_NAME(NT_WINDOW);
     DEBUG_DEFAULT;
   }
@@ -235,6 +235,7 @@ int debug_all_observer(struct NotifyCallback *nc)
       break;
     case NT_RESIZE:
     case NT_TIMEOUT:
+    case NT_TPOOL:
       break; // no other data
     case NT_WINDOW:
       if (nc->event_subtype == NT_WINDOW_STATE)
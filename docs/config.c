@@ -1916,6 +1916,11 @@
 ** disconnect when opening the mailbox, by sending a FETCH per set
 ** of this many headers, instead of a single FETCH for all new
 ** headers.
+** .pp
+** When \fIunset\fP, or set to 0, NeoMutt picks the group size itself: it
+** measures how fast the headers arrive and sizes each request to take about
+** two seconds, so fast links get large requests and slow links stay
+** responsive.
 */
 
 { "imap_headers", DT_STRING, 0 },
@@ -2398,6 +2403,17 @@
 */
 #endif
 
+{ "maildir_scan_threads", DT_NUMBER, 0 },
+/*
+** .pp
+** Number of worker threads used to parse the messages when a maildir
+** folder is opened or polled.  Using several threads can speed up opening
+** large folders considerably, especially on a cold cache.  When set to
+** \fI0\fP or \fI1\fP, messages are parsed serially.
+** \fBNote:\fP this only applies to maildir-style mailboxes.  Setting
+** it will have no effect on other mailbox types.
+*/
+
 { "maildir_trash", DT_BOOL, false },
 /*
 ** .pp
@@ -2460,6 +2476,16 @@
 ** This can also be set using the \fC-m\fP command-line option.
 */
 
+{ "mbox_use_mmap", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, mbox folders are parsed through a memory map instead of
+** reading every line, which is considerably faster for large files.  The
+** message bodies are skipped entirely while scanning for message
+** separators.  \fBNote:\fP this only applies to mbox-style mailboxes.
+** Setting it will have no effect on other mailbox types.
+*/
+
 { "me_too", DT_BOOL, false },
 /*
 ** .pp
@@ -486,6 +486,9 @@ int enter_function_dispatcher(struct MuttWindow *win, int op)
 
   struct EnterWindowData *wdata = win->wdata;
 
+  // The editing functions expect a contiguous string
+  enter_state_gap_close(wdata->state);
+
   int rc = FR_UNKNOWN;
   for (size_t i = 0; EnterFunctions[i].op != OP_NULL; i++)
   {
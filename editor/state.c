@@ -67,6 +67,49 @@ void enter_state_resize(struct EnterState *es, size_t num)
   es->wbuflen = num;
 }
 
+/**
+ * enter_state_gap_close - Make the entered string contiguous
+ * @param es State of the Enter buffer
+ *
+ * Move the text after the cursor down to close the insertion gap.
+ * Afterwards, wbuf[0 .. lastchar) holds the string being entered.
+ */
+void enter_state_gap_close(struct EnterState *es)
+{
+  if (!es || (es->gap == 0))
+    return;
+
+  wmemmove(es->wbuf + es->curpos, es->wbuf + es->curpos + es->gap,
+           es->lastchar - es->curpos);
+  es->gap = 0;
+}
+
+/**
+ * enter_state_insert - Insert a wide character at the cursor
+ * @param es State of the Enter buffer
+ * @param wc Character to insert
+ *
+ * The text after the cursor is only moved when the gap is empty, and the
+ * buffer grows geometrically, so repeated insertion is O(1) amortised.
+ */
+void enter_state_insert(struct EnterState *es, wchar_t wc)
+{
+  if (!es)
+    return;
+
+  if (es->gap == 0)
+  {
+    enter_state_resize(es, es->lastchar + MAX(es->lastchar / 2, 128));
+    es->gap = es->wbuflen - es->lastchar;
+    wmemmove(es->wbuf + es->curpos + es->gap, es->wbuf + es->curpos,
+             es->lastchar - es->curpos);
+  }
+
+  es->wbuf[es->curpos++] = wc;
+  es->gap--;
+  es->lastchar++;
+}
+
 /**
  * enter_state_new - Create a new EnterState
  * @retval ptr New EnterState
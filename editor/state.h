@@ -27,6 +27,11 @@
 
 /**
  * struct EnterState - Keep our place when entering a string
+ *
+ * The buffer is a gap buffer: while characters are being inserted, the spare
+ * capacity sits at the cursor, wbuf[curpos .. curpos+gap), and the text after
+ * the cursor starts at wbuf[curpos+gap].
+ * Call enter_state_gap_close() before reading wbuf as a contiguous string.
  */
 struct EnterState
 {
@@ -35,9 +40,12 @@ struct EnterState
   size_t lastchar; ///< Position of the last character
   size_t curpos;   ///< Position of the cursor
   size_t begin;    ///< Position of the start
+  size_t gap;      ///< Number of unused slots at the cursor
 };
 
 void               enter_state_free(struct EnterState **ptr);
+void               enter_state_gap_close(struct EnterState *es);
+void               enter_state_insert(struct EnterState *es, wchar_t wc);
 struct EnterState *enter_state_new(void);
 void               enter_state_resize(struct EnterState *es, size_t num);
 
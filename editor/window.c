@@ -126,6 +126,7 @@ bool self_insert(struct EnterWindowData *wdata, int ch)
   if ((wc == '\r') || (wc == '\n'))
   {
     /* Convert from wide characters */
+    enter_state_gap_close(wdata->state);
     buf_mb_wcstombs(wdata->buffer, wdata->state->wbuf, wdata->state->lastchar);
     if (!wdata->pass)
       mutt_hist_add(wdata->hclass, buf_string(wdata->buffer), true);
@@ -147,16 +148,7 @@ bool self_insert(struct EnterWindowData *wdata, int ch)
   }
   else if (wc && ((wc < ' ') || IsWPrint(wc))) /* why? */
   {
-    if (wdata->state->lastchar >= wdata->state->wbuflen)
-    {
-      wdata->state->wbuflen = wdata->state->lastchar + 20;
-      mutt_mem_realloc(&wdata->state->wbuf, wdata->state->wbuflen * sizeof(wchar_t));
-    }
-    memmove(wdata->state->wbuf + wdata->state->curpos + 1,
-            wdata->state->wbuf + wdata->state->curpos,
-            (wdata->state->lastchar - wdata->state->curpos) * sizeof(wchar_t));
-    wdata->state->wbuf[wdata->state->curpos++] = wc;
-    wdata->state->lastchar++;
+    enter_state_insert(wdata->state, wc);
   }
   else
   {
@@ -202,6 +194,7 @@ static int enter_repaint(struct MuttWindow *win)
 
   if (!wdata->pass)
   {
+    enter_state_gap_close(wdata->state);
     if (wdata->redraw == ENTER_REDRAW_INIT)
     {
       /* Go to end of line */
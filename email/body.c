@@ -37,13 +37,16 @@
 #include "mime.h"
 #include "parameter.h"
 
+/// Slab allocator for Bodies
+static struct Slab BodySlab = SLAB_INITIALIZER(struct Body);
+
 /**
  * mutt_body_new - Create a new Body
  * @retval ptr Newly allocated Body
  */
 struct Body *mutt_body_new(void)
 {
-  struct Body *p = mutt_mem_calloc(1, sizeof(struct Body));
+  struct Body *p = slab_alloc(&BodySlab);
 
   p->disposition = DISP_ATTACH;
   p->use_disp = true;
@@ -95,7 +98,7 @@ void mutt_body_free(struct Body **ptr)
 
     mutt_env_free(&b->mime_headers);
     mutt_body_free(&b->parts);
-    FREE(&b);
+    slab_free(&BodySlab, (void **) &b);
   }
 
   *ptr = NULL;
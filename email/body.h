@@ -65,8 +65,6 @@ struct Body
   // ---------------------------------------------------------------------------
   // Management data - Runtime info and glue to hold the objects together
 
-  bool unlink           : 1;      ///< If true, `filename` should be unlink()ed before free()ing this structure
-
   struct Content *content;        ///< Detailed info about the content of the attachment.
                                   ///< Used to determine what content-transfer-encoding is required when sending mail.
   struct Body *next;              ///< next attachment in the list
@@ -80,6 +78,7 @@ struct Body
                                   ///< The charset used in the generated message is stored in parameter.
   long hdr_offset;                ///< Offset in stream where the headers begin.
                                   ///< This info is used when invoking metamail, where we need to send the headers of the attachment
+  bool unlink           : 1;      ///< If true, `filename` should be unlink()ed before free()ing this structure
 
   // ---------------------------------------------------------------------------
   // View data - Used by the GUI
@@ -39,6 +39,9 @@
 
 void nm_edata_free(void **ptr);
 
+/// Slab allocator for Emails
+static struct Slab EmailSlab = SLAB_INITIALIZER(struct Email);
+
 /**
  * email_free - Free an Email
  * @param[out] ptr Email to free
@@ -61,13 +64,15 @@ void email_free(struct Email **ptr)
   mutt_body_free(&e->body);
   FREE(&e->tree);
   FREE(&e->path);
+  FREE(&e->disp_date);
+  FREE(&e->disp_date_local);
 #ifdef USE_NOTMUCH
   nm_edata_free(&e->nm_edata);
 #endif
   driver_tags_free(&e->tags);
   notify_free(&e->notify);
 
-  FREE(ptr);
+  slab_free(&EmailSlab, (void **) ptr);
 }
 
 /**
@@ -78,7 +83,7 @@ struct Email *email_new(void)
 {
   static size_t sequence = 0;
 
-  struct Email *e = mutt_mem_calloc(1, sizeof(struct Email));
+  struct Email *e = slab_alloc(&EmailSlab);
   STAILQ_INIT(&e->tags);
   e->visible = true;
   e->sequence = sequence++;
@@ -125,6 +130,61 @@ size_t email_size(const struct Email *e)
   return e->body->length + e->body->offset - e->body->hdr_offset;
 }
 
+/**
+ * email_parts_ref - Take a reference to the parsed part tree of an Email
+ * @param e Email
+ *
+ * A view that keeps pointers into Email::body->parts across an event loop
+ * should hold a reference, so that invalidation can't free the tree from
+ * under it.  Release it with email_parts_unref().
+ */
+void email_parts_ref(struct Email *e)
+{
+  if (!e)
+    return;
+
+  e->parts_refs++;
+}
+
+/**
+ * email_parts_unref - Release a reference to the parsed part tree of an Email
+ * @param e Email
+ *
+ * If the tree was invalidated while references were held, the last one out
+ * frees it.
+ */
+void email_parts_unref(struct Email *e)
+{
+  if (!e || (e->parts_refs == 0))
+    return;
+
+  e->parts_refs--;
+  if ((e->parts_refs == 0) && e->body && e->body->parts &&
+      (e->parts_gen != e->content_gen))
+  {
+    mutt_body_free(&e->body->parts);
+  }
+}
+
+/**
+ * email_parts_invalidate - Mark the parsed part tree of an Email as stale
+ * @param e Email
+ *
+ * Call this when the message content changes, e.g. when a sync rewrites the
+ * message and the cached offsets no longer apply.  The tree is freed at once
+ * if nothing references it, otherwise when the last reference is released;
+ * either way, the next mutt_parse_mime_message() will re-parse.
+ */
+void email_parts_invalidate(struct Email *e)
+{
+  if (!e)
+    return;
+
+  e->content_gen++;
+  if ((e->parts_refs == 0) && e->body)
+    mutt_body_free(&e->body->parts);
+}
+
 /**
  * header_find - Find a header, matching on its field, in a list of headers
  * @param hdrlist List of headers to search
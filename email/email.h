@@ -27,6 +27,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 #include "mutt/lib.h"
 #include "ncrypt/lib.h"
@@ -67,17 +68,15 @@ struct Email
   size_t sequence;             ///< Sequence number assigned on creation
   struct Envelope *env;        ///< Envelope information
   struct Body *body;           ///< List of MIME parts
+  int content_gen;             ///< Generation of the message content, bumped when a sync rewrites it
+  int parts_gen;               ///< Generation of the content that Email::body->parts was parsed from
+  short parts_refs;            ///< Views holding a reference to the parsed part tree
   char *path;                  ///< Path of Email (for local Mailboxes)
   LOFF_T offset;               ///< Where in the stream does this message begin?
   struct TagList tags;         ///< For drivers that support server tagging
   struct Notify *notify;       ///< Notifications: #NotifyEmail, #EventEmail
   void *edata;                 ///< Driver-specific data
 
-  bool active          : 1;    ///< Message is not to be removed
-  bool changed         : 1;    ///< Email has been edited
-  bool deleted         : 1;    ///< Email is deleted
-  bool purge           : 1;    ///< Skip trash folder when deleting
-
   /**
    * @defgroup email_edata_free Email Private Data API
    *
@@ -93,6 +92,11 @@ struct Email
   void *nm_edata;              ///< Notmuch private data
 #endif
 
+  bool active          : 1;    ///< Message is not to be removed
+  bool changed         : 1;    ///< Email has been edited
+  bool deleted         : 1;    ///< Email is deleted
+  bool purge           : 1;    ///< Skip trash folder when deleting
+
   // ---------------------------------------------------------------------------
   // View data - Used by the GUI
 
@@ -107,22 +111,27 @@ struct Email
   bool tagged          : 1;    ///< Email is tagged
   bool threaded        : 1;    ///< Used for threading
 
+  // The following are used to support collapsing threads
+  bool collapsed     : 1;      ///< Is this message part of a collapsed thread?
+  bool visible       : 1;      ///< Is this message part of the view?
+  bool limit_visited : 1;      ///< Has the limit pattern been applied to this message?
+
   int index;                   ///< The absolute (unsorted) message number
   int msgno;                   ///< Number displayed to the user
-  const struct AttrColor *attr_color; ///< Color-pair to use when displaying in the index
   int score;                   ///< Message score
+  const struct AttrColor *attr_color; ///< Color-pair to use when displaying in the index
+  unsigned int attr_color_gen; ///< Generation of the colour rules used to compute Email::attr_color
+  int score_gen;               ///< Generation of the score rules used to compute Email::score
   int vnum;                    ///< Virtual message number
   short attach_total;          ///< Number of qualifying attachments in message, if attach_valid
   short recipient;             ///< User_is_recipient()'s return value, cached
-
-  // The following are used to support collapsing threads
-  struct MuttThread *thread;   ///< Thread of Emails
-  bool collapsed     : 1;      ///< Is this message part of a collapsed thread?
-  bool visible       : 1;      ///< Is this message part of the view?
-  bool limit_visited : 1;      ///< Has the limit pattern been applied to this message?
-  size_t num_hidden;           ///< Number of hidden messages in this view
+  int num_hidden;              ///< Number of hidden messages in this view
                                ///< (only valid when collapsed is set)
+  struct MuttThread *thread;   ///< Thread of Emails
   char *tree;                  ///< Character string to print thread tree
+  char *disp_date;             ///< Cached '%d' index date (sender's timezone)
+  char *disp_date_local;       ///< Cached '%D' index date (local timezone)
+  uint64_t disp_date_gen;      ///< Config generation the cached dates were rendered under
 };
 ARRAY_HEAD(EmailArray, struct Email *);
 
@@ -221,6 +230,9 @@ struct EventHeader
 bool          email_cmp_strict(const struct Email *e1, const struct Email *e2);
 void          email_free      (struct Email **ptr);
 struct Email *email_new       (void);
+void          email_parts_invalidate(struct Email *e);
+void          email_parts_ref       (struct Email *e);
+void          email_parts_unref     (struct Email *e);
 size_t        email_size      (const struct Email *e);
 
 struct ListNode *header_add   (struct ListHead *hdrlist, const char *header);
@@ -39,13 +39,16 @@
 #include "envelope.h"
 #include "email.h"
 
+/// Slab allocator for Envelopes
+static struct Slab EnvelopeSlab = SLAB_INITIALIZER(struct Envelope);
+
 /**
  * mutt_env_new - Create a new Envelope
  * @retval ptr New Envelope
  */
 struct Envelope *mutt_env_new(void)
 {
-  struct Envelope *env = mutt_mem_calloc(1, sizeof(struct Envelope));
+  struct Envelope *env = slab_alloc(&EnvelopeSlab);
   TAILQ_INIT(&env->return_path);
   TAILQ_INIT(&env->from);
   TAILQ_INIT(&env->to);
@@ -65,10 +68,29 @@ struct Envelope *mutt_env_new(void)
  * mutt_env_set_subject - Set both subject and real_subj to subj
  * @param env  Envelope
  * @param subj Subject
+ *
+ * Most subjects are short, so they're stored inline in the Envelope rather
+ * than in a separate allocation - sorting and formatting the index then reads
+ * contiguous memory instead of chasing a pointer per message.
  */
 void mutt_env_set_subject(struct Envelope *env, const char *subj)
 {
-  mutt_str_replace((char **) &env->subject, subj);
+  const size_t len = mutt_str_len(subj);
+
+  if (subj && (len < sizeof(env->subj_inline)))
+  {
+    // memmove(): subj may already point into subj_inline
+    memmove(env->subj_inline, subj, len + 1);
+    subj = env->subj_inline;
+  }
+  else if (subj)
+  {
+    subj = mutt_str_dup(subj);
+  }
+
+  if (env->subject != env->subj_inline)
+    FREE((char **) &env->subject);
+  *(char **) &env->subject = (char *) subj;
   *(char **) &env->real_subj = NULL;
 
   if (env->subject)
@@ -143,7 +165,9 @@ void mutt_env_free(struct Envelope **ptr)
   FREE(&env->list_post);
   FREE(&env->list_subscribe);
   FREE(&env->list_unsubscribe);
-  FREE((char **) &env->subject);
+  if (env->subject != env->subj_inline)
+    FREE((char **) &env->subject);
+  *(char **) &env->subject = NULL;
   /* real_subj is just an offset to subject and shouldn't be freed */
   FREE(&env->disp_subj);
   FREE(&env->message_id);
@@ -167,7 +191,7 @@ void mutt_env_free(struct Envelope **ptr)
   mutt_autocrypthdr_free(&env->autocrypt_gossip);
 #endif
 
-  FREE(ptr);
+  slab_free(&EnvelopeSlab, (void **) ptr);
 }
 
 /**
@@ -252,15 +276,14 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
     MOVE_STAILQ(in_reply_to);
   }
 
-  /* real_subj is subordinate to subject */
+  /* real_subj is subordinate to subject.  The subject can't be moved as a
+   * pointer: it may live in the extra Envelope's inline storage. */
   if (!base->subject)
   {
-    *(char **) &base->subject = (*extra)->subject;
-    *(char **) &base->real_subj = (*extra)->real_subj;
+    mutt_env_set_subject(base, (*extra)->subject);
     base->disp_subj = (*extra)->disp_subj;
-    *(char **) &(*extra)->subject = NULL;
-    *(char **) &(*extra)->real_subj = NULL;
     (*extra)->disp_subj = NULL;
+    mutt_env_set_subject(*extra, NULL);
   }
   /* spam and user headers should never be hashed, and the new envelope may
    * have better values. Use new versions regardless. */
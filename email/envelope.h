@@ -70,6 +70,7 @@ struct Envelope
   char *const subject;                 ///< Email's subject
   char *const real_subj;               ///< Offset of the real subject
   char *disp_subj;                     ///< Display subject (modified copy of subject)
+  char subj_inline[48];                ///< Storage for a short subject - always read Envelope.subject instead
   char *message_id;                    ///< Message ID
   char *supersedes;                    ///< Supersedes header
   char *date;                          ///< Sent date
@@ -38,6 +38,8 @@ struct HashTable *AutoSubscribeCache = NULL;
 struct ListHead Ignore = STAILQ_HEAD_INITIALIZER(Ignore);
 ///< List of regexes to match mailing lists
 struct RegexList MailLists = STAILQ_HEAD_INITIALIZER(MailLists);
+///< Incremented when any of the mailing-list regexes change
+unsigned int MailListsGeneration = 0;
 ///< List of permitted fields in a mailto: url
 struct ListHead MailToAllow = STAILQ_HEAD_INITIALIZER(MailToAllow);
 ///< List of regexes to identify non-spam emails
@@ -29,6 +29,7 @@
 extern struct HashTable  *AutoSubscribeCache;
 extern struct ListHead    Ignore;
 extern struct RegexList   MailLists;
+extern unsigned int       MailListsGeneration;
 extern struct ListHead    MailToAllow;
 extern struct RegexList   NoSpamList;
 extern struct ReplaceList SpamList;
@@ -37,6 +37,9 @@
 #include <errno.h>
 #include <string.h>
 #include <time.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "config/lib.h"
@@ -66,6 +69,109 @@ static struct Body *rfc822_parse_message(FILE *fp, struct Body *parent, int *cou
 static struct Body *parse_multipart(FILE *fp, const char *boundary,
                                     LOFF_T end_off, bool digest, int *counter);
 
+/// Maximum number of raw header values remembered in the address cache
+#define ADDRCACHE_MAX_ENTRIES 4096
+
+/// Cache of parsed address headers: raw header value -> AddressList
+static struct HashTable *AddrCache = NULL;
+/// Number of entries in #AddrCache
+static size_t AddrCacheCount = 0;
+#ifdef HAVE_PTHREAD_CREATE
+/// Lock for #AddrCache - parser worker threads share it with the main thread
+static pthread_mutex_t AddrCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * addrcache_lock - Take exclusive ownership of the address cache
+ */
+static inline void addrcache_lock(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_lock(&AddrCacheMutex);
+#endif
+}
+
+/**
+ * addrcache_unlock - Release ownership of the address cache
+ */
+static inline void addrcache_unlock(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_unlock(&AddrCacheMutex);
+#endif
+}
+
+/**
+ * addrcache_elem_free - Free a cached AddressList - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void addrcache_elem_free(int type, void *obj, intptr_t data)
+{
+  struct AddressList *al = obj;
+  mutt_addrlist_clear(al);
+  FREE(&al);
+}
+
+/**
+ * parse_addrlist_cached - Parse a list of email addresses, memoized
+ * @param al AddressList to append addresses to
+ * @param s  String to parse
+ *
+ * In a mailing-list folder, most messages repeat the same handful of raw
+ * From/To/Cc values, so the parsed form of each value is remembered and
+ * cloned, rather than tokenized again for every message.  The caller owns
+ * the copy, so the addresses stay as mutable as ever.
+ *
+ * The copy is made while the cache is locked: maildir parser workers all pass
+ * through here, and the periodic reset below frees every cached list.
+ */
+static void parse_addrlist_cached(struct AddressList *al, const char *s)
+{
+  if (!s)
+    return;
+
+  addrcache_lock();
+
+  if (!AddrCache)
+  {
+    AddrCache = mutt_hash_new(1024, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(AddrCache, addrcache_elem_free, 0);
+  }
+
+  struct AddressList *cached = mutt_hash_find(AddrCache, s);
+  if (!cached)
+  {
+    if (AddrCacheCount >= ADDRCACHE_MAX_ENTRIES)
+    {
+      /* start over rather than track recency */
+      mutt_hash_free(&AddrCache);
+      AddrCache = mutt_hash_new(1024, MUTT_HASH_STRDUP_KEYS);
+      mutt_hash_set_destructor(AddrCache, addrcache_elem_free, 0);
+      AddrCacheCount = 0;
+    }
+
+    cached = mutt_mem_calloc(1, sizeof(*cached));
+    TAILQ_INIT(cached);
+    mutt_addrlist_parse(cached, s);
+    mutt_hash_insert(AddrCache, s, cached);
+    AddrCacheCount++;
+  }
+
+  mutt_addrlist_copy(al, cached, false);
+
+  addrcache_unlock();
+}
+
+/**
+ * mutt_addrcache_cleanup - Free the cache of parsed address headers
+ */
+void mutt_addrcache_cleanup(void)
+{
+  addrcache_lock();
+  mutt_hash_free(&AddrCache);
+  AddrCacheCount = 0;
+  addrcache_unlock();
+}
+
 /**
  * mutt_filter_commandline_header_tag - Sanitise characters in a header tag
  * @param header String to sanitise
@@ -132,6 +238,7 @@ void mutt_auto_subscribe(const char *mailto)
        * try to add here without any checks. */
       mutt_regexlist_add(&MailLists, mailbox, REG_ICASE, NULL);
       mutt_regexlist_add(&SubscribedLists, mailbox, REG_ICASE, NULL);
+      MailListsGeneration++;
     }
   }
 
@@ -689,12 +796,12 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
     case 'a':
       if ((name_len == 13) && eqi12(name + 1, "pparently-to"))
       {
-        mutt_addrlist_parse(&env->to, body);
+        parse_addrlist_cached(&env->to, body);
         matched = true;
       }
       else if ((name_len == 15) && eqi14(name + 1, "pparently-from"))
       {
-        mutt_addrlist_parse(&env->from, body);
+        parse_addrlist_cached(&env->from, body);
         matched = true;
       }
 #ifdef USE_AUTOCRYPT
@@ -722,7 +829,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
     case 'b':
       if ((name_len == 3) && eqi2(name + 1, "cc"))
       {
-        mutt_addrlist_parse(&env->bcc, body);
+        parse_addrlist_cached(&env->bcc, body);
         matched = true;
       }
       break;
@@ -730,7 +837,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
     case 'c':
       if ((name_len == 2) && eqi1(name + 1, "c"))
       {
-        mutt_addrlist_parse(&env->cc, body);
+        parse_addrlist_cached(&env->cc, body);
         matched = true;
       }
       else
@@ -817,7 +924,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
     case 'f':
       if ((name_len == 4) && eqi4(name, "from"))
       {
-        mutt_addrlist_parse(&env->from, body);
+        parse_addrlist_cached(&env->from, body);
         matched = true;
       }
       else if ((name_len == 11) && eqi10(name + 1, "ollowup-to"))
@@ -918,12 +1025,12 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
           {
             /* override the Reply-To: field */
             mutt_addrlist_clear(&env->reply_to);
-            mutt_addrlist_parse(&env->reply_to, body);
+            parse_addrlist_cached(&env->reply_to, body);
             matched = true;
           }
           else if ((name_len == 16) && eqi11(name + 5, "followup-to"))
           {
-            mutt_addrlist_parse(&env->mail_followup_to, body);
+            parse_addrlist_cached(&env->mail_followup_to, body);
             matched = true;
           }
         }
@@ -958,12 +1065,12 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
       }
       else if ((name_len == 8) && eqi8(name, "reply-to"))
       {
-        mutt_addrlist_parse(&env->reply_to, body);
+        parse_addrlist_cached(&env->reply_to, body);
         matched = true;
       }
       else if ((name_len == 11) && eqi10(name + 1, "eturn-path"))
       {
-        mutt_addrlist_parse(&env->return_path, body);
+        parse_addrlist_cached(&env->return_path, body);
         matched = true;
       }
       else if ((name_len == 8) && eqi8(name, "received"))
@@ -990,7 +1097,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
       }
       else if ((name_len == 6) && eqi5(name + 1, "ender"))
       {
-        mutt_addrlist_parse(&env->sender, body);
+        parse_addrlist_cached(&env->sender, body);
         matched = true;
       }
       else if ((name_len == 6) && eqi5(name + 1, "tatus"))
@@ -1029,7 +1136,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
     case 't':
       if ((name_len == 2) && eqi1(name + 1, "o"))
       {
-        mutt_addrlist_parse(&env->to, body);
+        parse_addrlist_cached(&env->to, body);
         matched = true;
       }
       break;
@@ -1080,7 +1187,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
       }
       else if ((name_len == 13) && eqi12(name + 1, "-original-to"))
       {
-        mutt_addrlist_parse(&env->x_original_to, body);
+        parse_addrlist_cached(&env->x_original_to, body);
         matched = true;
       }
       break;
@@ -1128,7 +1235,10 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
     return 0;
 
   size_t read = 0;
-  char line[1024] = { 0 }; /* RFC2822 specifies a maximum line length of 998 */
+  /* RFC2822 specifies a maximum line length of 998.
+   * fgets() terminates the buffer, so clearing it up-front would only add a
+   * 1KiB memset to every header line read. */
+  char line[1024];
 
   buf_reset(buf);
   while (true)
@@ -1152,6 +1262,7 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
 
     read += linelen;
 
+    size_t len = linelen;
     size_t off = linelen - 1;
     if (line[off] == '\n')
     {
@@ -1160,6 +1271,7 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
       {
         line[off] = '\0';
       } while (off && mutt_str_is_email_wsp(line[--off]));
+      len = (line[off] == '\0') ? off : (off + 1);
 
       /* check to see if the next line is a continuation line */
       int ch = fgetc(fp);
@@ -1167,7 +1279,7 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
       {
         /* next line is a separate header field or EOH */
         ungetc(ch, fp);
-        buf_addstr(buf, line);
+        buf_addstr_n(buf, line, len);
         break;
       }
       read++;
@@ -1181,9 +1293,11 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
       ungetc(ch, fp);
       line[off + 1] = ' '; /* string is still terminated because we removed
                               at least one whitespace char above */
+      if (len != 0)
+        len = off + 2;
     }
 
-    buf_addstr(buf, line);
+    buf_addstr_n(buf, line, len);
   }
 
   return read;
@@ -1201,6 +1315,13 @@ size_t mutt_rfc822_read_line(FILE *fp, struct Buffer *buf)
  * @retval ptr Newly allocated envelope structure
  *
  * Caller should free the Envelope using mutt_env_free().
+ *
+ * @note Mailbox backends pass user_hdrs=false, so custom headers that
+ *       nothing consumes are dropped as they're parsed - only the fields the
+ *       Envelope names (X-Label included, for ~y and %y) are retained.
+ *       Pass user_hdrs=true only where the full header list genuinely has a
+ *       consumer, e.g. recalling a postponed message for editing; the whole
+ *       list is kept for every message read that way.
  */
 struct Envelope *mutt_rfc822_read_header(FILE *fp, struct Email *e, bool user_hdrs, bool weed)
 {
@@ -1272,8 +1393,10 @@ struct Envelope *mutt_rfc822_read_header(FILE *fp, struct Email *e, bool user_hd
     }
     size_t name_len = p - lines;
 
-    char buf[1024] = { 0 };
-    if (mutt_replacelist_match(&SpamList, buf, sizeof(buf), lines))
+    /* spam matching needs a scratch buffer for the whole line; don't pay for
+     * it on every header when no spam patterns are defined */
+    char buf[1024];
+    if (!STAILQ_EMPTY(&SpamList) && mutt_replacelist_match(&SpamList, buf, sizeof(buf), lines))
     {
       if (!mutt_regexlist_match(&NoSpamList, lines))
       {
@@ -34,6 +34,7 @@ struct Buffer;
 struct Email;
 struct Envelope;
 
+void             mutt_addrcache_cleanup   (void);
 void             mutt_auto_subscribe      (const char *mailto);
 int              mutt_check_encoding      (const char *c);
 enum ContentType mutt_check_mime_type     (const char *s);
@@ -663,6 +663,12 @@ void rfc2047_decode(char **pd)
   if (!pd || !*pd)
     return;
 
+  /* Most headers contain no encoded words at all.  Unless $assumed_charset
+   * asks for unencoded text to be converted too, decoding such a string is an
+   * expensive no-op - skip the Buffer round-trip entirely. */
+  if (!strstr(*pd, "=?") && slist_is_empty(cc_assumed_charset()))
+    return;
+
   struct Buffer *buf = buf_pool_get();  // Output buffer
   char *s = *pd;                        // Read pointer
   char *beg = NULL;                     // Begin of encoded word
@@ -843,8 +849,8 @@ void rfc2047_decode_envelope(struct Envelope *env)
   rfc2047_decode_addrlist(&env->sender);
   rfc2047_decode(&env->x_label);
 
-  char *subj = env->subject;
-  *(char **) &env->subject = NULL;
+  // Copy the subject: it may live in the Envelope's inline storage
+  char *subj = mutt_str_dup(env->subject);
   rfc2047_decode(&subj);
   mutt_env_set_subject(env, subj);
   FREE(&subj);
@@ -868,8 +874,8 @@ void rfc2047_encode_envelope(struct Envelope *env)
   const struct Slist *const c_send_charset = cs_subset_slist(NeoMutt->sub, "send_charset");
   rfc2047_encode(&env->x_label, NULL, sizeof("X-Label:"), c_send_charset);
 
-  char *subj = env->subject;
-  *(char **) &env->subject = NULL;
+  // Copy the subject: it may live in the Envelope's inline storage
+  char *subj = mutt_str_dup(env->subject);
   rfc2047_encode(&subj, NULL, sizeof("Subject:"), c_send_charset);
   mutt_env_set_subject(env, subj);
   FREE(&subj);
@@ -32,6 +32,7 @@ struct Email;
  */
 struct MuttThread
 {
+  bool         check_pseudo         : 1;  ///< Should the Thread be rematched by subject?
   bool         check_subject        : 1;  ///< Should the Subject be checked?
   bool         deep                 : 1;  ///< Is the Thread deeply nested?
   bool         duplicate_thread     : 1;  ///< Duplicated Email in Thread
@@ -41,6 +42,11 @@ struct MuttThread
   unsigned int subtree_visible      : 2;  ///< Is this Thread subtree visible?
   bool         visible              : 1;  ///< Is this Thread visible?
 
+  bool         agg_valid            : 1;  ///< Are the cached aggregates current? (thread roots only)
+  bool         agg_flagged          : 1;  ///< Cached: does the thread contain flagged mail?
+  unsigned int agg_unread           : 2;  ///< Cached: 1, new unread mail; 2, only old unread mail; 0, none
+  int          agg_min_unread;            ///< Cached: vnum of the first unread email
+
   struct MuttThread *parent;        ///< Parent of this Thread
   struct MuttThread *child;         ///< Child of this Thread
   struct MuttThread *next;          ///< Next sibling Thread
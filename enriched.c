@@ -164,23 +164,9 @@ static void enriched_wrap(struct EnrichedState *enriched)
     if (extra > 0)
     {
       if (enriched->tag_level[RICH_CENTER])
-      {
-        x = extra / 2;
-        while (x)
-        {
-          state_putc(enriched->state, ' ');
-          x--;
-        }
-      }
+        state_pad(enriched->state, ' ', extra / 2);
       else if (enriched->tag_level[RICH_FLUSHRIGHT])
-      {
-        x = extra - 1;
-        while (x)
-        {
-          state_putc(enriched->state, ' ');
-          x--;
-        }
-      }
+        state_pad(enriched->state, ' ', extra - 1);
     }
     state_putws(enriched->state, (const wchar_t *) enriched->line);
   }
@@ -222,11 +208,7 @@ static void enriched_wrap(struct EnrichedState *enriched)
   {
     x = enriched->tag_level[RICH_INDENT] * INDENT_SIZE;
     enriched->indent_len += x;
-    while (x)
-    {
-      state_putc(enriched->state, ' ');
-      x--;
-    }
+    state_pad(enriched->state, ' ', x);
   }
 }
 
@@ -264,7 +246,6 @@ static void enriched_flush(struct EnrichedState *enriched, bool wrap)
   }
   if (wrap)
     enriched_wrap(enriched);
-  fflush(enriched->state->fp_out);
 }
 
 /**
@@ -459,6 +440,41 @@ static void enriched_set_flags(const wchar_t *tag, struct EnrichedState *enriche
   }
 }
 
+/**
+ * enriched_getwc - Read one wide character from a stream
+ * @param fp       File to read from
+ * @param pushback Character from an earlier call, to deliver again, or WEOF
+ * @retval num Wide character
+ * @retval WEOF End of file
+ *
+ * The bytes are read with fgetc() and converted here, rather than with
+ * fgetwc() - a wide read puts the stream into wide orientation, which not
+ * every libc supports on the in-memory streams used with USE_FMEMOPEN.
+ */
+static wint_t enriched_getwc(FILE *fp, wint_t *pushback)
+{
+  if (*pushback != WEOF)
+  {
+    const wint_t wc = *pushback;
+    *pushback = WEOF;
+    return wc;
+  }
+
+  mbstate_t mbstate = { 0 };
+  for (int ch = fgetc(fp); ch != EOF; ch = fgetc(fp))
+  {
+    const char c = ch;
+    wchar_t wc = 0;
+    const size_t rc = mbrtowc(&wc, &c, 1, &mbstate);
+    if (rc == ICONV_BUF_TOO_SMALL)
+      continue; // part of a multi-byte character, keep reading
+    if (rc == ICONV_ILLEGAL_SEQ)
+      return ReplacementChar;
+    return wc;
+  }
+  return WEOF;
+}
+
 /**
  * text_enriched_handler - Handler for enriched text - Implements ::handler_t - @ingroup handler_api
  * @retval 0 Always
@@ -479,6 +495,7 @@ int text_enriched_handler(struct Body *b_email, struct State *state)
   long bytes = b_email->length;
   struct EnrichedState enriched = { 0 };
   wint_t wc = 0;
+  wint_t pushback = WEOF;
   int tag_len = 0;
   wchar_t tag[1024 + 1];
 
@@ -504,7 +521,7 @@ int text_enriched_handler(struct Body *b_email, struct State *state)
   {
     if (text_state != ST_EOF)
     {
-      if (!bytes || ((wc = fgetwc(state->fp_in)) == WEOF))
+      if (!bytes || ((wc = enriched_getwc(state->fp_in, &pushback)) == WEOF))
         text_state = ST_EOF;
       else
         bytes--;
@@ -580,7 +597,7 @@ int text_enriched_handler(struct Body *b_email, struct State *state)
         }
         else
         {
-          ungetwc(wc, state->fp_in);
+          pushback = wc;
           bytes++;
           text_state = TEXT;
         }
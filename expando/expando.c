@@ -134,3 +134,21 @@ bool expando_equal(const struct Expando *a, const struct Expando *b)
 
   return mutt_str_equal(a->string, b->string);
 }
+
+/**
+ * expando_uses - Does an Expando use a particular variable?
+ * @param exp Expando to search
+ * @param did Domain ID to look for, e.g. #ED_MENU
+ * @param uid Unique ID to look for, e.g. #ED_MEN_PERCENTAGE
+ * @retval true The variable appears in the Expando
+ *
+ * Lets a caller skip re-rendering a format string when an event can't
+ * affect its output.
+ */
+bool expando_uses(const struct Expando *exp, int did, int uid)
+{
+  if (!exp)
+    return false;
+
+  return node_uses(exp->node, did, uid);
+}
@@ -47,6 +47,7 @@ void            expando_free(struct Expando **ptr);
 struct Expando *expando_new (const char *format);
 
 bool expando_equal(const struct Expando *a, const struct Expando *b);
+bool expando_uses (const struct Expando *exp, int did, int uid);
 
 struct Expando *expando_parse(const char *str, const struct ExpandoDefinition *defs, struct Buffer *err);
 
@@ -40,22 +40,28 @@
 #endif
 
 /**
- * buf_justify - Justify a string
+ * buf_justify_at - Justify the tail of a string
  * @param buf      String to justify
+ * @param start    Offset where the region to justify begins
  * @param justify  Justification, e.g. #JUSTIFY_RIGHT
- * @param max_cols Number of columns to pad to
+ * @param max_cols Number of columns to pad the region to
  * @param pad_char Character to fill with
+ *
+ * Bytes before start are left untouched, so freshly-appended text can be
+ * justified in place in a partially-filled buffer.
  */
-void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols, char pad_char)
+void buf_justify_at(struct Buffer *buf, size_t start, enum FormatJustify justify,
+                    size_t max_cols, char pad_char)
 {
-  if (!buf || (pad_char == '\0'))
+  if (!buf || (pad_char == '\0') || (start > buf_len(buf)))
     return;
 
-  size_t len = buf_len(buf);
+  size_t len = buf_len(buf) - start;
   if (len >= max_cols)
     return;
 
-  buf_alloc(buf, len + max_cols);
+  buf_alloc(buf, buf_len(buf) + max_cols);
+  char *base = buf->data + start;
 
   max_cols -= len;
 
@@ -63,7 +69,7 @@ void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols
   {
     case JUSTIFY_LEFT:
     {
-      memset(buf->dptr, pad_char, max_cols);
+      memset(base + len, pad_char, max_cols);
       break;
     }
 
@@ -71,17 +77,17 @@ void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols
     {
       if (max_cols > 1)
       {
-        memmove(buf->data + (max_cols / 2), buf->data, len);
-        memset(buf->data, pad_char, max_cols / 2);
+        memmove(base + (max_cols / 2), base, len);
+        memset(base, pad_char, max_cols / 2);
       }
-      memset(buf->data + len + (max_cols / 2), pad_char, (max_cols + 1) / 2);
+      memset(base + len + (max_cols / 2), pad_char, (max_cols + 1) / 2);
       break;
     }
 
     case JUSTIFY_RIGHT:
     {
-      memmove(buf->data + max_cols, buf->data, len);
-      memset(buf->data, pad_char, max_cols);
+      memmove(base + max_cols, base, len);
+      memset(base, pad_char, max_cols);
       break;
     }
   }
@@ -90,6 +96,18 @@ void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols
   buf->dptr[0] = '\0';
 }
 
+/**
+ * buf_justify - Justify a string
+ * @param buf      String to justify
+ * @param justify  Justification, e.g. #JUSTIFY_RIGHT
+ * @param max_cols Number of columns to pad to
+ * @param pad_char Character to fill with
+ */
+void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols, char pad_char)
+{
+  buf_justify_at(buf, 0, justify, max_cols, pad_char);
+}
+
 /**
  * format_string - Format a string, like snprintf()
  * @param[out] buf       Buffer in which to save string
@@ -104,6 +122,9 @@ void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t max_cols
  *
  * This formats a string, a bit like sprintf(buf, "%-*.*s", min_cols, max_cols, str),
  * except that the max_cols refer to the number of character cells when printed.
+ *
+ * The result is appended to buf and justified in place; any existing contents
+ * are left untouched, so nodes can render directly into a shared buffer.
  */
 int format_string(struct Buffer *buf, int min_cols, int max_cols, enum FormatJustify justify,
                   char pad_char, const char *str, size_t n, bool arboreal)
@@ -116,6 +137,7 @@ int format_string(struct Buffer *buf, int min_cols, int max_cols, enum FormatJus
   mbstate_t mbstate2 = { 0 };
   bool escaped = false;
   int used_cols = 0;
+  const size_t start = buf_len(buf);
 
   for (; (n > 0) && (k = mbrtowc(&wc, str, n, &mbstate1)); str += k, n -= k)
   {
@@ -184,7 +206,7 @@ int format_string(struct Buffer *buf, int min_cols, int max_cols, enum FormatJus
   }
 
   if (w > 0)
-    buf_justify(buf, justify, buf_len(buf) + w, pad_char);
+    buf_justify_at(buf, start, justify, (buf_len(buf) - start) + w, pad_char);
 
   return used_cols;
 }
@@ -34,6 +34,7 @@
 #include "mutt/lib.h"
 #include "helpers.h"
 #include "definition.h"
+#include "node.h"
 #include "mutt_thread.h"
 #include "render.h"
 
@@ -85,6 +86,53 @@ const struct ExpandoRenderData *find_get_string(const struct ExpandoRenderData *
   return NULL;
 }
 
+/**
+ * node_resolve_rdata - Memoize a Node's render callbacks
+ * @param node  Node to resolve
+ * @param rdata Render data to search
+ *
+ * The matching entries only depend on rdata, which is a static array at every
+ * call site, so compare by address and re-resolve only if it has changed.
+ */
+static void node_resolve_rdata(const struct ExpandoNode *node,
+                               const struct ExpandoRenderData *rdata)
+{
+  struct ExpandoRenderCache *rc = node->rcache;
+
+  if (rc->rdata == rdata)
+    return;
+
+  rc->get_string = find_get_string(rdata, node->did, node->uid);
+  rc->get_number = find_get_number(rdata, node->did, node->uid);
+  rc->rdata = rdata;
+}
+
+/**
+ * node_find_get_number - Find a Node's get_number() callback, with memoization
+ * @param node  Node to resolve
+ * @param rdata Render data to search
+ * @retval ptr Matching Render data
+ */
+const struct ExpandoRenderData *node_find_get_number(const struct ExpandoNode *node,
+                                                     const struct ExpandoRenderData *rdata)
+{
+  node_resolve_rdata(node, rdata);
+  return node->rcache->get_number;
+}
+
+/**
+ * node_find_get_string - Find a Node's get_string() callback, with memoization
+ * @param node  Node to resolve
+ * @param rdata Render data to search
+ * @retval ptr Matching Render data
+ */
+const struct ExpandoRenderData *node_find_get_string(const struct ExpandoNode *node,
+                                                     const struct ExpandoRenderData *rdata)
+{
+  node_resolve_rdata(node, rdata);
+  return node->rcache->get_string;
+}
+
 /**
  * skip_until_ch - Search a string for a terminator character
  * @param start      Start of string
@@ -168,17 +216,18 @@ const char *skip_classic_expando(const char *str, const struct ExpandoDefinition
 }
 
 /**
- * buf_lower_special - Convert to lowercase, excluding special characters
- * @param buf String to lowercase
+ * buf_lower_special_at - Convert the tail of a string to lowercase, excluding special characters
+ * @param buf    String to lowercase
+ * @param offset Offset of the first byte to transform
  *
- * The string is transformed in place.
+ * The string is transformed in place, starting at offset.
  */
-void buf_lower_special(struct Buffer *buf)
+void buf_lower_special_at(struct Buffer *buf, size_t offset)
 {
-  if (!buf || !buf->data)
+  if (!buf || !buf->data || (offset > buf_len(buf)))
     return;
 
-  char *p = buf->data;
+  char *p = buf->data + offset;
 
   while (*p)
   {
@@ -197,3 +246,14 @@ void buf_lower_special(struct Buffer *buf)
     p++;
   }
 }
+
+/**
+ * buf_lower_special - Convert to lowercase, excluding special characters
+ * @param buf String to lowercase
+ *
+ * The string is transformed in place.
+ */
+void buf_lower_special(struct Buffer *buf)
+{
+  buf_lower_special_at(buf, 0);
+}
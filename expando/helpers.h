@@ -24,8 +24,11 @@
 #ifndef MUTT_EXPANDO_HELPERS_H
 #define MUTT_EXPANDO_HELPERS_H
 
+#include <stddef.h>
+
 struct Buffer;
 struct ExpandoDefinition;
+struct ExpandoNode;
 struct ExpandoRenderData;
 
 const char *skip_classic_expando      (const char *str, const struct ExpandoDefinition *defs);
@@ -35,6 +38,10 @@ const char *skip_until_classic_expando(const char *start);
 const struct ExpandoRenderData *find_get_number(const struct ExpandoRenderData *rdata, int did, int uid);
 const struct ExpandoRenderData *find_get_string(const struct ExpandoRenderData *rdata, int did, int uid);
 
-void buf_lower_special(struct Buffer *buf);
+const struct ExpandoRenderData *node_find_get_number(const struct ExpandoNode *node, const struct ExpandoRenderData *rdata);
+const struct ExpandoRenderData *node_find_get_string(const struct ExpandoNode *node, const struct ExpandoRenderData *rdata);
+
+void buf_lower_special   (struct Buffer *buf);
+void buf_lower_special_at(struct Buffer *buf, size_t offset);
 
 #endif /* MUTT_EXPANDO_HELPERS_H */
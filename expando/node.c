@@ -38,7 +38,9 @@
  */
 struct ExpandoNode *node_new(void)
 {
-  return mutt_mem_calloc(1, sizeof(struct ExpandoNode));
+  struct ExpandoNode *node = mutt_mem_calloc(1, sizeof(struct ExpandoNode));
+  node->rcache = mutt_mem_calloc(1, sizeof(struct ExpandoRenderCache));
+  return node;
 }
 
 /**
@@ -63,6 +65,7 @@ void node_free(struct ExpandoNode **ptr)
   }
 
   FREE(&node->format);
+  FREE(&node->rcache);
 
   ARRAY_FREE(&node->children);
 
@@ -130,6 +133,31 @@ void node_append(struct ExpandoNode **root, struct ExpandoNode *new_node)
   node->next = new_node;
 }
 
+/**
+ * node_uses - Does a tree of Nodes reference an Expando?
+ * @param node Root Node
+ * @param did  Domain ID to look for, e.g. #ED_MENU
+ * @param uid  Unique ID to look for, e.g. #ED_MEN_PERCENTAGE
+ * @retval true A Node with matching IDs was found
+ */
+bool node_uses(const struct ExpandoNode *node, int did, int uid)
+{
+  for (; node; node = node->next)
+  {
+    if ((node->did == did) && (node->uid == uid))
+      return true;
+
+    struct ExpandoNode **enp = NULL;
+    ARRAY_FOREACH(enp, &node->children)
+    {
+      if (node_uses(*enp, did, uid))
+        return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * node_last - Find the last Node in a tree
  * @param node Root Node
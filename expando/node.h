@@ -60,6 +60,20 @@ struct ExpandoFormat
   const char        *end;             ///< End of Expando specifier string
 };
 
+/**
+ * struct ExpandoRenderCache - Render callbacks resolved for a Node
+ *
+ * Resolving a Node's Domain+UID against an ExpandoRenderData array is a
+ * linear search, and it used to happen on every render.  The result only
+ * depends on the array, so it's resolved once and memoized here.
+ */
+struct ExpandoRenderCache
+{
+  const struct ExpandoRenderData *rdata;      ///< Array the callbacks were resolved from
+  const struct ExpandoRenderData *get_string; ///< Matching entry with a get_string()
+  const struct ExpandoRenderData *get_number; ///< Matching entry with a get_number()
+};
+
 /**
  * struct ExpandoNode - Basic Expando Node
  *
@@ -82,6 +96,8 @@ struct ExpandoNode
   void *ndata;                           ///< Private node data
   void (*ndata_free)(void **ptr);        ///< Function to free the private node data
 
+  struct ExpandoRenderCache *rcache;     ///< Memoized render callbacks for this Node
+
   /**
    * @defgroup expando_render Expando Render API
    *
@@ -105,5 +121,6 @@ void                node_append   (struct ExpandoNode **root, struct ExpandoNode
 struct ExpandoNode *node_get_child(const struct ExpandoNode *node, int index);
 
 struct ExpandoNode *node_last (struct ExpandoNode *node);
+bool                node_uses (const struct ExpandoNode *node, int did, int uid);
 
 #endif /* MUTT_EXPANDO_NODE_H */
@@ -77,7 +77,7 @@ int node_conddate_render(const struct ExpandoNode *node,
 {
   ASSERT(node->type == ENT_CONDDATE);
 
-  const struct ExpandoRenderData *rd_match = find_get_number(rdata, node->did, node->uid);
+  const struct ExpandoRenderData *rd_match = node_find_get_number(node, rdata);
   ASSERT(rd_match && "Unknown UID");
 
   const long t_test = rd_match->get_number(node, data, flags);
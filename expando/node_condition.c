@@ -45,10 +45,15 @@ static int node_condition_render(const struct ExpandoNode *node,
 
   const struct ExpandoNode *node_cond = node_get_child(node, ENC_CONDITION);
 
-  // Discard any text returned, just use the return value as a bool
-  struct Buffer *buf_cond = buf_pool_get();
-  int rc = node_cond->render(node_cond, rdata, buf_cond, max_cols, data, flags);
-  buf_pool_release(&buf_cond);
+  // Render into the caller's buffer, then rewind: only the return value
+  // matters, as a bool
+  const size_t start = buf_len(buf);
+  int rc = node_cond->render(node_cond, rdata, buf, max_cols, data, flags);
+  if (buf->data)
+  {
+    buf->dptr = buf->data + start;
+    *buf->dptr = '\0';
+  }
 
   if (rc == true)
   {
@@ -52,30 +52,27 @@ int node_container_render(const struct ExpandoNode *node,
 
   int total_cols = 0;
 
-  struct Buffer *tmp = buf_pool_get();
+  // With no format to apply, the children can render straight into the
+  // caller's buffer; otherwise they need a scratch buffer to reformat from
+  struct Buffer *tmp = fmt ? buf_pool_get() : NULL;
+  struct Buffer *dest = fmt ? tmp : buf;
   struct ExpandoNode **enp = NULL;
   ARRAY_FOREACH(enp, &node->children)
   {
-    total_cols += node_render(*enp, rdata, tmp, max_cols - total_cols, data, flags);
+    total_cols += node_render(*enp, rdata, dest, max_cols - total_cols, data, flags);
   }
 
   if (fmt)
   {
     int min_cols = MIN(fmt->min_cols, max_cols);
-    struct Buffer *tmp2 = buf_pool_get();
-    total_cols = format_string(tmp2, min_cols, max_cols, fmt->justification,
+    const size_t start = buf_len(buf);
+    total_cols = format_string(buf, min_cols, max_cols, fmt->justification,
                                fmt->leader, buf_string(tmp), buf_len(tmp), true);
     if (fmt->lower)
-      buf_lower_special(tmp2);
-    buf_addstr(buf, buf_string(tmp2));
-    buf_pool_release(&tmp2);
-  }
-  else
-  {
-    buf_addstr(buf, buf_string(tmp));
+      buf_lower_special_at(buf, start);
+    buf_pool_release(&tmp);
   }
 
-  buf_pool_release(&tmp);
   return total_cols;
 }
 
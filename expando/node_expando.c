@@ -349,14 +349,14 @@ int node_expando_render(const struct ExpandoNode *node,
 
   struct Buffer *buf_expando = buf_pool_get();
 
-  const struct ExpandoRenderData *rd_match = find_get_string(rdata, node->did, node->uid);
+  const struct ExpandoRenderData *rd_match = node_find_get_string(node, rdata);
   if (rd_match)
   {
     rd_match->get_string(node, data, flags, max_cols, buf_expando);
   }
   else
   {
-    rd_match = find_get_number(rdata, node->did, node->uid);
+    rd_match = node_find_get_number(node, rdata);
     ASSERT(rd_match && "Unknown UID");
 
     const long num = rd_match->get_number(node, data, flags);
@@ -370,25 +370,24 @@ int node_expando_render(const struct ExpandoNode *node,
   if (priv->color > -1)
     add_color(buf, priv->color);
 
-  struct Buffer *tmp = buf_pool_get();
+  // format_string() appends, so render straight into the caller's buffer
+  const size_t start = buf_len(buf);
   const struct ExpandoFormat *fmt = node->format;
   if (fmt)
   {
     max_cols = MIN(max_cols, fmt->max_cols);
     int min_cols = MIN(max_cols, fmt->min_cols);
-    total_cols += format_string(tmp, min_cols, max_cols, fmt->justification,
+    total_cols += format_string(buf, min_cols, max_cols, fmt->justification,
                                 fmt->leader, buf_string(buf_expando),
                                 buf_len(buf_expando), priv->has_tree);
     if (fmt->lower)
-      buf_lower_special(tmp);
+      buf_lower_special_at(buf, start);
   }
   else
   {
-    total_cols += format_string(tmp, 0, max_cols, JUSTIFY_LEFT, 0, buf_string(buf_expando),
+    total_cols += format_string(buf, 0, max_cols, JUSTIFY_LEFT, 0, buf_string(buf_expando),
                                 buf_len(buf_expando), priv->has_tree);
   }
-  buf_addstr(buf, buf_string(tmp));
-  buf_pool_release(&tmp);
 
   if (priv->color > -1)
     add_color(buf, MT_COLOR_INDEX);
@@ -125,29 +125,25 @@ int node_padding_render_hard(const struct ExpandoNode *node,
                              const struct ExpandoRenderData *rdata, struct Buffer *buf,
                              int max_cols, void *data, MuttFormatFlags flags)
 {
-  struct Buffer *buf_left = buf_pool_get();
-  struct Buffer *buf_pad = buf_pool_get();
+  // The right side must be measured before the padding can be sized, but is
+  // emitted after it, so it's the only part that needs a scratch buffer
   struct Buffer *buf_right = buf_pool_get();
 
   int cols_used = 0;
 
   struct ExpandoNode *left = node_get_child(node, ENP_LEFT);
   if (left)
-    cols_used += node_render(left, rdata, buf_left, max_cols - cols_used, data, flags);
+    cols_used += node_render(left, rdata, buf, max_cols - cols_used, data, flags);
 
   struct ExpandoNode *right = node_get_child(node, ENP_RIGHT);
   if (right)
     cols_used += node_render(right, rdata, buf_right, max_cols - cols_used, data, flags);
 
   if (max_cols > cols_used)
-    cols_used += pad_string(node, buf_pad, max_cols - cols_used);
+    cols_used += pad_string(node, buf, max_cols - cols_used);
 
-  buf_addstr(buf, buf_string(buf_left));
-  buf_addstr(buf, buf_string(buf_pad));
-  buf_addstr(buf, buf_string(buf_right));
+  buf_addbuf(buf, buf_right);
 
-  buf_pool_release(&buf_left);
-  buf_pool_release(&buf_pad);
   buf_pool_release(&buf_right);
 
   return cols_used;
@@ -163,8 +159,8 @@ int node_padding_render_soft(const struct ExpandoNode *node,
                              const struct ExpandoRenderData *rdata, struct Buffer *buf,
                              int max_cols, void *data, MuttFormatFlags flags)
 {
-  struct Buffer *buf_left = buf_pool_get();
-  struct Buffer *buf_pad = buf_pool_get();
+  // The right side renders first, taking priority over the left, but is
+  // emitted last, so it's the only part that needs a scratch buffer
   struct Buffer *buf_right = buf_pool_get();
 
   int cols_used = 0;
@@ -175,17 +171,13 @@ int node_padding_render_soft(const struct ExpandoNode *node,
 
   struct ExpandoNode *left = node_get_child(node, ENP_LEFT);
   if (left)
-    cols_used += node_render(left, rdata, buf_left, max_cols - cols_used, data, flags);
+    cols_used += node_render(left, rdata, buf, max_cols - cols_used, data, flags);
 
   if (max_cols > cols_used)
-    cols_used += pad_string(node, buf_pad, max_cols - cols_used);
+    cols_used += pad_string(node, buf, max_cols - cols_used);
 
-  buf_addstr(buf, buf_string(buf_left));
-  buf_addstr(buf, buf_string(buf_pad));
-  buf_addstr(buf, buf_string(buf_right));
+  buf_addbuf(buf, buf_right);
 
-  buf_pool_release(&buf_left);
-  buf_pool_release(&buf_pad);
   buf_pool_release(&buf_right);
 
   return cols_used;
@@ -152,6 +152,12 @@ void index_bounce_message(struct Mailbox *m, struct EmailArray *ea)
 
   msgwin_clear_text(NULL);
 
+  /* share one SMTP connection across the batch */
+  struct SmtpSession *smtp = NULL;
+  const char *const c_smtp_url = cs_subset_string(NeoMutt->sub, "smtp_url");
+  if (c_smtp_url && (msg_count > 1))
+    smtp = mutt_smtp_session_open(NeoMutt->sub);
+
   struct Message *msg = NULL;
   ARRAY_FOREACH(ep, ea)
   {
@@ -163,13 +169,15 @@ void index_bounce_message(struct Mailbox *m, struct EmailArray *ea)
       break;
     }
 
-    rc = mutt_bounce_message(msg->fp, m, e, &al, NeoMutt->sub);
+    rc = mutt_bounce_message(msg->fp, m, e, &al, smtp, NeoMutt->sub);
     mx_msg_close(m, &msg);
 
     if (rc < 0)
       break;
   }
 
+  mutt_smtp_session_close(&smtp);
+
   /* If no error, or background, display message. */
   if ((rc == 0) || (rc == S_BKG))
     mutt_message(ngettext("Message bounced", "Messages bounced", msg_count));
@@ -936,7 +944,36 @@ int mutt_save_message(struct Mailbox *m, struct EmailArray *ea,
   if (m_comp && (m_comp->msg_count == 0))
     m_comp = NULL;
 
-  if (msg_count == 1)
+  /* Try the backend's bulk copy before falling back to per-message appends */
+  int batch_rc = 1;
+  if (transform_opt == TRANSFORM_NONE)
+    batch_rc = mx_msg_copy_batch(m, ea, m_save);
+
+  if (batch_rc == -1)
+  {
+    rc = -1;
+    mx_mbox_close(m_save);
+    m_save->append = old_append;
+    goto errcleanup;
+  }
+
+  if (batch_rc == 0)
+  {
+    rc = 0;
+    if (save_opt == SAVE_MOVE)
+    {
+      const bool c_delete_untag = cs_subset_bool(NeoMutt->sub, "delete_untag");
+      struct Email **ep = NULL;
+      ARRAY_FOREACH(ep, ea)
+      {
+        mutt_set_flag(m, *ep, MUTT_DELETE, true, true);
+        mutt_set_flag(m, *ep, MUTT_PURGE, true, true);
+        if (c_delete_untag)
+          mutt_set_flag(m, *ep, MUTT_TAG, false, true);
+      }
+    }
+  }
+  else if (msg_count == 1)
   {
     rc = mutt_save_message_mbox(m, e_cur, save_opt, transform_opt, m_save);
     if (rc != 0)
@@ -0,0 +1,231 @@
+/**
+ * @file
+ * Write-ahead journal of message flag changes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_flagjournal Write-ahead journal of message flag changes
+ *
+ * Flag changes normally live only in memory until the mailbox is synced, so a
+ * crash loses the user's triage work since the last sync.  If
+ * `$flag_journal_dir` is set, every persistent flag change is also appended to
+ * a tiny per-mailbox journal as it happens.  Reopening the mailbox replays any
+ * journal left behind by a crash, and a successful sync deletes it.
+ *
+ * Records are one line each: the flag letter, the new value and the
+ * Message-ID, e.g. `D 1 <20260828.12345@example.com>`.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "flagjournal.h"
+#include "mutt_thread.h"
+#include "protos.h"
+
+/// Journal records are being replayed - don't journal them again
+static bool JournalReplaying = false;
+
+/**
+ * journal_path - Find the journal file for a Mailbox
+ * @param m    Mailbox
+ * @param path Buffer for the result
+ * @retval true Journalling is enabled and the path was filled in
+ */
+static bool journal_path(struct Mailbox *m, struct Buffer *path)
+{
+  const char *const c_flag_journal_dir = cs_subset_path(NeoMutt->sub, "flag_journal_dir");
+  if (!c_flag_journal_dir || !m)
+    return false;
+
+  unsigned char digest[16];
+  char name[33];
+  mutt_md5(mailbox_path(m), digest);
+  mutt_md5_toascii(digest, name);
+  buf_printf(path, "%s/%s", c_flag_journal_dir, name);
+  return true;
+}
+
+/**
+ * journal_flag_char - Map a MessageType to its journal letter
+ * @param flag Flag, e.g. #MUTT_DELETE
+ * @retval ch  Journal letter
+ * @retval 0   The flag isn't persistent and isn't journalled
+ */
+static char journal_flag_char(enum MessageType flag)
+{
+  switch (flag)
+  {
+    case MUTT_DELETE:
+      return 'D';
+    case MUTT_FLAG:
+      return 'F';
+    case MUTT_NEW:
+      return 'N';
+    case MUTT_OLD:
+      return 'O';
+    case MUTT_READ:
+      return 'S';
+    case MUTT_REPLIED:
+      return 'R';
+    default:
+      return 0;
+  }
+}
+
+/**
+ * journal_char_flag - Map a journal letter back to its MessageType
+ * @param c Journal letter
+ * @retval enum #MessageType, or #MUTT_MT_MAX on an unknown letter
+ */
+static enum MessageType journal_char_flag(char c)
+{
+  switch (c)
+  {
+    case 'D':
+      return MUTT_DELETE;
+    case 'F':
+      return MUTT_FLAG;
+    case 'N':
+      return MUTT_NEW;
+    case 'O':
+      return MUTT_OLD;
+    case 'S':
+      return MUTT_READ;
+    case 'R':
+      return MUTT_REPLIED;
+    default:
+      return MUTT_MT_MAX;
+  }
+}
+
+/**
+ * flag_journal_record - Append a flag change to the Mailbox's journal
+ * @param m    Mailbox
+ * @param e    Email whose flag changed
+ * @param flag Flag, e.g. #MUTT_DELETE
+ * @param bf   New value of the flag
+ *
+ * Changes to messages without a Message-ID can't be replayed and aren't
+ * recorded.
+ */
+void flag_journal_record(struct Mailbox *m, struct Email *e, enum MessageType flag, bool bf)
+{
+  if (JournalReplaying || !m || !e || !e->env || !e->env->message_id)
+    return;
+
+  const char fc = journal_flag_char(flag);
+  if (fc == 0)
+    return;
+
+  struct Buffer *path = buf_pool_get();
+  if (journal_path(m, path))
+  {
+    const char *const c_flag_journal_dir = cs_subset_path(NeoMutt->sub, "flag_journal_dir");
+    mutt_file_mkdir(c_flag_journal_dir, S_IRWXU);
+
+    FILE *fp = mutt_file_fopen(buf_string(path), "a");
+    if (fp)
+    {
+      fprintf(fp, "%c %d %s\n", fc, bf ? 1 : 0, e->env->message_id);
+      mutt_file_fclose(&fp);
+    }
+  }
+  buf_pool_release(&path);
+}
+
+/**
+ * flag_journal_replay - Re-apply a journal left behind by a crash
+ * @param m Mailbox, freshly opened
+ *
+ * The replayed changes mark the Emails as changed, so the next sync persists
+ * them to the backend; the journal itself survives until that sync succeeds.
+ */
+void flag_journal_replay(struct Mailbox *m)
+{
+  struct Buffer *path = buf_pool_get();
+  FILE *fp = NULL;
+
+  if (journal_path(m, path))
+    fp = fopen(buf_string(path), "r");
+
+  if (fp)
+  {
+    struct HashTable *id_hash = mutt_make_id_hash(m);
+    char *line = NULL;
+    size_t size = 0;
+    int applied = 0;
+
+    while ((line = mutt_file_read_line(line, &size, fp, NULL, MUTT_RL_NO_FLAGS)))
+    {
+      if (mutt_str_len(line) < 5)
+        continue;
+
+      const enum MessageType flag = journal_char_flag(line[0]);
+      if ((flag == MUTT_MT_MAX) || (line[1] != ' ') || (line[3] != ' '))
+        continue;
+
+      struct Email *e = mutt_hash_find(id_hash, line + 4);
+      if (!e)
+        continue;
+
+      JournalReplaying = true;
+      mutt_set_flag(m, e, flag, (line[2] == '1'), true);
+      JournalReplaying = false;
+      applied++;
+    }
+
+    FREE(&line);
+    mutt_file_fclose(&fp);
+    mutt_hash_free(&id_hash);
+
+    if (applied > 0)
+    {
+      mutt_debug(LL_DEBUG1, "replayed %d flag change(s) for %s\n", applied,
+                 mailbox_path(m));
+      mutt_message(ngettext("Replayed %d unsaved flag change",
+                            "Replayed %d unsaved flag changes", applied),
+                   applied);
+    }
+  }
+
+  buf_pool_release(&path);
+}
+
+/**
+ * flag_journal_clear - Delete a Mailbox's journal
+ * @param m Mailbox
+ *
+ * Called after a successful sync - the backend now holds the flags, so the
+ * journal has nothing left to protect.
+ */
+void flag_journal_clear(struct Mailbox *m)
+{
+  struct Buffer *path = buf_pool_get();
+  if (journal_path(m, path))
+    unlink(buf_string(path));
+  buf_pool_release(&path);
+}
@@ -43,22 +43,29 @@
 #include "color/lib.h"
 #include "index/lib.h"
 #include "key/lib.h"
+#include "flagjournal.h"
 #include "mutt_thread.h"
 #include "protos.h"
 
 /**
- * mutt_set_flag - Set a flag on an email
+ * set_flag - Set a flag on an email
  * @param m        Mailbox
  * @param e        Email
  * @param flag     Flag to set, e.g. #MUTT_DELETE
  * @param bf       true: set the flag; false: clear the flag
  * @param upd_mbox true: update the Mailbox
+ * @param notify   true: notify the Mailbox's observers
+ * @retval true The Email was changed
+ *
+ * Callers changing many Emails should pass notify=false and send a single
+ * #NT_MAILBOX_CHANGE notification afterwards; notifying per message makes
+ * the index observers re-run for every Email.
  */
-void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
-                   bool bf, bool upd_mbox)
+static bool set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
+                     bool bf, bool upd_mbox, bool notify)
 {
   if (!m || !e)
-    return;
+    return false;
 
   bool changed = e->changed;
   int deleted = m->msg_deleted;
@@ -67,14 +74,14 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
   int update = false;
 
   if (m->readonly && (flag != MUTT_TAG))
-    return; /* don't modify anything if we are read-only */
+    return false; /* don't modify anything if we are read-only */
 
   switch (flag)
   {
     case MUTT_DELETE:
     {
       if (!(m->rights & MUTT_ACL_DELETE))
-        return;
+        return false;
 
       if (bf)
       {
@@ -122,7 +129,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_PURGE:
     {
       if (!(m->rights & MUTT_ACL_DELETE))
-        return;
+        return false;
 
       if (bf)
       {
@@ -138,7 +145,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_NEW:
     {
       if (!(m->rights & MUTT_ACL_SEEN))
-        return;
+        return false;
 
       if (bf)
       {
@@ -177,7 +184,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_OLD:
     {
       if (!(m->rights & MUTT_ACL_SEEN))
-        return;
+        return false;
 
       if (bf)
       {
@@ -209,7 +216,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_READ:
     {
       if (!(m->rights & MUTT_ACL_SEEN))
-        return;
+        return false;
 
       if (bf)
       {
@@ -245,7 +252,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_REPLIED:
     {
       if (!(m->rights & MUTT_ACL_WRITE))
-        return;
+        return false;
 
       if (bf)
       {
@@ -280,7 +287,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
     case MUTT_FLAG:
     {
       if (!(m->rights & MUTT_ACL_WRITE))
-        return;
+        return false;
 
       if (bf)
       {
@@ -316,7 +323,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
           update = true;
           e->tagged = true;
           if (upd_mbox)
-            m->msg_tagged++;
+            mailbox_tagged_add(m, e);
         }
       }
       else if (e->tagged)
@@ -324,7 +331,7 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
         update = true;
         e->tagged = false;
         if (upd_mbox)
-          m->msg_tagged--;
+          mailbox_tagged_remove(m, e);
       }
       break;
     }
@@ -336,9 +343,16 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
 
   if (update)
   {
-    mutt_set_header_color(m, e);
-    struct EventMailbox ev_m = { m };
-    notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+    flag_journal_record(m, e, flag, bf);
+    mutt_thread_invalidate(e);
+    /* Recoloured lazily at the next repaint - a bulk flag change would
+     * otherwise run every `color index` pattern over every message */
+    e->attr_color = NULL;
+    if (notify)
+    {
+      struct EventMailbox ev_m = { m };
+      notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+    }
   }
 
   /* if the message status has changed, we need to invalidate the cached
@@ -349,6 +363,22 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
   {
     e->searched = false;
   }
+
+  return update;
+}
+
+/**
+ * mutt_set_flag - Set a flag on an email
+ * @param m        Mailbox
+ * @param e        Email
+ * @param flag     Flag to set, e.g. #MUTT_DELETE
+ * @param bf       true: set the flag; false: clear the flag
+ * @param upd_mbox true: update the Mailbox
+ */
+void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
+                   bool bf, bool upd_mbox)
+{
+  set_flag(m, e, flag, bf, upd_mbox, true);
 }
 
 /**
@@ -357,6 +387,8 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
  * @param ea   Array of Emails to flag
  * @param flag Flag to set, e.g. #MUTT_DELETE
  * @param bf   true: set the flag; false: clear the flag
+ *
+ * The Mailbox's observers are notified just once, however many Emails change.
  */
 void mutt_emails_set_flag(struct Mailbox *m, struct EmailArray *ea,
                           enum MessageType flag, bool bf)
@@ -364,11 +396,18 @@ void mutt_emails_set_flag(struct Mailbox *m, struct EmailArray *ea,
   if (!m || !ea || ARRAY_EMPTY(ea))
     return;
 
+  bool changed = false;
   struct Email **ep = NULL;
   ARRAY_FOREACH(ep, ea)
   {
     struct Email *e = *ep;
-    mutt_set_flag(m, e, flag, bf, true);
+    changed |= set_flag(m, e, flag, bf, true, false);
+  }
+
+  if (changed)
+  {
+    struct EventMailbox ev_m = { m };
+    notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
   }
 }
 
@@ -387,6 +426,7 @@ int mutt_thread_set_flag(struct Mailbox *m, struct Email *e,
 {
   struct MuttThread *start = NULL;
   struct MuttThread *cur = e->thread;
+  bool changed = false;
 
   if (!mutt_using_threads())
   {
@@ -401,7 +441,7 @@ int mutt_thread_set_flag(struct Mailbox *m, struct Email *e,
   start = cur;
 
   if (cur->message && (cur != e->thread))
-    mutt_set_flag(m, cur->message, flag, bf, true);
+    changed |= set_flag(m, cur->message, flag, bf, true, false);
 
   cur = cur->child;
   if (!cur)
@@ -410,7 +450,7 @@ int mutt_thread_set_flag(struct Mailbox *m, struct Email *e,
   while (true)
   {
     if (cur->message && (cur != e->thread))
-      mutt_set_flag(m, cur->message, flag, bf, true);
+      changed |= set_flag(m, cur->message, flag, bf, true, false);
 
     if (cur->child)
     {
@@ -434,7 +474,13 @@ int mutt_thread_set_flag(struct Mailbox *m, struct Email *e,
 done:
   cur = e->thread;
   if (cur->message)
-    mutt_set_flag(m, cur->message, flag, bf, true);
+    changed |= set_flag(m, cur->message, flag, bf, true, false);
+
+  if (changed)
+  {
+    struct EventMailbox ev_m = { m };
+    notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+  }
   return 0;
 }
 
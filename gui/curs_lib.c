@@ -89,6 +89,41 @@ void mutt_refresh(void)
   refresh();
 }
 
+/// Quiet interval that ends a resize storm, in milliseconds
+#define RESIZE_SETTLE_MS 50
+
+/**
+ * mutt_resize_settle - Wait for a storm of resize events to pass
+ *
+ * Dragging the terminal corner delivers SIGWINCH many times a second and a
+ * full reflow-and-repaint for each one can make NeoMutt unresponsive for
+ * seconds.  Swallow the burst here and let the caller reflow just once, when
+ * the size has been stable for a short interval.
+ *
+ * @note This clears #SigWinch
+ */
+void mutt_resize_settle(void)
+{
+  timeout(RESIZE_SETTLE_MS);
+  while (true)
+  {
+    SigWinch = false;
+    const int ch = getch();
+
+    if (ch == KEY_RESIZE)
+      continue; // ncurses' own marker for the same event
+
+    if (ch != ERR)
+    {
+      mutt_unget_ch(ch); // the user is typing again - the drag is over
+      break;
+    }
+
+    if (!SigWinch)
+      break; // a whole interval with no events - the size has settled
+  }
+}
+
 /**
  * mutt_need_hard_redraw - Force a hard refresh
  *
@@ -103,8 +138,7 @@ void mutt_need_hard_redraw(void)
   // Using encryption can leave ncurses confused about which mode it's in.
   fputs("\033[?1049h", stdout);
   fflush(stdout);
-  keypad(stdscr, true);
-  clearok(stdscr, true);
+  window_invalidate_all();
   window_redraw(NULL);
 }
 
@@ -472,6 +506,17 @@ size_t mutt_strnwidth(const char *s, size_t n)
       continue;
     }
 
+    if (CharsetIsUtf8)
+    {
+      const size_t run = mutt_mb_ascii_run(s, n);
+      if (run > 0)
+      {
+        w += run; // printable ASCII is always one column wide
+        k = run;
+        continue;
+      }
+    }
+
     if ((k == ICONV_ILLEGAL_SEQ) || (k == ICONV_BUF_TOO_SMALL))
     {
       if (k == ICONV_ILLEGAL_SEQ)
@@ -539,7 +584,8 @@ void mw_what_key(void)
 
       if (SigWinch)
       {
-        SigWinch = false;
+        mutt_resize_settle();
+        timeout(1000); // 1 second
         notify_send(NeoMutt->notify_resize, NT_RESIZE, 0, NULL);
         window_redraw(NULL);
       }
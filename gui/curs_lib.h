@@ -57,6 +57,7 @@ void         mutt_paddstr(struct MuttWindow *win, int n, const char *s);
 void         mutt_push_macro_event(int ch, int op);
 void         mutt_query_exit(void);
 void         mutt_refresh(void);
+void         mutt_resize_settle(void);
 size_t       mutt_strwidth(const char *s);
 size_t       mutt_strnwidth(const char *s, size_t len);
 void         mutt_unget_ch(int ch);
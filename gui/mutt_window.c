@@ -56,6 +56,8 @@ static const struct Mapping WindowNames[] = {
   { "WT_DLG_GPGME",       WT_DLG_GPGME },
   { "WT_DLG_HISTORY",     WT_DLG_HISTORY },
   { "WT_DLG_INDEX",       WT_DLG_INDEX },
+  { "WT_DLG_LABEL",       WT_DLG_LABEL },
+  { "WT_DLG_MXSEARCH",    WT_DLG_MXSEARCH },
   { "WT_DLG_PAGER",       WT_DLG_PAGER },
   { "WT_DLG_PATTERN",     WT_DLG_PATTERN },
   { "WT_DLG_PGP",         WT_DLG_PGP },
@@ -588,21 +590,28 @@ static void window_recalc(struct MuttWindow *win)
 /**
  * window_repaint - Repaint a tree of Windows
  * @param win   Window to start at
+ * @retval true At least one Window was repainted
  */
-static void window_repaint(struct MuttWindow *win)
+static bool window_repaint(struct MuttWindow *win)
 {
   if (!win || !win->state.visible)
-    return;
+    return false;
 
+  bool painted = false;
   if (win->repaint && (win->actions & WA_REPAINT))
+  {
     win->repaint(win);
+    painted = true;
+  }
   win->actions &= ~WA_REPAINT;
 
   struct MuttWindow *np = NULL;
   TAILQ_FOREACH(np, &win->children, entries)
   {
-    window_repaint(np);
+    painted |= window_repaint(np);
   }
+
+  return painted;
 }
 
 /**
@@ -639,10 +648,14 @@ void window_redraw(struct MuttWindow *win)
   window_notify_all(win);
 
   window_recalc(win);
-  window_repaint(win);
+  const bool painted = window_repaint(win);
   window_recursor();
 
-  mutt_refresh();
+  /* Nothing was painted, so the terminal already shows the right thing.
+   * A pending cursor move doesn't need a flush either: curses refreshes a
+   * moved or modified screen by itself before the next getch(). */
+  if (painted)
+    mutt_refresh();
 }
 
 /**
@@ -84,6 +84,8 @@ enum WindowType
   WT_DLG_PAGER,       ///< Pager Dialog,       dlg_pager()
   WT_DLG_HISTORY,     ///< History Dialog,     dlg_history()
   WT_DLG_INDEX,       ///< Index Dialog,       dlg_index()
+  WT_DLG_LABEL,       ///< Label Dialog,       mutt_label_select()
+  WT_DLG_MXSEARCH,    ///< Mailbox Search Dialog, dlg_mxsearch()
   WT_DLG_PATTERN,     ///< Pattern Dialog,     dlg_pattern()
   WT_DLG_PGP,         ///< Pgp Dialog,         dlg_pgp()
   WT_DLG_POSTPONED,   ///< Postponed Dialog,   dlg_postponed()
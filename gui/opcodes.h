@@ -204,6 +204,9 @@ const char *opcodes_get_name       (int op);
   /* L10N: Help screen description for OP_BROWSER_VIEW_FILE */ \
   /*       Browser: <op_browser_view_file> */ \
   _fmt(OP_BROWSER_VIEW_FILE,                  N_("view file")) \
+  /* L10N: Help screen description for OP_BROWSE_LABELS */ \
+  /*       Index: <op_main_limit> */ \
+  _fmt(OP_BROWSE_LABELS,                      N_("select a label and limit to messages using it")) \
   /* L10N: Help screen description for OP_CATCHUP */ \
   /*       Browser: <op_catchup> */ \
   /*       Index: <op_catchup> */ \
@@ -472,6 +475,9 @@ const char *opcodes_get_name       (int op);
   _fmt(OP_JUMP_7,                             N_("jump to an index number")) \
   _fmt(OP_JUMP_8,                             N_("jump to an index number")) \
   _fmt(OP_JUMP_9,                             N_("jump to an index number")) \
+  /* L10N: Help screen description for OP_JUMP_TO_MSGID */ \
+  /*       Index: <op_jump_to_msgid> */ \
+  _fmt(OP_JUMP_TO_MSGID,                      N_("jump to a message by its message-id, across mailboxes")) \
   /* L10N: Help screen description for OP_LAST_ENTRY */ \
   /*       Menu: <menu_movement> */ \
   _fmt(OP_LAST_ENTRY,                         N_("move to the last entry")) \
@@ -606,6 +612,9 @@ const char *opcodes_get_name       (int op);
   /* L10N: Help screen description for OP_MAIN_ROOT_MESSAGE */ \
   /*       Index: <op_main_root_message> */ \
   _fmt(OP_MAIN_ROOT_MESSAGE,                  N_("jump to root message in thread")) \
+  /* L10N: Help screen description for OP_MAIN_SEARCH_MAILBOXES */ \
+  /*       Index: <op_main_search_mailboxes> */ \
+  _fmt(OP_MAIN_SEARCH_MAILBOXES,              N_("search for messages matching a pattern in all mailboxes")) \
   /* L10N: Help screen description for OP_MAIN_SET_FLAG */ \
   /*       Index: <op_main_set_flag> */ \
   _fmt(OP_MAIN_SET_FLAG,                      N_("set a status flag on a message")) \
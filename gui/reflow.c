@@ -27,11 +27,32 @@
  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include "mutt/lib.h"
 #include "reflow.h"
 #include "mutt_window.h"
 
+/**
+ * window_geometry_changed - Has a Window's geometry changed since it was last observed?
+ * @param win Window
+ * @retval true Window has moved, resized or changed visibility
+ *
+ * An unchanged Window means an unchanged subtree: anything that alters a
+ * deeper Window reflows from that Window's parent, so its children are
+ * already laid out.  The reflow can skip them - resizing a large dialog then
+ * only walks the parts of the tree that actually move.
+ */
+static bool window_geometry_changed(const struct MuttWindow *win)
+{
+  const struct WindowState *old = &win->old;
+  const struct WindowState *wstate = &win->state;
+
+  return (wstate->visible != old->visible) || (wstate->rows != old->rows) ||
+         (wstate->cols != old->cols) || (wstate->row_offset != old->row_offset) ||
+         (wstate->col_offset != old->col_offset);
+}
+
 /**
  * window_reflow_horiz - Reflow Windows using all the available horizontal space
  * @param win Window
@@ -112,7 +133,8 @@ static void window_reflow_horiz(struct MuttWindow *win)
     np->state.row_offset = win->state.row_offset;
     col += np->state.cols;
 
-    window_reflow(np);
+    if (window_geometry_changed(np))
+      window_reflow(np);
   }
 
   if ((space > 0) && (win->size == MUTT_WIN_SIZE_MINIMISE))
@@ -201,7 +223,8 @@ static void window_reflow_vert(struct MuttWindow *win)
     np->state.col_offset = win->state.col_offset;
     row += np->state.rows;
 
-    window_reflow(np);
+    if (window_geometry_changed(np))
+      window_reflow(np);
   }
 
   if ((space > 0) && (win->size == MUTT_WIN_SIZE_MINIMISE))
@@ -1537,6 +1537,12 @@ void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd
   char bufi[BUFI_SIZE] = { 0 };
   size_t l = 0;
 
+  /* Read the input in blocks - a fgetc() per encoded byte dominates the
+   * decode time of a large attachment */
+  unsigned char rdbuf[4096];
+  size_t rdlen = 0;
+  size_t rdpos = 0;
+
   buf[4] = '\0';
 
   if (istext)
@@ -1546,10 +1552,15 @@ void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd
   {
     for (i = 0; (i < 4) && (len > 0); len--)
     {
-      ch = fgetc(state->fp_in);
-      if (ch == EOF)
-        break;
-      if ((ch >= 0) && (ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
+      if (rdpos == rdlen)
+      {
+        rdlen = fread(rdbuf, 1, MIN(sizeof(rdbuf), len), state->fp_in);
+        rdpos = 0;
+        if (rdlen == 0)
+          break;
+      }
+      ch = rdbuf[rdpos++];
+      if ((ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
         buf[i++] = ch;
     }
     if (i != 4)
@@ -1612,6 +1623,10 @@ void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd
       convert_to_state(cd, bufi, &l, state);
   }
 
+  // Put back anything read ahead, but not consumed (e.g. after '=' padding)
+  if (rdpos < rdlen)
+    mutt_file_seek(state->fp_in, -(LOFF_T) (rdlen - rdpos), SEEK_CUR);
+
   if (cr)
     bufi[l++] = '\r';
 
@@ -131,6 +131,9 @@ static struct ConfigDef HcacheVars[] = {
   { "header_cache_backend", DT_STRING, 0, 0, hcache_validator,
     "(hcache) Header cache backend to use"
   },
+  { "header_cache_compact_size", DT_LONG|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(hcache) Compact the database when it grows past this size in bytes (0 to disable)"
+  },
   { NULL },
   // clang-format on
 };
@@ -31,6 +31,7 @@
  */
 
 #include "config.h"
+#include <dirent.h>
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
@@ -48,6 +49,7 @@
 #include "compress/lib.h"
 #include "store/lib.h"
 #include "hcache/hcversion.h" // path needed by out-of-tree build
+#include "parse/lib.h"
 #include "muttlib.h"
 #include "serialize.h"
 
@@ -60,6 +62,11 @@
 /// Header Cache version
 static unsigned int HcacheVer = 0x0;
 
+/// Maximum number of records sampled for compression dictionary training
+#define DICT_MAX_SAMPLES 1024
+/// Don't train a compression dictionary on fewer records than this
+#define DICT_MIN_SAMPLES 128
+
 /**
  * struct RealKey - Hcache key name (including compression method)
  */
@@ -76,13 +83,17 @@ struct RealKey
  * @param keylen   Length of original key
  * @param compress Will the data be compressed?
  * @retval ptr Static location holding data and length of the real key
+ *
+ * The folder is represented by its fixed-width digest rather than its path -
+ * shorter keys mean shallower b-trees in the store.
  */
 static struct RealKey *realkey(struct HeaderCache *hc, const char *key,
                                size_t keylen, bool compress)
 {
   static struct RealKey rk;
 
-  rk.keylen = snprintf(rk.key, sizeof(rk.key), "%s/%.*s", hc->folder, (int) keylen, key);
+  rk.keylen = snprintf(rk.key, sizeof(rk.key), "%s/%.*s", hc->folder_key,
+                       (int) keylen, key);
 
 #ifdef USE_HCACHE_COMPRESSION
   if (compress && hc->compr_ops)
@@ -107,6 +118,12 @@ static void hcache_free(struct HeaderCache **ptr)
 
   struct HeaderCache *hc = *ptr;
   FREE(&hc->folder);
+  FREE(&hc->store_path);
+
+  for (size_t i = 0; i < hc->dict_num_samples; i++)
+    FREE(&hc->dict_samples[i]);
+  FREE(&hc->dict_samples);
+  FREE(&hc->dict_sample_lens);
 
   FREE(ptr);
 }
@@ -465,11 +482,25 @@ static unsigned int generate_hcachever(void)
   return digest.intval;
 }
 
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * dict_path - Path of the compression dictionary for a header cache
+ * @param[in]  hc   Header cache handle
+ * @param[out] path Buffer for the path
+ *
+ * The dictionary lives alongside the store file, e.g. `<store>.zstd-dict`.
+ */
+static void dict_path(struct HeaderCache *hc, struct Buffer *path)
+{
+  buf_printf(path, "%s.%s-dict", hc->store_path, hc->compr_ops->name);
+}
+#endif
+
 /**
  * hcache_open - Multiplexor for StoreOps::open
  */
 struct HeaderCache *hcache_open(const char *path, const char *folder,
-                                hcache_namer_t namer, bool create)
+                                hcache_namer_t namer, bool create, bool read_only)
 {
   if (!path || (path[0] == '\0'))
     return NULL;
@@ -481,6 +512,13 @@ struct HeaderCache *hcache_open(const char *path, const char *folder,
 
   hc->folder = get_foldername(folder);
   hc->crc = HcacheVer;
+  hc->read_only = read_only;
+
+  // Two seeds give 64 bits of folder digest - enough to keep folders apart
+  const size_t folder_len = mutt_str_len(hc->folder);
+  snprintf(hc->folder_key, sizeof(hc->folder_key), "%08x%08x",
+           mutt_crc32c(0, hc->folder, folder_len),
+           mutt_crc32c(1, hc->folder, folder_len));
 
   const char *const c_header_cache_backend = cs_subset_string(NeoMutt->sub, "header_cache_backend");
   hc->store_ops = store_get_backend_ops(c_header_cache_backend);
@@ -512,14 +550,16 @@ struct HeaderCache *hcache_open(const char *path, const char *folder,
 
   struct Buffer *hcpath = buf_pool_get();
   hcache_per_folder(hc, hcpath, path, namer);
+  hc->store_path = buf_strdup(hcpath);
 
-  hc->store_handle = hc->store_ops->open(buf_string(hcpath), create);
+  hc->store_handle = hc->store_ops->open(buf_string(hcpath), create && !read_only, read_only);
   if (!hc->store_handle)
   {
-    /* remove a possibly incompatible version */
-    if (unlink(buf_string(hcpath)) == 0)
+    /* remove a possibly incompatible version - but a reader mustn't destroy
+     * the interactive session's cache behind its back */
+    if (!read_only && (unlink(buf_string(hcpath)) == 0))
     {
-      hc->store_handle = hc->store_ops->open(buf_string(hcpath), create);
+      hc->store_handle = hc->store_ops->open(buf_string(hcpath), create, read_only);
       if (!hc->store_handle)
       {
         if (hc->compr_ops)
@@ -535,6 +575,25 @@ struct HeaderCache *hcache_open(const char *path, const char *folder,
     }
   }
 
+#ifdef USE_HCACHE_COMPRESSION
+  if (hc && hc->store_handle && hc->compr_ops && hc->compr_ops->dict_load)
+  {
+    /* Headers are highly repetitive, so a dictionary trained on this
+     * database compresses much better than a generic one.  If there's no
+     * dictionary yet, hcache_store_email() samples records and
+     * hcache_close() trains one for next time.  */
+    struct Buffer *dpath = buf_pool_get();
+    dict_path(hc, dpath);
+    hc->dict_loaded = hc->compr_ops->dict_load(hc->compr_handle, buf_string(dpath));
+    if (hc->dict_loaded)
+    {
+      mutt_debug(LL_DEBUG3, "Header cache using compression dictionary %s\n",
+                 buf_string(dpath));
+    }
+    buf_pool_release(&dpath);
+  }
+#endif
+
   buf_pool_release(&hcpath);
   return hc;
 }
@@ -551,9 +610,42 @@ void hcache_close(struct HeaderCache **ptr)
 
 #ifdef USE_HCACHE_COMPRESSION
   if (hc->compr_ops)
+  {
+    if (!hc->dict_loaded && hc->compr_ops->dict_train &&
+        (hc->dict_num_samples >= DICT_MIN_SAMPLES))
+    {
+      struct Buffer *dpath = buf_pool_get();
+      dict_path(hc, dpath);
+      if (hc->compr_ops->dict_train(hc->compr_handle, buf_string(dpath),
+                                    (const char **) hc->dict_samples,
+                                    hc->dict_sample_lens, hc->dict_num_samples))
+      {
+        mutt_debug(LL_DEBUG1, "hcache: trained compression dictionary %s on %zu records\n",
+                   buf_string(dpath), hc->dict_num_samples);
+      }
+      buf_pool_release(&dpath);
+    }
     hc->compr_ops->close(&hc->compr_handle);
+  }
 #endif
 
+  mutt_debug(LL_DEBUG3, "hcache: %zu records referenced in %s\n",
+             hc->keys_touched, NONULL(hc->store_path));
+
+  /* If the store file has outgrown the configured limit, compact it before
+   * letting go of the handle */
+  const long c_header_cache_compact_size = cs_subset_long(NeoMutt->sub, "header_cache_compact_size");
+  if ((c_header_cache_compact_size > 0) && hc->store_path && !hc->read_only)
+  {
+    struct stat st = { 0 };
+    if ((stat(hc->store_path, &st) == 0) && (st.st_size >= c_header_cache_compact_size))
+    {
+      mutt_debug(LL_DEBUG1, "hcache: compacting %s (%zu bytes)\n",
+                 hc->store_path, (size_t) st.st_size);
+      hc->store_ops->vacuum(hc->store_handle);
+    }
+  }
+
   hc->store_ops->close(&hc->store_handle);
 
   hcache_free(ptr);
@@ -610,9 +702,71 @@ struct HCacheEntry hcache_fetch_email(struct HeaderCache *hc, const char *key,
 
 end:
   free_raw(hc, &to_free);
+  if (hce.email)
+    hc->keys_touched++;
+  perf_count(hce.email ? PERF_HCACHE_HIT : PERF_HCACHE_MISS, 0);
   return hce;
 }
 
+/**
+ * hcache_compressed - Is the Header Cache compressed?
+ * @param hc Header Cache
+ * @retval true Records are compressed
+ */
+bool hcache_compressed(struct HeaderCache *hc)
+{
+#ifdef USE_HCACHE_COMPRESSION
+  return hc && hc->compr_ops;
+#else
+  return false;
+#endif
+}
+
+/**
+ * hcache_fetch_email_raw - Fetch an Email's serialised data, without decoding it
+ */
+void *hcache_fetch_email_raw(struct HeaderCache *hc, const char *key,
+                             size_t keylen, uint32_t *uidvalidity)
+{
+  if (!hc || hcache_compressed(hc))
+    return NULL;
+
+  size_t dlen = 0;
+  struct RealKey *rk = realkey(hc, key, keylen, true);
+  void *data = hc->store_ops->fetch(hc->store_handle, rk->key, rk->keylen, &dlen);
+  if (!data)
+    return NULL;
+
+  void *blob = NULL;
+  if (header_size() > dlen)
+    goto end;
+
+  int off = 0;
+  unsigned int crc = 0;
+  serial_restore_uint32_t(uidvalidity, data, &off);
+  serial_restore_int(&crc, data, &off);
+  if (crc != hc->crc)
+    goto end;
+
+  blob = mutt_mem_malloc(dlen);
+  memcpy(blob, data, dlen);
+
+end:
+  free_raw(hc, &data);
+  return blob;
+}
+
+/**
+ * hcache_restore_email - Decode an Email fetched with hcache_fetch_email_raw()
+ */
+struct Email *hcache_restore_email(const void *data)
+{
+  if (!data)
+    return NULL;
+
+  return restore_email(data);
+}
+
 /**
  * hcache_fetch_raw_obj_full - Fetch a message's header from the cache into a destination object
  * @param[in]  hc     Pointer to the struct HeaderCache structure got by hcache_open()
@@ -675,6 +829,8 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen,
 {
   if (!hc)
     return -1;
+  if (hc->read_only)
+    return -1;
 
   int dlen = 0;
   char *data = dump_email(hc, e, &dlen, uidvalidity);
@@ -686,6 +842,22 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen,
      * decompressing on fetch().  */
     size_t hlen = header_size();
 
+    /* Until a dictionary has been trained, sample the records passing
+     * through, so hcache_close() has a training corpus */
+    if (!hc->dict_loaded && hc->compr_ops->dict_train &&
+        (hc->dict_num_samples < DICT_MAX_SAMPLES))
+    {
+      if (!hc->dict_samples)
+      {
+        hc->dict_samples = mutt_mem_calloc(DICT_MAX_SAMPLES, sizeof(char *));
+        hc->dict_sample_lens = mutt_mem_calloc(DICT_MAX_SAMPLES, sizeof(size_t));
+      }
+      hc->dict_samples[hc->dict_num_samples] = mutt_mem_malloc(dlen - hlen);
+      memcpy(hc->dict_samples[hc->dict_num_samples], data + hlen, dlen - hlen);
+      hc->dict_sample_lens[hc->dict_num_samples] = dlen - hlen;
+      hc->dict_num_samples++;
+    }
+
     /* data / dlen gets ptr to compressed data here */
     size_t clen = dlen;
     void *cdata = hc->compr_ops->compress(hc->compr_handle, data + hlen, dlen - hlen, &clen);
@@ -711,6 +883,70 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen,
 
   FREE(&data);
 
+  if (rc == 0)
+    hc->keys_touched++;
+
+  return rc;
+}
+
+/**
+ * hcache_copy_email - Copy a serialised Email between two header caches
+ */
+int hcache_copy_email(struct HeaderCache *hc_src, const char *key_src,
+                      size_t keylen_src, struct HeaderCache *hc_dst,
+                      const char *key_dst, size_t keylen_dst, uint32_t uidvalidity)
+{
+  if (!hc_src || !hc_dst)
+    return -1;
+  if (hc_dst->read_only)
+    return -1;
+
+  /* Both sides must agree on the record layout, and hold it uncompressed -
+   * the caches may differ in codec or trained dictionary */
+  if ((hc_src->crc != hc_dst->crc) || hcache_compressed(hc_src) || hcache_compressed(hc_dst))
+    return -1;
+
+  /* realkey() returns a static buffer, so compute the destination key before
+   * fetching overwrites it */
+  struct RealKey rk_dst = *realkey(hc_dst, key_dst, keylen_dst, true);
+
+  size_t dlen = 0;
+  struct RealKey *rk_src = realkey(hc_src, key_src, keylen_src, true);
+  void *data = hc_src->store_ops->fetch(hc_src->store_handle, rk_src->key,
+                                        rk_src->keylen, &dlen);
+  if (!data)
+    return -1;
+
+  int rc = -1;
+  size_t hlen = header_size();
+  if (hlen > dlen)
+    goto end;
+
+  int off = 0;
+  uint32_t uv = 0;
+  unsigned int crc = 0;
+  serial_restore_uint32_t(&uv, data, &off);
+  serial_restore_int(&crc, data, &off);
+  if (crc != hc_src->crc)
+    goto end;
+
+  char *copy = mutt_mem_malloc(dlen);
+  memcpy(copy, data, dlen);
+  if (uidvalidity != 0)
+  {
+    /* Patch the validity datum in place; the blob after the header holds no
+     * keys or offsets, so it needs no other fixups */
+    memcpy(copy, &uidvalidity, sizeof(uidvalidity));
+  }
+
+  rc = hc_dst->store_ops->store(hc_dst->store_handle, rk_dst.key, rk_dst.keylen, copy, dlen);
+  FREE(&copy);
+
+  if (rc == 0)
+    hc_dst->keys_touched++;
+
+end:
+  free_raw(hc_src, &data);
   return rc;
 }
 
@@ -729,6 +965,8 @@ int hcache_store_raw(struct HeaderCache *hc, const char *key, size_t keylen,
 {
   if (!hc)
     return -1;
+  if (hc->read_only)
+    return -1;
 
   struct RealKey *rk = realkey(hc, key, keylen, false);
   int rc = hc->store_ops->store(hc->store_handle, rk->key, rk->keylen, data, dlen);
@@ -743,6 +981,8 @@ int hcache_delete_email(struct HeaderCache *hc, const char *key, size_t keylen)
 {
   if (!hc)
     return -1;
+  if (hc->read_only)
+    return -1;
 
   struct RealKey *rk = realkey(hc, key, keylen, true);
 
@@ -756,8 +996,191 @@ int hcache_delete_raw(struct HeaderCache *hc, const char *key, size_t keylen)
 {
   if (!hc)
     return -1;
+  if (hc->read_only)
+    return -1;
 
   struct RealKey *rk = realkey(hc, key, keylen, false);
 
   return hc->store_ops->delete_record(hc->store_handle, rk->key, rk->keylen);
 }
+
+/**
+ * hcache_delete_batch - Multiplexor for StoreOps::delete_batch
+ */
+int hcache_delete_batch(struct HeaderCache *hc, const char **keys,
+                        const size_t *keylens, size_t count)
+{
+  if (!hc)
+    return -1;
+  if (hc->read_only)
+    return -1;
+  if (count == 0)
+    return 0;
+
+  /* realkey() returns a static buffer, so the prefixed keys must be copied */
+  char **rkeys = mutt_mem_calloc(count, sizeof(char *));
+  size_t *rklens = mutt_mem_calloc(count, sizeof(size_t));
+
+  for (size_t i = 0; i < count; i++)
+  {
+    struct RealKey *rk = realkey(hc, keys[i], keylens[i], true);
+    rkeys[i] = mutt_strn_dup(rk->key, rk->keylen);
+    rklens[i] = rk->keylen;
+  }
+
+  int rc = hc->store_ops->delete_batch(hc->store_handle, (const char **) rkeys,
+                                       rklens, count);
+
+  for (size_t i = 0; i < count; i++)
+    FREE(&rkeys[i]);
+  FREE(&rkeys);
+  FREE(&rklens);
+
+  return rc;
+}
+
+/**
+ * hcache_txn_begin - Multiplexor for StoreOps::txn_begin
+ */
+int hcache_txn_begin(struct HeaderCache *hc)
+{
+  if (!hc)
+    return -1;
+  if (hc->read_only)
+    return -1;
+
+  return hc->store_ops->txn_begin(hc->store_handle);
+}
+
+/**
+ * hcache_txn_commit - Multiplexor for StoreOps::txn_commit
+ */
+int hcache_txn_commit(struct HeaderCache *hc)
+{
+  if (!hc)
+    return -1;
+  if (hc->read_only)
+    return -1;
+
+  return hc->store_ops->txn_commit(hc->store_handle);
+}
+
+/**
+ * hcache_compact_file - Compact a single store database file
+ * @param ops  Store backend operations
+ * @param path Path of the database file
+ * @retval  0 Success
+ * @retval -1 Failure, or compaction isn't supported
+ */
+static int hcache_compact_file(const struct StoreOps *ops, const char *path)
+{
+  StoreHandle *handle = ops->open(path, false, false);
+  if (!handle)
+    return -1;
+
+  int rc = ops->vacuum(handle);
+  ops->close(&handle);
+
+  if (rc != 0)
+    mutt_debug(LL_DEBUG1, "hcache: failed to compact %s (rc %d)\n", path, rc);
+
+  return (rc == 0) ? 0 : -1;
+}
+
+/**
+ * parse_hcache_compact - Parse the 'hcache-compact' command - Implements Command::parse() - @ingroup command_parse
+ *
+ * The 'hcache-compact' command rewrites the header cache database(s) so they
+ * only occupy the space their live records need.
+ */
+static enum CommandResult parse_hcache_compact(struct Buffer *buf, struct Buffer *s,
+                                               intptr_t data, struct Buffer *err)
+{
+  if (MoreArgs(s))
+  {
+    buf_printf(err, _("%s: too many arguments"), "hcache-compact");
+    return MUTT_CMD_WARNING;
+  }
+
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+  if (!c_header_cache || (c_header_cache[0] == '\0'))
+  {
+    buf_printf(err, _("%s: $header_cache isn't set"), "hcache-compact");
+    return MUTT_CMD_WARNING;
+  }
+
+  const char *const c_header_cache_backend = cs_subset_string(NeoMutt->sub, "header_cache_backend");
+  const struct StoreOps *ops = store_get_backend_ops(c_header_cache_backend);
+  if (!ops)
+  {
+    buf_printf(err, _("%s: no store backend available"), "hcache-compact");
+    return MUTT_CMD_ERROR;
+  }
+
+  struct Buffer *path = buf_pool_get();
+  buf_strcpy(path, c_header_cache);
+  buf_expand_path(path);
+
+  int num_done = 0;
+  int num_failed = 0;
+
+  struct stat st = { 0 };
+  if ((stat(buf_string(path), &st) == 0) && S_ISDIR(st.st_mode))
+  {
+    /* One database file per folder */
+    DIR *dir = mutt_file_opendir(buf_string(path), MUTT_OPENDIR_NONE);
+    if (dir)
+    {
+      struct Buffer *file = buf_pool_get();
+      struct dirent *de = NULL;
+      while ((de = readdir(dir)))
+      {
+        buf_concat_path(file, buf_string(path), de->d_name);
+        if ((stat(buf_string(file), &st) != 0) || !S_ISREG(st.st_mode))
+          continue;
+
+        if (hcache_compact_file(ops, buf_string(file)) == 0)
+          num_done++;
+        else
+          num_failed++;
+      }
+      buf_pool_release(&file);
+      closedir(dir);
+    }
+  }
+  else
+  {
+    if (hcache_compact_file(ops, buf_string(path)) == 0)
+      num_done++;
+    else
+      num_failed++;
+  }
+
+  buf_pool_release(&path);
+
+  if ((num_done == 0) && (num_failed != 0))
+  {
+    buf_printf(err, _("%s: compaction failed"), "hcache-compact");
+    return MUTT_CMD_ERROR;
+  }
+
+  mutt_message(_("Compacted %d header cache database(s)"), num_done);
+  return MUTT_CMD_SUCCESS;
+}
+
+/**
+ * HcacheCommands - Hcache Commands
+ */
+static const struct Command HcacheCommands[] = {
+  // clang-format off
+  { "hcache-compact", parse_hcache_compact, 0 },
+  // clang-format on
+};
+
+/**
+ * hcache_init - Setup feature commands
+ */
+void hcache_init(void)
+{
+  commands_register(HcacheCommands, mutt_array_size(HcacheCommands));
+}
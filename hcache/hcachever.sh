@@ -1,6 +1,6 @@
 #!/bin/sh
 
-BASEVERSION=9
+BASEVERSION=10
 STRUCTURES="Address Body Buffer Email Envelope ListNode Parameter"
 
 cleanstruct () {
@@ -102,6 +102,12 @@ while read -r line; do
 done
 echo " */" >> "$TMPD"
 
+# The record layout table is part of the cache format too - hash it in, so
+# editing serial.def invalidates old caches just like a struct change does
+if [ -n "$2" ]; then
+  TEXT="$TEXT $(grep -v '^#' "$2")"
+fi
+
 MD5PROG=$(md5prog)
 MD5TEXT=$(echo "$TEXT" | $MD5PROG | cut -c-8)
 echo "#define HCACHEVER 0x$MD5TEXT" >> "$TMPD"
@@ -85,11 +85,19 @@ struct Email;
 struct HeaderCache
 {
   char *folder;                       ///< Folder name
+  char folder_key[17];                ///< CRC-32C digest of the folder, used in store keys
   unsigned int crc;                   ///< CRC of the cache entry
   const struct StoreOps *store_ops;   ///< Store backend
   StoreHandle *store_handle;          ///< Store handle
   const struct ComprOps *compr_ops;   ///< Compression backend
   ComprHandle *compr_handle;          ///< Compression handle
+  char *store_path;                   ///< Path of the store file
+  bool read_only;                     ///< Store is open read-only; writes are dropped
+  size_t keys_touched;                ///< Records referenced since open
+  bool dict_loaded;                   ///< Records are compressed with a trained dictionary
+  char **dict_samples;                ///< Records sampled for dictionary training
+  size_t *dict_sample_lens;           ///< Lengths of the sampled records
+  size_t dict_num_samples;            ///< Number of records sampled so far
 };
 
 /**
@@ -112,6 +120,11 @@ struct HCacheEntry
  */
 typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
 
+/**
+ * hcache_init - Setup feature commands
+ */
+void hcache_init(void);
+
 /**
  * hcache_open - Open the connection to the header cache
  * @param path   Location of the header cache (often as specified by the user)
@@ -119,10 +132,16 @@ typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
  * @param namer  Optional (might be NULL) client-specific function to form the
  *               final name of the hcache database file.
  * @param create Create the file if it's not there?
+ * @param read_only Open the store without write locks?
  * @retval ptr  Success, struct HeaderCache struct
  * @retval NULL Otherwise
+ *
+ * Callers with a read-only Mailbox should pass its `readonly` flag as
+ * @a read_only - the reader handle doesn't contend with a concurrent
+ * interactive session's read-write handle, and all writes through it are
+ * silently dropped.
  */
-struct HeaderCache *hcache_open(const char *path, const char *folder, hcache_namer_t namer, bool create);
+struct HeaderCache *hcache_open(const char *path, const char *folder, hcache_namer_t namer, bool create, bool read_only);
 
 /**
  * hcache_close - Close the connection to the header cache
@@ -144,6 +163,25 @@ void hcache_close(struct HeaderCache **ptr);
  */
 int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen, struct Email *e, uint32_t uidvalidity);
 
+/**
+ * hcache_copy_email - Copy a serialised Email between two header caches
+ * @param hc_src      Header cache to copy from
+ * @param key_src     Source message identification string
+ * @param keylen_src  Length of the key_src string
+ * @param hc_dst      Header cache to copy to (may equal hc_src)
+ * @param key_dst     Destination message identification string
+ * @param keylen_dst  Length of the key_dst string
+ * @param uidvalidity Validity datum for the copy, or 0 to keep the original
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * The serialised record is copied verbatim, skipping the Envelope/Body
+ * restore and re-dump a fetch/store pair would do.  Both caches must use the
+ * same record layout (crc) and store records uncompressed; otherwise the
+ * caller has to fall back to hcache_fetch_email() + hcache_store_email().
+ */
+int hcache_copy_email(struct HeaderCache *hc_src, const char *key_src, size_t keylen_src, struct HeaderCache *hc_dst, const char *key_dst, size_t keylen_dst, uint32_t uidvalidity);
+
 /**
  * hcache_fetch_email - Fetch and validate a  message's header from the cache
  * @param hc     Pointer to the struct HeaderCache structure got by hcache_open()
@@ -157,6 +195,33 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen, s
  */
 struct HCacheEntry hcache_fetch_email(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t uidvalidity);
 
+/**
+ * hcache_fetch_email_raw - Fetch an Email's serialised data from the cache
+ * @param[in]  hc          Pointer to the struct HeaderCache structure got by hcache_open()
+ * @param[in]  key         Message identification string
+ * @param[in]  keylen      Length of the string pointed to by key
+ * @param[out] uidvalidity Validity datum stored with the record
+ * @retval ptr  Success, serialised data for hcache_restore_email()
+ * @retval NULL Not found, or the record is unusable
+ *
+ * The caller owns the returned data and must FREE() it.  Splitting the fetch
+ * from the decode lets a caller fetch a batch of records here and decode them
+ * on other threads - hcache_restore_email() doesn't touch the store backend.
+ * Compressed caches can't be split this way; use hcache_fetch_email() there.
+ */
+void *hcache_fetch_email_raw(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t *uidvalidity);
+
+/**
+ * hcache_restore_email - Restore an Email fetched with hcache_fetch_email_raw()
+ * @param data Serialised data
+ * @retval ptr Restored Email
+ *
+ * Doesn't touch the store backend, so it may run on any thread.
+ */
+struct Email *hcache_restore_email(const void *data);
+
+bool hcache_compressed(struct HeaderCache *hc);
+
 char *hcache_fetch_raw_str(struct HeaderCache *hc, const char *key, size_t keylen);
 bool  hcache_fetch_raw_obj_full(struct HeaderCache *hc, const char *key, size_t keylen, void *dst, size_t dstlen);
 #define hcache_fetch_raw_obj(hc, key, keylen, dst) hcache_fetch_raw_obj_full(hc, key, keylen, dst, sizeof(*dst))
@@ -184,4 +249,38 @@ int hcache_delete_email(struct HeaderCache *hc, const char *key, size_t keylen);
  */
 int hcache_delete_raw(struct HeaderCache *hc, const char *key, size_t keylen);
 
+/**
+ * hcache_delete_batch - Delete a set of keys in one batch
+ * @param hc      Pointer to the struct HeaderCache structure got by hcache_open()
+ * @param keys    Array of keys
+ * @param keylens Array of key lengths
+ * @param count   Number of keys
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * Where the store backend supports it, the records are removed in a single
+ * write batch, which is much faster than one delete per record.
+ */
+int hcache_delete_batch(struct HeaderCache *hc, const char **keys, const size_t *keylens, size_t count);
+
+/**
+ * hcache_txn_begin - Start a batch of writes to the header cache
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * Stores made before the matching hcache_txn_commit() may be committed to the
+ * database in a single transaction, which is much faster than one transaction
+ * per store on some backends.
+ */
+int hcache_txn_begin(struct HeaderCache *hc);
+
+/**
+ * hcache_txn_commit - Commit a batch of writes to the header cache
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ */
+int hcache_txn_commit(struct HeaderCache *hc);
+
 #endif /* MUTT_HCACHE_LIB_H */
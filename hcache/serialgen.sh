@@ -0,0 +1,232 @@
+#!/bin/sh
+#
+# Generate the Envelope/Body (de)serialisers from hcache/serial.def
+#
+#     serialgen.sh serial.def serialize_gen.c
+#
+# Both directions are emitted from the same field table, so dump and
+# restore stay in lockstep and each function comes out as one flat run of
+# calls for the compiler to inline.
+
+DEF="$1"
+DEST="$2"
+TMPD="$DEST.tmp"
+
+conv_arg () {
+  if [ "$1" = "convert" ]; then
+    echo "convert"
+  else
+    echo "false"
+  fi
+}
+
+# emit_fields <record> <dump|restore>
+emit_fields () {
+  while read -r record kind name conv; do
+    case "$record" in
+      ''|'#'*) continue ;;
+    esac
+    [ "$record" = "$1" ] || continue
+    c=$(conv_arg "$conv")
+
+    if [ "$2" = "dump" ]; then
+      case "$kind" in
+        address)   echo "  d = serial_dump_address(&env->$name, d, off, $c);" ;;
+        char)
+          if [ "$1" = "envelope" ]; then
+            echo "  d = serial_dump_char(env->$name, d, off, $c);"
+          else
+            echo "  d = serial_dump_char(b->$name, d, off, $c);"
+          fi
+          ;;
+        buffer)    echo "  d = serial_dump_buffer(&env->$name, d, off, $c);" ;;
+        stailq)    echo "  d = serial_dump_stailq(&env->$name, d, off, $c);" ;;
+        parameter) echo "  d = serial_dump_parameter(&b->$name, d, off, $c);" ;;
+        uint64)    echo "  d = serial_dump_uint64_t((uint64_t) b->$name, d, off);" ;;
+        flags)
+          echo "  d = serial_dump_uint32_t(body_pack_flags(b), d, off);"
+          ;;
+        subject)
+          cat <<EOT
+  d = serial_dump_char(env->subject, d, off, $c);
+
+  if (env->real_subj)
+    d = serial_dump_int(env->real_subj - env->subject, d, off);
+  else
+    d = serial_dump_int(-1, d, off);
+EOT
+          ;;
+        *)
+          echo "serialgen.sh: unknown kind '$kind'" >&2
+          exit 1
+          ;;
+      esac
+    else
+      case "$kind" in
+        address)   echo "  serial_restore_address(&env->$name, d, off, $c);" ;;
+        char)
+          if [ "$1" = "envelope" ]; then
+            echo "  serial_restore_char(&env->$name, d, off, $c);"
+          else
+            echo "  serial_restore_char(&b->$name, d, off, $c);"
+          fi
+          ;;
+        buffer)    echo "  serial_restore_buffer(&env->$name, d, off, $c);" ;;
+        stailq)    echo "  serial_restore_stailq(&env->$name, d, off, $c);" ;;
+        parameter)
+          echo "  TAILQ_INIT(&b->$name);"
+          echo "  serial_restore_parameter(&b->$name, d, off, $c);"
+          ;;
+        uint64)
+          cat <<EOT
+  {
+    uint64_t big = 0;
+    serial_restore_uint64_t(&big, d, off);
+    b->$name = big;
+  }
+EOT
+          ;;
+        flags)
+          cat <<EOT
+  uint32_t packed = 0;
+  serial_restore_uint32_t(&packed, d, off);
+  body_unpack_flags(b, packed);
+EOT
+          ;;
+        subject)
+          cat <<EOT
+  const bool c_auto_subscribe = cs_subset_bool(NeoMutt->sub, "auto_subscribe");
+  if (c_auto_subscribe)
+    mutt_auto_subscribe(env->list_post);
+
+  {
+    char *subject = NULL;
+    int real_subj_off = 0;
+    serial_restore_char(&subject, d, off, $c);
+    serial_restore_int((unsigned int *) &real_subj_off, d, off);
+
+    const size_t len = mutt_str_len(subject);
+    if (subject && (len < sizeof(env->subj_inline)))
+    {
+      // Keep short subjects in the Envelope's inline storage
+      memcpy(env->subj_inline, subject, len + 1);
+      *(char **) &env->subject = env->subj_inline;
+      FREE(&subject);
+    }
+    else
+    {
+      *(char **) &env->subject = subject;
+    }
+
+    if ((real_subj_off < 0) || (real_subj_off >= len))
+      *(char **) &env->real_subj = NULL;
+    else
+      *(char **) &env->real_subj = env->subject + real_subj_off;
+  }
+EOT
+          ;;
+        *)
+          echo "serialgen.sh: unknown kind '$kind'" >&2
+          exit 1
+          ;;
+      esac
+    fi
+  done < "$DEF"
+}
+
+{
+  cat <<'EOT'
+/* This file is generated from hcache/serial.def by hcache/serialgen.sh.
+ * Do not edit it directly - change the def file and rebuild. */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/types.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "serialize.h"
+
+/* The flag packing must stay stable: the bit positions are part of the
+ * cache format. */
+static inline uint32_t body_pack_flags(const struct Body *b)
+{
+  if (!b)
+    return 0;
+
+  uint32_t packed = b->type +
+                   (b->encoding      <<  4) +
+                   (b->disposition   <<  7) +
+                   (b->badsig        <<  9) +
+                   (b->force_charset << 10) +
+                   (b->goodsig       << 11) +
+                   (b->noconv        << 12) +
+                   (b->use_disp      << 13) +
+                   (b->warnsig       << 14);
+#ifdef USE_AUTOCRYPT
+  packed += (b->is_autocrypt << 15);
+#endif
+
+  return packed;
+}
+
+static inline void body_unpack_flags(struct Body *b, uint32_t packed)
+{
+  if (!b)
+    return;
+
+  b->type         =  (packed       & ((1 << 4) - 1)); // bits 0-3 (4)
+  b->encoding     = ((packed >> 4) & ((1 << 3) - 1)); // bits 4-6 (3)
+  b->disposition  = ((packed >> 7) & ((1 << 2) - 1)); // bits 7-8 (2)
+
+  b->badsig        = (packed & (1 <<  9));
+  b->force_charset = (packed & (1 << 10));
+  b->goodsig       = (packed & (1 << 11));
+  b->noconv        = (packed & (1 << 12));
+  b->use_disp      = (packed & (1 << 13));
+  b->warnsig       = (packed & (1 << 14));
+#ifdef USE_AUTOCRYPT
+  b->is_autocrypt  = (packed & (1 << 15));
+#endif
+}
+
+unsigned char *serial_dump_body(const struct Body *b, unsigned char *d, int *off, bool convert)
+{
+EOT
+  emit_fields body dump
+  cat <<'EOT'
+
+  return d;
+}
+
+void serial_restore_body(struct Body *b, const unsigned char *d, int *off, bool convert)
+{
+EOT
+  emit_fields body restore
+  cat <<'EOT'
+}
+
+unsigned char *serial_dump_envelope(const struct Envelope *env,
+                                    unsigned char *d, int *off, bool convert)
+{
+EOT
+  emit_fields envelope dump
+  cat <<'EOT'
+
+  return d;
+}
+
+void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *off, bool convert)
+{
+EOT
+  emit_fields envelope restore
+  cat <<'EOT'
+}
+EOT
+} > "$TMPD" || exit 1
+
+mv "$TMPD" "$DEST"
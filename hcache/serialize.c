@@ -26,6 +26,11 @@
  * @page hc_serial Email-object serialiser
  *
  * Email-object serialiser
+ *
+ * Strings are stored with a varint length prefix and well-known values, e.g.
+ * charsets and MIME types, are reduced to a one-byte dictionary reference.
+ * Bump **`BASEVERSION`** in `hcache/hcachever.sh` whenever the format
+ * changes; old records then simply miss and get rewritten.
  */
 
 #include "config.h"
@@ -35,11 +40,22 @@
 #include <sys/types.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
-#include "config/lib.h"
 #include "email/lib.h"
 #include "core/lib.h"
 #include "serialize.h"
 
+/// Strings that turn up in (almost) every cache record.
+/// Only ever append to this list - the indexes are part of the format.
+static const char *const SerialDict[] = {
+  // clang-format off
+  "7bit", "8bit", "alternative", "application", "attachment", "base64",
+  "charset", "flowed", "format", "html", "inline", "iso-8859-1",
+  "iso-8859-15", "iso-8859-2", "mixed", "multipart", "octet-stream",
+  "plain", "quoted-printable", "related", "signed", "text", "us-ascii",
+  "utf-8",
+  // clang-format on
+};
+
 /**
  * lazy_realloc - Reallocate some memory
  * @param[in] ptr Pointer to resize
@@ -105,6 +121,51 @@ unsigned char *serial_dump_uint64_t(const uint64_t s, unsigned char *d, int *off
   return d;
 }
 
+/**
+ * serial_dump_varint - Pack a length as a varint into a binary blob
+ * @param[in]     n   Length to save
+ * @param[in]     d   Binary blob to add to
+ * @param[in,out] off Offset into the blob
+ * @retval ptr End of the newly packed binary
+ *
+ * LEB128: seven bits per byte, high bit set on all but the last byte.
+ * Most string lengths fit in a single byte.
+ */
+static unsigned char *serial_dump_varint(size_t n, unsigned char *d, int *off)
+{
+  lazy_realloc(&d, *off + ((sizeof(n) * 8) / 7) + 1);
+  while (n >= 0x80)
+  {
+    d[(*off)++] = (n & 0x7f) | 0x80;
+    n >>= 7;
+  }
+  d[(*off)++] = n;
+
+  return d;
+}
+
+/**
+ * serial_restore_varint - Unpack a varint length from a binary blob
+ * @param[in]     d   Binary blob to read from
+ * @param[in,out] off Offset into the blob
+ * @retval num Unpacked length
+ */
+static size_t serial_restore_varint(const unsigned char *d, int *off)
+{
+  size_t n = 0;
+  int shift = 0;
+  unsigned char byte = 0;
+
+  do
+  {
+    byte = d[(*off)++];
+    n |= (size_t) (byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+
+  return n;
+}
+
 /**
  * serial_restore_int - Unpack an integer from a binary blob
  * @param[in]     i   Integer to write to
@@ -149,6 +210,11 @@ void serial_restore_uint64_t(uint64_t *s, const unsigned char *d, int *off)
  * @param[in,out] off     Offset into the blob
  * @param[in]     convert If true, the strings will be converted to utf-8
  * @retval ptr End of the newly packed binary
+ *
+ * The length prefix encodes three cases:
+ * - `0` - NULL or empty string, no bytes follow
+ * - `1 .. #SerialDict size` - reference to a dictionary string, no bytes follow
+ * - bigger - literal string of `(prefix - dictionary size)` bytes
  */
 unsigned char *serial_dump_char_size(const char *c, ssize_t size,
                                      unsigned char *d, int *off, bool convert)
@@ -157,7 +223,16 @@ unsigned char *serial_dump_char_size(const char *c, ssize_t size,
 
   if (!c || (*c == '\0') || (size == 0))
   {
-    return serial_dump_int(0, d, off);
+    return serial_dump_varint(0, d, off);
+  }
+
+  if ((size > 0) && (c[size - 1] == '\0'))
+  {
+    for (size_t i = 0; i < mutt_array_size(SerialDict); i++)
+    {
+      if (mutt_str_equal(c, SerialDict[i]))
+        return serial_dump_varint(i + 1, d, off);
+    }
   }
 
   if (convert && !mutt_str_is_ascii(c, size))
@@ -169,7 +244,7 @@ unsigned char *serial_dump_char_size(const char *c, ssize_t size,
     }
   }
 
-  d = serial_dump_int(size, d, off);
+  d = serial_dump_varint(size + mutt_array_size(SerialDict), d, off);
   lazy_realloc(&d, *off + size);
   memcpy(d + *off, p ? p : c, size);
   *off += size;
@@ -201,8 +276,7 @@ unsigned char *serial_dump_char(const char *c, unsigned char *d, int *off, bool
  */
 void serial_restore_char(char **c, const unsigned char *d, int *off, bool convert)
 {
-  unsigned int size = 0;
-  serial_restore_int(&size, d, off);
+  size_t size = serial_restore_varint(d, off);
 
   if (size == 0)
   {
@@ -210,6 +284,13 @@ void serial_restore_char(char **c, const unsigned char *d, int *off, bool conver
     return;
   }
 
+  if (size <= mutt_array_size(SerialDict))
+  {
+    *c = mutt_str_dup(SerialDict[size - 1]);
+    return;
+  }
+  size -= mutt_array_size(SerialDict);
+
   *c = mutt_mem_malloc(size);
   memcpy(*c, d + *off, size);
   if (convert && !mutt_str_is_ascii(*c, size))
@@ -449,235 +530,6 @@ void serial_restore_parameter(struct ParameterList *pl, const unsigned char *d,
   }
 }
 
-/**
- * body_pack_flags - Pack the Body flags into a uint32_t
- * @param b Body to pack
- * @retval num uint32_t of packed flags
- *
- * @note Order of packing must match body_unpack_flags()
- */
-static inline uint32_t body_pack_flags(const struct Body *b)
-{
-  if (!b)
-    return 0;
-
-  // clang-format off
-  uint32_t packed = b->type +
-                   (b->encoding      <<  4) +
-                   (b->disposition   <<  7) +
-                   (b->badsig        <<  9) +
-                   (b->force_charset << 10) +
-                   (b->goodsig       << 11) +
-                   (b->noconv        << 12) +
-                   (b->use_disp      << 13) +
-                   (b->warnsig       << 14);
-  // clang-format on
-#ifdef USE_AUTOCRYPT
-  packed += (b->is_autocrypt << 15);
-#endif
-
-  return packed;
-}
-
-/**
- * body_unpack_flags - Unpack the Body flags from a uint32_t
- * @param b      Body to unpack into
- * @param packed Packed flags
- *
- * @note Order of packing must match body_pack_flags()
- */
-static inline void body_unpack_flags(struct Body *b, uint32_t packed)
-{
-  if (!b)
-    return;
-
-  // clang-format off
-  b->type         =  (packed       & ((1 << 4) - 1)); // bits 0-3 (4)
-  b->encoding     = ((packed >> 4) & ((1 << 3) - 1)); // bits 4-6 (3)
-  b->disposition  = ((packed >> 7) & ((1 << 2) - 1)); // bits 7-8 (2)
-
-  b->badsig        = (packed & (1 <<  9));
-  b->force_charset = (packed & (1 << 10));
-  b->goodsig       = (packed & (1 << 11));
-  b->noconv        = (packed & (1 << 12));
-  b->use_disp      = (packed & (1 << 13));
-  b->warnsig       = (packed & (1 << 14));
-#ifdef USE_AUTOCRYPT
-  b->is_autocrypt  = (packed & (1 << 15));
-#endif
-  // clang-format on
-}
-
-/**
- * serial_dump_body - Pack an Body into a binary blob
- * @param[in]     b       Body to pack
- * @param[in]     d       Binary blob to add to
- * @param[in,out] off     Offset into the blob
- * @param[in]     convert If true, the strings will be converted to utf-8
- * @retval ptr End of the newly packed binary
- */
-unsigned char *serial_dump_body(const struct Body *b, unsigned char *d, int *off, bool convert)
-{
-  uint32_t packed = body_pack_flags(b);
-  d = serial_dump_uint32_t(packed, d, off);
-
-  uint64_t big = b->offset;
-  d = serial_dump_uint64_t(big, d, off);
-
-  big = b->length;
-  d = serial_dump_uint64_t(big, d, off);
-
-  d = serial_dump_char(b->xtype, d, off, false);
-  d = serial_dump_char(b->subtype, d, off, false);
-
-  d = serial_dump_parameter(&b->parameter, d, off, convert);
-
-  d = serial_dump_char(b->description, d, off, convert);
-  d = serial_dump_char(b->content_id, d, off, convert);
-  d = serial_dump_char(b->form_name, d, off, convert);
-  d = serial_dump_char(b->filename, d, off, convert);
-  d = serial_dump_char(b->d_filename, d, off, convert);
-
-  return d;
-}
-
-/**
- * serial_restore_body - Unpack a Body from a binary blob
- * @param[in]     b       Store the unpacked Body here
- * @param[in]     d       Binary blob to read from
- * @param[in,out] off     Offset into the blob
- * @param[in]     convert If true, the strings will be converted from utf-8
- */
-void serial_restore_body(struct Body *b, const unsigned char *d, int *off, bool convert)
-{
-  uint32_t packed = 0;
-  serial_restore_uint32_t(&packed, d, off);
-  body_unpack_flags(b, packed);
-
-  uint64_t big = 0;
-  serial_restore_uint64_t(&big, d, off);
-  b->offset = big;
-
-  big = 0;
-  serial_restore_uint64_t(&big, d, off);
-  b->length = big;
-
-  serial_restore_char(&b->xtype, d, off, false);
-  serial_restore_char(&b->subtype, d, off, false);
-
-  TAILQ_INIT(&b->parameter);
-  serial_restore_parameter(&b->parameter, d, off, convert);
-
-  serial_restore_char(&b->description, d, off, convert);
-  serial_restore_char(&b->content_id, d, off, convert);
-  serial_restore_char(&b->form_name, d, off, convert);
-  serial_restore_char(&b->filename, d, off, convert);
-  serial_restore_char(&b->d_filename, d, off, convert);
-}
-
-/**
- * serial_dump_envelope - Pack an Envelope into a binary blob
- * @param[in]     env     Envelope to pack
- * @param[in]     d       Binary blob to add to
- * @param[in,out] off     Offset into the blob
- * @param[in]     convert If true, the strings will be converted to utf-8
- * @retval ptr End of the newly packed binary
- */
-unsigned char *serial_dump_envelope(const struct Envelope *env,
-                                    unsigned char *d, int *off, bool convert)
-{
-  d = serial_dump_address(&env->return_path, d, off, convert);
-  d = serial_dump_address(&env->from, d, off, convert);
-  d = serial_dump_address(&env->to, d, off, convert);
-  d = serial_dump_address(&env->cc, d, off, convert);
-  d = serial_dump_address(&env->bcc, d, off, convert);
-  d = serial_dump_address(&env->sender, d, off, convert);
-  d = serial_dump_address(&env->reply_to, d, off, convert);
-  d = serial_dump_address(&env->mail_followup_to, d, off, convert);
-
-  d = serial_dump_char(env->list_post, d, off, convert);
-  d = serial_dump_char(env->list_subscribe, d, off, convert);
-  d = serial_dump_char(env->list_unsubscribe, d, off, convert);
-  d = serial_dump_char(env->subject, d, off, convert);
-
-  if (env->real_subj)
-    d = serial_dump_int(env->real_subj - env->subject, d, off);
-  else
-    d = serial_dump_int(-1, d, off);
-
-  d = serial_dump_char(env->message_id, d, off, false);
-  d = serial_dump_char(env->supersedes, d, off, false);
-  d = serial_dump_char(env->date, d, off, false);
-  d = serial_dump_char(env->x_label, d, off, convert);
-  d = serial_dump_char(env->organization, d, off, convert);
-
-  d = serial_dump_buffer(&env->spam, d, off, convert);
-
-  d = serial_dump_stailq(&env->references, d, off, false);
-  d = serial_dump_stailq(&env->in_reply_to, d, off, false);
-  d = serial_dump_stailq(&env->userhdrs, d, off, convert);
-
-  d = serial_dump_char(env->xref, d, off, false);
-  d = serial_dump_char(env->followup_to, d, off, false);
-  d = serial_dump_char(env->x_comment_to, d, off, convert);
-
-  return d;
-}
-
-/**
- * serial_restore_envelope - Unpack an Envelope from a binary blob
- * @param[in]     env     Store the unpacked Envelope here
- * @param[in]     d       Binary blob to read from
- * @param[in,out] off     Offset into the blob
- * @param[in]     convert If true, the strings will be converted from utf-8
- */
-void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *off, bool convert)
-{
-  int real_subj_off = 0;
-
-  serial_restore_address(&env->return_path, d, off, convert);
-  serial_restore_address(&env->from, d, off, convert);
-  serial_restore_address(&env->to, d, off, convert);
-  serial_restore_address(&env->cc, d, off, convert);
-  serial_restore_address(&env->bcc, d, off, convert);
-  serial_restore_address(&env->sender, d, off, convert);
-  serial_restore_address(&env->reply_to, d, off, convert);
-  serial_restore_address(&env->mail_followup_to, d, off, convert);
-
-  serial_restore_char(&env->list_post, d, off, convert);
-  serial_restore_char(&env->list_subscribe, d, off, convert);
-  serial_restore_char(&env->list_unsubscribe, d, off, convert);
-
-  const bool c_auto_subscribe = cs_subset_bool(NeoMutt->sub, "auto_subscribe");
-  if (c_auto_subscribe)
-    mutt_auto_subscribe(env->list_post);
-
-  serial_restore_char((char **) &env->subject, d, off, convert);
-  serial_restore_int((unsigned int *) (&real_subj_off), d, off);
-
-  size_t len = mutt_str_len(env->subject);
-  if ((real_subj_off < 0) || (real_subj_off >= len))
-    *(char **) &env->real_subj = NULL;
-  else
-    *(char **) &env->real_subj = env->subject + real_subj_off;
-
-  serial_restore_char(&env->message_id, d, off, false);
-  serial_restore_char(&env->supersedes, d, off, false);
-  serial_restore_char(&env->date, d, off, false);
-  serial_restore_char(&env->x_label, d, off, convert);
-  serial_restore_char(&env->organization, d, off, convert);
-
-  serial_restore_buffer(&env->spam, d, off, convert);
-
-  serial_restore_stailq(&env->references, d, off, false);
-  serial_restore_stailq(&env->in_reply_to, d, off, false);
-  serial_restore_stailq(&env->userhdrs, d, off, convert);
-
-  serial_restore_char(&env->xref, d, off, false);
-  serial_restore_char(&env->followup_to, d, off, false);
-  serial_restore_char(&env->x_comment_to, d, off, convert);
-}
-
 /**
  * serial_dump_tags - Pack a TagList into a binary blob
  * @param[in]     tl   TagList to pack
@@ -64,6 +64,57 @@
 
 const struct ExpandoRenderData IndexRenderData[];
 
+/// Memoized config handles - these are read for every rendered index row
+static struct ConfigMemo CryptCharsMemo  = CONFIG_MEMO_INIT("crypt_chars");
+static struct ConfigMemo DateFormatMemo  = CONFIG_MEMO_INIT("date_format");
+static struct ConfigMemo FlagCharsMemo   = CONFIG_MEMO_INIT("flag_chars");
+static struct ConfigMemo FromCharsMemo   = CONFIG_MEMO_INIT("from_chars");
+static struct ConfigMemo SaveAddressMemo = CONFIG_MEMO_INIT("save_address");
+static struct ConfigMemo ToCharsMemo     = CONFIG_MEMO_INIT("to_chars");
+
+/**
+ * struct FlagCharsCache - Resolved flag characters for the index
+ *
+ * The $flag_chars, $crypt_chars and $to_chars fragments, resolved through
+ * mbtable_get_nth_wchar() once per config generation instead of once per
+ * rendered row.  The strings belong to the config system and stay valid
+ * until the next config change, which also invalidates the cache.
+ */
+struct FlagCharsCache
+{
+  uint64_t generation;                    ///< Config generation of the cached strings
+  const char *flag[FLAG_CHAR_MAX];        ///< $flag_chars fragments
+  const char *crypt[FLAG_CHAR_CRYPT_MAX]; ///< $crypt_chars fragments
+  const char *to[FLAG_CHAR_TO_MAX];       ///< $to_chars fragments
+};
+
+/**
+ * flag_chars_get - Get the resolved flag-character table
+ * @retval ptr Cached table (do not free it)
+ */
+static const struct FlagCharsCache *flag_chars_get(void)
+{
+  static struct FlagCharsCache cache = { 0 };
+
+  const uint64_t generation = cs_generation();
+  if (cache.generation == generation)
+    return &cache;
+
+  const struct MbTable *c_flag_chars = (const struct MbTable *) cs_subset_memo_native_get(NeoMutt->sub, &FlagCharsMemo);
+  const struct MbTable *c_crypt_chars = (const struct MbTable *) cs_subset_memo_native_get(NeoMutt->sub, &CryptCharsMemo);
+  const struct MbTable *c_to_chars = (const struct MbTable *) cs_subset_memo_native_get(NeoMutt->sub, &ToCharsMemo);
+
+  for (int i = 0; i < FLAG_CHAR_MAX; i++)
+    cache.flag[i] = mbtable_get_nth_wchar(c_flag_chars, i);
+  for (int i = 0; i < FLAG_CHAR_CRYPT_MAX; i++)
+    cache.crypt[i] = mbtable_get_nth_wchar(c_crypt_chars, i);
+  for (int i = 0; i < FLAG_CHAR_TO_MAX; i++)
+    cache.to[i] = mbtable_get_nth_wchar(c_to_chars, i);
+
+  cache.generation = generation;
+  return &cache;
+}
+
 /**
  * struct HdrFormatInfo - Data passed to index_format_str()
  */
@@ -107,7 +158,7 @@ static const char *make_from_prefix(enum FieldType disp)
     [DISP_FROM] = "",  [DISP_PLAIN] = "",
   };
 
-  const struct MbTable *c_from_chars = cs_subset_mbtable(NeoMutt->sub, "from_chars");
+  const struct MbTable *c_from_chars = (const struct MbTable *) cs_subset_memo_native_get(NeoMutt->sub, &FromCharsMemo);
 
   if (!c_from_chars || !c_from_chars->chars || (c_from_chars->len == 0))
     return long_prefixes[disp];
@@ -381,6 +432,39 @@ static void index_email_date(const struct ExpandoNode *node, const struct Email
   buf_strcpy(buf, out);
 }
 
+/**
+ * index_email_date_cached - Render a date through the per-Email cache
+ *
+ * The '%d' and '%D' expandos format the same timestamp with the same
+ * $date_format for as long as the config stands still, yet every index
+ * redraw used to re-run strftime() per row.  Cache the rendered string on
+ * the Email and drop it whenever any config item changes.
+ */
+static void index_email_date_cached(const struct ExpandoNode *node, struct Email *e,
+                                    enum IndexDateChoice which, MuttFormatFlags flags,
+                                    struct Buffer *buf, const char *format)
+{
+  const uint64_t gen = cs_generation();
+  if (e->disp_date_gen != gen)
+  {
+    FREE(&e->disp_date);
+    FREE(&e->disp_date_local);
+    e->disp_date_gen = gen;
+  }
+
+  char **cache = (which == SENT_SENDER) ? &e->disp_date : &e->disp_date_local;
+  if (!*cache)
+  {
+    index_email_date(node, e, which, flags, buf, format, strlen(format));
+    *cache = mutt_str_dup(buf_string(buf));
+    return;
+  }
+
+  if (flags & MUTT_FORMAT_INDEX)
+    node_expando_set_color(node, MT_COLOR_INDEX_DATE);
+  buf_strcpy(buf, *cache);
+}
+
 /**
  * index_date_recv_local - Index: Received local date and time - Implements ExpandoRenderData::get_string() - @ingroup expando_get_string_api
  */
@@ -678,14 +762,14 @@ void index_d(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
              int max_cols, struct Buffer *buf)
 {
   const struct HdrFormatInfo *hfi = data;
-  const struct Email *e = hfi->email;
+  struct Email *e = hfi->email;
   if (!e)
     return;
 
-  const char *c_date_format = cs_subset_string(NeoMutt->sub, "date_format");
+  const char *c_date_format = (const char *) cs_subset_memo_native_get(NeoMutt->sub, &DateFormatMemo);
   const char *cp = NONULL(c_date_format);
 
-  index_email_date(node, e, SENT_SENDER, flags, buf, cp, strlen(cp));
+  index_email_date_cached(node, e, SENT_SENDER, flags, buf, cp);
 }
 
 /**
@@ -695,14 +779,14 @@ void index_D(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
              int max_cols, struct Buffer *buf)
 {
   const struct HdrFormatInfo *hfi = data;
-  const struct Email *e = hfi->email;
+  struct Email *e = hfi->email;
   if (!e)
     return;
 
-  const char *c_date_format = cs_subset_string(NeoMutt->sub, "date_format");
+  const char *c_date_format = (const char *) cs_subset_memo_native_get(NeoMutt->sub, &DateFormatMemo);
   const char *cp = NONULL(c_date_format);
 
-  index_email_date(node, e, SENT_LOCAL, flags, buf, cp, strlen(cp));
+  index_email_date_cached(node, e, SENT_LOCAL, flags, buf, cp);
 }
 
 /**
@@ -1113,7 +1197,7 @@ void index_O(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
   char *p = NULL;
 
   make_from_addr(e->env, tmp, sizeof(tmp), true);
-  const bool c_save_address = cs_subset_bool(NeoMutt->sub, "save_address");
+  const bool c_save_address = (bool) cs_subset_memo_native_get(NeoMutt->sub, &SaveAddressMemo);
   if (!c_save_address && (p = strpbrk(tmp, "%@")))
   {
     *p = '\0';
@@ -1213,26 +1297,26 @@ void index_S(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
   if (!e)
     return;
 
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
   const int msg_in_pager = hfi->msg_in_pager;
 
   const char *wch = NULL;
   if (e->deleted)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED);
+    wch = fc->flag[FLAG_CHAR_DELETED];
   else if (e->attach_del)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED_ATTACH);
+    wch = fc->flag[FLAG_CHAR_DELETED_ATTACH];
   else if (e->tagged)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_TAGGED);
+    wch = fc->flag[FLAG_CHAR_TAGGED];
   else if (e->flagged)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_IMPORTANT);
+    wch = fc->flag[FLAG_CHAR_IMPORTANT];
   else if (e->replied)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_REPLIED);
+    wch = fc->flag[FLAG_CHAR_REPLIED];
   else if (e->read && (msg_in_pager != e->msgno))
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_SEMPTY);
+    wch = fc->flag[FLAG_CHAR_SEMPTY];
   else if (e->old)
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_OLD);
+    wch = fc->flag[FLAG_CHAR_OLD];
   else
-    wch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_NEW);
+    wch = fc->flag[FLAG_CHAR_NEW];
 
   if (flags & MUTT_FORMAT_INDEX)
     node_expando_set_color(node, MT_COLOR_INDEX_FLAGS);
@@ -1283,14 +1367,9 @@ void index_T(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
   if (!e)
     return;
 
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
 
-  int i;
-  const char *s = (c_to_chars && ((i = user_is_recipient(e))) < c_to_chars->len) ?
-                      c_to_chars->chars[i] :
-                      " ";
-
-  buf_strcpy(buf, s);
+  buf_strcpy(buf, fc->to[user_is_recipient(e)]);
 }
 
 /**
@@ -1511,28 +1590,28 @@ void index_zc(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
   if (!e)
     return;
 
-  const struct MbTable *c_crypt_chars = cs_subset_mbtable(NeoMutt->sub, "crypt_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
 
   const char *ch = NULL;
   if ((WithCrypto != 0) && (e->security & SEC_GOODSIGN))
   {
-    ch = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_GOOD_SIGN);
+    ch = fc->crypt[FLAG_CHAR_CRYPT_GOOD_SIGN];
   }
   else if ((WithCrypto != 0) && (e->security & SEC_ENCRYPT))
   {
-    ch = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_ENCRYPTED);
+    ch = fc->crypt[FLAG_CHAR_CRYPT_ENCRYPTED];
   }
   else if ((WithCrypto != 0) && (e->security & SEC_SIGN))
   {
-    ch = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_SIGNED);
+    ch = fc->crypt[FLAG_CHAR_CRYPT_SIGNED];
   }
   else if (((WithCrypto & APPLICATION_PGP) != 0) && ((e->security & PGP_KEY) == PGP_KEY))
   {
-    ch = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_CONTAINS_KEY);
+    ch = fc->crypt[FLAG_CHAR_CRYPT_CONTAINS_KEY];
   }
   else
   {
-    ch = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_NO_CRYPTO);
+    ch = fc->crypt[FLAG_CHAR_CRYPT_NO_CRYPTO];
   }
 
   if (flags & MUTT_FORMAT_INDEX)
@@ -1552,46 +1631,46 @@ void index_zs(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
     return;
 
   const bool threads = mutt_using_threads();
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
   const int msg_in_pager = hfi->msg_in_pager;
 
   const char *ch = NULL;
   if (e->deleted)
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED);
+    ch = fc->flag[FLAG_CHAR_DELETED];
   }
   else if (e->attach_del)
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED_ATTACH);
+    ch = fc->flag[FLAG_CHAR_DELETED_ATTACH];
   }
   else if (threads && thread_is_new(e))
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_NEW_THREAD);
+    ch = fc->flag[FLAG_CHAR_NEW_THREAD];
   }
   else if (threads && thread_is_old(e))
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_OLD_THREAD);
+    ch = fc->flag[FLAG_CHAR_OLD_THREAD];
   }
   else if (e->read && (msg_in_pager != e->msgno))
   {
     if (e->replied)
     {
-      ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_REPLIED);
+      ch = fc->flag[FLAG_CHAR_REPLIED];
     }
     else
     {
-      ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_ZEMPTY);
+      ch = fc->flag[FLAG_CHAR_ZEMPTY];
     }
   }
   else
   {
     if (e->old)
     {
-      ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_OLD);
+      ch = fc->flag[FLAG_CHAR_OLD];
     }
     else
     {
-      ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_NEW);
+      ch = fc->flag[FLAG_CHAR_NEW];
     }
   }
 
@@ -1611,21 +1690,20 @@ void index_zt(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
   if (!e)
     return;
 
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
 
   const char *ch = NULL;
   if (e->tagged)
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_TAGGED);
+    ch = fc->flag[FLAG_CHAR_TAGGED];
   }
   else if (e->flagged)
   {
-    ch = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_IMPORTANT);
+    ch = fc->flag[FLAG_CHAR_IMPORTANT];
   }
   else
   {
-    ch = mbtable_get_nth_wchar(c_to_chars, user_is_recipient(e));
+    ch = fc->to[user_is_recipient(e)];
   }
 
   if (flags & MUTT_FORMAT_INDEX)
@@ -1646,68 +1724,66 @@ void index_Z(const struct ExpandoNode *node, void *data, MuttFormatFlags flags,
 
   const int msg_in_pager = hfi->msg_in_pager;
 
-  const struct MbTable *c_crypt_chars = cs_subset_mbtable(NeoMutt->sub, "crypt_chars");
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct FlagCharsCache *fc = flag_chars_get();
   const bool threads = mutt_using_threads();
 
   const char *first = NULL;
   if (threads && thread_is_new(e))
   {
-    first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_NEW_THREAD);
+    first = fc->flag[FLAG_CHAR_NEW_THREAD];
   }
   else if (threads && thread_is_old(e))
   {
-    first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_OLD_THREAD);
+    first = fc->flag[FLAG_CHAR_OLD_THREAD];
   }
   else if (e->read && (msg_in_pager != e->msgno))
   {
     if (e->replied)
     {
-      first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_REPLIED);
+      first = fc->flag[FLAG_CHAR_REPLIED];
     }
     else
     {
-      first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_ZEMPTY);
+      first = fc->flag[FLAG_CHAR_ZEMPTY];
     }
   }
   else
   {
     if (e->old)
     {
-      first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_OLD);
+      first = fc->flag[FLAG_CHAR_OLD];
     }
     else
     {
-      first = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_NEW);
+      first = fc->flag[FLAG_CHAR_NEW];
     }
   }
 
   /* Marked for deletion; deleted attachments; crypto */
   const char *second = NULL;
   if (e->deleted)
-    second = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED);
+    second = fc->flag[FLAG_CHAR_DELETED];
   else if (e->attach_del)
-    second = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_DELETED_ATTACH);
+    second = fc->flag[FLAG_CHAR_DELETED_ATTACH];
   else if ((WithCrypto != 0) && (e->security & SEC_GOODSIGN))
-    second = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_GOOD_SIGN);
+    second = fc->crypt[FLAG_CHAR_CRYPT_GOOD_SIGN];
   else if ((WithCrypto != 0) && (e->security & SEC_ENCRYPT))
-    second = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_ENCRYPTED);
+    second = fc->crypt[FLAG_CHAR_CRYPT_ENCRYPTED];
   else if ((WithCrypto != 0) && (e->security & SEC_SIGN))
-    second = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_SIGNED);
+    second = fc->crypt[FLAG_CHAR_CRYPT_SIGNED];
   else if (((WithCrypto & APPLICATION_PGP) != 0) && (e->security & PGP_KEY))
-    second = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_CONTAINS_KEY);
+    second = fc->crypt[FLAG_CHAR_CRYPT_CONTAINS_KEY];
   else
-    second = mbtable_get_nth_wchar(c_crypt_chars, FLAG_CHAR_CRYPT_NO_CRYPTO);
+    second = fc->crypt[FLAG_CHAR_CRYPT_NO_CRYPTO];
 
   /* Tagged, flagged and recipient flag */
   const char *third = NULL;
   if (e->tagged)
-    third = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_TAGGED);
+    third = fc->flag[FLAG_CHAR_TAGGED];
   else if (e->flagged)
-    third = mbtable_get_nth_wchar(c_flag_chars, FLAG_CHAR_IMPORTANT);
+    third = fc->flag[FLAG_CHAR_IMPORTANT];
   else
-    third = mbtable_get_nth_wchar(c_to_chars, user_is_recipient(e));
+    third = fc->to[user_is_recipient(e)];
 
   if (flags & MUTT_FORMAT_INDEX)
     node_expando_set_color(node, MT_COLOR_INDEX_FLAGS);
@@ -76,6 +76,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -84,6 +87,9 @@
 
 #define HC_FIRST HC_EXT_COMMAND
 
+/// Smallest history file worth compacting
+#define HIST_SHRINK_MIN 4096
+
 /**
  * struct History - Saved list of user-entered commands/searches
  *
@@ -103,6 +109,8 @@ static struct History Histories[HC_MAX];
 /// The previous number of history entries to save
 /// @sa $history
 static int OldSize = 0;
+/// Size of `$history_file` after the last compaction
+static off_t ShrunkSize = 0;
 
 /**
  * get_history - Get a particular history
@@ -201,14 +209,17 @@ static int dup_hash_inc(struct HashTable *dup_hash, char *str)
 
 /**
  * shrink_histfile - Read, de-dupe and write the history file
+ *
+ * The file is scanned through a private memory map, so lines can be
+ * NUL-terminated in place without touching the file.  A trailing partial line
+ * (another process caught mid-append) is left alone.
  */
 static void shrink_histfile(void)
 {
   FILE *fp_tmp = NULL;
   int n[HC_MAX] = { 0 };
   int line, hclass = 0, read = 0;
-  char *linebuf = NULL, *p = NULL;
-  size_t buflen;
+  char *p = NULL;
   bool regen_file = false;
   struct HashTable *dup_hashes[HC_MAX] = { 0 };
 
@@ -217,6 +228,23 @@ static void shrink_histfile(void)
   if (!fp)
     return;
 
+  struct stat st = { 0 };
+  if ((fstat(fileno(fp), &st) != 0) || (st.st_size == 0))
+  {
+    mutt_file_fclose(&fp);
+    return;
+  }
+
+  char *base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    fileno(fp), 0);
+  if (base == MAP_FAILED)
+  {
+    mutt_debug(LL_DEBUG1, "mmap: %s (errno %d)\n", strerror(errno), errno);
+    mutt_file_fclose(&fp);
+    return;
+  }
+  char *const end = base + st.st_size;
+
   const bool c_history_remove_dups = cs_subset_bool(NeoMutt->sub, "history_remove_dups");
   const short c_save_history = cs_subset_number(NeoMutt->sub, "save_history");
   if (c_history_remove_dups)
@@ -226,25 +254,35 @@ static void shrink_histfile(void)
   }
 
   line = 0;
-  while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
+  for (char *lbuf = base; lbuf < end; )
   {
-    if ((sscanf(linebuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
-        (*(p = linebuf + strlen(linebuf) - 1) != '|') || (hclass < 0))
+    char *nl = memchr(lbuf, '\n', end - lbuf);
+    if (!nl)
+      break;
+    *nl = '\0';
+    line++;
+
+    if ((sscanf(lbuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
+        (nl == lbuf) || (*(p = nl - 1) != '|') || (hclass < 0))
     {
       mutt_error(_("%s:%d: Bad history file format"), c_history_file, line);
       regen_file = true;
+      lbuf = nl + 1;
       continue;
     }
     /* silently ignore too high class (probably newer neomutt) */
     if (hclass >= HC_MAX)
-      continue;
-    *p = '\0';
-    if (c_history_remove_dups && (dup_hash_inc(dup_hashes[hclass], linebuf + read) > 1))
     {
-      regen_file = true;
+      lbuf = nl + 1;
       continue;
     }
-    n[hclass]++;
+    *p = '\0';
+    if (c_history_remove_dups && (dup_hash_inc(dup_hashes[hclass], lbuf + read) > 1))
+      regen_file = true;
+    else
+      n[hclass]++;
+    *p = '|';
+    lbuf = nl + 1;
   }
 
   if (!regen_file)
@@ -267,31 +305,39 @@ static void shrink_histfile(void)
       mutt_perror(_("Can't create temporary file"));
       goto cleanup;
     }
-    rewind(fp);
-    line = 0;
-    while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
+    for (char *lbuf = base; lbuf < end; )
     {
-      if ((sscanf(linebuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
-          (*(p = linebuf + strlen(linebuf) - 1) != '|') || (hclass < 0))
+      char *nl = memchr(lbuf, '\0', end - lbuf);
+      if (!nl)
+        break;
+
+      if ((sscanf(lbuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
+          (nl == lbuf) || (*(p = nl - 1) != '|') || (hclass < 0))
       {
+        lbuf = nl + 1;
         continue;
       }
       if (hclass >= HC_MAX)
+      {
+        lbuf = nl + 1;
         continue;
+      }
       *p = '\0';
-      if (c_history_remove_dups && (dup_hash_dec(dup_hashes[hclass], linebuf + read) > 0))
+      if (c_history_remove_dups && (dup_hash_dec(dup_hashes[hclass], lbuf + read) > 0))
       {
+        lbuf = nl + 1;
         continue;
       }
       *p = '|';
       if (n[hclass]-- <= c_save_history)
-        fprintf(fp_tmp, "%s\n", linebuf);
+        fprintf(fp_tmp, "%s\n", lbuf);
+      lbuf = nl + 1;
     }
   }
 
 cleanup:
+  munmap(base, st.st_size);
   mutt_file_fclose(&fp);
-  FREE(&linebuf);
   if (fp_tmp)
   {
     if (fflush(fp_tmp) == 0)
@@ -308,6 +354,7 @@ cleanup:
     }
     mutt_file_fclose(&fp_tmp);
   }
+  ShrunkSize = mutt_file_get_size(c_history_file);
   if (c_history_remove_dups)
     for (hclass = 0; hclass < HC_MAX; hclass++)
       mutt_hash_free(&dup_hashes[hclass]);
@@ -320,8 +367,6 @@ cleanup:
  */
 static void save_history(enum HistoryClass hclass, const char *str)
 {
-  static int n = 0;
-
   if (!str || (*str == '\0')) // This shouldn't happen, but it's safer
     return;
 
@@ -342,15 +387,17 @@ static void save_history(enum HistoryClass hclass, const char *str)
    * We add a '|' in order to avoid lines ending with '\'. */
   fprintf(fp, "%d:%s|\n", (int) hclass, tmp);
 
+  const off_t size = ftello(fp);
   mutt_file_fclose(&fp);
   FREE(&tmp);
 
-  if (--n < 0)
-  {
-    const short c_save_history = cs_subset_number(NeoMutt->sub, "save_history");
-    n = c_save_history;
+  /* Compact the file once it has roughly doubled since the last compaction.
+   * The work is proportional to the bytes appended since then, so the cost
+   * per save is amortised O(1), even with several processes appending. */
+  if (size > MAX(HIST_SHRINK_MIN, 2 * ShrunkSize))
     shrink_histfile();
-  }
+  else if (ShrunkSize == 0)
+    ShrunkSize = size;
 }
 
 /**
@@ -636,6 +683,9 @@ void mutt_hist_read_file(void)
 
   mutt_file_fclose(&fp);
   FREE(&linebuf);
+
+  /* A fresh baseline for save_history()'s compaction trigger */
+  ShrunkSize = mutt_file_get_size(c_history_file);
 }
 
 /**
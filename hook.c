@@ -72,6 +72,7 @@ struct Hook
   char *source_file;           ///< Used for relative-directory source
   struct PatternList *pattern; ///< Used for fcc,save,send-hook
   struct Expando *expando;     ///< Used for format hooks
+  bool deferred;               ///< Compile the regex/expando when the hook first fires
   TAILQ_ENTRY(Hook) entries;   ///< Linked list
 };
 TAILQ_HEAD(HookList, Hook);
@@ -85,6 +86,109 @@ static struct HashTable *IdxFmtHooks = NULL;
 /// The type of the hook currently being executed, e.g. #MUTT_SAVE_HOOK
 static HookFlags CurrentHookType = MUTT_HOOK_NO_FLAGS;
 
+/// Bumped whenever a Hook is added or removed, so callers can spot stale caches
+static unsigned int HooksGen = 1;
+
+/**
+ * struct CachedRegex - A compiled regex shared between Hooks
+ *
+ * Hook patterns repeat heavily, e.g. one folder-hook per account prefix,
+ * so identical (pattern, flags) pairs share one compiled program.
+ */
+struct CachedRegex
+{
+  regex_t rx;   ///< Compiled regex program
+  int refcount; ///< Number of Hooks sharing it
+};
+
+/// Compiled regexes shared between Hooks, keyed by flags and pattern
+static struct HashTable *RegexCache = NULL;
+
+/**
+ * cached_regex_free - Free a CachedRegex - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void cached_regex_free(int type, void *obj, intptr_t data)
+{
+  struct CachedRegex *cr = obj;
+  regfree(&cr->rx);
+  FREE(&cr);
+}
+
+/**
+ * hook_regex_flags - Get the REG_COMP flags for a Hook's regex
+ * @param type Hook type, see #HookFlags
+ * @retval num Flags, e.g. #REG_ICASE
+ */
+static int hook_regex_flags(HookFlags type)
+{
+  return (type & MUTT_CRYPT_HOOK) ? REG_ICASE : 0;
+}
+
+/**
+ * hook_regex_get - Get a shared compiled regex for a hook pattern
+ * @param pattern Pattern to compile
+ * @param flags   Flags for REG_COMP, e.g. #REG_ICASE
+ * @param err     Buffer for error messages
+ * @retval ptr  Compiled regex
+ * @retval NULL Pattern didn't compile, err holds the message
+ *
+ * The caller must give the regex back with hook_regex_release().
+ */
+static regex_t *hook_regex_get(const char *pattern, int flags, struct Buffer *err)
+{
+  if (!RegexCache)
+  {
+    RegexCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(RegexCache, cached_regex_free, 0);
+  }
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%d\x1f%s", flags, pattern);
+
+  struct CachedRegex *cr = mutt_hash_find(RegexCache, buf_string(key));
+  if (!cr)
+  {
+    cr = mutt_mem_calloc(1, sizeof(struct CachedRegex));
+    const int rc = REG_COMP(&cr->rx, pattern, flags);
+    if (rc != 0)
+    {
+      if (err)
+        regerror(rc, &cr->rx, err->data, err->dsize);
+      regfree(&cr->rx);
+      FREE(&cr);
+      buf_pool_release(&key);
+      return NULL;
+    }
+    mutt_hash_insert(RegexCache, buf_string(key), cr);
+  }
+
+  cr->refcount++;
+  buf_pool_release(&key);
+  return &cr->rx;
+}
+
+/**
+ * hook_regex_release - Give back a shared compiled regex
+ * @param pattern Pattern it was compiled from
+ * @param flags   Flags it was compiled with
+ *
+ * The regex is freed when its last user releases it.
+ */
+static void hook_regex_release(const char *pattern, int flags)
+{
+  if (!RegexCache)
+    return;
+
+  struct Buffer *key = buf_pool_get();
+  buf_printf(key, "%d\x1f%s", flags, pattern);
+
+  struct CachedRegex *cr = mutt_hash_find(RegexCache, buf_string(key));
+  if (cr && (--cr->refcount == 0))
+    mutt_hash_delete(RegexCache, buf_string(key), cr);
+
+  buf_pool_release(&key);
+}
+
 /**
  * hook_free - Free a Hook
  * @param ptr Hook to free
@@ -98,12 +202,13 @@ static void hook_free(struct Hook **ptr)
 
   FREE(&h->command);
   FREE(&h->source_file);
-  FREE(&h->regex.pattern);
   if (h->regex.regex)
   {
-    regfree(h->regex.regex);
-    FREE(&h->regex.regex);
+    // The compiled regex is shared, see RegexCache
+    hook_regex_release(h->regex.pattern, hook_regex_flags(h->type));
+    h->regex.regex = NULL;
   }
+  FREE(&h->regex.pattern);
   mutt_pattern_free(&h->pattern);
   expando_free(&h->expando);
   FREE(ptr);
@@ -118,6 +223,40 @@ static struct Hook *hook_new(void)
   return mutt_mem_calloc(1, sizeof(struct Hook));
 }
 
+/**
+ * hook_compile - Compile a Hook's deferred regex and expando
+ * @param hook Hook to compile
+ *
+ * With $lazy_hooks set, hook regexes and format strings aren't compiled while
+ * the config is read, but when the hook first fires.  A compilation failure
+ * is reported once; the broken hook then simply never matches.
+ */
+static void hook_compile(struct Hook *hook)
+{
+  if (!hook->deferred)
+    return;
+  hook->deferred = false;
+
+  if (!hook->regex.regex && !hook->pattern && hook->regex.pattern)
+  {
+    struct Buffer *err = buf_pool_get();
+    hook->regex.regex = hook_regex_get(hook->regex.pattern,
+                                       hook_regex_flags(hook->type), err);
+    if (!hook->regex.regex)
+      mutt_error("%s: %s", hook->regex.pattern, buf_string(err));
+    buf_pool_release(&err);
+  }
+
+  if (!hook->expando && (hook->type & (MUTT_MBOX_HOOK | MUTT_SAVE_HOOK | MUTT_FCC_HOOK)))
+  {
+    struct Buffer *err = buf_pool_get();
+    hook->expando = expando_parse(hook->command, IndexFormatDef, err);
+    if (!hook->expando && !buf_is_empty(err))
+      mutt_error("%s", buf_string(err));
+    buf_pool_release(&err);
+  }
+}
+
 /**
  * mutt_parse_charset_iconv_hook - Parse 'charset-hook' and 'iconv-hook' commands - Implements Command::parse() - @ingroup command_parse
  */
@@ -348,20 +487,23 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
   }
   else if (~data & MUTT_GLOBAL_HOOK) /* NOT a global hook */
   {
-    /* Hooks not allowing full patterns: Check syntax of regex */
-    rx = mutt_mem_calloc(1, sizeof(regex_t));
-    int rc2 = REG_COMP(rx, buf_string(pattern), ((data & MUTT_CRYPT_HOOK) ? REG_ICASE : 0));
-    if (rc2 != 0)
+    const bool c_lazy_hooks = cs_subset_bool(NeoMutt->sub, "lazy_hooks");
+    if (!c_lazy_hooks)
     {
-      regerror(rc2, rx, err->data, err->dsize);
-      FREE(&rx);
-      goto cleanup;
+      /* Hooks not allowing full patterns: Check syntax of regex */
+      rx = hook_regex_get(buf_string(pattern), hook_regex_flags(data), err);
+      if (!rx)
+        goto cleanup;
     }
   }
 
   struct Expando *exp = NULL;
   if (data & (MUTT_IDXFMTHOOK | MUTT_MBOX_HOOK | MUTT_SAVE_HOOK | MUTT_FCC_HOOK))
-    exp = expando_parse(buf_string(cmd), IndexFormatDef, err);
+  {
+    const bool c_lazy_hooks = cs_subset_bool(NeoMutt->sub, "lazy_hooks");
+    if (!c_lazy_hooks)
+      exp = expando_parse(buf_string(cmd), IndexFormatDef, err);
+  }
 
   hook = hook_new();
   hook->type = data;
@@ -372,8 +514,10 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
   hook->regex.regex = rx;
   hook->regex.pat_not = pat_not;
   hook->expando = exp;
+  hook->deferred = cs_subset_bool(NeoMutt->sub, "lazy_hooks");
 
   TAILQ_INSERT_TAIL(&Hooks, hook, entries);
+  HooksGen++;
   rc = MUTT_CMD_SUCCESS;
 
 cleanup:
@@ -399,8 +543,24 @@ void mutt_delete_hooks(HookFlags type)
     {
       TAILQ_REMOVE(&Hooks, h, entries);
       hook_free(&h);
+      HooksGen++;
     }
   }
+
+  if (type == MUTT_HOOK_NO_FLAGS)
+    mutt_hash_free(&RegexCache); // It will be recreated on demand
+}
+
+/**
+ * mutt_hooks_gen - Get the generation number of the Hooks list
+ * @retval num Generation number
+ *
+ * The number changes whenever a hook is added or removed.  Callers who cache
+ * hook results can compare generations to decide when to flush.
+ */
+unsigned int mutt_hooks_gen(void)
+{
+  return HooksGen;
 }
 
 /**
@@ -638,6 +798,8 @@ void mutt_folder_hook(const char *path, const char *desc)
     if (!(hook->type & MUTT_FOLDER_HOOK))
       continue;
 
+    hook_compile(hook);
+
     const char *match = NULL;
     if (mutt_regex_match(&hook->regex, path))
       match = path;
@@ -676,6 +838,7 @@ char *mutt_find_hook(HookFlags type, const char *pat)
   {
     if (tmp->type & type)
     {
+      hook_compile(tmp);
       if (mutt_regex_match(&tmp->regex, pat))
         return tmp->command;
     }
@@ -704,6 +867,7 @@ void mutt_message_hook(struct Mailbox *m, struct Email *e, HookFlags type)
 
     if (hook->type & type)
     {
+      hook_compile(hook);
       if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
           hook->regex.pat_not)
       {
@@ -748,6 +912,7 @@ static int addr_hook(struct Buffer *path, HookFlags type, struct Mailbox *m, str
 
     if (hook->type & type)
     {
+      hook_compile(hook);
       if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
           hook->regex.pat_not)
       {
@@ -853,10 +1018,12 @@ static void list_hook(struct ListHead *matches, const char *match, HookFlags typ
 
   TAILQ_FOREACH(tmp, &Hooks, entries)
   {
-    if ((tmp->type & type) && mutt_regex_match(&tmp->regex, match))
-    {
+    if (!(tmp->type & type))
+      continue;
+
+    hook_compile(tmp);
+    if (mutt_regex_match(&tmp->regex, match))
       mutt_list_insert_tail(matches, mutt_str_dup(tmp->command));
-    }
   }
 }
 
@@ -893,6 +1060,8 @@ void mutt_account_hook(const char *url)
     if (!(hook->command && (hook->type & MUTT_ACCOUNT_HOOK)))
       continue;
 
+    hook_compile(hook);
+
     if (mutt_regex_match(&hook->regex, url))
     {
       inhook = true;
@@ -64,6 +64,7 @@ void                  mutt_default_save            (struct Buffer *path, struct
 void                  mutt_delete_hooks            (HookFlags type);
 char *                mutt_find_hook               (HookFlags type, const char *pat);
 void                  mutt_folder_hook             (const char *path, const char *desc);
+unsigned int          mutt_hooks_gen               (void);
 const struct Expando *mutt_idxfmt_hook             (const char *name, struct Mailbox *m, struct Email *e);
 void                  mutt_message_hook            (struct Mailbox *m, struct Email *e, HookFlags type);
 enum CommandResult    mutt_parse_charset_iconv_hook(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
@@ -34,6 +34,7 @@
 #include "conn/lib.h"
 #include "adata.h"
 #include "lib.h"
+#include "mdata.h"
 
 /**
  * imap_timeout_observer - Notification that a timeout has occurred - Implements ::observer_t - @ingroup observer_api
@@ -53,12 +54,51 @@ static int imap_timeout_observer(struct NotifyCallback *nc)
   time_t now = mutt_date_now();
   const short c_imap_keep_alive = cs_subset_number(NeoMutt->sub, "imap_keep_alive");
 
+  /* With $imap_idle, keep the selected connection in IDLE between commands
+   * and collect the server's unsolicited EXISTS/EXPUNGE/FETCH responses on
+   * every tick.  Changes then show up on the next pass of the Index's event
+   * loop, instead of waiting for a $mail_check poll. */
+  const bool c_imap_idle = cs_subset_bool(NeoMutt->sub, "imap_idle");
+  struct Mailbox *m = adata->mailbox;
+  if (c_imap_idle && m && (adata->capabilities & IMAP_CAP_IDLE) &&
+      (adata->status != IMAP_FATAL))
+  {
+    // Only IDLE a quiet connection - nothing queued, nothing in flight
+    if ((adata->state == IMAP_SELECTED) && (adata->nextcmd == adata->lastcmd))
+      imap_cmd_idle(adata);
+
+    if (adata->state == IMAP_IDLE)
+    {
+      while (mutt_socket_poll(adata->conn, 0) > 0)
+      {
+        if (imap_cmd_step(adata) != IMAP_RES_CONTINUE)
+          break;
+      }
+
+      struct ImapMboxData *mdata = m->mdata;
+      if (mdata && ((mdata->reopen & (IMAP_NEWMAIL_PENDING | IMAP_EXPUNGE_PENDING)) ||
+                    (mdata->check_status != IMAP_OPEN_NO_FLAGS)))
+      {
+        m->last_checked = 0; // the next mx_mbox_check() will apply the changes
+      }
+    }
+  }
+
   if ((adata->state >= IMAP_AUTHENTICATED) && (now >= (adata->lastread + c_imap_keep_alive)))
   {
     mutt_debug(LL_DEBUG5, "imap_keep_alive\n");
     imap_check_mailbox(adata->mailbox, true);
   }
 
+  /* The polling connection has no selected mailbox, so a plain NOOP keeps it alive */
+  struct ImapAccountData *poll = adata->poll_adata;
+  if (poll && (poll->state >= IMAP_AUTHENTICATED) &&
+      (now >= (poll->lastread + c_imap_keep_alive)))
+  {
+    mutt_debug(LL_DEBUG5, "imap_keep_alive (poll connection)\n");
+    imap_exec(poll, "NOOP", IMAP_CMD_POLL);
+  }
+
   mutt_debug(LL_DEBUG5, "imap timeout done\n");
   return 0;
 }
@@ -75,7 +115,10 @@ void imap_adata_free(void **ptr)
 
   notify_observer_remove(NeoMutt->notify_timeout, imap_timeout_observer, adata);
 
+  imap_adata_free((void **) &adata->poll_adata);
+
   FREE(&adata->capstr);
+  FREE(&adata->auth_method);
   buf_dealloc(&adata->cmdbuf);
   FREE(&adata->buf);
   FREE(&adata->cmds);
@@ -53,6 +53,7 @@ struct ImapAccountData
    * it's just no fun to get the same information twice */
   char *capstr;              ///< Capability string from the server
   ImapCapFlags capabilities; ///< Capability flags
+  char *auth_method;         ///< Method that last authenticated successfully, tried first on reconnect
   unsigned char seqid;       ///< tag sequence prefix
   unsigned int seqno;        ///< tag sequence number, e.g. '{seqid}0001'
   time_t lastread;           ///< last time we read a command for the server
@@ -62,6 +63,8 @@ struct ImapAccountData
   bool unicode; ///< If true, we can send UTF-8, and the server will use UTF8 rather than mUTF7
   bool qresync; ///< true, if QRESYNC is successfully ENABLE'd
 
+  unsigned int fetch_chunk; ///< Adaptive headers-per-FETCH chunk size, from measured throughput
+
   // if set, the response parser will store results for complicated commands here
   struct ImapList *cmdresult;
 
@@ -76,6 +79,8 @@ struct ImapAccountData
   struct Mailbox *mailbox;      ///< Current selected mailbox
   struct Mailbox *prev_mailbox; ///< Previously selected mailbox
   struct Account *account;      ///< Parent Account
+
+  struct ImapAccountData *poll_adata; ///< Second connection for polling, so STATUS doesn't queue behind the selected mailbox
 };
 
 void                    imap_adata_free(void **ptr);
@@ -37,6 +37,7 @@
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "core/lib.h"
+#include "adata.h"
 #include "auth.h"
 
 /**
@@ -116,6 +117,28 @@ int imap_authenticate(struct ImapAccountData *adata)
 {
   int rc = IMAP_AUTH_FAILURE;
 
+  /* Try the method that worked last time before probing: a flaky connection
+   * means frequent reconnects, and probing is expensive (GSSAPI makes several
+   * round trips before giving up) */
+  if (adata->auth_method)
+  {
+    mutt_debug(LL_DEBUG2, "Trying cached method %s\n", adata->auth_method);
+
+    for (size_t i = 0; i < mutt_array_size(ImapAuthenticators); i++)
+    {
+      const struct ImapAuth *auth = &ImapAuthenticators[i];
+      if (!auth->method || mutt_istr_equal(auth->method, adata->auth_method))
+      {
+        rc = auth->authenticate(adata, adata->auth_method);
+        if (rc == IMAP_AUTH_SUCCESS)
+          return rc;
+      }
+    }
+
+    mutt_debug(LL_DEBUG2, "Cached method %s no longer works\n", adata->auth_method);
+    FREE(&adata->auth_method);
+  }
+
   const struct Slist *c_imap_authenticators = cs_subset_slist(NeoMutt->sub, "imap_authenticators");
   if (c_imap_authenticators && (c_imap_authenticators->count > 0))
   {
@@ -135,6 +158,7 @@ int imap_authenticate(struct ImapAccountData *adata)
           rc = auth->authenticate(adata, np->data);
           if (rc == IMAP_AUTH_SUCCESS)
           {
+            mutt_str_replace(&adata->auth_method, np->data);
             return rc;
           }
         }
@@ -150,7 +174,10 @@ int imap_authenticate(struct ImapAccountData *adata)
     {
       rc = ImapAuthenticators[i].authenticate(adata, NULL);
       if (rc == IMAP_AUTH_SUCCESS)
+      {
+        mutt_str_replace(&adata->auth_method, ImapAuthenticators[i].method);
         return rc;
+      }
     }
   }
 
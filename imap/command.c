@@ -87,6 +87,7 @@ static const char *const Capabilities[] = {
   "COMPRESS=DEFLATE",
   "X-GM-EXT-1",
   "ID",
+  "COMPRESS=ZSTD",
   NULL,
 };
 
@@ -282,16 +283,9 @@ static void cmd_parse_expunge(struct ImapAccountData *adata, const char *s)
     imap_edata_get(e)->msn = 0;
   }
 
-  /* decrement seqno of those above. */
-  const size_t max_msn = imap_msn_highest(&mdata->msn);
-  for (unsigned int cur = exp_msn; cur < max_msn; cur++)
-  {
-    e = imap_msn_get(&mdata->msn, cur);
-    if (e)
-      imap_edata_get(e)->msn--;
-    imap_msn_set(&mdata->msn, cur - 1, e);
-  }
-  imap_msn_shrink(&mdata->msn, 1);
+  /* Those above get their seqno decremented, but lazily: a storm of
+   * expunges would otherwise shift the whole table once per message */
+  imap_msn_expunge(&mdata->msn, exp_msn - 1);
 
   mdata->reopen |= IMAP_EXPUNGE_PENDING;
 }
@@ -338,6 +332,10 @@ static void cmd_parse_vanished(struct ImapAccountData *adata, char *s)
     return;
   }
 
+  /* The Emails' cached msns index the table below, so make sure any holes
+   * from earlier expunges have been compacted first */
+  imap_msn_flush(&mdata->msn);
+
   while ((rc = mutt_seqset_iterator_next(iter, &uid)) == 0)
   {
     struct Email *e = mutt_hash_int_find(mdata->uid_hash, uid);
@@ -352,33 +350,23 @@ static void cmd_parse_vanished(struct ImapAccountData *adata, char *s)
     e->index = INT_MAX;
     imap_edata_get(e)->msn = 0;
 
-    if ((exp_msn < 1) || (exp_msn > imap_msn_highest(&mdata->msn)))
+    /* The msns name physical slots here: nothing moves during the batch, as
+     * the seqno decrements of those above are deferred via imap_msn_punch() */
+    if ((exp_msn < 1) || (exp_msn > imap_msn_slots(&mdata->msn)))
     {
       mutt_debug(LL_DEBUG1, "VANISHED: msn for UID %u is incorrect\n", uid);
       continue;
     }
-    if (imap_msn_get(&mdata->msn, exp_msn - 1) != e)
+    if (imap_msn_peek(&mdata->msn, exp_msn - 1) != e)
     {
       mutt_debug(LL_DEBUG1, "VANISHED: msn_index for UID %u is incorrect\n", uid);
       continue;
     }
 
-    imap_msn_remove(&mdata->msn, exp_msn - 1);
-
-    if (!earlier)
-    {
-      /* decrement seqno of those above. */
-      const size_t max_msn = imap_msn_highest(&mdata->msn);
-      for (unsigned int cur = exp_msn; cur < max_msn; cur++)
-      {
-        e = imap_msn_get(&mdata->msn, cur);
-        if (e)
-          imap_edata_get(e)->msn--;
-        imap_msn_set(&mdata->msn, cur - 1, e);
-      }
-
-      imap_msn_shrink(&mdata->msn, 1);
-    }
+    if (earlier)
+      imap_msn_remove(&mdata->msn, exp_msn - 1);
+    else
+      imap_msn_punch(&mdata->msn, exp_msn - 1);
   }
 
   if (rc < 0)
@@ -530,9 +518,16 @@ static void cmd_parse_fetch(struct ImapAccountData *adata, char *s)
     {
       /* If server flags could conflict with NeoMutt's flags, reopen the mailbox. */
       if (e->changed)
+      {
         mdata->reopen |= IMAP_EXPUNGE_PENDING;
+      }
       else
+      {
         mdata->check_status |= IMAP_FLAGS_PENDING;
+        /* Keep the cached flags fresh, so the next open of this mailbox
+         * displays them correctly before the CHANGEDSINCE delta arrives. */
+        imap_msg_save_hcache(adata->mailbox, e);
+      }
     }
   }
 }
@@ -83,7 +83,7 @@ static struct ConfigDef ImapVars[] = {
     "(imap) Characters that denote separators in IMAP folders"
   },
   { "imap_fetch_chunk_size", DT_LONG|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
-    "(imap) Download headers in blocks of this size"
+    "(imap) Download headers in blocks of this size (0: size the blocks automatically)"
   },
   { "imap_headers", DT_STRING, 0, 0, NULL,
     "(imap) Additional email headers to download when getting index"
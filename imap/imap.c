@@ -526,6 +526,9 @@ int imap_delete_mailbox(struct Mailbox *m, char *path)
  */
 static void imap_logout(struct ImapAccountData *adata)
 {
+  if (adata->poll_adata)
+    imap_logout(adata->poll_adata);
+
   /* we set status here to let imap_handle_untagged know we _expect_ to
    * receive a bye response (so it doesn't freak out and close the conn) */
   if (adata->state == IMAP_DISCONNECTED)
@@ -653,6 +656,7 @@ void imap_notify_delete_email(struct Mailbox *m, struct Email *e)
   if (!mdata || !edata)
     return;
 
+  imap_msn_flush(&mdata->msn); // edata->msn may predate deferred expunges
   imap_msn_remove(&mdata->msn, edata->msn - 1);
   edata->msn = 0;
 }
@@ -677,6 +681,8 @@ void imap_expunge_mailbox(struct Mailbox *m, bool resort)
 
 #ifdef USE_HCACHE
   imap_hcache_open(adata, mdata, false);
+  unsigned int *uids = mutt_mem_calloc(m->msg_count + 1, sizeof(unsigned int));
+  size_t num_uids = 0;
 #endif
 
   for (int i = 0; i < m->msg_count; i++)
@@ -693,7 +699,7 @@ void imap_expunge_mailbox(struct Mailbox *m, bool resort)
 
       imap_cache_del(m, e);
 #ifdef USE_HCACHE
-      imap_hcache_del(mdata, imap_edata_get(e)->uid);
+      uids[num_uids++] = imap_edata_get(e)->uid;
 #endif
 
       mutt_hash_int_delete(mdata->uid_hash, imap_edata_get(e)->uid, e);
@@ -722,6 +728,8 @@ void imap_expunge_mailbox(struct Mailbox *m, bool resort)
   }
 
 #ifdef USE_HCACHE
+  imap_hcache_del_batch(mdata, uids, num_uids);
+  FREE(&uids);
   imap_hcache_close(mdata);
 #endif
 
@@ -1095,6 +1103,48 @@ enum MxStatus imap_check_mailbox(struct Mailbox *m, bool force)
   return check;
 }
 
+/**
+ * imap_poll_adata - Get a connection that's free to poll a Mailbox
+ * @param adata IMAP Account data
+ * @retval ptr Account data whose connection a STATUS won't queue on
+ *
+ * While a mailbox is selected, its connection is often busy (e.g. mid-FETCH)
+ * when the periodic mailbox check fires, so a STATUS for another folder would
+ * serialise behind it - and vice versa.  Lazily open a second connection to
+ * the server, dedicated to polling.  If it can't be established, fall back to
+ * the main connection and don't try again.
+ */
+static struct ImapAccountData *imap_poll_adata(struct ImapAccountData *adata)
+{
+  // Nothing is selected, so the main connection is free
+  if (!adata->mailbox)
+    return adata;
+
+  struct ImapAccountData *poll = adata->poll_adata;
+  if (!poll)
+  {
+    poll = imap_adata_new(adata->account);
+    poll->conn = mutt_conn_new(&adata->conn->account);
+    adata->poll_adata = poll;
+    if (!poll->conn)
+    {
+      poll->status = IMAP_FATAL;
+      return adata;
+    }
+  }
+
+  if (poll->status == IMAP_FATAL)
+    return adata;
+
+  if ((poll->state < IMAP_AUTHENTICATED) && (imap_login(poll) < 0))
+  {
+    poll->status = IMAP_FATAL;
+    return adata;
+  }
+
+  return poll;
+}
+
 /**
  * imap_status - Refresh the number of total and new messages
  * @param adata  IMAP Account data
@@ -1140,7 +1190,30 @@ static int imap_status(struct ImapAccountData *adata, struct ImapMboxData *mdata
   snprintf(cmd, sizeof(cmd), "STATUS %s (UIDNEXT %s UNSEEN RECENT MESSAGES)",
            mdata->munge_name, uidvalidity_flag);
 
-  int rc = imap_exec(adata, cmd, queue ? IMAP_CMD_QUEUE : IMAP_CMD_POLL);
+  struct ImapAccountData *poll = imap_poll_adata(adata);
+  if (poll != adata)
+  {
+    // Collect the replies to previously sent polls
+    while ((poll->status != IMAP_FATAL) && (mutt_socket_poll(poll->conn, 0) > 0))
+      imap_cmd_step(poll);
+
+    if (poll->status == IMAP_FATAL)
+      poll = adata; // The polling connection died; use the main one
+  }
+
+  int rc;
+  if ((poll != adata) && queue)
+  {
+    /* The polling connection has nothing else in flight, so send the STATUS
+     * now and pick up the response on a later pass */
+    rc = (imap_cmd_start(poll, cmd) < 0) ? IMAP_EXEC_FATAL : IMAP_EXEC_SUCCESS;
+    if (rc == IMAP_EXEC_FATAL)
+      poll->status = IMAP_FATAL;
+  }
+  else
+  {
+    rc = imap_exec(poll, cmd, queue ? IMAP_CMD_QUEUE : IMAP_CMD_POLL);
+  }
   if (rc != IMAP_EXEC_SUCCESS)
   {
     mutt_debug(LL_DEBUG1, "Error queueing command\n");
@@ -1530,6 +1603,8 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
 
 #ifdef USE_HCACHE
   imap_hcache_open(adata, mdata, true);
+  unsigned int *uids = mutt_mem_calloc(m->msg_count + 1, sizeof(unsigned int));
+  size_t num_uids = 0;
 #endif
 
   /* save messages with real (non-flag) changes */
@@ -1543,7 +1618,7 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
     {
       imap_cache_del(m, e);
 #ifdef USE_HCACHE
-      imap_hcache_del(mdata, imap_edata_get(e)->uid);
+      uids[num_uids++] = imap_edata_get(e)->uid;
 #endif
     }
 
@@ -1574,6 +1649,8 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   }
 
 #ifdef USE_HCACHE
+  imap_hcache_del_batch(mdata, uids, num_uids);
+  FREE(&uids);
   imap_hcache_close(mdata);
 #endif
 
@@ -1806,15 +1883,33 @@ int imap_login(struct ImapAccountData *adata)
     /* capabilities may have changed */
     imap_exec(adata, "CAPABILITY", IMAP_CMD_PASS);
 
+#if defined(USE_ZLIB) || defined(USE_ZSTD)
+    const bool c_imap_deflate = cs_subset_bool(NeoMutt->sub, "imap_deflate");
+    bool compressed = false;
+#endif
+#ifdef USE_ZSTD
+    /* prefer zstd where the server offers it; it's cheaper than DEFLATE */
+    if (!compressed && (adata->capabilities & IMAP_CAP_COMPRESS_ZSTD) && c_imap_deflate &&
+        (imap_exec(adata, "COMPRESS ZSTD", IMAP_CMD_PASS) == IMAP_EXEC_SUCCESS))
+    {
+      mutt_zstdstrm_wrap_conn(adata->conn);
+      compressed = true;
+    }
+#endif
 #ifdef USE_ZLIB
     /* RFC4978 */
-    const bool c_imap_deflate = cs_subset_bool(NeoMutt->sub, "imap_deflate");
-    if ((adata->capabilities & IMAP_CAP_COMPRESS) && c_imap_deflate &&
+    if (!compressed && (adata->capabilities & IMAP_CAP_COMPRESS) && c_imap_deflate &&
         (imap_exec(adata, "COMPRESS DEFLATE", IMAP_CMD_PASS) == IMAP_EXEC_SUCCESS))
+    {
+      mutt_zstrm_wrap_conn(adata->conn);
+      compressed = true;
+    }
+#endif
+#if defined(USE_ZLIB) || defined(USE_ZSTD)
+    if (compressed)
     {
       mutt_debug(LL_DEBUG2, "IMAP compression is enabled on connection to %s\n",
                  adata->conn->account.host);
-      mutt_zstrm_wrap_conn(adata->conn);
     }
 #endif
 
@@ -27,6 +27,7 @@
 #include <time.h>
 #include "private.h"
 #include "mutt/lib.h"
+#include "msn.h"
 
 struct Mailbox;
 struct ImapAccountData;
@@ -57,7 +58,7 @@ struct ImapMboxData
 
   // Cached data used only when the mailbox is opened
   struct HashTable *uid_hash;               ///< Hash Table: "uid" -> Email
-  ARRAY_HEAD(MSNArray, struct Email *) msn; ///< look up headers by (MSN-1)
+  struct MSNArray msn;                      ///< look up headers by (MSN-1)
   struct BodyCache *bcache;                 ///< Email body cache
 
   struct HeaderCache *hcache; ///< Email header cache
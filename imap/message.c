@@ -72,6 +72,15 @@
 
 struct BodyCache;
 
+/// Headers per FETCH chunk before the first throughput measurement
+#define IMAP_FETCH_CHUNK_INITIAL 256
+/// Smallest adaptive chunk - below this the per-command overhead dominates
+#define IMAP_FETCH_CHUNK_MIN 32
+/// Largest adaptive chunk - bounds the sequence set and the server's workload
+#define IMAP_FETCH_CHUNK_MAX 65536
+/// Aim for one pipelined batch of header FETCHes every two seconds
+#define IMAP_FETCH_TARGET_NS 2000000000ULL
+
 /**
  * imap_bcache_open - Open a message cache
  * @param m     Selected Imap Mailbox
@@ -568,6 +577,8 @@ static unsigned int imap_fetch_msn_seqset(struct Buffer *buf, struct ImapAccount
   const long c_imap_fetch_chunk_size = cs_subset_long(NeoMutt->sub, "imap_fetch_chunk_size");
   if (c_imap_fetch_chunk_size > 0)
     max_headers_per_fetch = c_imap_fetch_chunk_size;
+  else if (adata->fetch_chunk > 0)
+    max_headers_per_fetch = adata->fetch_chunk;
 
   if (!evalhc)
   {
@@ -625,6 +636,37 @@ static unsigned int imap_fetch_msn_seqset(struct Buffer *buf, struct ImapAccount
   return msn_count;
 }
 
+/**
+ * update_fetch_chunk - Adapt the header FETCH chunk size to the link speed
+ * @param adata   Imap Account data
+ * @param fetched Number of headers requested by the batch
+ * @param elapsed Wall-clock time the batch took, in nanoseconds
+ * @param bytes   Raw bytes read from the network during the batch
+ *
+ * Scale ImapAccountData::fetch_chunk so that the next batch takes about
+ * #IMAP_FETCH_TARGET_NS: long enough to amortise the round trip, short enough
+ * that a slow link can't run into server timeouts or hold up cancellation.
+ * Growth is capped at 4x per measurement so that one undersized sample on a
+ * fast LAN doesn't cause a huge overshoot.
+ *
+ * If the user has set $imap_fetch_chunk_size, that wins over the estimate in
+ * imap_fetch_msn_seqset(), but the measurements are still kept up to date.
+ */
+static void update_fetch_chunk(struct ImapAccountData *adata,
+                               unsigned int fetched, uint64_t elapsed, uint64_t bytes)
+{
+  if ((fetched == 0) || (elapsed == 0))
+    return;
+
+  uint64_t chunk = fetched * IMAP_FETCH_TARGET_NS / elapsed;
+  chunk = MIN(chunk, (uint64_t) adata->fetch_chunk * 4);
+  adata->fetch_chunk = CLAMP(chunk, IMAP_FETCH_CHUNK_MIN, IMAP_FETCH_CHUNK_MAX);
+
+  mutt_debug(LL_DEBUG2, "fetched %u headers (%llu bytes) in %.3fs, next chunk %u\n",
+             fetched, (unsigned long long) bytes, (double) elapsed / 1e9,
+             adata->fetch_chunk);
+}
+
 /**
  * set_changed_flag - Have the flags of an email changed
  * @param[in]  m              Mailbox
@@ -1018,6 +1060,7 @@ static int imap_verify_qresync(struct Mailbox *m)
   if (!adata || (adata->mailbox != m))
     return -1;
 
+  imap_msn_flush(&mdata->msn); // the Emails' msns are compared to the table
   const size_t max_msn = imap_msn_highest(&mdata->msn);
 
   unsigned int msn;
@@ -1175,17 +1218,45 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
    *   at the end of the loop makes the comparison unneeded, but to be
    *   cautious I'm keeping it.
    */
+  /* Pipeline the FETCH commands: keep several chunks in flight, so that
+   * parsing one response overlaps the network wait for the next.  The queue
+   * accommodates $imap_pipeline_depth commands; leave a little headroom so
+   * that queueing never forces an implicit flush. */
+  const int max_in_flight = MAX(1, adata->cmdslots - 2);
+
+  if (adata->fetch_chunk == 0)
+    adata->fetch_chunk = IMAP_FETCH_CHUNK_INITIAL;
+
   edata = imap_edata_new();
-  while ((fetch_msn_end < msn_end) &&
-         imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+  while (fetch_msn_end < msn_end)
   {
-    char *cmd = NULL;
-    mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
-                      buf_string(buf), hdrreq);
-    imap_cmd_start(adata, cmd);
-    FREE(&cmd);
+    int in_flight = 0;
+    const int msgno_begin = msn_begin;
+    unsigned int batch_count = 0;
+    unsigned int seq_count = 0;
+
+    const uint64_t batch_start = perf_clock();
+    const uint64_t bytes_before = perf_total(PERF_NET_READ);
+
+    while ((in_flight < max_in_flight) && (fetch_msn_end < msn_end) &&
+           ((seq_count = imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin,
+                                               msn_end, &fetch_msn_end)) != 0))
+    {
+      char *cmd = NULL;
+      mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
+                        buf_string(buf), hdrreq);
+      imap_cmd_start(adata, cmd);
+      FREE(&cmd);
+
+      msn_begin = fetch_msn_end + 1;
+      batch_count += seq_count;
+      in_flight++;
+    }
 
-    int msgno = msn_begin;
+    if (in_flight == 0)
+      break;
+
+    int msgno = msgno_begin;
 
     while (true)
     {
@@ -1288,6 +1359,9 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 #endif /* USE_HCACHE */
     }
 
+    update_fetch_chunk(adata, batch_count, perf_clock() - batch_start,
+                       perf_total(PERF_NET_READ) - bytes_before);
+
     /* In case we get new mail while fetching the headers. */
     if (mdata->reopen & IMAP_NEWMAIL_PENDING)
     {
@@ -1306,8 +1380,8 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
      *   msn_begin = mdata->max_msn + 1;
      * but with chunking and header cache holes this
      * may not be correct.  So here we must assume the msn values have
-     * not been altered during or after the fetch.  */
-    msn_begin = fetch_msn_end + 1;
+     * not been altered during or after the fetch.
+     * msn_begin was already advanced when the chunks were queued.  */
   }
 
   rc = 0;
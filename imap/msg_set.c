@@ -79,6 +79,11 @@ int imap_make_msg_set(struct UidArray *uida, struct Buffer *buf, int *pos)
   if ((array_size == 0) || (*pos >= array_size))
     return 0;
 
+  /* Size the Buffer for a full command up front.  The loop below stops just
+   * past ImapMaxCmdlen, so this one allocation covers all the appends and
+   * they never grow the Buffer in #BufferStepSize hops. */
+  buf_alloc(buf, buf_len(buf) + ImapMaxCmdlen + 64);
+
   int count = 1; // Number of UIDs added to the set
   size_t i = *pos;
   unsigned int start = *ARRAY_GET(uida, i);
@@ -25,6 +25,12 @@
  * @page imap_msn MSN helper functions
  *
  * IMAP MSN helper functions
+ *
+ * A burst of EXPUNGE responses from another client used to shift the whole
+ * table, and renumber every Email above the expunge point, once per message -
+ * quadratic work that could hang on a mass expunge.  Expunges now punch holes
+ * tracked by a Fenwick tree, see #MSNArray, and the table is compacted once,
+ * by imap_msn_flush(), when dense access is next needed.
  */
 
 #include "config.h"
@@ -33,9 +39,105 @@
 #include <stdlib.h>
 #include <string.h>
 #include "mutt/lib.h"
+#include "email/lib.h"
 #include "msn.h"
+#include "edata.h"
 #include "mdata.h" // IWYU pragma: keep
 
+/// Marks an expunged slot until imap_msn_flush() compacts the table
+static struct Email MsnExpunged;
+
+/**
+ * msn_tree_build - Build the Fenwick tree over the table's slots
+ * @param msn MSN structure
+ *
+ * Called when the first hole of a burst is punched, so every slot is live.
+ */
+static void msn_tree_build(struct MSNArray *msn)
+{
+  const size_t num = ARRAY_SIZE(&msn->arr);
+
+  msn->tree_size = num;
+  msn->tree = mutt_mem_calloc(num + 1, sizeof(size_t));
+  for (size_t i = 1; i <= num; i++)
+  {
+    msn->tree[i]++;
+    const size_t j = i + (i & (~i + 1));
+    if (j <= num)
+      msn->tree[j] += msn->tree[i];
+  }
+}
+
+/**
+ * msn_tree_select - Find the physical slot of a live entry
+ * @param msn  MSN structure
+ * @param rank Rank of the entry among the live slots, counting from 1
+ * @retval num Physical index of the slot
+ */
+static size_t msn_tree_select(const struct MSNArray *msn, size_t rank)
+{
+  size_t pos = 0;
+
+  size_t step = 1;
+  while ((step * 2) <= msn->tree_size)
+    step *= 2;
+
+  for (; step > 0; step /= 2)
+  {
+    if (((pos + step) <= msn->tree_size) && (msn->tree[pos + step] < rank))
+    {
+      pos += step;
+      rank -= msn->tree[pos];
+    }
+  }
+
+  return pos;
+}
+
+/**
+ * msn_tree_punch - Mark a physical slot as expunged in the tree
+ * @param msn MSN structure
+ * @param pos Physical index of the slot
+ */
+static void msn_tree_punch(struct MSNArray *msn, size_t pos)
+{
+  for (size_t i = pos + 1; i <= msn->tree_size; i += (i & (~i + 1)))
+    msn->tree[i]--;
+}
+
+/**
+ * imap_msn_flush - Compact the holes left by expunges
+ * @param msn MSN structure
+ *
+ * The live entries are slid down over the holes in one pass and their Emails'
+ * cached MSNs renumbered - the work the per-expunge shifting used to do once
+ * per EXPUNGE.
+ */
+void imap_msn_flush(struct MSNArray *msn)
+{
+  if (msn->holes == 0)
+    return;
+
+  size_t pos = 0;
+  struct Email **ep = NULL;
+  ARRAY_FOREACH(ep, &msn->arr)
+  {
+    struct Email *e = *ep;
+    if (e == &MsnExpunged)
+      continue;
+
+    if (e)
+      imap_edata_get(e)->msn = pos + 1;
+    ARRAY_SET(&msn->arr, pos, e);
+    pos++;
+  }
+
+  ARRAY_SHRINK(&msn->arr, msn->holes);
+  msn->holes = 0;
+  FREE(&msn->tree);
+  msn->tree_size = 0;
+}
+
 /**
  * imap_msn_reserve - Create / reallocate the cache
  * @param msn MSN structure
@@ -52,7 +154,8 @@ void imap_msn_reserve(struct MSNArray *msn, size_t num)
     mutt_exit(1);
   }
 
-  ARRAY_RESERVE(msn, num);
+  imap_msn_flush(msn);
+  ARRAY_RESERVE(&msn->arr, num);
 }
 
 /**
@@ -61,7 +164,10 @@ void imap_msn_reserve(struct MSNArray *msn, size_t num)
  */
 void imap_msn_free(struct MSNArray *msn)
 {
-  ARRAY_FREE(msn);
+  ARRAY_FREE(&msn->arr);
+  FREE(&msn->tree);
+  msn->tree_size = 0;
+  msn->holes = 0;
 }
 
 /**
@@ -71,7 +177,17 @@ void imap_msn_free(struct MSNArray *msn)
  */
 size_t imap_msn_highest(const struct MSNArray *msn)
 {
-  return ARRAY_SIZE(msn);
+  return ARRAY_SIZE(&msn->arr) - msn->holes;
+}
+
+/**
+ * imap_msn_slots - Return the number of physical slots in the table
+ * @param msn MSN structure
+ * @retval num Number of slots, including holes awaiting compaction
+ */
+size_t imap_msn_slots(const struct MSNArray *msn)
+{
+  return ARRAY_SIZE(&msn->arr);
 }
 
 /**
@@ -79,11 +195,35 @@ size_t imap_msn_highest(const struct MSNArray *msn)
  * @param msn MSN structure
  * @param idx Index to retrieve
  * @retval ptr Pointer to Email or NULL
+ *
+ * While holes exist, the index is mapped onto the physical slots through the
+ * Fenwick tree, so the server's renumbered MSNs stay correct mid-burst.
  */
 struct Email *imap_msn_get(const struct MSNArray *msn, size_t idx)
 {
-  struct Email **ep = ARRAY_GET(msn, idx);
-  return ep ? *ep : NULL;
+  if (msn->holes != 0)
+  {
+    if (idx >= imap_msn_highest(msn))
+      return NULL;
+    idx = msn_tree_select(msn, idx + 1);
+  }
+
+  struct Email **ep = ARRAY_GET(&msn->arr, idx);
+  return (ep && (*ep != &MsnExpunged)) ? *ep : NULL;
+}
+
+/**
+ * imap_msn_peek - Return the Email in a physical slot
+ * @param msn MSN structure
+ * @param idx Physical index of the slot
+ * @retval ptr Pointer to Email or NULL
+ *
+ * Unlike imap_msn_get(), the index isn't remapped around the holes.
+ */
+struct Email *imap_msn_peek(const struct MSNArray *msn, size_t idx)
+{
+  struct Email **ep = ARRAY_GET(&msn->arr, idx);
+  return (ep && (*ep != &MsnExpunged)) ? *ep : NULL;
 }
 
 /**
@@ -94,7 +234,8 @@ struct Email *imap_msn_get(const struct MSNArray *msn, size_t idx)
  */
 void imap_msn_set(struct MSNArray *msn, size_t idx, struct Email *e)
 {
-  ARRAY_SET(msn, idx, e);
+  imap_msn_flush(msn);
+  ARRAY_SET(&msn->arr, idx, e);
 }
 
 /**
@@ -105,17 +246,66 @@ void imap_msn_set(struct MSNArray *msn, size_t idx, struct Email *e)
  */
 size_t imap_msn_shrink(struct MSNArray *msn, size_t num)
 {
-  return ARRAY_SHRINK(msn, num);
+  imap_msn_flush(msn);
+  return ARRAY_SHRINK(&msn->arr, num);
 }
 
 /**
  * imap_msn_remove - Remove an entry from the cache
  * @param msn MSN structure
  * @param idx Index to invalidate
+ *
+ * The slot is emptied but keeps its place - the MSNs above don't change.
  */
 void imap_msn_remove(struct MSNArray *msn, size_t idx)
 {
-  struct Email **ep = ARRAY_GET(msn, idx);
+  imap_msn_flush(msn);
+  struct Email **ep = ARRAY_GET(&msn->arr, idx);
   if (ep)
     *ep = NULL;
 }
+
+/**
+ * imap_msn_expunge - Remove an entry and renumber those above, lazily
+ * @param msn MSN structure
+ * @param idx Index to expunge, in the server's current numbering
+ *
+ * The slot becomes a hole; sliding the tail down and renumbering the Emails
+ * is deferred to imap_msn_flush(), so a storm of expunges costs O(log n)
+ * each instead of O(n).
+ */
+void imap_msn_expunge(struct MSNArray *msn, size_t idx)
+{
+  if (idx >= imap_msn_highest(msn))
+    return;
+
+  if (msn->holes == 0)
+    msn_tree_build(msn);
+
+  const size_t pos = msn_tree_select(msn, idx + 1);
+  msn_tree_punch(msn, pos);
+  ARRAY_SET(&msn->arr, pos, &MsnExpunged);
+  msn->holes++;
+}
+
+/**
+ * imap_msn_punch - Remove an entry by its physical slot, renumbering lazily
+ * @param msn MSN structure
+ * @param idx Physical index of the slot
+ *
+ * Like imap_msn_expunge(), but for callers working from an Email's cached
+ * MSN during a deferred burst, where the slot positions haven't moved.
+ */
+void imap_msn_punch(struct MSNArray *msn, size_t idx)
+{
+  struct Email **ep = ARRAY_GET(&msn->arr, idx);
+  if (!ep || (*ep == &MsnExpunged))
+    return;
+
+  if (msn->holes == 0)
+    msn_tree_build(msn);
+
+  msn_tree_punch(msn, idx);
+  *ep = &MsnExpunged;
+  msn->holes++;
+}
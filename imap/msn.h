@@ -25,16 +25,38 @@
 #define MUTT_IMAP_MSN_H
 
 #include <stdlib.h>
+#include "mutt/lib.h"
 
-struct MSNArray;
 struct Email;
 
+/**
+ * struct MSNArray - Map MSNs to their Emails
+ *
+ * The table is a dense array indexed by (MSN-1).  Expunges punch holes in it
+ * instead of shifting the tail: a Fenwick tree of live-slot counts, built on
+ * the first expunge of a burst, maps the server's (renumbered) MSNs onto the
+ * physical slots in O(log n).  The holes are compacted, and the Emails'
+ * cached MSNs renumbered, in one pass by imap_msn_flush().
+ */
+struct MSNArray
+{
+  ARRAY_HEAD(MsnSlotArray, struct Email *) arr; ///< Email of each MSN slot
+  size_t *tree;     ///< Fenwick tree of live-slot counts, only while holes exist
+  size_t tree_size; ///< Number of slots covered by MSNArray::tree
+  size_t holes;     ///< Punched slots awaiting compaction
+};
+
+void          imap_msn_expunge(struct MSNArray *msn, size_t idx);
+void          imap_msn_flush  (struct MSNArray *msn);
 void          imap_msn_free   (struct MSNArray *msn);
 struct Email *imap_msn_get    (const struct MSNArray *msn, size_t idx);
 size_t        imap_msn_highest(const struct MSNArray *msn);
+struct Email *imap_msn_peek   (const struct MSNArray *msn, size_t idx);
+void          imap_msn_punch  (struct MSNArray *msn, size_t idx);
 void          imap_msn_remove (struct MSNArray *msn, size_t idx);
 void          imap_msn_reserve(struct MSNArray *msn, size_t num);
 void          imap_msn_set    (struct MSNArray *msn, size_t idx, struct Email *e);
 size_t        imap_msn_shrink (struct MSNArray *msn, size_t num);
+size_t        imap_msn_slots  (const struct MSNArray *msn);
 
 #endif /* MUTT_IMAP_MSN_H */
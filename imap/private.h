@@ -139,8 +139,9 @@ typedef uint32_t ImapCapFlags;              ///< Flags, e.g. #IMAP_CAP_IMAP4
 #define IMAP_CAP_COMPRESS         (1 << 18) ///< RFC4978: COMPRESS=DEFLATE
 #define IMAP_CAP_X_GM_EXT_1       (1 << 19) ///< https://developers.google.com/gmail/imap/imap-extensions
 #define IMAP_CAP_ID               (1 << 20) ///< RFC2971: IMAP4 ID extension
+#define IMAP_CAP_COMPRESS_ZSTD    (1 << 21) ///< COMPRESS=ZSTD, non-standard extension
 
-#define IMAP_CAP_ALL             ((1 << 21) - 1)
+#define IMAP_CAP_ALL             ((1 << 22) - 1)
 
 /**
  * struct ImapList - Items in an IMAP browser
@@ -221,6 +222,7 @@ void imap_hcache_close(struct ImapMboxData *mdata);
 struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid);
 int imap_hcache_put(struct ImapMboxData *mdata, struct Email *e);
 int imap_hcache_del(struct ImapMboxData *mdata, unsigned int uid);
+int imap_hcache_del_batch(struct ImapMboxData *mdata, const unsigned int *uids, size_t count);
 int imap_hcache_store_uid_seqset(struct ImapMboxData *mdata);
 int imap_hcache_clear_uid_seqset(struct ImapMboxData *mdata);
 char *imap_hcache_get_uid_seqset(struct ImapMboxData *mdata);
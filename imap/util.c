@@ -329,7 +329,11 @@ void imap_hcache_open(struct ImapAccountData *adata, struct ImapMboxData *mdata,
   url_tobuffer(&url, cachepath, U_PATH);
 
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
-  hc = hcache_open(c_header_cache, buf_string(cachepath), imap_hcache_namer, create);
+  const bool read_only = adata->mailbox && adata->mailbox->readonly;
+  hc = hcache_open(c_header_cache, buf_string(cachepath), imap_hcache_namer, create, read_only);
+
+  // Batch all the stores into a single transaction, where the backend allows
+  hcache_txn_begin(hc);
 
 cleanup:
   buf_pool_release(&mbox);
@@ -346,6 +350,7 @@ void imap_hcache_close(struct ImapMboxData *mdata)
   if (!mdata->hcache)
     return;
 
+  hcache_txn_commit(mdata->hcache);
   hcache_close(&mdata->hcache);
 }
 
@@ -410,6 +415,43 @@ int imap_hcache_del(struct ImapMboxData *mdata, unsigned int uid)
   return hcache_delete_email(mdata->hcache, key, mutt_str_len(key));
 }
 
+/**
+ * imap_hcache_del_batch - Delete a set of items from the header cache
+ * @param mdata Imap Mailbox data
+ * @param uids  Array of UIDs of entries to delete
+ * @param count Number of UIDs
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * The records are removed in one write batch, so an expunge of thousands of
+ * messages doesn't pay for one store transaction each.
+ */
+int imap_hcache_del_batch(struct ImapMboxData *mdata, const unsigned int *uids, size_t count)
+{
+  if (!mdata->hcache)
+    return -1;
+  if (count == 0)
+    return 0;
+
+  char(*keys)[16] = mutt_mem_calloc(count, sizeof(*keys));
+  const char **kptrs = mutt_mem_calloc(count, sizeof(const char *));
+  size_t *klens = mutt_mem_calloc(count, sizeof(size_t));
+
+  for (size_t i = 0; i < count; i++)
+  {
+    klens[i] = snprintf(keys[i], sizeof(keys[i]), "%u", uids[i]);
+    kptrs[i] = keys[i];
+  }
+
+  int rc = hcache_delete_batch(mdata->hcache, kptrs, klens, count);
+
+  FREE(&keys);
+  FREE(&kptrs);
+  FREE(&klens);
+
+  return rc;
+}
+
 /**
  * imap_hcache_store_uid_seqset - Store a UID Sequence Set in the header cache
  * @param mdata Imap Mailbox data
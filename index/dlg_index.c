@@ -77,12 +77,15 @@
 #include "pager/lib.h"
 #include "pattern/lib.h"
 #include "sidebar/lib.h"
+#include "backsync.h"
 #include "functions.h"
 #include "globals.h"
 #include "hdrline.h"
 #include "hook.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
+#include "prefetch.h"
+#include "session.h"
 #include "mutt_thread.h"
 #include "mview.h"
 #include "mx.h"
@@ -197,17 +200,8 @@ void collapse_all(struct MailboxView *mv, struct Menu *menu, int toggle)
   /* Restore the cursor */
   mutt_set_vnum(mv->mailbox);
   menu->max = mv->mailbox->vcount;
-  for (int i = 0; i < mv->mailbox->vcount; i++)
-  {
-    struct Email *e = mutt_get_virt_email(mv->mailbox, i);
-    if (!e)
-      break;
-    if (e->index == base->index)
-    {
-      menu_set_index(menu, i);
-      break;
-    }
-  }
+  if (base->vnum >= 0)
+    menu_set_index(menu, base->vnum);
 
   menu_queue_redraw(menu, MENU_REDRAW_INDEX);
 }
@@ -379,18 +373,9 @@ void resort_index(struct MailboxView *mv, struct Menu *menu)
   int new_index = -1;
   mutt_sort_headers(mv, false);
 
-  /* Restore the current message */
-  for (int i = 0; i < m->vcount; i++)
-  {
-    struct Email *e = mutt_get_virt_email(m, i);
-    if (!e)
-      continue;
-    if (e == e_cur)
-    {
-      new_index = i;
-      break;
-    }
-  }
+  /* Restore the current message: sorting has renumbered Email.vnum */
+  if (e_cur && (e_cur->vnum >= 0))
+    new_index = e_cur->vnum;
 
   if (mutt_using_threads() && (old_index < 0))
     new_index = mutt_parent_message(e_cur, false);
@@ -557,16 +542,28 @@ void update_index(struct Menu *menu, struct MailboxView *mv, enum MxStatus check
   int index = -1;
   if (oldcount)
   {
-    /* restore the current message to the message it was pointing to */
-    for (int i = 0; i < m->vcount; i++)
+    /* Unless the mailbox was reopened, the selected Email still exists and
+     * the sort has already renumbered it */
+    if (check != MX_STATUS_REOPENED)
     {
-      struct Email *e = mutt_get_virt_email(m, i);
-      if (!e)
-        continue;
-      if (index_shared_data_is_cur_email(shared, e))
+      struct Email *e = shared->email;
+      if (e && index_shared_data_is_cur_email(shared, e) && (e->vnum >= 0))
+        index = e->vnum;
+    }
+
+    if (index < 0)
+    {
+      /* restore the current message to the message it was pointing to */
+      for (int i = 0; i < m->vcount; i++)
       {
-        index = i;
-        break;
+        struct Email *e = mutt_get_virt_email(m, i);
+        if (!e)
+          continue;
+        if (index_shared_data_is_cur_email(shared, e))
+        {
+          index = i;
+          break;
+        }
       }
     }
   }
@@ -601,6 +598,153 @@ static int index_mailbox_observer(struct NotifyCallback *nc)
   return 0;
 }
 
+/**
+ * struct FolderCacheEntry - A parked Mailbox view
+ *
+ * With `$folder_cache_count` set, leaving a folder doesn't close it.  The
+ * Mailbox stays open and its view - sort order, threads, limit, cursor - is
+ * parked here, so switching back needs no re-parse, re-sort or re-thread.
+ */
+struct FolderCacheEntry
+{
+  struct Mailbox *mailbox;   ///< Mailbox, still open
+  struct MailboxView *mview; ///< Its view: sort, threads, limit
+  int menu_index;            ///< Cursor position
+  uint64_t last_used;        ///< Park time, for LRU eviction
+};
+
+/// Hard upper limit on `$folder_cache_count`
+#define FOLDER_CACHE_MAX 8
+
+/// Parked views of recently-left folders
+static struct FolderCacheEntry FolderCache[FOLDER_CACHE_MAX];
+
+/**
+ * folder_cache_release - Close a parked folder
+ * @param fce Entry to close
+ * @retval true The folder was closed and the slot emptied
+ *
+ * The close can fail, e.g. new mail arrived while the folder was parked.
+ * In that case the entry is left in the cache.
+ */
+static bool folder_cache_release(struct FolderCacheEntry *fce)
+{
+  struct Mailbox *m = fce->mailbox;
+
+  session_state_save(fce->mview, mutt_get_virt_email(m, fce->menu_index));
+  if (mx_mbox_close(m) != MX_STATUS_OK)
+    return false;
+
+  mview_free(&fce->mview);
+  mailbox_free(&fce->mailbox);
+  memset(fce, 0, sizeof(*fce));
+  return true;
+}
+
+/**
+ * folder_cache_flush - Close all the parked folders
+ *
+ * Call this before quitting, or before logging out of the servers the parked
+ * folders live on.  If a folder can't be closed cleanly, its view is dropped;
+ * the Mailbox is released at shutdown.
+ */
+void folder_cache_flush(void)
+{
+  for (int i = 0; i < FOLDER_CACHE_MAX; i++)
+  {
+    struct FolderCacheEntry *fce = &FolderCache[i];
+    if (!fce->mailbox)
+      continue;
+
+    if (!folder_cache_release(fce))
+    {
+      mutt_debug(LL_DEBUG1, "couldn't close parked folder %s\n",
+                 mailbox_path(fce->mailbox));
+      mview_free(&fce->mview);
+      mailbox_free(&fce->mailbox);
+      memset(fce, 0, sizeof(*fce));
+    }
+  }
+}
+
+/**
+ * folder_cache_find - Find the parked view of a Mailbox
+ * @param m Mailbox to look for
+ * @retval ptr  Matching entry
+ * @retval NULL Mailbox isn't parked
+ */
+static struct FolderCacheEntry *folder_cache_find(const struct Mailbox *m)
+{
+  if (!m)
+    return NULL;
+
+  for (int i = 0; i < FOLDER_CACHE_MAX; i++)
+  {
+    if (FolderCache[i].mailbox &&
+        mutt_str_equal(FolderCache[i].mailbox->realpath, m->realpath))
+    {
+      return &FolderCache[i];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * folder_cache_stash - Try to park the current folder instead of closing it
+ * @param shared Shared Index data
+ * @param menu   Current Menu
+ * @retval true The folder was parked; the caller must not close it
+ */
+static bool folder_cache_stash(struct IndexSharedData *shared, struct Menu *menu)
+{
+  const short c_folder_cache_count = cs_subset_number(shared->sub, "folder_cache_count");
+  struct Mailbox *m = shared->mailbox;
+  if ((c_folder_cache_count < 1) || !m || !shared->mailbox_view)
+    return false;
+
+  /* Only local directory-based backends can be parked safely: mbox holds file
+   * locks, and a parked IMAP folder would lose its SELECTed state as soon as
+   * another folder is opened on the same connection. */
+  if ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH) && (m->type != MUTT_NOTMUCH))
+    return false;
+
+  const int max = MIN(c_folder_cache_count, FOLDER_CACHE_MAX);
+
+  // Find a free slot, or make one by evicting the least recently used
+  struct FolderCacheEntry *slot = NULL;
+  struct FolderCacheEntry *lru = NULL;
+  int used = 0;
+  for (int i = 0; i < FOLDER_CACHE_MAX; i++)
+  {
+    struct FolderCacheEntry *fce = &FolderCache[i];
+    if (!fce->mailbox)
+    {
+      if (!slot)
+        slot = fce;
+      continue;
+    }
+    used++;
+    if (!lru || (fce->last_used < lru->last_used))
+      lru = fce;
+  }
+
+  if (used >= max)
+  {
+    if (!lru || !folder_cache_release(lru))
+      return false; // Can't evict; let the caller close normally
+    slot = lru;
+  }
+  if (!slot)
+    return false;
+
+  slot->mailbox = m;
+  slot->mview = shared->mailbox_view;
+  slot->menu_index = menu_get_index(menu);
+  slot->last_used = mutt_date_now_ms();
+  return true;
+}
+
 /**
  * change_folder_mailbox - Change to a different Mailbox by pointer
  * @param menu      Current Menu
@@ -622,7 +766,20 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
     mailbox_free(&shared->mailbox);
   }
 
-  if (shared->mailbox)
+  if (shared->mailbox && (shared->mailbox != m) &&
+      !mutt_str_equal(shared->mailbox->realpath, m->realpath) &&
+      folder_cache_stash(shared, menu))
+  {
+    // The old folder is parked in the FolderCache instead of being closed
+#ifdef USE_INOTIFY
+    mutt_monitor_remove(NULL);
+#endif
+    FREE(&LastFolder);
+    LastFolder = mutt_str_dup(mailbox_path(shared->mailbox));
+    *oldcount = 0;
+    index_shared_data_set_mview(shared, NULL);
+  }
+  else if (shared->mailbox)
   {
     char *new_last_folder = NULL;
 #ifdef USE_INOTIFY
@@ -634,6 +791,7 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
       new_last_folder = mutt_str_dup(mailbox_path(shared->mailbox));
     *oldcount = shared->mailbox->msg_count;
 
+    session_state_save(shared->mailbox_view, shared->email);
     const enum MxStatus check = mx_mbox_close(shared->mailbox);
     if (check == MX_STATUS_OK)
     {
@@ -690,7 +848,34 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
     return;
 
   const OpenMailboxFlags flags = read_only ? MUTT_READONLY : MUTT_OPEN_NO_FLAGS;
-  if (mx_mbox_open(m, flags))
+  bool adopted = false;
+  struct FolderCacheEntry *fce = folder_cache_find(m);
+  if (fce && (!read_only || fce->mailbox->readonly))
+  {
+    // Wake the parked view -- sort, threads, limit and cursor all survive
+    struct Mailbox *m_parked = fce->mailbox;
+    struct MailboxView *mv = fce->mview;
+    const int menu_index = fce->menu_index;
+    memset(fce, 0, sizeof(*fce));
+
+    if (m != m_parked)
+      mailbox_free(&m);
+
+    index_shared_data_set_mview(shared, mv);
+    menu->max = m_parked->vcount;
+    menu_set_index(menu, menu_index);
+    adopted = true;
+
+    // Pick up anything that arrived while the view was parked
+    const int oc = m_parked->msg_count;
+    enum MxStatus check = mx_mbox_check(m_parked);
+    if ((check == MX_STATUS_NEW_MAIL) || (check == MX_STATUS_REOPENED))
+      update_index(menu, shared->mailbox_view, check, oc, shared);
+#ifdef USE_INOTIFY
+    mutt_monitor_add(NULL);
+#endif
+  }
+  else if (mx_mbox_open(m, flags))
   {
     struct MailboxView *mv = mview_new(m, NeoMutt->notify);
     index_shared_data_set_mview(shared, mv);
@@ -708,9 +893,12 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
   }
 
   const bool c_collapse_all = cs_subset_bool(shared->sub, "collapse_all");
-  if (mutt_using_threads() && c_collapse_all)
+  if (!adopted && mutt_using_threads() && c_collapse_all)
     collapse_all(shared->mailbox_view, menu, 0);
 
+  if (!adopted)
+    session_state_restore(shared->mailbox_view, menu);
+
   mutt_clear_error();
   /* force the mailbox check after we have changed the folder */
   struct EventMailbox ev_m = { shared->mailbox };
@@ -789,6 +977,41 @@ void change_folder_string(struct Menu *menu, struct Buffer *buf, int *oldcount,
   change_folder_mailbox(menu, m, oldcount, shared, read_only);
 }
 
+/**
+ * struct CachedLine - Cached copy of a rendered $index_format line
+ */
+struct CachedLine
+{
+  struct Email *email;   ///< Email the line was rendered from
+  int cols;              ///< Screen width it was rendered for
+  MuttFormatFlags flags; ///< Format flags it was rendered with
+  int msg_in_pager;      ///< Which message was in the pager at render time
+  int cols_used;         ///< Number of screen columns used
+  char *text;            ///< Rendered line
+};
+ARRAY_HEAD(CachedLineArray, struct CachedLine);
+
+/// Rendered index lines, indexed by Menu line number
+static struct CachedLineArray LineCache = ARRAY_HEAD_INITIALIZER;
+
+/**
+ * index_line_cache_flush - Discard the cached index lines
+ *
+ * Call whenever anything that feeds $index_format changes: email flags, the
+ * Mailbox, the sort order, relevant config, ...  Redraws that change none of
+ * them, e.g. scrolling, reuse the cached lines instead of rendering the
+ * expandos again.
+ */
+void index_line_cache_flush(void)
+{
+  struct CachedLine *cl = NULL;
+  ARRAY_FOREACH(cl, &LineCache)
+  {
+    FREE(&cl->text);
+  }
+  ARRAY_FREE(&LineCache);
+}
+
 /**
  * index_make_entry - Format an Email for the Menu - Implements Menu::make_entry() - @ingroup menu_make_entry
  *
@@ -888,7 +1111,31 @@ int index_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *b
     max_cols -= (mutt_strwidth(c_arrow_string) + 1);
   }
 
-  return mutt_make_string(buf, max_cols, c_index_format, m, msg_in_pager, e, flags, NULL);
+  struct CachedLine *cl = ARRAY_GET(&LineCache, line);
+  if (cl && (cl->email == e) && (cl->cols == max_cols) && (cl->flags == flags) &&
+      (cl->msg_in_pager == msg_in_pager))
+  {
+    buf_strcpy(buf, cl->text);
+    return cl->cols_used;
+  }
+
+  const int cols_used = mutt_make_string(buf, max_cols, c_index_format, m,
+                                         msg_in_pager, e, flags, NULL);
+
+  if (!cl)
+  {
+    struct CachedLine cl_new = { 0 };
+    ARRAY_SET(&LineCache, line, cl_new);
+    cl = ARRAY_GET(&LineCache, line);
+  }
+  cl->email = e;
+  cl->cols = max_cols;
+  cl->flags = flags;
+  cl->msg_in_pager = msg_in_pager;
+  cl->cols_used = cols_used;
+  mutt_str_replace(&cl->text, buf_string(buf));
+
+  return cols_used;
 }
 
 /**
@@ -906,7 +1153,7 @@ const struct AttrColor *index_color(struct Menu *menu, int line)
   if (!e)
     return NULL;
 
-  if (e->attr_color)
+  if (e->attr_color && (e->attr_color_gen == regex_colors_generation()))
     return e->attr_color;
 
   mutt_set_header_color(m, e);
@@ -1113,6 +1360,8 @@ struct Mailbox *dlg_index(struct MuttWindow *dlg, struct Mailbox *m_init)
     menu_queue_redraw(priv->menu, MENU_REDRAW_FULL);
   }
 
+  session_state_restore(shared->mailbox_view, priv->menu);
+
   int rc = 0;
   do
   {
@@ -1239,35 +1488,45 @@ struct Mailbox *dlg_index(struct MuttWindow *dlg, struct Mailbox *m_init)
       }
     }
 
-    window_redraw(NULL);
-
-    /* give visual indication that the next command is a tag- command */
-    if (priv->tag_prefix)
+    /* Coalesce input: while key repeats or queued macro events are still
+     * pending, skip the repaint.  Each pending op updates the Menu cheaply
+     * and the screen is painted once the input drains - held-down arrow
+     * keys cause one repaint, not hundreds.  Paint at least every 100ms,
+     * so a long stream of macro events still shows progress.  */
+    if (!mutt_input_pending(GETCH_NO_FLAGS) ||
+        ((mutt_date_now_ms() - priv->last_repaint) >= 100))
     {
-      msgwin_set_text(NULL, "tag-", MT_COLOR_NORMAL);
-    }
+      window_redraw(NULL);
 
-    const bool c_arrow_cursor = cs_subset_bool(shared->sub, "arrow_cursor");
-    const bool c_braille_friendly = cs_subset_bool(shared->sub, "braille_friendly");
-    const int index = menu_get_index(priv->menu);
-    if (c_arrow_cursor)
-    {
-      const char *const c_arrow_string = cs_subset_string(shared->sub, "arrow_string");
-      const int arrow_width = mutt_strwidth(c_arrow_string);
-      mutt_window_move(priv->menu->win, arrow_width, index - priv->menu->top);
-    }
-    else if (c_braille_friendly)
-    {
-      mutt_window_move(priv->menu->win, 0, index - priv->menu->top);
-    }
-    else
-    {
-      mutt_window_move(priv->menu->win, priv->menu->win->state.cols - 1,
-                       index - priv->menu->top);
+      /* give visual indication that the next command is a tag- command */
+      if (priv->tag_prefix)
+      {
+        msgwin_set_text(NULL, "tag-", MT_COLOR_NORMAL);
+      }
+
+      const bool c_arrow_cursor = cs_subset_bool(shared->sub, "arrow_cursor");
+      const bool c_braille_friendly = cs_subset_bool(shared->sub, "braille_friendly");
+      const int index = menu_get_index(priv->menu);
+      if (c_arrow_cursor)
+      {
+        const char *const c_arrow_string = cs_subset_string(shared->sub, "arrow_string");
+        const int arrow_width = mutt_strwidth(c_arrow_string);
+        mutt_window_move(priv->menu->win, arrow_width, index - priv->menu->top);
+      }
+      else if (c_braille_friendly)
+      {
+        mutt_window_move(priv->menu->win, 0, index - priv->menu->top);
+      }
+      else
+      {
+        mutt_window_move(priv->menu->win, priv->menu->win->state.cols - 1,
+                         index - priv->menu->top);
+      }
+
+      window_redraw(NULL);
+      priv->last_repaint = mutt_date_now_ms();
     }
-    mutt_refresh();
 
-    window_redraw(NULL);
     op = km_dokey(MENU_INDEX, GETCH_NO_FLAGS);
 
     if (op == OP_REPAINT)
@@ -1284,6 +1543,15 @@ struct Mailbox *dlg_index(struct MuttWindow *dlg, struct Mailbox *m_init)
     {
       if (priv->tag_prefix)
         msgwin_clear_text(NULL);
+      if (op == OP_TIMEOUT)
+      {
+        /* finish marking search matches before spending idle time elsewhere */
+        if (!mutt_search_step(shared->mailbox_view, shared->search_state) &&
+            !backsync_step(shared->mailbox))
+        {
+          prefetch_step(shared->mailbox);
+        }
+      }
       continue;
     }
 
@@ -1395,6 +1663,7 @@ void mutt_set_header_color(struct Mailbox *m, struct Email *e)
     ac_merge = ac_normal;
 
   e->attr_color = ac_merge;
+  e->attr_color_gen = regex_colors_generation();
 }
 
 /**
@@ -62,15 +62,18 @@
 #include "functions.h"
 #include "globals.h"
 #include "hook.h"
+#include "msgid.h"
 #include "mutt_header.h"
 #include "mutt_mailbox.h"
 #include "mutt_thread.h"
 #include "muttlib.h"
 #include "mview.h"
+#include "mxsearch.h"
 #include "mx.h"
 #include "nntp/mdata.h"
 #include "private_data.h"
 #include "protos.h"
+#include "session.h"
 #include "shared_data.h"
 #include "sort.h"
 #ifdef USE_AUTOCRYPT
@@ -98,6 +101,7 @@ const struct MenuFuncOp OpIndex[] = { /* map: index */
 #endif
   { "bounce-message",                OP_BOUNCE_MESSAGE },
   { "break-thread",                  OP_MAIN_BREAK_THREAD },
+  { "browse-labels",                 OP_BROWSE_LABELS },
   { "catchup",                       OP_CATCHUP },
   { "change-folder",                 OP_MAIN_CHANGE_FOLDER },
   { "change-folder-readonly",        OP_MAIN_CHANGE_FOLDER_READONLY },
@@ -147,6 +151,7 @@ const struct MenuFuncOp OpIndex[] = { /* map: index */
   { "group-reply",                   OP_GROUP_REPLY },
   { "imap-fetch-mail",               OP_MAIN_IMAP_FETCH },
   { "imap-logout-all",               OP_MAIN_IMAP_LOGOUT_ALL },
+  { "jump-to-message-id",            OP_JUMP_TO_MSGID },
   { "limit",                         OP_MAIN_LIMIT },
   { "limit-current-thread",          OP_LIMIT_CURRENT_THREAD },
   { "link-threads",                  OP_MAIN_LINK_THREADS },
@@ -192,6 +197,7 @@ const struct MenuFuncOp OpIndex[] = { /* map: index */
   { "resend-message",                OP_RESEND },
   { "root-message",                  OP_MAIN_ROOT_MESSAGE },
   { "save-message",                  OP_SAVE },
+  { "search-mailboxes",              OP_MAIN_SEARCH_MAILBOXES },
   { "set-flag",                      OP_MAIN_SET_FLAG },
   { "show-limit",                    OP_MAIN_SHOW_LIMIT },
   { "sidebar-first",                 OP_SIDEBAR_FIRST },
@@ -810,14 +816,21 @@ static int op_flag_message(struct IndexSharedData *shared,
   struct Mailbox *m = shared->mailbox;
   if (priv->tag_prefix)
   {
-    for (size_t i = 0; i < m->msg_count; i++)
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+    struct EmailArray ea_set = ARRAY_HEAD_INITIALIZER;
+    struct EmailArray ea_clear = ARRAY_HEAD_INITIALIZER;
+    ea_add_tagged(&ea, shared->mailbox_view, NULL, true);
+    struct Email **ep = NULL;
+    ARRAY_FOREACH(ep, &ea)
     {
-      struct Email *e = m->emails[i];
-      if (!e)
-        break;
-      if (message_is_tagged(e))
-        mutt_set_flag(m, e, MUTT_FLAG, !e->flagged, true);
+      struct Email *e = *ep;
+      ARRAY_ADD(e->flagged ? &ea_clear : &ea_set, e);
     }
+    mutt_emails_set_flag(m, &ea_set, MUTT_FLAG, true);
+    mutt_emails_set_flag(m, &ea_clear, MUTT_FLAG, false);
+    ARRAY_FREE(&ea);
+    ARRAY_FREE(&ea_set);
+    ARRAY_FREE(&ea_clear);
 
     menu_queue_redraw(priv->menu, MENU_REDRAW_INDEX);
   }
@@ -952,6 +965,106 @@ static int op_jump(struct IndexSharedData *shared, struct IndexPrivateData *priv
   return rc;
 }
 
+/**
+ * op_jump_to_msgid - Jump to a message by its message-id - Implements ::index_function_t - @ingroup index_function_api
+ *
+ * The message may be in another Mailbox: the message-id index covers every
+ * folder that's been opened or synced, and the remaining local folders are
+ * scanned on demand.
+ */
+static int op_jump_to_msgid(struct IndexSharedData *shared,
+                            struct IndexPrivateData *priv, int op)
+{
+  int rc = FR_ERROR;
+  struct Buffer *buf = buf_pool_get();
+
+  /* Default to the parent of the current message */
+  if (shared->email && shared->email->env)
+  {
+    struct ListNode *np = STAILQ_FIRST(&shared->email->env->in_reply_to);
+    if (np)
+      buf_strcpy(buf, np->data);
+  }
+
+  if ((mw_get_field(_("Jump to message-id: "), buf, MUTT_COMP_NO_FLAGS,
+                    HC_OTHER, NULL, NULL) != 0) ||
+      buf_is_empty(buf))
+  {
+    rc = FR_NO_ACTION;
+    goto done;
+  }
+
+  /* Message-ids are stored with their angle brackets */
+  if (buf_at(buf, 0) != '<')
+  {
+    struct Buffer *tmp = buf_pool_get();
+    buf_printf(tmp, "<%s>", buf_string(buf));
+    buf_copy(buf, tmp);
+    buf_pool_release(&tmp);
+  }
+
+  struct Mailbox *m = shared->mailbox;
+  if (!m->id_hash)
+    m->id_hash = mutt_make_id_hash(m);
+  struct Email *e = mutt_hash_find(m->id_hash, buf_string(buf));
+
+  if (!e)
+  {
+    const char *path = msgid_index_scan(buf_string(buf));
+    if (!path)
+    {
+      mutt_error(_("Message-id %s not found in any mailbox"), buf_string(buf));
+      goto done;
+    }
+
+    struct Mailbox *m_target = mx_mbox_find2(path);
+    if (m_target)
+    {
+      change_folder_mailbox(priv->menu, m_target, &priv->oldcount, shared, false);
+    }
+    else
+    {
+      struct Buffer *folderbuf = buf_pool_get();
+      buf_strcpy(folderbuf, path);
+      change_folder_string(priv->menu, folderbuf, &priv->oldcount, shared, false);
+      buf_pool_release(&folderbuf);
+    }
+
+    m = shared->mailbox;
+    if (!m)
+      goto done;
+    if (!m->id_hash)
+      m->id_hash = mutt_make_id_hash(m);
+    e = mutt_hash_find(m->id_hash, buf_string(buf));
+    if (!e)
+    {
+      mutt_error(_("Message-id %s not found in any mailbox"), buf_string(buf));
+      goto done;
+    }
+  }
+
+  if (e->vnum != -1)
+  {
+    menu_set_index(priv->menu, e->vnum);
+  }
+  else if (e->collapsed)
+  {
+    mutt_uncollapse_thread(e);
+    mutt_set_vnum(m);
+    menu_set_index(priv->menu, e->vnum);
+  }
+  else
+  {
+    mutt_error(_("Message is not visible in limited view"));
+    goto done;
+  }
+  rc = FR_SUCCESS;
+
+done:
+  buf_pool_release(&buf);
+  return rc;
+}
+
 /**
  * op_list_reply - Reply to specified mailing list - Implements ::index_function_t - @ingroup index_function_api
  */
@@ -1219,6 +1332,7 @@ static int op_main_delete_pattern(struct IndexSharedData *shared,
  * op_main_limit - Limit view to a pattern/thread - Implements ::index_function_t - @ingroup index_function_api
  *
  * This function handles:
+ * - OP_BROWSE_LABELS
  * - OP_LIMIT_CURRENT_THREAD
  * - OP_MAIN_LIMIT
  * - OP_TOGGLE_READ
@@ -1227,6 +1341,32 @@ static int op_main_limit(struct IndexSharedData *shared, struct IndexPrivateData
 {
   const bool lmt = mview_has_limit(shared->mailbox_view);
   int old_index = shared->email ? shared->email->index : -1;
+  if (op == OP_BROWSE_LABELS)
+  {
+    struct Buffer *label = buf_pool_get();
+    if (!mutt_label_select(shared->mailbox, label))
+    {
+      buf_pool_release(&label);
+      return FR_NO_ACTION;
+    }
+
+    // Quote the label for the pattern compiler
+    struct Buffer *pattern = buf_pool_get();
+    buf_addstr(pattern, "~y \"");
+    for (const char *p = buf_string(label); *p; p++)
+    {
+      if ((*p == '"') || (*p == '\\'))
+        buf_addch(pattern, '\\');
+      buf_addch(pattern, *p);
+    }
+    buf_addch(pattern, '"');
+
+    mutt_str_replace(&shared->mailbox_view->pattern, buf_string(pattern));
+    mutt_pattern_func(shared->mailbox_view, MUTT_LIMIT, NULL);
+
+    buf_pool_release(&pattern);
+    buf_pool_release(&label);
+  }
   if (op == OP_TOGGLE_READ)
   {
     char buf2[1024] = { 0 };
@@ -1247,7 +1387,7 @@ static int op_main_limit(struct IndexSharedData *shared, struct IndexPrivateData
 
   if (((op == OP_LIMIT_CURRENT_THREAD) &&
        mutt_limit_current_thread(shared->mailbox_view, shared->email)) ||
-      (op == OP_TOGGLE_READ) ||
+      (op == OP_TOGGLE_READ) || (op == OP_BROWSE_LABELS) ||
       ((op == OP_MAIN_LIMIT) && (mutt_pattern_func(shared->mailbox_view, MUTT_LIMIT,
                                                    _("Limit to messages matching: ")) == 0)))
   {
@@ -1394,13 +1534,13 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
     if (m->type == MUTT_NOTMUCH)
       nm_db_longrun_init(m, true);
 #endif
-    for (int px = 0, i = 0; i < m->msg_count; i++)
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+    ea_add_tagged(&ea, shared->mailbox_view, NULL, true);
+    int px = 0;
+    struct Email **ep = NULL;
+    ARRAY_FOREACH(ep, &ea)
     {
-      struct Email *e = m->emails[i];
-      if (!e)
-        break;
-      if (!message_is_tagged(e))
-        continue;
+      struct Email *e = *ep;
 
       progress_update(progress, ++px, -1);
       mx_tags_commit(m, e, buf_string(buf));
@@ -1416,6 +1556,7 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
         m->changed = true;
       }
     }
+    ARRAY_FREE(&ea);
     progress_free(&progress);
 #ifdef USE_NOTMUCH
     if (m->type == MUTT_NOTMUCH)
@@ -1723,17 +1864,15 @@ static int op_main_quasi_delete(struct IndexSharedData *shared,
   if (priv->tag_prefix)
   {
     struct Mailbox *m = shared->mailbox;
-    for (size_t i = 0; i < m->msg_count; i++)
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+    ea_add_tagged(&ea, shared->mailbox_view, NULL, true);
+    struct Email **ep = NULL;
+    ARRAY_FOREACH(ep, &ea)
     {
-      struct Email *e = m->emails[i];
-      if (!e)
-        break;
-      if (message_is_tagged(e))
-      {
-        e->quasi_deleted = true;
-        m->changed = true;
-      }
+      (*ep)->quasi_deleted = true;
+      m->changed = true;
     }
+    ARRAY_FREE(&ea);
   }
   else
   {
@@ -1793,6 +1932,74 @@ static int op_main_root_message(struct IndexSharedData *shared,
   return FR_SUCCESS;
 }
 
+/**
+ * op_main_search_mailboxes - Search for messages matching a pattern in all mailboxes - Implements ::index_function_t - @ingroup index_function_api
+ */
+static int op_main_search_mailboxes(struct IndexSharedData *shared,
+                                    struct IndexPrivateData *priv, int op)
+{
+  int rc = FR_ERROR;
+  struct Buffer *folder = buf_pool_get();
+  struct Buffer *msgid = buf_pool_get();
+
+  if (!mxsearch_search(shared->mailbox, folder, msgid))
+  {
+    rc = FR_NO_ACTION;
+    goto done;
+  }
+
+  struct Mailbox *m = shared->mailbox;
+  if (!m || !mutt_str_equal(mailbox_path(m), buf_string(folder)))
+  {
+    struct Mailbox *m_target = mx_mbox_find2(buf_string(folder));
+    if (m_target)
+      change_folder_mailbox(priv->menu, m_target, &priv->oldcount, shared, false);
+    else
+      change_folder_string(priv->menu, folder, &priv->oldcount, shared, false);
+
+    m = shared->mailbox;
+    if (!m)
+      goto done;
+  }
+
+  if (buf_is_empty(msgid))
+  {
+    rc = FR_SUCCESS;
+    goto done;
+  }
+
+  if (!m->id_hash)
+    m->id_hash = mutt_make_id_hash(m);
+  struct Email *e = mutt_hash_find(m->id_hash, buf_string(msgid));
+  if (!e)
+  {
+    mutt_error(_("Message-id %s not found in any mailbox"), buf_string(msgid));
+    goto done;
+  }
+
+  if (e->vnum != -1)
+  {
+    menu_set_index(priv->menu, e->vnum);
+  }
+  else if (e->collapsed)
+  {
+    mutt_uncollapse_thread(e);
+    mutt_set_vnum(m);
+    menu_set_index(priv->menu, e->vnum);
+  }
+  else
+  {
+    mutt_error(_("Message is not visible in limited view"));
+    goto done;
+  }
+  rc = FR_SUCCESS;
+
+done:
+  buf_pool_release(&folder);
+  buf_pool_release(&msgid);
+  return rc;
+}
+
 /**
  * op_main_set_flag - Set a status flag on a message - Implements ::index_function_t - @ingroup index_function_api
  *
@@ -2118,6 +2325,8 @@ static int op_quit(struct IndexSharedData *shared, struct IndexPrivateData *priv
     mutt_debug(LL_NOTIFY, "NT_GLOBAL_SHUTDOWN\n");
     notify_send(NeoMutt->notify, NT_GLOBAL, NT_GLOBAL_SHUTDOWN, NULL);
 
+    folder_cache_flush();
+    session_state_save(shared->mailbox_view, shared->email);
     enum MxStatus check = MX_STATUS_OK;
     if (!shared->mailbox_view || ((check = mx_mbox_close(shared->mailbox)) == MX_STATUS_OK))
     {
@@ -2182,15 +2391,14 @@ static int op_resend(struct IndexSharedData *shared, struct IndexPrivateData *pr
   int rc = -1;
   if (priv->tag_prefix)
   {
-    struct Mailbox *m = shared->mailbox;
-    for (size_t i = 0; i < m->msg_count; i++)
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+    ea_add_tagged(&ea, shared->mailbox_view, NULL, true);
+    struct Email **ep = NULL;
+    ARRAY_FOREACH(ep, &ea)
     {
-      struct Email *e = m->emails[i];
-      if (!e)
-        break;
-      if (message_is_tagged(e))
-        rc = mutt_resend_message(NULL, shared->mailbox, e, shared->sub);
+      rc = mutt_resend_message(NULL, shared->mailbox, *ep, shared->sub);
     }
+    ARRAY_FREE(&ea);
   }
   else
   {
@@ -2314,14 +2522,17 @@ static int op_tag(struct IndexSharedData *shared, struct IndexPrivateData *priv,
   if (priv->tag_prefix && !c_auto_tag)
   {
     struct Mailbox *m = shared->mailbox;
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
     for (size_t i = 0; i < m->msg_count; i++)
     {
       struct Email *e = m->emails[i];
       if (!e)
         break;
       if (e->visible)
-        mutt_set_flag(m, e, MUTT_TAG, false, true);
+        ARRAY_ADD(&ea, e);
     }
+    mutt_emails_set_flag(m, &ea, MUTT_TAG, false);
+    ARRAY_FREE(&ea);
     menu_queue_redraw(priv->menu, MENU_REDRAW_INDEX);
     return FR_SUCCESS;
   }
@@ -2372,19 +2583,21 @@ static int op_toggle_new(struct IndexSharedData *shared, struct IndexPrivateData
   struct Mailbox *m = shared->mailbox;
   if (priv->tag_prefix)
   {
-    for (size_t i = 0; i < m->msg_count; i++)
+    struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+    struct EmailArray ea_new = ARRAY_HEAD_INITIALIZER;
+    struct EmailArray ea_read = ARRAY_HEAD_INITIALIZER;
+    ea_add_tagged(&ea, shared->mailbox_view, NULL, true);
+    struct Email **ep = NULL;
+    ARRAY_FOREACH(ep, &ea)
     {
-      struct Email *e = m->emails[i];
-      if (!e)
-        break;
-      if (!message_is_tagged(e))
-        continue;
-
-      if (e->read || e->old)
-        mutt_set_flag(m, e, MUTT_NEW, true, true);
-      else
-        mutt_set_flag(m, e, MUTT_READ, true, true);
+      struct Email *e = *ep;
+      ARRAY_ADD((e->read || e->old) ? &ea_new : &ea_read, e);
     }
+    mutt_emails_set_flag(m, &ea_new, MUTT_NEW, true);
+    mutt_emails_set_flag(m, &ea_read, MUTT_READ, true);
+    ARRAY_FREE(&ea);
+    ARRAY_FREE(&ea_new);
+    ARRAY_FREE(&ea_read);
     menu_queue_redraw(priv->menu, MENU_REDRAW_INDEX);
   }
   else
@@ -3161,6 +3374,8 @@ static const struct IndexFunction IndexFunctions[] = {
   { OP_JUMP_7,                              op_jump,                              CHECK_IN_MAILBOX },
   { OP_JUMP_8,                              op_jump,                              CHECK_IN_MAILBOX },
   { OP_JUMP_9,                              op_jump,                              CHECK_IN_MAILBOX },
+  { OP_BROWSE_LABELS,                       op_main_limit,                        CHECK_IN_MAILBOX },
+  { OP_JUMP_TO_MSGID,                       op_jump_to_msgid,                     CHECK_IN_MAILBOX },
   { OP_LIMIT_CURRENT_THREAD,                op_main_limit,                        CHECK_IN_MAILBOX },
   { OP_LIST_REPLY,                          op_list_reply,                        CHECK_ATTACH | CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_VISIBLE },
   { OP_LIST_SUBSCRIBE,                      op_list_subscribe,                    CHECK_ATTACH | CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_VISIBLE },
@@ -3202,6 +3417,7 @@ static const struct IndexFunction IndexFunctions[] = {
   { OP_MAIN_READ_SUBTHREAD,                 op_main_read_thread,                  CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_READ_THREAD,                    op_main_read_thread,                  CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_ROOT_MESSAGE,                   op_main_root_message,                 CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_VISIBLE },
+  { OP_MAIN_SEARCH_MAILBOXES,               op_main_search_mailboxes,             CHECK_NO_FLAGS },
   { OP_MAIN_SET_FLAG,                       op_main_set_flag,                     CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_SHOW_LIMIT,                     op_main_show_limit,                   CHECK_IN_MAILBOX },
   { OP_MAIN_SYNC_FOLDER,                    op_main_sync_folder,                  CHECK_NO_FLAGS },
@@ -68,6 +68,8 @@
 #include "gui/lib.h"
 #include "lib.h"
 #include "color/lib.h"
+#include "expando/lib.h"
+#include "menu/lib.h"
 #include "private_data.h"
 #include "shared_data.h"
 #include "status.h"
@@ -82,8 +84,44 @@ struct IBarPrivateData
   char *status_format;            ///< Cached screen status string
   char *ts_status_format;         ///< Cached terminal status string
   char *ts_icon_format;           ///< Cached terminal icon string
+  bool uses_menu;                 ///< Do the status formats use the Menu position (`%P`)?
+  bool uses_menu_valid;           ///< uses_menu has been calculated
 };
 
+/**
+ * ibar_uses_menu - Do the status formats depend on the Menu?
+ * @param ibar_data Private data
+ * @retval true One of the active formats uses the Menu position
+ *
+ * The Menu only feeds the percentage expando (`%P`).  If none of the active
+ * formats uses it, scrolling can't change the status bar and there's no need
+ * to re-render the formats for Menu events.
+ */
+static bool ibar_uses_menu(struct IBarPrivateData *ibar_data)
+{
+  if (ibar_data->uses_menu_valid)
+    return ibar_data->uses_menu;
+
+  struct IndexSharedData *shared = ibar_data->shared;
+
+  const struct Expando *c_status_format = cs_subset_expando(shared->sub, "status_format");
+  bool uses = expando_uses(c_status_format, ED_MENU, ED_MEN_PERCENTAGE);
+
+  const bool c_ts_enabled = cs_subset_bool(shared->sub, "ts_enabled");
+  if (!uses && c_ts_enabled && TsSupported)
+  {
+    const struct Expando *c_ts_status_format = cs_subset_expando(shared->sub, "ts_status_format");
+    const struct Expando *c_ts_icon_format = cs_subset_expando(shared->sub, "ts_icon_format");
+    uses = expando_uses(c_ts_status_format, ED_MENU, ED_MEN_PERCENTAGE) ||
+           expando_uses(c_ts_icon_format, ED_MENU, ED_MEN_PERCENTAGE);
+  }
+
+  ibar_data->uses_menu = uses;
+  ibar_data->uses_menu_valid = true;
+
+  return uses;
+}
+
 /**
  * ibar_recalc - Recalculate the Window data - Implements MuttWindow::recalc() - @ingroup window_recalc
  */
@@ -212,6 +250,9 @@ static int ibar_config_observer(struct NotifyCallback *nc)
   }
 
   struct MuttWindow *win_ibar = nc->global_data;
+  struct IBarPrivateData *ibar_data = win_ibar->wdata;
+
+  ibar_data->uses_menu_valid = false;
   win_ibar->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "config done, request WA_RECALC\n");
 
@@ -250,6 +291,15 @@ static int ibar_menu_observer(struct NotifyCallback *nc)
     return -1;
 
   struct MuttWindow *win_ibar = nc->global_data;
+  struct IBarPrivateData *ibar_data = win_ibar->wdata;
+
+  // `%P` depends on the visible page, not the selection
+  if (nc->event_subtype == MENU_REDRAW_MOTION)
+    return 0;
+
+  if (!ibar_uses_menu(ibar_data))
+    return 0;
+
   win_ibar->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "menu done, request WA_RECALC\n");
 
@@ -70,11 +70,13 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
+#include "lib.h"
 #include "attach/lib.h"
 #include "color/lib.h"
 #include "menu/lib.h"
@@ -231,6 +233,7 @@ static int index_altern_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_alternates_reset(shared->mailbox_view);
+  index_line_cache_flush();
   mutt_debug(LL_DEBUG5, "alternates done\n");
   return 0;
 }
@@ -250,6 +253,7 @@ static int index_attach_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_attachments_reset(shared->mailbox_view);
+  index_line_cache_flush();
   mutt_debug(LL_DEBUG5, "attachments done\n");
   return 0;
 }
@@ -416,6 +420,7 @@ static int index_config_observer(struct NotifyCallback *nc)
     mutt_debug(LL_DEBUG5, "config done\n");
   }
 
+  index_line_cache_flush();
   menu_queue_redraw(win->wdata, MENU_REDRAW_INDEX);
   return 0;
 }
@@ -451,6 +456,10 @@ static int index_index_observer(struct NotifyCallback *nc)
   if (!nc->global_data)
     return -1;
 
+  // Moving the cursor (NT_INDEX_EMAIL) doesn't change any line's content
+  if ((nc->event_type != NT_INDEX) || (nc->event_subtype & ~NT_INDEX_EMAIL))
+    index_line_cache_flush();
+
   struct MuttWindow *win = nc->global_data;
   win->actions |= WA_RECALC;
 
@@ -518,6 +527,7 @@ static int index_score_observer(struct NotifyCallback *nc)
     e->attr_color = NULL; // Force recalc of colour
   }
 
+  index_line_cache_flush();
   mutt_debug(LL_DEBUG5, "score done\n");
   return 0;
 }
@@ -537,6 +547,7 @@ static int index_subjrx_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   subjrx_clear_mods(shared->mailbox_view);
+  index_line_cache_flush();
   mutt_debug(LL_DEBUG5, "subjectrx done\n");
   return 0;
 }
@@ -577,6 +588,7 @@ static int index_window_observer(struct NotifyCallback *nc)
   notify_observer_remove(NeoMutt->notify, index_subjrx_observer, win);
   notify_observer_remove(win->notify, index_window_observer, win);
 
+  index_line_cache_flush();
   mutt_debug(LL_DEBUG5, "window delete done\n");
   return 0;
 }
@@ -61,6 +61,7 @@
 #include "config/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
+#include "preview/lib.h"
 #include "ibar.h"
 #include "private_data.h"
 
@@ -130,15 +131,19 @@ struct MuttWindow *ipanel_new(bool status_on_top, struct IndexSharedData *shared
 
   struct MuttWindow *win_index = index_window_new(priv);
 
+  struct MuttWindow *win_preview = preview_window_new(shared);
+
   struct MuttWindow *win_ibar = ibar_new(panel_index, shared, priv);
   if (status_on_top)
   {
     mutt_window_add_child(panel_index, win_ibar);
     mutt_window_add_child(panel_index, win_index);
+    mutt_window_add_child(panel_index, win_preview);
   }
   else
   {
     mutt_window_add_child(panel_index, win_index);
+    mutt_window_add_child(panel_index, win_preview);
     mutt_window_add_child(panel_index, win_ibar);
   }
 
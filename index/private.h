@@ -32,6 +32,7 @@ struct ConfigSubset;
 
 struct MuttWindow *index_window_new(struct IndexPrivateData *priv);
 struct MuttWindow *ipanel_new(bool status_on_top, struct IndexSharedData *shared);
-int index_adjust_sort_threads(const struct ConfigSubset *sub);
+void index_adjust_sort_threads(const struct ConfigSubset *sub);
+void index_line_cache_flush(void);
 
 #endif /* MUTT_INDEX_PRIVATE_H */
@@ -24,6 +24,7 @@
 #define MUTT_INDEX_PRIVATE_DATA_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 struct IndexSharedData;
 struct MuttWindow;
@@ -36,6 +37,7 @@ struct IndexPrivateData
   bool tag_prefix;               ///< tag-prefix has been pressed
   int  oldcount;                 ///< Old count of mails in the mailbox
   bool do_mailbox_notify;        ///< Do we need to notify the user of new mail?
+  uint64_t last_repaint;         ///< Time (ms) of the last repaint, for input coalescing
 
   struct IndexSharedData *shared; ///< Shared Index data
   struct Menu *menu;              ///< Menu controlling the index
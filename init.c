@@ -58,8 +58,11 @@
 #include "commands.h"
 #include "globals.h"
 #include "hook.h"
+#include "maillist.h"
 #include "mutt_logging.h"
 #include "muttlib.h"
+#include "prefetch.h"
+#include "session.h"
 #include "protos.h"
 #ifndef DOMAIN
 #include "conn/lib.h"
@@ -67,6 +70,9 @@
 #ifdef USE_LUA
 #include "mutt_lua.h"
 #endif
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
 
 /**
  * execute_commands - Execute a set of NeoMutt commands
@@ -271,6 +277,7 @@ void mutt_opts_cleanup(void)
   mutt_regexlist_free(&SubscribedLists);
   mutt_regexlist_free(&UnMailLists);
   mutt_regexlist_free(&UnSubscribedLists);
+  mutt_maillist_cleanup();
 
   mutt_grouplist_cleanup();
   driver_tags_cleanup();
@@ -329,6 +336,9 @@ int mutt_init(struct ConfigSet *cs, const char *dlevel, const char *dfile,
   hooks_init();
   mutt_comp_init();
   imap_init();
+#ifdef USE_HCACHE
+  hcache_init();
+#endif
 #ifdef USE_LUA
   mutt_lua_init();
 #endif
@@ -589,6 +599,8 @@ int mutt_init(struct ConfigSet *cs, const char *dlevel, const char *dfile,
 
   mutt_hist_init();
   mutt_hist_read_file();
+  prefetch_init();
+  session_init();
 
 #ifdef USE_NOTMUCH
   const bool c_virtual_spool_file = cs_subset_bool(NeoMutt->sub, "virtual_spool_file");
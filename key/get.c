@@ -29,6 +29,9 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -260,7 +263,7 @@ struct KeyEvent mutt_getch(GetChFlags flags)
 
     if (SigWinch)
     {
-      SigWinch = false;
+      mutt_resize_settle();
       notify_send(NeoMutt->notify_resize, NT_RESIZE, 0, NULL);
       return event_repaint;
     }
@@ -287,6 +290,36 @@ struct KeyEvent mutt_getch(GetChFlags flags)
   return (struct KeyEvent){ ch, OP_NULL };
 }
 
+/**
+ * mutt_input_pending - Is more user input already waiting?
+ * @param flags Flags, e.g. #GETCH_IGNORE_MACRO
+ * @retval true More input is ready to be read
+ *
+ * Event loops use this to coalesce input: while key repeats or queued macro
+ * events are pending, each operation only needs to update its state - the
+ * screen repaint can wait until the input has drained.
+ */
+bool mutt_input_pending(GetChFlags flags)
+{
+  if (OptNoCurses)
+    return false;
+
+  if (!ARRAY_EMPTY(&UngetKeyEvents))
+    return true;
+
+  if (!(flags & GETCH_IGNORE_MACRO) && !ARRAY_EMPTY(&MacroEvents))
+    return true;
+
+  // Peek at the keyboard: take a character and put it straight back
+  timeout(0);
+  int ch = getch();
+  if (ch == ERR)
+    return false;
+
+  ungetch(ch);
+  return true;
+}
+
 /**
  * km_error_key - Handle an unbound key sequence
  * @param mtype Menu type, e.g. #MENU_PAGER
@@ -337,13 +370,158 @@ static struct KeyEvent retry_generic(enum MenuType mtype, keycode_t *keys,
   return (struct KeyEvent){ mutt_getch(flags).ch, OP_NULL };
 }
 
+/// Number of latency buckets; bucket n counts runs of [2^n, 2^(n+1)) microseconds
+#define OP_PERF_NUM_BUCKETS 24
+
 /**
- * km_dokey_event - Determine what a keypress should do
+ * struct OpPerf - Latency distribution of one function
+ */
+struct OpPerf
+{
+  uint64_t events;   ///< Number of times the function ran
+  uint64_t total_ns; ///< Total time spent in it
+  uint64_t max_ns;   ///< Slowest single run
+  uint64_t buckets[OP_PERF_NUM_BUCKETS]; ///< log2-of-microseconds histogram
+};
+
+/// Latency histograms, indexed by opcode and allocated on first use
+static struct OpPerf *OpPerfData[OP_MAX] = { 0 };
+
+/// Function whose execution is being timed; OP_NULL if none
+static int OpPerfOp = OP_NULL;
+
+/// When #OpPerfOp was handed to its dispatcher
+static uint64_t OpPerfStart = 0;
+
+/**
+ * op_perf_stop - Close the timing of the function dispatched last
+ *
+ * km_dokey_event() blocks until the user presses a key, so the gap between
+ * handing a function to the caller and being asked for the next key is the
+ * time NeoMutt spent executing that function (dispatch plus redraw) - the
+ * user's thinking time never shows up in the histogram.
+ */
+static void op_perf_stop(void)
+{
+  const int op = OpPerfOp;
+  if ((op <= OP_NULL) || (op >= OP_MAX))
+    return;
+  OpPerfOp = OP_NULL;
+
+  struct OpPerf *perf = OpPerfData[op];
+  if (!perf)
+  {
+    perf = mutt_mem_calloc(1, sizeof(struct OpPerf));
+    OpPerfData[op] = perf;
+  }
+
+  const uint64_t elapsed = perf_clock() - OpPerfStart;
+  perf->events++;
+  perf->total_ns += elapsed;
+  if (elapsed > perf->max_ns)
+    perf->max_ns = elapsed;
+
+  uint64_t us = elapsed / 1000;
+  size_t b = 0;
+  while ((us > 1) && (b < (OP_PERF_NUM_BUCKETS - 1)))
+  {
+    us >>= 1;
+    b++;
+  }
+  perf->buckets[b]++;
+}
+
+/**
+ * op_perf_percentile - Estimate a latency percentile of one function
+ * @param perf Histogram to read
+ * @param pct  Percentile, e.g. 99
+ * @retval num Latency, in microseconds
+ *
+ * The estimate is the upper bound of the bucket the percentile falls in.
+ */
+static uint64_t op_perf_percentile(const struct OpPerf *perf, int pct)
+{
+  const uint64_t need = ((perf->events * pct) + 99) / 100;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < OP_PERF_NUM_BUCKETS; b++)
+  {
+    seen += perf->buckets[b];
+    if (seen >= need)
+      return 2ULL << b;
+  }
+  return perf->max_ns / 1000;
+}
+
+/**
+ * op_perf_compare - Compare two histograms by total time - Implements ::sort_t - @ingroup sort_api
+ */
+static int op_perf_compare(const void *a, const void *b)
+{
+  const uint64_t ta = OpPerfData[*(const int *) a]->total_ns;
+  const uint64_t tb = OpPerfData[*(const int *) b]->total_ns;
+  if (ta == tb)
+    return 0;
+  return (ta < tb) ? 1 : -1;
+}
+
+/**
+ * km_perf_report - Print the function latency histograms
+ * @param fp File to write to
+ *
+ * Functions are listed slowest-in-total first.
+ */
+void km_perf_report(FILE *fp)
+{
+  if (!fp)
+    return;
+
+  int ops[OP_MAX];
+  int num = 0;
+  for (int i = 0; i < OP_MAX; i++)
+  {
+    if (OpPerfData[i])
+      ops[num++] = i;
+  }
+
+  if (num == 0)
+  {
+    fprintf(fp, "%s\n", _("No functions have been timed yet"));
+    return;
+  }
+
+  qsort(ops, num, sizeof(int), op_perf_compare);
+
+  fprintf(fp, "%-34s %8s %10s %9s %9s %9s %9s\n", "function", "events",
+          "total", "avg", "p50", "p99", "max");
+  for (int i = 0; i < num; i++)
+  {
+    const struct OpPerf *perf = OpPerfData[ops[i]];
+    fprintf(fp, "%-34s %8llu %8.3f s %6.1f ms %6llu us %6llu us %6.1f ms\n",
+            opcodes_get_name(ops[i]), (unsigned long long) perf->events,
+            (double) perf->total_ns / 1e9,
+            (double) perf->total_ns / 1e6 / perf->events,
+            (unsigned long long) op_perf_percentile(perf, 50),
+            (unsigned long long) op_perf_percentile(perf, 99),
+            (double) perf->max_ns / 1e6);
+  }
+}
+
+/**
+ * km_perf_cleanup - Free the function latency histograms
+ */
+void km_perf_cleanup(void)
+{
+  for (int i = 0; i < OP_MAX; i++)
+    FREE(&OpPerfData[i]);
+}
+
+/**
+ * dokey_event - Determine what a keypress should do
  * @param mtype Menu type, e.g. #MENU_EDITOR
  * @param flags Flags, e.g. #GETCH_IGNORE_MACRO
  * @retval ptr Event
  */
-struct KeyEvent km_dokey_event(enum MenuType mtype, GetChFlags flags)
+static struct KeyEvent dokey_event(enum MenuType mtype, GetChFlags flags)
 {
   struct KeyEvent event = { 0, OP_NULL };
   struct Keymap *map = STAILQ_FIRST(&Keymaps[mtype]);
@@ -452,6 +630,28 @@ struct KeyEvent km_dokey_event(enum MenuType mtype, GetChFlags flags)
   /* not reached */
 }
 
+/**
+ * km_dokey_event - Determine what a keypress should do
+ * @param mtype Menu type, e.g. #MENU_EDITOR
+ * @param flags Flags, e.g. #GETCH_IGNORE_MACRO
+ * @retval ptr Event
+ */
+struct KeyEvent km_dokey_event(enum MenuType mtype, GetChFlags flags)
+{
+  // Asking for a key means the last function has finished executing
+  op_perf_stop();
+
+  struct KeyEvent event = dokey_event(mtype, flags);
+
+  if (event.op > OP_NULL)
+  {
+    OpPerfOp = event.op;
+    OpPerfStart = perf_clock();
+  }
+
+  return event;
+}
+
 /**
  * km_dokey - Determine what a keypress should do
  * @param mtype Menu type, e.g. #MENU_EDITOR
@@ -227,6 +227,7 @@ void mutt_keys_cleanup(void)
   {
     mutt_keymaplist_free(&Keymaps[i]);
   }
+  km_perf_cleanup();
 }
 
 /**
@@ -40,6 +40,7 @@
 #include "config.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include "mutt/lib.h"
 #include "core/lib.h"
 #include "menu/lib.h"
@@ -157,10 +158,12 @@ struct Keymap *          km_find_func               (enum MenuType menu, int fun
 const struct MenuFuncOp *km_get_table               (enum MenuType mtype);
 void                     km_init                    (void);
 const char *             km_keyname                 (int c);
+void                     km_perf_report             (FILE *fp);
 void                     init_extended_keys         (void);
 int                      main_config_observer       (struct NotifyCallback *nc);
 void                     mutt_flush_macro_to_endcond(void);
 void                     mutt_init_abort_key        (void);
+bool                     mutt_input_pending         (GetChFlags flags);
 void                     mutt_keys_cleanup          (void);
 void                     mw_what_key                (void);
 
@@ -170,6 +173,7 @@ enum CommandResult dump_bind_macro             (struct Buffer *buf, struct Buffe
 void               generic_tokenize_push_string(char *s);
 int                get_op                      (const struct MenuFuncOp *funcs, const char *start, size_t len);
 enum CommandResult km_bindkey                  (const char *s, enum MenuType mtype, int op);
+void               km_perf_cleanup             (void);
 struct Keymap *    km_compare_keys             (struct Keymap *k1, struct Keymap *k2, size_t *pos);
 const char *       mutt_get_func               (const struct MenuFuncOp *bindings, int op);
 void               mutt_keymap_free            (struct Keymap **ptr);
@@ -390,6 +390,11 @@ static bool rfc1524_mailcap_parse(struct Body *b, const char *filename, const ch
             entry->xneomuttnowrap = true;
           b->nowrap = true;
         }
+        else if (mutt_istr_startswith(field, "x-neomutt-stream"))
+        {
+          if (entry)
+            entry->xneomuttstream = true;
+        }
       } /* while (ch) */
 
       if (opt == MUTT_MC_AUTOVIEW)
@@ -428,6 +433,7 @@ static bool rfc1524_mailcap_parse(struct Body *b, const char *filename, const ch
           entry->needsterminal = false;
           entry->copiousoutput = false;
           entry->xneomuttkeep = false;
+          entry->xneomuttstream = false;
         }
       }
     }
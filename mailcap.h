@@ -47,6 +47,7 @@ struct MailcapEntry
   bool copiousoutput : 1; ///< needs pager, basically
   bool xneomuttkeep  : 1; ///< do not remove the file on command exit
   bool xneomuttnowrap: 1; ///< do not wrap the output in the pager
+  bool xneomuttstream: 1; ///< feed %s through a named pipe while the viewer runs
 };
 
 /**
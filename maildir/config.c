@@ -78,6 +78,12 @@ static struct ConfigDef MaildirVars[] = {
   { "maildir_field_delimiter", DT_STRING|D_NOT_EMPTY|D_ON_STARTUP, IP ":", 0, maildir_field_delimiter_validator,
     "Field delimiter to be used for maildir email files (default is colon, recommended alternative is semi-colon)"
   },
+  { "maildir_scan_threads", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "Number of worker threads used to parse maildir messages (0 = don't use threads)"
+  },
+  { "maildir_snapshot", DT_BOOL, false, 0, NULL,
+    "Leave parsed header state in a snapshot file, for other NeoMutt instances to attach to"
+  },
   { "maildir_trash", DT_BOOL, false, 0, NULL,
     "Use the maildir 'trashed' flag, rather than deleting"
   },
@@ -28,6 +28,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <sys/stat.h>
 #include "mutt/lib.h"
@@ -36,8 +37,14 @@
 #include "core/lib.h"
 #include "hcache/lib.h"
 #include "edata.h"
+#include "hcache.h"
 #include "mailbox.h"
 
+/// Cache key for the stats snapshot.  It can't collide with a message:
+/// maildir filenames never contain a slash.
+#define STATS_KEY "/stats"
+#define STATS_KEYLEN (sizeof(STATS_KEY) - 1)
+
 /**
  * maildir_hcache_key - Get the header cache key for an Email
  * @param e Email
@@ -68,9 +75,116 @@ static size_t maildir_hcache_keylen(const char *fn)
  */
 void maildir_hcache_close(struct HeaderCache **ptr)
 {
+  if (!ptr || !*ptr)
+    return;
+
+  hcache_txn_commit(*ptr);
   hcache_close(ptr);
 }
 
+/**
+ * maildir_hcache_compressed - Is the Header Cache compressed?
+ * @param hc Header Cache
+ * @retval true Records are compressed
+ *
+ * A compressed cache can't be used with maildir_hcache_fetch_raw().
+ */
+bool maildir_hcache_compressed(struct HeaderCache *hc)
+{
+  return hcache_compressed(hc);
+}
+
+/**
+ * maildir_hcache_copy - Seed a destination Maildir's cache from the source's
+ * @param m_src    Mailbox the Email was copied from
+ * @param e        Email that was copied
+ * @param m_dst    Mailbox the Email was copied to
+ * @param path_dst Full path of the newly committed file
+ * @retval  0 Success
+ * @retval -1 Error, e.g. no usable source record - the destination will
+ *            simply parse the new file on its next open
+ *
+ * After a verbatim copy, the serialised record describing the message is
+ * already in the source's header cache.  Copy it across, so opening the
+ * destination doesn't have to parse the new file from scratch.
+ *
+ * The record embeds the offset and length of the message body, so it's only
+ * valid if the copy really is byte-identical - header weeding or updated
+ * Content-Length headers would shift them.  Checking the committed file's
+ * size against the record's expectation catches any such rewrite.
+ */
+int maildir_hcache_copy(struct Mailbox *m_src, struct Email *e,
+                        struct Mailbox *m_dst, const char *path_dst)
+{
+  if (!m_src || !e || !e->path || !e->body || !m_dst || !path_dst)
+    return -1;
+
+  struct stat st = { 0 };
+  if ((stat(path_dst, &st) != 0) ||
+      (st.st_size != (e->body->offset + e->body->length)))
+  {
+    return -1;
+  }
+
+  const char *key_src = maildir_hcache_key(e);
+  size_t keylen_src = maildir_hcache_keylen(key_src);
+
+  const char *key_dst = strrchr(path_dst, '/');
+  key_dst = key_dst ? (key_dst + 1) : path_dst;
+  size_t keylen_dst = maildir_hcache_keylen(key_dst);
+
+  int rc = -1;
+  struct HeaderCache *hc_src = maildir_hcache_open(m_src);
+  struct HeaderCache *hc_dst = maildir_hcache_open(m_dst);
+  if (hc_src && hc_dst)
+  {
+    rc = hcache_copy_email(hc_src, key_src, keylen_src, hc_dst, key_dst,
+                           keylen_dst, mutt_date_now());
+  }
+
+  maildir_hcache_close(&hc_dst);
+  maildir_hcache_close(&hc_src);
+  return rc;
+}
+
+/**
+ * maildir_hcache_decode - Turn a cache record into an Email
+ * @param e           Email it was fetched for
+ * @param fn          Filename
+ * @param data        Record from maildir_hcache_fetch_raw()
+ * @param uidvalidity When the record was stored
+ * @retval ptr  Email from the Header Cache
+ * @retval NULL The record is stale
+ *
+ * The decode half of maildir_hcache_read().  It doesn't touch the store
+ * backend, so it may run on a worker thread.
+ */
+struct Email *maildir_hcache_decode(struct Email *e, const char *fn,
+                                    const void *data, uint32_t uidvalidity)
+{
+  if (!e || !data)
+    return NULL;
+
+  struct stat st_lastchanged = { 0 };
+  int rc = 0;
+
+  const bool c_maildir_header_cache_verify = cs_subset_bool(NeoMutt->sub, "maildir_header_cache_verify");
+  if (c_maildir_header_cache_verify)
+    rc = stat(fn, &st_lastchanged);
+
+  if ((rc != 0) || (st_lastchanged.st_mtime > (time_t) uidvalidity))
+    return NULL;
+
+  struct Email *e_new = hcache_restore_email(data);
+  e_new->edata = maildir_edata_new();
+  e_new->edata_free = maildir_edata_free;
+  e_new->old = e->old;
+  e_new->path = mutt_str_dup(e->path);
+  maildir_parse_flags(e_new, fn);
+
+  return e_new;
+}
+
 /**
  * maildir_hcache_delete - Delete an Email from the Header Cache
  * @param hc Header Cache
@@ -89,6 +203,43 @@ int maildir_hcache_delete(struct HeaderCache *hc, struct Email *e)
   return hcache_delete_email(hc, key, keylen);
 }
 
+/**
+ * maildir_hcache_fetch_raw - Fetch an Email's cache record
+ * @param[in]  hc          Header Cache
+ * @param[in]  e           Email to find
+ * @param[out] uidvalidity When the record was stored
+ * @retval ptr  Serialised record, for maildir_hcache_decode()
+ * @retval NULL Not found
+ *
+ * The caller owns the returned record and must FREE() it.
+ */
+void *maildir_hcache_fetch_raw(struct HeaderCache *hc, struct Email *e, uint32_t *uidvalidity)
+{
+  if (!hc || !e)
+    return NULL;
+
+  const char *key = maildir_hcache_key(e);
+  size_t keylen = maildir_hcache_keylen(key);
+
+  return hcache_fetch_email_raw(hc, key, keylen, uidvalidity);
+}
+
+/**
+ * maildir_hcache_fetch_stats - Fetch the stats snapshot of a Mailbox
+ * @param[in]  hc    Header Cache
+ * @param[out] stats Snapshot of the message counts
+ * @retval true Success
+ *
+ * The caller must check the snapshot is still current, see MaildirStats.
+ */
+bool maildir_hcache_fetch_stats(struct HeaderCache *hc, struct MaildirStats *stats)
+{
+  if (!hc || !stats)
+    return false;
+
+  return hcache_fetch_raw_obj(hc, STATS_KEY, STATS_KEYLEN, stats);
+}
+
 /**
  * maildir_hcache_open - Open the Header Cache
  * @param m Mailbox
@@ -100,7 +251,11 @@ struct HeaderCache *maildir_hcache_open(struct Mailbox *m)
 
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
 
-  return hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  // Batch all the stores into a single transaction, where the backend allows
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
+  hcache_txn_begin(hc);
+
+  return hc;
 }
 
 /**
@@ -145,6 +300,21 @@ struct Email *maildir_hcache_read(struct HeaderCache *hc, struct Email *e, const
   return hce.email;
 }
 
+/**
+ * maildir_hcache_store_stats - Save the stats snapshot of a Mailbox
+ * @param hc    Header Cache
+ * @param stats Snapshot of the message counts
+ * @retval  0 Success
+ * @retval -1 Error
+ */
+int maildir_hcache_store_stats(struct HeaderCache *hc, const struct MaildirStats *stats)
+{
+  if (!hc || !stats)
+    return 0;
+
+  return hcache_store_raw(hc, STATS_KEY, STATS_KEYLEN, (void *) stats, sizeof(*stats));
+}
+
 /**
  * maildir_hcache_store - Save an Email to the Header Cache
  * @param hc        Header Cache
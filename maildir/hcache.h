@@ -23,27 +23,67 @@
 #ifndef MUTT_MAILDIR_HCACHE_H
 #define MUTT_MAILDIR_HCACHE_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <sys/types.h>
+#include <time.h>
 
 struct Email;
 struct HeaderCache;
 struct Mailbox;
 
+/**
+ * struct MaildirStats - Snapshot of a Maildir's message counts
+ *
+ * Stored in the header cache so that mailbox statistics (e.g. for the
+ * Sidebar) can be answered with one cache fetch and two directory stat()s,
+ * instead of re-reading new/ and cur/.
+ *
+ * The total size can't be recounted without stat()ing every message, so it
+ * carries over the running total kept while the Mailbox was open.  It is 0
+ * for a Maildir that has only ever been counted, never opened.
+ */
+struct MaildirStats
+{
+  struct timespec new_mtime;    ///< mtime of new/ when the counts were taken
+  struct timespec cur_mtime;    ///< mtime of cur/ when the counts were taken
+  struct timespec last_visited; ///< Mailbox::last_visited the counts assumed
+  int msg_count;                ///< Total number of messages
+  int msg_unread;               ///< Number of unread messages
+  int msg_flagged;              ///< Number of flagged messages
+  int msg_new;                  ///< Number of new messages
+  bool has_new;                 ///< Mailbox has new mail
+  off_t size;                   ///< Total size of all messages, in bytes
+};
+
 #ifdef USE_HCACHE
 
-void                maildir_hcache_close (struct HeaderCache **ptr);
-int                 maildir_hcache_delete(struct HeaderCache *hc, struct Email *e);
-struct HeaderCache *maildir_hcache_open  (struct Mailbox *m);
-struct Email *      maildir_hcache_read  (struct HeaderCache *hc, struct Email *e, const char *fn);
-int                 maildir_hcache_store (struct HeaderCache *hc, struct Email *e);
+void                maildir_hcache_close     (struct HeaderCache **ptr);
+bool                maildir_hcache_compressed(struct HeaderCache *hc);
+int                 maildir_hcache_copy      (struct Mailbox *m_src, struct Email *e, struct Mailbox *m_dst, const char *path_dst);
+struct Email *      maildir_hcache_decode    (struct Email *e, const char *fn, const void *data, uint32_t uidvalidity);
+int                 maildir_hcache_delete    (struct HeaderCache *hc, struct Email *e);
+void *              maildir_hcache_fetch_raw (struct HeaderCache *hc, struct Email *e, uint32_t *uidvalidity);
+struct HeaderCache *maildir_hcache_open      (struct Mailbox *m);
+bool                maildir_hcache_fetch_stats(struct HeaderCache *hc, struct MaildirStats *stats);
+struct Email *      maildir_hcache_read      (struct HeaderCache *hc, struct Email *e, const char *fn);
+int                 maildir_hcache_store     (struct HeaderCache *hc, struct Email *e);
+int                 maildir_hcache_store_stats(struct HeaderCache *hc, const struct MaildirStats *stats);
 
 #else
 
-static inline void                maildir_hcache_close (struct HeaderCache **ptr) {}
-static inline int                 maildir_hcache_delete(struct HeaderCache *hc, struct Email *e) { return 0; }
-static inline struct HeaderCache *maildir_hcache_open  (struct Mailbox *m) { return NULL; }
-static inline struct Email *      maildir_hcache_read  (struct HeaderCache *hc, struct Email *e, const char *fn) { return NULL; }
-static inline int                 maildir_hcache_store (struct HeaderCache *hc, struct Email *e) { return 0; }
+static inline void                maildir_hcache_close     (struct HeaderCache **ptr) {}
+static inline bool                maildir_hcache_compressed(struct HeaderCache *hc) { return false; }
+static inline int                 maildir_hcache_copy      (struct Mailbox *m_src, struct Email *e, struct Mailbox *m_dst, const char *path_dst) { return -1; }
+static inline struct Email *      maildir_hcache_decode    (struct Email *e, const char *fn, const void *data, uint32_t uidvalidity) { return NULL; }
+static inline int                 maildir_hcache_delete    (struct HeaderCache *hc, struct Email *e) { return 0; }
+static inline void *              maildir_hcache_fetch_raw (struct HeaderCache *hc, struct Email *e, uint32_t *uidvalidity) { return NULL; }
+static inline struct HeaderCache *maildir_hcache_open      (struct Mailbox *m) { return NULL; }
+static inline bool                maildir_hcache_fetch_stats(struct HeaderCache *hc, struct MaildirStats *stats) { return false; }
+static inline struct Email *      maildir_hcache_read      (struct HeaderCache *hc, struct Email *e, const char *fn) { return NULL; }
+static inline int                 maildir_hcache_store     (struct HeaderCache *hc, struct Email *e) { return 0; }
+static inline int                 maildir_hcache_store_stats(struct HeaderCache *hc, const struct MaildirStats *stats) { return 0; }
 
 #endif
 
@@ -38,6 +38,7 @@
  * | maildir/message.c  | @subpage maildir_message  |
  * | maildir/path.c     | @subpage maildir_path     |
  * | maildir/shared.c   | @subpage maildir_shared   |
+ * | maildir/snapshot.c | @subpage maildir_snapshot |
  */
 
 #ifndef MUTT_MAILDIR_LIB_H
@@ -29,7 +29,12 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -45,6 +50,7 @@
 #include "mdemail.h"
 #include "mx.h"
 #include "shared.h"
+#include "snapshot.h"
 #include "sort.h"
 #ifdef USE_INOTIFY
 #include "monitor.h"
@@ -325,6 +331,308 @@ cleanup:
   return rc;
 }
 
+#ifdef USE_INOTIFY
+/**
+ * maildir_parse_delta - Read just the changed files of a Maildir
+ * @param[in]  m      Mailbox
+ * @param[out] mda    Array for results
+ * @param[in]  names  Filenames reported by the watch on 'new'
+ * @param[out] occult Set to true if a message disappeared
+ *
+ * Equivalent of maildir_parse_dir() for when the monitor knows exactly which
+ * files were added to or removed from 'new': stat each reported name instead
+ * of reading the whole directory.  Files that still exist are queued the same
+ * way a scan would queue them; messages whose file is gone, and wasn't just
+ * renamed to another reported name, are marked as removed.
+ */
+static void maildir_parse_delta(struct Mailbox *m, struct MdEmailArray *mda,
+                                struct ListHead *names, bool *occult)
+{
+  struct Buffer *buf = buf_pool_get();
+  struct Buffer *canon = buf_pool_get();
+  struct stat st = { 0 };
+  bool gone_any = false;
+
+  /* Canonical (sans flags) filenames seen alive / reported missing.
+   * A rename within the directory reports both the old and the new name;
+   * pairing them up by canonical name stops a flag change looking like a
+   * removal, and stops a twice-reported file being queued twice.  */
+  struct HashTable *seen = mutt_hash_new(MAX(m->msg_count, 64), MUTT_HASH_STRDUP_KEYS);
+  struct HashTable *gone = mutt_hash_new(MAX(m->msg_count, 64), MUTT_HASH_STRDUP_KEYS);
+
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, names, entries)
+  {
+    if (*np->data == '.')
+      continue;
+
+    buf_printf(buf, "new/%s", np->data);
+    maildir_canon_filename(canon, buf_string(buf));
+
+    buf_printf(buf, "%s/new/%s", mailbox_path(m), np->data);
+    if (stat(buf_string(buf), &st) == 0)
+    {
+      mutt_hash_delete(gone, buf_string(canon), NULL);
+      if (mutt_hash_find(seen, buf_string(canon)))
+        continue; /* reported more than once, e.g. created then closed */
+      mutt_hash_insert(seen, buf_string(canon), np->data);
+
+      mutt_debug(LL_DEBUG2, "queueing %s\n", np->data);
+
+      struct Email *e = maildir_email_new();
+      maildir_parse_flags(e, np->data);
+      buf_printf(buf, "new/%s", np->data);
+      e->path = buf_strdup(buf);
+
+      struct MdEmail *entry = maildir_entry_new();
+      entry->email = e;
+      entry->inode = st.st_ino;
+      ARRAY_ADD(mda, entry);
+    }
+    else
+    {
+      mutt_hash_insert(gone, buf_string(canon), np->data);
+      gone_any = true;
+    }
+  }
+
+  ARRAY_SORT(mda, maildir_sort_inode, NULL);
+
+  /* Anything reported missing without a surviving name has disappeared out
+   * from underneath us, so we need to simulate a "reopen" event.  */
+  if (gone_any)
+  {
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      struct Email *e = m->emails[i];
+      if (!e)
+        break;
+      if (!mutt_strn_equal(e->path, "new/", 4))
+        continue;
+
+      maildir_canon_filename(canon, e->path);
+      if (!mutt_hash_find(gone, buf_string(canon)))
+        continue;
+
+      *occult = true;
+      e->deleted = true;
+      e->purge = true;
+    }
+  }
+
+  mutt_hash_free(&seen);
+  mutt_hash_free(&gone);
+  buf_pool_release(&buf);
+  buf_pool_release(&canon);
+}
+#endif /* USE_INOTIFY */
+
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * struct MaildirParseWorker - State for one Maildir parser thread
+ */
+struct MaildirParseWorker
+{
+  pthread_t thread;          ///< Worker thread handle
+  struct MdEmailArray *mda;  ///< Shared array of messages to parse
+  const char *folder;        ///< Path to the Mailbox
+  size_t begin;              ///< First index this worker parses
+  size_t step;               ///< Stride between indices
+  void **blobs;              ///< Raw cache records, indexed like mda
+  uint32_t *uidvs;           ///< Validity timestamps of the records
+};
+
+/**
+ * maildir_parse_thread - Parse a shard of a Maildir - Worker thread
+ * @param arg MaildirParseWorker state
+ * @retval NULL Always
+ *
+ * Parse every step'th message, starting at begin.  Entries whose headers are
+ * already known are left alone; entries with a cache record are decoded from
+ * it; entries that fail to parse have their Email freed, which marks them for
+ * the caller.
+ */
+static void *maildir_parse_thread(void *arg)
+{
+  struct MaildirParseWorker *w = arg;
+  char fn[PATH_MAX] = { 0 };
+
+  for (size_t i = w->begin; i < ARRAY_SIZE(w->mda); i += w->step)
+  {
+    struct MdEmail *md = *ARRAY_GET(w->mda, i);
+    if (!md || !md->email || md->header_parsed)
+      continue;
+
+    snprintf(fn, sizeof(fn), "%s/%s", w->folder, md->email->path);
+
+    if (w->blobs && w->blobs[i])
+    {
+      struct Email *e = maildir_hcache_decode(md->email, fn, w->blobs[i], w->uidvs[i]);
+      FREE(&w->blobs[i]);
+      if (e)
+      {
+        email_free(&md->email);
+        md->email = e;
+        md->header_parsed = true;
+        continue;
+      }
+      // The record was stale - parse the file instead
+    }
+
+    if (!maildir_parse_message(fn, md->email->old, md->email))
+      email_free(&md->email);
+  }
+
+  return NULL;
+}
+
+/**
+ * maildir_parallel_parsing - Parse a Maildir using a pool of worker threads
+ * @param[in]  m        Mailbox
+ * @param[out] mda      Maildir array to parse
+ * @param[in]  hc       Header Cache
+ * @param[in]  progress Progress bar
+ * @retval true Parsing was handled by the workers
+ *
+ * The Header Cache isn't safe to share between threads, so the cache records
+ * are fetched up-front on this thread; decoding them, and parsing the misses,
+ * is sharded across the workers.  Freshly parsed headers are written back to
+ * the cache once the workers have finished.
+ */
+static bool maildir_parallel_parsing(struct Mailbox *m, struct MdEmailArray *mda,
+                                     struct HeaderCache *hc, struct Progress *progress)
+{
+  const short c_maildir_scan_threads = cs_subset_number(NeoMutt->sub, "maildir_scan_threads");
+  if ((c_maildir_scan_threads < 2) ||
+      (ARRAY_SIZE(mda) < (size_t) c_maildir_scan_threads))
+  {
+    return false;
+  }
+
+  char fn[PATH_MAX] = { 0 };
+  size_t num_unparsed = 0;
+
+  void **blobs = NULL;
+  uint32_t *uidvs = NULL;
+
+  struct MdEmail *md = NULL;
+  struct MdEmail **mdp = NULL;
+  if (hc && !maildir_hcache_compressed(hc))
+  {
+    // Fetch the raw cache records; the workers will decode them
+    blobs = mutt_mem_calloc(ARRAY_SIZE(mda), sizeof(*blobs));
+    uidvs = mutt_mem_calloc(ARRAY_SIZE(mda), sizeof(*uidvs));
+    ARRAY_FOREACH(mdp, mda)
+    {
+      md = *mdp;
+      if (!md || !md->email || md->header_parsed)
+        continue;
+
+      progress_update(progress, ARRAY_FOREACH_IDX, -1);
+
+      blobs[ARRAY_FOREACH_IDX] = maildir_hcache_fetch_raw(hc, md->email,
+                                                          &uidvs[ARRAY_FOREACH_IDX]);
+      num_unparsed++;
+    }
+  }
+  else
+  {
+    // Compressed records can't be fetched raw; decode them on this thread
+    ARRAY_FOREACH(mdp, mda)
+    {
+      md = *mdp;
+      if (!md || !md->email || md->header_parsed)
+        continue;
+
+      progress_update(progress, ARRAY_FOREACH_IDX, -1);
+
+      snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), md->email->path);
+      struct Email *e = maildir_hcache_read(hc, md->email, fn);
+      if (e)
+      {
+        email_free(&md->email);
+        md->email = e;
+        md->header_parsed = true;
+      }
+      else
+      {
+        num_unparsed++;
+      }
+    }
+  }
+
+  if (num_unparsed == 0)
+  {
+    FREE(&blobs);
+    FREE(&uidvs);
+    return true;
+  }
+
+  size_t num_workers = MIN((size_t) c_maildir_scan_threads, num_unparsed);
+  struct MaildirParseWorker *workers = mutt_mem_calloc(num_workers,
+                                                       sizeof(struct MaildirParseWorker));
+
+  size_t num_running = 0;
+  for (size_t i = 0; i < num_workers; i++)
+  {
+    workers[i].mda = mda;
+    workers[i].folder = mailbox_path(m);
+    workers[i].begin = i;
+    workers[i].step = num_workers;
+    workers[i].blobs = blobs;
+    workers[i].uidvs = uidvs;
+    if (pthread_create(&workers[i].thread, NULL, maildir_parse_thread, &workers[i]) != 0)
+      break;
+    num_running++;
+  }
+
+  if (num_running == 0)
+  {
+    // Couldn't start any workers, fall back to the serial path
+    if (blobs)
+    {
+      for (size_t i = 0; i < ARRAY_SIZE(mda); i++)
+        FREE(&blobs[i]);
+    }
+    FREE(&blobs);
+    FREE(&uidvs);
+    FREE(&workers);
+    return false;
+  }
+
+  // Parse any shards whose worker failed to start
+  for (size_t i = num_running; i < num_workers; i++)
+  {
+    workers[i].begin = i;
+    workers[i].step = num_workers;
+    workers[i].mda = mda;
+    workers[i].folder = mailbox_path(m);
+    workers[i].blobs = blobs;
+    workers[i].uidvs = uidvs;
+    maildir_parse_thread(&workers[i]);
+  }
+
+  for (size_t i = 0; i < num_running; i++)
+    pthread_join(workers[i].thread, NULL);
+  FREE(&workers);
+  FREE(&blobs);
+  FREE(&uidvs);
+
+  // The workers cleared the Emails that failed to parse
+  ARRAY_FOREACH(mdp, mda)
+  {
+    md = *mdp;
+    if (!md || !md->email || md->header_parsed)
+      continue;
+
+    md->header_parsed = true;
+    maildir_hcache_store(hc, md->email);
+  }
+
+  return true;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
  * @param[in]  m   Mailbox
@@ -338,6 +646,14 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
 
   struct HeaderCache *hc = maildir_hcache_open(m);
 
+#ifdef HAVE_PTHREAD_CREATE
+  if (maildir_parallel_parsing(m, mda, hc, progress))
+  {
+    maildir_hcache_close(&hc);
+    return;
+  }
+#endif
+
   struct MdEmail *md = NULL;
   struct MdEmail **mdp = NULL;
   ARRAY_FOREACH(mdp, mda)
@@ -391,7 +707,6 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
   struct stat st = { 0 };
 
   struct Buffer *path = buf_pool_get();
-  struct Buffer *msgpath = buf_pool_get();
   buf_printf(path, "%s/%s", mailbox_path(m), dir_name);
 
   /* when $mail_check_recent is set, if the new/ directory hasn't been modified since
@@ -443,9 +758,9 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
       {
         if (c_mail_check_recent)
         {
-          buf_printf(msgpath, "%s/%s", buf_string(path), de->d_name);
-          /* ensure this message was received since leaving this m */
-          if ((stat(buf_string(msgpath), &st) == 0) &&
+          /* ensure this message was received since leaving this m.
+           * stat relative to the open directory, saving the path walk */
+          if ((fstatat(dirfd(dir), de->d_name, &st, 0) == 0) &&
               (mutt_file_stat_timespec_compare(&st, MUTT_STAT_CTIME, &m->last_visited) <= 0))
           {
             continue;
@@ -468,7 +783,6 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
 
 cleanup:
   buf_pool_release(&path);
-  buf_pool_release(&msgpath);
 }
 
 /**
@@ -541,6 +855,7 @@ static enum MxStatus maildir_check(struct Mailbox *m)
   struct stat st_new = { 0 }; /* status of the "new" subdirectory */
   struct stat st_cur = { 0 }; /* status of the "cur" subdirectory */
   int changed = MMC_NO_DIRS;  /* which subdirectories have changed */
+  bool delta = false;         /* only the monitor-reported files were scanned */
   bool occult = false;        /* messages were removed from the mailbox */
   int num_new = 0;            /* number of new messages added to the mailbox */
   bool flags_changed = false; /* message flags were changed in the mailbox */
@@ -599,7 +914,24 @@ static enum MxStatus maildir_check(struct Mailbox *m)
   /* do a fast scan of just the filenames in
    * the subdirectories that have changed.  */
   struct MdEmailArray mda = ARRAY_HEAD_INITIALIZER;
+#ifdef USE_INOTIFY
+  /* The watch on new/ records which files changed; if the record is complete
+   * and cur/ is untouched, process just those files instead of re-scanning.
+   * The collection also resets the record, so it stays in step with a full
+   * scan.  */
   if (changed & MMC_NEW_DIR)
+  {
+    struct ListHead names = STAILQ_HEAD_INITIALIZER(names);
+    const bool complete = mutt_monitor_take_events(m, &names);
+    if (complete && (changed == MMC_NEW_DIR))
+    {
+      maildir_parse_delta(m, &mda, &names, &occult);
+      delta = true;
+    }
+    mutt_list_free(&names);
+  }
+#endif
+  if (!delta && (changed & MMC_NEW_DIR))
     maildir_parse_dir(m, &mda, "new", NULL);
   if (changed & MMC_CUR_DIR)
     maildir_parse_dir(m, &mda, "cur", NULL);
@@ -658,9 +990,12 @@ static enum MxStatus maildir_check(struct Mailbox *m)
     }
     /* This message was not in the list of messages we just scanned.
      * Check to see if we have enough information to know if the
-     * message has disappeared out from underneath us.  */
-    else if (((changed & MMC_NEW_DIR) && mutt_strn_equal(e->path, "new/", 4)) ||
-             ((changed & MMC_CUR_DIR) && mutt_strn_equal(e->path, "cur/", 4)))
+     * message has disappeared out from underneath us.  A delta scan
+     * only covers the changed files, so absence from it means nothing;
+     * removals were already handled by maildir_parse_delta().  */
+    else if (!delta &&
+             (((changed & MMC_NEW_DIR) && mutt_strn_equal(e->path, "new/", 4)) ||
+              ((changed & MMC_CUR_DIR) && mutt_strn_equal(e->path, "cur/", 4))))
     {
       /* This message disappeared, so we need to simulate a "reopen"
        * event.  We know it disappeared because we just scanned the
@@ -735,9 +1070,22 @@ void maildir_update_mtime(struct Mailbox *m)
  */
 enum MxOpenReturns maildir_mbox_open(struct Mailbox *m)
 {
+  const bool c_maildir_snapshot = cs_subset_bool(NeoMutt->sub, "maildir_snapshot");
+  if (c_maildir_snapshot && maildir_snapshot_read(m))
+    return MX_OPEN_OK;
+
+  /* Take the view generation before scanning, so a racing delivery
+   * invalidates the snapshot rather than going unnoticed */
+  struct MaildirGeneration gen = { 0 };
+  const bool can_snapshot = c_maildir_snapshot && !m->readonly && !m->peekonly &&
+                            maildir_generation_get(m, &gen);
+
   if ((maildir_read_dir(m, "new") == -1) || (maildir_read_dir(m, "cur") == -1))
     return MX_OPEN_ERROR;
 
+  if (can_snapshot)
+    maildir_snapshot_write(m, &gen);
+
   return MX_OPEN_OK;
 }
 
@@ -803,6 +1151,109 @@ enum MxStatus maildir_mbox_check(struct Mailbox *m)
   return maildir_check(m);
 }
 
+/**
+ * maildir_stats_dir_mtimes - Get the mtimes of a Mailbox's new/ and cur/
+ * @param[in]  m     Mailbox to stat
+ * @param[out] stats Snapshot to fill in
+ * @retval true Success
+ */
+static bool maildir_stats_dir_mtimes(struct Mailbox *m, struct MaildirStats *stats)
+{
+  struct stat st = { 0 };
+  struct Buffer *path = buf_pool_get();
+  bool rc = false;
+
+  buf_printf(path, "%s/new", mailbox_path(m));
+  if (stat(buf_string(path), &st) != 0)
+    goto done;
+  mutt_file_get_stat_timespec(&stats->new_mtime, &st, MUTT_STAT_MTIME);
+
+  buf_printf(path, "%s/cur", mailbox_path(m));
+  if (stat(buf_string(path), &st) != 0)
+    goto done;
+  mutt_file_get_stat_timespec(&stats->cur_mtime, &st, MUTT_STAT_MTIME);
+
+  rc = true;
+
+done:
+  buf_pool_release(&path);
+  return rc;
+}
+
+/**
+ * maildir_stats_fetch - Use a cached stats snapshot if the Mailbox is unchanged
+ * @param m Mailbox to count
+ * @retval true The cached counts were used
+ *
+ * The snapshot is only trusted if new/ and cur/ still have the mtimes it was
+ * taken with, and - under $mail_check_recent - the mailbox hasn't been
+ * visited since, as a visit changes which messages count as new.
+ */
+static bool maildir_stats_fetch(struct Mailbox *m)
+{
+  struct HeaderCache *hc = maildir_hcache_open(m);
+  if (!hc)
+    return false;
+
+  struct MaildirStats stats = { 0 };
+  const bool found = maildir_hcache_fetch_stats(hc, &stats);
+  maildir_hcache_close(&hc);
+  if (!found)
+    return false;
+
+  struct MaildirStats now = { 0 };
+  if (!maildir_stats_dir_mtimes(m, &now))
+    return false;
+
+  if ((mutt_file_timespec_compare(&now.new_mtime, &stats.new_mtime) != 0) ||
+      (mutt_file_timespec_compare(&now.cur_mtime, &stats.cur_mtime) != 0))
+  {
+    return false;
+  }
+
+  const bool c_mail_check_recent = cs_subset_bool(NeoMutt->sub, "mail_check_recent");
+  if (c_mail_check_recent &&
+      (mutt_file_timespec_compare(&stats.last_visited, &m->last_visited) != 0))
+  {
+    return false;
+  }
+
+  m->msg_count = stats.msg_count;
+  m->msg_unread = stats.msg_unread;
+  m->msg_flagged = stats.msg_flagged;
+  m->msg_new = stats.msg_new;
+  m->has_new = stats.has_new;
+  m->size = stats.size;
+  return true;
+}
+
+/**
+ * maildir_stats_store - Cache a stats snapshot of a Mailbox
+ * @param m     Mailbox that was counted
+ * @param stats Snapshot with the directory mtimes from before the count
+ *
+ * The mtimes must have been taken before the directories were read: if a
+ * delivery races with the count, the snapshot then simply fails to validate
+ * on the next check.
+ */
+static void maildir_stats_store(struct Mailbox *m, struct MaildirStats *stats)
+{
+  struct HeaderCache *hc = maildir_hcache_open(m);
+  if (!hc)
+    return;
+
+  stats->last_visited = m->last_visited;
+  stats->msg_count = m->msg_count;
+  stats->msg_unread = m->msg_unread;
+  stats->msg_flagged = m->msg_flagged;
+  stats->msg_new = m->msg_new;
+  stats->has_new = m->has_new;
+  stats->size = m->size;
+
+  maildir_hcache_store_stats(hc, stats);
+  maildir_hcache_close(&hc);
+}
+
 /**
  * maildir_mbox_check_stats - Check the Mailbox statistics - Implements MxOps::mbox_check_stats() - @ingroup mx_mbox_check_stats
  */
@@ -811,8 +1262,18 @@ enum MxStatus maildir_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   bool check_stats = flags & MUTT_MAILBOX_CHECK_STATS;
   bool check_new = true;
 
+  struct MaildirStats stats = { 0 };
+  bool can_snapshot = false;
+
   if (check_stats)
   {
+    if (maildir_stats_fetch(m))
+      return m->msg_new ? MX_STATUS_NEW_MAIL : MX_STATUS_OK;
+
+    /* Take the mtimes before reading, so a racing delivery invalidates the
+     * snapshot rather than going unnoticed */
+    can_snapshot = maildir_stats_dir_mtimes(m, &stats);
+
     m->msg_new = 0;
     m->msg_count = 0;
     m->msg_unread = 0;
@@ -826,6 +1287,9 @@ enum MxStatus maildir_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   if (check_new || check_stats)
     maildir_check_dir(m, "cur", check_new, check_stats);
 
+  if (check_stats && can_snapshot)
+    maildir_stats_store(m, &stats);
+
   return m->msg_new ? MX_STATUS_NEW_MAIL : MX_STATUS_OK;
 }
 
@@ -843,6 +1307,10 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
 
   struct HeaderCache *hc = maildir_hcache_open(m);
 
+  /* All the renames/unlinks are relative to this one fd, so each message
+   * costs a single directory operation instead of a full path walk */
+  int dirfd = open(mailbox_path(m), O_RDONLY | O_DIRECTORY);
+
   struct Progress *progress = NULL;
   if (m->verbose)
   {
@@ -855,13 +1323,15 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
     progress_update(progress, i, -1);
 
     struct Email *e = m->emails[i];
-    if (!maildir_sync_mailbox_message(m, e, hc))
+    if (!maildir_sync_mailbox_message(m, e, hc, dirfd))
     {
       progress_free(&progress);
       goto err;
     }
   }
   progress_free(&progress);
+  if (dirfd >= 0)
+    close(dirfd);
   maildir_hcache_close(&hc);
 
   /* XXX race condition? */
@@ -887,6 +1357,8 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
   return check;
 
 err:
+  if (dirfd >= 0)
+    close(dirfd);
   maildir_hcache_close(&hc);
   return MX_STATUS_ERROR;
 }
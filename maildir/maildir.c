@@ -58,6 +58,7 @@ const struct MxOps MxMaildirOps = {
   .msg_open_new     = maildir_msg_open_new,
   .msg_commit       = maildir_msg_commit,
   .msg_close        = maildir_msg_close,
+  .msg_copy_batch   = maildir_msg_copy_batch,
   .msg_padding_size = NULL,
   .msg_save_hcache  = maildir_msg_save_hcache,
   .tags_edit        = NULL,
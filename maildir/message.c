@@ -209,12 +209,16 @@ cleanup:
 
 /**
  * maildir_sync_message - Sync an email to a Maildir folder
- * @param m Mailbox
- * @param e Email
+ * @param m     Mailbox
+ * @param e     Email
+ * @param dirfd Open fd of the mailbox directory, or -1
  * @retval  0 Success
  * @retval -1 Error
+ *
+ * With a dirfd, the rename works on paths relative to it, saving the mailbox
+ * path lookup for every message.
  */
-static int maildir_sync_message(struct Mailbox *m, struct Email *e)
+static int maildir_sync_message(struct Mailbox *m, struct Email *e, int dirfd)
 {
   if (!m || !e)
     return -1;
@@ -264,10 +268,8 @@ static int maildir_sync_message(struct Mailbox *m, struct Email *e)
 
     buf_printf(partpath, "%s/%s%s", (e->read || e->old) ? "cur" : "new",
                buf_string(newpath), suffix);
-    buf_printf(fullpath, "%s/%s", mailbox_path(m), buf_string(partpath));
-    buf_printf(oldpath, "%s/%s", mailbox_path(m), e->path);
 
-    if (mutt_str_equal(buf_string(fullpath), buf_string(oldpath)))
+    if (mutt_str_equal(buf_string(partpath), e->path))
     {
       /* message hasn't really changed */
       goto cleanup;
@@ -277,17 +279,38 @@ static int maildir_sync_message(struct Mailbox *m, struct Email *e)
     e->trash = e->deleted;
 
     struct stat st = { 0 };
-    if (stat(buf_string(oldpath), &st) == -1)
+    if (dirfd >= 0)
     {
-      mutt_debug(LL_DEBUG1, "File already removed (just continuing)");
-      goto cleanup;
-    }
+      if (fstatat(dirfd, e->path, &st, 0) == -1)
+      {
+        mutt_debug(LL_DEBUG1, "File already removed (just continuing)");
+        goto cleanup;
+      }
 
-    if (rename(buf_string(oldpath), buf_string(fullpath)) != 0)
+      if (renameat(dirfd, e->path, dirfd, buf_string(partpath)) != 0)
+      {
+        mutt_perror("renameat");
+        rc = -1;
+        goto cleanup;
+      }
+    }
+    else
     {
-      mutt_perror("rename");
-      rc = -1;
-      goto cleanup;
+      buf_printf(fullpath, "%s/%s", mailbox_path(m), buf_string(partpath));
+      buf_printf(oldpath, "%s/%s", mailbox_path(m), e->path);
+
+      if (stat(buf_string(oldpath), &st) == -1)
+      {
+        mutt_debug(LL_DEBUG1, "File already removed (just continuing)");
+        goto cleanup;
+      }
+
+      if (rename(buf_string(oldpath), buf_string(fullpath)) != 0)
+      {
+        mutt_perror("rename");
+        rc = -1;
+        goto cleanup;
+      }
     }
     mutt_str_replace(&e->path, buf_string(partpath));
   }
@@ -306,10 +329,12 @@ cleanup:
  * @param m     Mailbox
  * @param e     Email
  * @param hc    Header cache handle
+ * @param dirfd Open fd of the mailbox directory, or -1
  * @retval true Success
  * @retval false Error
  */
-bool maildir_sync_mailbox_message(struct Mailbox *m, struct Email *e, struct HeaderCache *hc)
+bool maildir_sync_mailbox_message(struct Mailbox *m, struct Email *e,
+                                  struct HeaderCache *hc, int dirfd)
 {
   if (!e)
     return false;
@@ -317,15 +342,22 @@ bool maildir_sync_mailbox_message(struct Mailbox *m, struct Email *e, struct Hea
   const bool c_maildir_trash = cs_subset_bool(NeoMutt->sub, "maildir_trash");
   if (e->deleted && !c_maildir_trash)
   {
-    char path[PATH_MAX] = { 0 };
-    snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
     maildir_hcache_delete(hc, e);
-    unlink(path);
+    if (dirfd >= 0)
+    {
+      unlinkat(dirfd, e->path, 0);
+    }
+    else
+    {
+      char path[PATH_MAX] = { 0 };
+      snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
+      unlink(path);
+    }
   }
   else if (e->changed || e->attach_del ||
            ((c_maildir_trash || e->trash) && (e->deleted != e->trash)))
   {
-    if (maildir_sync_message(m, e) == -1)
+    if (maildir_sync_message(m, e, dirfd) == -1)
       return false;
   }
 
@@ -364,6 +396,9 @@ static int maildir_commit_message(struct Mailbox *m, struct Message *msg, struct
   char suffix[PATH_MAX] = { 0 };
   int rc = 0;
 
+  // Take the size from the open stream - no need to stat() the file later
+  const long size = mutt_file_get_size_fp(msg->fp);
+
   if (mutt_file_fsync_close(&msg->fp))
   {
     mutt_perror(_("Could not flush message to disk"));
@@ -427,6 +462,9 @@ static int maildir_commit_message(struct Mailbox *m, struct Message *msg, struct
       mutt_str_replace(&msg->committed_path, buf_string(full));
       FREE(&msg->path);
 
+      if (size > 0)
+        m->size += size;
+
       goto cleanup;
     }
     else if (errno != EEXIST)
@@ -461,6 +499,7 @@ int maildir_rewrite_message(struct Mailbox *m, struct Email *e)
   long old_body_offset = e->body->offset;
   long old_body_length = e->body->length;
   long old_hdr_lines = e->lines;
+  const size_t old_size = email_size(e);
 
   struct Message *src = mx_msg_open(m, e);
   struct Message *dest = mx_msg_open_new(m, e, MUTT_MSG_NO_FLAGS);
@@ -480,6 +519,8 @@ int maildir_rewrite_message(struct Mailbox *m, struct Email *e)
     if (rc == 0)
     {
       unlink(oldpath);
+      // maildir_commit_message() counted the rewritten file's bytes
+      m->size -= old_size;
       restore = false;
     }
   }
@@ -493,12 +534,54 @@ int maildir_rewrite_message(struct Mailbox *m, struct Email *e)
     e->lines = old_hdr_lines;
   }
 
-  mutt_body_free(&e->body->parts);
+  email_parts_invalidate(e);
   return rc;
 }
 
 // Mailbox API -----------------------------------------------------------------
 
+#ifdef HAVE_POSIX_FADVISE
+/**
+ * maildir_advise_neighbours - Ask the kernel to read ahead the adjacent messages
+ * @param m Mailbox
+ * @param e Email that has just been opened
+ *
+ * After reading a message, the user usually moves to the next or previous one
+ * in the current sort order.  Hint the kernel to pull those files into the
+ * page cache while the current message is being read; on a cold cache this
+ * hides most of the seek latency of the next open.
+ */
+static void maildir_advise_neighbours(struct Mailbox *m, struct Email *e)
+{
+  if (!m->v2r || (e->vnum < 0))
+    return;
+
+  char path[PATH_MAX] = { 0 };
+
+  for (int offset = -1; offset <= 1; offset += 2)
+  {
+    const int vnum = e->vnum + offset;
+    if ((vnum < 0) || (vnum >= m->vcount))
+      continue;
+
+    const int msgno = m->v2r[vnum];
+    if ((msgno < 0) || (msgno >= m->msg_count))
+      continue;
+
+    struct Email *e_adj = m->emails[msgno];
+    if (!e_adj || !e_adj->path)
+      continue;
+
+    snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e_adj->path);
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+      continue;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+  }
+}
+#endif
+
 /**
  * maildir_msg_open - Open an email message in a Mailbox - Implements MxOps::msg_open() - @ingroup mx_msg_open
  */
@@ -518,6 +601,12 @@ bool maildir_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e)
     return false;
   }
 
+#ifdef HAVE_POSIX_FADVISE
+  // The message will be parsed front to back
+  posix_fadvise(fileno(msg->fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+  maildir_advise_neighbours(m, e);
+#endif
+
   return true;
 }
 
@@ -616,6 +705,75 @@ int maildir_msg_close(struct Mailbox *m, struct Message *msg)
   return mutt_file_fclose(&msg->fp);
 }
 
+/**
+ * maildir_msg_copy_batch - Copy a set of messages to another Mailbox - Implements MxOps::msg_copy_batch() - @ingroup mx_msg_copy_batch
+ *
+ * Both Mailboxes are directories of one-file-per-message, so a verbatim copy
+ * doesn't need to read the messages at all: hard-link each source file to a
+ * fresh maildir name in the target.  If the Mailboxes are on different
+ * filesystems, the first link fails with EXDEV and the caller falls back to
+ * copying the messages one at a time.
+ */
+int maildir_msg_copy_batch(struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst)
+{
+  if ((m_src->type != MUTT_MAILDIR) && (m_src->type != MUTT_MH))
+    return 1;
+
+  int rc = 0;
+  struct Buffer *src = buf_pool_get();
+  struct Buffer *dst = buf_pool_get();
+  char suffix[PATH_MAX] = { 0 };
+
+  struct Email **ep = NULL;
+  ARRAY_FOREACH(ep, ea)
+  {
+    struct Email *e = *ep;
+
+    buf_printf(src, "%s/%s", mailbox_path(m_src), e->path);
+
+    /* The copy gets a fresh set of flags, as in maildir_msg_open_new() */
+    struct Email tmp = *e;
+    tmp.deleted = false;
+    tmp.edata = NULL;
+    maildir_gen_flags(suffix, sizeof(suffix), &tmp);
+
+    const char *subdir = (e->read || e->old) ? "cur" : "new";
+
+    while (true)
+    {
+      buf_printf(dst, "%s/%s/%lld.R%" PRIu64 ".%s%s", mailbox_path(m_dst),
+                 subdir, (long long) mutt_date_now(), mutt_rand64(),
+                 NONULL(ShortHostname), suffix);
+
+      mutt_debug(LL_DEBUG2, "linking %s to %s\n", buf_string(src), buf_string(dst));
+
+      if (link(buf_string(src), buf_string(dst)) == 0)
+        break;
+
+      if (errno == EEXIST)
+        continue;
+
+      if ((ARRAY_FOREACH_IDX == 0) &&
+          ((errno == EXDEV) || (errno == EPERM) || (errno == EMLINK) || (errno == ENOENT)))
+      {
+        /* This pair of directories can't be linked - copy the long way round */
+        rc = 1;
+      }
+      else
+      {
+        mutt_perror("%s", buf_string(dst));
+        rc = -1;
+      }
+      goto done;
+    }
+  }
+
+done:
+  buf_pool_release(&src);
+  buf_pool_release(&dst);
+  return rc;
+}
+
 /**
  * maildir_msg_save_hcache - Save message to the header cache - Implements MxOps::msg_save_hcache() - @ingroup mx_msg_save_hcache
  */
@@ -26,11 +26,13 @@
 #include <stdbool.h>
 
 struct Email;
+struct EmailArray;
 struct Mailbox;
 struct Message;
 
 int  maildir_msg_close      (struct Mailbox *m, struct Message *msg);
 int  maildir_msg_commit     (struct Mailbox *m, struct Message *msg);
+int  maildir_msg_copy_batch (struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst);
 bool maildir_msg_open_new   (struct Mailbox *m, struct Message *msg, const struct Email *e);
 bool maildir_msg_open       (struct Mailbox *m, struct Message *msg, struct Email *e);
 int  maildir_msg_save_hcache(struct Mailbox *m, struct Email *e);
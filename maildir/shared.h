@@ -48,7 +48,7 @@ bool          maildir_parse_message       (const char *fname, bool is_old, struc
 bool          maildir_parse_stream        (FILE *fp, const char *fname, bool is_old, struct Email *e);
 int           maildir_path_is_empty       (struct Buffer *path);
 int           maildir_rewrite_message     (struct Mailbox *m, struct Email *e);
-bool          maildir_sync_mailbox_message(struct Mailbox *m, struct Email *e, struct HeaderCache *hc);
+bool          maildir_sync_mailbox_message(struct Mailbox *m, struct Email *e, struct HeaderCache *hc, int dirfd);
 void          maildir_update_mtime        (struct Mailbox *m);
 
 #endif /* MUTT_MAILDIR_SHARED_H */
@@ -0,0 +1,346 @@
+/**
+ * @file
+ * Maildir header-state snapshots
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page maildir_snapshot Maildir header-state snapshots
+ *
+ * When `$maildir_snapshot` is set, the first reader of a Maildir leaves its
+ * parsed header state behind in a `.neomutt_snapshot` file at the root of the
+ * mailbox.  Further readers whose view generation matches - the mtimes of
+ * 'new' and 'cur' are unchanged - attach to that state with one sequential
+ * read instead of opening every message file again.
+ *
+ * The snapshot stores each message's raw header block, so attaching runs the
+ * ordinary RFC822 parser over a single stream; nothing is trusted that the
+ * parser wouldn't accept from the message file itself.  Flags are re-derived
+ * from the stored filenames, exactly as a directory scan would derive them.
+ */
+
+#include "config.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "snapshot.h"
+#include "progress/lib.h"
+#include "mdata.h"
+#include "mx.h"
+#include "shared.h"
+
+/// Name of the snapshot file, relative to the mailbox
+#define SNAPSHOT_FILE ".neomutt_snapshot"
+
+/// First line of a snapshot; bump the number when the format changes
+#define SNAPSHOT_MAGIC "NeoMutt-Maildir-Snapshot 1"
+
+/**
+ * maildir_generation_get - Read the current view generation of a Maildir
+ * @param[in]  m   Mailbox to stat
+ * @param[out] gen Generation to fill in
+ * @retval true Success
+ *
+ * Take the generation *before* scanning the directories: a delivery that
+ * races with the scan then simply invalidates the snapshot stamped with it,
+ * rather than going unnoticed.
+ */
+bool maildir_generation_get(struct Mailbox *m, struct MaildirGeneration *gen)
+{
+  struct stat st = { 0 };
+  struct Buffer *path = buf_pool_get();
+  bool rc = false;
+
+  buf_printf(path, "%s/new", mailbox_path(m));
+  if (stat(buf_string(path), &st) != 0)
+    goto done;
+  mutt_file_get_stat_timespec(&gen->new_mtime, &st, MUTT_STAT_MTIME);
+
+  buf_printf(path, "%s/cur", mailbox_path(m));
+  if (stat(buf_string(path), &st) != 0)
+    goto done;
+  mutt_file_get_stat_timespec(&gen->cur_mtime, &st, MUTT_STAT_MTIME);
+
+  rc = true;
+
+done:
+  buf_pool_release(&path);
+  return rc;
+}
+
+/**
+ * snapshot_read_email - Read one message's header state from a snapshot
+ * @param fp Snapshot file, positioned at an entry line
+ * @retval ptr Parsed Email
+ * @retval NULL Malformed entry
+ */
+static struct Email *snapshot_read_email(FILE *fp)
+{
+  char line[PATH_MAX + 64] = { 0 };
+  if (!fgets(line, sizeof(line), fp))
+    return NULL;
+
+  long long hdr_len = 0;
+  long long length = 0;
+  long long received = 0;
+  int pos = 0;
+  if (sscanf(line, "%lld %lld %lld %n", &hdr_len, &length, &received, &pos) != 3)
+    return NULL;
+  if ((hdr_len <= 0) || (length < 0))
+    return NULL;
+
+  char *path = line + pos;
+  size_t plen = mutt_str_len(path);
+  if ((plen < 2) || (path[plen - 1] != '\n'))
+    return NULL;
+  path[plen - 1] = '\0';
+
+  const off_t hdr_start = ftello(fp);
+
+  struct Email *e = maildir_email_new();
+  e->path = mutt_str_dup(path);
+  e->old = mutt_strn_equal(path, "cur/", 4);
+  maildir_parse_flags(e, path);
+
+  e->env = mutt_rfc822_read_header(fp, e, false, false);
+
+  /* The offsets belong to the message file the headers were copied from,
+   * not to the snapshot */
+  e->body->offset = hdr_len;
+  e->body->length = length;
+  e->received = received;
+  if (e->received == 0)
+    e->received = e->date_sent;
+  e->index = -1;
+
+  /* Step over the header block and its separator, wherever the parser
+   * stopped */
+  if (fseeko(fp, hdr_start + hdr_len + 1, SEEK_SET) != 0)
+  {
+    email_free(&e);
+    return NULL;
+  }
+
+  return e;
+}
+
+/**
+ * maildir_snapshot_read - Attach to a Maildir's snapshot
+ * @param m Mailbox to populate
+ * @retval true The Mailbox was populated from the snapshot
+ *
+ * The Mailbox is only touched if the whole snapshot is read successfully;
+ * any mismatch or truncation leaves it empty for a normal directory scan.
+ */
+bool maildir_snapshot_read(struct Mailbox *m)
+{
+  if (!m)
+    return false;
+
+  struct MaildirGeneration now = { 0 };
+  if (!maildir_generation_get(m, &now))
+    return false;
+
+  struct Buffer *buf = buf_pool_get();
+  buf_printf(buf, "%s/%s", mailbox_path(m), SNAPSHOT_FILE);
+  FILE *fp = mutt_file_fopen(buf_string(buf), "r");
+  buf_pool_release(&buf);
+  if (!fp)
+    return false;
+
+  bool rc = false;
+  int count = 0;
+  struct EmailArray ea = ARRAY_HEAD_INITIALIZER;
+  struct Progress *progress = NULL;
+  char line[PATH_MAX + 64] = { 0 };
+
+  if (!fgets(line, sizeof(line), fp) || !mutt_str_equal(line, SNAPSHOT_MAGIC "\n"))
+    goto done;
+
+  struct MaildirGeneration gen = { 0 };
+  long long sec[2] = { 0 };
+  long nsec[2] = { 0 };
+  if (!fgets(line, sizeof(line), fp) ||
+      (sscanf(line, "%lld %ld %lld %ld", &sec[0], &nsec[0], &sec[1], &nsec[1]) != 4))
+  {
+    goto done;
+  }
+  gen.new_mtime.tv_sec = sec[0];
+  gen.new_mtime.tv_nsec = nsec[0];
+  gen.cur_mtime.tv_sec = sec[1];
+  gen.cur_mtime.tv_nsec = nsec[1];
+
+  /* Another generation means the directories have changed since the snapshot
+   * was taken - scan them instead */
+  if ((mutt_file_timespec_compare(&now.new_mtime, &gen.new_mtime) != 0) ||
+      (mutt_file_timespec_compare(&now.cur_mtime, &gen.cur_mtime) != 0))
+  {
+    goto done;
+  }
+
+  if (!fgets(line, sizeof(line), fp) || (sscanf(line, "%d", &count) != 1) || (count < 0))
+    goto done;
+
+  if (m->verbose)
+  {
+    progress = progress_new(MUTT_PROGRESS_READ, count);
+    progress_set_message(progress, _("Reading %s..."), mailbox_path(m));
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    progress_update(progress, i, -1);
+    struct Email *e = snapshot_read_email(fp);
+    if (!e)
+      goto done;
+    ARRAY_ADD(&ea, e);
+  }
+
+  struct Email **ep = NULL;
+  ARRAY_FOREACH(ep, &ea)
+  {
+    mx_alloc_memory(m, m->msg_count);
+    m->emails[m->msg_count] = *ep;
+    m->emails[m->msg_count]->index = m->msg_count;
+    mailbox_size_add(m, *ep);
+    m->msg_count++;
+  }
+  ARRAY_FREE(&ea);
+
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  if (!mdata)
+  {
+    mdata = maildir_mdata_new();
+    m->mdata = mdata;
+    m->mdata_free = maildir_mdata_free;
+  }
+  if (!mdata->umask)
+    mdata->umask = maildir_umask(m);
+
+  mutt_debug(LL_DEBUG1, "attached to snapshot of %s: %d messages\n",
+             mailbox_path(m), count);
+  rc = true;
+
+done:
+  progress_free(&progress);
+  struct Email **ep2 = NULL;
+  ARRAY_FOREACH(ep2, &ea)
+  {
+    email_free(ep2);
+  }
+  ARRAY_FREE(&ea);
+  mutt_file_fclose(&fp);
+  return rc;
+}
+
+/**
+ * snapshot_write_email - Write one message's header state to a snapshot
+ * @param fp     Snapshot file
+ * @param folder Path of the mailbox
+ * @param e      Email to write
+ * @retval true Success
+ *
+ * The raw header block is copied straight from the message file, so the
+ * snapshot holds exactly what a fresh parse would see.
+ */
+static bool snapshot_write_email(FILE *fp, const char *folder, struct Email *e)
+{
+  if (e->body->offset <= 0)
+    return false;
+
+  struct Buffer *path = buf_pool_get();
+  buf_printf(path, "%s/%s", folder, e->path);
+  FILE *fp_msg = mutt_file_fopen(buf_string(path), "r");
+  buf_pool_release(&path);
+  if (!fp_msg)
+    return false;
+
+  bool rc = false;
+  fprintf(fp, "%lld %lld %lld %s\n", (long long) e->body->offset,
+          (long long) e->body->length, (long long) e->received, e->path);
+  if (mutt_file_copy_bytes(fp_msg, fp, e->body->offset) != 0)
+    goto done;
+  if (fputc('\n', fp) == EOF)
+    goto done;
+
+  rc = true;
+
+done:
+  mutt_file_fclose(&fp_msg);
+  return rc;
+}
+
+/**
+ * maildir_snapshot_write - Leave a snapshot of a Maildir's header state
+ * @param m   Mailbox that was scanned
+ * @param gen Generation taken before the scan
+ *
+ * The snapshot is assembled in a temporary file and renamed into place, so
+ * concurrent readers only ever see a complete one.  Failure just costs the
+ * next reader a directory scan, so errors are quietly discarded.
+ */
+void maildir_snapshot_write(struct Mailbox *m, const struct MaildirGeneration *gen)
+{
+  if (!m || !gen)
+    return;
+
+  struct Buffer *tmp = buf_pool_get();
+  struct Buffer *path = buf_pool_get();
+  buf_printf(tmp, "%s/" SNAPSHOT_FILE ".%d", mailbox_path(m), (int) getpid());
+  buf_printf(path, "%s/%s", mailbox_path(m), SNAPSHOT_FILE);
+
+  FILE *fp = mutt_file_fopen(buf_string(tmp), "w");
+  if (!fp)
+    goto done;
+
+  fprintf(fp, "%s\n", SNAPSHOT_MAGIC);
+  fprintf(fp, "%lld %ld %lld %ld\n", (long long) gen->new_mtime.tv_sec,
+          gen->new_mtime.tv_nsec, (long long) gen->cur_mtime.tv_sec,
+          gen->cur_mtime.tv_nsec);
+  fprintf(fp, "%d\n", m->msg_count);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    if (!snapshot_write_email(fp, mailbox_path(m), m->emails[i]))
+      goto fail;
+  }
+
+  if ((fflush(fp) == EOF) || ferror(fp))
+    goto fail;
+  mutt_file_fclose(&fp);
+
+  if (rename(buf_string(tmp), buf_string(path)) != 0)
+    unlink(buf_string(tmp));
+  goto done;
+
+fail:
+  mutt_file_fclose(&fp);
+  unlink(buf_string(tmp));
+
+done:
+  buf_pool_release(&tmp);
+  buf_pool_release(&path);
+}
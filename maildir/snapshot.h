@@ -0,0 +1,48 @@
+/**
+ * @file
+ * Maildir header-state snapshots
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MAILDIR_SNAPSHOT_H
+#define MUTT_MAILDIR_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <time.h>
+
+struct Mailbox;
+
+/**
+ * struct MaildirGeneration - View generation of a Maildir
+ *
+ * A snapshot is only valid for the exact state of the directories it was
+ * taken from, identified by the mtimes of 'new' and 'cur'.  Any delivery,
+ * sync or external change bumps one of them and invalidates the snapshot.
+ */
+struct MaildirGeneration
+{
+  struct timespec new_mtime; ///< mtime of the 'new' dir
+  struct timespec cur_mtime; ///< mtime of the 'cur' dir
+};
+
+bool maildir_generation_get(struct Mailbox *m, struct MaildirGeneration *gen);
+bool maildir_snapshot_read (struct Mailbox *m);
+void maildir_snapshot_write(struct Mailbox *m, const struct MaildirGeneration *gen);
+
+#endif /* MUTT_MAILDIR_SNAPSHOT_H */
@@ -29,6 +29,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
@@ -37,6 +38,64 @@
 #include "muttlib.h"
 #include "sort.h"
 
+#define ML_VALID      (1 << 0) ///< Cache entry has been computed
+#define ML_LIST       (1 << 1) ///< Address matches 'lists'
+#define ML_SUBSCRIBED (1 << 2) ///< Address matches 'subscribe'
+
+/// Map of address to ML_* flags - matching runs every list regex, so the
+/// results are cached for the index, which tests the same addresses per row
+static struct HashTable *MailListCache = NULL;
+/// Value of #MailListsGeneration when the cache was created
+static unsigned int CacheGeneration = 0;
+
+/**
+ * maillist_lookup - Match an address against the mailing-list regexes
+ * @param addr Address to test
+ * @retval num ML_* flags, e.g. #ML_SUBSCRIBED
+ *
+ * Results are cached per address until the list patterns change
+ * (`lists`, `subscribe`, `unlists`, `unsubscribe`, $auto_subscribe).
+ */
+static int maillist_lookup(const struct Address *addr)
+{
+  if (MailListCache && (CacheGeneration != MailListsGeneration))
+    mutt_hash_free(&MailListCache);
+
+  if (!MailListCache)
+  {
+    MailListCache = mutt_hash_new(256, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+    CacheGeneration = MailListsGeneration;
+  }
+
+  const char *mailbox = buf_string(addr->mailbox);
+  int ml = (intptr_t) mutt_hash_find(MailListCache, mailbox);
+  if (ml != 0)
+    return ml;
+
+  ml = ML_VALID;
+  if (!mutt_regexlist_match(&UnMailLists, mailbox))
+  {
+    if (mutt_regexlist_match(&MailLists, mailbox))
+      ml |= ML_LIST;
+    if (!mutt_regexlist_match(&UnSubscribedLists, mailbox) &&
+        mutt_regexlist_match(&SubscribedLists, mailbox))
+    {
+      ml |= ML_SUBSCRIBED;
+    }
+  }
+
+  mutt_hash_insert(MailListCache, mailbox, (void *) (intptr_t) ml);
+  return ml;
+}
+
+/**
+ * mutt_maillist_cleanup - Free the mailing-list match cache
+ */
+void mutt_maillist_cleanup(void)
+{
+  mutt_hash_free(&MailListCache);
+}
+
 /**
  * mutt_is_mail_list - Is this the email address of a mailing list? - Implements ::addr_predicate_t - @ingroup addr_predicate_api
  * @param addr Address to test
@@ -44,9 +103,7 @@
  */
 bool mutt_is_mail_list(const struct Address *addr)
 {
-  if (!mutt_regexlist_match(&UnMailLists, buf_string(addr->mailbox)))
-    return mutt_regexlist_match(&MailLists, buf_string(addr->mailbox));
-  return false;
+  return maillist_lookup(addr) & ML_LIST;
 }
 
 /**
@@ -56,12 +113,7 @@ bool mutt_is_mail_list(const struct Address *addr)
  */
 bool mutt_is_subscribed_list(const struct Address *addr)
 {
-  if (!mutt_regexlist_match(&UnMailLists, buf_string(addr->mailbox)) &&
-      !mutt_regexlist_match(&UnSubscribedLists, buf_string(addr->mailbox)))
-  {
-    return mutt_regexlist_match(&SubscribedLists, buf_string(addr->mailbox));
-  }
-  return false;
+  return maillist_lookup(addr) & ML_SUBSCRIBED;
 }
 
 /**
@@ -34,5 +34,6 @@ bool check_for_mailing_list_addr(struct AddressList *al, char *buf, int buflen);
 bool first_mailing_list         (char *buf, size_t buflen, struct AddressList *al);
 bool mutt_is_mail_list          (const struct Address *addr);
 bool mutt_is_subscribed_list    (const struct Address *addr);
+void mutt_maillist_cleanup      (void);
 
 #endif /* MUTT_MAILLIST_H */
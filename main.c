@@ -70,6 +70,7 @@
  * | File            | Description                |
  * | :-------------- | :------------------------- |
  * | alternates.c    | @subpage neo_alternates    |
+ * | background.c    | @subpage neo_background    |
  * | commands.c      | @subpage neo_commands      |
  * | copy.c          | @subpage neo_copy          |
  * | editmsg.c       | @subpage neo_editmsg       |
@@ -162,21 +163,28 @@
 #include "menu/lib.h"
 #include "ncrypt/lib.h"
 #include "nntp/lib.h"
+#include "pattern/lib.h"
 #include "pop/lib.h"
 #include "postpone/lib.h"
 #include "question/lib.h"
 #include "send/lib.h"
 #include "alternates.h"
+#include "background.h"
 #include "external.h"
 #include "globals.h"
 #include "hook.h"
 #include "init.h"
+#include "msgid.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
 #include "muttlib.h"
+#include "prefetch.h"
+#include "rccache.h"
+#include "session.h"
 #include "mx.h"
 #include "nntp/adata.h" // IWYU pragma: keep
 #include "protos.h"
+#include "rfc3676.h"
 #include "subjectrx.h"
 #include "version.h"
 #ifdef ENABLE_NLS
@@ -299,6 +307,7 @@ static bool usage(void)
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -d <level> -l <file>"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -G"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -g <server>"));
+  puts(_("  neomutt [-n] [-e <command>] [-F <config>] [-f <mailbox>] -j <pattern>"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -p"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -Q <variable> [-O]"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -Z"));
@@ -330,6 +339,8 @@ static bool usage(void)
   puts(_("  -H <draft>    Specify a draft file with header and body for message composing"));
   puts(_("  -h            Print this help message and exit"));
   puts(_("  -i <include>  Specify an include file to be embedded in the body of a message"));
+  puts(_("  -j <pattern>  Print the messages matching the pattern, one JSON object per\n"
+         "                line, to stdout and exit (use -f to pick the mailbox)"));
   puts(_("  -l <file>     Specify a file for debugging output (default \"~/.neomuttdebug0\")"));
   puts(_("  -m <type>     Specify a default mailbox format type for newly created folders\n"
          "                The type is either MH, MMDF, Maildir or mbox (case-insensitive)"));
@@ -353,6 +364,120 @@ static bool usage(void)
   return !ferror(stdout);
 }
 
+/**
+ * json_print_string - Write a JSON string literal to stdout
+ * @param s String to quote, may be NULL
+ *
+ * Quotes, backslashes and control characters are escaped as required by JSON.
+ * A NULL string is written as an empty string.
+ */
+static void json_print_string(const char *s)
+{
+  fputc('"', stdout);
+  for (; s && *s; s++)
+  {
+    unsigned char c = *s;
+    if ((c == '"') || (c == '\\'))
+      printf("\\%c", c);
+    else if (c < 0x20)
+      printf("\\u%04x", c);
+    else
+      fputc(c, stdout);
+  }
+  fputc('"', stdout);
+}
+
+/**
+ * query_messages - Print the messages matching a pattern and exit
+ * @param folder      Mailbox to search
+ * @param pattern_str Pattern to match, e.g. "~N"
+ * @retval 0 Success
+ * @retval 1 Error
+ *
+ * Open the mailbox read-only with #MUTT_PEEK, so nothing is changed, and
+ * write one JSON object per matching message to stdout.  Curses is never
+ * initialised, giving scripts a query interface without the cost of a full
+ * interactive startup.
+ */
+static int query_messages(struct Buffer *folder, const char *pattern_str)
+{
+  if (buf_is_empty(folder))
+  {
+    const char *const c_spool_file = cs_subset_string(NeoMutt->sub, "spool_file");
+    buf_strcpy(folder, c_spool_file);
+  }
+  if (buf_is_empty(folder))
+  {
+    mutt_error(_("No mailbox specified"));
+    return 1;
+  }
+  buf_expand_path(folder);
+
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, pattern_str,
+                                              MUTT_PC_FULL_MSG, err);
+  if (!pat)
+  {
+    mutt_error("%s", buf_string(err));
+    buf_pool_release(&err);
+    return 1;
+  }
+  buf_pool_release(&err);
+
+  int rc = 1;
+  struct Mailbox *m = mx_path_resolve(buf_string(folder));
+  if (!m)
+    goto done;
+
+  if (!mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK))
+  {
+    mutt_error(_("Can't open mailbox %s"), buf_string(folder));
+    mailbox_free(&m);
+    goto done;
+  }
+
+  struct Buffer *buf = buf_pool_get();
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || e->deleted)
+      continue;
+    if (!mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      continue;
+
+    printf("{\"index\":%d,\"date\":%lld,", i, (long long) e->date_sent);
+
+    buf_reset(buf);
+    mutt_addrlist_write(&e->env->from, buf, false);
+    fputs("\"from\":", stdout);
+    json_print_string(buf_string(buf));
+
+    buf_reset(buf);
+    mutt_addrlist_write(&e->env->to, buf, false);
+    fputs(",\"to\":", stdout);
+    json_print_string(buf_string(buf));
+
+    fputs(",\"subject\":", stdout);
+    json_print_string(e->env->subject);
+
+    fputs(",\"message_id\":", stdout);
+    json_print_string(e->env->message_id);
+
+    printf(",\"unread\":%s,\"flagged\":%s}\n", e->read ? "false" : "true",
+           e->flagged ? "true" : "false");
+  }
+  buf_pool_release(&buf);
+  rc = ferror(stdout) ? 1 : 0;
+  fflush(stdout);
+
+  mx_mbox_close(m);
+  mailbox_free(&m);
+
+done:
+  mutt_pattern_free(&pat);
+  return rc;
+}
+
 /**
  * start_curses - Start the Curses UI
  * @retval 0 Success
@@ -560,6 +685,7 @@ main
   char *dlevel = NULL;
   char *dfile = NULL;
   const char *cli_nntp = NULL;
+  const char *query_pattern = NULL;
   struct Email *e = NULL;
   struct ListHead attach = STAILQ_HEAD_INITIALIZER(attach);
   struct ListHead commands = STAILQ_HEAD_INITIALIZER(commands);
@@ -619,7 +745,7 @@ main
         argv[nargc++] = argv[optind];
     }
 
-    i = getopt(argc, argv, "+A:a:Bb:F:f:Cc:Dd:l:Ee:g:GH:i:hm:nOpQ:RSs:TvyzZ");
+    i = getopt(argc, argv, "+A:a:Bb:F:f:Cc:Dd:l:Ee:g:GH:i:hj:m:nOpQ:RSs:TvyzZ");
     if (i != EOF)
     {
       switch (i)
@@ -674,6 +800,9 @@ main
         case 'i':
           include_file = optarg;
           break;
+        case 'j':
+          query_pattern = optarg;
+          break;
         case 'l':
           dfile = optarg;
           break;
@@ -818,7 +947,7 @@ main
 
   /* Check for a batch send. */
   if (!isatty(0) || !STAILQ_EMPTY(&queries) || !STAILQ_EMPTY(&alias_queries) ||
-      dump_variables || batch_mode)
+      dump_variables || batch_mode || query_pattern)
   {
     OptNoCurses = true;
     sendflags |= SEND_BATCH;
@@ -910,6 +1039,12 @@ main
     goto main_ok; // TEST18: neomutt -D
   }
 
+  if (query_pattern)
+  {
+    rc = query_messages(folder, query_pattern);
+    goto main_curses; // TEST52: neomutt -f mailbox -j '~A'
+  }
+
   if (!STAILQ_EMPTY(&alias_queries))
   {
     rc = 0;
@@ -1479,6 +1614,7 @@ main_exit:
   buf_pool_cleanup();
   envlist_free(&EnvList);
   mutt_browser_cleanup();
+  background_cleanup();
   external_cleanup();
   menu_cleanup();
   crypt_cleanup();
@@ -1489,9 +1625,20 @@ main_exit:
   alternates_cleanup();
   mutt_keys_cleanup();
   mutt_prex_cleanup();
+  trigram_index_cleanup();
+  mutt_dns_cache_cleanup();
+  mutt_account_cmd_cache_cleanup();
+  mutt_addrcache_cleanup();
+  session_cleanup();
+  rc_cache_cleanup();
+  prefetch_cleanup();
+  msgid_index_cleanup();
+  mutt_rfc3676_cleanup();
   config_cache_cleanup();
   neomutt_free(&NeoMutt);
   cs_free(&cs);
+  // Last: anything above may still return HashElems to the slab
+  slab_cleanup();
   log_queue_flush(log_disp_terminal);
   mutt_log_stop();
   return rc;
@@ -39,6 +39,9 @@ static struct ConfigDef MboxVars[] = {
   { "check_mbox_size", DT_BOOL, false, 0, NULL,
     "(mbox,mmdf) Use mailbox size as an indicator of new mail"
   },
+  { "mbox_use_mmap", DT_BOOL, false, 0, NULL,
+    "(mbox) Use a memory map to parse the mailbox, rather than reading every line"
+  },
   { NULL },
   // clang-format on
 };
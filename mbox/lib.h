@@ -37,6 +37,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <sys/types.h>
 #include <time.h>
 #include "core/lib.h"
 
@@ -51,9 +52,11 @@ struct MboxAccountData
   struct timespec mtime;              ///< Time Mailbox was last changed
   struct timespec atime;              ///< File's last-access time
   struct timespec stats_last_checked; ///< Mtime of mailbox the last time stats where checked
+  off_t stats_size;                   ///< Size of mailbox the last time stats were counted
 
   bool locked : 1; ///< is the mailbox locked?
   bool append : 1; ///< mailbox is opened in append mode
+  bool batch : 1;  ///< mid-batch append; commits defer their fsync
 };
 
 extern const struct MxOps MxMboxOps;
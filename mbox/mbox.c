@@ -41,6 +41,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
@@ -338,6 +339,215 @@ fail:
   return rc;
 }
 
+/**
+ * mbox_copy_line - Copy one line out of a memory-mapped mailbox
+ * @param buf    Buffer for the result
+ * @param buflen Length of buffer
+ * @param p      Start of the line in the map
+ * @param end    End of the map
+ * @retval num Length of the line, including the newline
+ *
+ * The result is truncated to fit the buffer, but the returned length is
+ * always that of the whole line.
+ */
+static size_t mbox_copy_line(char *buf, size_t buflen, const char *p, const char *end)
+{
+  const char *nl = memchr(p, '\n', end - p);
+  const size_t len = nl ? (size_t) (nl - p + 1) : (size_t) (end - p);
+
+  size_t copy = MIN(len, buflen - 1);
+  memcpy(buf, p, copy);
+  buf[copy] = '\0';
+
+  return len;
+}
+
+/**
+ * mbox_parse_mailbox_mmap - Read a mailbox through a memory map
+ * @param[in]  m  Mailbox
+ * @param[out] rc Result, e.g. #MX_OPEN_OK
+ * @retval true The Mailbox was parsed, rc is valid
+ *
+ * Scan the mapped file for "From " separators with memmem(), which is far
+ * faster than pulling every line through stdio.  The headers of each message
+ * are still parsed with mutt_rfc822_read_header(); the bodies are never
+ * visited, as their size and line count come straight from the map.
+ *
+ * Like mbox_parse_mailbox(), this is also used to pick up messages appended
+ * to an open folder - parsing starts at the current file offset.  A final
+ * message that is still being appended (no terminating newline yet) isn't
+ * parsed; Mailbox::size is wound back to its separator instead, so the next
+ * mailbox check picks it up once the write has completed.
+ */
+static bool mbox_parse_mailbox_mmap(struct Mailbox *m, enum MxOpenReturns *rc)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+
+  struct stat st = { 0 };
+  if (stat(mailbox_path(m), &st) == -1)
+  {
+    mutt_perror("%s", mailbox_path(m));
+    *rc = MX_OPEN_ERROR;
+    return true;
+  }
+
+  m->size = st.st_size;
+  mutt_file_get_stat_timespec(&adata->mtime, &st, MUTT_STAT_MTIME);
+  mutt_file_get_stat_timespec(&adata->atime, &st, MUTT_STAT_ATIME);
+
+  if (!m->readonly)
+    m->readonly = access(mailbox_path(m), W_OK) ? true : false;
+
+  LOFF_T start = ftello(adata->fp);
+  if (start < 0)
+  {
+    mutt_debug(LL_DEBUG1, "ftello: %s (errno %d)\n", strerror(errno), errno);
+    start = 0;
+  }
+
+  if (start >= m->size)
+  {
+    *rc = MX_OPEN_OK; // Nothing new to read
+    return true;
+  }
+
+  const size_t map_len = m->size;
+  const char *base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fileno(adata->fp), 0);
+  if (base == MAP_FAILED)
+  {
+    mutt_debug(LL_DEBUG1, "mmap: %s (errno %d)\n", strerror(errno), errno);
+    return false; // Fall back to the stdio parser
+  }
+
+  struct Progress *progress = NULL;
+  if (m->verbose)
+  {
+    progress = progress_new(MUTT_PROGRESS_READ, 0);
+    progress_set_message(progress, _("Reading %s..."), mailbox_path(m));
+  }
+
+  const char *end = base + m->size;
+
+  /* Torn-write detection: a fast appender may still be mid-write.  Every
+   * complete mbox message ends with a newline, so if the map doesn't, the
+   * final message is incomplete.  It's left unparsed and m->size is wound
+   * back, so the next mailbox check resumes from its separator.  */
+  const bool torn = (end > base) && (end[-1] != '\n');
+
+  char buf[8192] = { 0 };
+  char return_path[256] = { 0 };
+  time_t t = 0;
+  int count = 0;
+
+  // Find the first message separator
+  const char *sep = base + start;
+  while ((sep < end) && !SigInt)
+  {
+    if (((sep == base) || (sep[-1] == '\n')) && ((end - sep) >= 5) &&
+        mutt_strn_equal(sep, "From ", 5))
+    {
+      mbox_copy_line(buf, sizeof(buf), sep, end);
+      if (is_from(buf, return_path, sizeof(return_path), &t))
+        break;
+    }
+    sep = memmem(sep + 1, end - sep - 1, "\nFrom ", 6);
+    if (!sep)
+      break;
+    sep++; // Step over the newline, onto the separator line
+  }
+
+  if (torn && !sep)
+    m->size = start; // The torn tail holds the only separator - retry later
+
+  while (sep && (sep < end) && !SigInt)
+  {
+    const LOFF_T loc = sep - base;
+    const size_t sep_len = mbox_copy_line(buf, sizeof(buf), sep, end);
+
+    // Find the start of the next message, including the newline
+    // that ends the separator line (the next message may be empty)
+    const char *next = sep + sep_len - 1;
+    while (next && (next < end))
+    {
+      next = memmem(next, end - next, "\nFrom ", 6);
+      if (!next)
+        break;
+      next++; // Step over the newline, onto the candidate line
+      mbox_copy_line(buf, sizeof(buf), next, end);
+      if (is_from(buf, return_path, sizeof(return_path), &t))
+        break;
+    }
+    const LOFF_T loc_next = next ? (next - base) : m->size;
+
+    if (torn && !next)
+    {
+      m->size = loc; // Resume from this separator once the write completes
+      break;
+    }
+
+    // is_from() has clobbered these, so parse the separator again
+    mbox_copy_line(buf, sizeof(buf), sep, end);
+    is_from(buf, return_path, sizeof(return_path), &t);
+
+    count++;
+    progress_update(progress, count, (int) (loc / (m->size / 100 + 1)));
+
+    mx_alloc_memory(m, m->msg_count);
+
+    struct Email *e_cur = email_new();
+    m->emails[m->msg_count] = e_cur;
+    e_cur->received = t - mutt_date_local_tz(t);
+    e_cur->offset = loc;
+    e_cur->index = m->msg_count;
+
+    (void) mutt_file_seek(adata->fp, loc + sep_len, SEEK_SET);
+    e_cur->env = mutt_rfc822_read_header(adata->fp, e_cur, false, false);
+
+    // The body runs from the end of the headers to the next separator
+    LOFF_T body_off = e_cur->body->offset;
+    if ((body_off < loc) || (body_off > loc_next))
+      body_off = loc_next; // Corrupt headers, don't trust the offset
+
+    e_cur->body->length = loc_next - body_off - 1;
+    if (e_cur->body->length < 0)
+      e_cur->body->length = 0;
+
+    // Count the lines in the body straight from the map
+    int lines = 0;
+    for (const char *q = base + body_off; (q = memchr(q, '\n', (base + loc_next) - q)); q++)
+      lines++;
+    e_cur->lines = lines ? lines - 1 : 0;
+
+    m->msg_count++;
+
+    if (TAILQ_EMPTY(&e_cur->env->return_path) && return_path[0])
+      mutt_addrlist_parse(&e_cur->env->return_path, return_path);
+
+    if (TAILQ_EMPTY(&e_cur->env->from))
+      mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
+
+    sep = next;
+  }
+
+  // Leave the stream at the end of the file, like the stdio parser
+  (void) mutt_file_seek(adata->fp, m->size, SEEK_SET);
+
+  munmap((void *) base, map_len);
+  progress_free(&progress);
+
+  if (SigInt)
+  {
+    SigInt = false;
+    *rc = MX_OPEN_ABORT; // action aborted
+  }
+  else
+  {
+    *rc = MX_OPEN_OK;
+  }
+
+  return true;
+}
+
 /**
  * mbox_parse_mailbox - Read a mailbox from disk
  * @param m Mailbox
@@ -358,6 +568,14 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
   if (!adata)
     return MX_OPEN_ERROR;
 
+  const bool c_mbox_use_mmap = cs_subset_bool(NeoMutt->sub, "mbox_use_mmap");
+  if (c_mbox_use_mmap)
+  {
+    enum MxOpenReturns rc_mmap = MX_OPEN_ERROR;
+    if (mbox_parse_mailbox_mmap(m, &rc_mmap))
+      return rc_mmap;
+  }
+
   struct stat st = { 0 };
   char buf[8192] = { 0 };
   char return_path[256] = { 0 };
@@ -1015,6 +1233,11 @@ static enum MxStatus mbox_mbox_check(struct Mailbox *m)
             mutt_sig_unblock();
           }
 
+          /* The parser may have set nothing aside, e.g. a torn write whose
+           * final message isn't complete yet - don't announce it until it is */
+          if (m->msg_count == old_msg_count)
+            return MX_STATUS_OK;
+
           return MX_STATUS_NEW_MAIL; /* signal that new mail arrived */
         }
         else
@@ -1058,6 +1281,185 @@ error:
   return MX_STATUS_ERROR;
 }
 
+/**
+ * struct StatusPatch - An in-place Status/X-Status header edit
+ */
+struct StatusPatch
+{
+  LOFF_T offset; ///< Where the header's value starts in the mailbox
+  char text[32]; ///< Replacement value, space-padded to the old length
+  int len;       ///< Number of bytes to overwrite
+};
+ARRAY_HEAD(StatusPatchArray, struct StatusPatch);
+
+/**
+ * status_patch_add - Prepare an in-place edit of one Status header
+ * @param spa    Patch list to add to
+ * @param offset Offset of the header's value, just after the colon
+ * @param oldlen Length of the current value, up to the newline
+ * @param flags  New flag characters, e.g. "RO"
+ * @retval true The new value fits in the old one's bytes
+ */
+static bool status_patch_add(struct StatusPatchArray *spa, LOFF_T offset,
+                             size_t oldlen, const char *flags)
+{
+  struct StatusPatch sp = { 0 };
+  size_t flen = mutt_str_len(flags);
+
+  if ((oldlen < flen) || (oldlen >= sizeof(sp.text)))
+    return false;
+
+  sp.offset = offset;
+  sp.len = oldlen;
+  memset(sp.text, ' ', oldlen);
+  memcpy(sp.text + ((oldlen > flen) ? 1 : 0), flags, flen);
+
+  ARRAY_ADD(spa, sp);
+  return true;
+}
+
+/**
+ * mbox_patch_email - Prepare in-place Status edits for one Email
+ * @param fp  Mailbox file
+ * @param e   Email whose flags have changed
+ * @param spa Patch list to add to
+ * @retval true All the changes fit in the existing headers
+ *
+ * A full rewrite is needed if a flag has to go into a header that isn't
+ * there, or doesn't have enough room.
+ */
+static bool mbox_patch_email(FILE *fp, struct Email *e, struct StatusPatchArray *spa)
+{
+  char buf[1024] = { 0 };
+  char status[4] = { 0 };
+  char xstatus[4] = { 0 };
+
+  if (e->read)
+    mutt_str_copy(status, "RO", sizeof(status));
+  else if (e->old)
+    mutt_str_copy(status, "O", sizeof(status));
+
+  int n = 0;
+  if (e->replied)
+    xstatus[n++] = 'A';
+  if (e->flagged)
+    xstatus[n++] = 'F';
+
+  if (!mutt_file_seek(fp, e->offset, SEEK_SET))
+    return false;
+
+  bool seen_status = false;
+  bool seen_xstatus = false;
+  bool at_bol = true;
+
+  while (ftello(fp) < e->body->offset)
+  {
+    const LOFF_T line_off = ftello(fp);
+    if (!fgets(buf, sizeof(buf), fp))
+      return false;
+
+    const bool bol = at_bol;
+    at_bol = (strchr(buf, '\n') != NULL);
+    if (!bol)
+      continue; // the rest of an over-long line
+    if ((buf[0] == '\n') || ((buf[0] == '\r') && (buf[1] == '\n')))
+      break; // end of the headers
+
+    bool is_status = true;
+    size_t plen = mutt_istr_startswith(buf, "Status:");
+    if (plen == 0)
+    {
+      is_status = false;
+      plen = mutt_istr_startswith(buf, "X-Status:");
+    }
+    if (plen == 0)
+      continue;
+
+    // The rewrite would drop a duplicate header; we can't
+    if (is_status ? seen_status : seen_xstatus)
+      return false;
+
+    char *eol = strchr(buf, '\n');
+    if (!eol)
+      return false;
+
+    if (!status_patch_add(spa, line_off + plen, eol - (buf + plen),
+                          is_status ? status : xstatus))
+    {
+      return false;
+    }
+
+    if (is_status)
+      seen_status = true;
+    else
+      seen_xstatus = true;
+  }
+
+  // A flag needs a header that the message doesn't have
+  if ((status[0] && !seen_status) || (xstatus[0] && !seen_xstatus))
+    return false;
+
+  return true;
+}
+
+/**
+ * mbox_sync_inplace - Try to sync flag changes without rewriting the mailbox
+ * @param m  Mailbox
+ * @param fp Mailbox file, opened for writing
+ * @retval true All the changes are on disk
+ *
+ * When the only changes are message flags, the Status/X-Status headers can
+ * usually be overwritten where they are, saving the rewrite of everything
+ * after the first changed message.  Deletions, edited headers and stripped
+ * attachments still need the full rewrite.
+ *
+ * The patches are all collected before any of them is written, so on failure
+ * the mailbox is untouched and the caller can fall back to the rewrite.
+ */
+static bool mbox_sync_inplace(struct Mailbox *m, FILE *fp)
+{
+  struct StatusPatchArray spa = ARRAY_HEAD_INITIALIZER;
+  bool ok = true;
+
+  for (int i = 0; ok && (i < m->msg_count); i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (e->deleted || e->attach_del)
+      ok = false;
+    else if (e->changed)
+    {
+      if (e->env->changed)
+        ok = false;
+      else
+        ok = mbox_patch_email(fp, e, &spa);
+    }
+  }
+
+  if (ok)
+  {
+    const int fd = fileno(fp);
+    struct StatusPatch *sp = NULL;
+    ARRAY_FOREACH(sp, &spa)
+    {
+      if (pwrite(fd, sp->text, sp->len, sp->offset) != sp->len)
+      {
+        /* Patches only blank or shrink values, so whatever was written is
+         * still valid - the full rewrite will put the rest right */
+        ok = false;
+        break;
+      }
+    }
+
+    // Don't let stdio serve stale bytes for the patched regions
+    mutt_file_seek(fp, 0, SEEK_SET);
+  }
+
+  ARRAY_FREE(&spa);
+  return ok;
+}
+
 /**
  * mbox_mbox_sync - Save changes to the Mailbox - Implements MxOps::mbox_sync() - @ingroup mx_mbox_sync
  */
@@ -1121,6 +1523,25 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     goto fatal;
   }
 
+  /* If only flags changed, patch the Status headers in place instead of
+   * rewriting everything from the first change onwards */
+  if (m->type == MUTT_MBOX)
+  {
+    if (stat(mailbox_path(m), &st) == -1)
+    {
+      mutt_perror("%s", mailbox_path(m));
+      goto bail;
+    }
+    if (mbox_sync_inplace(m, adata->fp))
+    {
+      /* Restore the previous access/modification times */
+      mbox_reset_atime(m, &st);
+      mbox_unlock_mailbox(m);
+      mutt_sig_unblock();
+      return MX_STATUS_OK;
+    }
+  }
+
   /* Create a temporary file to write the new version of the mailbox in. */
   tempfile = buf_pool_get();
   buf_mktemp(tempfile);
@@ -1221,7 +1642,7 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
        * we just flush the in memory cache so that the message will be reparsed
        * if the user accesses it later.  */
       new_offset[i - first].body = ftello(fp) - m->emails[i]->body->length + offset;
-      mutt_body_free(&m->emails[i]->body->parts);
+      email_parts_invalidate(m->emails[i]);
 
       if (m->type == MUTT_MMDF)
       {
@@ -1505,6 +1926,10 @@ static int mbox_msg_commit(struct Mailbox *m, struct Message *msg)
   if (fputc('\n', msg->fp) == EOF)
     return -1;
 
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (adata && adata->batch)
+    return 0; /* one fsync at the end of the batch, see mbox_msg_copy_batch() */
+
   if ((fflush(msg->fp) == EOF) || (fsync(fileno(msg->fp)) == -1))
   {
     mutt_perror(_("Can't write message"));
@@ -1527,6 +1952,44 @@ static int mbox_msg_close(struct Mailbox *m, struct Message *msg)
   return 0;
 }
 
+/**
+ * mbox_msg_copy_batch - Copy a set of messages to another Mailbox - Implements MxOps::msg_copy_batch() - @ingroup mx_msg_copy_batch
+ *
+ * The messages go through the normal append path, so From_/MMDF separators
+ * and quoting are handled as usual, but the mailbox is flushed and fsync'd
+ * once for the whole batch instead of once per message.
+ *
+ * The append fd is already locked for the lifetime of the batch, see
+ * mbox_mbox_open_append().
+ */
+static int mbox_msg_copy_batch(struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m_dst);
+  if (!adata || !adata->fp)
+    return 1;
+
+  int rc = 0;
+  adata->batch = true;
+  struct Email **ep = NULL;
+  ARRAY_FOREACH(ep, ea)
+  {
+    if (mutt_append_message(m_dst, m_src, *ep, NULL, MUTT_CM_NO_FLAGS, CH_NO_FLAGS) != 0)
+    {
+      rc = -1;
+      break;
+    }
+  }
+  adata->batch = false;
+
+  if ((fflush(adata->fp) == EOF) || (fsync(fileno(adata->fp)) == -1))
+  {
+    mutt_perror(_("Can't write message"));
+    rc = -1;
+  }
+
+  return rc;
+}
+
 /**
  * mbox_msg_padding_size - Bytes of padding between messages - Implements MxOps::msg_padding_size() - @ingroup mx_msg_padding_size
  * @param m Mailbox
@@ -1626,6 +2089,10 @@ static int mmdf_msg_commit(struct Mailbox *m, struct Message *msg)
   if (fputs(MMDF_SEP, msg->fp) == EOF)
     return -1;
 
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (adata && adata->batch)
+    return 0; /* one fsync at the end of the batch, see mbox_msg_copy_batch() */
+
   if ((fflush(msg->fp) == EOF) || (fsync(fileno(msg->fp)) == -1))
   {
     mutt_perror(_("Can't write message"));
@@ -1645,6 +2112,151 @@ static int mmdf_msg_padding_size(struct Mailbox *m)
   return 10;
 }
 
+/**
+ * mbox_stats_scan - Count the messages in an mbox without parsing them
+ * @param m  Mailbox
+ * @param st stat of the mailbox file, taken before reading it
+ * @retval true The counts were updated
+ *
+ * A stats sweep only needs totals, so don't build Emails or parse full
+ * headers the way opening the mailbox would.  Walk the file for "From "
+ * separators and peek at each message's Status/X-Status headers - the only
+ * fields the counts depend on.
+ *
+ * The file size at the last count is remembered.  If the mailbox has only
+ * grown and the old end of the file is still a message separator, only the
+ * appended messages are counted - the same append-only heuristic as
+ * mbox_mbox_check().
+ *
+ * The file is read without a lock: a racing delivery touches the mtime
+ * again, so the next sweep simply recounts.
+ */
+static bool mbox_stats_scan(struct Mailbox *m, struct stat *st)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata)
+    return false;
+
+  FILE *fp = mutt_file_fopen(mailbox_path(m), "r");
+  if (!fp)
+    return false;
+
+  char buf[8192] = { 0 };
+  char return_path[256] = { 0 };
+  time_t t = 0;
+
+  LOFF_T start = 0;
+  if ((adata->stats_size > 0) && (st->st_size > adata->stats_size) &&
+      mutt_file_seek(fp, adata->stats_size, SEEK_SET) && fgets(buf, sizeof(buf), fp) &&
+      is_from(buf, return_path, sizeof(return_path), &t))
+  {
+    start = adata->stats_size; // Count only the appended messages
+  }
+  else
+  {
+    m->msg_count = 0;
+    m->msg_unread = 0;
+    m->msg_flagged = 0;
+    m->msg_new = 0;
+  }
+
+  if (!mutt_file_seek(fp, start, SEEK_SET))
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  bool at_bol = true; // A line overflowing buf continues on the next read
+  bool in_hdr = false;
+  bool have_msg = false;
+  bool is_read = false, old = false, flagged = false, deleted = false;
+
+  while (true)
+  {
+    const bool got = (fgets(buf, sizeof(buf), fp) != NULL);
+
+    if (!got || (at_bol && mutt_str_startswith(buf, "From ") &&
+                 is_from(buf, return_path, sizeof(return_path), &t)))
+    {
+      if (have_msg)
+      {
+        m->msg_count++;
+        if (!is_read)
+        {
+          m->msg_unread++;
+          if (!old && !deleted)
+            m->msg_new++;
+        }
+        if (flagged)
+          m->msg_flagged++;
+      }
+      if (!got)
+        break;
+
+      have_msg = true;
+      in_hdr = true;
+      is_read = false;
+      old = false;
+      flagged = false;
+      deleted = false;
+    }
+    else if (at_bol && in_hdr)
+    {
+      size_t plen = 0;
+      if ((buf[0] == '\n') || ((buf[0] == '\r') && (buf[1] == '\n')))
+      {
+        in_hdr = false;
+      }
+      else if ((plen = mutt_istr_startswith(buf, "status:")))
+      {
+        for (const char *p = buf + plen; *p && (*p != '\n'); p++)
+        {
+          if (*p == 'R')
+            is_read = true;
+          else if (*p == 'O')
+            old = true;
+        }
+      }
+      else if ((plen = mutt_istr_startswith(buf, "x-status:")))
+      {
+        for (const char *p = buf + plen; *p && (*p != '\n'); p++)
+        {
+          if (*p == 'F')
+            flagged = true;
+          else if (*p == 'D')
+            deleted = true;
+        }
+      }
+    }
+
+    at_bol = (strchr(buf, '\n') != NULL);
+  }
+
+  mutt_file_fclose(&fp);
+
+  m->size = st->st_size;
+  adata->stats_size = st->st_size;
+  m->has_new = (m->msg_new > 0);
+
+  /* fix up the times so mailbox won't get confused */
+  if (mutt_file_stat_compare(st, MUTT_STAT_MTIME, st, MUTT_STAT_ATIME) > 0)
+  {
+#ifdef HAVE_UTIMENSAT
+    struct timespec ts[2] = { { 0 }, { 0 } };
+    mutt_file_get_stat_timespec(&ts[0], st, MUTT_STAT_ATIME);
+    mutt_file_get_stat_timespec(&ts[1], st, MUTT_STAT_MTIME);
+    utimensat(AT_FDCWD, mailbox_path(m), ts, 0);
+#else
+    struct utimbuf ut = { 0 };
+    ut.actime = st->st_atime;
+    ut.modtime = st->st_mtime;
+    utime(mailbox_path(m), &ut);
+#endif
+  }
+
+  return true;
+}
+
 /**
  * mbox_mbox_check_stats - Check the Mailbox statistics - Implements MxOps::mbox_check_stats() - @ingroup mx_mbox_check_stats
  */
@@ -1694,10 +2306,14 @@ static enum MxStatus mbox_mbox_check_stats(struct Mailbox *m, uint8_t flags)
     if (adata && mutt_file_stat_timespec_compare(&st, MUTT_STAT_MTIME,
                                                  &adata->stats_last_checked) > 0)
     {
-      bool old_peek = m->peekonly;
-      mx_mbox_open(m, MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK);
-      mx_mbox_close(m);
-      m->peekonly = old_peek;
+      // MMDF uses a different separator - keep the old parse for it
+      if ((m->type != MUTT_MBOX) || !mbox_stats_scan(m, &st))
+      {
+        bool old_peek = m->peekonly;
+        mx_mbox_open(m, MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK);
+        mx_mbox_close(m);
+        m->peekonly = old_peek;
+      }
       mutt_time_now(&adata->stats_last_checked);
     }
   }
@@ -1727,6 +2343,7 @@ const struct MxOps MxMboxOps = {
   .msg_open_new     = mbox_msg_open_new,
   .msg_commit       = mbox_msg_commit,
   .msg_close        = mbox_msg_close,
+  .msg_copy_batch   = mbox_msg_copy_batch,
   .msg_padding_size = mbox_msg_padding_size,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
@@ -1757,6 +2374,7 @@ const struct MxOps MxMmdfOps = {
   .msg_open_new     = mbox_msg_open_new,
   .msg_commit       = mmdf_msg_commit,
   .msg_close        = mbox_msg_close,
+  .msg_copy_batch   = mbox_msg_copy_batch,
   .msg_padding_size = mmdf_msg_padding_size,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
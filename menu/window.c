@@ -96,7 +96,14 @@ static int menu_repaint(struct MuttWindow *win)
     return 0;
 
   struct Menu *menu = win->wdata;
-  menu->redraw |= MENU_REDRAW_FULL;
+  /* A repaint with no queued damage was requested from outside the Menu
+   * (e.g. window_invalidate_all()), so the screen contents are unknown and
+   * everything must be painted.  Otherwise, honour the queued damage:
+   * single-row changes only repaint their own rows. */
+  if (menu->redraw == MENU_REDRAW_NO_FLAGS)
+    menu->redraw = MENU_REDRAW_FULL;
+
+  const MenuRedrawFlags redraw = menu->redraw;
   menu_redraw(menu);
   menu->redraw = MENU_REDRAW_NO_FLAGS;
 
@@ -119,7 +126,12 @@ static int menu_repaint(struct MuttWindow *win)
     mutt_window_move(menu->win, menu->win->state.cols - 1, menu->current - menu->top);
   }
 
-  mutt_debug(LL_DEBUG5, "repaint done\n");
+  int rows = 1; // MENU_REDRAW_CURRENT
+  if (redraw & (MENU_REDRAW_FULL | MENU_REDRAW_INDEX))
+    rows = menu->page_len;
+  else if (redraw & MENU_REDRAW_MOTION)
+    rows = 2;
+  mutt_debug(LL_DEBUG5, "repaint done, painted %d of %d rows\n", rows, menu->page_len);
   return 0;
 }
 
@@ -162,29 +162,17 @@ static enum MxStatus mh_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   m->msg_flagged = 0;
 
   enum MxStatus rc = MX_STATUS_OK;
-  bool check_new = true;
-  for (int i = mhs.max; i > 0; i--)
+  m->msg_flagged = mh_seq_count(&mhs, MH_SEQ_FLAGGED);
+  m->msg_unread = mh_seq_count(&mhs, MH_SEQ_UNSEEN);
+
+  /* if the most recent unseen message was in the m during the last visit,
+   * don't notify about it */
+  const int last_unseen = mh_seq_last(&mhs, MH_SEQ_UNSEEN);
+  if ((last_unseen > 0) &&
+      (!c_mail_check_recent || (mh_already_notified(m, last_unseen) == 0)))
   {
-    if ((mh_seq_check(&mhs, i) & MH_SEQ_FLAGGED))
-      m->msg_flagged++;
-    if (mh_seq_check(&mhs, i) & MH_SEQ_UNSEEN)
-    {
-      m->msg_unread++;
-      if (check_new)
-      {
-        /* if the first unseen message we encounter was in the m during the
-         * last visit, don't notify about it */
-        if (!c_mail_check_recent || (mh_already_notified(m, i) == 0))
-        {
-          m->has_new = true;
-          rc = MX_STATUS_NEW_MAIL;
-        }
-        /* Because we are traversing from high to low, we can stop
-         * checking for new mail after the first unseen message.
-         * Whether it resulted in "new mail" or not. */
-        check_new = false;
-      }
-    }
+    m->has_new = true;
+    rc = MX_STATUS_NEW_MAIL;
   }
 
   mh_seq_free(&mhs);
@@ -386,7 +374,7 @@ static int mh_rewrite_message(struct Mailbox *m, struct Email *e)
     e->lines = old_hdr_lines;
   }
 
-  mutt_body_free(&e->body->parts);
+  email_parts_invalidate(e);
   return rc;
 }
 
@@ -553,7 +541,7 @@ static void mh_delayed_parsing(struct Mailbox *m, struct MhEmailArray *mha,
 
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
-  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
 #endif
 
   struct MhEmail *md = NULL;
@@ -788,7 +776,7 @@ static int mh_msg_save_hcache(struct Mailbox *m, struct Email *e)
   int rc = 0;
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
-  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
   rc = hcache_store_email(hc, e->path, strlen(e->path), e, 0);
   hcache_close(&hc);
 #endif
@@ -1071,7 +1059,7 @@ static enum MxStatus mh_mbox_sync(struct Mailbox *m)
   struct HeaderCache *hc = NULL;
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
-  hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
 #endif
 
   struct Progress *progress = NULL;
@@ -29,6 +29,7 @@
 
 #include "config.h"
 #include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -41,24 +42,78 @@
 #include "shared.h"
 
 /**
- * mh_seq_alloc - Allocate more memory for sequences
- * @param mhs Existing sequences
- * @param i   Number required
+ * mh_seq_range_insert - Add a range of numbers to a set
+ * @param set   Set to update
+ * @param first First number to add
+ * @param last  Last number to add
  *
- * @note Memory is allocated in blocks of 128.
+ * The ranges are kept sorted and any ranges that overlap, or are adjacent to,
+ * [first,last] are merged into one.
  */
-static void mh_seq_alloc(struct MhSequences *mhs, int i)
+static void mh_seq_range_insert(struct MhSeqSet *set, int first, int last)
 {
-  if ((i <= mhs->max) && mhs->flags)
+  /* find the first range that could touch [first,last] */
+  int lo = 0;
+  int hi = set->count;
+  while (lo < hi)
+  {
+    const int mid = (lo + hi) / 2;
+    if (set->ranges[mid].last < (first - 1))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if ((lo == set->count) || (set->ranges[lo].first > (last + 1)))
+  {
+    /* no overlap, insert a new range at lo */
+    if (set->count == set->capacity)
+    {
+      set->capacity = MAX(set->capacity * 2, 16);
+      mutt_mem_realloc(&set->ranges, sizeof(set->ranges[0]) * set->capacity);
+    }
+    memmove(set->ranges + lo + 1, set->ranges + lo,
+            sizeof(set->ranges[0]) * (set->count - lo));
+    set->ranges[lo].first = first;
+    set->ranges[lo].last = last;
+    set->count++;
     return;
+  }
 
-  const int newmax = i + 128;
-  int j = mhs->flags ? mhs->max + 1 : 0;
-  mutt_mem_realloc(&mhs->flags, sizeof(mhs->flags[0]) * (newmax + 1));
-  while (j <= newmax)
-    mhs->flags[j++] = 0;
+  /* merge [first,last] with the ranges it touches */
+  int end = lo;
+  while ((end < set->count) && (set->ranges[end].first <= (last + 1)))
+    end++;
 
-  mhs->max = newmax;
+  set->ranges[lo].first = MIN(set->ranges[lo].first, first);
+  set->ranges[lo].last = MAX(set->ranges[end - 1].last, last);
+  if (end > (lo + 1))
+  {
+    memmove(set->ranges + lo + 1, set->ranges + end,
+            sizeof(set->ranges[0]) * (set->count - end));
+    set->count -= (end - lo - 1);
+  }
+}
+
+/**
+ * mh_seq_set_contains - Is a number in a set?
+ * @param set Set to search
+ * @param i   Number to look for
+ * @retval true The number is in the set
+ */
+static bool mh_seq_set_contains(const struct MhSeqSet *set, int i)
+{
+  int lo = 0;
+  int hi = set->count;
+  while (lo < hi)
+  {
+    const int mid = (lo + hi) / 2;
+    if (set->ranges[mid].last < i)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return (lo < set->count) && (set->ranges[lo].first <= i);
 }
 
 /**
@@ -67,7 +122,12 @@ static void mh_seq_alloc(struct MhSequences *mhs, int i)
  */
 void mh_seq_free(struct MhSequences *mhs)
 {
-  FREE(&mhs->flags);
+  for (int b = 0; b < MH_SEQ_SETS; b++)
+  {
+    FREE(&mhs->sets[b].ranges);
+    mhs->sets[b].count = 0;
+    mhs->sets[b].capacity = 0;
+  }
 }
 
 /**
@@ -78,9 +138,70 @@ void mh_seq_free(struct MhSequences *mhs)
  */
 MhSeqFlags mh_seq_check(struct MhSequences *mhs, int i)
 {
-  if (!mhs->flags || (i > mhs->max))
-    return 0;
-  return mhs->flags[i];
+  MhSeqFlags flags = MH_SEQ_NO_FLAGS;
+  for (int b = 0; b < MH_SEQ_SETS; b++)
+  {
+    if (mh_seq_set_contains(&mhs->sets[b], i))
+      flags |= (1 << b);
+  }
+  return flags;
+}
+
+/**
+ * mh_seq_count - Count the numbers that have a given flag
+ * @param mhs Sequences
+ * @param f   Flag, see #MhSeqFlags
+ * @retval num Size of the flag's set
+ */
+int mh_seq_count(struct MhSequences *mhs, MhSeqFlags f)
+{
+  int total = 0;
+  for (int b = 0; b < MH_SEQ_SETS; b++)
+  {
+    if (!(f & (1 << b)))
+      continue;
+    const struct MhSeqSet *set = &mhs->sets[b];
+    for (int i = 0; i < set->count; i++)
+      total += set->ranges[i].last - set->ranges[i].first + 1;
+  }
+  return total;
+}
+
+/**
+ * mh_seq_last - Find the highest number that has a given flag
+ * @param mhs Sequences
+ * @param f   Flag, see #MhSeqFlags
+ * @retval num Highest number in the flag's set
+ * @retval 0   The set is empty
+ */
+int mh_seq_last(struct MhSequences *mhs, MhSeqFlags f)
+{
+  int last = 0;
+  for (int b = 0; b < MH_SEQ_SETS; b++)
+  {
+    if (!(f & (1 << b)))
+      continue;
+    const struct MhSeqSet *set = &mhs->sets[b];
+    if (set->count > 0)
+      last = MAX(last, set->ranges[set->count - 1].last);
+  }
+  return last;
+}
+
+/**
+ * mh_seq_set_range - Set a flag for a range of sequence numbers
+ * @param mhs   Sequences
+ * @param first First number in the range
+ * @param last  Last number in the range
+ * @param f     Flags, see #MhSeqFlags
+ */
+static void mh_seq_set_range(struct MhSequences *mhs, int first, int last, MhSeqFlags f)
+{
+  for (int b = 0; b < MH_SEQ_SETS; b++)
+  {
+    if (f & (1 << b))
+      mh_seq_range_insert(&mhs->sets[b], first, last);
+  }
 }
 
 /**
@@ -88,13 +209,10 @@ MhSeqFlags mh_seq_check(struct MhSequences *mhs, int i)
  * @param mhs Sequences
  * @param i   Index number
  * @param f   Flags, see #MhSeqFlags
- * @retval num Resulting flags, see #MhSeqFlags
  */
-static MhSeqFlags mh_seq_set(struct MhSequences *mhs, int i, MhSeqFlags f)
+static void mh_seq_set(struct MhSequences *mhs, int i, MhSeqFlags f)
 {
-  mh_seq_alloc(mhs, i);
-  mhs->flags[i] |= f;
-  return mhs->flags[i];
+  mh_seq_set_range(mhs, i, i, f);
 }
 
 /**
@@ -189,38 +307,20 @@ static void mh_seq_write_one(FILE *fp, struct MhSequences *mhs, MhSeqFlags f, co
 {
   fprintf(fp, "%s:", tag);
 
-  int first = -1;
-  int last = -1;
-
-  for (int i = 0; i <= mhs->max; i++)
+  for (int b = 0; b < MH_SEQ_SETS; b++)
   {
-    if ((mh_seq_check(mhs, i) & f))
-    {
-      if (first < 0)
-        first = i;
-      else
-        last = i;
-    }
-    else if (first >= 0)
+    if (!(f & (1 << b)))
+      continue;
+    const struct MhSeqSet *set = &mhs->sets[b];
+    for (int i = 0; i < set->count; i++)
     {
-      if (last < 0)
-        fprintf(fp, " %d", first);
+      if (set->ranges[i].first == set->ranges[i].last)
+        fprintf(fp, " %d", set->ranges[i].first);
       else
-        fprintf(fp, " %d-%d", first, last);
-
-      first = -1;
-      last = -1;
+        fprintf(fp, " %d-%d", set->ranges[i].first, set->ranges[i].last);
     }
   }
 
-  if (first >= 0)
-  {
-    if (last < 0)
-      fprintf(fp, " %d", first);
-    else
-      fprintf(fp, " %d-%d", first, last);
-  }
-
   fputc('\n', fp);
 }
 
@@ -416,8 +516,7 @@ int mh_seq_read(struct MhSequences *mhs, const char *path)
         rc = -1;
         goto out;
       }
-      for (; first <= last; first++)
-        mh_seq_set(mhs, first, flags);
+      mh_seq_set_range(mhs, first, last, flags);
     }
   }
 
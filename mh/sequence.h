@@ -34,19 +34,45 @@ typedef uint8_t MhSeqFlags;         ///< Flags, e.g. #MH_SEQ_UNSEEN
 #define MH_SEQ_REPLIED   (1 << 1)   ///< Email has been replied to
 #define MH_SEQ_FLAGGED   (1 << 2)   ///< Email is flagged
 
+#define MH_SEQ_SETS 3               ///< Number of flag bits, one MhSeqSet each
+
+/**
+ * struct MhSeqRange - Inclusive range of MH sequence numbers
+ */
+struct MhSeqRange
+{
+  int first; ///< First number in the range
+  int last;  ///< Last number in the range
+};
+
+/**
+ * struct MhSeqSet - Set of MH sequence numbers, stored as sorted ranges
+ *
+ * The ranges are kept sorted, non-overlapping and non-adjacent, so a set
+ * costs memory proportional to the number of runs in the `.mh_sequences`
+ * file, not to the highest sequence number.
+ */
+struct MhSeqSet
+{
+  struct MhSeqRange *ranges; ///< Sorted array of disjoint ranges
+  int count;                 ///< Number of ranges in use
+  int capacity;              ///< Number of ranges allocated
+};
+
 /**
  * struct MhSequences - Set of MH sequence numbers
  */
 struct MhSequences
 {
-  int max;           ///< Number of flags stored
-  MhSeqFlags *flags; ///< Flags for each email
+  struct MhSeqSet sets[MH_SEQ_SETS]; ///< One set per flag, see #MhSeqFlags
 };
 
 void       mh_seq_add_one(struct Mailbox *m, int n, bool unseen, bool flagged, bool replied);
 int        mh_seq_changed(struct Mailbox *m);
 MhSeqFlags mh_seq_check  (struct MhSequences *mhs, int i);
+int        mh_seq_count  (struct MhSequences *mhs, MhSeqFlags f);
 void       mh_seq_free   (struct MhSequences *mhs);
+int        mh_seq_last   (struct MhSequences *mhs, MhSeqFlags f);
 int        mh_seq_read   (struct MhSequences *mhs, const char *path);
 void       mh_seq_update (struct Mailbox *m);
 
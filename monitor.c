@@ -45,6 +45,9 @@
 #include "core/lib.h"
 #include "monitor.h"
 #include "index/lib.h"
+#ifdef USE_NOTMUCH
+#include "notmuch/lib.h"
+#endif
 #ifndef HAVE_INOTIFY_INIT1
 #include <fcntl.h>
 #endif
@@ -67,9 +70,14 @@ static struct pollfd *PollFds = NULL;
 /// Monitor file descriptor of the current mailbox
 static int MonitorCurMboxDescriptor = -1;
 
-#define INOTIFY_MASK_DIR (IN_MOVED_TO | IN_ATTRIB | IN_CLOSE_WRITE | IN_ISDIR)
+#define INOTIFY_MASK_DIR                                                       \
+  (IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ATTRIB |           \
+   IN_CLOSE_WRITE | IN_ISDIR)
 #define INOTIFY_MASK_FILE IN_CLOSE_WRITE
 
+/// Maximum number of filenames to remember per watch between collections
+#define MONITOR_PENDING_MAX 1024
+
 #define EVENT_BUFLEN MAX(4096, sizeof(struct inotify_event) + NAME_MAX + 1)
 
 /**
@@ -95,6 +103,10 @@ struct Monitor
   ino_t st_ino;
   enum MailboxType type;
   int desc;
+  bool changed;            ///< Seen events since the last mutt_monitor_unchanged()
+  struct ListHead pending; ///< Filenames the watch has seen since the last collection
+  size_t num_pending;      ///< Length of pending
+  bool overflowed;         ///< Filenames were dropped; pending is incomplete
 };
 
 /**
@@ -221,6 +233,9 @@ static struct Monitor *monitor_new(struct MonitorInfo *info, int descriptor)
   monitor->st_dev = info->st_dev;
   monitor->st_ino = info->st_ino;
   monitor->desc = descriptor;
+  monitor->changed = true; // run a real check before trusting the watch
+  STAILQ_INIT(&monitor->pending);
+  monitor->overflowed = true; // files may predate the watch; force a full scan
   monitor->next = Monitor;
   if (info->type == MUTT_MH)
     monitor->mh_backup_path = mutt_str_dup(info->path);
@@ -260,6 +275,7 @@ static void monitor_delete(struct Monitor *monitor)
   }
 
   FREE(&monitor->mh_backup_path);
+  mutt_list_free(&monitor->pending);
   monitor = monitor->next;
   FREE(ptr);
   *ptr = monitor;
@@ -317,6 +333,67 @@ static int monitor_handle_ignore(int desc)
   return new_desc;
 }
 
+/**
+ * monitor_mark_changed - Note that a watch has seen an event
+ * @param desc Watch descriptor
+ */
+static void monitor_mark_changed(int desc)
+{
+  struct Monitor *iter = Monitor;
+
+  while (iter && (iter->desc != desc))
+    iter = iter->next;
+
+  if (iter)
+    iter->changed = true;
+}
+
+/**
+ * monitor_queue_event - Record the filename from a directory watch event
+ * @param desc Watch descriptor
+ * @param name Filename the event refers to
+ *
+ * The names let the mailbox backends process only the files that changed,
+ * instead of re-scanning the whole directory.  If a watch sees more than
+ * #MONITOR_PENDING_MAX names before they're collected, the record is dropped
+ * and the watch flagged as overflowed, so the next collection falls back to a
+ * full scan.
+ */
+static void monitor_queue_event(int desc, const char *name)
+{
+  struct Monitor *iter = Monitor;
+
+  while (iter && (iter->desc != desc))
+    iter = iter->next;
+
+  if (!iter || iter->overflowed)
+    return;
+
+  if (iter->num_pending == MONITOR_PENDING_MAX)
+  {
+    iter->overflowed = true;
+    mutt_list_free(&iter->pending);
+    iter->num_pending = 0;
+    return;
+  }
+
+  mutt_list_insert_tail(&iter->pending, mutt_str_dup(name));
+  iter->num_pending++;
+}
+
+/**
+ * monitor_queue_overflow - The kernel dropped events; no record is complete
+ */
+static void monitor_queue_overflow(void)
+{
+  for (struct Monitor *iter = Monitor; iter; iter = iter->next)
+  {
+    iter->overflowed = true;
+    mutt_list_free(&iter->pending);
+    iter->num_pending = 0;
+  }
+}
+
 /**
  * monitor_resolve - Get the monitor for a mailbox
  * @param[out] info Details of the mailbox's monitor
@@ -359,6 +436,17 @@ static enum ResolveResult monitor_resolve(struct MonitorInfo *info, struct Mailb
     info->is_dir = true;
     fmt = "%s/new";
   }
+#ifdef USE_NOTMUCH
+  else if (info->type == MUTT_NOTMUCH)
+  {
+    /* Watch the Xapian directory: every database commit touches it, so the
+     * watch fires when `notmuch new` or another client updates the index */
+    info->is_dir = true;
+    if (!nm_db_monitor_path(m ? m : m_cur, &info->path_buf))
+      return RESOLVE_RES_FAIL_STAT;
+    info->path = buf_string(&info->path_buf);
+  }
+#endif
   else
   {
     info->is_dir = false;
@@ -455,6 +543,11 @@ int mutt_monitor_poll(void)
                 event = (const struct inotify_event *) ptr;
                 mutt_debug(LL_DEBUG3, "+ detail: descriptor=%d mask=0x%x\n",
                            event->wd, event->mask);
+                monitor_mark_changed(event->wd);
+                if (event->mask & IN_Q_OVERFLOW)
+                  monitor_queue_overflow();
+                else if (event->len > 0)
+                  monitor_queue_event(event->wd, event->name);
                 if (event->mask & IN_IGNORED)
                   monitor_handle_ignore(event->wd);
                 else if (event->wd == MonitorCurMboxDescriptor)
@@ -473,6 +566,61 @@ int mutt_monitor_poll(void)
   return rc;
 }
 
+/**
+ * mutt_monitor_unchanged - Has a watched mailbox been quiet since the last check?
+ * @param m Mailbox
+ * @retval true The Mailbox is watched and its watch has seen no events
+ *
+ * Lets the periodic mailbox poll skip mailboxes that can't have changed.
+ * Unwatched (e.g. remote) mailboxes always count as changed, as does a watch's
+ * first query after it's created.
+ */
+bool mutt_monitor_unchanged(struct Mailbox *m)
+{
+  struct MonitorInfo info = { 0 };
+  bool rc = false;
+
+  if (monitor_resolve(&info, m) == RESOLVE_RES_OK_EXISTING)
+  {
+    rc = !info.monitor->changed;
+    info.monitor->changed = false;
+  }
+
+  monitor_info_free(&info);
+  return rc;
+}
+
+/**
+ * mutt_monitor_take_events - Collect the filenames a mailbox's watch has seen
+ * @param[in]  m     Mailbox
+ * @param[out] names List to receive the filenames
+ * @retval true The record is complete and has been handed over
+ *
+ * On success, names holds every filename the watch reported since the last
+ * collection and the watch's record is reset.  If there is no watch, or if
+ * names were dropped, the list is left empty and the caller must fall back to
+ * scanning the directory.  For Maildir mailboxes the watch covers only the
+ * 'new' subdirectory.
+ */
+bool mutt_monitor_take_events(struct Mailbox *m, struct ListHead *names)
+{
+  struct MonitorInfo info = { 0 };
+  bool rc = false;
+
+  if (monitor_resolve(&info, m) == RESOLVE_RES_OK_EXISTING)
+  {
+    struct Monitor *monitor = info.monitor;
+    rc = !monitor->overflowed;
+    if (rc)
+      STAILQ_CONCAT(names, &monitor->pending);
+    monitor->num_pending = 0;
+    monitor->overflowed = false;
+  }
+
+  monitor_info_free(&info);
+  return rc;
+}
+
 /**
  * mutt_monitor_add - Add a watch for a mailbox
  * @param m Mailbox to watch
@@ -26,6 +26,7 @@
 
 #include <stdbool.h>
 
+struct ListHead;
 struct Mailbox;
 
 extern bool MonitorFilesChanged;   ///< true after a monitored file has changed
@@ -34,5 +35,7 @@ extern bool MonitorCurMboxChanged; ///< true after the current mailbox has chang
 int mutt_monitor_add(struct Mailbox *m);
 int mutt_monitor_remove(struct Mailbox *m);
 int mutt_monitor_poll(void);
+bool mutt_monitor_unchanged(struct Mailbox *m);
+bool mutt_monitor_take_events(struct Mailbox *m, struct ListHead *names);
 
 #endif /* MUTT_MONITOR_H */
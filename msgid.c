@@ -0,0 +1,168 @@
+/**
+ * @file
+ * Message-id to Mailbox index
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_msgid Message-id to Mailbox index
+ *
+ * A session-wide index of message-id to the Mailbox holding the message.
+ *
+ * The index is fed from every Mailbox that gets opened or synced, so
+ * following a reference across folders costs one hash lookup instead of a
+ * manual search.  If a message-id isn't known yet, msgid_index_scan() peeks
+ * at the configured local Mailboxes that haven't been indexed, adding them
+ * as it goes.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "msgid.h"
+#include "mx.h"
+
+/// Map of message-id to the path of the Mailbox holding the message
+static struct HashTable *MsgidIndex = NULL;
+/// Set of Mailbox paths that have already been indexed
+static struct HashTable *MsgidScanned = NULL;
+
+/**
+ * msgid_entry_free - Free an index entry - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void msgid_entry_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * msgid_index_record - Add a Mailbox's messages to the index
+ * @param m Mailbox that has been opened or synced
+ *
+ * Message-ids are stored with their angle brackets, as in Email::env.
+ */
+void msgid_index_record(struct Mailbox *m)
+{
+  if (!m || (m->msg_count == 0))
+    return;
+
+  if (!MsgidIndex)
+  {
+    MsgidIndex = mutt_hash_new(1024, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(MsgidIndex, msgid_entry_free, 0);
+    MsgidScanned = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+  }
+
+  const char *path = mailbox_path(m);
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->env || !e->env->message_id)
+      continue;
+
+    struct HashElem *he = mutt_hash_find_elem(MsgidIndex, e->env->message_id);
+    if (he)
+    {
+      if (!mutt_str_equal(he->data, path))
+        mutt_str_replace((char **) &he->data, path);
+    }
+    else
+    {
+      mutt_hash_insert(MsgidIndex, e->env->message_id, mutt_str_dup(path));
+    }
+  }
+
+  if (!mutt_hash_find(MsgidScanned, path))
+    mutt_hash_insert(MsgidScanned, path, MsgidScanned);
+}
+
+/**
+ * msgid_index_lookup - Find the Mailbox holding a message
+ * @param msgid Message-id to find, with angle brackets
+ * @retval ptr  Path of the Mailbox
+ * @retval NULL Message-id isn't in the index
+ */
+const char *msgid_index_lookup(const char *msgid)
+{
+  if (!MsgidIndex || !msgid)
+    return NULL;
+
+  return mutt_hash_find(MsgidIndex, msgid);
+}
+
+/**
+ * msgid_index_scan - Search the configured Mailboxes for a message-id
+ * @param msgid Message-id to find, with angle brackets
+ * @retval ptr  Path of the Mailbox
+ * @retval NULL Message-id isn't in any known Mailbox
+ *
+ * Local Mailboxes that haven't been indexed yet are opened briefly (peek) to
+ * feed the index.  Each Mailbox is only ever scanned once per session; after
+ * that, lookups are a single hash find.
+ */
+const char *msgid_index_scan(const char *msgid)
+{
+  const char *found = msgid_index_lookup(msgid);
+  if (found)
+    return found;
+
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+
+    if ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH) &&
+        (m->type != MUTT_MBOX) && (m->type != MUTT_MMDF))
+    {
+      continue; // remote mailboxes might prompt for credentials
+    }
+    if (m->opened > 0)
+      continue; // already indexed at open
+    if (MsgidScanned && mutt_hash_find(MsgidScanned, mailbox_path(m)))
+      continue;
+
+    mutt_message(_("Scanning %s..."), mailbox_path(m));
+    if (mx_mbox_open(m, MUTT_READONLY | MUTT_PEEK | MUTT_QUIET | MUTT_NOSORT))
+    {
+      msgid_index_record(m);
+      mx_mbox_close(m);
+    }
+
+    found = msgid_index_lookup(msgid);
+    if (found)
+      break;
+  }
+  neomutt_mailboxlist_clear(&ml);
+
+  return found;
+}
+
+/**
+ * msgid_index_cleanup - Free the message-id index
+ */
+void msgid_index_cleanup(void)
+{
+  mutt_hash_free(&MsgidIndex);
+  mutt_hash_free(&MsgidScanned);
+}
@@ -0,0 +1,33 @@
+/**
+ * @file
+ * Message-id to Mailbox index
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MSGID_H
+#define MUTT_MSGID_H
+
+struct Mailbox;
+
+void        msgid_index_cleanup(void);
+const char *msgid_index_lookup (const char *msgid);
+void        msgid_index_record (struct Mailbox *m);
+const char *msgid_index_scan   (const char *msgid);
+
+#endif /* MUTT_MSGID_H */
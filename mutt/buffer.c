@@ -230,6 +230,22 @@ size_t buf_addstr(struct Buffer *buf, const char *s)
   return buf_addstr_n(buf, s, mutt_str_len(s));
 }
 
+/**
+ * buf_addbuf - Add a Buffer to a Buffer
+ * @param buf Buffer to add to
+ * @param src Buffer to append
+ * @retval num Bytes written to Buffer
+ *
+ * A Buffer already knows its length, so unlike buf_addstr() the data doesn't
+ * need to be rescanned.
+ */
+size_t buf_addbuf(struct Buffer *buf, const struct Buffer *src)
+{
+  if (!buf || !src || !src->data)
+    return 0;
+  return buf_addstr_n(buf, src->data, buf_len(src));
+}
+
 /**
  * buf_addch - Add a single character to a Buffer
  * @param buf Buffer to add to
@@ -610,6 +626,51 @@ size_t buf_copy(struct Buffer *dst, const struct Buffer *src)
   return buf_addstr_n(dst, src->data, buf_len(src));
 }
 
+/**
+ * buf_move - Move a Buffer's contents to another Buffer
+ * @param dst Buffer for result
+ * @param src Buffer to move; left empty
+ *
+ * The Buffers exchange their storage, so no string is copied or freed: dst
+ * adopts src's contents and src is emptied but keeps dst's old allocation.
+ * That makes it safe to move out of (or into) a Buffer from the pool.
+ */
+void buf_move(struct Buffer *dst, struct Buffer *src)
+{
+  if (!dst || !src || (dst == src))
+    return;
+
+  struct Buffer tmp = *dst;
+  *dst = *src;
+  *src = tmp;
+
+  src->dptr = src->data;
+  if (src->data)
+    *src->data = '\0';
+}
+
+/**
+ * buf_take_string - Detach a Buffer's string, leaving the Buffer empty
+ * @param buf Buffer to take from
+ * @retval ptr The string, now owned by the caller
+ * @retval NULL Buffer was unallocated
+ *
+ * Saves a copy when the string's final home is a plain char pointer.
+ * The caller must free the result.
+ */
+char *buf_take_string(struct Buffer *buf)
+{
+  if (!buf)
+    return NULL;
+
+  char *str = buf->data;
+  buf->data = NULL;
+  buf->dptr = NULL;
+  buf->dsize = 0;
+
+  return str;
+}
+
 /**
  * buf_seek - Set current read/write position to offset from beginning
  * @param buf    Buffer to use
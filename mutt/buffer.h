@@ -61,6 +61,7 @@ size_t         buf_startswith      (const struct Buffer *buf, const char *prefix
 const char    *buf_rfind           (const struct Buffer *buf, const char *str);
 
 // Functions that APPEND to a Buffer
+size_t         buf_addbuf          (struct Buffer *buf, const struct Buffer *src);
 size_t         buf_addch           (struct Buffer *buf, char c);
 size_t         buf_addstr          (struct Buffer *buf, const char *s);
 size_t         buf_addstr_n        (struct Buffer *buf, const char *s, size_t len);
@@ -75,6 +76,8 @@ size_t         buf_insert          (struct Buffer *buf, size_t offset, const cha
 size_t         buf_concat_path     (struct Buffer *buf, const char *dir, const char *fname);
 size_t         buf_concatn_path    (struct Buffer *dst, const char *dir, size_t dirlen, const char *fname, size_t fnamelen);
 size_t         buf_copy            (struct Buffer *dst, const struct Buffer *src);
+void           buf_move            (struct Buffer *dst, struct Buffer *src);
+char *         buf_take_string     (struct Buffer *buf);
 int            buf_printf          (struct Buffer *buf, const char *fmt, ...)
                                     __attribute__((__format__(__printf__, 2, 3)));
 size_t         buf_strcpy          (struct Buffer *buf, const char *s);
@@ -37,10 +37,14 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "charset.h"
 #include "buffer.h"
 #include "list.h"
 #include "logging2.h"
+#include "lrucache.h"
 #include "memory.h"
 #include "pool.h"
 #include "queue.h"
@@ -82,22 +86,77 @@ TAILQ_HEAD(LookupList, Lookup);
 /// Lookup table of preferred character set names
 static struct LookupList Lookups = TAILQ_HEAD_INITIALIZER(Lookups);
 
+/// Max size of the iconv cache
+#define ICONV_CACHE_SIZE 64
+
+#ifdef HAVE_PTHREAD_CREATE
+/// Key for each thread's own iconv descriptor cache
+static pthread_key_t IconvCacheKey;
+/// Create IconvCacheKey only once
+static pthread_once_t IconvCacheKeyOnce = PTHREAD_ONCE_INIT;
+#else
+/// The sole iconv descriptor cache of a threadless build
+static struct LruCache *IconvCacheSingle = NULL;
+#endif
+
 /**
- * struct IconvCacheEntry - Cached iconv conversion descriptor
+ * iconv_cache_evict - Dispose of a cached iconv descriptor - Implements ::lru_evict_t - @ingroup lru_evict_api
  */
-struct IconvCacheEntry
+static void iconv_cache_evict(const char *key, void *data)
 {
-  char *fromcode1; ///< Source character set
-  char *tocode1;   ///< Destination character set
-  iconv_t cd;      ///< iconv conversion descriptor
-};
+  iconv_t *cd = data;
 
-/// Max size of the iconv cache
-#define ICONV_CACHE_SIZE 16
-/// Cache of iconv conversion descriptors
-static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
-/// Number of iconv descriptors in the cache
-static int IconvCacheUsed = 0;
+  mutt_debug(LL_DEBUG2, "iconv: dropping %s from the cache\n", key);
+  if (iconv_t_valid(*cd))
+    iconv_close(*cd);
+  FREE(&data);
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * iconv_cache_destroy - Free a thread's iconv cache - Implements ::pthread key destructor
+ * @param arg LruCache of the exiting thread
+ */
+static void iconv_cache_destroy(void *arg)
+{
+  struct LruCache *ic = arg;
+  lru_cache_free(&ic);
+}
+
+/**
+ * iconv_cache_key_init - Create the thread-local iconv cache key
+ */
+static void iconv_cache_key_init(void)
+{
+  pthread_key_create(&IconvCacheKey, iconv_cache_destroy);
+}
+#endif
+
+/**
+ * iconv_cache_get - Get the calling thread's iconv descriptor cache
+ * @retval ptr LruCache, created on first use
+ *
+ * Each thread keeps its own cache: iconv descriptors carry conversion state,
+ * so they can't be shared between the maildir parser workers, and a private
+ * cache needs no locking.
+ */
+static struct LruCache *iconv_cache_get(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_once(&IconvCacheKeyOnce, iconv_cache_key_init);
+  struct LruCache *ic = pthread_getspecific(IconvCacheKey);
+  if (!ic)
+  {
+    ic = lru_cache_new(ICONV_CACHE_SIZE, 0, iconv_cache_evict);
+    pthread_setspecific(IconvCacheKey, ic);
+  }
+  return ic;
+#else
+  if (!IconvCacheSingle)
+    IconvCacheSingle = lru_cache_new(ICONV_CACHE_SIZE, 0, iconv_cache_evict);
+  return IconvCacheSingle;
+#endif
+}
 
 /**
  * struct MimeNames - MIME name lookup entry
@@ -580,10 +639,11 @@ const char *mutt_ch_charset_lookup(const char *chs)
  * label, or such. Misusing MUTT_ICONV_HOOK_FROM leads to unwanted interactions
  * in some setups.
  *
- * Since calling iconv_open() repeatedly can be expensive, we keep a cache of
- * the most recently used iconv_t objects, kept in LRU order. This means that
- * you should not call iconv_close() on the object yourself. All remaining
- * objects in the cache will exit when main() calls mutt_ch_cache_cleanup().
+ * Since calling iconv_open() repeatedly can be expensive, each thread keeps a
+ * cache of its most recently used iconv_t objects, kept in LRU order. This
+ * means that you should not call iconv_close() on the object yourself. The
+ * remaining objects are closed when a worker thread exits, or when main()
+ * calls mutt_ch_cache_cleanup().
  *
  * @note By design charset-hooks should never be, and are never, applied
  * to tocode.
@@ -613,28 +673,20 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t fla
   }
 
   /* check if we have this pair cached already */
-  for (int i = 0; i < IconvCacheUsed; ++i)
-  {
-    if (strcmp(tocode1, IconvCache[i].tocode1) == 0 &&
-        strcmp(fromcode1, IconvCache[i].fromcode1) == 0)
-    {
-      iconv_t cd = IconvCache[i].cd;
+  char key[sizeof(fromcode1) + sizeof(tocode1)];
+  snprintf(key, sizeof(key), "%s/%s", fromcode1, tocode1);
 
-      /* make room for this one at the top */
-      struct IconvCacheEntry top = IconvCache[i];
-      for (int j = i; j-- > 0;)
-      {
-        IconvCache[j + 1] = IconvCache[j];
-      }
-      IconvCache[0] = top;
+  struct LruCache *ic = iconv_cache_get();
 
-      if (iconv_t_valid(cd))
-      {
-        /* reset state */
-        iconv(cd, NULL, NULL, NULL, NULL);
-      }
-      return cd;
+  iconv_t *cached = lru_cache_get(ic, key);
+  if (cached)
+  {
+    if (iconv_t_valid(*cached))
+    {
+      /* reset state */
+      iconv(*cached, NULL, NULL, NULL, NULL);
     }
+    return *cached;
   }
 
   /* not found in cache */
@@ -647,33 +699,10 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t fla
   /* call system iconv with names it appreciates */
   iconv_t cd = iconv_open(tocode2, fromcode2);
 
-  if (IconvCacheUsed == ICONV_CACHE_SIZE)
-  {
-    mutt_debug(LL_DEBUG2, "iconv: dropping %s -> %s from the cache\n",
-               IconvCache[IconvCacheUsed - 1].fromcode1,
-               IconvCache[IconvCacheUsed - 1].tocode1);
-    /* get rid of the oldest entry */
-    FREE(&IconvCache[IconvCacheUsed - 1].fromcode1);
-    FREE(&IconvCache[IconvCacheUsed - 1].tocode1);
-    if (iconv_t_valid(IconvCache[IconvCacheUsed - 1].cd))
-    {
-      iconv_close(IconvCache[IconvCacheUsed - 1].cd);
-    }
-    IconvCacheUsed--;
-  }
-
-  /* make room for this one at the top */
-  for (int j = IconvCacheUsed; j-- > 0;)
-  {
-    IconvCache[j + 1] = IconvCache[j];
-  }
-
-  IconvCacheUsed++;
-
   mutt_debug(LL_DEBUG2, "iconv: adding %s -> %s to the cache\n", fromcode1, tocode1);
-  IconvCache[0].fromcode1 = strdup(fromcode1);
-  IconvCache[0].tocode1 = strdup(tocode1);
-  IconvCache[0].cd = cd;
+  cached = mutt_mem_malloc(sizeof(iconv_t));
+  *cached = cd;
+  lru_cache_insert(ic, key, cached, 0);
 
   return cd;
 }
@@ -841,6 +870,17 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, uint8_t
   if (!to || !from)
     return -1;
 
+  /* Pure-ASCII text converts to itself whenever both charsets are ASCII
+   * supersets - skip iconv entirely.  This is the common case: most mail is
+   * ASCII even in charset-rich mailboxes, and this function runs per header
+   * and per body chunk. */
+  if ((mutt_ch_is_utf8(from) || mutt_ch_is_us_ascii(from)) &&
+      (mutt_ch_is_utf8(to) || mutt_ch_is_us_ascii(to)) &&
+      mutt_str_is_ascii(s, strlen(s)))
+  {
+    return 0;
+  }
+
   const char *repls[] = { "\357\277\275", "?", 0 };
   int rc = 0;
 
@@ -1177,14 +1217,12 @@ char *mutt_ch_choose(const char *fromcode, const struct Slist *charsets,
  */
 void mutt_ch_cache_cleanup(void)
 {
-  for (int i = 0; i < IconvCacheUsed; ++i)
-  {
-    FREE(&IconvCache[i].fromcode1);
-    FREE(&IconvCache[i].tocode1);
-    if (iconv_t_valid(IconvCache[i].cd))
-    {
-      iconv_close(IconvCache[i].cd);
-    }
-  }
-  IconvCacheUsed = 0;
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_once(&IconvCacheKeyOnce, iconv_cache_key_init);
+  struct LruCache *ic = pthread_getspecific(IconvCacheKey);
+  lru_cache_free(&ic);
+  pthread_setspecific(IconvCacheKey, NULL);
+#else
+  lru_cache_free(&IconvCacheSingle);
+#endif
 }
@@ -0,0 +1,159 @@
+/**
+ * @file
+ * Hardware-accelerated CRC-32C checksums
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_crc32c Hardware-accelerated CRC-32C checksums
+ *
+ * CRC-32C (Castagnoli) is a fast, non-cryptographic checksum, suitable for
+ * cache keys and data validation - not for anything an attacker may control.
+ * Recent x86-64 and AArch64 CPUs compute it in hardware; the implementation is
+ * picked at runtime, falling back to a lookup table.
+ */
+
+#include "config.h"
+#include <string.h>
+#include "crc32c.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_CRC32C_HW 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define HAVE_CRC32C_HW 1
+#endif
+
+/// CRC-32C generator polynomial, reflected
+static const uint32_t Crc32cPoly = 0x82f63b78;
+
+/// Byte-at-a-time lookup table for the software fallback
+static uint32_t Crc32cTable[256];
+
+/**
+ * crc32c_sw - Update a CRC-32C with a byte-at-a-time table - Implements crc32c_update_t
+ */
+static uint32_t crc32c_sw(uint32_t crc, const unsigned char *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+    crc = (crc >> 8) ^ Crc32cTable[(crc ^ data[i]) & 0xff];
+
+  return crc;
+}
+
+#ifdef HAVE_CRC32C_HW
+/**
+ * crc32c_hw - Update a CRC-32C with CPU crc instructions - Implements crc32c_update_t
+ *
+ * On x86-64 the crc instructions need SSE4.2; the function is compiled for it
+ * and crc32c_init() only selects it after checking the CPU.
+ */
+#ifdef __x86_64__
+__attribute__((target("sse4.2")))
+#endif
+static uint32_t crc32c_hw(uint32_t crc, const unsigned char *data, size_t len)
+{
+  while (len >= 8)
+  {
+    uint64_t chunk = 0;
+    memcpy(&chunk, data, 8);
+#ifdef __x86_64__
+    crc = (uint32_t) _mm_crc32_u64(crc, chunk);
+#else
+    crc = __crc32cd(crc, chunk);
+#endif
+    data += 8;
+    len -= 8;
+  }
+
+  while (len > 0)
+  {
+#ifdef __x86_64__
+    crc = _mm_crc32_u8(crc, *data);
+#else
+    crc = __crc32cb(crc, *data);
+#endif
+    data++;
+    len--;
+  }
+
+  return crc;
+}
+#endif /* HAVE_CRC32C_HW */
+
+/**
+ * crc32c_update_t - Update a CRC-32C over a block of memory
+ * @param crc  CRC so far, pre-inverted
+ * @param data Data to checksum
+ * @param len  Length of data
+ * @retval num Updated CRC
+ */
+typedef uint32_t (*crc32c_update_t)(uint32_t crc, const unsigned char *data, size_t len);
+
+/// The implementation picked for this CPU, NULL until the first use
+static crc32c_update_t Crc32cUpdate = NULL;
+
+/**
+ * crc32c_init - Pick a CRC-32C implementation for this CPU
+ */
+static void crc32c_init(void)
+{
+#if defined(HAVE_CRC32C_HW) && defined(__x86_64__)
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    Crc32cUpdate = crc32c_hw;
+    return;
+  }
+#elif defined(HAVE_CRC32C_HW)
+  // The compiler was told the CPU has the crc instructions; trust it
+  Crc32cUpdate = crc32c_hw;
+  return;
+#endif
+
+  for (uint32_t i = 0; i < 256; i++)
+  {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ ((crc & 1) ? Crc32cPoly : 0);
+    Crc32cTable[i] = crc;
+  }
+  Crc32cUpdate = crc32c_sw;
+}
+
+/**
+ * mutt_crc32c - Calculate the CRC-32C checksum of a block of memory
+ * @param crc  CRC of preceding data, or 0 to start
+ * @param data Data to checksum
+ * @param len  Length of data
+ * @retval num CRC-32C checksum
+ *
+ * Checksumming data in several calls, passing each result as the next seed,
+ * gives the same answer as one call over the whole buffer.
+ */
+uint32_t mutt_crc32c(uint32_t crc, const void *data, size_t len)
+{
+  if (!data)
+    return crc;
+
+  if (!Crc32cUpdate)
+    crc32c_init();
+
+  return ~Crc32cUpdate(~crc, data, len);
+}
@@ -183,13 +183,30 @@ static time_t add_tz_offset(time_t t, bool w, time_t h, time_t m)
  * @param len Length of the s string
  * @retval ptr Pointer to the Tz struct
  * @retval NULL Not found
+ *
+ * Binary search; relies on #TimeZones being kept in alphabetical order.
  */
 static const struct Tz *find_tz(const char *s, size_t len)
 {
-  for (size_t i = 0; i < mutt_array_size(TimeZones); i++)
+  int lo = 0;
+  int hi = mutt_array_size(TimeZones) - 1;
+
+  while (lo <= hi)
   {
-    if (mutt_istrn_equal(TimeZones[i].tzname, s, len))
-      return &TimeZones[i];
+    int mid = (lo + hi) / 2;
+    const int cmp = mutt_istrn_cmp(s, TimeZones[mid].tzname, len);
+    if (cmp == 0)
+    {
+      /* s may be a prefix of several entries ("met" vs "met dst");
+       * the shortest one sorts first and is the intended match */
+      while ((mid > 0) && (mutt_istrn_cmp(s, TimeZones[mid - 1].tzname, len) == 0))
+        mid--;
+      return &TimeZones[mid];
+    }
+    if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
   }
   return NULL;
 }
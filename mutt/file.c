@@ -72,6 +72,9 @@ const char FilenameSafeChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrst
 
 #define MAX_LOCK_ATTEMPTS 5
 
+/// Buffer size for the stdio copy loops; only used when copy_file_range() can't be
+#define COPY_BUF_SIZE (64 * 1024)
+
 /* This is defined in POSIX:2008 which isn't a build requirement */
 #ifndef O_NOFOLLOW
 #define O_NOFOLLOW 0
@@ -246,6 +249,67 @@ void mutt_file_unlink(const char *s)
   close(fd);
 }
 
+#ifdef HAVE_COPY_FILE_RANGE
+/**
+ * file_copy_bytes_fd - Copy bytes between two files within the kernel
+ * @param fp_in  Source file
+ * @param fp_out Destination file
+ * @param size   Maximum number of bytes to copy
+ * @retval num Number of bytes copied
+ * @retval  -1 The copy wasn't possible, the streams are untouched
+ *
+ * Use copy_file_range() to move the data without bouncing it through
+ * userspace.  This only works when both streams sit on regular files; the
+ * caller is expected to fall back to a read/write loop otherwise.
+ *
+ * On return, both streams are repositioned to match the bytes copied, so a
+ * partial copy can be finished with stdio.
+ */
+static ssize_t file_copy_bytes_fd(FILE *fp_in, FILE *fp_out, size_t size)
+{
+  struct stat st_in = { 0 };
+  struct stat st_out = { 0 };
+
+  const int fd_in = fileno(fp_in);
+  const int fd_out = fileno(fp_out);
+
+  if ((fd_in < 0) || (fd_out < 0) || (fstat(fd_in, &st_in) != 0) ||
+      (fstat(fd_out, &st_out) != 0) || !S_ISREG(st_in.st_mode) ||
+      !S_ISREG(st_out.st_mode))
+  {
+    return -1;
+  }
+
+  /* Any buffered output has to land before the kernel writes to the fd */
+  if (fflush(fp_out) != 0)
+    return -1;
+
+  off_t off_in = ftello(fp_in);
+  off_t off_out = ftello(fp_out);
+  if ((off_in < 0) || (off_out < 0))
+    return -1;
+
+  size_t total = 0;
+  while (total < size)
+  {
+    const ssize_t chunk = copy_file_range(fd_in, &off_in, fd_out, &off_out,
+                                          size - total, 0);
+    if (chunk <= 0)
+      break; /* error (e.g. EXDEV) or EOF - the caller handles the rest */
+    total += chunk;
+  }
+
+  if (total == 0)
+    return -1;
+
+  /* Resynchronise the stdio streams with the kernel offsets */
+  if ((fseeko(fp_in, off_in, SEEK_SET) != 0) || (fseeko(fp_out, off_out, SEEK_SET) != 0))
+    return -1;
+
+  return total;
+}
+#endif
+
 /**
  * mutt_file_copy_bytes - Copy some content from one file to another
  * @param fp_in  Source file
@@ -259,20 +323,33 @@ int mutt_file_copy_bytes(FILE *fp_in, FILE *fp_out, size_t size)
   if (!fp_in || !fp_out)
     return -1;
 
+#ifdef HAVE_COPY_FILE_RANGE
+  const ssize_t copied = file_copy_bytes_fd(fp_in, fp_out, size);
+  if (copied > 0)
+    size -= copied;
+#endif
+
+  int rc = 0;
+  const size_t bufsize = MIN(size, COPY_BUF_SIZE);
+  char *buf = (size > 0) ? mutt_mem_malloc(bufsize) : NULL;
+
   while (size > 0)
   {
-    char buf[2048] = { 0 };
-    size_t chunk = (size > sizeof(buf)) ? sizeof(buf) : size;
+    size_t chunk = MIN(size, bufsize);
     chunk = fread(buf, 1, chunk, fp_in);
     if (chunk < 1)
       break;
     if (fwrite(buf, 1, chunk, fp_out) != chunk)
-      return -1;
+    {
+      rc = -1;
+      break;
+    }
 
     size -= chunk;
   }
 
-  if (fflush(fp_out) != 0)
+  FREE(&buf);
+  if ((rc != 0) || (fflush(fp_out) != 0))
     return -1;
   return 0;
 }
@@ -290,16 +367,33 @@ int mutt_file_copy_stream(FILE *fp_in, FILE *fp_out)
     return -1;
 
   size_t total = 0;
+
+#ifdef HAVE_COPY_FILE_RANGE
+  /* Copy as much as possible in the kernel, then finish off with stdio */
+  struct stat st = { 0 };
+  const off_t off = ftello(fp_in);
+  if ((off >= 0) && (fstat(fileno(fp_in), &st) == 0) && (st.st_size > off))
+  {
+    const ssize_t copied = file_copy_bytes_fd(fp_in, fp_out, st.st_size - off);
+    if (copied > 0)
+      total += copied;
+  }
+#endif
+
   size_t l;
-  char buf[1024] = { 0 };
+  char *buf = mutt_mem_malloc(COPY_BUF_SIZE);
 
-  while ((l = fread(buf, 1, sizeof(buf), fp_in)) > 0)
+  while ((l = fread(buf, 1, COPY_BUF_SIZE, fp_in)) > 0)
   {
     if (fwrite(buf, 1, l, fp_out) != l)
+    {
+      FREE(&buf);
       return -1;
+    }
     total += l;
   }
 
+  FREE(&buf);
   if (fflush(fp_out) != 0)
     return -1;
   return total;
@@ -858,9 +952,11 @@ char *mutt_file_read_line(char *line, size_t *size, FILE *fp, int *line_num, Rea
       else
       {
         ungetc(c, fp); /* undo our damage */
-        /* There wasn't room for the line -- increase "line" */
+        /* There wasn't room for the line -- increase "line".  Double the size
+         * so a long line costs O(log n) refills rather than one per 256
+         * bytes, each of which makes fgets() rescan for the '\n'. */
         offset = *size - 1; /* overwrite the terminating 0 */
-        *size += 256;
+        *size *= 2;
         mutt_mem_realloc(&line, *size);
       }
     }
@@ -32,16 +32,20 @@
 #include <stdbool.h>
 #include "hash.h"
 #include "memory.h"
+#include "slab.h"
 #include "string2.h"
 
 #define SOME_PRIME 149711
 
+/// Slab allocator for HashElem objects
+static struct Slab HashElemSlab = SLAB_INITIALIZER(struct HashElem);
+
 /**
  * gen_hash_string - Generate a hash from a string - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
  *
  * @note If the key is NULL or empty, the retval will be 0
  */
-static size_t gen_hash_string(union HashKey key, size_t num_elems)
+static size_t gen_hash_string(union HashKey key)
 {
   size_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
@@ -50,9 +54,8 @@ static size_t gen_hash_string(union HashKey key, size_t num_elems)
 
   while (*s != '\0')
     hash += ((hash << 7) + *s++);
-  hash = (hash * SOME_PRIME) % num_elems;
 
-  return hash;
+  return hash * SOME_PRIME;
 }
 
 /**
@@ -68,7 +71,7 @@ static int cmp_key_string(union HashKey a, union HashKey b)
  *
  * @note If the key is NULL or empty, the retval will be 0
  */
-static size_t gen_hash_case_string(union HashKey key, size_t num_elems)
+static size_t gen_hash_case_string(union HashKey key)
 {
   size_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
@@ -77,9 +80,8 @@ static size_t gen_hash_case_string(union HashKey key, size_t num_elems)
 
   while (*s != '\0')
     hash += ((hash << 7) + tolower(*s++));
-  hash = (hash * SOME_PRIME) % num_elems;
 
-  return hash;
+  return hash * SOME_PRIME;
 }
 
 /**
@@ -93,9 +95,9 @@ static int cmp_key_case_string(union HashKey a, union HashKey b)
 /**
  * gen_hash_int - Generate a hash from an integer - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
  */
-static size_t gen_hash_int(union HashKey key, size_t num_elems)
+static size_t gen_hash_int(union HashKey key)
 {
-  return (key.intkey % num_elems);
+  return key.intkey;
 }
 
 /**
@@ -142,27 +144,30 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
-  struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
-  size_t hash = table->gen_hash(key, table->num_elems);
+  // Slab memory isn't zeroed, so every field must be set explicitly
+  struct HashElem *he = slab_alloc(&HashElemSlab);
+  const size_t hash = table->gen_hash(key);
+  const size_t bucket = hash % table->num_elems;
+  he->hash = hash;
   he->key = key;
   he->data = data;
   he->type = type;
 
   if (table->allow_dups)
   {
-    he->next = table->table[hash];
-    table->table[hash] = he;
+    he->next = table->table[bucket];
+    table->table[bucket] = he;
   }
   else
   {
     struct HashElem *tmp = NULL, *last = NULL;
 
-    for (tmp = table->table[hash], last = NULL; tmp; last = tmp, tmp = tmp->next)
+    for (tmp = table->table[bucket], last = NULL; tmp; last = tmp, tmp = tmp->next)
     {
       const int rc = table->cmp_key(tmp->key, key);
       if (rc == 0)
       {
-        FREE(&he);
+        slab_free(&HashElemSlab, (void **) &he);
         return NULL;
       }
       if (rc > 0)
@@ -171,7 +176,7 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
     if (last)
       last->next = he;
     else
-      table->table[hash] = he;
+      table->table[bucket] = he;
     he->next = tmp;
   }
   return he;
@@ -188,11 +193,12 @@ static struct HashElem *union_hash_find_elem(const struct HashTable *table, unio
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
+  const size_t hash = table->gen_hash(key);
+  struct HashElem *he = table->table[hash % table->num_elems];
   for (; he; he = he->next)
   {
-    if (table->cmp_key(key, he->key) == 0)
+    // Compare the cached hashes first - a full key compare is rarely needed
+    if ((he->hash == hash) && (table->cmp_key(key, he->key) == 0))
       return he;
   }
   return NULL;
@@ -225,20 +231,22 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
   if (!table)
     return; // LCOV_EXCL_LINE
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
-  struct HashElem **he_last = &table->table[hash];
+  const size_t hash = table->gen_hash(key);
+  const size_t bucket = hash % table->num_elems;
+  struct HashElem *he = table->table[bucket];
+  struct HashElem **he_last = &table->table[bucket];
 
   while (he)
   {
-    if (((data == he->data) || !data) && (table->cmp_key(he->key, key) == 0))
+    if (((data == he->data) || !data) && (he->hash == hash) &&
+        (table->cmp_key(he->key, key) == 0))
     {
       *he_last = he->next;
       if (table->hdata_free)
         table->hdata_free(he->type, he->data, table->hdata);
       if (table->strdup_keys)
         FREE(&he->key.strkey);
-      FREE(&he);
+      slab_free(&HashElemSlab, (void **) &he);
 
       he = *he_last;
     }
@@ -414,8 +422,8 @@ struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char
   union HashKey key;
 
   key.strkey = strkey;
-  size_t hash = table->gen_hash(key, table->num_elems);
-  return table->table[hash];
+  const size_t hash = table->gen_hash(key);
+  return table->table[hash % table->num_elems];
 }
 
 /**
@@ -472,7 +480,7 @@ void mutt_hash_free(struct HashTable **ptr)
         table->hdata_free(tmp->type, tmp->data, table->hdata);
       if (table->strdup_keys)
         FREE(&tmp->key.strkey);
-      FREE(&tmp);
+      slab_free(&HashElemSlab, (void **) &tmp);
     }
   }
   FREE(&table->table);
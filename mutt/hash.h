@@ -42,6 +42,7 @@ union HashKey
 struct HashElem
 {
   int type;              ///< Type of data stored in Hash Table, e.g. #DT_STRING
+  size_t hash;           ///< Full hash of the key, cached to skip key compares
   union HashKey key;     ///< Key representing the data
   void *data;            ///< User-supplied data
   struct HashElem *next; ///< Linked List
@@ -65,13 +66,13 @@ typedef void (*hash_hdata_free_t)(int type, void *obj, intptr_t data);
  *
  * Prototype for a Key hashing function
  *
- * @param key       Key to hash
- * @param num_elems Number of elements in the Hash Table
+ * @param key Key to hash
  *
- * Turn a Key (a string or an integer) into a hash id.
- * The hash id will be a number between 0 and (num_elems-1).
+ * Turn a Key (a string or an integer) into a hash.
+ * The caller reduces the hash to a bucket index; the full hash is cached in
+ * HashElem::hash so that lookups can skip most key compares.
  */
-typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
+typedef size_t (*hash_gen_hash_t)(union HashKey key);
 
 /**
  * @defgroup hash_cmp_key_api Hash Table Compare API
@@ -34,6 +34,7 @@
  * | mutt/base64.c    | @subpage mutt_base64    |
  * | mutt/buffer.c    | @subpage mutt_buffer    |
  * | mutt/charset.c   | @subpage mutt_charset   |
+ * | mutt/crc32c.c    | @subpage mutt_crc32c    |
  * | mutt/date.c      | @subpage mutt_date      |
  * | mutt/envlist.c   | @subpage mutt_envlist   |
  * | mutt/eqi.h       | @subpage mutt_eqi       |
@@ -43,21 +44,25 @@
  * | mutt/hash.c      | @subpage mutt_hash      |
  * | mutt/list.c      | @subpage mutt_list      |
  * | mutt/logging.c   | @subpage mutt_logging   |
+ * | mutt/lrucache.c  | @subpage mutt_lrucache  |
  * | mutt/mapping.c   | @subpage mutt_mapping   |
  * | mutt/mbyte.c     | @subpage mutt_mbyte     |
  * | mutt/md5.c       | @subpage mutt_md5       |
  * | mutt/memory.c    | @subpage mutt_memory    |
  * | mutt/notify.c    | @subpage mutt_notify    |
  * | mutt/path.c      | @subpage mutt_path      |
+ * | mutt/perf.c      | @subpage mutt_perf      |
  * | mutt/pool.c      | @subpage mutt_pool      |
  * | mutt/prex.c      | @subpage mutt_prex      |
  * | mutt/qsort_r.c   | @subpage mutt_qsort_r   |
  * | mutt/random.c    | @subpage mutt_random    |
  * | mutt/regex.c     | @subpage mutt_regex     |
  * | mutt/signal.c    | @subpage mutt_signal    |
+ * | mutt/slab.c      | @subpage mutt_slab      |
  * | mutt/slist.c     | @subpage mutt_slist     |
  * | mutt/state.c     | @subpage mutt_state     |
  * | mutt/string.c    | @subpage mutt_string    |
+ * | mutt/threadpool.c| @subpage mutt_threadpool|
  *
  * @note The library is self-contained -- some files may depend on others in
  *       the library, but none depends on source from outside.
@@ -75,6 +80,7 @@
 #include "base64.h"
 #include "buffer.h"
 #include "charset.h"
+#include "crc32c.h"
 #include "date.h"
 #include "envlist.h"
 #include "eqi.h"
@@ -84,6 +90,7 @@
 #include "hash.h"
 #include "list.h"
 #include "logging2.h"
+#include "lrucache.h"
 #include "mapping.h"
 #include "mbyte.h"
 #include "md5.h"
@@ -93,6 +100,7 @@
 #include "notify_type.h"
 #include "observer.h"
 #include "path.h"
+#include "perf.h"
 #include "pool.h"
 #include "prex.h"
 #include "qsort_r.h"
@@ -100,9 +108,11 @@
 #include "random.h"
 #include "regex3.h"
 #include "signal2.h"
+#include "slab.h"
 #include "slist.h"
 #include "state.h"
 #include "string2.h"
+#include "threadpool.h"
 // IWYU pragma: end_keep
 
 #if defined(COMPILER_IS_CLANG) || defined(COMPILER_IS_GCC)
@@ -29,6 +29,9 @@
 
 #include "config.h"
 #include <errno.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include <stdarg.h> // IWYU pragma: keep
 #include <stdbool.h>
 #include <stdio.h>
@@ -92,6 +95,150 @@ static const char *timestamp(time_t stamp)
   return buf;
 }
 
+#ifdef HAVE_PTHREAD_CREATE
+/* At high debug levels, the fprintf+flush for every line is slow enough to
+ * change the timing of the code being debugged.  Instead, the formatted lines
+ * are put in a small ring buffer and a background thread writes them out in
+ * batches.  If the ring fills up, lines are dropped (and counted) rather than
+ * stalling the caller. */
+
+/// Ring buffer writing is used at this debug level and above
+#define LOG_ASYNC_LEVEL LL_DEBUG3
+/// Number of lines the ring buffer can hold
+#define LOG_RING_SIZE 256
+/// Maximum length of one formatted log line
+#define LOG_RING_LINE_LEN 1024
+
+static char LogRing[LOG_RING_SIZE][LOG_RING_LINE_LEN]; ///< Formatted lines awaiting writing
+static int LogRingHead = 0;        ///< Index of the next line to write out
+static int LogRingTail = 0;        ///< Index of the next free slot
+static int LogRingDropped = 0;     ///< Lines dropped because the ring was full
+static bool LogWriterRunning = false; ///< The writer thread is active
+static bool LogWriterStop = false; ///< Ask the writer thread to finish
+static pthread_t LogWriterThread;  ///< Writer thread handle
+static pthread_mutex_t LogRingMutex = PTHREAD_MUTEX_INITIALIZER; ///< Protects the ring indices
+static pthread_cond_t LogRingCond = PTHREAD_COND_INITIALIZER; ///< Signalled when lines are added
+
+/**
+ * log_writer - Write queued log lines in batches - Implements ::pthread entry point
+ * @param arg Unused
+ * @retval NULL Always
+ *
+ * Lines are gathered into one buffer and written with a single syscall,
+ * bypassing the (line-buffered) stdio stream, which the producers don't touch
+ * while the writer is running.
+ */
+static void *log_writer(void *arg)
+{
+  static char batch[8192];
+
+  pthread_mutex_lock(&LogRingMutex);
+  while (true)
+  {
+    while ((LogRingHead == LogRingTail) && !LogWriterStop)
+      pthread_cond_wait(&LogRingCond, &LogRingMutex);
+    if (LogRingHead == LogRingTail)
+      break; // stopped and fully drained
+
+    int head = LogRingHead;
+    const int tail = LogRingTail;
+    pthread_mutex_unlock(&LogRingMutex);
+
+    const int fd = fileno(LogFileFP);
+    size_t used = 0;
+    while (head != tail)
+    {
+      const size_t len = strlen(LogRing[head]);
+      if ((used + len) > sizeof(batch))
+      {
+        if (write(fd, batch, used) < 0)
+          break;
+        used = 0;
+      }
+      memcpy(batch + used, LogRing[head], len);
+      used += len;
+      head = (head + 1) % LOG_RING_SIZE;
+    }
+    if ((used > 0) && (write(fd, batch, used) < 0))
+    {
+      // nothing sensible to do about a failed log write
+    }
+
+    pthread_mutex_lock(&LogRingMutex);
+    LogRingHead = head;
+  }
+  pthread_mutex_unlock(&LogRingMutex);
+  return NULL;
+}
+
+/**
+ * log_ring_push - Queue a formatted line for the writer thread
+ * @param line Line to queue
+ */
+static void log_ring_push(const char *line)
+{
+  pthread_mutex_lock(&LogRingMutex);
+  const int next = (LogRingTail + 1) % LOG_RING_SIZE;
+  if (next == LogRingHead)
+  {
+    LogRingDropped++;
+  }
+  else
+  {
+    mutt_str_copy(LogRing[LogRingTail], line, LOG_RING_LINE_LEN);
+    LogRingTail = next;
+    pthread_cond_signal(&LogRingCond);
+  }
+  pthread_mutex_unlock(&LogRingMutex);
+}
+
+/**
+ * log_writer_stop - Stop the writer thread, draining the ring first
+ *
+ * Afterwards the stdio stream may be used again.
+ */
+static void log_writer_stop(void)
+{
+  if (!LogWriterRunning)
+    return;
+
+  pthread_mutex_lock(&LogRingMutex);
+  LogWriterStop = true;
+  pthread_cond_signal(&LogRingCond);
+  pthread_mutex_unlock(&LogRingMutex);
+  pthread_join(LogWriterThread, NULL);
+  LogWriterRunning = false;
+
+  if (LogRingDropped > 0)
+  {
+    fprintf(LogFileFP, "[%s] %d log lines dropped\n", timestamp(0), LogRingDropped);
+    LogRingDropped = 0;
+  }
+}
+
+/**
+ * log_writer_update - Start or stop the writer thread to match the log level
+ */
+static void log_writer_update(void)
+{
+  if (!LogFileFP || (LogFileLevel < LOG_ASYNC_LEVEL))
+  {
+    log_writer_stop();
+    return;
+  }
+
+  if (LogWriterRunning)
+    return;
+
+  fflush(LogFileFP);
+  LogRingHead = 0;
+  LogRingTail = 0;
+  LogWriterStop = false;
+  if (pthread_create(&LogWriterThread, NULL, log_writer, NULL) == 0)
+    LogWriterRunning = true;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
 /**
  * log_file_close - Close the log file
  * @param verbose If true, then log the event
@@ -101,6 +248,9 @@ void log_file_close(bool verbose)
   if (!LogFileFP)
     return;
 
+#ifdef HAVE_PTHREAD_CREATE
+  log_writer_stop();
+#endif
   fprintf(LogFileFP, "[%s] Closing log.\n", timestamp(0));
   fprintf(LogFileFP, "# vim: syntax=neomuttlog\n");
   mutt_file_fclose(&LogFileFP);
@@ -137,6 +287,9 @@ int log_file_open(bool verbose)
           NONULL(LogFileVersion), LogFileLevel);
   if (verbose)
     mutt_message(_("Debugging at level %d to file '%s'"), LogFileLevel, LogFileName);
+#ifdef HAVE_PTHREAD_CREATE
+  log_writer_update();
+#endif
   return 0;
 }
 
@@ -181,6 +334,10 @@ int log_file_set_level(enum LogLevel level, bool verbose)
   if (level == LogFileLevel)
     return 0;
 
+#ifdef HAVE_PTHREAD_CREATE
+  /* the stdio stream is used directly below */
+  log_writer_stop();
+#endif
   LogFileLevel = level;
 
   if (level == LL_MESSAGE)
@@ -201,6 +358,9 @@ int log_file_set_level(enum LogLevel level, bool verbose)
 
   if (LogFileLevel >= LL_DEBUG5)
   {
+#ifdef HAVE_PTHREAD_CREATE
+    log_writer_stop();
+#endif
     fprintf(LogFileFP, "\n"
                        "WARNING:\n"
                        "    Logging at this level can reveal personal information.\n"
@@ -208,6 +368,9 @@ int log_file_set_level(enum LogLevel level, bool verbose)
                        "\n");
   }
 
+#ifdef HAVE_PTHREAD_CREATE
+  log_writer_update();
+#endif
   return 0;
 }
 
@@ -255,6 +418,31 @@ int log_disp_file(time_t stamp, const char *file, int line, const char *function
   if (!function)
     function = "UNKNOWN";
 
+#ifdef HAVE_PTHREAD_CREATE
+  if (LogWriterRunning)
+  {
+    /* format here, write in the background */
+    char text[LOG_RING_LINE_LEN];
+    size_t len = snprintf(text, sizeof(text), "[%s]<%c> %s() ", timestamp(stamp),
+                          LevelAbbr[level + 3], function);
+    len = MIN(len, sizeof(text) - 1);
+
+    va_list ap;
+    va_start(ap, format);
+    len += vsnprintf(text + len, sizeof(text) - len, format, ap);
+    va_end(ap);
+    len = MIN(len, sizeof(text) - 1);
+
+    if (level == LL_PERROR)
+      snprintf(text + len, sizeof(text) - len, ": %s\n", strerror(err));
+    else if (level <= LL_MESSAGE)
+      mutt_str_copy(text + len, "\n", sizeof(text) - len);
+
+    log_ring_push(text);
+    return len;
+  }
+#endif
+
   rc += fprintf(LogFileFP, "[%s]<%c> %s() ", timestamp(stamp), LevelAbbr[level + 3], function);
 
   va_list ap;
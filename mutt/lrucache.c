@@ -0,0 +1,205 @@
+/**
+ * @file
+ * Least-recently-used cache
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_lrucache Least-recently-used cache
+ *
+ * A bounded cache of string-keyed entries.  Lookups go through a HashTable;
+ * a list threaded through the entries tracks recency, so when the cache
+ * exceeds its entry count or total data size, the entries used longest ago
+ * are evicted first, through a caller-supplied callback.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include "lrucache.h"
+#include "hash.h"
+#include "memory.h"
+#include "queue.h"
+#include "string2.h"
+
+/**
+ * struct LruEntry - An entry in an LruCache
+ */
+struct LruEntry
+{
+  char *key;                     ///< Lookup key (owned copy)
+  void *data;                    ///< Caller's data
+  size_t size;                   ///< Caller-declared size of data
+  TAILQ_ENTRY(LruEntry) entries; ///< Linked list, most recently used first
+};
+TAILQ_HEAD(LruEntryList, LruEntry);
+
+/**
+ * struct LruCache - Least-recently-used cache
+ */
+struct LruCache
+{
+  struct HashTable *table;  ///< Key to LruEntry lookup
+  struct LruEntryList list; ///< Entries, most recently used first
+  size_t max_count;         ///< Maximum number of entries, 0 for unlimited
+  size_t max_size;          ///< Maximum total size of the data, 0 for unlimited
+  size_t count;             ///< Current number of entries
+  size_t size;              ///< Current total size of the data
+  lru_evict_t evict;        ///< Callback to dispose of evicted data
+};
+
+/**
+ * lru_entry_free - Evict an entry and free it
+ * @param lc    Cache
+ * @param entry Entry to free
+ */
+static void lru_entry_free(struct LruCache *lc, struct LruEntry *entry)
+{
+  mutt_hash_delete(lc->table, entry->key, entry);
+  TAILQ_REMOVE(&lc->list, entry, entries);
+  lc->count--;
+  lc->size -= entry->size;
+
+  if (lc->evict)
+    lc->evict(entry->key, entry->data);
+  FREE(&entry->key);
+  FREE(&entry);
+}
+
+/**
+ * lru_cache_trim - Evict entries until the cache is within its bounds
+ * @param lc Cache
+ */
+static void lru_cache_trim(struct LruCache *lc)
+{
+  while (((lc->max_count != 0) && (lc->count > lc->max_count)) ||
+         ((lc->max_size != 0) && (lc->size > lc->max_size)))
+  {
+    struct LruEntry *last = TAILQ_LAST(&lc->list, LruEntryList);
+    if (!last)
+      break;
+    lru_entry_free(lc, last);
+  }
+}
+
+/**
+ * lru_cache_new - Create a new LruCache
+ * @param max_count Maximum number of entries, 0 for unlimited
+ * @param max_size  Maximum total size of the data, 0 for unlimited
+ * @param evict     Callback to dispose of evicted data (OPTIONAL)
+ * @retval ptr New LruCache
+ */
+struct LruCache *lru_cache_new(size_t max_count, size_t max_size, lru_evict_t evict)
+{
+  struct LruCache *lc = mutt_mem_calloc(1, sizeof(struct LruCache));
+
+  size_t buckets = (max_count != 0) ? max_count : 128;
+  lc->table = mutt_hash_new(buckets, MUTT_HASH_NO_FLAGS);
+  TAILQ_INIT(&lc->list);
+  lc->max_count = max_count;
+  lc->max_size = max_size;
+  lc->evict = evict;
+
+  return lc;
+}
+
+/**
+ * lru_cache_free - Free an LruCache and evict all its entries
+ * @param[out] ptr Cache to free
+ */
+void lru_cache_free(struct LruCache **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct LruCache *lc = *ptr;
+
+  struct LruEntry *entry = NULL;
+  while ((entry = TAILQ_FIRST(&lc->list)))
+    lru_entry_free(lc, entry);
+
+  mutt_hash_free(&lc->table);
+  FREE(ptr);
+}
+
+/**
+ * lru_cache_get - Look up an entry and mark it most recently used
+ * @param lc  Cache
+ * @param key Key to look up
+ * @retval ptr  Data of the matching entry
+ * @retval NULL No matching entry
+ */
+void *lru_cache_get(struct LruCache *lc, const char *key)
+{
+  if (!lc || !key)
+    return NULL;
+
+  struct LruEntry *entry = mutt_hash_find(lc->table, key);
+  if (!entry)
+    return NULL;
+
+  if (entry != TAILQ_FIRST(&lc->list))
+  {
+    TAILQ_REMOVE(&lc->list, entry, entries);
+    TAILQ_INSERT_HEAD(&lc->list, entry, entries);
+  }
+
+  return entry->data;
+}
+
+/**
+ * lru_cache_insert - Add an entry to a cache
+ * @param lc   Cache
+ * @param key  Key of the entry
+ * @param data Data of the entry
+ * @param size Size of data, if the cache is size-bounded (else 0)
+ *
+ * An existing entry with the same key is evicted first.  Entries used
+ * longest ago are then evicted until the cache is within its bounds again.
+ */
+void lru_cache_insert(struct LruCache *lc, const char *key, void *data, size_t size)
+{
+  if (!lc || !key)
+    return;
+
+  struct LruEntry *old = mutt_hash_find(lc->table, key);
+  if (old)
+    lru_entry_free(lc, old);
+
+  struct LruEntry *entry = mutt_mem_calloc(1, sizeof(struct LruEntry));
+  entry->key = mutt_str_dup(key);
+  entry->data = data;
+  entry->size = size;
+
+  mutt_hash_insert(lc->table, entry->key, entry);
+  TAILQ_INSERT_HEAD(&lc->list, entry, entries);
+  lc->count++;
+  lc->size += size;
+
+  lru_cache_trim(lc);
+}
+
+/**
+ * lru_cache_count - Count the entries in a cache
+ * @param lc Cache
+ * @retval num Number of entries
+ */
+size_t lru_cache_count(const struct LruCache *lc)
+{
+  return lc ? lc->count : 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file
+ * Least-recently-used cache
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_LRUCACHE_H
+#define MUTT_MUTT_LRUCACHE_H
+
+#include <stddef.h>
+
+struct LruCache;
+
+/**
+ * @defgroup lru_evict_api LRU Cache Eviction API
+ *
+ * lru_evict_t - Dispose of a cache entry's data
+ * @param key  Key of the entry being evicted
+ * @param data Data of the entry being evicted
+ *
+ * Called when an entry is pushed out of the cache, replaced by a new value
+ * for the same key, or dropped by lru_cache_free().
+ */
+typedef void (*lru_evict_t)(const char *key, void *data);
+
+struct LruCache *lru_cache_new(size_t max_count, size_t max_size, lru_evict_t evict);
+void             lru_cache_free(struct LruCache **ptr);
+void *           lru_cache_get(struct LruCache *lc, const char *key);
+void             lru_cache_insert(struct LruCache *lc, const char *key, void *data, size_t size);
+size_t           lru_cache_count(const struct LruCache *lc);
+
+#endif /* MUTT_MUTT_LRUCACHE_H */
@@ -31,6 +31,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <wchar.h>
 #include <wctype.h>
@@ -125,6 +126,49 @@ bool mutt_mb_get_initials(const char *name, char *buf, size_t buflen)
   return true;
 }
 
+/**
+ * mutt_mb_ascii_run - Measure a leading run of printable ASCII
+ * @param s String to scan
+ * @param n Length of string in bytes
+ * @retval num Bytes in the run
+ *
+ * Count the leading bytes in the range 0x20-0x7E, eight at a time using
+ * word-sized bit tricks.  In a UTF-8 locale, each such byte is one character,
+ * one screen column wide, so width calculation can skip mbrtowc() and
+ * wcwidth() for the run.  Tabs, newlines and the menu's tree/colour markers
+ * are all control bytes, so they end a run.
+ */
+size_t mutt_mb_ascii_run(const char *s, size_t n)
+{
+  const uint64_t ones = UINT64_C(0x0101010101010101);
+  const uint64_t high = UINT64_C(0x8080808080808080);
+
+  size_t i = 0;
+  while ((n - i) >= 8)
+  {
+    uint64_t chunk;
+    memcpy(&chunk, s + i, 8);
+
+    const uint64_t ctrl = (chunk - (ones * 0x20)) & ~chunk;  // any byte < 0x20
+    const uint64_t del7f = chunk ^ (ones * 0x7f);            // zero byte == DEL
+    const uint64_t del = (del7f - ones) & ~del7f;
+
+    if ((chunk | ctrl | del) & high)
+      break;
+
+    i += 8;
+  }
+
+  for (; i < n; i++)
+  {
+    const unsigned char c = s[i];
+    if ((c < 0x20) || (c > 0x7e))
+      break;
+  }
+
+  return i;
+}
+
 /**
  * mutt_mb_width - Measure a string's display width (in screen columns)
  * @param str     String to measure
@@ -147,6 +191,18 @@ int mutt_mb_width(const char *str, int col, bool indent)
 
   while (*str && (str_len > 0))
   {
+    if (CharsetIsUtf8 && !nl)
+    {
+      const size_t run = mutt_mb_ascii_run(str, str_len);
+      if (run > 0)
+      {
+        total_width += run;
+        str += run;
+        str_len -= run;
+        continue;
+      }
+    }
+
     wchar_t wc = L'\0';
     size_t consumed = mbrtowc(&wc, str, str_len, &mbstate);
     if (consumed == 0)
@@ -220,7 +276,13 @@ int mutt_mb_wcswidth(const wchar_t *s, size_t n)
 
   int w = 0;
   while (n--)
-    w += mutt_mb_wcwidth(*s++);
+  {
+    const wchar_t wc = *s++;
+    if ((wc >= 0x20) && (wc < 0x7f))
+      w++; // printable ASCII is always one column
+    else
+      w += mutt_mb_wcwidth(wc);
+  }
   return w;
 }
 
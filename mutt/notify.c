@@ -43,7 +43,7 @@ static const char *NotifyTypeNames[] = {
   "NT_BINDING", "NT_COLOR",    "NT_COMMAND", "NT_CONFIG", "NT_CONTEXT",
   "NT_EMAIL",   "NT_ENVELOPE", "NT_GLOBAL",  "NT_HEADER", "NT_INDEX",
   "NT_MAILBOX", "NT_MENU",     "NT_PAGER",   "NT_RESIZE", "NT_SCORE",
-  "NT_SUBJRX",  "NT_TIMEOUT",  "NT_WINDOW",
+  "NT_SUBJRX",  "NT_TIMEOUT",  "NT_TPOOL",  "NT_WINDOW",
 };
 
 /**
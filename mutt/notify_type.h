@@ -54,6 +54,7 @@ enum NotifyType
   NT_SCORE,     ///< Email scoring has changed
   NT_SUBJRX,    ///< Subject Regex has changed,     #NotifySubjRx
   NT_TIMEOUT,   ///< Timeout has occurred
+  NT_TPOOL,     ///< ThreadPool task has completed, #NotifyTPool, #EventTPool
   NT_WINDOW,    ///< MuttWindow has changed,        #NotifyWindow,    #EventWindow
 };
 
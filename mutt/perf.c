@@ -0,0 +1,142 @@
+/**
+ * @file
+ * Lightweight performance counters
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_perf Lightweight performance counters
+ *
+ * Counters and timers around the expensive operations: mailbox open/check/sync,
+ * header cache hits/misses and network traffic.  They cost an addition per
+ * event, so they're always on.  The accumulated numbers are printed by
+ * perf_report(), reachable from the `perf-report` command.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <time.h>
+#include "perf.h"
+
+/**
+ * struct PerfData - Accumulated data for one PerfCounter
+ */
+struct PerfData
+{
+  uint64_t events; ///< Number of times the counter was hit
+  uint64_t amount; ///< Accumulated nanoseconds or bytes
+};
+
+/// Accumulated counters, indexed by #PerfCounter
+static struct PerfData PerfCounters[PERF_MAX] = { 0 };
+
+/**
+ * struct PerfInfo - Name and unit of one PerfCounter
+ */
+struct PerfInfo
+{
+  const char *name; ///< Name shown in the report
+  bool timed;       ///< Amount is nanoseconds (true) or bytes (false)
+};
+
+/// Display names for #PerfCounter, same order as the enum
+static const struct PerfInfo PerfNames[PERF_MAX] = {
+  // clang-format off
+  [PERF_MBOX_OPEN]   = { "mailbox-open",  true  },
+  [PERF_MBOX_CHECK]  = { "mailbox-check", true  },
+  [PERF_MBOX_SYNC]   = { "mailbox-sync",  true  },
+  [PERF_HCACHE_HIT]  = { "hcache-hit",    false },
+  [PERF_HCACHE_MISS] = { "hcache-miss",   false },
+  [PERF_NET_READ]    = { "net-read",      false },
+  [PERF_NET_WRITE]   = { "net-write",     false },
+  [PERF_NET_INFLATED] = { "net-inflated", false },
+  [PERF_NET_DEFLATED] = { "net-deflated", false },
+  // clang-format on
+};
+
+/**
+ * perf_clock - Read the monotonic clock
+ * @retval num Current time, in nanoseconds from an arbitrary origin
+ */
+uint64_t perf_clock(void)
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/**
+ * perf_count - Record one event on a counter
+ * @param pc     Counter to update
+ * @param amount Nanoseconds or bytes to add
+ */
+void perf_count(enum PerfCounter pc, uint64_t amount)
+{
+  PerfCounters[pc].events++;
+  PerfCounters[pc].amount += amount;
+}
+
+/**
+ * perf_time - Record the time elapsed since a perf_clock() reading
+ * @param pc    Counter to update
+ * @param start Earlier reading of perf_clock()
+ */
+void perf_time(enum PerfCounter pc, uint64_t start)
+{
+  perf_count(pc, perf_clock() - start);
+}
+
+/**
+ * perf_total - Read a counter's accumulated total
+ * @param pc Counter to read
+ * @retval num Accumulated nanoseconds or bytes
+ *
+ * Taking the difference of two readings measures one operation, e.g. the
+ * bytes a single network transfer moved.
+ */
+uint64_t perf_total(enum PerfCounter pc)
+{
+  return PerfCounters[pc].amount;
+}
+
+/**
+ * perf_report - Print the accumulated counters
+ * @param fp File to write to
+ */
+void perf_report(FILE *fp)
+{
+  if (!fp)
+    return;
+
+  fprintf(fp, "%-15s %10s %15s\n", "counter", "events", "total");
+  for (int i = 0; i < PERF_MAX; i++)
+  {
+    const struct PerfData *pd = &PerfCounters[i];
+    if (PerfNames[i].timed)
+    {
+      fprintf(fp, "%-15s %10llu %12.3f s\n", PerfNames[i].name,
+              (unsigned long long) pd->events, (double) pd->amount / 1e9);
+    }
+    else
+    {
+      fprintf(fp, "%-15s %10llu %13llu B\n", PerfNames[i].name,
+              (unsigned long long) pd->events, (unsigned long long) pd->amount);
+    }
+  }
+}
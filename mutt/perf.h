@@ -0,0 +1,55 @@
+/**
+ * @file
+ * Lightweight performance counters
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_PERF_H
+#define MUTT_MUTT_PERF_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * enum PerfCounter - Instrumented operations
+ *
+ * Timed counters accumulate nanoseconds; byte counters accumulate bytes.
+ * Every counter also records how many times it was hit.
+ */
+enum PerfCounter
+{
+  PERF_MBOX_OPEN,   ///< Time spent opening mailboxes
+  PERF_MBOX_CHECK,  ///< Time spent checking mailboxes for new mail
+  PERF_MBOX_SYNC,   ///< Time spent syncing mailboxes
+  PERF_HCACHE_HIT,  ///< Header cache lookups that found a usable entry
+  PERF_HCACHE_MISS, ///< Header cache lookups that came back empty
+  PERF_NET_READ,    ///< Bytes read from the network
+  PERF_NET_WRITE,   ///< Bytes written to the network
+  PERF_NET_INFLATED, ///< Uncompressed bytes produced by the compression layer
+  PERF_NET_DEFLATED, ///< Uncompressed bytes given to the compression layer
+  PERF_MAX,
+};
+
+uint64_t perf_clock (void);
+void     perf_count (enum PerfCounter pc, uint64_t amount);
+void     perf_time  (enum PerfCounter pc, uint64_t start);
+uint64_t perf_total (enum PerfCounter pc);
+void     perf_report(FILE *fp);
+
+#endif /* MUTT_MUTT_PERF_H */
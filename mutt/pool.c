@@ -24,54 +24,142 @@
  * @page mutt_pool A global pool of Buffers
  *
  * A shared pool of Buffers to save lots of allocs/frees.
+ *
+ * The pool keeps its idle Buffers in a few size classes and trims each Buffer
+ * to its class size on release, so one huge string doesn't pin every pooled
+ * Buffer at the largest size ever seen.  Where threads are available each
+ * thread has its own pool, so the parser workers never contend with the main
+ * thread for a lock; a Buffer released on a different thread than it was
+ * acquired on simply migrates.
  */
 
 #include "config.h"
 #include <stdio.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "pool.h"
 #include "buffer.h"
 #include "logging2.h"
 #include "memory.h"
 
-/// Number of buffers in the pool
-static size_t BufferPoolCount = 0;
-/// Total size of the pool
-static size_t BufferPoolLen = 0;
-/// Amount to increase the size of the pool
-static const size_t BufferPoolIncrement = 20;
-/// Minimum size for a buffer
-static const size_t BufferPoolInitialBufferSize = 1024;
-/// A pool of buffers
-static struct Buffer **BufferPool = NULL;
+/// Sizes of the pool's Buffer classes
+static const size_t PoolClassSizes[] = { 1024, 8192, 65536 };
+/// Idle Buffers kept per class; any more are freed on release
+static const size_t PoolClassLimits[] = { 20, 8, 2 };
+/// Number of Buffer classes
+#define POOL_NUM_CLASSES mutt_array_size(PoolClassSizes)
+/// Largest of the PoolClassLimits
+#define POOL_MAX_KEEP 20
+
+/**
+ * struct BufferPool - A per-thread pool of Buffers
+ */
+struct BufferPool
+{
+  struct Buffer *bufs[POOL_NUM_CLASSES][POOL_MAX_KEEP]; ///< Idle Buffers, stacked per class
+  size_t count[POOL_NUM_CLASSES];                       ///< Number of idle Buffers per class
+};
+
+#ifdef HAVE_PTHREAD_CREATE
+/// Key for each thread's own BufferPool
+static pthread_key_t PoolKey;
+/// Create PoolKey only once
+static pthread_once_t PoolKeyOnce = PTHREAD_ONCE_INIT;
+#else
+/// The sole BufferPool of a threadless build
+static struct BufferPool PoolSingle = { 0 };
+#endif
+
+/**
+ * pool_drop - Free all the Buffers held by a pool
+ * @param bp Pool to empty
+ */
+static void pool_drop(struct BufferPool *bp)
+{
+  for (size_t c = 0; c < POOL_NUM_CLASSES; c++)
+  {
+    while (bp->count[c])
+      buf_free(&bp->bufs[c][--bp->count[c]]);
+  }
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * pool_destroy - Free a thread's pool - Implements ::pthread key destructor
+ * @param arg BufferPool of the exiting thread
+ */
+static void pool_destroy(void *arg)
+{
+  struct BufferPool *bp = arg;
+  if (!bp)
+    return;
+
+  pool_drop(bp);
+  FREE(&bp);
+}
 
 /**
- * pool_increase_size - Increase the size of the Buffer pool
+ * pool_key_init - Create the thread-local pool key
  */
-static void pool_increase_size(void)
+static void pool_key_init(void)
 {
-  BufferPoolLen += BufferPoolIncrement;
-  mutt_debug(LL_DEBUG1, "%zu\n", BufferPoolLen);
+  pthread_key_create(&PoolKey, pool_destroy);
+}
+#endif
 
-  mutt_mem_realloc(&BufferPool, BufferPoolLen * sizeof(struct Buffer *));
-  while (BufferPoolCount < BufferPoolIncrement)
+/**
+ * pool_get - Get the calling thread's BufferPool
+ * @retval ptr BufferPool, created on first use
+ */
+static struct BufferPool *pool_get(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_once(&PoolKeyOnce, pool_key_init);
+  struct BufferPool *bp = pthread_getspecific(PoolKey);
+  if (!bp)
   {
-    struct Buffer *newbuf = buf_new(NULL);
-    buf_alloc(newbuf, BufferPoolInitialBufferSize);
-    BufferPool[BufferPoolCount++] = newbuf;
+    bp = mutt_mem_calloc(1, sizeof(struct BufferPool));
+    pthread_setspecific(PoolKey, bp);
   }
+  return bp;
+#else
+  return &PoolSingle;
+#endif
+}
+
+/**
+ * pool_class - Find the Buffer class a size belongs to
+ * @param dsize Buffer data size
+ * @retval num Index of the largest class not bigger than @a dsize
+ */
+static size_t pool_class(size_t dsize)
+{
+  size_t c = 0;
+  while (((c + 1) < POOL_NUM_CLASSES) && (dsize >= PoolClassSizes[c + 1]))
+    c++;
+  return c;
 }
 
 /**
  * buf_pool_cleanup - Release the Buffer pool
+ *
+ * Frees the calling thread's pool.  The worker threads' pools are freed
+ * automatically when those threads exit.
  */
 void buf_pool_cleanup(void)
 {
-  mutt_debug(LL_DEBUG1, "%zu of %zu returned to pool\n", BufferPoolCount, BufferPoolLen);
-
-  while (BufferPoolCount)
-    buf_free(&BufferPool[--BufferPoolCount]);
-  FREE(&BufferPool);
-  BufferPoolLen = 0;
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_once(&PoolKeyOnce, pool_key_init);
+  struct BufferPool *bp = pthread_getspecific(PoolKey);
+  if (bp)
+  {
+    pthread_setspecific(PoolKey, NULL);
+    pool_destroy(bp);
+  }
+#else
+  pool_drop(&PoolSingle);
+#endif
 }
 
 /**
@@ -80,9 +168,18 @@ void buf_pool_cleanup(void)
  */
 struct Buffer *buf_pool_get(void)
 {
-  if (BufferPoolCount == 0)
-    pool_increase_size();
-  return BufferPool[--BufferPoolCount];
+  struct BufferPool *bp = pool_get();
+
+  // An idle Buffer from a bigger class beats a fresh malloc
+  for (size_t c = 0; c < POOL_NUM_CLASSES; c++)
+  {
+    if (bp->count[c])
+      return bp->bufs[c][--bp->count[c]];
+  }
+
+  struct Buffer *newbuf = buf_new(NULL);
+  buf_alloc(newbuf, PoolClassSizes[0]);
+  return newbuf;
 }
 
 /**
@@ -96,25 +193,24 @@ void buf_pool_release(struct Buffer **ptr)
   if (!ptr || !*ptr)
     return;
 
-  if (BufferPoolCount >= BufferPoolLen)
+  struct BufferPool *bp = pool_get();
+  struct Buffer *buf = *ptr;
+
+  const size_t c = pool_class(buf->dsize);
+  if (bp->count[c] >= PoolClassLimits[c])
   {
-    // LCOV_EXCL_START
-    mutt_debug(LL_DEBUG1, "Internal buffer pool error\n");
     buf_free(ptr);
     return;
-    // LCOV_EXCL_STOP
   }
 
-  // Reset the size if it's too big or too small
-  struct Buffer *buf = *ptr;
-  if ((buf->dsize > (2 * BufferPoolInitialBufferSize)) ||
-      (buf->dsize < BufferPoolInitialBufferSize))
+  // Trim (or grow an undersized stray) to its class size
+  if (buf->dsize != PoolClassSizes[c])
   {
-    buf->dsize = BufferPoolInitialBufferSize;
+    buf->dsize = PoolClassSizes[c];
     mutt_mem_realloc(&buf->data, buf->dsize);
   }
   buf_reset(buf);
-  BufferPool[BufferPoolCount++] = buf;
+  bp->bufs[c][bp->count[c]++] = buf;
 
   *ptr = NULL;
 }
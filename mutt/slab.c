@@ -0,0 +1,157 @@
+/**
+ * @file
+ * Slab allocator for identically-sized objects
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_slab Slab allocator for identically-sized objects
+ *
+ * Opening a big mailbox allocates an Email, Envelope and Body per message.
+ * Rather than do millions of small mallocs, carve the objects out of large
+ * blocks and recycle released objects through a free list.
+ */
+
+#include "config.h"
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include "slab.h"
+#include "memory.h"
+
+/// Number of objects allocated per block
+static const size_t SlabObjsPerBlock = 256;
+/// All the Slabs holding memory, for slab_cleanup()
+static struct Slab *SlabList = NULL;
+#ifdef HAVE_PTHREAD_CREATE
+/// Lock for the Slabs - parser worker threads share them with the main thread
+static pthread_mutex_t SlabMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * slab_lock - Take exclusive ownership of the Slabs
+ */
+static inline void slab_lock(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_lock(&SlabMutex);
+#endif
+}
+
+/**
+ * slab_unlock - Release ownership of the Slabs
+ */
+static inline void slab_unlock(void)
+{
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_unlock(&SlabMutex);
+#endif
+}
+
+/**
+ * slab_alloc - Get an object from a Slab
+ * @param slab Slab to allocate from
+ * @retval ptr Zeroed object of slab->obj_size bytes
+ *
+ * Release the object with slab_free() when it's no longer needed.
+ */
+void *slab_alloc(struct Slab *slab)
+{
+  slab_lock();
+
+  void *obj = slab->free_list;
+  if (obj)
+  {
+    memcpy(&slab->free_list, obj, sizeof(void *));
+  }
+  else
+  {
+    if ((slab->num_blocks == 0) || (slab->num_used == SlabObjsPerBlock))
+    {
+      if (slab->num_blocks == 0)
+      {
+        // First allocation: make the Slab known to slab_cleanup()
+        slab->next = SlabList;
+        SlabList = slab;
+      }
+      slab->num_blocks++;
+      mutt_mem_realloc(&slab->blocks, slab->num_blocks * sizeof(void *));
+      slab->blocks[slab->num_blocks - 1] = mutt_mem_malloc(SlabObjsPerBlock * slab->obj_size);
+      slab->num_used = 0;
+    }
+    obj = (char *) slab->blocks[slab->num_blocks - 1] + (slab->num_used * slab->obj_size);
+    slab->num_used++;
+  }
+
+  slab_unlock();
+
+  memset(obj, 0, slab->obj_size);
+  return obj;
+}
+
+/**
+ * slab_free - Return an object to its Slab
+ * @param[in]  slab Slab the object came from
+ * @param[out] ptr  Object to release
+ *
+ * The memory isn't returned to the system, but recycled by the next
+ * slab_alloc() on the same Slab.
+ *
+ * @note The pointer will be NULL'd
+ */
+void slab_free(struct Slab *slab, void **ptr)
+{
+  if (!slab || !ptr || !*ptr)
+    return;
+
+  slab_lock();
+  // The first bytes of a free object hold the free-list chain
+  memcpy(*ptr, &slab->free_list, sizeof(void *));
+  slab->free_list = *ptr;
+  slab_unlock();
+
+  *ptr = NULL;
+}
+
+/**
+ * slab_cleanup - Release the memory of all the Slabs
+ *
+ * Only call this at program exit, when no Slab objects are in use.
+ */
+void slab_cleanup(void)
+{
+  slab_lock();
+
+  struct Slab *next = NULL;
+  for (struct Slab *slab = SlabList; slab; slab = next)
+  {
+    next = slab->next;
+    for (size_t i = 0; i < slab->num_blocks; i++)
+      FREE(&slab->blocks[i]);
+    FREE(&slab->blocks);
+    slab->num_blocks = 0;
+    slab->num_used = 0;
+    slab->free_list = NULL;
+    slab->next = NULL;
+  }
+  SlabList = NULL;
+
+  slab_unlock();
+}
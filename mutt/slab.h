@@ -0,0 +1,58 @@
+/**
+ * @file
+ * Slab allocator for identically-sized objects
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_SLAB_H
+#define MUTT_MUTT_SLAB_H
+
+#include <stddef.h>
+
+/**
+ * struct Slab - Allocator for lots of identically-sized objects
+ *
+ * Objects are carved out of large, contiguous blocks and recycled through a
+ * free list when they're released, saving a malloc()/free() round-trip per
+ * object and keeping related objects close together in memory.
+ *
+ * Define one statically with #SLAB_INITIALIZER; the memory is handed back by
+ * slab_cleanup() at program exit.
+ */
+struct Slab
+{
+  size_t obj_size;   ///< Size of each object
+  void *free_list;   ///< Chain of released objects, ready for reuse
+  void **blocks;     ///< Blocks of memory the objects are carved from
+  size_t num_blocks; ///< Number of entries in blocks
+  size_t num_used;   ///< Objects handed out of the newest block
+  struct Slab *next; ///< Linked list of Slabs, for slab_cleanup()
+};
+
+/// Static initialiser for a Slab holding objects of the given type
+#define SLAB_INITIALIZER(type)                                                 \
+  {                                                                            \
+    .obj_size = sizeof(type),                                                  \
+  }
+
+void *slab_alloc(struct Slab *slab);
+void slab_free(struct Slab *slab, void **ptr);
+void slab_cleanup(void);
+
+#endif /* MUTT_MUTT_SLAB_H */
@@ -32,9 +32,11 @@
 #include <limits.h>
 #include <stdarg.h> // IWYU pragma: keep
 #include <stdio.h>
+#include <string.h>
 #include <wchar.h>
 #include "state.h"
 #include "date.h"
+#include "memory.h"
 #include "random.h"
 
 /**
@@ -117,43 +119,71 @@ void state_attach_puts(struct State *state, const char *t)
 }
 
 /**
- * state_putwc - Write a wide character to the state
+ * state_putws - Write a wide string to the state
  * @param state State to write to
- * @param wc    Wide character to write
+ * @param ws    Wide string to write
  * @retval  0 Success
  * @retval -1 Error
+ *
+ * The string is converted in spans and written with a few fwrite()s, rather
+ * than one stdio call per character.
  */
-static int state_putwc(struct State *state, wchar_t wc)
+int state_putws(struct State *state, const wchar_t *ws)
 {
-  char mb[MB_LEN_MAX] = { 0 };
-  int rc;
+  char buf[4096];
+  size_t used = 0;
+  mbstate_t mbstate = { 0 };
+
+  for (const wchar_t *p = ws; p && (*p != L'\0'); p++)
+  {
+    if ((used + MB_LEN_MAX) > sizeof(buf))
+    {
+      fwrite(buf, 1, used, state->fp_out);
+      used = 0;
+    }
+
+    const size_t rc = wcrtomb(buf + used, *p, &mbstate);
+    if (rc == (size_t) -1)
+      return -1;
+    used += rc;
+  }
 
-  rc = wcrtomb(mb, wc, NULL);
-  if (rc < 0)
-    return rc;
-  if (fputs(mb, state->fp_out) == EOF)
+  if (used && (fwrite(buf, 1, used, state->fp_out) != used))
     return -1;
   return 0;
 }
 
 /**
- * state_putws - Write a wide string to the state
+ * state_put - Write a fixed-length string to the State
  * @param state State to write to
- * @param ws    Wide string to write
- * @retval  0 Success
- * @retval -1 Error
+ * @param buf   String to write
+ * @param len   Length of string
  */
-int state_putws(struct State *state, const wchar_t *ws)
+void state_put(struct State *state, const char *buf, size_t len)
 {
-  const wchar_t *p = ws;
+  fwrite(buf, 1, len, state->fp_out);
+}
 
-  while (p && (*p != L'\0'))
+/**
+ * state_pad - Write a run of one character to the State
+ * @param state State to write to
+ * @param c     Character to repeat
+ * @param n     Length of the run
+ *
+ * Used for indents and alignment padding, which the handlers would otherwise
+ * write one character at a time.
+ */
+void state_pad(struct State *state, char c, size_t n)
+{
+  char pad[64];
+
+  memset(pad, c, MIN(n, sizeof(pad)));
+  while (n > 0)
   {
-    if (state_putwc(state, *p) < 0)
-      return -1;
-    p++;
+    const size_t chunk = MIN(n, sizeof(pad));
+    fwrite(pad, 1, chunk, state->fp_out);
+    n -= chunk;
   }
-  return 0;
 }
 
 /**
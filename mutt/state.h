@@ -61,10 +61,12 @@ struct State
 void state_attach_puts          (struct State *state, const char *t);
 void state_mark_attach          (struct State *state);
 void state_mark_protected_header(struct State *state);
+void state_pad                  (struct State *state, char c, size_t n);
 void state_prefix_put           (struct State *state, const char *buf, size_t buflen);
 void state_prefix_putc          (struct State *state, char c);
 int  state_printf               (struct State *state, const char *fmt, ...)
                                   __attribute__((__format__(__printf__, 2, 3)));
+void state_put                  (struct State *state, const char *buf, size_t len);
 int  state_putws                (struct State *state, const wchar_t *ws);
 
 const char *state_attachment_marker(void);
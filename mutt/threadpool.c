@@ -0,0 +1,273 @@
+/**
+ * @file
+ * Worker pool for background tasks
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_threadpool Worker pool for background tasks
+ *
+ * A small pool of worker threads with a shared task queue.
+ *
+ * Work functions run on the workers; completion functions run on whichever
+ * thread calls tpool_drain() - in practice the main thread, which makes them
+ * a safe place to touch curses or config.  Observers of the pool's Notify
+ * receive an #NT_TPOOL event per completed task.
+ */
+
+#include "config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "memory.h"
+#include "notify.h"
+#include "notify_type.h"
+#include "queue.h"
+#include "threadpool.h"
+
+/// Cap for the automatic worker count - the tasks are mostly I/O-bound
+#define TPOOL_MAX_AUTO_WORKERS 8
+
+/**
+ * struct ThreadTask - A unit of work for a ThreadPool
+ */
+struct ThreadTask
+{
+  tpool_work_t work;                 ///< Runs on a worker thread
+  tpool_done_t done;                 ///< Runs during tpool_drain()
+  void *wdata;                       ///< Private data for the callbacks
+  STAILQ_ENTRY(ThreadTask) entries;  ///< Linked list
+};
+STAILQ_HEAD(ThreadTaskList, ThreadTask);
+
+/**
+ * struct ThreadPool - A pool of worker threads
+ */
+struct ThreadPool
+{
+  pthread_t *threads;               ///< Worker thread handles
+  int num_threads;                  ///< Number of workers running
+  pthread_mutex_t mutex;            ///< Protects the queues and counters
+  pthread_cond_t work_cond;         ///< Signalled when work arrives (or shutdown)
+  pthread_cond_t idle_cond;         ///< Signalled when a worker finishes a task
+  struct ThreadTaskList pending;    ///< Tasks waiting for a worker
+  struct ThreadTaskList completed;  ///< Tasks waiting for tpool_drain()
+  int num_busy;                     ///< Tasks currently being executed
+  bool shutdown;                    ///< Workers should exit when the queue empties
+  struct Notify *notify;            ///< Notifications: #NotifyTPool, #EventTPool
+};
+
+/**
+ * tpool_worker - Take tasks off the queue and run them - Implements ::pthread entry point
+ * @param arg ThreadPool
+ * @retval NULL Always
+ */
+static void *tpool_worker(void *arg)
+{
+  struct ThreadPool *tp = arg;
+
+  pthread_mutex_lock(&tp->mutex);
+  while (true)
+  {
+    while (STAILQ_EMPTY(&tp->pending) && !tp->shutdown)
+      pthread_cond_wait(&tp->work_cond, &tp->mutex);
+
+    if (tp->shutdown && STAILQ_EMPTY(&tp->pending))
+      break;
+
+    struct ThreadTask *task = STAILQ_FIRST(&tp->pending);
+    STAILQ_REMOVE_HEAD(&tp->pending, entries);
+    tp->num_busy++;
+    pthread_mutex_unlock(&tp->mutex);
+
+    task->work(task->wdata);
+
+    pthread_mutex_lock(&tp->mutex);
+    tp->num_busy--;
+    STAILQ_INSERT_TAIL(&tp->completed, task, entries);
+    pthread_cond_broadcast(&tp->idle_cond);
+  }
+  pthread_mutex_unlock(&tp->mutex);
+
+  return NULL;
+}
+
+/**
+ * tpool_new - Create a ThreadPool
+ * @param num_workers Number of worker threads, or <=0 for one per CPU
+ * @retval ptr  New ThreadPool
+ * @retval NULL Error, no workers could be started
+ */
+struct ThreadPool *tpool_new(int num_workers)
+{
+  if (num_workers <= 0)
+  {
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_workers = (num_cpus < 1) ? 1 : (int) num_cpus;
+    if (num_workers > TPOOL_MAX_AUTO_WORKERS)
+      num_workers = TPOOL_MAX_AUTO_WORKERS;
+  }
+
+  struct ThreadPool *tp = mutt_mem_calloc(1, sizeof(struct ThreadPool));
+  STAILQ_INIT(&tp->pending);
+  STAILQ_INIT(&tp->completed);
+  pthread_mutex_init(&tp->mutex, NULL);
+  pthread_cond_init(&tp->work_cond, NULL);
+  pthread_cond_init(&tp->idle_cond, NULL);
+  tp->notify = notify_new();
+
+  tp->threads = mutt_mem_calloc(num_workers, sizeof(pthread_t));
+  for (int i = 0; i < num_workers; i++)
+  {
+    if (pthread_create(&tp->threads[i], NULL, tpool_worker, tp) != 0)
+      break;
+    tp->num_threads++;
+  }
+
+  if (tp->num_threads == 0)
+  {
+    tpool_free(&tp);
+    return NULL;
+  }
+
+  return tp;
+}
+
+/**
+ * tpool_submit - Queue a task for the workers
+ * @param tp    ThreadPool
+ * @param work  Function to run on a worker thread
+ * @param done  Function to run during tpool_drain(), may be NULL
+ * @param wdata Private data, passed to both functions
+ * @retval true Task was queued
+ */
+bool tpool_submit(struct ThreadPool *tp, tpool_work_t work, tpool_done_t done, void *wdata)
+{
+  if (!tp || !work)
+    return false;
+
+  struct ThreadTask *task = mutt_mem_calloc(1, sizeof(struct ThreadTask));
+  task->work = work;
+  task->done = done;
+  task->wdata = wdata;
+
+  pthread_mutex_lock(&tp->mutex);
+  STAILQ_INSERT_TAIL(&tp->pending, task, entries);
+  pthread_cond_signal(&tp->work_cond);
+  pthread_mutex_unlock(&tp->mutex);
+
+  return true;
+}
+
+/**
+ * tpool_drain - Run the completion callbacks for finished tasks
+ * @param tp ThreadPool
+ * @retval num Number of tasks drained
+ *
+ * Runs on the calling thread, so the callbacks (and the #NT_TPOOL observers)
+ * may safely touch state the workers mustn't.
+ */
+int tpool_drain(struct ThreadPool *tp)
+{
+  if (!tp)
+    return 0;
+
+  int count = 0;
+  while (true)
+  {
+    pthread_mutex_lock(&tp->mutex);
+    struct ThreadTask *task = STAILQ_FIRST(&tp->completed);
+    if (task)
+      STAILQ_REMOVE_HEAD(&tp->completed, entries);
+    pthread_mutex_unlock(&tp->mutex);
+
+    if (!task)
+      break;
+
+    if (task->done)
+      task->done(task->wdata);
+
+    struct EventTPool ev_t = { task->wdata };
+    notify_send(tp->notify, NT_TPOOL, NT_TPOOL_TASK_DONE, &ev_t);
+
+    FREE(&task);
+    count++;
+  }
+
+  return count;
+}
+
+/**
+ * tpool_wait - Wait for the workers to go idle
+ * @param tp ThreadPool
+ *
+ * On return, every submitted work function has finished.  The completion
+ * callbacks still need a tpool_drain().
+ */
+void tpool_wait(struct ThreadPool *tp)
+{
+  if (!tp)
+    return;
+
+  pthread_mutex_lock(&tp->mutex);
+  while (!STAILQ_EMPTY(&tp->pending) || (tp->num_busy > 0))
+    pthread_cond_wait(&tp->idle_cond, &tp->mutex);
+  pthread_mutex_unlock(&tp->mutex);
+}
+
+/**
+ * tpool_notify - Get the ThreadPool's notifications
+ * @param tp ThreadPool
+ * @retval ptr Notify to observe for #NT_TPOOL events
+ */
+struct Notify *tpool_notify(struct ThreadPool *tp)
+{
+  return tp ? tp->notify : NULL;
+}
+
+/**
+ * tpool_free - Shut down a ThreadPool
+ * @param[out] ptr ThreadPool to free
+ *
+ * Waits for the queued work to finish and drains any outstanding completions.
+ */
+void tpool_free(struct ThreadPool **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct ThreadPool *tp = *ptr;
+
+  pthread_mutex_lock(&tp->mutex);
+  tp->shutdown = true;
+  pthread_cond_broadcast(&tp->work_cond);
+  pthread_mutex_unlock(&tp->mutex);
+
+  for (int i = 0; i < tp->num_threads; i++)
+    pthread_join(tp->threads[i], NULL);
+
+  tpool_drain(tp);
+
+  notify_free(&tp->notify);
+  pthread_cond_destroy(&tp->idle_cond);
+  pthread_cond_destroy(&tp->work_cond);
+  pthread_mutex_destroy(&tp->mutex);
+  FREE(&tp->threads);
+  FREE(ptr);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * Worker pool for background tasks
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_THREADPOOL_H
+#define MUTT_MUTT_THREADPOOL_H
+
+#include <stdbool.h>
+
+struct Notify;
+struct ThreadPool;
+
+/**
+ * @defgroup tpool_work_api ThreadPool Work API
+ *
+ * Prototype for a ThreadPool work function
+ *
+ * @param wdata Private data, passed to tpool_submit()
+ *
+ * The function runs on a worker thread.  It must not touch curses, config or
+ * any other state owned by the main thread.
+ */
+typedef void (*tpool_work_t)(void *wdata);
+
+/**
+ * @defgroup tpool_done_api ThreadPool Completion API
+ *
+ * Prototype for a ThreadPool completion function
+ *
+ * @param wdata Private data, passed to tpool_submit()
+ *
+ * The function runs on the thread that calls tpool_drain(), after the work
+ * function has finished - never on a worker thread.
+ */
+typedef void (*tpool_done_t)(void *wdata);
+
+/**
+ * enum NotifyTPool - ThreadPool notifications
+ *
+ * Observers of #NT_TPOOL will be passed an #EventTPool.
+ */
+enum NotifyTPool
+{
+  NT_TPOOL_TASK_DONE = 1, ///< A Task has completed
+};
+
+/**
+ * struct EventTPool - A ThreadPool event
+ */
+struct EventTPool
+{
+  void *wdata; ///< Private data of the completed Task
+};
+
+struct ThreadPool *tpool_new(int num_workers);
+void               tpool_free(struct ThreadPool **ptr);
+
+bool           tpool_submit(struct ThreadPool *tp, tpool_work_t work, tpool_done_t done, void *wdata);
+int            tpool_drain (struct ThreadPool *tp);
+void           tpool_wait  (struct ThreadPool *tp);
+struct Notify *tpool_notify(struct ThreadPool *tp);
+
+#endif /* MUTT_MUTT_THREADPOOL_H */
@@ -446,6 +446,9 @@ static struct ConfigDef MainVars[] = {
   { "auto_tag", DT_BOOL, false, 0, NULL,
     "Automatically apply actions to all tagged messages"
   },
+  { "background_sync", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "Flush this many pending flag changes per idle tick (0 to disable)"
+  },
   { "beep", DT_BOOL, true, 0, NULL,
     "Make a noise when an error occurs"
   },
@@ -470,6 +473,9 @@ static struct ConfigDef MainVars[] = {
   { "color_directcolor", DT_BOOL|D_ON_STARTUP, false, 0, NULL,
     "Use 24bit colors (aka truecolor aka directcolor)"
   },
+  { "config_cache_file", DT_PATH|D_PATH_FILE, 0, 0, NULL,
+    "File in which to cache preprocessed config lines for faster startup"
+  },
   { "config_charset", DT_STRING, 0, 0, charset_validator,
     "Character set that the config files are in"
   },
@@ -518,12 +524,18 @@ static struct ConfigDef MainVars[] = {
   { "flag_chars", DT_MBTABLE, IP "*!DdrONon- ", 0, NULL,
     "User-configurable index flags: tagged, new, etc"
   },
+  { "flag_journal_dir", DT_PATH|D_PATH_DIR, 0, 0, NULL,
+    "Directory for the write-ahead journals of unsaved flag changes"
+  },
   { "flag_safe", DT_BOOL, false, 0, NULL,
     "Protect flagged messages from deletion"
   },
   { "folder", DT_STRING|D_STRING_MAILBOX, IP "~/Mail", 0, NULL,
     "Base folder for a set of mailboxes"
   },
+  { "folder_cache_count", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "Keep the views of this many recent folders alive for instant switching (0 to disable)"
+  },
   { "force_name", DT_BOOL, false, 0, NULL,
     "Save outgoing mail in a folder of their name"
   },
@@ -587,6 +599,9 @@ static struct ConfigDef MainVars[] = {
   { "keep_flagged", DT_BOOL, false, 0, NULL,
     "Don't move flagged messages from `$spool_file` to `$mbox`"
   },
+  { "lazy_hooks", DT_BOOL, false, 0, NULL,
+    "Delay compiling hook regexes and formats until the hook first fires"
+  },
   { "local_date_header", DT_BOOL, true, 0, NULL,
     "Convert the date in the Date header of sent emails into local timezone, UTC otherwise"
   },
@@ -599,6 +614,9 @@ static struct ConfigDef MainVars[] = {
   { "mail_check_stats", DT_BOOL, false, 0, NULL,
     "Periodically check for new mail"
   },
+  { "mail_check_stats_budget", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "Time (in milliseconds) to spend counting mail per check, 0 for no limit"
+  },
   { "mail_check_stats_interval", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 60, 0, NULL,
     "How often to check for new mail"
   },
@@ -626,6 +644,9 @@ static struct ConfigDef MainVars[] = {
   { "message_cache_dir", DT_PATH|D_PATH_DIR, 0, 0, NULL,
     "(imap/pop) Directory for the message cache"
   },
+  { "message_cache_size", DT_LONG|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(imap/pop) Evict the least recently used messages over this size (bytes), 0 for no limit"
+  },
   { "message_format", DT_EXPANDO|D_NOT_EMPTY, IP "%s", IP &IndexFormatDef, NULL,
     "printf-like format string for listing attached messages"
   },
@@ -668,6 +689,12 @@ static struct ConfigDef MainVars[] = {
   { "preferred_languages", DT_SLIST|D_SLIST_SEP_COMMA, 0, 0, NULL,
     "List of Preferred Languages for multilingual MIME (comma-separated)"
   },
+  { "prefetch_mailboxes", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "Warm the caches of this many frequently-visited mailboxes while idle"
+  },
+  { "prefetch_visits_file", DT_PATH|D_PATH_FILE, IP "~/.neomutt_visits", 0, NULL,
+    "File in which to store mailbox visit counts"
+  },
   { "print", DT_QUAD, MUTT_ASKNO, 0, NULL,
     "Confirm before printing a message"
   },
@@ -768,6 +795,9 @@ static struct ConfigDef MainVars[] = {
   { "send_charset", DT_SLIST|D_SLIST_SEP_COLON|D_SLIST_ALLOW_EMPTY|D_CHARSET_STRICT, IP "us-ascii:iso-8859-1:utf-8", 0, charset_slist_validator,
     "Character sets for outgoing mail"
   },
+  { "session_state_file", DT_PATH|D_PATH_FILE, 0, 0, NULL,
+    "File in which to save each mailbox's view (limit, collapsed threads, selection) between sessions"
+  },
   { "shell", DT_STRING|D_STRING_COMMAND, IP "/bin/sh", 0, NULL,
     "External command to run subshells in"
   },
@@ -1004,6 +1034,7 @@ static void init_variables(struct ConfigSet *cs)
   CONFIG_INIT_VARS(cs, pager);
   CONFIG_INIT_VARS(cs, pattern);
   CONFIG_INIT_VARS(cs, pop);
+  CONFIG_INIT_VARS(cs, preview);
   CONFIG_INIT_VARS(cs, send);
   CONFIG_INIT_VARS(cs, sidebar);
 }
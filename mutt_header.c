@@ -47,10 +47,13 @@
 #include "editor/lib.h"
 #include "history/lib.h"
 #include "index/lib.h"
+#include "key/lib.h"
+#include "menu/lib.h"
 #include "ncrypt/lib.h"
 #include "postpone/lib.h"
 #include "send/lib.h"
 #include "globals.h"
+#include "mutt_logging.h"
 #include "muttlib.h"
 #include "mview.h"
 
@@ -433,3 +436,146 @@ void mutt_label_hash_remove(struct Mailbox *m, struct Email *e)
   if (e->env->x_label)
     label_ref_dec(m, e->env->x_label);
 }
+
+/**
+ * struct LabelCount - One label and how many messages use it
+ */
+struct LabelCount
+{
+  const char *label; ///< Label text, owned by Mailbox::label_hash
+  uintptr_t count;   ///< Number of messages carrying it
+};
+
+/// Help Bar for the Label Selection dialog
+static const struct Mapping LabelHelp[] = {
+  // clang-format off
+  { N_("Exit"),   OP_EXIT },
+  { N_("Select"), OP_GENERIC_SELECT_ENTRY },
+  { N_("Help"),   OP_HELP },
+  { NULL, 0 },
+  // clang-format on
+};
+
+/**
+ * label_count_sort - Compare two labels - Implements ::sort_t - @ingroup sort_api
+ */
+static int label_count_sort(const void *a, const void *b, void *sdata)
+{
+  const struct LabelCount *la = a;
+  const struct LabelCount *lb = b;
+
+  return mutt_istr_cmp(la->label, lb->label);
+}
+
+/**
+ * label_make_entry - Format a Label for the Menu - Implements Menu::make_entry() - @ingroup menu_make_entry
+ */
+static int label_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *buf)
+{
+  const struct LabelCount *lc = &((struct LabelCount *) menu->mdata)[line];
+
+  return buf_printf(buf, "%6lu  %s", (unsigned long) lc->count, lc->label);
+}
+
+/**
+ * mutt_label_select - Let the user pick a label used in the Mailbox - @ingroup gui_dlg
+ * @param[in]  m     Mailbox
+ * @param[out] label Buffer for the chosen label
+ * @retval true A label was chosen
+ *
+ * The Label Selection Dialog lists every X-Label in Mailbox::label_hash with
+ * its message count, so label-based workflows don't depend on remembering the
+ * exact text.  The chosen label is typically fed to a `~y` limit.
+ */
+bool mutt_label_select(struct Mailbox *m, struct Buffer *label)
+{
+  if (!m || !m->label_hash)
+    return false;
+
+  struct HashElem *he = NULL;
+  struct HashWalkState hws = { 0 };
+  int num_labels = 0;
+
+  while ((he = mutt_hash_walk(m->label_hash, &hws)))
+    num_labels++;
+
+  if (num_labels == 0)
+  {
+    mutt_error(_("No labels in this mailbox"));
+    return false;
+  }
+
+  struct LabelCount *labels = mutt_mem_calloc(num_labels, sizeof(struct LabelCount));
+  memset(&hws, 0, sizeof(hws));
+  for (int i = 0; (he = mutt_hash_walk(m->label_hash, &hws)); i++)
+  {
+    labels[i].label = he->key.strkey;
+    labels[i].count = (uintptr_t) he->data;
+  }
+  mutt_qsort_r(labels, num_labels, sizeof(struct LabelCount), label_count_sort, NULL);
+
+  struct MuttWindow *dlg = simple_dialog_new(MENU_GENERIC, WT_DLG_LABEL, LabelHelp);
+
+  struct MuttWindow *sbar = window_find_child(dlg, WT_STATUS_BAR);
+  sbar_set_title(sbar, _("Labels"));
+
+  struct Menu *menu = dlg->wdata;
+  menu->make_entry = label_make_entry;
+  menu->max = num_labels;
+  menu->mdata = labels;
+  menu->mdata_free = NULL; // Freed below
+
+  bool done = false;
+  bool picked = false;
+
+  struct MuttWindow *old_focus = window_set_focus(menu->win);
+  // ---------------------------------------------------------------------------
+  // Event Loop
+  int op = OP_NULL;
+  do
+  {
+    menu_tagging_dispatcher(menu->win, op);
+    window_redraw(NULL);
+
+    op = km_dokey(MENU_DIALOG, GETCH_NO_FLAGS);
+    mutt_debug(LL_DEBUG1, "Got op %s (%d)\n", opcodes_get_name(op), op);
+    if (op < 0)
+      continue;
+    if (op == OP_NULL)
+    {
+      km_error_key(MENU_GENERIC);
+      continue;
+    }
+    mutt_clear_error();
+
+    int rc = FR_UNKNOWN;
+    if (op == OP_GENERIC_SELECT_ENTRY)
+    {
+      const int index = menu_get_index(menu);
+      if ((index >= 0) && (index < num_labels))
+      {
+        buf_strcpy(label, labels[index].label);
+        picked = true;
+      }
+      done = true;
+      rc = FR_SUCCESS;
+    }
+    else if (op == OP_EXIT)
+    {
+      done = true;
+      rc = FR_SUCCESS;
+    }
+
+    if (rc == FR_UNKNOWN)
+      rc = menu_function_dispatcher(menu->win, op);
+    if (rc == FR_UNKNOWN)
+      rc = global_function_dispatcher(NULL, op);
+  } while (!done);
+  // ---------------------------------------------------------------------------
+
+  window_set_focus(old_focus);
+  simple_dialog_free(&dlg);
+  FREE(&labels);
+
+  return picked;
+}
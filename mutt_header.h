@@ -23,6 +23,8 @@
 #ifndef MUTT_MUTT_HEADER_H
 #define MUTT_MUTT_HEADER_H
 
+#include <stdbool.h>
+
 struct Buffer;
 struct Email;
 struct EmailArray;
@@ -30,6 +32,7 @@ struct Mailbox;
 struct MailboxView;
 
 void mutt_edit_headers(const char *editor, const char *body, struct Email *e, struct Buffer *fcc);
+bool mutt_label_select(struct Mailbox *m, struct Buffer *label);
 void mutt_label_hash_add(struct Mailbox *m, struct Email *e);
 void mutt_label_hash_remove(struct Mailbox *m, struct Email *e);
 int mutt_label_message(struct MailboxView *mv, struct EmailArray *ea);
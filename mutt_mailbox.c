@@ -29,6 +29,7 @@
  */
 
 #include "config.h"
+#include <stdint.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -38,11 +39,13 @@
 #include "core/lib.h"
 #include "mutt_mailbox.h"
 #include "postpone/lib.h"
+#ifdef USE_INOTIFY
+#include "monitor.h"
+#endif
 #include "muttlib.h"
 #include "mx.h"
 
 static time_t MailboxTime = 0; ///< last time we started checking for mail
-static time_t MailboxStatsTime = 0; ///< last time we check performed mail_check_stats
 static short MailboxCount = 0;  ///< how many boxes with new mail
 static short MailboxNotify = 0; ///< # of unnotified new boxes
 
@@ -134,6 +137,13 @@ static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
       case MUTT_MMDF:
       case MUTT_MAILDIR:
       case MUTT_MH:
+#ifdef USE_INOTIFY
+        /* If the watch has seen no activity, skip the poll.  Periodic stats
+         * checks still go through: the watch doesn't cover flag changes
+         * inside a maildir's cur/ directory. */
+        if (((flags & MUTT_MAILBOX_CHECK_STATS) == 0) && mutt_monitor_unchanged(m_check))
+          break;
+#endif
         mx_mbox_check_stats(m_check, flags);
         break;
       default:; /* do nothing */
@@ -177,17 +187,18 @@ int mutt_mailbox_check(struct Mailbox *m_cur, CheckStatsFlags flags)
   const short c_mail_check = cs_subset_number(NeoMutt->sub, "mail_check");
   const bool c_mail_check_stats = cs_subset_bool(NeoMutt->sub, "mail_check_stats");
   const short c_mail_check_stats_interval = cs_subset_number(NeoMutt->sub, "mail_check_stats_interval");
+  const short c_mail_check_stats_budget = cs_subset_number(NeoMutt->sub, "mail_check_stats_budget");
 
   time_t t = mutt_date_now();
   if ((flags == MUTT_MAILBOX_CHECK_NO_FLAGS) && ((t - MailboxTime) < c_mail_check))
     return MailboxCount;
 
-  if ((flags & MUTT_MAILBOX_CHECK_STATS) ||
-      (c_mail_check_stats && ((t - MailboxStatsTime) >= c_mail_check_stats_interval)))
-  {
-    flags |= MUTT_MAILBOX_CHECK_STATS;
-    MailboxStatsTime = t;
-  }
+  /* Stats checks requested by the user run in full.  Periodic checks are
+   * budgeted: each Mailbox is recounted when its interval expires, but once
+   * the budget is spent the remaining Mailboxes wait for a later check. */
+  uint64_t stats_deadline = 0;
+  if (!(flags & MUTT_MAILBOX_CHECK_STATS) && (c_mail_check_stats_budget > 0))
+    stats_deadline = mutt_date_now_ms() + c_mail_check_stats_budget;
 
   MailboxTime = t;
   MailboxCount = 0;
@@ -213,10 +224,16 @@ int mutt_mailbox_check(struct Mailbox *m_cur, CheckStatsFlags flags)
       continue;
 
     CheckStatsFlags m_flags = flags;
-    if (!m->first_check_stats_done && c_mail_check_stats)
+    if (!(m_flags & MUTT_MAILBOX_CHECK_STATS) && c_mail_check_stats &&
+        (!m->first_check_stats_done ||
+         ((t - m->last_stats_check) >= c_mail_check_stats_interval)))
     {
-      m_flags |= MUTT_MAILBOX_CHECK_STATS;
+      if ((stats_deadline == 0) || (mutt_date_now_ms() < stats_deadline))
+        m_flags |= MUTT_MAILBOX_CHECK_STATS;
+      /* otherwise leave the Mailbox due - a later check will resume here */
     }
+    if (m_flags & MUTT_MAILBOX_CHECK_STATS)
+      m->last_stats_check = t;
     mailbox_check(m_cur, m, &st_cur, m_flags);
     if (m->has_new)
       MailboxCount++;
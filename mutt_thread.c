@@ -46,6 +46,9 @@
 #include "mx.h"
 #include "protos.h"
 #include "sort.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
 
 /**
  * UseThreadsMethods - Choices for '$use_threads' for the index
@@ -229,9 +232,9 @@ static void linearize_tree(struct ThreadsContext *tctx)
  * this calculates whether a node is the root of a subtree that has visible
  * nodes, whether a node itself is visible, whether, if invisible, it has
  * depth anyway, and whether any of its later siblings are roots of visible
- * subtrees.  while it's at it, it frees the old thread display, so we can
- * skip parts of the tree in mutt_draw_tree() if we've decided here that we
- * don't care about them any more.
+ * subtrees.  while it's at it, it frees the thread display of messages that
+ * are no longer visible; visible ones keep their strings so mutt_draw_tree()
+ * can reuse any whose column hasn't changed shape.
  */
 static void calculate_visibility(struct MuttThread *tree, int *max_depth)
 {
@@ -259,9 +262,9 @@ static void calculate_visibility(struct MuttThread *tree, int *max_depth)
       *max_depth = depth;
 
     tree->subtree_visible = 0;
+    tree->agg_valid = false; /* visibility is part of the cached aggregates */
     if (tree->message)
     {
-      FREE(&tree->message->tree);
       if (is_visible(tree->message))
       {
         tree->deep = true;
@@ -283,6 +286,7 @@ static void calculate_visibility(struct MuttThread *tree, int *max_depth)
       }
       else
       {
+        FREE(&tree->message->tree);
         tree->visible = false;
         tree->deep = !c_hide_limited;
       }
@@ -393,7 +397,7 @@ void mutt_thread_ctx_free(struct ThreadsContext **ptr)
  */
 void mutt_draw_tree(struct ThreadsContext *tctx)
 {
-  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *new_tree = NULL;
+  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *scratch = NULL;
   const bool reverse = (mutt_thread_style() == UT_REVERSE);
   enum TreeChar corner = reverse ? MUTT_TREE_ULCORNER : MUTT_TREE_LLCORNER;
   enum TreeChar vtee = reverse ? MUTT_TREE_BTEE : MUTT_TREE_TTEE;
@@ -403,11 +407,12 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
 
   struct MuttThread *tree = tctx->tree;
 
-  /* Do the visibility calculations and free the old thread chars.
-   * From now on we can simply ignore invisible subtrees */
+  /* Do the visibility calculations and drop the thread chars of messages that
+   * are no longer visible.  From now on we can simply ignore invisible subtrees */
   calculate_visibility(tree, &max_depth);
   pfx = mutt_mem_malloc((width * max_depth) + 2);
   arrow = mutt_mem_malloc((width * max_depth) + 2);
+  scratch = mutt_mem_malloc((width * max_depth) + 2);
   const bool c_hide_limited = cs_subset_bool(NeoMutt->sub, "hide_limited");
   const bool c_hide_missing = cs_subset_bool(NeoMutt->sub, "hide_missing");
   while (tree)
@@ -432,20 +437,26 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
       {
         myarrow[width] = MUTT_TREE_RARROW;
         myarrow[width + 1] = 0;
-        new_tree = mutt_mem_malloc(((size_t) depth * width) + 2);
         if (start_depth > 1)
         {
-          strncpy(new_tree, pfx, (size_t) width * (start_depth - 1));
-          mutt_str_copy(new_tree + (start_depth - 1) * width, arrow,
+          strncpy(scratch, pfx, (size_t) width * (start_depth - 1));
+          mutt_str_copy(scratch + (start_depth - 1) * width, arrow,
                         (1 + depth - start_depth) * width + 2);
         }
         else
         {
-          mutt_str_copy(new_tree, arrow, ((size_t) depth * width) + 2);
+          mutt_str_copy(scratch, arrow, ((size_t) depth * width) + 2);
         }
-        tree->message->tree = new_tree;
+        /* Keep the old allocation if the column hasn't changed shape */
+        if (!mutt_str_equal(tree->message->tree, scratch))
+          mutt_str_replace(&tree->message->tree, scratch);
       }
     }
+    else if (tree->message)
+    {
+      /* Top-level messages have no tree column */
+      FREE(&tree->message->tree);
+    }
     if (tree->child && (depth != 0))
     {
       mypfx = pfx + (depth - 1) * width;
@@ -509,27 +520,29 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
 
   FREE(&pfx);
   FREE(&arrow);
+  FREE(&scratch);
 }
 
 /**
  * make_subject_list - Create a sorted list of all subjects in a thread
- * @param[out] subjects String List of subjects
- * @param[in]  cur      Email Thread
- * @param[out] dateptr  Earliest date found in thread
+ * @param[out] subjects         String List of subjects
+ * @param[in]  cur              Email Thread
+ * @param[out] dateptr          Earliest date found in thread
+ * @param[in]  c_thread_received Value of $thread_received
+ * @param[in]  c_sort_re         Value of $sort_re
  *
  * Since we may be trying to attach as a pseudo-thread a MuttThread that has no
  * message, we have to make a list of all the subjects of its most immediate
  * existing descendants.
  */
-static void make_subject_list(struct ListHead *subjects, struct MuttThread *cur, time_t *dateptr)
+static void make_subject_list(struct ListHead *subjects, struct MuttThread *cur,
+                              time_t *dateptr, bool c_thread_received, bool c_sort_re)
 {
   struct MuttThread *start = cur;
   struct Envelope *env = NULL;
   time_t thisdate;
   int rc = 0;
 
-  const bool c_thread_received = cs_subset_bool(NeoMutt->sub, "thread_received");
-  const bool c_sort_re = cs_subset_bool(NeoMutt->sub, "sort_re");
   while (true)
   {
     while (!cur->message)
@@ -570,14 +583,17 @@ static void make_subject_list(struct ListHead *subjects, struct MuttThread *cur,
 
 /**
  * find_subject - Find the best possible match for a parent based on subject
- * @param m   Mailbox
- * @param cur Email to match
+ * @param m                Mailbox
+ * @param cur              Email to match
+ * @param c_thread_received Value of $thread_received
+ * @param c_sort_re         Value of $sort_re
  * @retval ptr Best match for a parent
  *
  * If there are multiple matches, the one which was sent the latest, but before
  * the current message, is used.
  */
-static struct MuttThread *find_subject(struct Mailbox *m, struct MuttThread *cur)
+static struct MuttThread *find_subject(struct Mailbox *m, struct MuttThread *cur,
+                                       bool c_thread_received, bool c_sort_re)
 {
   if (!m)
     return NULL;
@@ -587,24 +603,25 @@ static struct MuttThread *find_subject(struct Mailbox *m, struct MuttThread *cur
   struct ListHead subjects = STAILQ_HEAD_INITIALIZER(subjects);
   time_t date = 0;
 
-  make_subject_list(&subjects, cur, &date);
+  make_subject_list(&subjects, cur, &date, c_thread_received, c_sort_re);
 
   struct ListNode *np = NULL;
-  const bool c_thread_received = cs_subset_bool(NeoMutt->sub, "thread_received");
   STAILQ_FOREACH(np, &subjects, entries)
   {
     for (he = mutt_hash_find_bucket(m->subj_hash, np->data); he; he = he->next)
     {
       tmp = ((struct Email *) he->data)->thread;
+      /* cheap scalar tests first; is_descendant() walks the tree and
+       * mutt_str_equal() compares the whole subject */
       if ((tmp != cur) &&                  /* don't match the same message */
           !tmp->fake_thread &&             /* don't match pseudo threads */
           tmp->message->subject_changed && /* only match interesting replies */
-          !is_descendant(tmp, cur) &&      /* don't match in the same thread */
           (date >= (c_thread_received ? tmp->message->received : tmp->message->date_sent)) &&
           (!last || (c_thread_received ?
                          (last->message->received < tmp->message->received) :
                          (last->message->date_sent < tmp->message->date_sent))) &&
           tmp->message->env->real_subj &&
+          !is_descendant(tmp, cur) &&      /* don't match in the same thread */
           mutt_str_equal(np->data, tmp->message->env->real_subj))
       {
         last = tmp; /* best match so far */
@@ -640,13 +657,53 @@ static struct HashTable *make_subj_hash(struct Mailbox *m)
   return hash;
 }
 
+/**
+ * thread_earliest_date - Find the earliest date in a thread
+ * @param cur Email Thread
+ * @retval num Date of the oldest message in the thread
+ *
+ * @sa make_subject_list(), which computes the same date
+ */
+static time_t thread_earliest_date(struct MuttThread *cur)
+{
+  struct MuttThread *start = cur;
+  time_t date = 0;
+
+  const bool c_thread_received = cs_subset_bool(NeoMutt->sub, "thread_received");
+  while (true)
+  {
+    while (!cur->message)
+      cur = cur->child;
+
+    const time_t thisdate = c_thread_received ? cur->message->received :
+                                                cur->message->date_sent;
+    if ((date == 0) || (thisdate < date))
+      date = thisdate;
+
+    while (!cur->next && (cur != start))
+    {
+      cur = cur->parent;
+    }
+    if (cur == start)
+      break;
+    cur = cur->next;
+  }
+
+  return date;
+}
+
 /**
  * pseudo_threads - Thread messages by subject
- * @param tctx Threading context
+ * @param tctx       Threading context
+ * @param oldest_new Date of the oldest newly arrived Email, 0 if none
+ * @param init       If true, rematch every thread
+ *
+ * Thread by subject things that didn't get threaded by message-id.
  *
- * Thread by subject things that didn't get threaded by message-id
+ * On an incremental pass, only threads that changed (#MuttThread.check_pseudo)
+ * or that a newly arrived message could become the parent of, are rematched.
  */
-static void pseudo_threads(struct ThreadsContext *tctx)
+static void pseudo_threads(struct ThreadsContext *tctx, time_t oldest_new, bool init)
 {
   if (!tctx || !tctx->mailbox_view)
     return;
@@ -661,11 +718,24 @@ static void pseudo_threads(struct ThreadsContext *tctx)
   if (!m->subj_hash)
     m->subj_hash = make_subj_hash(m);
 
+  const bool c_thread_received = cs_subset_bool(NeoMutt->sub, "thread_received");
+  const bool c_sort_re = cs_subset_bool(NeoMutt->sub, "sort_re");
+
   while (tree)
   {
     cur = tree;
     tree = tree->next;
-    parent = find_subject(m, cur);
+
+    if (!init && !cur->check_pseudo)
+    {
+      /* a parent must be older than the thread, so an unchanged thread only
+       * needs rematching if a new message is old enough to be its parent */
+      if ((oldest_new == 0) || (thread_earliest_date(cur) < oldest_new))
+        continue;
+    }
+    cur->check_pseudo = false;
+
+    parent = find_subject(m, cur, c_thread_received, c_sort_re);
     if (parent)
     {
       cur->fake_thread = true;
@@ -1041,6 +1111,8 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   struct MuttThread *thread = NULL, *tnew = NULL, *tmp = NULL;
   struct MuttThread top = { 0 };
   struct ListNode *ref = NULL;
+  int *new_msgs = NULL; ///< Indices of the Emails threaded during this pass
+  int num_new = 0;
 
   ASSERT(m->msg_count > 0);
   if (!tctx->hash)
@@ -1087,6 +1159,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
           unlink_message(&thread->child, tnew);
           insert_message(&top.child, &top, tnew);
           tnew->fake_thread = false;
+          tnew->check_pseudo = true;
         }
         tnew = tmp;
       }
@@ -1172,6 +1245,13 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
       continue;
     e->threaded = true;
 
+    if (!init)
+    {
+      if (!new_msgs)
+        new_msgs = mutt_mem_malloc(m->msg_count * sizeof(int));
+      new_msgs[num_new++] = i;
+    }
+
     thread = e->thread;
     if (!thread)
       continue;
@@ -1255,11 +1335,32 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   }
   tctx->tree = top.child;
 
+  /* mark the threads the new arrivals ended up in, so pseudo_threads()
+   * can leave the others untouched */
+  time_t oldest_new = 0;
+  const bool c_thread_received = cs_subset_bool(NeoMutt->sub, "thread_received");
+  for (int j = 0; j < num_new; j++)
+  {
+    e = m->emails[new_msgs[j]];
+    if (!e || !e->thread)
+      continue;
+
+    for (thread = e->thread; thread->parent; thread = thread->parent)
+      ; // walk up to the root of the thread
+
+    thread->check_pseudo = true;
+
+    const time_t date = c_thread_received ? e->received : e->date_sent;
+    if ((oldest_new == 0) || (date < oldest_new))
+      oldest_new = date;
+  }
+  FREE(&new_msgs);
+
   check_subjects(mv, init);
 
   const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
   if (!c_strict_threads)
-    pseudo_threads(tctx);
+    pseudo_threads(tctx, oldest_new, init);
 
   /* if $sort_aux or similar changed after the mailbox is sorted, then
    * all the subthreads need to be resorted */
@@ -1276,6 +1377,341 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   }
 }
 
+#ifdef USE_HCACHE
+/// Header Cache key of the record holding the last thread graph
+static const char ThreadCacheKey[] = "thread-graph";
+
+/**
+ * struct ThreadRef - Preorder position of a MuttThread
+ *
+ * Used to map the MuttThread pointers in ThreadsContext.hash back to their
+ * position in the serialised graph.
+ */
+struct ThreadRef
+{
+  const struct MuttThread *thread; ///< Node in the thread graph
+  int index;                       ///< Its preorder position
+};
+
+/**
+ * compare_thread_refs - Compare two ThreadRefs by their node's address
+ * @param a First ThreadRef
+ * @param b Second ThreadRef
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ */
+static int compare_thread_refs(const void *a, const void *b)
+{
+  const struct ThreadRef *ra = a;
+  const struct ThreadRef *rb = b;
+
+  if (ra->thread == rb->thread)
+    return 0;
+  return (ra->thread > rb->thread) ? 1 : -1;
+}
+
+/**
+ * thread_cache_open - Open the Header Cache holding a Mailbox's thread graph
+ * @param m      Mailbox
+ * @param create Create the Header Cache if it doesn't exist
+ * @retval ptr Header Cache
+ *
+ * The record refers to the messages by their paths, so it's only kept for
+ * Mailbox types where each message is a separate file.
+ */
+static struct HeaderCache *thread_cache_open(struct Mailbox *m, bool create)
+{
+  const enum MailboxType type = mx_type(m);
+  if ((type != MUTT_MAILDIR) && (type != MUTT_MH))
+    return NULL;
+
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+  if (!c_header_cache)
+    return NULL;
+
+  return hcache_open(c_header_cache, mailbox_path(m), NULL, create, m->readonly);
+}
+
+/**
+ * mutt_thread_cache_store - Record the computed thread graph in the Header Cache
+ * @param tctx Threading context
+ *
+ * One record describes the whole graph: a settings line holding the config
+ * the graph's shape depends on and the node count, then one line per
+ * MuttThread in preorder, so parents always precede their children:
+ *
+ *     <parent> <flags> <path>TAB<key>
+ *
+ * parent is the line number of the parent node, or -1 for a thread root.
+ * path is empty for ghost nodes (messages that are referenced, but not
+ * present).  key is the node's key in ThreadsContext.hash: the message-id,
+ * or the reference string that conjured up a ghost.
+ */
+void mutt_thread_cache_store(struct ThreadsContext *tctx)
+{
+  if (!tctx || !tctx->mailbox_view || !tctx->tree || !tctx->hash)
+    return;
+
+  struct Mailbox *m = tctx->mailbox_view->mailbox;
+  struct HeaderCache *hc = thread_cache_open(m, true);
+  if (!hc)
+    return;
+
+  /* Count the nodes, ghosts included */
+  int count = 0;
+  struct MuttThread *thread = tctx->tree;
+  while (thread)
+  {
+    count++;
+    if (thread->child)
+    {
+      thread = thread->child;
+    }
+    else
+    {
+      while (thread && !thread->next)
+        thread = thread->parent;
+      if (thread)
+        thread = thread->next;
+    }
+  }
+
+  struct MuttThread **nodes = mutt_mem_calloc(count, sizeof(struct MuttThread *));
+  int *parents = mutt_mem_calloc(count, sizeof(int));
+  int *stack = mutt_mem_calloc(count, sizeof(int));
+  struct ThreadRef *refs = mutt_mem_calloc(count, sizeof(struct ThreadRef));
+  const char **keys = mutt_mem_calloc(count, sizeof(const char *));
+  struct Buffer *rec = buf_pool_get();
+
+  /* Preorder walk, tracking each node's parent by its position */
+  int idx = 0;
+  int depth = 0;
+  thread = tctx->tree;
+  while (thread)
+  {
+    nodes[idx] = thread;
+    parents[idx] = (depth == 0) ? -1 : stack[depth - 1];
+    refs[idx].thread = thread;
+    refs[idx].index = idx;
+    stack[depth] = idx;
+    idx++;
+
+    if (thread->child)
+    {
+      depth++;
+      thread = thread->child;
+    }
+    else
+    {
+      while (thread && !thread->next)
+      {
+        thread = thread->parent;
+        depth--;
+      }
+      if (thread)
+        thread = thread->next;
+    }
+  }
+
+  /* The keys live in the hash; map them back to the nodes they belong to.
+   * The hash may also hold nodes that were pruned from the tree - skip them. */
+  qsort(refs, count, sizeof(struct ThreadRef), compare_thread_refs);
+  struct HashWalkState walk = { 0 };
+  struct HashElem *he = NULL;
+  while ((he = mutt_hash_walk(tctx->hash, &walk)))
+  {
+    struct ThreadRef ref = { he->data, 0 };
+    struct ThreadRef *found = bsearch(&ref, refs, count, sizeof(struct ThreadRef),
+                                      compare_thread_refs);
+    if (found)
+      keys[found->index] = he->key.strkey;
+  }
+
+  const bool c_duplicate_threads = cs_subset_bool(NeoMutt->sub, "duplicate_threads");
+  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
+  buf_printf(rec, "%d %d %d\n", c_duplicate_threads, c_strict_threads, count);
+
+  for (int i = 0; i < count; i++)
+  {
+    thread = nodes[i];
+    if (thread->message && !thread->message->path)
+      goto done; /* no stable name to refer to the message by */
+
+    const unsigned int tflags = (thread->fake_thread ? 1 : 0) |
+                                (thread->duplicate_thread ? 2 : 0);
+    buf_add_printf(rec, "%d %u %s\t%s\n", parents[i], tflags,
+                   thread->message ? thread->message->path : "",
+                   keys[i] ? keys[i] : "");
+  }
+
+  hcache_store_raw(hc, ThreadCacheKey, strlen(ThreadCacheKey), rec->data, buf_len(rec));
+
+done:
+  buf_pool_release(&rec);
+  FREE(&keys);
+  FREE(&refs);
+  FREE(&stack);
+  FREE(&parents);
+  FREE(&nodes);
+  hcache_close(&hc);
+}
+
+/**
+ * mutt_thread_cache_restore - Rebuild the thread graph from the Header Cache
+ * @param tctx Threading context
+ * @retval true The cached graph was still valid and has been restored
+ *
+ * The record is only trusted if it was made with the same config, every path
+ * it names is present, and every message is covered.  Any mismatch and the
+ * caller threads from scratch, as if the record didn't exist.
+ *
+ * The parent/child/sibling links and the pseudo-thread markers are taken
+ * from the record; everything derived from them (subject changes, subthread
+ * order, the drawn tree) is recomputed, so config that only affects display
+ * can't go stale.
+ */
+bool mutt_thread_cache_restore(struct ThreadsContext *tctx)
+{
+  if (!tctx || !tctx->mailbox_view || tctx->tree || tctx->hash)
+    return false;
+
+  struct MailboxView *mv = tctx->mailbox_view;
+  struct Mailbox *m = mv->mailbox;
+  if (!m || (m->msg_count == 0))
+    return false;
+
+  bool rc = false;
+  char *record = NULL;
+  struct HashTable *paths = NULL;
+  struct MuttThread **nodes = NULL;
+
+  struct HeaderCache *hc = thread_cache_open(m, false);
+  if (!hc)
+    return false;
+
+  record = hcache_fetch_raw_str(hc, ThreadCacheKey, strlen(ThreadCacheKey));
+  if (!record)
+    goto done;
+
+  /* The first line holds the settings the graph was computed with */
+  char *line = strchr(record, '\n');
+  int duplicate_threads = 0;
+  int strict_threads = 0;
+  int count = 0;
+  const bool c_duplicate_threads = cs_subset_bool(NeoMutt->sub, "duplicate_threads");
+  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
+  if (!line || (sscanf(record, "%d %d %d", &duplicate_threads, &strict_threads, &count) != 3) ||
+      (duplicate_threads != c_duplicate_threads) ||
+      (strict_threads != c_strict_threads) || (count < m->msg_count))
+  {
+    goto done;
+  }
+  line++;
+
+  int num_lines = 0;
+  for (const char *p = line; (p = strchr(p, '\n')); p++)
+    num_lines++;
+  if (num_lines != count)
+    goto done;
+
+  paths = mutt_hash_new(m->msg_count, MUTT_HASH_NO_FLAGS);
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->path)
+      goto done;
+    mutt_hash_insert(paths, e->path, e);
+  }
+
+  nodes = mutt_mem_calloc(count, sizeof(struct MuttThread *));
+
+  /* mutt_sort_threads() borrows its keys from the Envelopes, but the record
+   * is freed below, so this hash must copy them */
+  tctx->hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_ALLOW_DUPS | MUTT_HASH_STRDUP_KEYS);
+  mutt_hash_set_destructor(tctx->hash, thread_hash_destructor, 0);
+
+  int matched = 0;
+  for (int num = 0; num < count; num++)
+  {
+    char *nl = strchr(line, '\n');
+    *nl = '\0';
+
+    int parent = 0;
+    unsigned int tflags = 0;
+    int consumed = 0;
+    if ((sscanf(line, "%d %u %n", &parent, &tflags, &consumed) != 2) ||
+        (parent < -1) || (parent >= num))
+    {
+      goto done;
+    }
+
+    char *path = line + consumed;
+    char *key = strchr(path, '\t');
+    if (!key)
+      goto done;
+    *key = '\0';
+    key++;
+
+    struct MuttThread *thread = mutt_mem_calloc(1, sizeof(struct MuttThread));
+    nodes[num] = thread;
+    mutt_hash_insert(tctx->hash, key, thread); /* the hash owns the node now */
+    thread->fake_thread = (tflags & 1);
+    thread->duplicate_thread = (tflags & 2);
+
+    if (path[0] != '\0')
+    {
+      struct Email *e = mutt_hash_find(paths, path);
+      if (!e || e->thread) /* expired message, or one listed twice */
+        goto done;
+      thread->message = e;
+      e->thread = thread;
+      e->threaded = true;
+      matched++;
+    }
+
+    if (parent >= 0)
+      insert_message(&nodes[parent]->child, nodes[parent], thread);
+    else
+      insert_message(&tctx->tree, NULL, thread);
+
+    line = nl + 1;
+  }
+
+  if (matched != m->msg_count) /* new messages the record doesn't cover */
+    goto done;
+
+  /* The graph is good: recompute everything the links drive */
+  check_subjects(mv, true);
+  mutt_sort_subthreads(tctx, true);
+  OptSortSubthreads = false;
+  linearize_tree(tctx);
+  mutt_draw_tree(tctx);
+  rc = true;
+
+done:
+  if (!rc && tctx->hash)
+  {
+    /* partially rebuilt - throw it away and let the caller thread fully */
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      struct Email *e = m->emails[i];
+      if (!e)
+        break;
+      e->thread = NULL;
+      e->threaded = false;
+    }
+    tctx->tree = NULL;
+    mutt_hash_free(&tctx->hash);
+  }
+  FREE(&nodes);
+  mutt_hash_free(&paths);
+  FREE(&record);
+  hcache_close(&hc);
+  return rc;
+}
+#endif /* USE_HCACHE */
+
 /**
  * mutt_aside_thread - Find the next/previous (sub)thread
  * @param e          Search from this Email
@@ -1461,6 +1897,19 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
   while (thread->parent)
     thread = thread->parent;
   top = thread;
+
+  /* serve the read-only queries from the cached aggregates, O(depth)
+   * instead of O(subtree) */
+  if (top->agg_valid && !(flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE)))
+  {
+    if (flag & MUTT_THREAD_UNREAD)
+      return top->agg_unread;
+    if (flag & MUTT_THREAD_NEXT_UNREAD)
+      return top->agg_unread ? top->agg_min_unread : min_unread;
+    if (flag & MUTT_THREAD_FLAGGED)
+      return top->agg_flagged;
+  }
+
   while (!thread->message)
     thread = thread->child;
   e_cur = thread->message;
@@ -1499,6 +1948,12 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
 
   if ((thread == top) && !(thread = thread->child))
   {
+    /* cache the aggregates for the next read-only query */
+    top->agg_unread = (old_mail && new_mail) ? new_mail : (old_mail ? old_mail : new_mail);
+    top->agg_flagged = flagged;
+    top->agg_min_unread = min_unread;
+    top->agg_valid = true;
+
     /* return value depends on action requested */
     if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
     {
@@ -1506,7 +1961,7 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
       return final;
     }
     if (flag & MUTT_THREAD_UNREAD)
-      return (old_mail && new_mail) ? new_mail : (old_mail ? old_mail : new_mail);
+      return top->agg_unread;
     if (flag & MUTT_THREAD_NEXT_UNREAD)
       return min_unread;
     if (flag & MUTT_THREAD_FLAGGED)
@@ -1634,11 +2089,17 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
     }
   }
 
+  /* cache the aggregates for the next read-only query */
+  top->agg_unread = (old_mail && new_mail) ? new_mail : (old_mail ? old_mail : new_mail);
+  top->agg_flagged = flagged;
+  top->agg_min_unread = min_unread;
+  top->agg_valid = true;
+
   /* return value depends on action requested */
   if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
     return final;
   if (flag & MUTT_THREAD_UNREAD)
-    return (old_mail && new_mail) ? new_mail : (old_mail ? old_mail : new_mail);
+    return top->agg_unread;
   if (flag & MUTT_THREAD_NEXT_UNREAD)
     return min_unread;
   if (flag & MUTT_THREAD_FLAGGED)
@@ -1647,6 +2108,24 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
   return 0;
 }
 
+/**
+ * mutt_thread_invalidate - Mark an Email's cached thread aggregates as stale
+ * @param e Email whose flags have changed
+ *
+ * Propagate the change up to the thread root, so the next read-only
+ * mutt_traverse_thread() query recomputes the aggregates.
+ */
+void mutt_thread_invalidate(struct Email *e)
+{
+  if (!e || !e->thread)
+    return;
+
+  struct MuttThread *thread = e->thread;
+  while (thread->parent)
+    thread = thread->parent;
+  thread->agg_valid = false;
+}
+
 /**
  * mutt_messages_in_thread - Count the messages in a thread
  * @param m    Mailbox
@@ -103,7 +103,8 @@ enum UseThreads
 
 extern const struct EnumDef UseThreadsTypeDef;
 
-int mutt_traverse_thread(struct Email *e, MuttThreadFlags flag);
+int  mutt_traverse_thread(struct Email *e, MuttThreadFlags flag);
+void mutt_thread_invalidate(struct Email *e);
 #define mutt_collapse_thread(e)         mutt_traverse_thread(e, MUTT_THREAD_COLLAPSE)
 #define mutt_uncollapse_thread(e)       mutt_traverse_thread(e, MUTT_THREAD_UNCOLLAPSE)
 #define mutt_thread_contains_unread(e)  mutt_traverse_thread(e, MUTT_THREAD_UNREAD)
@@ -136,5 +137,9 @@ int                    mutt_messages_in_thread(struct Mailbox *m, struct Email *
 int                    mutt_parent_message    (struct Email *e, bool find_root);
 off_t                  mutt_set_vnum          (struct Mailbox *m);
 void                   mutt_sort_threads      (struct ThreadsContext *tctx, bool init);
+#ifdef USE_HCACHE
+bool                   mutt_thread_cache_restore(struct ThreadsContext *tctx);
+void                   mutt_thread_cache_store  (struct ThreadsContext *tctx);
+#endif
 
 #endif /* MUTT_MUTT_THREAD_H */
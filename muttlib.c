@@ -293,7 +293,7 @@ void buf_expand_path_regex(struct Buffer *buf, bool regex)
       buf_printf(tmp, "%s%s", buf_string(p), tail);
     }
 
-    buf_copy(buf, tmp);
+    buf_move(buf, tmp);
   } while (recurse);
 
   buf_pool_release(&p);
@@ -77,6 +77,7 @@ void mview_free(struct MailboxView **ptr)
   notify_free(&mv->notify);
   FREE(&mv->pattern);
   mutt_pattern_free(&mv->limit_pattern);
+  mutt_pattern_matches_free(&mv->matches);
 
   *ptr = NULL;
   FREE(&mv);
@@ -120,6 +121,7 @@ static void mview_clean(struct MailboxView *mv)
 {
   FREE(&mv->pattern);
   mutt_pattern_free(&mv->limit_pattern);
+  mutt_pattern_matches_free(&mv->matches);
   if (mv->mailbox)
     notify_observer_remove(mv->mailbox->notify, mview_mailbox_observer, mv);
 
@@ -215,7 +217,7 @@ void mview_update(struct MailboxView *mv)
     if (e->deleted)
       m->msg_deleted++;
     if (e->tagged)
-      m->msg_tagged++;
+      mailbox_tagged_add(m, e);
     if (!e->read)
     {
       m->msg_unread++;
@@ -283,7 +285,7 @@ static void update_tables(struct MailboxView *mv)
       }
 
       if (m->emails[j]->tagged)
-        m->msg_tagged++;
+        mailbox_tagged_add(m, m->emails[j]);
       if (m->emails[j]->flagged)
         m->msg_flagged++;
       if (!m->emails[j]->read)
@@ -331,6 +333,9 @@ int mview_mailbox_observer(struct NotifyCallback *nc)
 
   struct MailboxView *mv = nc->global_data;
 
+  /* Any change to the Mailbox can alter pattern match results */
+  mv->change_seq++;
+
   switch (nc->event_subtype)
   {
     case NT_MAILBOX_DELETE:
@@ -366,6 +371,17 @@ bool message_is_tagged(struct Email *e)
   return e->visible && e->tagged;
 }
 
+/**
+ * email_msgno_sort - Compare two Emails by msgno - Implements ::sort_t - @ingroup sort_api
+ */
+static int email_msgno_sort(const void *a, const void *b, void *sdata)
+{
+  const struct Email *ea = *(struct Email const *const *) a;
+  const struct Email *eb = *(struct Email const *const *) b;
+
+  return mutt_numeric_cmp(ea->msgno, eb->msgno);
+}
+
 /**
  * ea_add_tagged - Get an array of the tagged Emails
  * @param ea         Empty EmailArray to populate
@@ -382,17 +398,19 @@ int ea_add_tagged(struct EmailArray *ea, struct MailboxView *mv, struct Email *e
     if (!mv || !mv->mailbox || !mv->mailbox->emails)
       return -1;
 
+    /* The Mailbox maintains the set of tagged Emails, so only the tagged
+     * messages are visited, not the whole mailbox.  The set is in tagging
+     * order; sort the results back into mailbox order. */
     struct Mailbox *m = mv->mailbox;
-    for (int i = 0; i < m->msg_count; i++)
+    for (int i = 0; i < m->msg_tagged; i++)
     {
-      e = m->emails[i];
-      if (!e)
-        break;
+      e = m->tagged[i];
       if (!message_is_tagged(e))
-        continue;
+        continue; // hidden by the current limit
 
       ARRAY_ADD(ea, e);
     }
+    ARRAY_SORT(ea, email_msgno_sort, NULL);
   }
   else
   {
@@ -41,6 +41,8 @@ struct MailboxView
   off_t vsize;                       ///< Size (in bytes) of the messages shown
   char *pattern;                     ///< Limit pattern string
   struct PatternList *limit_pattern; ///< Compiled limit pattern
+  struct PatternMatches *matches;    ///< Cached results of the last full pattern match
+  unsigned int change_seq;           ///< Bumped when the Mailbox changes, invalidating #matches
   struct ThreadsContext *threads;    ///< Threads context
   int msg_in_pager;                  ///< Message currently shown in the pager
 
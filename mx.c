@@ -62,14 +62,20 @@
 #include "question/lib.h"
 #include "copy.h"
 #include "external.h"
+#include "flagjournal.h"
 #include "globals.h"
 #include "hook.h"
+#include "msgid.h"
 #include "mutt_header.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
 #include "muttlib.h"
+#include "prefetch.h"
 #include "nntp/mdata.h" // IWYU pragma: keep
 #include "protos.h"
+#ifdef USE_AUTOCRYPT
+#include "autocrypt/lib.h"
+#endif
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
 #endif
@@ -369,7 +375,16 @@ bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
   m->msg_tagged = 0;
   m->vcount = 0;
 
+#ifdef USE_AUTOCRYPT
+  // Batch the Autocrypt header updates into one database transaction
+  mutt_autocrypt_batch_begin();
+#endif
+  const uint64_t t_start = perf_clock();
   enum MxOpenReturns rc = m->mx_ops->mbox_open(m);
+  perf_time(PERF_MBOX_OPEN, t_start);
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_end();
+#endif
   m->opened++;
 
   if ((rc == MX_OPEN_OK) || (rc == MX_OPEN_ABORT))
@@ -397,6 +412,15 @@ bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
     m->has_new = false;
   OptForceRefresh = false;
 
+  if (!(flags & (MUTT_PEEK | MUTT_APPEND | MUTT_NEWFOLDER)))
+    prefetch_record_visit(mailbox_path(m));
+
+  if (!(flags & (MUTT_APPEND | MUTT_NEWFOLDER)))
+    msgid_index_record(m);
+
+  if (!m->readonly && !m->peekonly)
+    flag_journal_replay(m);
+
   return true;
 
 error:
@@ -464,7 +488,9 @@ static enum MxStatus sync_mailbox(struct Mailbox *m)
     mutt_message(_("Writing %s..."), mailbox_path(m));
   }
 
+  const uint64_t t_start = perf_clock();
   enum MxStatus rc = m->mx_ops->mbox_sync(m);
+  perf_time(PERF_MBOX_SYNC, t_start);
   if (rc != MX_STATUS_OK)
   {
     mutt_debug(LL_DEBUG2, "mbox_sync returned: %d\n", rc);
@@ -796,6 +822,7 @@ enum MxStatus mx_mbox_close(struct Mailbox *m)
       mutt_message(_("Mailbox is unchanged"));
     if ((m->type == MUTT_MBOX) || (m->type == MUTT_MMDF))
       mbox_reset_atime(m, NULL);
+    flag_journal_clear(m);
     mx_fastclose_mailbox(m, false);
     rc = MX_STATUS_OK;
     goto cleanup;
@@ -847,6 +874,8 @@ enum MxStatus mx_mbox_close(struct Mailbox *m)
     }
   }
 
+  flag_journal_clear(m);
+
   if (m->verbose)
   {
     if (move_messages)
@@ -1005,6 +1034,7 @@ enum MxStatus mx_mbox_sync(struct Mailbox *m)
         ((m->type == MUTT_MBOX) || (m->type == MUTT_MMDF)) &&
         !mutt_is_spool(mailbox_path(m)) && !c_save_empty)
     {
+      flag_journal_clear(m);
       unlink(mailbox_path(m));
       mx_fastclose_mailbox(m, false);
       return MX_STATUS_OK;
@@ -1025,6 +1055,9 @@ enum MxStatus mx_mbox_sync(struct Mailbox *m)
         mailbox_changed(m, NT_MAILBOX_RESORT);
       }
     }
+
+    msgid_index_record(m);
+    flag_journal_clear(m);
   }
 
   return rc;
@@ -1115,7 +1148,15 @@ enum MxStatus mx_mbox_check(struct Mailbox *m)
 
   m->last_checked = t;
 
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_begin();
+#endif
+  const uint64_t t_start = perf_clock();
   enum MxStatus rc = m->mx_ops->mbox_check(m);
+  perf_time(PERF_MBOX_CHECK, t_start);
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_end();
+#endif
   if ((rc == MX_STATUS_NEW_MAIL) || (rc == MX_STATUS_REOPENED))
   {
     mailbox_changed(m, NT_MAILBOX_INVALID);
@@ -1198,6 +1239,26 @@ int mx_msg_close(struct Mailbox *m, struct Message **ptr)
   return rc;
 }
 
+/**
+ * mx_msg_copy_batch - Copy a set of messages to another Mailbox - Wrapper for MxOps::msg_copy_batch()
+ * @param m_src Source Mailbox
+ * @param ea    Array of Emails to copy
+ * @param m_dst Destination Mailbox, opened for appending
+ * @retval  0 Success
+ * @retval  1 Not supported, copy the messages one at a time
+ * @retval -1 Failure
+ */
+int mx_msg_copy_batch(struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst)
+{
+  if (!m_src || !ea || !m_dst || !m_dst->append)
+    return 1;
+
+  if (!m_dst->mx_ops || !m_dst->mx_ops->msg_copy_batch)
+    return 1;
+
+  return m_dst->mx_ops->msg_copy_batch(m_src, ea, m_dst);
+}
+
 /**
  * mx_alloc_memory - Create storage for the emails
  * @param m        Mailbox
@@ -1482,7 +1543,8 @@ int mx_path_canon2(struct Mailbox *m, const char *folder)
 
   int rc = mx_path_canon(path, folder, &m->type);
 
-  mutt_str_replace(&m->realpath, buf_string(path));
+  FREE(&m->realpath);
+  m->realpath = buf_take_string(path);
   buf_pool_release(&path);
 
   if (rc >= 0)
@@ -31,6 +31,7 @@
 
 struct Buffer;
 struct Email;
+struct EmailArray;
 
 extern const struct EnumDef MboxTypeDef;
 
@@ -47,6 +48,7 @@ bool                 mx_mbox_open         (struct Mailbox *m, OpenMailboxFlags f
 enum MxStatus        mx_mbox_sync         (struct Mailbox *m);
 int                  mx_msg_close         (struct Mailbox *m, struct Message **ptr);
 int                  mx_msg_commit        (struct Mailbox *m, struct Message *msg);
+int                  mx_msg_copy_batch    (struct Mailbox *m_src, struct EmailArray *ea, struct Mailbox *m_dst);
 struct Message *     mx_msg_open_new      (struct Mailbox *m, const struct Email *e, MsgOpenFlags flags);
 struct Message *     mx_msg_open          (struct Mailbox *m, struct Email *e);
 int                  mx_msg_padding_size  (struct Mailbox *m);
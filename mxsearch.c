@@ -0,0 +1,459 @@
+/**
+ * @file
+ * Pattern search across many mailboxes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_mxsearch Pattern search across many mailboxes
+ *
+ * Match a pattern against every configured local Mailbox in one go, instead
+ * of opening each folder by hand.
+ *
+ * The pattern is compiled once, without #MUTT_PC_FULL_MSG, so it can only
+ * use data that lives in the cached headers - searching message bodies
+ * would mean reading every message in every folder.  Mailboxes are opened
+ * read-only on the main thread (the mx layer isn't thread-safe), while the
+ * matching itself is sharded across a small worker pool: pattern execution
+ * against loaded headers only reads shared data, so folder N can be matched
+ * while folder N+1 is being parsed.
+ *
+ * The hits from all folders are streamed into one results menu; selecting
+ * an entry hands the folder path and message-id back to the caller, which
+ * switches folders and selects the message.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "gui/lib.h"
+#include "mxsearch.h"
+#include "editor/lib.h"
+#include "history/lib.h"
+#include "key/lib.h"
+#include "menu/lib.h"
+#include "pattern/lib.h"
+#include "globals.h"
+#include "mutt_logging.h"
+#include "muttlib.h"
+#include "mx.h"
+
+/// Number of worker threads matching the pattern
+#define MXSEARCH_NUM_WORKERS 4
+
+/**
+ * struct MxSearchHit - One message that matched the pattern
+ */
+struct MxSearchHit
+{
+  char *folder;  ///< Path of the Mailbox holding the message
+  char *msgid;   ///< Message-id of the message, with angle brackets
+  char *display; ///< Pre-formatted line for the results menu
+};
+ARRAY_HEAD(MxSearchHitArray, struct MxSearchHit);
+
+ARRAY_HEAD(MxSearchIdxArray, int);
+
+/**
+ * struct MxSearchJob - Match one Mailbox against the pattern
+ */
+struct MxSearchJob
+{
+  struct Mailbox *m;               ///< Mailbox to search
+  struct PatternList *pats;        ///< Compiled pattern, shared by all jobs
+  bool close_after;                ///< Mailbox was opened for the search
+  struct MxSearchIdxArray matched; ///< Indices of the Emails that matched
+};
+
+/// Hits from all Mailboxes, in the order the jobs completed
+static struct MxSearchHitArray Hits = ARRAY_HEAD_INITIALIZER;
+
+/// Help Bar for the results menu
+static const struct Mapping MxSearchHelp[] = {
+  // clang-format off
+  { N_("Exit"),   OP_EXIT },
+  { N_("Select"), OP_GENERIC_SELECT_ENTRY },
+  { N_("Help"),   OP_HELP },
+  { NULL, 0 },
+  // clang-format on
+};
+
+/**
+ * hits_clear - Free all the search results
+ */
+static void hits_clear(void)
+{
+  struct MxSearchHit *hit = NULL;
+  ARRAY_FOREACH(hit, &Hits)
+  {
+    FREE(&hit->folder);
+    FREE(&hit->msgid);
+    FREE(&hit->display);
+  }
+  ARRAY_FREE(&Hits);
+}
+
+/**
+ * hit_add - Record a matching message
+ * @param m Mailbox holding the message
+ * @param e Email that matched
+ */
+static void hit_add(struct Mailbox *m, struct Email *e)
+{
+  struct MxSearchHit hit = { 0 };
+
+  hit.folder = mutt_str_dup(mailbox_path(m));
+  if (e->env->message_id)
+    hit.msgid = mutt_str_dup(e->env->message_id);
+
+  char folder[128] = { 0 };
+  mutt_str_copy(folder, mailbox_path(m), sizeof(folder));
+  mutt_pretty_mailbox(folder, sizeof(folder));
+
+  char date[16] = { 0 };
+  mutt_date_localtime_format(date, sizeof(date), "%b %d", e->received);
+
+  struct Buffer *from = buf_pool_get();
+  mutt_addrlist_write(&e->env->from, from, false);
+
+  struct Buffer *disp = buf_pool_get();
+  buf_printf(disp, "%-18.18s %s %-20.20s %s", folder, date, buf_string(from),
+             NONULL(e->env->subject));
+  hit.display = buf_strdup(disp);
+
+  buf_pool_release(&from);
+  buf_pool_release(&disp);
+
+  ARRAY_ADD(&Hits, hit);
+}
+
+/**
+ * search_worker - Match a Mailbox's Emails against the pattern - Implements ::tpool_work_t - @ingroup tpool_work_api
+ *
+ * Runs on a worker thread: it only reads the loaded headers and the shared,
+ * read-only pattern, and writes to the job's own index array.
+ */
+static void search_worker(void *wdata)
+{
+  struct MxSearchJob *job = wdata;
+  struct Mailbox *m = job->m;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->env)
+      continue;
+
+    if (mutt_pattern_exec(SLIST_FIRST(job->pats), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      ARRAY_ADD(&job->matched, i);
+  }
+}
+
+/**
+ * search_done - Collect the hits from a finished job - Implements ::tpool_done_t - @ingroup tpool_done_api
+ *
+ * Runs on the main thread: turn the matched indices into display entries
+ * and close the Mailbox if the search opened it.
+ */
+static void search_done(void *wdata)
+{
+  struct MxSearchJob *job = wdata;
+
+  int *idx = NULL;
+  ARRAY_FOREACH(idx, &job->matched)
+  {
+    hit_add(job->m, job->m->emails[*idx]);
+  }
+  ARRAY_FREE(&job->matched);
+
+  if (job->close_after)
+    mx_mbox_close(job->m);
+
+  FREE(&job);
+}
+
+/**
+ * pattern_has_op - Does a Pattern tree contain any of the given operations?
+ * @param pats    Pattern tree to search
+ * @param ops     Operations to look for, e.g. #MUTT_PAT_LIST
+ * @param num_ops Number of operations
+ * @retval true At least one of the operations is present
+ */
+static bool pattern_has_op(struct PatternList *pats, const short *ops, size_t num_ops)
+{
+  struct Pattern *pat = NULL;
+  SLIST_FOREACH(pat, pats, entries)
+  {
+    for (size_t i = 0; i < num_ops; i++)
+    {
+      if (pat->op == ops[i])
+        return true;
+    }
+    if (pat->child && pattern_has_op(pat->child, ops, num_ops))
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * search_make_entry - Format a search hit for the Menu - Implements Menu::make_entry() - @ingroup menu_make_entry
+ */
+static int search_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *buf)
+{
+  struct MxSearchHit *hit = ARRAY_GET(&Hits, line);
+  if (!hit)
+    return 0;
+
+  const int bytes = buf_addstr(buf, hit->display);
+  return mutt_strnwidth(buf_string(buf), bytes);
+}
+
+/**
+ * dlg_mxsearch - Let the user pick a search hit - @ingroup gui_dlg
+ * @param pattern Pattern the hits matched, for the title
+ * @retval num Index of the chosen hit
+ * @retval -1  No selection was made
+ *
+ * The Mailbox Search Dialog shows one line per matching message: folder,
+ * date, sender and subject.
+ */
+static int dlg_mxsearch(const char *pattern)
+{
+  struct MuttWindow *dlg = simple_dialog_new(MENU_GENERIC, WT_DLG_MXSEARCH, MxSearchHelp);
+
+  struct MuttWindow *sbar = window_find_child(dlg, WT_STATUS_BAR);
+  char title[256] = { 0 };
+  snprintf(title, sizeof(title), _("%zu matches for '%s'"), ARRAY_SIZE(&Hits), pattern);
+  sbar_set_title(sbar, title);
+
+  struct Menu *menu = dlg->wdata;
+  menu->make_entry = search_make_entry;
+  menu->max = ARRAY_SIZE(&Hits);
+  menu->mdata = NULL;
+  menu->mdata_free = NULL;
+
+  struct MuttWindow *old_focus = window_set_focus(menu->win);
+  // ---------------------------------------------------------------------------
+  // Event Loop
+  int choice = -1;
+  bool done = false;
+  int op = OP_NULL;
+  do
+  {
+    window_redraw(NULL);
+
+    op = km_dokey(MENU_DIALOG, GETCH_NO_FLAGS);
+    mutt_debug(LL_DEBUG1, "Got op %s (%d)\n", opcodes_get_name(op), op);
+    if (op < 0)
+      continue;
+    if (op == OP_NULL)
+    {
+      km_error_key(MENU_GENERIC);
+      continue;
+    }
+    mutt_clear_error();
+
+    switch (op)
+    {
+      case OP_GENERIC_SELECT_ENTRY:
+        choice = menu_get_index(menu);
+        done = true;
+        break;
+
+      case OP_EXIT:
+        done = true;
+        break;
+
+      default:
+      {
+        int rc = menu_function_dispatcher(menu->win, op);
+        if (rc == FR_UNKNOWN)
+          global_function_dispatcher(NULL, op);
+        break;
+      }
+    }
+  } while (!done);
+  // ---------------------------------------------------------------------------
+
+  window_set_focus(old_focus);
+  simple_dialog_free(&dlg);
+
+  return choice;
+}
+
+/**
+ * mxsearch_search - Search every configured Mailbox for a pattern
+ * @param[in]  m_cur  Currently open Mailbox, may be NULL
+ * @param[out] folder Path of the Mailbox holding the chosen message
+ * @param[out] msgid  Message-id of the chosen message, may end up empty
+ * @retval true The user picked a hit; @a folder and @a msgid are filled in
+ *
+ * Prompt for a pattern, match it against the current Mailbox and all the
+ * configured local Mailboxes, and show the hits in a menu.  Mailboxes that
+ * aren't open are opened read-only for the duration of the search; remote
+ * Mailboxes are skipped so the search never prompts for credentials.
+ */
+bool mxsearch_search(struct Mailbox *m_cur, struct Buffer *folder, struct Buffer *msgid)
+{
+  bool found = false;
+  struct PatternList *pats = NULL;
+  struct ThreadPool *tp = NULL;
+  struct Buffer *buf = buf_pool_get();
+  struct Buffer *err = buf_pool_get();
+
+  if ((mw_get_field(_("Search mailboxes for: "), buf, MUTT_COMP_CLEAR, HC_PATTERN,
+                    &CompletePatternOps, NULL) != 0) ||
+      buf_is_empty(buf))
+  {
+    goto done;
+  }
+
+  const char *const c_simple_search = cs_subset_string(NeoMutt->sub, "simple_search");
+  mutt_check_simple(buf, NONULL(c_simple_search));
+
+  mutt_message(_("Compiling search pattern..."));
+
+  /* No MUTT_PC_FULL_MSG: only data present in the cached headers can be
+   * matched, so no folder needs its messages read */
+  pats = mutt_pattern_comp(NULL, NULL, buf_string(buf), MUTT_PC_NO_FLAGS, err);
+  if (!pats)
+  {
+    mutt_error("%s", buf_string(err));
+    goto done;
+  }
+
+  /* Thread patterns match against neighbouring messages, and the searched
+   * Mailboxes are opened unsorted and unthreaded */
+  static const short thread_ops[] = {
+    MUTT_PAT_THREAD,     MUTT_PAT_PARENT,       MUTT_PAT_CHILDREN,
+    MUTT_PAT_COLLAPSED,  MUTT_PAT_DUPLICATED,   MUTT_PAT_UNREFERENCED,
+    MUTT_PAT_BROKEN,
+  };
+  if (pattern_has_op(pats, thread_ops, mutt_array_size(thread_ops)))
+  {
+    mutt_error(_("Thread patterns can't be used when searching across mailboxes"));
+    goto done;
+  }
+
+  mutt_pattern_optimize(pats);
+
+  /* The mailing-list predicates write to a shared result cache, so patterns
+   * using them are matched on the main thread instead of the pool */
+  static const short serial_ops[] = { MUTT_PAT_LIST, MUTT_PAT_SUBSCRIBED_LIST };
+  if (!pattern_has_op(pats, serial_ops, mutt_array_size(serial_ops)))
+    tp = tpool_new(MXSEARCH_NUM_WORKERS);
+
+  /* The current Mailbox may not be on the configured list - search its
+   * loaded headers directly */
+  if (m_cur)
+  {
+    struct MxSearchJob *job = mutt_mem_calloc(1, sizeof(struct MxSearchJob));
+    job->m = m_cur;
+    job->pats = pats;
+
+    if (tp)
+    {
+      tpool_submit(tp, search_worker, search_done, job);
+    }
+    else
+    {
+      search_worker(job);
+      search_done(job);
+    }
+  }
+
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+    bool close_after = false;
+
+    if (m == m_cur)
+      continue; // already searched
+
+    if (m->opened == 0)
+    {
+      if ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH) &&
+          (m->type != MUTT_MBOX) && (m->type != MUTT_MMDF))
+      {
+        continue; // remote mailboxes might prompt for credentials
+      }
+
+      mutt_message(_("Searching %s..."), mailbox_path(m));
+      if (!mx_mbox_open(m, MUTT_READONLY | MUTT_PEEK | MUTT_QUIET | MUTT_NOSORT))
+        continue;
+      close_after = true;
+    }
+
+    struct MxSearchJob *job = mutt_mem_calloc(1, sizeof(struct MxSearchJob));
+    job->m = m;
+    job->pats = pats;
+    job->close_after = close_after;
+
+    if (tp)
+    {
+      tpool_submit(tp, search_worker, search_done, job);
+      tpool_drain(tp); // Reap finished jobs, so their Mailboxes close early
+    }
+    else
+    {
+      search_worker(job);
+      search_done(job);
+    }
+  }
+  neomutt_mailboxlist_clear(&ml);
+
+  if (tp)
+  {
+    tpool_wait(tp);
+    tpool_free(&tp); // Drains the remaining completions
+  }
+
+  if (ARRAY_EMPTY(&Hits))
+  {
+    mutt_message(_("No messages matched criteria"));
+    goto done;
+  }
+
+  mutt_clear_error();
+  const int choice = dlg_mxsearch(buf_string(buf));
+  if (choice >= 0)
+  {
+    struct MxSearchHit *hit = ARRAY_GET(&Hits, choice);
+    buf_strcpy(folder, hit->folder);
+    buf_strcpy(msgid, hit->msgid);
+    found = true;
+  }
+
+done:
+  hits_clear();
+  mutt_pattern_free(&pats);
+  buf_pool_release(&buf);
+  buf_pool_release(&err);
+  return found;
+}
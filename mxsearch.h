@@ -0,0 +1,33 @@
+/**
+ * @file
+ * Pattern search across many mailboxes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MXSEARCH_H
+#define MUTT_MXSEARCH_H
+
+#include <stdbool.h>
+
+struct Buffer;
+struct Mailbox;
+
+bool mxsearch_search(struct Mailbox *m_cur, struct Buffer *folder, struct Buffer *msgid);
+
+#endif /* MUTT_MXSEARCH_H */
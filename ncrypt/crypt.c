@@ -50,6 +50,7 @@
 #include "cryptglue.h"
 #include "globals.h"
 #include "handler.h"
+#include "hook.h"
 #include "mx.h"
 #ifdef USE_AUTOCRYPT
 #include "autocrypt/lib.h"
@@ -944,6 +945,70 @@ cleanup:
   buf_pool_release(&tempfname);
 }
 
+/// Resolved keylists, keyed by application, mode and recipients.
+/// Bulk jobs, e.g. re-encrypting a folder, resolve the same recipients over
+/// and over; the crypt-hook matching and keyring lookups only need doing once.
+static struct HashTable *KeyCache = NULL;
+
+/// Hooks generation (see mutt_hooks_gen()) that #KeyCache was filled under
+static unsigned int KeyCacheGen = 0;
+
+/**
+ * key_cache_free - Free a cached keylist - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void key_cache_free(int type, void *obj, intptr_t data)
+{
+  char *keylist = obj;
+  FREE(&keylist);
+}
+
+/**
+ * find_keys_cached - Find the keyids of some recipients, using a session cache
+ * @param addrlist Addresses to match
+ * @param oppenc_mode If true, use opportunistic encryption
+ * @param smime If true, use S/MIME, else PGP
+ * @retval ptr  Space-separated list of keys
+ * @retval NULL At least one key couldn't be resolved
+ *
+ * Successful resolutions are remembered for the rest of the session, so a key
+ * chosen at a prompt is only asked for once.  Changing the hooks flushes the
+ * cache, since crypt-hooks feed the resolution.
+ */
+static char *find_keys_cached(struct AddressList *addrlist, bool oppenc_mode, bool smime)
+{
+  if (KeyCache && (KeyCacheGen != mutt_hooks_gen()))
+    mutt_hash_free(&KeyCache);
+
+  if (!KeyCache)
+  {
+    KeyCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(KeyCache, key_cache_free, 0);
+    KeyCacheGen = mutt_hooks_gen();
+  }
+
+  struct Buffer *cache_key = buf_pool_get();
+  buf_printf(cache_key, "%c%c:", smime ? 's' : 'p', oppenc_mode ? '1' : '0');
+  mutt_addrlist_write(addrlist, cache_key, false);
+
+  char *keylist = mutt_hash_find(KeyCache, buf_string(cache_key));
+  if (keylist)
+  {
+    keylist = mutt_str_dup(keylist);
+  }
+  else
+  {
+    if (smime)
+      keylist = crypt_smime_find_keys(addrlist, oppenc_mode);
+    else
+      keylist = crypt_pgp_find_keys(addrlist, oppenc_mode);
+    if (keylist)
+      mutt_hash_insert(KeyCache, buf_string(cache_key), mutt_str_dup(keylist));
+  }
+
+  buf_pool_release(&cache_key);
+  return keylist;
+}
+
 /**
  * crypt_get_keys - Check we have all the keys we need
  * @param[in]  e           Email with addresses to match
@@ -994,7 +1059,7 @@ int crypt_get_keys(struct Email *e, char **keylist, bool oppenc_mode)
   {
     if (((WithCrypto & APPLICATION_PGP) != 0) && (e->security & APPLICATION_PGP))
     {
-      *keylist = crypt_pgp_find_keys(&addrlist, oppenc_mode);
+      *keylist = find_keys_cached(&addrlist, oppenc_mode, false);
       if (!*keylist)
       {
         mutt_addrlist_clear(&addrlist);
@@ -1009,7 +1074,7 @@ int crypt_get_keys(struct Email *e, char **keylist, bool oppenc_mode)
     }
     if (((WithCrypto & APPLICATION_SMIME) != 0) && (e->security & APPLICATION_SMIME))
     {
-      *keylist = crypt_smime_find_keys(&addrlist, oppenc_mode);
+      *keylist = find_keys_cached(&addrlist, oppenc_mode, true);
       if (!*keylist)
       {
         mutt_addrlist_clear(&addrlist);
@@ -1232,6 +1297,198 @@ blank:
   return 0;
 }
 
+/// Number of worker threads for verifying signatures
+#define SIGVERIFY_NUM_WORKERS 4
+
+/**
+ * @defgroup crypto_verify_fn Signature verify function
+ *
+ * Prototype for a backend signature verify function
+ *
+ * @param b        Body part containing the signature
+ * @param state    State to read from and write to
+ * @param tempfile File containing the signed data
+ * @retval 0 Success
+ *
+ * @sa crypt_pgp_verify_one(), crypt_smime_verify_one()
+ */
+typedef int (*verify_fn_t)(struct Body *b, struct State *state, const char *tempfile);
+
+/**
+ * struct VerifyJob - One signature check, ready to run on a worker
+ *
+ * Everything the check touches is private to the job: the signature bytes
+ * and the signed data are spooled into the job's own files, and the output
+ * is collected in the job's own State.  The outputs are spliced back into
+ * the handler's State in signature order, so the rendering is identical to
+ * checking the signatures one by one.
+ */
+struct VerifyJob
+{
+  struct Body sig;           ///< Shallow copy of the signature part, rebased to offset 0
+  struct State state;        ///< Private State, writing to VerifyJob::fp_out
+  FILE *fp_sig;              ///< Spooled signature bytes, the job's input
+  FILE *fp_out;              ///< Collected verification output
+  struct Buffer *signedfile; ///< Job's own copy of the signed data
+  verify_fn_t verify_fn;     ///< Backend verify function, or NULL if unsupported
+  int rc;                    ///< Result of the verification
+};
+
+/**
+ * signature_verifier - Pick the backend verify function for a signature
+ * @param sig Body part containing the signature
+ * @retval ptr  Verify function
+ * @retval NULL We can't verify signatures of this type
+ */
+static verify_fn_t signature_verifier(const struct Body *sig)
+{
+  if (((WithCrypto & APPLICATION_PGP) != 0) && (sig->type == TYPE_APPLICATION) &&
+      mutt_istr_equal(sig->subtype, "pgp-signature"))
+  {
+    return crypt_pgp_verify_one;
+  }
+
+  if (((WithCrypto & APPLICATION_SMIME) != 0) && (sig->type == TYPE_APPLICATION) &&
+      (mutt_istr_equal(sig->subtype, "x-pkcs7-signature") ||
+       mutt_istr_equal(sig->subtype, "pkcs7-signature")))
+  {
+    return crypt_smime_verify_one;
+  }
+
+  return NULL;
+}
+
+/**
+ * verify_worker - Check one signature - Implements ::tpool_work_t - @ingroup tpool_work_api
+ *
+ * Runs on a worker thread.  The job's Body, State and files are all private,
+ * so independent signatures can be checked concurrently.  The handler blocks
+ * until every job has finished, so the config reads inside the backends
+ * can't race the main thread; the gpgme backend serialises its own shared
+ * state.
+ */
+static void verify_worker(void *wdata)
+{
+  struct VerifyJob *job = wdata;
+
+  job->rc = job->verify_fn(&job->sig, &job->state, buf_string(job->signedfile));
+}
+
+/**
+ * verify_job_free - Release a job's files
+ * @param job Job to clean up
+ */
+static void verify_job_free(struct VerifyJob *job)
+{
+  mutt_file_fclose(&job->fp_sig);
+  mutt_file_fclose(&job->fp_out);
+  if (job->signedfile)
+    mutt_file_unlink(buf_string(job->signedfile));
+  buf_pool_release(&job->signedfile);
+}
+
+/**
+ * verify_signatures_parallel - Check a set of signatures on the worker pool
+ * @param[in]  b_email    Signed part of the message
+ * @param[in]  signatures Array of signature parts
+ * @param[in]  sigcnt     Number of signatures
+ * @param[in]  state      State to write to
+ * @param[out] goodsig    Set to false if any signature fails to verify
+ * @retval true  All signatures were checked
+ * @retval false The jobs couldn't be set up - check them serially instead
+ *
+ * A digest can carry dozens of individually signed parts; checked one after
+ * another, rendering waits for the sum of the verification times.  Check
+ * them concurrently instead, bounding the wait by the slowest signature.
+ *
+ * Each job gets its own copy of the signed data: the classic backends put
+ * their work files next to it, so sharing one copy would make them collide.
+ */
+static bool verify_signatures_parallel(struct Body *b_email, struct Body **signatures,
+                                       int sigcnt, struct State *state, bool *goodsig)
+{
+  struct VerifyJob *jobs = mutt_mem_calloc(sigcnt, sizeof(struct VerifyJob));
+  bool rc = false;
+
+  for (int i = 0; i < sigcnt; i++)
+  {
+    struct VerifyJob *job = &jobs[i];
+
+    job->verify_fn = signature_verifier(signatures[i]);
+    if (!job->verify_fn)
+      continue; // Warn in signature order, when the outputs are merged
+
+    job->fp_sig = mutt_file_mkstemp();
+    job->fp_out = mutt_file_mkstemp();
+    if (!job->fp_sig || !job->fp_out)
+      goto cleanup;
+
+    if (!mutt_file_seek(state->fp_in, signatures[i]->offset, SEEK_SET))
+      goto cleanup;
+    mutt_file_copy_bytes(state->fp_in, job->fp_sig, signatures[i]->length);
+    if (fflush(job->fp_sig) != 0)
+      goto cleanup;
+    rewind(job->fp_sig);
+
+    job->signedfile = buf_pool_get();
+    buf_mktemp(job->signedfile);
+    if (crypt_write_signed(b_email, state, buf_string(job->signedfile)) != 0)
+      goto cleanup;
+
+    job->sig = *signatures[i];
+    job->sig.offset = 0;
+    job->sig.hdr_offset = 0;
+
+    job->state.fp_in = job->fp_sig;
+    job->state.fp_out = job->fp_out;
+    job->state.prefix = state->prefix;
+    job->state.flags = state->flags;
+  }
+
+  struct ThreadPool *tp = tpool_new(SIGVERIFY_NUM_WORKERS);
+  if (!tp)
+    goto cleanup;
+
+  for (int i = 0; i < sigcnt; i++)
+  {
+    struct VerifyJob *job = &jobs[i];
+    if (job->verify_fn && !tpool_submit(tp, verify_worker, NULL, job))
+      verify_worker(job);
+  }
+
+  tpool_wait(tp);
+  tpool_free(&tp);
+
+  /* Splice the outputs back in signature order */
+  for (int i = 0; i < sigcnt; i++)
+  {
+    struct VerifyJob *job = &jobs[i];
+
+    if (!job->verify_fn)
+    {
+      state_printf(state, _("[-- Warning: We can't verify %s/%s signatures --]\n\n"),
+                   TYPE(signatures[i]), signatures[i]->subtype);
+      continue;
+    }
+
+    fflush(job->fp_out);
+    rewind(job->fp_out);
+    mutt_file_copy_stream(job->fp_out, state->fp_out);
+
+    if (job->rc != 0)
+      *goodsig = false;
+  }
+
+  rc = true;
+
+cleanup:
+  for (int i = 0; i < sigcnt; i++)
+    verify_job_free(&jobs[i]);
+  FREE(&jobs);
+
+  return rc;
+}
+
 /**
  * mutt_signed_handler - Handler for "multipart/signed" - Implements ::handler_t - @ingroup handler_api
  */
@@ -1308,31 +1565,23 @@ int mutt_signed_handler(struct Body *b_email, struct State *state)
       bool goodsig = true;
       if (crypt_write_signed(b_email, state, buf_string(tempfile)) == 0)
       {
-        for (int i = 0; i < sigcnt; i++)
+        if ((sigcnt == 1) ||
+            !verify_signatures_parallel(b_email, signatures, sigcnt, state, &goodsig))
         {
-          if (((WithCrypto & APPLICATION_PGP) != 0) &&
-              (signatures[i]->type == TYPE_APPLICATION) &&
-              mutt_istr_equal(signatures[i]->subtype, "pgp-signature"))
+          for (int i = 0; i < sigcnt; i++)
           {
-            if (crypt_pgp_verify_one(signatures[i], state, buf_string(tempfile)) != 0)
-              goodsig = false;
-
-            continue;
-          }
-
-          if (((WithCrypto & APPLICATION_SMIME) != 0) &&
-              (signatures[i]->type == TYPE_APPLICATION) &&
-              (mutt_istr_equal(signatures[i]->subtype, "x-pkcs7-signature") ||
-               mutt_istr_equal(signatures[i]->subtype, "pkcs7-signature")))
-          {
-            if (crypt_smime_verify_one(signatures[i], state, buf_string(tempfile)) != 0)
-              goodsig = false;
-
-            continue;
+            const verify_fn_t verify_fn = signature_verifier(signatures[i]);
+            if (verify_fn)
+            {
+              if (verify_fn(signatures[i], state, buf_string(tempfile)) != 0)
+                goodsig = false;
+            }
+            else
+            {
+              state_printf(state, _("[-- Warning: We can't verify %s/%s signatures --]\n\n"),
+                           TYPE(signatures[i]), signatures[i]->subtype);
+            }
           }
-
-          state_printf(state, _("[-- Warning: We can't verify %s/%s signatures --]\n\n"),
-                       TYPE(signatures[i]), signatures[i]->subtype);
         }
       }
 
@@ -38,10 +38,13 @@
 #include <gpgme.h>
 #include <langinfo.h>
 #include <locale.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 #include "private.h"
 #include "mutt/lib.h"
@@ -95,6 +98,53 @@ static gpgme_key_t SignatureKey = NULL;
 /// Email address of the sender
 static char *CurrentSender = NULL;
 
+/**
+ * struct VerifyResult - Remembered result of a signature verification
+ *
+ * Verifying a signature can take hundreds of milliseconds (large keyrings,
+ * smartcards), but the result can't change unless the keyring does.  The
+ * verdict and the rendered signature information are remembered, keyed by a
+ * digest of the signature, the signed data and the display settings, so
+ * re-opening a signed message doesn't re-run the verification.
+ */
+struct VerifyResult
+{
+  int rc;     ///< Result of verify_one()
+  char *info; ///< Rendered signature information
+};
+
+/// Cache of verification results: digest -> VerifyResult
+static struct HashTable *VerifyCache = NULL;
+/// Keyring modification time the cached results are valid for
+static time_t VerifyCacheMtime = 0;
+/// Serialise access to #VerifyCache and #SignatureKey.
+/// mutt_signed_handler() checks independent signatures on worker threads;
+/// only the gpgme operation itself may run unserialised.
+static pthread_mutex_t VerifyLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * struct KeyCacheEntry - Remembered result of a keyring lookup
+ *
+ * Enumerating the keyring is the slow part of choosing encryption keys: with
+ * a large keyring, the keylist operation in get_candidates() can take
+ * seconds.  The candidate keys for each hint pattern are remembered, so
+ * encrypting repeatedly to the same recipients pays that cost only once per
+ * keyring change.
+ */
+struct KeyCacheEntry
+{
+  char *pattern;              ///< Pattern built from the lookup hints
+  SecurityFlags app;          ///< Application, e.g. #APPLICATION_PGP
+  int secret;                 ///< Whether secret keys were listed
+  struct CryptKeyInfo *keys;  ///< Matching keys
+  struct KeyCacheEntry *next; ///< Linked list
+};
+
+/// Cache of keyring lookups: hint pattern -> candidate keys
+static struct KeyCacheEntry *KeyCache = NULL;
+/// Keyring modification time the cached lookups are valid for
+static time_t KeyCacheMtime = 0;
+
 #define PKA_NOTATION_NAME "pka-address@gnupg.org"
 
 #define _LINE_COMPARE(_x, _y) line_compare(_x, sizeof(_x) - 1, _y)
@@ -267,6 +317,43 @@ static void crypt_key_free(struct CryptKeyInfo **keylist)
   }
 }
 
+/**
+ * crypt_copy_key_list - Return a copy of a list of keys
+ * @param keys List of keys to copy
+ * @retval ptr Copy of the list
+ */
+static struct CryptKeyInfo *crypt_copy_key_list(struct CryptKeyInfo *keys)
+{
+  struct CryptKeyInfo *db = NULL;
+  struct CryptKeyInfo **kend = &db;
+
+  for (struct CryptKeyInfo *k = keys; k; k = k->next)
+  {
+    struct CryptKeyInfo *copy = crypt_copy_key(k);
+    *kend = copy;
+    kend = &copy->next;
+  }
+
+  return db;
+}
+
+/**
+ * key_cache_flush - Discard all the cached keyring lookups
+ */
+static void key_cache_flush(void)
+{
+  struct KeyCacheEntry *kce = KeyCache;
+  while (kce)
+  {
+    struct KeyCacheEntry *next = kce->next;
+    FREE(&kce->pattern);
+    crypt_key_free(&kce->keys);
+    FREE(&kce);
+    kce = next;
+  }
+  KeyCache = NULL;
+}
+
 /**
  * crypt_id_is_strong - Is the key strong
  * @param key Key to test
@@ -353,6 +440,40 @@ static int crypt_id_matches_addr(struct Address *addr, struct Address *u_addr,
   return rc;
 }
 
+/**
+ * crypt_progress - Show progress of a GPGME operation - Implements ::gpgme_progress_cb_t
+ * @param hook    GPGME context performing the operation
+ * @param what    Description of the current stage
+ * @param type    Type of progress (unused)
+ * @param current Amount done so far
+ * @param total   Total amount of work, or 0 if unknown
+ *
+ * GPGME invokes this periodically during long operations.  Keep the user
+ * informed and give them a chance to abort: if Ctrl-C was caught while the
+ * operation was interruptible (see decrypt_part()), cancel the operation.
+ * It will then fail with GPG_ERR_CANCELED.
+ */
+static void crypt_progress(void *hook, const char *what, int type, int current, int total)
+{
+  if (SigInt)
+  {
+    SigInt = false;
+    gpgme_cancel_async((gpgme_ctx_t) hook);
+    return;
+  }
+
+  static time_t last = 0;
+  const time_t now = mutt_date_now();
+  if (now == last)
+    return;
+  last = now;
+
+  if (total > 0)
+    mutt_message(_("Crypto operation (%s)... %d%%"), what, (100 * current) / total);
+  else
+    mutt_message(_("Crypto operation (%s)... %d"), what, current);
+}
+
 /**
  * create_gpgme_context - Create a new GPGME context
  * @param for_smime If true, protocol of the context is set to CMS
@@ -386,6 +507,8 @@ gpgme_ctx_t create_gpgme_context(bool for_smime)
     }
   }
 
+  gpgme_set_progress_cb(ctx, crypt_progress, ctx);
+
   return ctx;
 }
 
@@ -1566,7 +1689,7 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *state)
 }
 
 /**
- * verify_one - Do the actual verification step
+ * verify_one_real - Do the actual verification step
  * @param b        Body part containing signature
  * @param state    State to read from
  * @param tempfile Temporary file to read
@@ -1578,7 +1701,8 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *state)
  *
  * With is_smime set to true we assume S/MIME.
  */
-static int verify_one(struct Body *b, struct State *state, const char *tempfile, bool is_smime)
+static int verify_one_real(struct Body *b, struct State *state,
+                           const char *tempfile, bool is_smime)
 {
   int badsig = -1;
   int anywarn = 0;
@@ -1607,10 +1731,16 @@ static int verify_one(struct Body *b, struct State *state, const char *tempfile,
    * such an attack by separating the meta information from the data. */
   state_attach_puts(state, _("[-- Begin signature information --]\n"));
 
+  SigInt = false;
+  mutt_sig_allow_interrupt(true);
   err = gpgme_op_verify(ctx, signature, message, NULL);
+  mutt_sig_allow_interrupt(false);
   gpgme_data_release(message);
   gpgme_data_release(signature);
 
+  /* Rendering the result touches SignatureKey and the redraw state; only
+   * the verify operation above may run concurrently */
+  pthread_mutex_lock(&VerifyLock);
   redraw_if_needed(ctx);
   if (err != GPG_ERR_NO_ERROR)
   {
@@ -1646,6 +1776,7 @@ static int verify_one(struct Body *b, struct State *state, const char *tempfile,
         badsig = 0;
     }
   }
+  pthread_mutex_unlock(&VerifyLock);
 
   if (badsig == 0)
   {
@@ -1700,6 +1831,209 @@ static int verify_one(struct Body *b, struct State *state, const char *tempfile,
   return badsig ? 1 : anywarn ? 2 : 0;
 }
 
+/**
+ * verify_result_free - Free our hash table data - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void verify_result_free(int type, void *obj, intptr_t data)
+{
+  struct VerifyResult *vr = obj;
+  FREE(&vr->info);
+  FREE(&vr);
+}
+
+/**
+ * keyring_mtime - Get the modification time of the keyring
+ * @retval num Time of the last keyring change
+ *
+ * Cached verification results and keyring lookups are only valid as long as
+ * the keyring they were made against.  Take the newest timestamp of the
+ * keyring files, so that importing, refreshing or editing a key drops the
+ * cached results.
+ */
+static time_t keyring_mtime(void)
+{
+  static const char *files[] = { "pubring.kbx", "pubring.gpg", "trustdb.gpg" };
+
+  struct Buffer *path = buf_pool_get();
+  const char *home = mutt_str_getenv("GNUPGHOME");
+  time_t mtime = 0;
+
+  for (size_t i = 0; i < mutt_array_size(files); i++)
+  {
+    if (home)
+      buf_printf(path, "%s/%s", home, files[i]);
+    else
+      buf_printf(path, "%s/.gnupg/%s", NONULL(HomeDir), files[i]);
+
+    struct stat st = { 0 };
+    if ((stat(buf_string(path), &st) == 0) && (st.st_mtime > mtime))
+      mtime = st.st_mtime;
+  }
+
+  buf_pool_release(&path);
+  return mtime;
+}
+
+/**
+ * verify_cache_key - Compute the cache key for a signature check
+ * @param b        Body part containing signature
+ * @param state    State to read from
+ * @param tempfile File containing the signed data
+ * @param key      Buffer for the ascii digest, at least 33 bytes
+ * @retval true Success
+ */
+static bool verify_cache_key(struct Body *b, struct State *state,
+                             const char *tempfile, char *key)
+{
+  struct Md5Ctx md5ctx = { 0 };
+  unsigned char digest[16];
+  char buf[4096];
+
+  FILE *fp = mutt_file_fopen(tempfile, "r");
+  if (!fp)
+    return false;
+
+  if (!mutt_file_seek(state->fp_in, b->offset, SEEK_SET))
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  mutt_md5_init_ctx(&md5ctx);
+
+  /* the signature part */
+  size_t remaining = b->length;
+  while (remaining != 0)
+  {
+    const size_t len = fread(buf, 1, MIN(sizeof(buf), remaining), state->fp_in);
+    if (len == 0)
+      break;
+    mutt_md5_process_bytes(buf, len, &md5ctx);
+    remaining -= len;
+  }
+
+  /* the signed data */
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), fp)) != 0)
+    mutt_md5_process_bytes(buf, len, &md5ctx);
+  mutt_file_fclose(&fp);
+
+  /* the rendered output depends on how it's displayed */
+  if (state->prefix)
+    mutt_md5_process(state->prefix, &md5ctx);
+  mutt_md5_process_bytes(&state->flags, sizeof(state->flags), &md5ctx);
+
+  mutt_md5_finish_ctx(&md5ctx, digest);
+  mutt_md5_toascii(digest, key);
+  return true;
+}
+
+/**
+ * verify_cache_lookup - Look up a cached verification result
+ * @param key Cache key from verify_cache_key()
+ * @retval ptr  Cached result
+ * @retval NULL No valid cached result
+ *
+ * If the keyring has changed since the results were cached, they're all
+ * discarded.
+ */
+static struct VerifyResult *verify_cache_lookup(const char *key)
+{
+  const time_t mtime = keyring_mtime();
+
+  if (VerifyCache && (mtime != VerifyCacheMtime))
+  {
+    mutt_debug(LL_DEBUG1, "keyring changed, dropping verification cache\n");
+    mutt_hash_free(&VerifyCache);
+  }
+
+  if (!VerifyCache)
+  {
+    VerifyCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(VerifyCache, verify_result_free, 0);
+    VerifyCacheMtime = mtime;
+  }
+
+  return mutt_hash_find(VerifyCache, key);
+}
+
+/**
+ * verify_cache_store - Cache a verification result
+ * @param key  Cache key from verify_cache_key()
+ * @param rc   Result of verify_one()
+ * @param info Rendered signature information, ownership is taken
+ */
+static void verify_cache_store(const char *key, int rc, char **info)
+{
+  if (!VerifyCache || mutt_hash_find(VerifyCache, key))
+  {
+    FREE(info);
+    return;
+  }
+
+  struct VerifyResult *vr = mutt_mem_calloc(1, sizeof(struct VerifyResult));
+  vr->rc = rc;
+  vr->info = *info;
+  *info = NULL;
+  mutt_hash_insert(VerifyCache, key, vr);
+}
+
+/**
+ * verify_one - Check a signature, reusing a cached result if possible
+ * @param b        Body part containing signature
+ * @param state    State to read from
+ * @param tempfile Temporary file to read
+ * @param is_smime Is the key S/MIME?
+ * @retval  0 Success
+ * @retval  1 Bad signature
+ * @retval  2 Warnings
+ * @retval -1 Error
+ *
+ * S/MIME results aren't cached: the pager uses the #SignatureKey left behind
+ * by a real verification to check the signer against the sender.
+ */
+static int verify_one(struct Body *b, struct State *state, const char *tempfile, bool is_smime)
+{
+  if (is_smime)
+    return verify_one_real(b, state, tempfile, is_smime);
+
+  char key[33] = { 0 };
+  if (!verify_cache_key(b, state, tempfile, key))
+    return verify_one_real(b, state, tempfile, is_smime);
+
+  pthread_mutex_lock(&VerifyLock);
+  struct VerifyResult *vr = verify_cache_lookup(key);
+  if (vr)
+  {
+    mutt_debug(LL_DEBUG1, "cached verification result %d\n", vr->rc);
+    state_puts(state, vr->info);
+    pthread_mutex_unlock(&VerifyLock);
+    return vr->rc;
+  }
+  pthread_mutex_unlock(&VerifyLock);
+
+  char *info = NULL;
+  size_t infolen = 0;
+  FILE *fp_mem = open_memstream(&info, &infolen);
+  if (!fp_mem)
+    return verify_one_real(b, state, tempfile, is_smime);
+
+  struct State state_mem = *state;
+  state_mem.fp_out = fp_mem;
+  const int rc = verify_one_real(b, &state_mem, tempfile, is_smime);
+  mutt_file_fclose(&fp_mem);
+
+  if (info)
+  {
+    state_puts(state, info);
+    pthread_mutex_lock(&VerifyLock);
+    verify_cache_store(key, rc, &info);
+    pthread_mutex_unlock(&VerifyLock);
+  }
+
+  return rc;
+}
+
 /**
  * pgp_gpgme_verify_one - Check a signed MIME part against a signature - Implements CryptModuleSpecs::verify_one() - @ingroup crypto_verify_one
  */
@@ -1758,7 +2092,11 @@ restart:
     goto cleanup;
   plaintext = create_gpgme_data();
 
-  /* Do the decryption or the verification in case of the S/MIME hack. */
+  /* Do the decryption or the verification in case of the S/MIME hack.
+   * Let Ctrl-C through while the operation runs; crypt_progress() turns it
+   * into a cancellation. */
+  SigInt = false;
+  mutt_sig_allow_interrupt(true);
   if ((!is_smime) || maybe_signed)
   {
     if (!is_smime)
@@ -1778,6 +2116,7 @@ restart:
   {
     err = gpgme_op_decrypt(ctx, ciphertext, plaintext);
   }
+  mutt_sig_allow_interrupt(false);
   gpgme_data_release(ciphertext);
   ciphertext = NULL;
 
@@ -3081,6 +3420,25 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, SecurityFlags
   if (!pattern)
     return NULL;
 
+  /* an unchanged keyring means the cached lookups are still good */
+  const time_t mtime = keyring_mtime();
+  if (mtime != KeyCacheMtime)
+  {
+    key_cache_flush();
+    KeyCacheMtime = mtime;
+  }
+
+  for (struct KeyCacheEntry *kce = KeyCache; kce; kce = kce->next)
+  {
+    if ((kce->app == app) && (kce->secret == secret) &&
+        mutt_str_equal(kce->pattern, pattern))
+    {
+      mutt_debug(LL_DEBUG2, "key cache hit for '%s'\n", pattern);
+      FREE(&pattern);
+      return crypt_copy_key_list(kce->keys);
+    }
+  }
+
   ctx = create_gpgme_context(0);
   db = NULL;
   kend = &db;
@@ -3209,7 +3567,16 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, SecurityFlags
   }
 
   gpgme_release(ctx);
-  FREE(&pattern);
+
+  /* remember the result, even an empty one, for next time */
+  struct KeyCacheEntry *kce = mutt_mem_calloc(1, sizeof(*kce));
+  kce->pattern = pattern; // takes ownership
+  kce->app = app;
+  kce->secret = secret;
+  kce->keys = crypt_copy_key_list(db);
+  kce->next = KeyCache;
+  KeyCache = kce;
+
   return db;
 }
 
@@ -3868,6 +4235,15 @@ void pgp_gpgme_init(void)
   init_pgp();
 }
 
+/**
+ * pgp_gpgme_cleanup - Clean up the crypt module - Implements CryptModuleSpecs::cleanup() - @ingroup crypto_cleanup
+ */
+void pgp_gpgme_cleanup(void)
+{
+  mutt_hash_free(&VerifyCache);
+  key_cache_flush();
+}
+
 /**
  * smime_gpgme_init - Initialise the crypto module - Implements CryptModuleSpecs::init() - @ingroup crypto_init
  */
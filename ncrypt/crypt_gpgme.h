@@ -91,6 +91,7 @@ void                 pgp_gpgme_set_sender           (const char *sender);
 
 int                  pgp_gpgme_application_handler  (struct Body *b, struct State *state);
 bool                 pgp_gpgme_check_traditional    (FILE *fp, struct Body *b, bool just_one);
+void                 pgp_gpgme_cleanup              (void);
 int                  pgp_gpgme_decrypt_mime         (FILE *fp_in, FILE **fp_out, struct Body *b, struct Body **b_dec);
 int                  pgp_gpgme_encrypted_handler    (struct Body *b, struct State *state);
 struct Body *        pgp_gpgme_encrypt_message      (struct Body *b, char *keylist, bool sign, const struct AddressList *from);
@@ -29,6 +29,7 @@
 #include "config.h"
 #include "private.h"
 #include "mutt/lib.h"
+#include "lib.h"
 #include "adata.h"
 
 struct Connection;
@@ -47,6 +48,10 @@ void nntp_adata_free(void **ptr)
 
   struct NntpAccountData *adata = *ptr;
 
+  /* sidecar updates left the text .newsrc stale; other newsreaders need it */
+  if (adata->newsrc_export)
+    nntp_newsrc_export(adata);
+
   mutt_file_fclose(&adata->fp_newsrc);
   FREE(&adata->newsrc_file);
   FREE(&adata->authenticators);
@@ -47,6 +47,7 @@ struct NntpAccountData
   unsigned int status     : 3;
   bool cacheable          : 1;
   bool newsrc_modified    : 1;
+  bool newsrc_export      : 1; ///< .newsrc text is stale; export it before the account goes away
   FILE *fp_newsrc;
   char *newsrc_file;
   char *authenticators;
@@ -55,6 +56,7 @@ struct NntpAccountData
   time_t mtime;
   time_t newgroups_time;
   time_t check_time;
+  unsigned int nb_appends; ///< Records appended to the binary newsrc since its last snapshot
   unsigned int groups_num;
   unsigned int groups_max;
   void **groups_list;
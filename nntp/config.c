@@ -94,6 +94,9 @@ static struct ConfigDef NntpVars[] = {
   { "nntp_poll", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 60, 0, NULL,
     "(nntp) Interval between checks for new posts"
   },
+  { "nntp_prefetch_articles", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(nntp) Fetch this many upcoming articles into the body cache with each article read"
+  },
   { "nntp_user", DT_STRING|D_SENSITIVE, 0, 0, NULL,
     "(nntp) Username for the news server"
   },
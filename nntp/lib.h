@@ -88,6 +88,7 @@ struct NntpMboxData *mutt_newsgroup_catchup(struct Mailbox *m, struct NntpAccoun
 struct NntpMboxData *mutt_newsgroup_uncatchup(struct Mailbox *m, struct NntpAccountData *adata, char *group);
 int nntp_active_fetch(struct NntpAccountData *adata, bool mark_new);
 int nntp_newsrc_update(struct NntpAccountData *adata);
+int nntp_newsrc_export(struct NntpAccountData *adata);
 int nntp_post(struct Mailbox *m, const char *msg);
 int nntp_check_msgid(struct Mailbox *m, const char *msgid);
 int nntp_check_children(struct Mailbox *m, const char *msgid);
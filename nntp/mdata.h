@@ -24,6 +24,7 @@
 #define MUTT_NNTP_MDATA_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 #include "lib.h"
 
@@ -45,6 +46,7 @@ struct NntpMboxData
   bool deleted      : 1;
   unsigned int newsrc_len;
   struct NewsrcEntry *newsrc_ent;
+  uint32_t newsrc_crc; ///< CRC of the ranges last written to the binary newsrc
   struct NntpAccountData *adata;
   struct NntpAcache acache[NNTP_ACACHE_LEN];
   struct BodyCache *bcache;
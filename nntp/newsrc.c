@@ -35,6 +35,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -66,6 +67,8 @@ struct BodyCache;
 
 const struct ExpandoRenderData NntpRenderData[];
 
+static void nb_load(struct NntpAccountData *adata, struct stat *st);
+
 /**
  * mdata_find - Find NntpMboxData for given newsgroup or add it
  * @param adata NNTP server
@@ -293,6 +296,7 @@ int nntp_newsrc_parse(struct NntpAccountData *adata)
     mutt_debug(LL_DEBUG2, "%s\n", mdata->group);
   }
   FREE(&line);
+  nb_load(adata, &st);
   return 1;
 }
 
@@ -436,13 +440,416 @@ static int update_file(char *filename, char *buf)
   return rc;
 }
 
+/* Next to the text .newsrc, NeoMutt keeps a binary sidecar, "<newsrc>.nb".
+ * Its header records the stat of the .newsrc it was derived from; the rest is
+ * a stream of per-group records, article ranges stored as zigzag varint
+ * deltas.  Changed groups are appended to the stream and the last record for
+ * a group wins, so a catchup costs one small append instead of rewriting
+ * megabytes of text.  The file is compacted once the appends outgrow the
+ * group count, and the text .newsrc is re-exported (for other newsreaders)
+ * when the account goes away.  If the .newsrc is edited behind our back, its
+ * stat no longer matches the sidecar header and the text wins. */
+
+/// Magic bytes at the start of a binary newsrc sidecar
+static const char NewsrcBinMagic[4] = { 'N', 'M', 'N', 'B' };
+/// Format version of the binary newsrc sidecar
+#define NEWSRC_BIN_VERSION 1
+/// Appended records allowed beyond the group count before compacting
+#define NEWSRC_BIN_SLACK 100
+/// Upper bound on ranges per record - anything bigger is corruption
+#define NEWSRC_BIN_MAX_RANGES 0x100000
+
+#define NB_SUBSCRIBED (1 << 0) ///< Sidecar record: group is subscribed
+#define NB_FORGET     (1 << 1) ///< Sidecar record: group has no ranges any more
+
+/**
+ * nb_path - Compose the path of the binary newsrc sidecar
+ * @param adata  NNTP server
+ * @param buf    Buffer for the path
+ * @param buflen Length of buffer
+ */
+static void nb_path(struct NntpAccountData *adata, char *buf, size_t buflen)
+{
+  snprintf(buf, buflen, "%s.nb", adata->newsrc_file);
+}
+
+/**
+ * nb_put_uint - Write an unsigned varint
+ * @param fp  File to write to
+ * @param val Value to encode
+ */
+static void nb_put_uint(FILE *fp, uint64_t val)
+{
+  while (val >= 0x80)
+  {
+    fputc((val & 0x7f) | 0x80, fp);
+    val >>= 7;
+  }
+  fputc(val, fp);
+}
+
+/**
+ * nb_put_int - Write a signed varint, zigzag-encoded
+ * @param fp  File to write to
+ * @param val Value to encode
+ */
+static void nb_put_int(FILE *fp, int64_t val)
+{
+  nb_put_uint(fp, ((uint64_t) val << 1) ^ (uint64_t) (val >> 63));
+}
+
 /**
- * nntp_newsrc_update - Update .newsrc file
+ * nb_get_uint - Read an unsigned varint
+ * @param[in]  fp  File to read from
+ * @param[out] val Decoded value
+ * @retval  0 Success
+ * @retval -1 End of file or malformed encoding
+ */
+static int nb_get_uint(FILE *fp, uint64_t *val)
+{
+  uint64_t v = 0;
+  int shift = 0;
+  int ch;
+  do
+  {
+    ch = fgetc(fp);
+    if ((ch == EOF) || (shift > 63))
+      return -1;
+    v |= (uint64_t) (ch & 0x7f) << shift;
+    shift += 7;
+  } while (ch & 0x80);
+  *val = v;
+  return 0;
+}
+
+/**
+ * nb_get_int - Read a signed varint, zigzag-encoded
+ * @param[in]  fp  File to read from
+ * @param[out] val Decoded value
+ * @retval  0 Success
+ * @retval -1 End of file or malformed encoding
+ */
+static int nb_get_int(FILE *fp, int64_t *val)
+{
+  uint64_t v = 0;
+  if (nb_get_uint(fp, &v) != 0)
+    return -1;
+  *val = (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+  return 0;
+}
+
+/**
+ * nb_group_crc - Checksum a group's newsrc state
+ * @param mdata NNTP Mailbox data
+ * @retval num CRC of the subscription flag and article ranges
+ *
+ * Comparing this against NntpMboxData::newsrc_crc is how the sidecar spots
+ * dirty groups, whichever code path modified the ranges.
+ */
+static uint32_t nb_group_crc(const struct NntpMboxData *mdata)
+{
+  const unsigned char sub = mdata->subscribed;
+  const uint32_t crc = mutt_crc32c(1, &sub, 1);
+  return mutt_crc32c(crc, mdata->newsrc_ent,
+                     mdata->newsrc_len * sizeof(struct NewsrcEntry));
+}
+
+/**
+ * nb_write_group - Append one group record to a binary newsrc
+ * @param fp     File to write to
+ * @param mdata  NNTP Mailbox data
+ * @param forget true: record that the group has no ranges any more
+ */
+static void nb_write_group(FILE *fp, const struct NntpMboxData *mdata, bool forget)
+{
+  const size_t namelen = mutt_str_len(mdata->group);
+  unsigned char flags = 0;
+  if (mdata->subscribed)
+    flags |= NB_SUBSCRIBED;
+  if (forget)
+    flags |= NB_FORGET;
+
+  nb_put_uint(fp, namelen);
+  fwrite(mdata->group, 1, namelen, fp);
+  fputc(flags, fp);
+  if (forget)
+    return;
+
+  nb_put_uint(fp, mdata->newsrc_len);
+  anum_t prev = 0;
+  for (unsigned int i = 0; i < mdata->newsrc_len; i++)
+  {
+    /* deltas keep multi-million article numbers to a couple of bytes */
+    nb_put_int(fp, mdata->newsrc_ent[i].first - prev);
+    nb_put_int(fp, mdata->newsrc_ent[i].last - mdata->newsrc_ent[i].first);
+    prev = mdata->newsrc_ent[i].last;
+  }
+}
+
+/**
+ * nb_snapshot - Write a compact binary newsrc from scratch
  * @param adata NNTP server
  * @retval  0 Success
  * @retval -1 Failure
  */
+static int nb_snapshot(struct NntpAccountData *adata)
+{
+  char file[PATH_MAX] = { 0 };
+  char tmpfile[PATH_MAX] = { 0 };
+
+  nb_path(adata, file, sizeof(file));
+  snprintf(tmpfile, sizeof(tmpfile), "%s.tmp", file);
+
+  unlink(tmpfile);
+  FILE *fp = mutt_file_fopen(tmpfile, "w");
+  if (!fp)
+    return -1;
+
+  fwrite(NewsrcBinMagic, 1, sizeof(NewsrcBinMagic), fp);
+  fputc(NEWSRC_BIN_VERSION, fp);
+  nb_put_uint(fp, (uint64_t) adata->size);
+  nb_put_uint(fp, (uint64_t) adata->mtime);
+
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (!mdata)
+      continue;
+    if (!mdata->newsrc_ent)
+    {
+      mdata->newsrc_crc = 0;
+      continue;
+    }
+    nb_write_group(fp, mdata, false);
+    mdata->newsrc_crc = nb_group_crc(mdata);
+  }
+
+  if (ferror(fp))
+  {
+    mutt_file_fclose(&fp);
+    unlink(tmpfile);
+    return -1;
+  }
+  if ((mutt_file_fclose(&fp) == EOF) || (rename(tmpfile, file) < 0))
+  {
+    unlink(tmpfile);
+    return -1;
+  }
+
+  adata->nb_appends = 0;
+  mutt_debug(LL_DEBUG1, "Snapshotted %s\n", file);
+  return 0;
+}
+
+/**
+ * nb_append_dirty - Append the changed groups to the binary newsrc
+ * @param adata NNTP server
+ * @retval  0 Success - the sidecar holds the current state
+ * @retval -1 Failure - fall back to rewriting the text .newsrc
+ *
+ * Writes a snapshot instead where no sidecar exists yet, or when the appended
+ * records have outgrown the group count.
+ */
+static int nb_append_dirty(struct NntpAccountData *adata)
+{
+  if (!adata->newsrc_file)
+    return -1;
+
+  char file[PATH_MAX] = { 0 };
+  nb_path(adata, file, sizeof(file));
+
+  unsigned int dirty = 0;
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (!mdata)
+      continue;
+    if (mdata->newsrc_ent ? (mdata->newsrc_crc != nb_group_crc(mdata)) :
+                            (mdata->newsrc_crc != 0))
+    {
+      dirty++;
+    }
+  }
+
+  if ((access(file, F_OK) != 0) ||
+      ((adata->nb_appends + dirty) > (adata->groups_num + NEWSRC_BIN_SLACK)))
+  {
+    return nb_snapshot(adata);
+  }
+
+  if (dirty == 0)
+    return 0;
+
+  FILE *fp = mutt_file_fopen(file, "a");
+  if (!fp)
+    return -1;
+
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (!mdata)
+      continue;
+    if (mdata->newsrc_ent)
+    {
+      const uint32_t crc = nb_group_crc(mdata);
+      if (crc == mdata->newsrc_crc)
+        continue;
+      nb_write_group(fp, mdata, false);
+      mdata->newsrc_crc = crc;
+    }
+    else if (mdata->newsrc_crc != 0)
+    {
+      nb_write_group(fp, mdata, true);
+      mdata->newsrc_crc = 0;
+    }
+    else
+    {
+      continue;
+    }
+    adata->nb_appends++;
+  }
+
+  const bool failed = ferror(fp);
+  if ((mutt_file_fclose(&fp) == EOF) || failed)
+    return -1;
+
+  mutt_debug(LL_DEBUG1, "Appended %u group(s) to %s\n", dirty, file);
+  return 0;
+}
+
+/**
+ * nb_load - Overlay the binary newsrc onto the parsed .newsrc
+ * @param adata NNTP server
+ * @param st    stat of the .newsrc text file just parsed
+ *
+ * Applied only when the sidecar header matches @a st; a mismatch means the
+ * .newsrc was modified externally, so the text wins and the sidecar is
+ * dropped.  A record torn by a crash mid-append ends the stream; everything
+ * before it is kept.
+ */
+static void nb_load(struct NntpAccountData *adata, struct stat *st)
+{
+  if (!adata->newsrc_file)
+    return;
+
+  char file[PATH_MAX] = { 0 };
+  nb_path(adata, file, sizeof(file));
+
+  FILE *fp = mutt_file_fopen(file, "r");
+  if (!fp)
+    return;
+
+  char magic[4] = { 0 };
+  uint64_t size = 0;
+  uint64_t mtime = 0;
+  if ((fread(magic, 1, sizeof(magic), fp) != sizeof(magic)) ||
+      (memcmp(magic, NewsrcBinMagic, sizeof(magic)) != 0) ||
+      (fgetc(fp) != NEWSRC_BIN_VERSION) || (nb_get_uint(fp, &size) != 0) ||
+      (nb_get_uint(fp, &mtime) != 0) || ((off_t) size != st->st_size) ||
+      ((time_t) mtime != st->st_mtime))
+  {
+    mutt_debug(LL_DEBUG1, "Discarding stale %s\n", file);
+    mutt_file_fclose(&fp);
+    unlink(file);
+    return;
+  }
+
+  unsigned int records = 0;
+  while (true)
+  {
+    uint64_t namelen = 0;
+    char group[1024] = { 0 };
+    if ((nb_get_uint(fp, &namelen) != 0) || (namelen == 0) ||
+        (namelen >= sizeof(group)) || (fread(group, 1, namelen, fp) != namelen))
+    {
+      break;
+    }
+    const int flags = fgetc(fp);
+    if (flags == EOF)
+      break;
+
+    struct NewsrcEntry *ent = NULL;
+    uint64_t num = 0;
+    if (!(flags & NB_FORGET))
+    {
+      if ((nb_get_uint(fp, &num) != 0) || (num > NEWSRC_BIN_MAX_RANGES))
+        break;
+      if (num)
+      {
+        ent = mutt_mem_calloc(num, sizeof(struct NewsrcEntry));
+        anum_t prev = 0;
+        bool torn = false;
+        for (uint64_t i = 0; i < num; i++)
+        {
+          int64_t gap = 0, span = 0;
+          if ((nb_get_int(fp, &gap) != 0) || (nb_get_int(fp, &span) != 0))
+          {
+            torn = true;
+            break;
+          }
+          ent[i].first = prev + gap;
+          ent[i].last = ent[i].first + span;
+          prev = ent[i].last;
+        }
+        if (torn)
+        {
+          FREE(&ent);
+          break;
+        }
+      }
+    }
+
+    struct NntpMboxData *mdata = mdata_find(adata, group);
+    FREE(&mdata->newsrc_ent);
+    mdata->newsrc_ent = ent;
+    mdata->newsrc_len = num;
+    mdata->subscribed = (flags & NB_SUBSCRIBED);
+    if ((mdata->last_message == 0) && num)
+      mdata->last_message = ent[num - 1].last;
+    mdata->newsrc_crc = ent ? nb_group_crc(mdata) : 0;
+    nntp_group_unread_stat(mdata);
+    records++;
+    adata->nb_appends = records; // over-counts snapshot records, erring towards compaction
+  }
+
+  mutt_file_fclose(&fp);
+  mutt_debug(LL_DEBUG1, "Loaded %u record(s) from %s\n", records, file);
+}
+
+/**
+ * nntp_newsrc_update - Update the newsrc state on disk
+ * @param adata NNTP server
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * The fast path appends just the changed groups to the binary sidecar and
+ * leaves the text .newsrc alone; it is re-exported when the account is
+ * freed.  If the sidecar can't be written, fall back to a full text rewrite.
+ */
 int nntp_newsrc_update(struct NntpAccountData *adata)
+{
+  if (!adata)
+    return -1;
+
+  if (nb_append_dirty(adata) == 0)
+  {
+    adata->newsrc_export = true;
+    return 0;
+  }
+
+  return nntp_newsrc_export(adata);
+}
+
+/**
+ * nntp_newsrc_export - Rewrite the text .newsrc file
+ * @param adata NNTP server
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * The text file is kept for interoperability with other newsreaders; with a
+ * working binary sidecar this only runs when the account is torn down.
+ */
+int nntp_newsrc_export(struct NntpAccountData *adata)
 {
   if (!adata)
     return -1;
@@ -511,6 +918,13 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
     {
       mutt_perror("%s", adata->newsrc_file);
     }
+
+    /* the text now holds the full state; the sidecar would just be stale */
+    char file[PATH_MAX] = { 0 };
+    nb_path(adata, file, sizeof(file));
+    unlink(file);
+    adata->nb_appends = 0;
+    adata->newsrc_export = false;
   }
   FREE(&buf);
   return rc;
@@ -722,7 +1136,7 @@ struct HeaderCache *nntp_hcache_open(struct NntpMboxData *mdata)
   url.path = mdata->group;
   url_tostring(&url, file, sizeof(file), U_PATH);
   const char *const c_news_cache_dir = cs_subset_path(NeoMutt->sub, "news_cache_dir");
-  return hcache_open(c_news_cache_dir, file, nntp_hcache_namer, true);
+  return hcache_open(c_news_cache_dir, file, nntp_hcache_namer, true, false);
 }
 
 /**
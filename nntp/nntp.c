@@ -97,6 +97,7 @@ struct FetchCtx
   bool restore;
   unsigned char *messages;
   struct Progress *progress;
+  FILE *fp_tmp;
   struct HeaderCache *hc;
 };
 
@@ -1080,10 +1081,16 @@ static int parse_overview_line(char *line, void *data)
     return 0;
   }
 
-  /* convert overview line to header */
-  FILE *fp = mutt_file_mkstemp();
+  /* convert overview line to header; one temporary file is reused for the
+   * whole fetch, rather than creating one per article */
+  if (!fc->fp_tmp)
+    fc->fp_tmp = mutt_file_mkstemp();
+  FILE *fp = fc->fp_tmp;
   if (!fp)
     return -1;
+  rewind(fp);
+  if (ftruncate(fileno(fp), 0) != 0)
+    return -1;
 
   header = mdata->adata->overview_fmt;
   while (field)
@@ -1094,7 +1101,6 @@ static int parse_overview_line(char *line, void *data)
     {
       if (!strstr(header, ":full") && (fputs(header, fp) == EOF))
       {
-        mutt_file_fclose(&fp);
         return -1;
       }
       header = strchr(header, '\0') + 1;
@@ -1105,7 +1111,6 @@ static int parse_overview_line(char *line, void *data)
       *field++ = '\0';
     if ((fputs(b, fp) == EOF) || (fputc('\n', fp) == EOF))
     {
-      mutt_file_fclose(&fp);
       return -1;
     }
   }
@@ -1120,7 +1125,6 @@ static int parse_overview_line(char *line, void *data)
   e->env = mutt_rfc822_read_header(fp, e, false, false);
   e->env->newsgroups = mutt_str_dup(mdata->group);
   e->received = e->date_sent;
-  mutt_file_fclose(&fp);
 
 #ifdef USE_HCACHE
   if (fc->hc)
@@ -1228,6 +1232,11 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     return -1;
   fc.hc = hc;
 
+#ifdef USE_HCACHE
+  /* batch the cache deletes and stores for the whole fetch */
+  hcache_txn_begin(fc.hc);
+#endif
+
   /* fetch list of articles */
   const bool c_nntp_listgroup = cs_subset_bool(NeoMutt->sub, "nntp_listgroup");
   if (c_nntp_listgroup && mdata->adata->hasLISTGROUP && !mdata->deleted)
@@ -1422,6 +1431,10 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     }
   }
 
+#ifdef USE_HCACHE
+  hcache_txn_commit(fc.hc);
+#endif
+  mutt_file_fclose(&fc.fp_tmp);
   FREE(&fc.messages);
   progress_free(&fc.progress);
   if (rc != 0)
@@ -2640,6 +2653,112 @@ static enum MxStatus nntp_mbox_close(struct Mailbox *m)
   return MX_STATUS_OK;
 }
 
+/**
+ * nntp_article_prefetch - Read ahead into the body cache
+ * @param m Mailbox
+ * @param e Email that has just been fetched
+ *
+ * Send a pipelined ARTICLE command for each of the next
+ * `$nntp_prefetch_articles` uncached articles, then stream all the responses
+ * into the body cache.  The whole batch costs a single round trip, so paging
+ * through a group doesn't pay the server latency for every message.
+ */
+static void nntp_article_prefetch(struct Mailbox *m, struct Email *e)
+{
+  const short c_nntp_prefetch_articles = cs_subset_number(NeoMutt->sub, "nntp_prefetch_articles");
+  if (c_nntp_prefetch_articles <= 0)
+    return;
+
+  struct NntpMboxData *mdata = m->mdata;
+  if (!mdata->bcache || mdata->deleted || (mdata->adata->status != NNTP_OK))
+    return;
+
+  struct Connection *conn = mdata->adata->conn;
+  char buf[1024] = { 0 };
+  char article[16] = { 0 };
+
+  /* pick the next uncached articles, in display order */
+  struct Email **queue = mutt_mem_calloc(c_nntp_prefetch_articles, sizeof(*queue));
+  int num_queued = 0;
+  for (int i = e->msgno + 1;
+       (i < m->msg_count) && (num_queued < c_nntp_prefetch_articles); i++)
+  {
+    struct Email *e2 = m->emails[i];
+    if (!e2 || !nntp_edata_get(e2)->article_num || nntp_edata_get(e2)->parsed)
+      continue;
+    snprintf(article, sizeof(article), ANUM_FMT, nntp_edata_get(e2)->article_num);
+    if (mutt_bcache_exists(mdata->bcache, article) == 0)
+      continue;
+    queue[num_queued++] = e2;
+  }
+
+  /* send all the commands up front ... */
+  for (int i = 0; i < num_queued; i++)
+  {
+    snprintf(buf, sizeof(buf), "ARTICLE " ANUM_FMT "\r\n",
+             nntp_edata_get(queue[i])->article_num);
+    if (mutt_socket_send(conn, buf) < 0)
+    {
+      mdata->adata->status = NNTP_NONE;
+      FREE(&queue);
+      return;
+    }
+  }
+
+  /* ... then collect all the responses */
+  for (int i = 0; i < num_queued; i++)
+  {
+    if (mutt_socket_readln(buf, sizeof(buf), conn) < 0)
+      goto conn_lost;
+
+    /* an error status is a single line; a body only follows success */
+    if (buf[0] != '2')
+      continue;
+
+    snprintf(article, sizeof(article), ANUM_FMT, nntp_edata_get(queue[i])->article_num);
+    FILE *fp = mutt_bcache_put(mdata->bcache, article);
+
+    bool at_bol = true;
+    while (true)
+    {
+      int chunk = mutt_socket_readln_d(buf, sizeof(buf), conn, MUTT_SOCK_LOG_FULL);
+      if (chunk < 0)
+      {
+        mutt_file_fclose(&fp);
+        goto conn_lost;
+      }
+
+      char *p = buf;
+      if (at_bol && (buf[0] == '.'))
+      {
+        if (buf[1] == '\0')
+          break;
+        if (buf[1] == '.')
+          p++;
+      }
+
+      if (fp)
+        fputs(p, fp);
+      at_bol = (chunk < sizeof(buf));
+      if (at_bol && fp)
+        fputc('\n', fp);
+    }
+
+    if (fp)
+    {
+      mutt_file_fclose(&fp);
+      mutt_bcache_commit(mdata->bcache, article);
+    }
+  }
+
+  FREE(&queue);
+  return;
+
+conn_lost:
+  mdata->adata->status = NNTP_NONE;
+  FREE(&queue);
+}
+
 /**
  * nntp_msg_open - Open an email message in a Mailbox - Implements MxOps::msg_open() - @ingroup mx_msg_open
  */
@@ -2729,6 +2848,8 @@ static bool nntp_msg_open(struct Mailbox *m, struct Message *msg, struct Email *
 
     if (!acache->path)
       mutt_bcache_commit(mdata->bcache, article);
+
+    nntp_article_prefetch(m, e);
   }
 
   /* replace envelope with new one
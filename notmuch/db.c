@@ -342,6 +342,63 @@ int nm_db_get_mtime(struct Mailbox *m, time_t *mtime)
   return 0;
 }
 
+/**
+ * nm_db_get_revision - Get the database revision counter
+ * @param m Mailbox
+ * @retval num Revision of the last committed change
+ * @retval 0   Error, or no revision support
+ *
+ * The revision pairs with notmuch's `lastmod:` search term: querying
+ * `lastmod:<revision+1>..` later returns exactly the messages that have been
+ * added or modified in between.
+ *
+ * @note The database must be open
+ */
+unsigned long nm_db_get_revision(struct Mailbox *m)
+{
+#if LIBNOTMUCH_CHECK_VERSION(4, 5, 0)
+  struct NmAccountData *adata = nm_adata_get(m);
+  if (!adata || !adata->db)
+    return 0;
+
+  const char *uuid = NULL;
+  return notmuch_database_get_revision(adata->db, &uuid);
+#else
+  return 0;
+#endif
+}
+
+/**
+ * nm_db_monitor_path - Get the directory to watch for database changes
+ * @param[in]  m    Mailbox
+ * @param[out] path Buffer for the result
+ * @retval true Success (path is filled in)
+ *
+ * Returns the Xapian directory: every committed change to the database
+ * touches the tables in there, so an inotify watch on it sees `notmuch new`
+ * and tag edits made by other clients.
+ */
+bool nm_db_monitor_path(struct Mailbox *m, struct Buffer *path)
+{
+  if (!m || !path)
+    return false;
+
+  struct stat st = { 0 };
+  const char *db_filename = nm_db_get_filename(m);
+  if (!db_filename)
+    return false;
+
+  // See if the path we were given has a Xapian directory.
+  // After notmuch 0.32, a .notmuch folder isn't guaranteed.
+  buf_printf(path, "%s/xapian", db_filename);
+  if (stat(buf_string(path), &st) == 0)
+    return true;
+
+  // Otherwise, check for a .notmuch directory.
+  buf_printf(path, "%s/.notmuch/xapian", db_filename);
+  return stat(buf_string(path), &st) == 0;
+}
+
 /**
  * nm_db_is_longrun - Is Notmuch in the middle of a long-running transaction
  * @param m Mailbox
@@ -360,6 +417,11 @@ bool nm_db_is_longrun(struct Mailbox *m)
  * nm_db_longrun_init - Start a long transaction
  * @param m        Mailbox
  * @param writable Read/write?
+ *
+ * A writable long run is wrapped in a single atomic transaction, so a batch
+ * of changes, e.g. retagging every tagged message, is committed and flushed
+ * once rather than per message.  nm_db_trans_begin() in the per-message
+ * functions simply joins this transaction.
  */
 void nm_db_longrun_init(struct Mailbox *m, bool writable)
 {
@@ -369,6 +431,8 @@ void nm_db_longrun_init(struct Mailbox *m, bool writable)
     return;
 
   adata->longrun = true;
+  if (writable)
+    nm_db_trans_begin(m);
   mutt_debug(LL_DEBUG2, "nm: long run initialized\n");
 }
 
@@ -382,6 +446,7 @@ void nm_db_longrun_done(struct Mailbox *m)
 
   if (adata)
   {
+    nm_db_trans_end(m); // commit the long run's transaction, if any
     adata->longrun = false; /* to force nm_db_release() released DB */
     if (nm_db_release(m) == 0)
       mutt_debug(LL_DEBUG2, "nm: long run deinitialized\n");
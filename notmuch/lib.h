@@ -47,6 +47,7 @@
 #include "core/lib.h"
 #include "complete/lib.h"
 
+struct Buffer;
 struct Email;
 struct stat;
 
@@ -59,6 +60,7 @@ void  nm_init                    (void);
 void  nm_db_debug_check          (struct Mailbox *m);
 void  nm_db_longrun_done         (struct Mailbox *m);
 void  nm_db_longrun_init         (struct Mailbox *m, bool writable);
+bool  nm_db_monitor_path         (struct Mailbox *m, struct Buffer *path);
 char *nm_email_get_folder        (struct Email *e);
 char *nm_email_get_folder_rel_db (struct Mailbox *m, struct Email *e);
 int   nm_get_all_tags            (struct Mailbox *m, const char **tag_list, int *tag_count);
@@ -42,6 +42,7 @@ struct NmMboxData
   int oldmsgcount;
   int ignmsgcount;             ///< Ignored messages
   struct timespec mtime;       ///< Time Mailbox was last changed
+  unsigned long lastmod;       ///< Database revision at the last (re)read
 };
 
 void                  nm_mdata_free(void **ptr);
@@ -119,7 +119,12 @@ static struct HeaderCache *nm_hcache_open(struct Mailbox *m)
 {
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
-  return hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+
+  // Batch all the stores into a single transaction, where the backend allows
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
+  hcache_txn_begin(hc);
+
+  return hc;
 #else
   return NULL;
 #endif
@@ -132,6 +137,8 @@ static struct HeaderCache *nm_hcache_open(struct Mailbox *m)
 static void nm_hcache_close(struct HeaderCache **ptr)
 {
 #ifdef USE_HCACHE
+  if (ptr && *ptr)
+    hcache_txn_commit(*ptr);
   hcache_close(ptr);
 #endif
 }
@@ -471,6 +478,46 @@ err:
   return NULL;
 }
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 5, 0)
+/**
+ * get_delta_query - Create a query for messages modified since a revision
+ * @param m        Mailbox
+ * @param lastmod  Database revision of the previous read
+ * @param matching If true, restrict to messages matching the vfolder query
+ * @retval ptr  Notmuch query
+ * @retval NULL Error
+ *
+ * Uses notmuch's `lastmod:` search term, so the result covers exactly the
+ * messages added or changed since that revision - typically a handful,
+ * however large the vfolder.
+ */
+static notmuch_query_t *get_delta_query(struct Mailbox *m, unsigned long lastmod, bool matching)
+{
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  notmuch_database_t *db = nm_db_get(m, false);
+  const char *str = matching ? get_query_string(mdata, true) : NULL;
+  if (!db || (matching && !str))
+    return NULL;
+
+  char *qstr = NULL;
+  if (matching)
+    mutt_str_asprintf(&qstr, "( %s ) lastmod:%lu..", str, lastmod + 1);
+  else
+    mutt_str_asprintf(&qstr, "lastmod:%lu..", lastmod + 1);
+
+  notmuch_query_t *q = notmuch_query_create(db, qstr);
+  mutt_debug(LL_DEBUG2, "nm: delta query initialized (%s)\n", qstr);
+  FREE(&qstr);
+  if (!q)
+    return NULL;
+
+  if (matching)
+    apply_exclude_tags(q);
+  notmuch_query_set_sort(q, NOTMUCH_SORT_NEWEST_FIRST);
+  return q;
+}
+#endif
+
 /**
  * update_email_tags - Update the Email's tags from Notmuch
  * @param e   Email
@@ -929,6 +976,31 @@ static notmuch_messages_t *get_messages(notmuch_query_t *query)
   return msgs;
 }
 
+/**
+ * get_count - Count the messages matching a query
+ * @param query Notmuch query
+ * @retval num Number of results
+ *
+ * This helper method is to be the single point for counting messages. It
+ * handles version specific calls, which will make maintenance easier.
+ */
+static unsigned int get_count(notmuch_query_t *query)
+{
+  unsigned int res = 0;
+
+#if LIBNOTMUCH_CHECK_VERSION(5, 0, 0)
+  if (notmuch_query_count_messages(query, &res) != NOTMUCH_STATUS_SUCCESS)
+    res = 0; /* may not be defined on error */
+#elif LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
+  if (notmuch_query_count_messages_st(query, &res) != NOTMUCH_STATUS_SUCCESS)
+    res = 0; /* may not be defined on error */
+#else
+  res = notmuch_query_count_messages(query);
+#endif
+
+  return res;
+}
+
 /**
  * read_mesgs_query - Search for matching messages
  * @param m     Mailbox
@@ -950,6 +1022,14 @@ static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
   if (!msgs)
     return false;
 
+  /* Counting is cheap for the database - reserve room for the whole result
+   * up front, rather than grow the Email array in small steps */
+  unsigned int count = get_count(q);
+  if ((limit != 0) && (count > (unsigned int) limit))
+    count = limit;
+  if (count != 0)
+    mx_alloc_memory(m, m->msg_count + count - 1);
+
   struct HeaderCache *hc = nm_hcache_open(m);
 
   for (; notmuch_messages_valid(msgs) && ((limit == 0) || (m->msg_count < limit));
@@ -1439,18 +1519,8 @@ static unsigned int count_query(notmuch_database_t *db, const char *qstr, int li
   if (!q)
     return 0;
 
-  unsigned int res = 0;
-
   apply_exclude_tags(q);
-#if LIBNOTMUCH_CHECK_VERSION(5, 0, 0)
-  if (notmuch_query_count_messages(q, &res) != NOTMUCH_STATUS_SUCCESS)
-    res = 0; /* may not be defined on error */
-#elif LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
-  if (notmuch_query_count_messages_st(q, &res) != NOTMUCH_STATUS_SUCCESS)
-    res = 0; /* may not be defined on error */
-#else
-  res = notmuch_query_count_messages(q);
-#endif
+  unsigned int res = get_count(q);
   notmuch_query_destroy(q);
   mutt_debug(LL_DEBUG1, "nm: count '%s', result=%d\n", qstr, res);
 
@@ -2076,6 +2146,8 @@ static enum MxOpenReturns nm_mbox_open(struct Mailbox *m)
     notmuch_query_destroy(q);
   }
 
+  mdata->lastmod = nm_db_get_revision(m);
+
   nm_db_release(m);
 
   mdata->mtime.tv_sec = mutt_date_now();
@@ -2113,23 +2185,60 @@ static enum MxStatus nm_mbox_check(struct Mailbox *m)
   mutt_debug(LL_DEBUG1, "nm: checking (db=%llu mailbox=%llu)\n",
              (unsigned long long) mtime, (unsigned long long) mdata->mtime.tv_sec);
 
-  notmuch_query_t *q = get_query(m, false);
+  int limit = get_limit(mdata);
+  bool delta = false;
+  notmuch_query_t *q = NULL;
+
+#if LIBNOTMUCH_CHECK_VERSION(4, 5, 0)
+  /* Prefer an incremental check: ask the database only for the messages
+   * modified since the revision we last read, instead of re-running the
+   * whole query.  Limited or windowed vfolders take the full path - their
+   * result set depends on more than the messages themselves. */
+  if ((mdata->lastmod > 0) && (limit == 0) && !nm_query_window_available())
+  {
+    q = get_delta_query(m, mdata->lastmod, true);
+    delta = (q != NULL);
+  }
+#endif
+
+  if (!q)
+    q = get_query(m, false);
   if (!q)
     goto done;
 
-  mutt_debug(LL_DEBUG1, "nm: start checking (count=%d)\n", m->msg_count);
+  mutt_debug(LL_DEBUG1, "nm: start checking (count=%d, delta=%d)\n", m->msg_count, delta);
   mdata->oldmsgcount = m->msg_count;
 
-  for (int i = 0; i < m->msg_count; i++)
+  if (delta)
   {
-    struct Email *e = m->emails[i];
-    if (!e)
-      break;
-
-    e->active = false;
+#if LIBNOTMUCH_CHECK_VERSION(4, 5, 0)
+    /* Mark only the modified messages dead; the matching walk below revives
+     * the ones still in the query.  Untouched messages keep their state. */
+    notmuch_query_t *q_mod = get_delta_query(m, mdata->lastmod, false);
+    notmuch_messages_t *mod = get_messages(q_mod);
+    for (; mod && notmuch_messages_valid(mod); notmuch_messages_move_to_next(mod))
+    {
+      notmuch_message_t *msg = notmuch_messages_get(mod);
+      struct Email *e = get_mutt_email(m, msg);
+      if (e)
+        e->active = false;
+      notmuch_message_destroy(msg);
+    }
+    if (q_mod)
+      notmuch_query_destroy(q_mod);
+#endif
   }
+  else
+  {
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      struct Email *e = m->emails[i];
+      if (!e)
+        break;
 
-  int limit = get_limit(mdata);
+      e->active = false;
+    }
+  }
 
   notmuch_messages_t *msgs = get_messages(q);
 
@@ -2189,24 +2298,37 @@ static enum MxStatus nm_mbox_check(struct Mailbox *m)
 
   nm_hcache_close(&hc);
 
+  int active = 0;
   for (int i = 0; i < m->msg_count; i++)
   {
     struct Email *e = m->emails[i];
     if (!e)
       break;
 
-    if (!e->active)
-    {
+    if (e->active)
+      active++;
+    else
       occult = true;
-      break;
-    }
   }
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 5, 0)
+  /* A message deleted from the database leaves no trace in a lastmod:
+   * search; catch disappearances by comparing result counts instead. */
+  if (delta && !occult &&
+      (count_query(nm_db_get(m, false), get_query_string(mdata, true), limit) != (unsigned int) active))
+  {
+    occult = true;
+  }
+#endif
+
   if (m->msg_count > mdata->oldmsgcount)
     mailbox_changed(m, NT_MAILBOX_INVALID);
 done:
   if (q)
+  {
+    mdata->lastmod = nm_db_get_revision(m);
     notmuch_query_destroy(q);
+  }
 
   nm_db_release(m);
 
@@ -2431,6 +2553,10 @@ static int nm_tags_commit(struct Mailbox *m, struct Email *e, const char *buf)
   if (!(db = nm_db_get(m, true)) || !(msg = get_nm_message(db, e)))
     goto done;
 
+  int trans = nm_db_trans_begin(m);
+  if (trans < 0)
+    goto done;
+
   mutt_debug(LL_DEBUG1, "nm: tags modify: '%s'\n", buf);
 
   update_tags(msg, buf);
@@ -2440,6 +2566,9 @@ static int nm_tags_commit(struct Mailbox *m, struct Email *e, const char *buf)
 
   rc = 0;
   e->changed = true;
+
+  if (trans == 1)
+    nm_db_trans_end(m);
 done:
   nm_db_release(m);
   if (e->changed)
@@ -64,6 +64,7 @@ notmuch_database_t *nm_db_do_open     (const char *filename, bool writable, bool
 void                nm_db_free        (notmuch_database_t *db);
 const char *        nm_db_get_filename(struct Mailbox *m);
 int                 nm_db_get_mtime   (struct Mailbox *m, time_t *mtime);
+unsigned long       nm_db_get_revision(struct Mailbox *m);
 notmuch_database_t *nm_db_get         (struct Mailbox *m, bool writable);
 bool                nm_db_is_longrun  (struct Mailbox *m);
 int                 nm_db_release     (struct Mailbox *m);
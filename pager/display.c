@@ -380,6 +380,19 @@ static void match_body_patterns(char *pat, struct Line *lines, int line_num)
   bool null_rx = false;
   regmatch_t pmatch[1] = { 0 };
 
+  /* If this exact text has already been matched against these colours,
+   * e.g. after a reflow, then the syntax array is still valid */
+  const unsigned int gen = regex_colors_generation();
+  unsigned int hash = 5381 + lines[line_num].cid;
+  for (const char *p = pat; *p != '\0'; p++)
+    hash = (hash << 5) + hash + (unsigned char) *p;
+  if ((lines[line_num].syntax_gen == gen) && (lines[line_num].syntax_hash == hash))
+  {
+    if (has_nl)
+      pat[buflen - 1] = '\n';
+    return;
+  }
+
   lines[line_num].syntax_arr_size = 0;
   if (lines[line_num].cid == MT_COLOR_HDRDEFAULT)
   {
@@ -391,7 +404,17 @@ static void match_body_patterns(char *pat, struct Line *lines, int line_num)
   }
   STAILQ_FOREACH(color_line, head, entries)
   {
-    color_line->stop_matching = false;
+    /* A rule whose required literal isn't in the line can't match */
+    if (color_line->literal &&
+        !(color_line->literal_icase ? (mutt_istr_find(pat, color_line->literal) != NULL) :
+                                      (strstr(pat, color_line->literal) != NULL)))
+    {
+      color_line->stop_matching = true;
+    }
+    else
+    {
+      color_line->stop_matching = false;
+    }
   }
 
   do
@@ -475,6 +498,9 @@ static void match_body_patterns(char *pat, struct Line *lines, int line_num)
       offset = (lines[line_num].syntax)[i].last;
   } while (found || null_rx);
 
+  lines[line_num].syntax_hash = hash;
+  lines[line_num].syntax_gen = gen;
+
   if (has_nl)
     pat[buflen - 1] = '\n';
 }
@@ -1020,6 +1046,142 @@ static int format_line(struct MuttWindow *win, struct Line **lines, int line_num
   return ch;
 }
 
+/// Literal substring that every search match must contain, or NULL
+static char *SearchPrefilter = NULL;
+/// Match #SearchPrefilter case-insensitively
+static bool SearchPrefilterIcase = false;
+
+/**
+ * display_search_prefilter - Derive a literal prefilter from a search pattern
+ * @param pattern Search regex, as typed by the user
+ * @param icase   True if the regex was compiled with REG_ICASE
+ *
+ * Extract the longest run of plain literal characters that any match must
+ * contain.  Lines without that substring can then skip regexec() entirely,
+ * which makes searching a huge message mostly memmem() speed.  Patterns where
+ * no such run can be found safely (alternation, groups, classes) simply get
+ * no prefilter.
+ */
+void display_search_prefilter(const char *pattern, bool icase)
+{
+  FREE(&SearchPrefilter);
+  SearchPrefilterIcase = icase;
+
+  /* Be conservative: give up on any construct whose extent is hard to judge.
+   * The searches that hurt - plain words over huge messages - survive. */
+  if (!pattern || (pattern[strcspn(pattern, "|(\\[{")] != '\0'))
+    return;
+
+  const char *best = NULL;
+  size_t best_len = 0;
+  const char *run = NULL;
+  size_t run_len = 0;
+
+  for (const char *p = pattern; *p; p++)
+  {
+    if (strchr("^$.*+?", *p))
+    {
+      // A quantifier makes the previous character optional
+      if (((*p == '*') || (*p == '?')) && (run_len > 0))
+        run_len--;
+      if (run_len > best_len)
+      {
+        best = run;
+        best_len = run_len;
+      }
+      run = NULL;
+      run_len = 0;
+      continue;
+    }
+
+    if (!run)
+      run = p;
+    run_len++;
+  }
+
+  if (run_len > best_len)
+  {
+    best = run;
+    best_len = run_len;
+  }
+
+  // A short literal has no selectivity
+  if (best_len < 3)
+    return;
+
+  SearchPrefilter = mutt_strn_dup(best, best_len);
+}
+
+/**
+ * display_search_prefilter_clear - Discard the search prefilter
+ */
+void display_search_prefilter_clear(void)
+{
+  FREE(&SearchPrefilter);
+}
+
+/**
+ * search_prefilter_match - Could a line contain a search match?
+ * @param line Text of the line
+ * @retval true The line may match, run the real regex
+ */
+static bool search_prefilter_match(const char *line)
+{
+  if (!SearchPrefilter)
+    return true;
+
+  if (SearchPrefilterIcase)
+    return (mutt_istr_find(line, SearchPrefilter) != NULL);
+
+  return (strstr(line, SearchPrefilter) != NULL);
+}
+
+/**
+ * lines_new - Allocate an array of Lines
+ * @param count Number of Lines to allocate
+ * @retval ptr New array of Lines
+ *
+ * Free the result with lines_free().  display_line() will grow the array as
+ * the file is read.
+ */
+struct Line *lines_new(int count)
+{
+  struct Line *lines = mutt_mem_calloc(count, sizeof(struct Line));
+
+  for (int i = 0; i < count; i++)
+  {
+    lines[i].cid = -1;
+    lines[i].search_arr_size = -1;
+    lines[i].syntax = mutt_mem_calloc(1, sizeof(struct TextSyntax));
+    (lines[i].syntax)[0].first = -1;
+    (lines[i].syntax)[0].last = -1;
+  }
+
+  return lines;
+}
+
+/**
+ * lines_free - Free an array of Lines
+ * @param[out] ptr   Array of Lines to free
+ * @param[in]  count Number of Lines in the array
+ *
+ * @note The pointer will be NULL'd
+ */
+void lines_free(struct Line **ptr, int count)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct Line *lines = *ptr;
+  for (int i = 0; i < count; i++)
+  {
+    FREE(&lines[i].syntax);
+    FREE(&lines[i].search);
+  }
+
+  FREE(ptr);
+}
+
 /**
  * display_line - Print a line on screen
  * @param[in]  fp              File to read from
@@ -1070,7 +1232,10 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
 
   if (*lines_used == *lines_max)
   {
-    mutt_mem_realloc(lines, sizeof(struct Line) * (*lines_max += LINES));
+    /* grow geometrically - fixed one-screenful steps make appending
+     * quadratic on million-line messages */
+    *lines_max = (*lines_max < LINES) ? (*lines_max + LINES) : (*lines_max * 2);
+    mutt_mem_realloc(lines, sizeof(struct Line) * *lines_max);
     for (ch = *lines_used; ch < *lines_max; ch++)
     {
       memset(&((*lines)[ch]), 0, sizeof(struct Line));
@@ -1193,8 +1358,9 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
 
     offset = 0;
     cur_line->search_arr_size = 0;
-    while (regexec(search_re, (char *) fmt + offset, 1, pmatch,
-                   (offset ? REG_NOTBOL : 0)) == 0)
+    while (search_prefilter_match((char *) fmt + offset) &&
+           (regexec(search_re, (char *) fmt + offset, 1, pmatch,
+                    (offset ? REG_NOTBOL : 0)) == 0))
     {
       if (++(cur_line->search_arr_size) > 1)
       {
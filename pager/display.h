@@ -56,6 +56,8 @@ struct Line
 
   short syntax_arr_size;     ///< Number of items in syntax array
   struct TextSyntax *syntax; ///< Array of coloured text in the line
+  unsigned int syntax_hash;  ///< Hash of the text the syntax was computed from
+  unsigned int syntax_gen;   ///< Regex-colour generation of the syntax, 0 if never computed
 
   short search_arr_size;     ///< Number of items in search array
   struct TextSyntax *search; ///< Array of search text in the line
@@ -63,9 +65,14 @@ struct Line
   struct QuoteStyle *quote;  ///< Quoting style for this line (pointer into PagerPrivateData->quote_list)
 };
 
+struct Line *lines_new(int count);
+void lines_free(struct Line **ptr, int count);
+
 int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
                  int line_num, int *lines_used, int *lines_max, PagerFlags flags,
                  struct QuoteStyle **quote_list, int *q_level, bool *force_redraw,
                  regex_t *search_re, struct MuttWindow *win_pager, struct AttrColorList *ansi_list);
+void display_search_prefilter(const char *pattern, bool icase);
+void display_search_prefilter_clear(void);
 
 #endif /* MUTT_PAGER_DISPLAY_H */
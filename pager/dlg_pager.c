@@ -318,21 +318,12 @@ int dlg_pager(struct PagerView *pview)
   //---------- initialize redraw pdata  -----------------------------------------
   pview->win_pager->size = MUTT_WIN_SIZE_MAXIMISE;
   priv->lines_max = LINES; // number of lines on screen, from curses
-  priv->lines = mutt_mem_calloc(priv->lines_max, sizeof(struct Line));
+  priv->lines = lines_new(priv->lines_max);
   priv->fp = mutt_file_fopen(pview->pdata->fname, "r");
   priv->has_types = ((pview->mode == PAGER_MODE_EMAIL) || (pview->flags & MUTT_SHOWCOLOR)) ?
                         MUTT_TYPES :
                         0; // main message or rfc822 attachment
 
-  for (size_t i = 0; i < priv->lines_max; i++)
-  {
-    priv->lines[i].cid = -1;
-    priv->lines[i].search_arr_size = -1;
-    priv->lines[i].syntax = mutt_mem_calloc(1, sizeof(struct TextSyntax));
-    (priv->lines[i].syntax)[0].first = -1;
-    (priv->lines[i].syntax)[0].last = -1;
-  }
-
   // ---------- try to open the pdata file -------------------------------------
   if (!priv->fp)
   {
@@ -392,8 +383,8 @@ int dlg_pager(struct PagerView *pview)
       mutt_window_move(priv->pview->win_pbar, priv->pview->win_pager->state.cols - 1, 0);
     }
 
-    // force redraw of the screen at every iteration of the event loop
-    mutt_refresh();
+    /* No flush here: window_redraw() above pushed out any repaint, and a
+     * cursor move on its own is carried by the next getch()'s refresh */
 
     //-------------------------------------------------------------------------
     // Check if information in the status bar needs an update
@@ -570,18 +561,15 @@ int dlg_pager(struct PagerView *pview)
 
   qstyle_free_tree(&priv->quote_list);
 
-  for (size_t i = 0; i < priv->lines_max; i++)
-  {
-    FREE(&(priv->lines[i].syntax));
-    if (priv->search_compiled && priv->lines[i].search)
-      FREE(&(priv->lines[i].search));
-  }
   if (priv->search_compiled)
   {
     regfree(&priv->search_re);
     priv->search_compiled = false;
+    display_search_prefilter_clear();
   }
-  FREE(&priv->lines);
+  lines_free(&priv->lines, priv->lines_max);
+  for (size_t i = 0; i < PAGER_LAYOUT_CACHE_SIZE; i++)
+    lines_free(&priv->layouts[i].lines, priv->layouts[i].lines_max);
   attr_color_list_clear(&priv->ansi_list);
   {
     struct AttrColor *ac = NULL;
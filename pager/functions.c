@@ -380,8 +380,12 @@ bool jump_to_bottom(struct PagerPrivateData *priv, struct PagerView *pview)
     return false;
   }
 
+  /* make sure the types are defined to the end of file - the lines up to
+   * lines_used were already materialized, so resume from the last of them
+   * rather than re-reading everything below the cursor */
   int line_num = priv->cur_line;
-  /* make sure the types are defined to the end of file */
+  if (priv->lines_used > 0)
+    line_num = MAX(line_num, priv->lines_used - 1);
   while (display_line(priv->fp, &priv->bytes_read, &priv->lines, line_num,
                       &priv->lines_used, &priv->lines_max,
                       priv->has_types | (pview->flags & MUTT_PAGER_NOWRAP),
@@ -640,10 +644,12 @@ static int op_pager_search(struct IndexSharedData *shared,
     }
     priv->search_flag = 0;
     priv->search_compiled = false;
+    display_search_prefilter_clear();
   }
   else
   {
     priv->search_compiled = true;
+    display_search_prefilter(priv->search_str, rflags != 0);
     /* update the search pointers */
     int line_num = 0;
     while (display_line(priv->fp, &priv->bytes_read, &priv->lines, line_num,
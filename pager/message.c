@@ -47,6 +47,7 @@
 #include "menu/lib.h"
 #include "ncrypt/lib.h"
 #include "question/lib.h"
+#include "background.h"
 #include "copy.h"
 #include "globals.h"
 #include "hdrline.h"
@@ -259,14 +260,15 @@ static int email_to_file(struct Message *msg, struct Buffer *tempfile,
     mutt_error(_("Could not copy message"));
     if (fp_filter_out)
     {
-      filter_wait(filterpid);
+      background_filter_wait(filterpid);
       mutt_file_fclose(&fp_filter_out);
     }
     mutt_file_unlink(buf_string(tempfile));
     goto cleanup;
   }
 
-  if (fp_filter_out && (filter_wait(filterpid) != 0))
+  /* Poll rather than block, so a slow $display_filter can be aborted */
+  if (fp_filter_out && (background_filter_wait(filterpid) != 0))
     mutt_any_key_to_continue(NULL);
 
   mutt_file_fclose(&fp_filter_out); /* XXX - check result? */
@@ -448,8 +450,11 @@ static void expand_index_panel(struct MuttWindow *win_index, struct MuttWindow *
 int mutt_display_message(struct MuttWindow *win_index, struct IndexSharedData *shared)
 {
   struct MuttWindow *dlg = dialog_find(win_index);
-  struct MuttWindow *win_pager = window_find_child(dlg, WT_CUSTOM);
-  struct MuttWindow *win_pbar = window_find_child(dlg, WT_STATUS_BAR);
+  /* Scope the search to the pager panel: the dialog has other WT_CUSTOM
+   * windows, e.g. the preview pane */
+  struct MuttWindow *panel_pager = window_find_child(dlg, WT_PAGER);
+  struct MuttWindow *win_pager = window_find_child(panel_pager, WT_CUSTOM);
+  struct MuttWindow *win_pbar = window_find_child(panel_pager, WT_STATUS_BAR);
   struct Buffer *tempfile = buf_pool_get();
   struct Message *msg = NULL;
 
@@ -63,6 +63,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include <sys/stat.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -115,6 +116,73 @@ static int config_pager_index_lines(struct MuttWindow *win)
   return 0;
 }
 
+/**
+ * layout_stash - Remember the current line wrapping
+ * @param priv Private Pager data
+ *
+ * Move the current Line array into the layout cache, keyed by the window
+ * width it was wrapped to.  The oldest cached layout makes way if the cache
+ * is full.  Afterwards, PagerPrivateData::lines is NULL.
+ */
+static void layout_stash(struct PagerPrivateData *priv)
+{
+  struct LineLayout *ll = &priv->layouts[PAGER_LAYOUT_CACHE_SIZE - 1];
+  lines_free(&ll->lines, ll->lines_max);
+
+  memmove(&priv->layouts[1], &priv->layouts[0],
+          (PAGER_LAYOUT_CACHE_SIZE - 1) * sizeof(struct LineLayout));
+
+  ll = &priv->layouts[0];
+  ll->cols = priv->flow_cols;
+  ll->flags = priv->flow_flags;
+  ll->lines = priv->lines;
+  ll->lines_used = priv->lines_used;
+  ll->lines_max = priv->lines_max;
+  ll->bytes_read = priv->bytes_read;
+
+  priv->lines = NULL;
+  priv->lines_used = 0;
+}
+
+/**
+ * layout_restore - Fetch a cached line wrapping
+ * @param priv  Private Pager data
+ * @param cols  Window width the lines must be wrapped to
+ * @param flags Flags the lines must have been flowed with
+ * @retval true A cached layout was restored
+ *
+ * Any search highlighting is discarded from the restored lines; the paint
+ * loop recomputes it for the current search.
+ */
+static bool layout_restore(struct PagerPrivateData *priv, short cols, PagerFlags flags)
+{
+  for (int i = 0; i < PAGER_LAYOUT_CACHE_SIZE; i++)
+  {
+    struct LineLayout *ll = &priv->layouts[i];
+    if (!ll->lines || (ll->cols != cols) || (ll->flags != flags))
+      continue;
+
+    priv->lines = ll->lines;
+    priv->lines_used = ll->lines_used;
+    priv->lines_max = ll->lines_max;
+    priv->bytes_read = ll->bytes_read;
+
+    memmove(&priv->layouts[i], &priv->layouts[i + 1],
+            (PAGER_LAYOUT_CACHE_SIZE - 1 - i) * sizeof(struct LineLayout));
+    memset(&priv->layouts[PAGER_LAYOUT_CACHE_SIZE - 1], 0, sizeof(struct LineLayout));
+
+    // The search results belong to whenever the layout was stashed
+    for (int n = 0; n < priv->lines_used; n++)
+    {
+      priv->lines[n].search_arr_size = -1;
+      FREE(&priv->lines[n].search);
+    }
+    return true;
+  }
+
+  return false;
+}
+
 /**
  * pager_recalc - Recalculate the Pager display - Implements MuttWindow::recalc() - @ingroup window_recalc
  */
@@ -140,49 +208,88 @@ static int pager_repaint(struct MuttWindow *win)
   const bool repopulate = (priv->cur_line > priv->lines_used);
   if ((priv->redraw & PAGER_REDRAW_FLOW) || repopulate)
   {
+    bool restored = false;
+    const PagerFlags flags = priv->has_types | priv->search_flag |
+                             (priv->pview->flags & MUTT_PAGER_NOWRAP) |
+                             (priv->pview->flags & MUTT_PAGER_STRIPES);
+
     if (!(priv->pview->flags & MUTT_PAGER_RETWINCH))
     {
+      const short cols = priv->pview->win_pager->state.cols;
       priv->win_height = -1;
       for (int i = 0; i <= priv->top_line; i++)
         if (!priv->lines[i].cont_line)
           priv->win_height++;
-      for (int i = 0; i < priv->lines_max; i++)
+
+      if (!repopulate && (priv->flow_cols > 0) && (cols != priv->flow_cols))
       {
-        priv->lines[i].offset = 0;
-        priv->lines[i].cid = -1;
-        priv->lines[i].cont_line = false;
-        priv->lines[i].syntax_arr_size = 0;
-        priv->lines[i].search_arr_size = -1;
-        priv->lines[i].quote = NULL;
-
-        mutt_mem_realloc(&(priv->lines[i].syntax), sizeof(struct TextSyntax));
-        if (priv->search_compiled && priv->lines[i].search)
-          FREE(&(priv->lines[i].search));
+        // The width changed: keep the old wrapping, we may well be back
+        layout_stash(priv);
+        restored = layout_restore(priv, cols, flags);
+        if (!restored)
+        {
+          priv->lines_max = LINES;
+          priv->lines = lines_new(priv->lines_max);
+          priv->bytes_read = 0;
+        }
       }
 
-      if (!repopulate)
+      if (restored)
       {
-        priv->lines_used = 0;
+        // Put the same part of the message at the top of the screen
         priv->top_line = 0;
+        int j = -1;
+        for (int i = 0; i < priv->lines_used; i++)
+        {
+          if (!priv->lines[i].cont_line && (++j == priv->win_height))
+          {
+            priv->top_line = i;
+            break;
+          }
+        }
       }
+      else
+      {
+        for (int i = 0; i < priv->lines_max; i++)
+        {
+          priv->lines[i].offset = 0;
+          priv->lines[i].cid = -1;
+          priv->lines[i].cont_line = false;
+          priv->lines[i].syntax_arr_size = 0;
+          priv->lines[i].search_arr_size = -1;
+          priv->lines[i].quote = NULL;
+
+          mutt_mem_realloc(&(priv->lines[i].syntax), sizeof(struct TextSyntax));
+          if (priv->search_compiled && priv->lines[i].search)
+            FREE(&(priv->lines[i].search));
+        }
+
+        if (!repopulate)
+        {
+          priv->lines_used = 0;
+          priv->top_line = 0;
+        }
+      }
+      priv->flow_cols = cols;
+      priv->flow_flags = flags;
     }
-    int i = -1;
-    int j = -1;
-    const PagerFlags flags = priv->has_types | priv->search_flag |
-                             (priv->pview->flags & MUTT_PAGER_NOWRAP) |
-                             (priv->pview->flags & MUTT_PAGER_STRIPES);
 
-    while (display_line(priv->fp, &priv->bytes_read, &priv->lines, ++i,
-                        &priv->lines_used, &priv->lines_max, flags, &priv->quote_list,
-                        &priv->q_level, &priv->force_redraw, &priv->search_re,
-                        priv->pview->win_pager, &priv->ansi_list) == 0)
+    if (!restored)
     {
-      if (!priv->lines[i].cont_line && (++j == priv->win_height))
+      int i = -1;
+      int j = -1;
+      while (display_line(priv->fp, &priv->bytes_read, &priv->lines, ++i,
+                          &priv->lines_used, &priv->lines_max, flags, &priv->quote_list,
+                          &priv->q_level, &priv->force_redraw, &priv->search_re,
+                          priv->pview->win_pager, &priv->ansi_list) == 0)
       {
-        if (!repopulate)
-          priv->top_line = i;
-        if (!priv->search_flag)
-          break;
+        if (!priv->lines[i].cont_line && (++j == priv->win_height))
+        {
+          if (!repopulate)
+            priv->top_line = i;
+          if (!priv->search_flag)
+            break;
+        }
       }
     }
   }
@@ -32,8 +32,30 @@
 #include "lib.h"
 #include "color/lib.h"
 
+struct Line;
 struct MuttWindow;
 
+/// Number of recently used line layouts to keep per pager view
+#define PAGER_LAYOUT_CACHE_SIZE 4
+
+/**
+ * struct LineLayout - Cached line wrapping for one window width
+ *
+ * When the width of the Pager window changes, e.g. the Sidebar is toggled or
+ * the terminal is resized, the line wrapping has to be recomputed.  Rather
+ * than throw the old result away, it's kept here, so flipping back to a
+ * recent width doesn't re-wrap the whole message.
+ */
+struct LineLayout
+{
+  short cols;                  ///< Window width the lines were wrapped to
+  PagerFlags flags;            ///< Flags the lines were flowed with
+  struct Line *lines;          ///< Array of text lines in pager
+  int lines_used;              ///< Size of lines array (used entries)
+  int lines_max;               ///< Capacity of lines array (total entries)
+  LOFF_T bytes_read;           ///< Number of bytes read from file
+};
+
 /**
  * struct PagerPrivateData - Private state data for the Pager
  */
@@ -50,6 +72,10 @@ struct PagerPrivateData
   int lines_max;               ///< Capacity of lines array (total entries)
   int cur_line;                ///< Current line (last line visible on screen)
 
+  struct LineLayout layouts[PAGER_LAYOUT_CACHE_SIZE]; ///< Line wrapping for recent window widths
+  short flow_cols;             ///< Window width the current lines are wrapped to
+  PagerFlags flow_flags;       ///< Flags the current lines were flowed with
+
   int old_top_line;            ///< Old top line, used for repainting
   int win_height;              ///< Number of lines in the Window
   int top_line;                ///< First visible line on screen
@@ -27,6 +27,7 @@
  */
 
 #include "config.h"
+#include <stdint.h>
 #include <stdio.h>
 #include "mutt/lib.h"
 #include "core/lib.h"
@@ -76,7 +77,14 @@ enum CommandResult parse_rc_buffer(struct Buffer *line, struct Buffer *token,
       if (mutt_str_equal(token->data, cmd[i].name))
       {
         mutt_debug(LL_DEBUG1, "NT_COMMAND: %s\n", cmd[i].name);
+        const uint64_t start_ms = mutt_date_now_ms();
         rc = cmd[i].parse(token, line, cmd[i].data, err);
+        const uint64_t elapsed_ms = mutt_date_now_ms() - start_ms;
+        if (elapsed_ms > 0)
+        {
+          mutt_debug(LL_DEBUG2, "command '%s' took %llu ms\n", cmd[i].name,
+                     (unsigned long long) elapsed_ms);
+        }
         if ((rc == MUTT_CMD_WARNING) || (rc == MUTT_CMD_ERROR) || (rc == MUTT_CMD_FINISH))
           goto finish; /* Propagate return code */
 
@@ -94,9 +94,7 @@ static bool eat_regex(struct Pattern *pat, PatternCompFlags flags,
   else
   {
     pat->p.regex = mutt_mem_calloc(1, sizeof(regex_t));
-#ifdef USE_DEBUG_GRAPHVIZ
     pat->raw_pattern = mutt_str_dup(buf->data);
-#endif
     uint16_t case_flags = mutt_mb_is_lower(buf->data) ? REG_ICASE : 0;
     int rc2 = REG_COMP(pat->p.regex, buf->data, REG_NEWLINE | REG_NOSUB | case_flags);
     if (rc2 != 0)
@@ -804,9 +802,7 @@ void mutt_pattern_free(struct PatternList **pat)
       FREE(&np->p.regex);
     }
 
-#ifdef USE_DEBUG_GRAPHVIZ
     FREE(&np->raw_pattern);
-#endif
     mutt_pattern_free(&np->child);
     FREE(&np);
 
@@ -1153,3 +1149,129 @@ cleanup:
   buf_pool_release(&ps);
   return NULL;
 }
+
+/**
+ * pattern_cost - Estimate the cost of matching a Pattern
+ * @param pat Pattern to examine
+ * @retval num Cost class, higher is more expensive
+ *
+ * Flag checks are virtually free, string and regex matches cost a little and
+ * anything that has to open the message, or walk its thread, costs a lot.
+ */
+static int pattern_cost(const struct Pattern *pat)
+{
+  if (pat->op < MUTT_PAT_AND)
+    return 0; // Simple flag check, e.g. MUTT_DELETED
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      // A group is as expensive as its dearest member
+      int cost = 0;
+      struct Pattern *p = NULL;
+      SLIST_FOREACH(p, pat->child, entries)
+      {
+        cost = MAX(cost, pattern_cost(p));
+      }
+      return cost;
+    }
+
+    case MUTT_PAT_BROKEN:
+    case MUTT_PAT_COLLAPSED:
+    case MUTT_PAT_CRYPT_ENCRYPT:
+    case MUTT_PAT_CRYPT_SIGN:
+    case MUTT_PAT_CRYPT_VERIFIED:
+    case MUTT_PAT_DATE:
+    case MUTT_PAT_DATE_RECEIVED:
+    case MUTT_PAT_DUPLICATED:
+    case MUTT_PAT_MESSAGE:
+    case MUTT_PAT_PGP_KEY:
+    case MUTT_PAT_SCORE:
+    case MUTT_PAT_SIZE:
+    case MUTT_PAT_UNREFERENCED:
+      return 0; // Flag or number comparison
+
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_MIMEATTACH:
+    case MUTT_PAT_MIMETYPE:
+    case MUTT_PAT_WHOLE_MSG:
+      return 3; // The message has to be opened and read
+
+    case MUTT_PAT_CHILDREN:
+    case MUTT_PAT_PARENT:
+    case MUTT_PAT_THREAD:
+      return 2; // The sub-pattern runs over the whole thread
+
+    default:
+      return 1; // String or regex match on a header
+  }
+}
+
+/**
+ * pattern_sort_cost - Sort a list of Patterns, cheapest first
+ * @param pl Pattern List
+ *
+ * The sort is stable, so equal-cost patterns keep the user's order.
+ */
+static void pattern_sort_cost(struct PatternList *pl)
+{
+  struct PatternList sorted = SLIST_HEAD_INITIALIZER(sorted);
+
+  struct Pattern *p = SLIST_FIRST(pl);
+  while (p)
+  {
+    struct Pattern *next = SLIST_NEXT(p, entries);
+    const int cost = pattern_cost(p);
+
+    // Insert p after the last entry that's no dearer
+    struct Pattern *pos = NULL, *s = NULL;
+    SLIST_FOREACH(s, &sorted, entries)
+    {
+      if (pattern_cost(s) > cost)
+        break;
+      pos = s;
+    }
+
+    if (pos)
+      SLIST_INSERT_AFTER(pos, p, entries);
+    else
+      SLIST_INSERT_HEAD(&sorted, p, entries);
+
+    p = next;
+  }
+
+  *pl = sorted;
+}
+
+/**
+ * mutt_pattern_optimize - Reorder a Pattern for fast matching
+ * @param pat Pattern to optimize
+ *
+ * Reorder the arguments of the logical operations so that the cheap checks
+ * run first and the expensive ones only when the cheap ones didn't already
+ * decide the result.  Matching a pattern has no side effects, so the
+ * reordering isn't observable.
+ *
+ * Use this before matching a pattern against many messages, e.g. for
+ * `<limit>` or `<search>`.
+ */
+void mutt_pattern_optimize(struct PatternList *pat)
+{
+  if (!pat)
+    return;
+
+  struct Pattern *p = NULL;
+  SLIST_FOREACH(p, pat, entries)
+  {
+    if (!p->child)
+      continue;
+
+    mutt_pattern_optimize(p->child);
+
+    if ((p->op == MUTT_PAT_AND) || (p->op == MUTT_PAT_OR))
+      pattern_sort_cost(p->child);
+  }
+}
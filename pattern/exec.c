@@ -31,6 +31,10 @@
  */
 
 #include "config.h"
+#include <limits.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include <stdarg.h> // IWYU pragma: keep
 #include <stdbool.h>
 #include <stdio.h>
@@ -54,6 +58,7 @@
 #include "handler.h"
 #include "maillist.h"
 #include "mx.h"
+#include "trigram.h"
 #ifndef USE_FMEMOPEN
 #include <sys/stat.h>
 #endif
@@ -290,6 +295,275 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
   return match;
 }
 
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * struct PatternSearchWorker - State for one message-search thread
+ */
+struct PatternSearchWorker
+{
+  pthread_t thread;      ///< Worker thread handle
+  struct Pattern *pat;   ///< Message-search Pattern to match
+  const char *folder;    ///< Path to the Mailbox
+  struct Email **emails; ///< Shared array of messages to search
+  int num_emails;        ///< Number of messages in the array
+  int begin;             ///< First index this worker searches
+  int step;              ///< Stride between indices
+  const uint32_t *tris;  ///< Trigrams the Pattern's matches must contain
+  int num_tris;          ///< Number of entries in tris; 0 disables the prefilter
+};
+
+/**
+ * pattern_search_thread - Search a shard of a Mailbox - Worker thread
+ * @param arg PatternSearchWorker state
+ * @retval NULL Always
+ *
+ * Run the raw search from msg_search() over every step'th message, starting
+ * at begin, recording the result in Email::matched.  Messages whose file
+ * can't be opened are recorded as non-matching, like the serial path.
+ *
+ * The Buffer pool and the error display aren't thread-safe, so this sticks to
+ * stack buffers and plain stdio.
+ */
+static void *pattern_search_thread(void *arg)
+{
+  struct PatternSearchWorker *w = arg;
+  struct Pattern *pat = w->pat;
+  char fn[PATH_MAX] = { 0 };
+
+  const bool needs_head = (pat->op == MUTT_PAT_HEADER) || (pat->op == MUTT_PAT_WHOLE_MSG);
+  const bool needs_body = (pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_WHOLE_MSG);
+
+  for (int i = w->begin; i < w->num_emails; i += w->step)
+  {
+    struct Email *e = w->emails[i];
+    if (!e || !e->body)
+      continue;
+
+    e->matched = false;
+
+    bool have_sig = false;
+    if (w->num_tris > 0)
+    {
+      unsigned char sig[TRIGRAM_SIG_LEN];
+      have_sig = trigram_index_get(e->path, e->body->length, needs_head, sig);
+      if (have_sig && !trigram_sig_match(sig, w->tris, w->num_tris))
+        continue; /* the message provably can't contain the literal */
+    }
+
+    snprintf(fn, sizeof(fn), "%s/%s", w->folder, e->path);
+    FILE *fp = fopen(fn, "r");
+    if (!fp)
+      continue;
+
+    long len = 0;
+    if (needs_head)
+      len = e->body->offset - e->offset;
+    if (needs_body)
+      len += e->body->length;
+
+    if (fseeko(fp, needs_head ? e->offset : e->body->offset, SEEK_SET) != 0)
+    {
+      fclose(fp);
+      continue;
+    }
+
+    bool match = false;
+    if (pat->op == MUTT_PAT_HEADER)
+    {
+      struct Buffer buf = { 0 };
+      while (len > 0)
+      {
+        if (mutt_rfc822_read_line(fp, &buf) == 0)
+        {
+          break;
+        }
+        len -= buf_len(&buf);
+        if (patmatch(pat, buf_string(&buf)))
+        {
+          match = true;
+          break;
+        }
+      }
+      buf_dealloc(&buf);
+    }
+    else
+    {
+      /* The search is reading the whole text anyway, so build the trigram
+       * signature as a by-product - unless a match cuts the read short.  */
+      struct TrigramStream ts;
+      const bool build_sig = (w->num_tris > 0) && !have_sig;
+      if (build_sig)
+        trigram_stream_init(&ts);
+
+      char buf[1024] = { 0 };
+      while (len > 0)
+      {
+        if (!fgets(buf, sizeof(buf), fp))
+        {
+          break; /* don't loop forever */
+        }
+        const size_t blen = mutt_str_len(buf);
+        len -= blen;
+        if (build_sig)
+          trigram_stream_add(&ts, buf, blen);
+        if (patmatch(pat, buf))
+        {
+          match = true;
+          break;
+        }
+      }
+
+      if (build_sig && !match)
+        trigram_index_put(e->path, e->body->length, needs_head, ts.sig);
+    }
+
+    e->matched = match;
+    fclose(fp);
+  }
+
+  return NULL;
+}
+
+/**
+ * prescan_find_pattern - Find the only message-search Pattern in a tree
+ * @param[in]  pats  Pattern tree to search
+ * @param[out] found The message-search Pattern, if any
+ * @retval num Number of message-search Patterns found
+ *
+ * Only the logical operators are descended into.  Patterns under the thread
+ * operators run against messages other than the one being matched, so they
+ * are left for msg_search() and don't count against the total.
+ */
+static int prescan_find_pattern(struct PatternList *pats, struct Pattern **found)
+{
+  int count = 0;
+
+  struct Pattern *pat = NULL;
+  SLIST_FOREACH(pat, pats, entries)
+  {
+    if ((pat->op == MUTT_PAT_AND) || (pat->op == MUTT_PAT_OR))
+    {
+      count += prescan_find_pattern(pat->child, found);
+    }
+    else if ((pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_HEADER) ||
+             (pat->op == MUTT_PAT_WHOLE_MSG))
+    {
+      if (!pat->sendmode)
+      {
+        *found = pat;
+        count++;
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * mutt_pattern_prescan - Run a message search across a Mailbox in parallel
+ * @param pats       Compiled Pattern
+ * @param m          Mailbox
+ * @param emails     Array of Emails the caller is about to match
+ * @param num_emails Number of Emails in the array
+ *
+ * When a Pattern contains exactly one body, header or whole-message search
+ * and the Mailbox keeps one file per message, nearly all the matching time is
+ * msg_search() reading each file.  The raw search only needs the message file
+ * and the shared, read-only pattern data, so it can be sharded across a pool
+ * of worker threads, sized by $maildir_scan_threads.  The results land in
+ * Email::matched and are picked up by pattern_exec(), like the IMAP
+ * server-side search.
+ *
+ * Decoded searches ($thorough_search) use the charset and MIME machinery,
+ * which isn't thread-safe, so they stay on the serial path.
+ */
+void mutt_pattern_prescan(struct PatternList *pats, struct Mailbox *m,
+                          struct Email **emails, int num_emails)
+{
+  if (!pats || !m || !emails)
+    return;
+
+  // One file per message, read with plain stdio
+  if ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH))
+    return;
+
+  const bool c_thorough_search = cs_subset_bool(NeoMutt->sub, "thorough_search");
+  if (c_thorough_search)
+    return;
+
+  const short c_maildir_scan_threads = cs_subset_number(NeoMutt->sub, "maildir_scan_threads");
+  if ((c_maildir_scan_threads < 2) || (num_emails < c_maildir_scan_threads))
+    return;
+
+  struct Pattern *pat = NULL;
+  if ((prescan_find_pattern(pats, &pat) != 1) || !pat)
+    return;
+
+  /* If the Pattern requires a literal, messages whose trigram signature lacks
+   * it are skipped without being opened.  Header-only searches are cheap and
+   * aren't covered by the signatures.  */
+  uint32_t tris[TRIGRAM_QUERY_MAX] = { 0 };
+  int num_tris = 0;
+  if ((pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_WHOLE_MSG))
+  {
+    const char *text = pat->string_match ? pat->p.str : pat->raw_pattern;
+    num_tris = trigram_extract(text, !pat->string_match, tris, TRIGRAM_QUERY_MAX);
+    if (num_tris > 0)
+      trigram_index_open(m, (pat->op == MUTT_PAT_WHOLE_MSG), emails, num_emails);
+  }
+
+  int num_workers = c_maildir_scan_threads;
+  struct PatternSearchWorker *workers = mutt_mem_calloc(num_workers,
+                                                        sizeof(struct PatternSearchWorker));
+
+  int num_running = 0;
+  for (int i = 0; i < num_workers; i++)
+  {
+    workers[i].pat = pat;
+    workers[i].folder = mailbox_path(m);
+    workers[i].emails = emails;
+    workers[i].num_emails = num_emails;
+    workers[i].begin = i;
+    workers[i].step = num_workers;
+    workers[i].tris = tris;
+    workers[i].num_tris = num_tris;
+    if (pthread_create(&workers[i].thread, NULL, pattern_search_thread, &workers[i]) != 0)
+      break;
+    num_running++;
+  }
+
+  if (num_running == 0)
+  {
+    // Couldn't start any workers, fall back to the serial path
+    FREE(&workers);
+    return;
+  }
+
+  // Search any shards whose worker failed to start
+  for (int i = num_running; i < num_workers; i++)
+  {
+    workers[i].pat = pat;
+    workers[i].folder = mailbox_path(m);
+    workers[i].emails = emails;
+    workers[i].num_emails = num_emails;
+    workers[i].begin = i;
+    workers[i].step = num_workers;
+    workers[i].tris = tris;
+    workers[i].num_tris = num_tris;
+    pattern_search_thread(&workers[i]);
+  }
+
+  for (int i = 0; i < num_running; i++)
+    pthread_join(workers[i].thread, NULL);
+  FREE(&workers);
+
+  if (num_tris > 0)
+    trigram_index_sync();
+
+  pat->prescanned = true;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
 /**
  * perform_and - Perform a logical AND on a set of Patterns
  * @param pat   Patterns to test
@@ -808,6 +1082,8 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
 
   if ((pat->op == MUTT_PAT_WHOLE_MSG) || (pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_HEADER))
   {
+    if (pat->prescanned)
+      return false;
     return !((m->type == MUTT_IMAP) && pat->string_match);
   }
 
@@ -908,6 +1184,9 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       /* IMAP search sets e->matched at search compile time */
       if ((m->type == MUTT_IMAP) && pat->string_match)
         return e->matched;
+      /* A parallel prescan sets e->matched before the serial loop */
+      if (pat->prescanned)
+        return pat->pat_not ^ e->matched;
       return pat->pat_not ^ msg_search(pat, e, msg);
     case MUTT_PAT_SERVERSEARCH:
       if (!m)
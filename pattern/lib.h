@@ -85,6 +85,7 @@ struct Pattern
   bool dynamic      : 1;         ///< Evaluate date ranges at run time
   bool sendmode     : 1;         ///< Evaluate searches in send-mode
   bool is_multi     : 1;         ///< Multiple case (only for ~I pattern now)
+  bool prescanned   : 1;         ///< Message search already ran; result is in Email::matched
   long min;                      ///< Minimum for range checks
   long max;                      ///< Maximum for range checks
   struct PatternList *child;     ///< Arguments to logical operation
@@ -94,9 +95,7 @@ struct Pattern
     char *str;                   ///< String, if string_match is set
     struct ListHead multi_cases; ///< Multiple strings for ~I pattern
   } p;
-#ifdef USE_DEBUG_GRAPHVIZ
-  const char *raw_pattern;
-#endif
+  const char *raw_pattern;       ///< Source text of a regex pattern
   SLIST_ENTRY(Pattern) entries;  ///< Linked list
 };
 SLIST_HEAD(PatternList, Pattern);
@@ -180,14 +179,36 @@ enum PatternType
   MUTT_PAT_MAX,
 };
 
+/**
+ * struct PatternMatches - Cached results of a full pattern match
+ *
+ * One bit per Email, indexed by the Email's position in Mailbox.emails[].
+ * The results stay valid while MailboxView::change_seq is unchanged, so
+ * running `<limit>` and then `<tag-pattern>` or `<search>` with the same
+ * pattern reuses the bitmap instead of re-matching every message.
+ */
+struct PatternMatches
+{
+  char *pattern;       ///< Expanded pattern string the results belong to
+  unsigned int seq;    ///< MailboxView::change_seq when the results were computed
+  int msg_count;       ///< Number of Emails covered
+  unsigned char *bits; ///< One bit per Email, set if it matched
+};
+
 bool mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m,
                        struct Email *e, struct PatternCache *cache);
 bool mutt_pattern_alias_exec(struct Pattern *pat, PatternExecFlags flags,
                              struct AliasView *av, struct PatternCache *cache);
 
 struct PatternList *mutt_pattern_comp(struct MailboxView *mv, struct Menu *menu, const char *s, PatternCompFlags flags, struct Buffer *err);
+void mutt_pattern_optimize(struct PatternList *pat);
+#ifdef HAVE_PTHREAD_CREATE
+void mutt_pattern_prescan(struct PatternList *pats, struct Mailbox *m, struct Email **emails, int num_emails);
+void trigram_index_cleanup(void);
+#endif
 void mutt_check_simple(struct Buffer *s, const char *simple);
 void mutt_pattern_free(struct PatternList **pat);
+void mutt_pattern_matches_free(struct PatternMatches **ptr);
 bool dlg_pattern(char *buf, size_t buflen);
 
 bool mutt_is_list_recipient(bool all_addr, struct Envelope *env);
@@ -196,6 +217,7 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt);
 int mutt_pattern_alias_func(char *prompt, struct AliasMenuData *mdata, struct Menu *menu);
 int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
                         struct SearchState *state, SearchFlags flags);
+bool mutt_search_step(struct MailboxView *mv, struct SearchState *state);
 int mutt_search_alias_command(struct Menu *menu, int cur,
                               struct SearchState *state, SearchFlags flags);
 
@@ -33,6 +33,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -46,6 +47,7 @@
 #include "editor/lib.h"
 #include "history/lib.h"
 #include "imap/lib.h"
+#include "key/lib.h"
 #include "menu/lib.h"
 #include "progress/lib.h"
 #include "mutt_logging.h"
@@ -278,6 +280,37 @@ bail:
   return rc;
 }
 
+/**
+ * mutt_pattern_matches_free - Free a PatternMatches bitmap
+ * @param ptr PatternMatches to free
+ */
+void mutt_pattern_matches_free(struct PatternMatches **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct PatternMatches *pm = *ptr;
+
+  FREE(&pm->pattern);
+  FREE(&pm->bits);
+  FREE(ptr);
+}
+
+/**
+ * pattern_matches_valid - Do cached match results apply?
+ * @param mv      Mailbox View
+ * @param pattern Expanded pattern string
+ * @retval true The cached bitmap was computed for this pattern and the Mailbox hasn't changed since
+ */
+static bool pattern_matches_valid(struct MailboxView *mv, const char *pattern)
+{
+  struct PatternMatches *pm = mv->matches;
+
+  return pm && (pm->seq == mv->change_seq) &&
+         (pm->msg_count == mv->mailbox->msg_count) &&
+         mutt_str_equal(pm->pattern, pattern);
+}
+
 /**
  * mutt_pattern_func - Perform some Pattern matching
  * @param mv     Mailbox View
@@ -298,6 +331,7 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
   struct Progress *progress = NULL;
   struct Buffer *buf = buf_pool_get();
   bool interrupted = false;
+  unsigned char *bits = NULL;
 
   buf_strcpy(buf, mv->pattern);
   if (prompt || (op != MUTT_LIMIT))
@@ -327,9 +361,30 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
     mutt_error("%s", buf_string(err));
     goto bail;
   }
+  mutt_pattern_optimize(pat);
 
-  if ((m->type == MUTT_IMAP) && (!imap_search(m, pat)))
-    goto bail;
+  /* e.g. `<limit>` then `<tag-pattern>` with the same pattern reuses the
+   * results of the first run */
+  const bool cached = !match_all && pattern_matches_valid(mv, buf_string(buf));
+  if (cached)
+  {
+    mutt_debug(LL_DEBUG2, "reusing cached matches for %s\n", buf_string(buf));
+  }
+  else
+  {
+    if ((m->type == MUTT_IMAP) && (!imap_search(m, pat)))
+      goto bail;
+
+#ifdef HAVE_PTHREAD_CREATE
+    /* message searches can be sharded across worker threads up-front */
+    if (!match_all)
+      mutt_pattern_prescan(pat, m, m->emails, m->msg_count);
+#endif
+
+    /* the limit walks every message, so its results are worth keeping */
+    if (!match_all && (op == MUTT_LIMIT))
+      bits = mutt_mem_calloc((m->msg_count / 8) + 1, sizeof(unsigned char));
+  }
 
   progress = progress_new(MUTT_PROGRESS_READ, (op == MUTT_LIMIT) ? m->msg_count : m->vcount);
   progress_set_message(progress, _("Executing command on matching messages..."));
@@ -361,8 +416,23 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
       e->collapsed = false;
       e->num_hidden = 0;
 
-      if (match_all ||
-          mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      bool matched;
+      if (match_all)
+      {
+        matched = true;
+      }
+      else if (cached)
+      {
+        matched = mv->matches->bits[i / 8] & (1 << (i % 8));
+      }
+      else
+      {
+        matched = mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL);
+        if (matched && bits)
+          bits[i / 8] |= (1 << (i % 8));
+      }
+
+      if (matched)
       {
         e->vnum = m->vcount;
         e->visible = true;
@@ -388,7 +458,17 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
         break;
       }
       progress_update(progress, i, -1);
-      if (mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      bool matched;
+      if (cached)
+      {
+        const int r = m->v2r[i];
+        matched = mv->matches->bits[r / 8] & (1 << (r % 8));
+      }
+      else
+      {
+        matched = mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL);
+      }
+      if (matched)
       {
         switch (op)
         {
@@ -411,6 +491,18 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
 
   mutt_clear_error();
 
+  if (bits && !interrupted)
+  {
+    mutt_pattern_matches_free(&mv->matches);
+    struct PatternMatches *pm = mutt_mem_calloc(1, sizeof(struct PatternMatches));
+    pm->pattern = buf_strdup(buf);
+    pm->seq = mv->change_seq;
+    pm->msg_count = m->msg_count;
+    pm->bits = bits;
+    bits = NULL;
+    mv->matches = pm;
+  }
+
   if (op == MUTT_LIMIT)
   {
     /* drop previous limit pattern */
@@ -438,6 +530,7 @@ bail:
   buf_pool_release(&buf);
   buf_pool_release(&err);
   FREE(&simple);
+  FREE(&bits);
   mutt_pattern_free(&pat);
 
   return rc;
@@ -494,6 +587,7 @@ int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
     struct Buffer *err = buf_pool_get();
     state->pattern = mutt_pattern_comp(mv, menu, state->string_expn->data,
                                        MUTT_PC_FULL_MSG, err);
+    mutt_pattern_optimize(state->pattern);
     pattern_changed = true;
     if (!state->pattern)
     {
@@ -509,10 +603,24 @@ int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
 
   if (pattern_changed)
   {
+    /* a cached limit/tag bitmap for the same pattern answers the search too */
+    const bool seeded = pattern_matches_valid(mv, buf_string(state->string_expn));
+    const unsigned char *bits = seeded ? mv->matches->bits : NULL;
     for (int i = 0; i < m->msg_count; i++)
-      m->emails[i]->searched = false;
-    if ((m->type == MUTT_IMAP) && (!imap_search(m, state->pattern)))
+    {
+      struct Email *e = m->emails[i];
+      e->searched = seeded;
+      e->matched = bits && (bits[i / 8] & (1 << (i % 8)));
+    }
+    if (!seeded && (m->type == MUTT_IMAP) && (!imap_search(m, state->pattern)))
       return -1;
+
+#ifdef HAVE_PTHREAD_CREATE
+    /* a cold cache means the walk below may open every message - shard the
+     * raw matching across workers where the mailbox format allows it */
+    if (!seeded)
+      mutt_pattern_prescan(state->pattern, m, m->emails, m->msg_count);
+#endif
   }
 
   int incr = state->reverse ? -1 : 1;
@@ -593,6 +701,14 @@ int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
       goto done;
     }
 
+    /* a keypress (e.g. Esc) aborts the search too; the messages marked so
+     * far are kept, so repeating the search resumes where this one stopped */
+    if (((j & 0x3f) == 0x3f) && mutt_input_pending(GETCH_IGNORE_MACRO))
+    {
+      mutt_error(_("Search interrupted"));
+      goto done;
+    }
+
     i += incr;
   }
 
@@ -602,6 +718,50 @@ done:
   return rc;
 }
 
+/**
+ * mutt_search_step - Continue marking search matches between keypresses
+ * @param mv    Mailbox view being searched
+ * @param state Current search state
+ * @retval true More messages remain to be searched
+ *
+ * mutt_search_command() stops at the first hit, leaving the rest of the
+ * mailbox unevaluated.  Calling this on each input timeout streams the scan
+ * onwards in bounded slices, so by the time the user asks for the next match
+ * the answer is usually already cached in Email::searched / Email::matched.
+ * A slice ends early if the user starts typing.
+ */
+bool mutt_search_step(struct MailboxView *mv, struct SearchState *state)
+{
+  struct Mailbox *m = mv ? mv->mailbox : NULL;
+  if (!m || !state || !state->pattern)
+    return false;
+
+  const uint64_t deadline = mutt_date_now_ms() + 50;
+  int budget = 128;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (e->searched)
+      continue;
+
+    if ((budget == 0) || (mutt_date_now_ms() >= deadline) ||
+        mutt_input_pending(GETCH_NO_FLAGS))
+    {
+      return true;
+    }
+    budget--;
+
+    e->searched = true;
+    e->matched = mutt_pattern_exec(SLIST_FIRST(state->pattern),
+                                   MUTT_MATCH_FULL_ADDRESS, m, e, NULL);
+  }
+
+  return false;
+}
+
 /**
  * mutt_search_alias_command - Perform a search
  * @param menu  Menu to search through
@@ -649,6 +809,7 @@ int mutt_search_alias_command(struct Menu *menu, int cur,
     struct Buffer *err = buf_pool_get();
     state->pattern = mutt_pattern_comp(NULL, menu, state->string_expn->data,
                                        MUTT_PC_FULL_MSG, err);
+    mutt_pattern_optimize(state->pattern);
     pattern_changed = true;
     if (!state->pattern)
     {
@@ -0,0 +1,435 @@
+/**
+ * @file
+ * Trigram prefilter for message searches
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_trigram Trigram prefilter for message searches
+ *
+ * A body search (~b, ~B) has to read every message in the Mailbox.  Most
+ * messages don't match, and for those a cheap summary of the body is enough to
+ * prove it: a Bloom filter over the trigrams (three-byte windows, lowercased)
+ * of the raw text.  If the Pattern requires a literal of three bytes or more,
+ * a message whose signature lacks one of the literal's trigrams can't match
+ * and is skipped without being opened.
+ *
+ * Signatures are built as a by-product of the first search, kept per Mailbox
+ * in memory, and persisted in the header cache when one is configured, so
+ * later searches prefilter the whole archive.  A message whose body changes
+ * fails the signature's validator and is simply re-read - the index needs no
+ * explicit invalidation on sync.
+ *
+ * The filter is conservative: it only ever skips messages that provably can't
+ * match, so patterns it can't extract a literal from just search every
+ * message, as before.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <limits.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "trigram.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
+
+/**
+ * trigram_code - Pack three bytes of text into a trigram
+ * @param c1 First byte
+ * @param c2 Second byte
+ * @param c3 Third byte
+ * @retval num Trigram code
+ *
+ * The bytes are lowercased so the signature is case-insensitive.  Matching
+ * case-sensitive patterns against it can only err towards false positives,
+ * which the full search then rejects.
+ */
+static uint32_t trigram_code(unsigned char c1, unsigned char c2, unsigned char c3)
+{
+  return ((uint32_t) tolower(c1) << 16) | ((uint32_t) tolower(c2) << 8) |
+         (uint32_t) tolower(c3);
+}
+
+/**
+ * trigram_sig_set - Set a trigram's bits in a signature
+ * @param sig  Signature to update
+ * @param code Trigram code
+ *
+ * Each trigram sets two bits, which keeps the false positive rate low without
+ * needing a second hash function.
+ */
+static void trigram_sig_set(unsigned char *sig, uint32_t code)
+{
+  const uint32_t h = code * 2654435761u;
+  const uint32_t b1 = h & (TRIGRAM_SIG_BITS - 1);
+  const uint32_t b2 = (h >> 16) & (TRIGRAM_SIG_BITS - 1);
+
+  sig[b1 >> 3] |= 1 << (b1 & 7);
+  sig[b2 >> 3] |= 1 << (b2 & 7);
+}
+
+/**
+ * trigram_extract - Get the trigrams a Pattern's matches must contain
+ * @param[in]  s        Pattern text
+ * @param[in]  is_regex Text is a regex, not a plain string
+ * @param[out] tris     Array for the trigrams
+ * @param[in]  max      Size of the array
+ * @retval num Number of trigrams extracted
+ * @retval 0   No usable literal; the Pattern can't be prefiltered
+ *
+ * For a plain string the whole text is required.  For a regex, find the
+ * longest run of characters that must appear literally in any match: runs end
+ * at metacharacters, a quantifier discards the (possibly optional) character
+ * before it, and an alternation anywhere makes no literal required at all.
+ */
+int trigram_extract(const char *s, bool is_regex, uint32_t *tris, int max)
+{
+  if (!s || !tris || (max < 1))
+    return 0;
+
+  char lit[256] = { 0 };
+  size_t lit_len = 0;
+
+  if (is_regex)
+  {
+    if (strchr(s, '|'))
+      return 0;
+
+    char run[256] = { 0 };
+    size_t run_len = 0;
+    for (const char *p = s;; p++)
+    {
+      const char c = *p;
+      if ((c != '\0') && !strchr(".[]()*+?{}^$\\", c))
+      {
+        if (run_len < (sizeof(run) - 1))
+          run[run_len++] = c;
+        continue;
+      }
+
+      /* a quantifier makes the preceding character optional or repeated */
+      if (((c == '*') || (c == '+') || (c == '?') || (c == '{')) && (run_len > 0))
+        run_len--;
+
+      if (run_len > lit_len)
+      {
+        memcpy(lit, run, run_len);
+        lit_len = run_len;
+      }
+      run_len = 0;
+
+      if (c == '\0')
+        break;
+      if ((c == '\\') && (p[1] != '\0'))
+        p++; /* skip the escaped char; it may be a class like \w */
+    }
+  }
+  else
+  {
+    lit_len = MIN(mutt_str_len(s), sizeof(lit) - 1);
+    memcpy(lit, s, lit_len);
+  }
+
+  if (lit_len < 3)
+    return 0;
+
+  int num = 0;
+  for (size_t i = 0; ((i + 3) <= lit_len) && (num < max); i++)
+    tris[num++] = trigram_code(lit[i], lit[i + 1], lit[i + 2]);
+
+  return num;
+}
+
+/**
+ * trigram_stream_init - Start building a trigram signature
+ * @param ts Stream to initialise
+ */
+void trigram_stream_init(struct TrigramStream *ts)
+{
+  memset(ts, 0, sizeof(*ts));
+}
+
+/**
+ * trigram_stream_add - Add a chunk of text to a trigram signature
+ * @param ts   Stream to update
+ * @param data Text to add
+ * @param len  Length of the text
+ */
+void trigram_stream_add(struct TrigramStream *ts, const char *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    ts->window = ((ts->window << 8) |
+                  (uint32_t) tolower((unsigned char) data[i])) &
+                 0xffffff;
+    if (++ts->seen >= 3)
+      trigram_sig_set(ts->sig, ts->window);
+  }
+}
+
+/**
+ * trigram_sig_match - Could a signature's text contain the required trigrams?
+ * @param sig  Signature to check
+ * @param tris Required trigrams
+ * @param num  Number of required trigrams
+ * @retval true  All trigrams may be present; the text must be searched
+ * @retval false Some trigram is definitely absent; the text can't match
+ */
+bool trigram_sig_match(const unsigned char *sig, const uint32_t *tris, int num)
+{
+  for (int i = 0; i < num; i++)
+  {
+    const uint32_t h = tris[i] * 2654435761u;
+    const uint32_t b1 = h & (TRIGRAM_SIG_BITS - 1);
+    const uint32_t b2 = (h >> 16) & (TRIGRAM_SIG_BITS - 1);
+
+    if (!(sig[b1 >> 3] & (1 << (b1 & 7))) || !(sig[b2 >> 3] & (1 << (b2 & 7))))
+      return false;
+  }
+
+  return true;
+}
+
+#ifdef HAVE_PTHREAD_CREATE
+
+/**
+ * struct TrigramEntry - Cached signature of one message
+ */
+struct TrigramEntry
+{
+  size_t vlen;                        ///< Validator: Body length when the signature was built
+  bool whole;                         ///< Signature covers the header too (~B)
+  bool dirty;                         ///< Not yet written to the header cache
+  unsigned char sig[TRIGRAM_SIG_LEN]; ///< The message's signature
+};
+
+#ifdef USE_HCACHE
+/**
+ * struct TrigramRecord - On-disk form of a TrigramEntry
+ */
+struct TrigramRecord
+{
+  uint32_t vlen;                      ///< Validator: Body length when the signature was built
+  uint8_t whole;                      ///< Signature covers the header too (~B)
+  unsigned char sig[TRIGRAM_SIG_LEN]; ///< The message's signature
+};
+#endif
+
+/// Mailbox the signature index belongs to (Mailbox::realpath)
+static char *IndexFolder = NULL;
+/// Signature index: relative message path -> TrigramEntry
+static struct HashTable *IndexSigs = NULL;
+/// Guards the index; the search worker threads read and write it concurrently
+static pthread_mutex_t IndexMutex = PTHREAD_MUTEX_INITIALIZER;
+#ifdef USE_HCACHE
+/// Connection to the Mailbox's header cache, for persisted signatures
+static struct HeaderCache *IndexHc = NULL;
+#endif
+
+/**
+ * index_entry_free - Free a TrigramEntry - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void index_entry_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * trigram_index_open - Point the signature index at a Mailbox
+ * @param m          Mailbox about to be searched
+ * @param whole      Search covers the header too (~B)
+ * @param emails     Messages about to be searched
+ * @param num_emails Number of messages
+ *
+ * Switching Mailbox drops the old index.  When a header cache is configured,
+ * persisted signatures for the given messages are loaded, so an archive
+ * searched in an earlier session prefilters immediately.
+ */
+void trigram_index_open(struct Mailbox *m, bool whole, struct Email **emails, int num_emails)
+{
+  pthread_mutex_lock(&IndexMutex);
+
+  if (!mutt_str_equal(IndexFolder, m->realpath))
+  {
+    mutt_hash_free(&IndexSigs);
+#ifdef USE_HCACHE
+    hcache_close(&IndexHc);
+#endif
+    mutt_str_replace(&IndexFolder, m->realpath);
+  }
+
+  if (!IndexSigs)
+  {
+    IndexSigs = mutt_hash_new(MAX(num_emails, 64), MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(IndexSigs, index_entry_free, 0);
+  }
+
+#ifdef USE_HCACHE
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+  if (!IndexHc && c_header_cache)
+    IndexHc = hcache_open(c_header_cache, mailbox_path(m), NULL, true, m->readonly);
+
+  if (IndexHc)
+  {
+    char key[PATH_MAX] = { 0 };
+    for (int i = 0; i < num_emails; i++)
+    {
+      struct Email *e = emails[i];
+      if (!e || !e->body || !e->path || mutt_hash_find(IndexSigs, e->path))
+        continue;
+
+      const int keylen = snprintf(key, sizeof(key), "%s/3gram", e->path);
+      struct TrigramRecord rec = { 0 };
+      if (!hcache_fetch_raw_obj(IndexHc, key, keylen, &rec))
+        continue;
+      if ((rec.vlen != (uint32_t) e->body->length) || (rec.whole != (uint8_t) whole))
+        continue;
+
+      struct TrigramEntry *entry = mutt_mem_calloc(1, sizeof(struct TrigramEntry));
+      entry->vlen = rec.vlen;
+      entry->whole = rec.whole;
+      memcpy(entry->sig, rec.sig, sizeof(entry->sig));
+      mutt_hash_insert(IndexSigs, e->path, entry);
+    }
+  }
+#endif
+
+  pthread_mutex_unlock(&IndexMutex);
+}
+
+/**
+ * trigram_index_get - Look up a message's signature
+ * @param[in]  path  Message path, relative to the Mailbox
+ * @param[in]  vlen  Expected Body length
+ * @param[in]  whole Signature must cover the header too (~B)
+ * @param[out] sig   Copy of the signature, #TRIGRAM_SIG_LEN bytes
+ * @retval true A current signature was found
+ */
+bool trigram_index_get(const char *path, size_t vlen, bool whole, unsigned char *sig)
+{
+  bool rc = false;
+
+  pthread_mutex_lock(&IndexMutex);
+  struct TrigramEntry *entry = IndexSigs ? mutt_hash_find(IndexSigs, path) : NULL;
+  if (entry && (entry->vlen == vlen) && (entry->whole == whole))
+  {
+    memcpy(sig, entry->sig, TRIGRAM_SIG_LEN);
+    rc = true;
+  }
+  pthread_mutex_unlock(&IndexMutex);
+
+  return rc;
+}
+
+/**
+ * trigram_index_put - Record a message's signature
+ * @param path  Message path, relative to the Mailbox
+ * @param vlen  Body length the signature was built from
+ * @param whole Signature covers the header too (~B)
+ * @param sig   The signature, #TRIGRAM_SIG_LEN bytes
+ *
+ * The signature is kept in memory; trigram_index_sync() writes it out.
+ */
+void trigram_index_put(const char *path, size_t vlen, bool whole, const unsigned char *sig)
+{
+  pthread_mutex_lock(&IndexMutex);
+  if (IndexSigs)
+  {
+    struct TrigramEntry *entry = mutt_hash_find(IndexSigs, path);
+    if (!entry)
+    {
+      entry = mutt_mem_calloc(1, sizeof(struct TrigramEntry));
+      mutt_hash_insert(IndexSigs, path, entry);
+    }
+    entry->vlen = vlen;
+    entry->whole = whole;
+    entry->dirty = true;
+    memcpy(entry->sig, sig, TRIGRAM_SIG_LEN);
+  }
+  pthread_mutex_unlock(&IndexMutex);
+}
+
+/**
+ * trigram_index_sync - Write new signatures to the header cache
+ *
+ * Called from the main thread after a search; the store backends aren't
+ * expected to be thread-safe.
+ */
+void trigram_index_sync(void)
+{
+#ifdef USE_HCACHE
+  pthread_mutex_lock(&IndexMutex);
+  if (IndexHc && IndexSigs)
+  {
+    char key[PATH_MAX] = { 0 };
+    struct HashWalkState state = { 0 };
+    struct HashElem *he = NULL;
+    while ((he = mutt_hash_walk(IndexSigs, &state)))
+    {
+      struct TrigramEntry *entry = he->data;
+      if (!entry->dirty)
+        continue;
+
+      struct TrigramRecord rec = { 0 };
+      rec.vlen = entry->vlen;
+      rec.whole = entry->whole;
+      memcpy(rec.sig, entry->sig, sizeof(rec.sig));
+
+      const int keylen = snprintf(key, sizeof(key), "%s/3gram", he->key.strkey);
+      hcache_store_raw(IndexHc, key, keylen, &rec, sizeof(rec));
+      entry->dirty = false;
+    }
+  }
+  pthread_mutex_unlock(&IndexMutex);
+#endif
+}
+
+/**
+ * trigram_index_cleanup - Free the signature index
+ */
+void trigram_index_cleanup(void)
+{
+  pthread_mutex_lock(&IndexMutex);
+  mutt_hash_free(&IndexSigs);
+  FREE(&IndexFolder);
+#ifdef USE_HCACHE
+  hcache_close(&IndexHc);
+#endif
+  pthread_mutex_unlock(&IndexMutex);
+}
+
+#else /* HAVE_PTHREAD_CREATE */
+
+/**
+ * trigram_index_cleanup - Free the signature index
+ */
+void trigram_index_cleanup(void)
+{
+}
+
+#endif /* HAVE_PTHREAD_CREATE */
@@ -0,0 +1,63 @@
+/**
+ * @file
+ * Trigram prefilter for message searches
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_PATTERN_TRIGRAM_H
+#define MUTT_PATTERN_TRIGRAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+struct Email;
+struct Mailbox;
+
+/// Bytes in a trigram signature (a Bloom filter over the text's trigrams)
+#define TRIGRAM_SIG_LEN 64
+/// Bits in a trigram signature
+#define TRIGRAM_SIG_BITS (TRIGRAM_SIG_LEN * 8)
+/// Maximum number of required trigrams extracted from a Pattern
+#define TRIGRAM_QUERY_MAX 16
+
+/**
+ * struct TrigramStream - Build a trigram signature from chunks of text
+ *
+ * Carries the last two bytes between chunks, so trigrams that straddle a
+ * chunk boundary aren't lost.
+ */
+struct TrigramStream
+{
+  uint32_t window;                     ///< Last three bytes seen, lowercased
+  size_t seen;                         ///< Total bytes seen
+  unsigned char sig[TRIGRAM_SIG_LEN];  ///< Signature built so far
+};
+
+int  trigram_extract   (const char *s, bool is_regex, uint32_t *tris, int max);
+void trigram_stream_init(struct TrigramStream *ts);
+void trigram_stream_add (struct TrigramStream *ts, const char *data, size_t len);
+bool trigram_sig_match  (const unsigned char *sig, const uint32_t *tris, int num);
+
+void trigram_index_open(struct Mailbox *m, bool whole, struct Email **emails, int num_emails);
+bool trigram_index_get (const char *path, size_t vlen, bool whole, unsigned char *sig);
+void trigram_index_put (const char *path, size_t vlen, bool whole, const unsigned char *sig);
+void trigram_index_sync(void);
+
+#endif /* MUTT_PATTERN_TRIGRAM_H */
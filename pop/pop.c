@@ -192,16 +192,26 @@ static int pop_read_header(struct PopAccountData *adata, struct Email *e)
   return rc;
 }
 
+/**
+ * struct UidlCtx - Keep track when matching UIDLs against the Mailbox
+ */
+struct UidlCtx
+{
+  struct Mailbox *m;          ///< Mailbox
+  struct HashTable *uid_hash; ///< Map of UID to Email
+};
+
 /**
  * fetch_uidl - Parse UIDL response - Implements ::pop_fetch_t - @ingroup pop_fetch_api
  * @param line String to parse
- * @param data Mailbox
+ * @param data UidlCtx to update
  * @retval  0 Success
  * @retval -1 Failure
  */
 static int fetch_uidl(const char *line, void *data)
 {
-  struct Mailbox *m = data;
+  struct UidlCtx *uctx = data;
+  struct Mailbox *m = uctx->m;
   struct PopAccountData *adata = pop_adata_get(m);
   char *endp = NULL;
 
@@ -217,39 +227,105 @@ static int fetch_uidl(const char *line, void *data)
   if (strlen(line) == 0)
     return -1;
 
-  int i;
-  for (i = 0; i < m->msg_count; i++)
-  {
-    struct PopEmailData *edata = pop_edata_get(m->emails[i]);
-    if (mutt_str_equal(line, edata->uid))
-      break;
-  }
-
-  if (i == m->msg_count)
+  struct Email *e = mutt_hash_find(uctx->uid_hash, line);
+  bool is_new = false;
+  if (!e)
   {
     mutt_debug(LL_DEBUG1, "new header %d %s\n", index, line);
 
-    mx_alloc_memory(m, i);
+    mx_alloc_memory(m, m->msg_count);
 
+    e = email_new();
+    e->edata = pop_edata_new(line);
+    e->edata_free = pop_edata_free;
+    m->emails[m->msg_count] = e;
     m->msg_count++;
-    m->emails[i] = email_new();
-
-    m->emails[i]->edata = pop_edata_new(line);
-    m->emails[i]->edata_free = pop_edata_free;
+    is_new = true;
   }
-  else if (m->emails[i]->index != index - 1)
+  else if (e->index != index - 1)
   {
     adata->clear_cache = true;
   }
 
-  m->emails[i]->index = index - 1;
+  e->index = index - 1;
 
-  struct PopEmailData *edata = pop_edata_get(m->emails[i]);
+  struct PopEmailData *edata = pop_edata_get(e);
   edata->refno = index;
+  if (is_new)
+    mutt_hash_insert(uctx->uid_hash, edata->uid, e);
 
   return 0;
 }
 
+/// Maximum number of new messages to fetch with individual "UIDL n" probes,
+/// above this the full "UIDL" listing is cheaper than the round-trips
+#define POP_UIDL_TAIL_MAX 128
+
+/**
+ * fetch_uidl_incremental - Match UIDLs without a full listing
+ * @param m    Mailbox
+ * @param uctx UIDL matching context
+ * @retval true The listing was handled incrementally
+ *
+ * On reconnect, if the last message we know about still has the same UID,
+ * then the server hasn't expunged anything and only the messages above that
+ * high-water mark need their UIDs fetched, one "UIDL n" probe each.
+ * Any surprise - fewer messages, a changed UID, or a batch of new mail big
+ * enough that the full listing is cheaper - falls back to "UIDL".
+ */
+static bool fetch_uidl_incremental(struct Mailbox *m, struct UidlCtx *uctx)
+{
+  struct PopAccountData *adata = pop_adata_get(m);
+  char buf[1024] = { 0 };
+
+  const int old_count = m->msg_count;
+  struct PopEmailData *last_edata = pop_edata_get(m->emails[old_count - 1]);
+
+  mutt_str_copy(buf, "STAT\r\n", sizeof(buf));
+  if (pop_query(adata, buf, sizeof(buf)) != 0)
+    return false;
+
+  int total = 0;
+  int bytes = 0;
+  if (sscanf(buf, "+OK %d %d", &total, &bytes) != 2)
+    return false;
+
+  if ((total < old_count) || ((total - old_count) > POP_UIDL_TAIL_MAX))
+    return false;
+
+  snprintf(buf, sizeof(buf), "UIDL %d\r\n", old_count);
+  if (pop_query(adata, buf, sizeof(buf)) != 0)
+    return false;
+
+  char *endp = NULL;
+  errno = 0;
+  const int index = strtol(buf + 3, &endp, 10);
+  if (errno || (index != old_count))
+    return false;
+  while (*endp == ' ')
+    endp++;
+  if (!mutt_str_equal(endp, last_edata->uid))
+    return false;
+
+  /* The prefix is unchanged, renumber it */
+  for (int i = 0; i < old_count; i++)
+  {
+    struct PopEmailData *edata = pop_edata_get(m->emails[i]);
+    edata->refno = i + 1;
+  }
+
+  for (int i = old_count + 1; i <= total; i++)
+  {
+    snprintf(buf, sizeof(buf), "UIDL %d\r\n", i);
+    if (pop_query(adata, buf, sizeof(buf)) != 0)
+      return false;
+    if (fetch_uidl(buf + 3, uctx) < 0)
+      return false;
+  }
+
+  return true;
+}
+
 /**
  * pop_bcache_delete - Delete an entry from the message cache - Implements ::bcache_list_t - @ingroup bcache_list_api
  */
@@ -301,7 +377,7 @@ static struct HeaderCache *pop_hcache_open(struct PopAccountData *adata, const c
 {
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
   if (!adata || !adata->conn)
-    return hcache_open(c_header_cache, path, NULL, true);
+    return hcache_open(c_header_cache, path, NULL, true, false);
 
   struct Url url = { 0 };
   char p[1024] = { 0 };
@@ -309,7 +385,7 @@ static struct HeaderCache *pop_hcache_open(struct PopAccountData *adata, const c
   mutt_account_tourl(&adata->conn->account, &url);
   url.path = HC_FNAME;
   url_tostring(&url, p, sizeof(p), U_PATH);
-  return hcache_open(c_header_cache, p, pop_hcache_namer, true);
+  return hcache_open(c_header_cache, p, pop_hcache_namer, true, false);
 }
 #endif
 
@@ -343,7 +419,19 @@ static int pop_fetch_headers(struct Mailbox *m)
   }
 
   const int old_count = m->msg_count;
-  int rc = pop_fetch_data(adata, "UIDL\r\n", NULL, fetch_uidl, m);
+
+  struct UidlCtx uctx = { m, NULL };
+  uctx.uid_hash = mutt_hash_new(MAX(64, old_count * 2), MUTT_HASH_NO_FLAGS);
+  for (int i = 0; i < old_count; i++)
+  {
+    struct PopEmailData *edata = pop_edata_get(m->emails[i]);
+    mutt_hash_insert(uctx.uid_hash, edata->uid, m->emails[i]);
+  }
+
+  int rc = 0;
+  if ((old_count == 0) || (adata->cmd_uidl != 1) || !fetch_uidl_incremental(m, &uctx))
+    rc = pop_fetch_data(adata, "UIDL\r\n", NULL, fetch_uidl, &uctx);
+  mutt_hash_free(&uctx.uid_hash);
   const int new_count = m->msg_count;
   m->msg_count = old_count;
 
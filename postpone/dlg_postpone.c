@@ -74,6 +74,7 @@
 #include "email/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
+#include "color/lib.h"
 #include "expando/lib.h"
 #include "index/lib.h"
 #include "key/lib.h"
@@ -188,7 +189,7 @@ static const struct AttrColor *post_color(struct Menu *menu, int line)
   if (!e)
     return NULL;
 
-  if (e->attr_color)
+  if (e->attr_color && (e->attr_color_gen == regex_colors_generation()))
     return e->attr_color;
 
   mutt_set_header_color(m, e);
@@ -0,0 +1,244 @@
+/**
+ * @file
+ * Background warming of frequently-visited mailboxes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_prefetch Background warming of frequently-visited mailboxes
+ *
+ * Keep a small persistent tally of how often each mailbox is opened, in
+ * `$prefetch_visits_file`.  While the index is idle, the most-visited
+ * mailboxes are opened once with #MUTT_PEEK and closed again, so their
+ * headers are parsed into the header cache (and the page cache) before the
+ * user switches to them.  One mailbox is warmed per idle tick, to keep the
+ * pauses short.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "prefetch.h"
+#include "mx.h"
+#include "sort.h"
+
+/// Maximum number of mailboxes remembered in `$prefetch_visits_file`
+#define PREFETCH_MAX_ENTRIES 100
+
+/**
+ * struct PrefetchEntry - Visit count for one mailbox
+ */
+struct PrefetchEntry
+{
+  char *path; ///< Mailbox path
+  int visits; ///< Number of times the mailbox has been opened
+  bool tried; ///< Mailbox has been warmed (or skipped) this session
+};
+
+ARRAY_HEAD(PrefetchArray, struct PrefetchEntry);
+
+/// Visit counts, loaded from `$prefetch_visits_file`
+static struct PrefetchArray Visits = ARRAY_HEAD_INITIALIZER;
+/// The counts have changed and need saving
+static bool VisitsDirty = false;
+/// Number of mailboxes warmed this session
+static int NumWarmed = 0;
+
+/**
+ * prefetch_entry_cmp - Compare two visit counts, descending - Implements ::sort_t - @ingroup sort_api
+ */
+static int prefetch_entry_cmp(const void *a, const void *b, void *sdata)
+{
+  const struct PrefetchEntry *pea = a;
+  const struct PrefetchEntry *peb = b;
+
+  return mutt_numeric_cmp(peb->visits, pea->visits);
+}
+
+/**
+ * prefetch_find - Find the entry for a mailbox
+ * @param path Mailbox path
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct PrefetchEntry *prefetch_find(const char *path)
+{
+  struct PrefetchEntry *pe = NULL;
+  ARRAY_FOREACH(pe, &Visits)
+  {
+    if (mutt_str_equal(pe->path, path))
+      return pe;
+  }
+  return NULL;
+}
+
+/**
+ * prefetch_init - Load the mailbox visit counts
+ *
+ * Each line of `$prefetch_visits_file` holds a visit count and a mailbox path,
+ * separated by a space.
+ */
+void prefetch_init(void)
+{
+  const char *const c_prefetch_visits_file = cs_subset_path(NeoMutt->sub, "prefetch_visits_file");
+  FILE *fp = mutt_file_fopen(c_prefetch_visits_file, "r");
+  if (!fp)
+    return;
+
+  char *buf = NULL;
+  size_t size = 0;
+  while ((buf = mutt_file_read_line(buf, &size, fp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    char *sep = strchr(buf, ' ');
+    if (!sep)
+      continue;
+    *sep = '\0';
+
+    int visits = 0;
+    if (!mutt_str_atoi_full(buf, &visits) || (visits < 1) || (sep[1] == '\0'))
+      continue;
+
+    struct PrefetchEntry pe = { mutt_str_dup(sep + 1), visits, false };
+    ARRAY_ADD(&Visits, pe);
+  }
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+}
+
+/**
+ * prefetch_cleanup - Save the mailbox visit counts and free them
+ */
+void prefetch_cleanup(void)
+{
+  struct PrefetchEntry *pe = NULL;
+
+  if (VisitsDirty)
+  {
+    const char *const c_prefetch_visits_file = cs_subset_path(NeoMutt->sub, "prefetch_visits_file");
+    unlink(c_prefetch_visits_file); // mutt_file_fopen() won't overwrite an existing file
+    FILE *fp = mutt_file_fopen(c_prefetch_visits_file, "w");
+    if (fp)
+    {
+      ARRAY_SORT(&Visits, prefetch_entry_cmp, NULL);
+      ARRAY_FOREACH(pe, &Visits)
+      {
+        if (ARRAY_FOREACH_IDX >= PREFETCH_MAX_ENTRIES)
+          break;
+        fprintf(fp, "%d %s\n", pe->visits, pe->path);
+      }
+      mutt_file_fclose(&fp);
+    }
+  }
+
+  ARRAY_FOREACH(pe, &Visits)
+  {
+    FREE(&pe->path);
+  }
+  ARRAY_FREE(&Visits);
+}
+
+/**
+ * prefetch_record_visit - Note that a mailbox has been opened
+ * @param path Mailbox path
+ */
+void prefetch_record_visit(const char *path)
+{
+  if (!path || (*path == '\0'))
+    return;
+
+  struct PrefetchEntry *pe = prefetch_find(path);
+  if (pe)
+  {
+    pe->visits++;
+  }
+  else
+  {
+    struct PrefetchEntry pe_new = { mutt_str_dup(path), 1, false };
+    ARRAY_ADD(&Visits, pe_new);
+    pe = ARRAY_LAST(&Visits);
+  }
+
+  /* no point warming what's already open */
+  pe->tried = true;
+  VisitsDirty = true;
+}
+
+/**
+ * prefetch_step - Warm the next most-visited mailbox
+ * @param m_cur Mailbox currently open in the index
+ *
+ * Called when the index is idle.  At most one mailbox is opened per call and
+ * at most `$prefetch_mailboxes` per session.  Only local mailboxes are
+ * warmed; prefetching a remote mailbox could prompt for a password.
+ */
+void prefetch_step(struct Mailbox *m_cur)
+{
+  const short c_prefetch_mailboxes = cs_subset_number(NeoMutt->sub, "prefetch_mailboxes");
+  if (NumWarmed >= c_prefetch_mailboxes)
+    return;
+
+  /* pick the most-visited mailbox that hasn't been tried yet */
+  struct PrefetchEntry *best = NULL;
+  struct PrefetchEntry *pe = NULL;
+  ARRAY_FOREACH(pe, &Visits)
+  {
+    if (pe->tried)
+      continue;
+    if (!best || (pe->visits > best->visits))
+      best = pe;
+  }
+  if (!best)
+    return;
+
+  /* one attempt each, successful or not */
+  best->tried = true;
+
+  if (m_cur && mutt_str_equal(best->path, mailbox_path(m_cur)))
+    return;
+
+  struct Mailbox *m = mx_path_resolve(best->path);
+  if (!m)
+    return;
+
+  if (((m->type != MUTT_MBOX) && (m->type != MUTT_MMDF) && (m->type != MUTT_MH) &&
+       (m->type != MUTT_MAILDIR)) ||
+      (m->opened > 0))
+  {
+    if (!m->account)
+      mailbox_free(&m);
+    return;
+  }
+
+  mutt_debug(LL_DEBUG2, "warming %s\n", best->path);
+  if (mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK))
+  {
+    NumWarmed++;
+    mx_mbox_close(m);
+    mailbox_free(&m);
+  }
+  else
+  {
+    mailbox_free(&m);
+  }
+}
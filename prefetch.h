@@ -0,0 +1,33 @@
+/**
+ * @file
+ * Background warming of frequently-visited mailboxes
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_PREFETCH_H
+#define MUTT_PREFETCH_H
+
+struct Mailbox;
+
+void prefetch_cleanup     (void);
+void prefetch_init        (void);
+void prefetch_record_visit(const char *path);
+void prefetch_step        (struct Mailbox *m_cur);
+
+#endif /* MUTT_PREFETCH_H */
@@ -0,0 +1,59 @@
+/**
+ * @file
+ * Config used by libpreview
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page preview_config Config used by libpreview
+ *
+ * Config used by libpreview
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+
+/**
+ * PreviewVars - Config definitions for the preview window
+ */
+static struct ConfigDef PreviewVars[] = {
+  // clang-format off
+  { "preview_height", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 12, 0, NULL,
+    "(preview) Height of the preview window"
+  },
+  { "preview_prefetch", DT_BOOL, true, 0, NULL,
+    "(preview) Speculatively fetch previews for the messages next to the selection"
+  },
+  { "preview_visible", DT_BOOL, false, 0, NULL,
+    "(preview) Show the preview window"
+  },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * config_init_preview - Register preview config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
+ */
+bool config_init_preview(struct ConfigSet *cs)
+{
+  return cs_register_variables(cs, PreviewVars);
+}
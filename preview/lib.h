@@ -0,0 +1,43 @@
+/**
+ * @file
+ * Preview of the selected email
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page lib_preview Preview
+ *
+ * Show a preview of the selected email below the index, without opening the
+ * pager.
+ *
+ * | File              | Description              |
+ * | :---------------- | :----------------------- |
+ * | preview/config.c  | @subpage preview_config  |
+ * | preview/preview.c | @subpage preview_preview |
+ */
+
+#ifndef MUTT_PREVIEW_LIB_H
+#define MUTT_PREVIEW_LIB_H
+
+struct IndexSharedData;
+struct MuttWindow;
+
+struct MuttWindow *preview_window_new(struct IndexSharedData *shared);
+
+#endif /* MUTT_PREVIEW_LIB_H */
@@ -0,0 +1,472 @@
+/**
+ * @file
+ * Preview of the selected email
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page preview_preview Preview window
+ *
+ * Show a preview of the selected email below the index, without opening the
+ * pager.
+ *
+ * The decoded previews are kept in a small cache and the previews of the
+ * neighbouring messages are fetched speculatively after the selection is
+ * drawn.  Moving the cursor sequentially thus finds the next preview already
+ * decoded - on IMAP, mx_msg_open() also leaves the fetched message in the
+ * body cache, so opening the pager afterwards is fast too.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "gui/lib.h"
+#include "lib.h"
+#include "attach/lib.h"
+#include "color/lib.h"
+#include "index/lib.h"
+#include "ncrypt/lib.h"
+#include "copy.h"
+#include "mview.h"
+#include "mx.h"
+
+/// Number of decoded previews kept in memory
+#define PREVIEW_CACHE_SIZE 32
+/// Maximum number of body lines to decode for one preview
+#define PREVIEW_MAX_LINES 64
+
+/**
+ * struct PreviewEntry - One cached preview
+ */
+struct PreviewEntry
+{
+  struct Email *email; ///< Email the text belongs to
+  char *message_id;    ///< Message-ID, to catch pointer reuse
+  char *text;          ///< Decoded body text, one line per '\n'
+  uint64_t last_used;  ///< For LRU eviction
+};
+
+/**
+ * struct PreviewWindowData - Private data for the Preview window
+ */
+struct PreviewWindowData
+{
+  struct IndexSharedData *shared;                 ///< Shared Index data
+  struct PreviewEntry cache[PREVIEW_CACHE_SIZE];  ///< Recently decoded previews
+  uint64_t use_counter;                           ///< Monotonic counter for the LRU
+};
+
+/**
+ * preview_entry_clear - Empty a cache slot
+ * @param entry Entry to clear
+ */
+static void preview_entry_clear(struct PreviewEntry *entry)
+{
+  entry->email = NULL;
+  FREE(&entry->message_id);
+  FREE(&entry->text);
+  entry->last_used = 0;
+}
+
+/**
+ * preview_cache_flush - Drop all the cached previews
+ * @param wdata Preview window data
+ */
+static void preview_cache_flush(struct PreviewWindowData *wdata)
+{
+  for (int i = 0; i < PREVIEW_CACHE_SIZE; i++)
+    preview_entry_clear(&wdata->cache[i]);
+}
+
+/**
+ * preview_cache_find - Find the cached preview for an email
+ * @param wdata Preview window data
+ * @param e     Email to look for
+ * @retval ptr  Matching entry
+ * @retval NULL Not cached
+ *
+ * The Message-ID is compared as well as the pointer, in case the Email was
+ * freed and the address reused.
+ */
+static struct PreviewEntry *preview_cache_find(struct PreviewWindowData *wdata,
+                                               struct Email *e)
+{
+  for (int i = 0; i < PREVIEW_CACHE_SIZE; i++)
+  {
+    struct PreviewEntry *entry = &wdata->cache[i];
+    if (entry->email != e)
+      continue;
+    if (!mutt_str_equal(entry->message_id, e->env ? e->env->message_id : NULL))
+    {
+      preview_entry_clear(entry);
+      return NULL;
+    }
+    entry->last_used = ++wdata->use_counter;
+    return entry;
+  }
+
+  return NULL;
+}
+
+/**
+ * preview_generate - Decode the beginning of an email's body
+ * @param m Mailbox
+ * @param e Email
+ * @retval ptr Decoded text, one line per '\n'
+ * @retval NULL The body couldn't be fetched
+ *
+ * @note The return value must be freed
+ */
+static char *preview_generate(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e)
+    return NULL;
+
+  // Don't trigger decryption (and passphrase prompts) for a preview
+  if ((WithCrypto != 0) && (e->security & SEC_ENCRYPT))
+    return mutt_str_dup(_("[-- This message is encrypted --]"));
+
+  struct Message *msg = mx_msg_open(m, e);
+  if (!msg)
+    return NULL;
+
+  char *text = NULL;
+  FILE *fp_tmp = mutt_file_mkstemp();
+  if (!fp_tmp)
+    goto cleanup;
+
+  mutt_parse_mime_message(e, msg->fp);
+
+  const CopyMessageFlags cmflags = MUTT_CM_DECODE | MUTT_CM_DISPLAY |
+                                   MUTT_CM_CHARCONV | MUTT_CM_NOHEADER;
+  if (mutt_copy_message(fp_tmp, e, msg, cmflags, CH_NO_FLAGS, 0) != 0)
+    goto cleanup;
+
+  rewind(fp_tmp);
+
+  struct Buffer *buf = buf_pool_get();
+  char *line = NULL;
+  size_t size = 0;
+  int num_lines = 0;
+  bool seen_text = false;
+
+  while ((num_lines < PREVIEW_MAX_LINES) &&
+         (line = mutt_file_read_line(line, &size, fp_tmp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    if (!seen_text && (*line == '\0'))
+      continue; // skip leading blank lines
+    seen_text = true;
+
+    buf_addstr(buf, line);
+    buf_addch(buf, '\n');
+    num_lines++;
+  }
+  FREE(&line);
+
+  text = buf_strdup(buf);
+  buf_pool_release(&buf);
+
+cleanup:
+  mutt_file_fclose(&fp_tmp);
+  mx_msg_close(m, &msg);
+  return text;
+}
+
+/**
+ * preview_cache_get - Fetch the preview for an email, using the cache
+ * @param wdata Preview window data
+ * @param e     Email
+ * @retval ptr  Preview text (owned by the cache)
+ * @retval NULL The body couldn't be fetched
+ */
+static const char *preview_cache_get(struct PreviewWindowData *wdata, struct Email *e)
+{
+  if (!e)
+    return NULL;
+
+  struct PreviewEntry *entry = preview_cache_find(wdata, e);
+  if (entry)
+    return entry->text;
+
+  char *text = preview_generate(wdata->shared->mailbox, e);
+  if (!text)
+    return NULL;
+
+  // Replace the least recently used entry
+  entry = &wdata->cache[0];
+  for (int i = 1; i < PREVIEW_CACHE_SIZE; i++)
+  {
+    if (wdata->cache[i].last_used < entry->last_used)
+      entry = &wdata->cache[i];
+  }
+
+  preview_entry_clear(entry);
+  entry->email = e;
+  entry->message_id = mutt_str_dup(e->env ? e->env->message_id : NULL);
+  entry->text = text;
+  entry->last_used = ++wdata->use_counter;
+
+  return entry->text;
+}
+
+/**
+ * preview_prefetch - Fetch the previews of the neighbouring messages
+ * @param wdata Preview window data
+ *
+ * Decode the previews of the messages just before and after the selection,
+ * so that moving the cursor finds them ready.  There's no safe way to do
+ * this off the main thread (the mailbox API isn't thread-safe), but for
+ * sequential movement each step only ever fetches one new message.
+ */
+static void preview_prefetch(struct PreviewWindowData *wdata)
+{
+  struct IndexSharedData *shared = wdata->shared;
+  struct Mailbox *m = shared->mailbox;
+  if (!m || !shared->email)
+    return;
+
+  const int vnum = shared->email->vnum;
+  if (vnum < 0)
+    return;
+
+  static const int offsets[] = { 1, -1 };
+  for (size_t i = 0; i < mutt_array_size(offsets); i++)
+  {
+    struct Email *e = mutt_get_virt_email(m, vnum + offsets[i]);
+    if (e)
+      preview_cache_get(wdata, e);
+  }
+}
+
+/**
+ * preview_recalc - Recalculate the Preview window - Implements MuttWindow::recalc() - @ingroup window_recalc
+ */
+static int preview_recalc(struct MuttWindow *win)
+{
+  struct PreviewWindowData *wdata = win->wdata;
+
+  // Make sure the selection's preview is decoded before the repaint
+  preview_cache_get(wdata, wdata->shared->email);
+
+  win->actions |= WA_REPAINT;
+  mutt_debug(LL_DEBUG5, "recalc done, request WA_REPAINT\n");
+  return 0;
+}
+
+/**
+ * preview_repaint - Repaint the Preview window - Implements MuttWindow::repaint() - @ingroup window_repaint
+ */
+static int preview_repaint(struct MuttWindow *win)
+{
+  if (!mutt_window_is_visible(win))
+    return 0;
+
+  struct PreviewWindowData *wdata = win->wdata;
+  struct Email *e = wdata->shared->email;
+
+  struct Buffer *title = buf_pool_get();
+  if (e && e->env)
+  {
+    mutt_addrlist_write(&e->env->from, title, true);
+    buf_addstr(title, ": ");
+    buf_addstr(title, NONULL(e->env->subject));
+  }
+
+  mutt_curses_set_normal_backed_color_by_id(MT_COLOR_STATUS);
+  mutt_window_move(win, 0, 0);
+  mutt_window_addstr(win, buf_string(title));
+  mutt_window_clrtoeol(win);
+  mutt_curses_set_color_by_id(MT_COLOR_NORMAL);
+  buf_pool_release(&title);
+
+  const char *text = preview_cache_get(wdata, e);
+  int row = 1;
+  if (text)
+  {
+    struct Buffer *line = buf_pool_get();
+    for (const char *p = text; *p && (row < win->state.rows); row++)
+    {
+      const char *eol = strchr(p, '\n');
+      if (!eol)
+        eol = p + strlen(p);
+
+      buf_reset(line);
+      buf_addstr_n(line, p, eol - p);
+      mutt_window_move(win, 0, row);
+      mutt_window_addnstr(win, buf_string(line),
+                          mutt_wstr_trunc(buf_string(line), buf_len(line),
+                                          win->state.cols, NULL));
+      mutt_window_clrtoeol(win);
+
+      p = (*eol == '\n') ? (eol + 1) : eol;
+    }
+    buf_pool_release(&line);
+  }
+
+  for (; row < win->state.rows; row++)
+  {
+    mutt_window_move(win, 0, row);
+    mutt_window_clrtoeol(win);
+  }
+
+  // The selection is on screen; now warm the cache for its neighbours
+  const bool c_preview_prefetch = cs_subset_bool(NeoMutt->sub, "preview_prefetch");
+  if (c_preview_prefetch)
+    preview_prefetch(wdata);
+
+  mutt_debug(LL_DEBUG5, "repaint done\n");
+  return 0;
+}
+
+/**
+ * preview_config_observer - Notification that a Config Variable has changed - Implements ::observer_t - @ingroup observer_api
+ */
+static int preview_config_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_CONFIG)
+    return 0;
+  if (!nc->global_data || !nc->event_data)
+    return -1;
+
+  struct EventConfig *ev_c = nc->event_data;
+  if (!mutt_strn_equal(ev_c->name, "preview_", 8))
+    return 0;
+
+  struct MuttWindow *win = nc->global_data;
+
+  if (mutt_str_equal(ev_c->name, "preview_visible"))
+  {
+    const bool c_preview_visible = cs_subset_bool(NeoMutt->sub, "preview_visible");
+    window_set_visible(win, c_preview_visible);
+  }
+  else if (mutt_str_equal(ev_c->name, "preview_height"))
+  {
+    const short c_preview_height = cs_subset_number(NeoMutt->sub, "preview_height");
+    win->req_rows = c_preview_height;
+  }
+
+  mutt_window_reflow(win->parent);
+  mutt_debug(LL_DEBUG5, "config done\n");
+  return 0;
+}
+
+/**
+ * preview_index_observer - Notification that the Index has changed - Implements ::observer_t - @ingroup observer_api
+ */
+static int preview_index_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_INDEX)
+    return 0;
+  if (!nc->global_data)
+    return -1;
+
+  struct MuttWindow *win = nc->global_data;
+  struct PreviewWindowData *wdata = win->wdata;
+
+  if (nc->event_subtype & NT_INDEX_MAILBOX)
+  {
+    // The Emails have been freed; the cached pointers are dead
+    preview_cache_flush(wdata);
+  }
+
+  if (nc->event_subtype & (NT_INDEX_MAILBOX | NT_INDEX_EMAIL))
+  {
+    win->actions |= WA_RECALC;
+    mutt_debug(LL_DEBUG5, "index done, request WA_RECALC\n");
+  }
+
+  return 0;
+}
+
+/**
+ * preview_window_observer - Notification that a Window has changed - Implements ::observer_t - @ingroup observer_api
+ */
+static int preview_window_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_WINDOW)
+    return 0;
+  if (!nc->global_data || !nc->event_data)
+    return -1;
+  if (nc->event_subtype != NT_WINDOW_DELETE)
+    return 0;
+
+  struct MuttWindow *win = nc->global_data;
+  struct EventWindow *ev_w = nc->event_data;
+  if (ev_w->win != win)
+    return 0;
+
+  struct PreviewWindowData *wdata = win->wdata;
+
+  notify_observer_remove(NeoMutt->sub->notify, preview_config_observer, win);
+  notify_observer_remove(wdata->shared->notify, preview_index_observer, win);
+  notify_observer_remove(win->notify, preview_window_observer, win);
+  mutt_debug(LL_DEBUG5, "window delete done\n");
+
+  return 0;
+}
+
+/**
+ * preview_wdata_free - Free the Preview Data - Implements MuttWindow::wdata_free() - @ingroup window_wdata_free
+ */
+static void preview_wdata_free(struct MuttWindow *win, void **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct PreviewWindowData *wdata = *ptr;
+  preview_cache_flush(wdata);
+  FREE(ptr);
+}
+
+/**
+ * preview_window_new - Create the Preview window
+ * @param shared Shared Index data
+ * @retval ptr New Window
+ */
+struct MuttWindow *preview_window_new(struct IndexSharedData *shared)
+{
+  const short c_preview_height = cs_subset_number(NeoMutt->sub, "preview_height");
+  struct MuttWindow *win = mutt_window_new(WT_CUSTOM, MUTT_WIN_ORIENT_VERTICAL,
+                                           MUTT_WIN_SIZE_FIXED, MUTT_WIN_SIZE_UNLIMITED,
+                                           c_preview_height);
+
+  const bool c_preview_visible = cs_subset_bool(NeoMutt->sub, "preview_visible");
+  win->state.visible = c_preview_visible;
+
+  struct PreviewWindowData *wdata = mutt_mem_calloc(1, sizeof(struct PreviewWindowData));
+  wdata->shared = shared;
+
+  win->wdata = wdata;
+  win->wdata_free = preview_wdata_free;
+  win->recalc = preview_recalc;
+  win->repaint = preview_repaint;
+
+  notify_observer_add(NeoMutt->sub->notify, NT_CONFIG, preview_config_observer, win);
+  notify_observer_add(shared->notify, NT_INDEX, preview_index_observer, win);
+  notify_observer_add(win->notify, NT_WINDOW, preview_window_observer, win);
+
+  return win;
+}
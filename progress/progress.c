@@ -39,6 +39,7 @@
 #include "lib.h"
 #include "globals.h"
 #include "mutt_logging.h"
+#include "wdata.h"
 #include "window.h"
 
 struct Progress;
@@ -84,6 +85,22 @@ bool progress_update(struct Progress *progress, size_t pos, int percent)
 
   // Decloak an opaque pointer
   struct MuttWindow *win = (struct MuttWindow *) progress;
+
+  // Fast path: avoid a function call per record in the callers' hot loops
+  const struct ProgressWindowData *wdata = win->wdata;
+  if (wdata)
+  {
+    if (percent >= 0)
+    {
+      if (percent <= wdata->display_percent)
+        return false;
+    }
+    else if (pos < wdata->next_pos)
+    {
+      return false;
+    }
+  }
+
   const bool updated = progress_window_update(win, pos, percent);
 
   if (SigWinch)
@@ -54,6 +54,7 @@ struct ProgressWindowData
   size_t   update_pos;          ///< Updated position
   int      update_percent;      ///< Updated percentage complete
   uint64_t update_time;         ///< Time of last update
+  size_t   next_pos;            ///< Position at which the next render is due
 };
 
 void                       progress_wdata_free(struct MuttWindow *win, void **ptr);
@@ -234,18 +234,6 @@ static bool percent_needs_update(const struct ProgressWindowData *wdata, int per
   return (percent > wdata->display_percent);
 }
 
-/**
- * pos_needs_update - Do we need to update, given the current pos?
- * @param wdata Private data
- * @param pos   Current pos
- * @retval true Progress needs an update
- */
-static bool pos_needs_update(const struct ProgressWindowData *wdata, long pos)
-{
-  const unsigned shift = wdata->is_bytes ? 10 : 0;
-  return pos >= (wdata->display_pos + (wdata->size_inc << shift));
-}
-
 /**
  * time_needs_update - Do we need to update, given the current time?
  * @param wdata Private data
@@ -285,10 +273,15 @@ bool progress_window_update(struct MuttWindow *win, size_t pos, int percent)
   }
   else
   {
-    if (!pos_needs_update(wdata, pos))
+    if (pos < wdata->next_pos)
       return false;
   }
 
+  /* Step to the next boundary, whether or not we render - keeping the clock
+   * call out of the once-per-record path */
+  const unsigned shift = wdata->is_bytes ? 10 : 0;
+  wdata->next_pos = pos + (wdata->size_inc << shift);
+
   const uint64_t now = mutt_date_now_ms();
   if (!time_needs_update(wdata, now))
     return false;
@@ -327,6 +320,7 @@ struct MuttWindow *progress_window_new(size_t size, size_t size_inc,
   wdata->size_inc = size_inc;
   wdata->time_inc = time_inc;
   wdata->is_bytes = is_bytes;
+  wdata->next_pos = size_inc << (is_bytes ? 10 : 0);
 
   if (is_bytes)
     mutt_str_pretty_size(wdata->pretty_size, sizeof(wdata->pretty_size), size);
@@ -371,5 +365,6 @@ void progress_window_set_size(struct MuttWindow *win, size_t size)
   wdata->display_pos = 0;
   wdata->display_percent = 0;
   wdata->display_time = 0;
+  wdata->next_pos = wdata->size_inc << (wdata->is_bytes ? 10 : 0);
   win->actions |= WA_RECALC;
 }
@@ -44,6 +44,93 @@
 #include <sys/param.h> // IWYU pragma: keep
 #endif
 
+/**
+ * struct YesNoLocale - Cached locale data for mw_yesorno()
+ *
+ * The "yes"/"no" strings and the YESEXPR/NOEXPR regexes depend only on the
+ * locale, which is fixed at startup, but they used to be translated and
+ * compiled again on every question - noticeable when prompts are asked in
+ * a loop.  The first question fills this cache; the rest reuse it.
+ */
+struct YesNoLocale
+{
+  bool init;      ///< Cache has been filled
+  char *yes;      ///< Localised "yes", or English fallback
+  char *no;       ///< Localised "no", or English fallback
+  regex_t reyes;  ///< Compiled YESEXPR, if #YesNoLocale.reyes_ok
+  regex_t reno;   ///< Compiled NOEXPR, if #YesNoLocale.reno_ok
+  bool reyes_ok;  ///< reyes is valid
+  bool reno_ok;   ///< reno is valid
+};
+
+/// Locale data for mw_yesorno(), filled on the first question
+static struct YesNoLocale YesNo = { 0 };
+
+/**
+ * yesorno_init - Fill the locale cache for mw_yesorno()
+ */
+static void yesorno_init(void)
+{
+  if (YesNo.init)
+    return;
+  YesNo.init = true;
+
+  char *yes = N_("yes");
+  char *no = N_("no");
+  char *trans_yes = _(yes);
+  char *trans_no = _(no);
+
+#ifdef OpenBSD
+  /* OpenBSD only supports locale C and UTF-8
+   * so there is no suitable base system's locale identification
+   * Remove this code immediately if this situation changes! */
+  char rexyes[16] = "^[+1YyYy]";
+  rexyes[6] = toupper(trans_yes[0]);
+  rexyes[7] = tolower(trans_yes[0]);
+
+  char rexno[16] = "^[-0NnNn]";
+  rexno[6] = toupper(trans_no[0]);
+  rexno[7] = tolower(trans_no[0]);
+
+  if (REG_COMP(&YesNo.reyes, rexyes, REG_NOSUB) == 0)
+    YesNo.reyes_ok = true;
+
+  if (REG_COMP(&YesNo.reno, rexno, REG_NOSUB) == 0)
+    YesNo.reno_ok = true;
+
+#else
+  char *expr = NULL;
+  YesNo.reyes_ok = (expr = nl_langinfo(YESEXPR)) && (expr[0] == '^') &&
+                   (REG_COMP(&YesNo.reyes, expr, REG_NOSUB) == 0);
+  YesNo.reno_ok = (expr = nl_langinfo(NOEXPR)) && (expr[0] == '^') &&
+                  (REG_COMP(&YesNo.reno, expr, REG_NOSUB) == 0);
+#endif
+
+  if ((yes != trans_yes) && (no != trans_no) && YesNo.reyes_ok && YesNo.reno_ok)
+  {
+    // If all parts of the translation succeeded...
+    yes = trans_yes;
+    no = trans_no;
+  }
+  else
+  {
+    // otherwise, fallback to English
+    if (YesNo.reyes_ok)
+    {
+      regfree(&YesNo.reyes);
+      YesNo.reyes_ok = false;
+    }
+    if (YesNo.reno_ok)
+    {
+      regfree(&YesNo.reno);
+      YesNo.reno_ok = false;
+    }
+  }
+
+  YesNo.yes = yes;
+  YesNo.no = no;
+}
+
 /**
  * mw_multi_choice - Offer the user a multiple choice question - @ingroup gui_mw
  * @param prompt  Message prompt
@@ -178,63 +265,9 @@ static enum QuadOption mw_yesorno(const char *prompt, enum QuadOption def,
   if (!win)
     return MUTT_ABORT;
 
-  char *yes = N_("yes");
-  char *no = N_("no");
-  char *trans_yes = _(yes);
-  char *trans_no = _(no);
-
-  regex_t reyes = { 0 };
-  regex_t reno = { 0 };
-
-  bool reyes_ok = false;
-  bool reno_ok = false;
-
-#ifdef OpenBSD
-  /* OpenBSD only supports locale C and UTF-8
-   * so there is no suitable base system's locale identification
-   * Remove this code immediately if this situation changes! */
-  char rexyes[16] = "^[+1YyYy]";
-  rexyes[6] = toupper(trans_yes[0]);
-  rexyes[7] = tolower(trans_yes[0]);
-
-  char rexno[16] = "^[-0NnNn]";
-  rexno[6] = toupper(trans_no[0]);
-  rexno[7] = tolower(trans_no[0]);
-
-  if (REG_COMP(&reyes, rexyes, REG_NOSUB) == 0)
-    reyes_ok = true;
-
-  if (REG_COMP(&reno, rexno, REG_NOSUB) == 0)
-    reno_ok = true;
-
-#else
-  char *expr = NULL;
-  reyes_ok = (expr = nl_langinfo(YESEXPR)) && (expr[0] == '^') &&
-             (REG_COMP(&reyes, expr, REG_NOSUB) == 0);
-  reno_ok = (expr = nl_langinfo(NOEXPR)) && (expr[0] == '^') &&
-            (REG_COMP(&reno, expr, REG_NOSUB) == 0);
-#endif
-
-  if ((yes != trans_yes) && (no != trans_no) && reyes_ok && reno_ok)
-  {
-    // If all parts of the translation succeeded...
-    yes = trans_yes;
-    no = trans_no;
-  }
-  else
-  {
-    // otherwise, fallback to English
-    if (reyes_ok)
-    {
-      regfree(&reyes);
-      reyes_ok = false;
-    }
-    if (reno_ok)
-    {
-      regfree(&reno);
-      reno_ok = false;
-    }
-  }
+  yesorno_init();
+  const char *yes = YesNo.yes;
+  const char *no = YesNo.no;
 
   bool show_help_prompt = cdef;
 
@@ -269,12 +302,14 @@ static enum QuadOption mw_yesorno(const char *prompt, enum QuadOption def,
 
     char answer[4] = { 0 };
     answer[0] = event.ch;
-    if (reyes_ok ? (regexec(&reyes, answer, 0, 0, 0) == 0) : (tolower(event.ch) == 'y'))
+    if (YesNo.reyes_ok ? (regexec(&YesNo.reyes, answer, 0, 0, 0) == 0) :
+                         (tolower(event.ch) == 'y'))
     {
       def = MUTT_YES;
       break;
     }
-    if (reno_ok ? (regexec(&reno, answer, 0, 0, 0) == 0) : (tolower(event.ch) == 'n'))
+    if (YesNo.reno_ok ? (regexec(&YesNo.reno, answer, 0, 0, 0) == 0) :
+                        (tolower(event.ch) == 'n'))
     {
       def = MUTT_NO;
       break;
@@ -307,11 +342,6 @@ static enum QuadOption mw_yesorno(const char *prompt, enum QuadOption def,
   window_set_focus(old_focus);
   mutt_window_free(&win);
 
-  if (reyes_ok)
-    regfree(&reyes);
-  if (reno_ok)
-    regfree(&reno);
-
   buf_pool_release(&text);
   return def;
 }
@@ -0,0 +1,355 @@
+/**
+ * @file
+ * Cache of preprocessed config file lines
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_rccache Cache of preprocessed config file lines
+ *
+ * Starting up means reading every config file, joining continuation lines,
+ * converting `$config_charset` and discarding comments, before a single
+ * command runs.  When `$config_cache_file` is set, the preprocessed logical lines
+ * of each file are remembered in that cache file, keyed by path and validated
+ * by mtime and size.  The next startup replays the lines straight from the
+ * cache, skipping the file reads and the preprocessing.
+ *
+ * Only the line stream is cached, not the commands' effects: backticks,
+ * variable expansion and `source somecommand|` must still see the current
+ * environment, so every line is parsed normally on replay.
+ *
+ * The cache takes effect for files source'd after `$config_cache_file` is set, so
+ * it should be set near the top of the neomuttrc.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "rccache.h"
+
+ARRAY_HEAD(RcFileCacheArray, struct RcFileCache *);
+
+/// Cached config files, loaded from `$config_cache_file`
+static struct RcFileCacheArray RcCache = ARRAY_HEAD_INITIALIZER;
+/// The cache has changed and needs saving
+static bool RcCacheDirty = false;
+/// The cache file has been read
+static bool RcCacheLoaded = false;
+
+/**
+ * rc_file_cache_free - Free a cached config file
+ * @param ptr Cache entry to free
+ */
+static void rc_file_cache_free(struct RcFileCache **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct RcFileCache *rfc = *ptr;
+
+  FREE(&rfc->path);
+  FREE(&rfc->charset);
+  struct RcCacheLine *cl = NULL;
+  ARRAY_FOREACH(cl, &rfc->lines)
+  {
+    FREE(&cl->text);
+  }
+  ARRAY_FREE(&rfc->lines);
+
+  FREE(ptr);
+}
+
+/**
+ * rc_cache_lookup - Find the cache entry for a config file
+ * @param path Absolute path of the config file
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct RcFileCache *rc_cache_lookup(const char *path)
+{
+  struct RcFileCache **rfcp = NULL;
+  ARRAY_FOREACH(rfcp, &RcCache)
+  {
+    if (mutt_str_equal((*rfcp)->path, path))
+      return *rfcp;
+  }
+  return NULL;
+}
+
+/**
+ * rc_cache_remove - Drop the cache entry for a config file
+ * @param rfc Entry to drop
+ */
+static void rc_cache_remove(struct RcFileCache *rfc)
+{
+  struct RcFileCache **rfcp = NULL;
+  ARRAY_FOREACH(rfcp, &RcCache)
+  {
+    if (*rfcp == rfc)
+    {
+      ARRAY_REMOVE(&RcCache, rfcp);
+      break;
+    }
+  }
+  rc_file_cache_free(&rfc);
+  RcCacheDirty = true;
+}
+
+/**
+ * rc_cache_load - Read `$config_cache_file` into memory
+ *
+ * The cache file holds one block per config file.  A `file` line carries the
+ * validation data and the path; the numbered lines that follow are the
+ * preprocessed content.
+ */
+static void rc_cache_load(const char *cache_file)
+{
+  FILE *fp = mutt_file_fopen(cache_file, "r");
+  if (!fp)
+    return;
+
+  struct RcFileCache *rfc = NULL;
+  char *buf = NULL;
+  size_t size = 0;
+  while ((buf = mutt_file_read_line(buf, &size, fp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    size_t plen = mutt_str_startswith(buf, "file ");
+    if (plen != 0)
+    {
+      char *end = NULL;
+      long long mtime = strtoll(buf + plen, &end, 10);
+      long long fsize = strtoll(end, &end, 10);
+      char *charset = end + 1;
+      char *path = strchr(charset, ' ');
+      if (!path)
+        continue;
+      *path++ = '\0';
+
+      rfc = mutt_mem_calloc(1, sizeof(struct RcFileCache));
+      rfc->path = mutt_str_dup(path);
+      rfc->charset = mutt_str_equal(charset, "-") ? NULL : mutt_str_dup(charset);
+      rfc->mtime = mtime;
+      rfc->size = fsize;
+      ARRAY_INIT(&rfc->lines);
+      ARRAY_ADD(&RcCache, rfc);
+      continue;
+    }
+
+    if (!rfc)
+      continue;
+
+    char *end = NULL;
+    long lineno = strtol(buf, &end, 10);
+    if ((end == buf) || (*end != ' '))
+      continue;
+
+    struct RcCacheLine cl = { lineno, mutt_str_dup(end + 1) };
+    ARRAY_ADD(&rfc->lines, cl);
+  }
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+}
+
+/**
+ * rc_cache_file - Get the cache file path, loading the cache on first use
+ * @retval ptr  Path of `$config_cache_file`
+ * @retval NULL Caching is disabled
+ *
+ * `$config_cache_file` is usually set by the config file being parsed, so the
+ * cache can't be loaded up front; it's loaded the first time the variable is
+ * seen set.
+ */
+static const char *rc_cache_file(void)
+{
+  const char *const c_config_cache = cs_subset_path(NeoMutt->sub, "config_cache_file");
+  if (!c_config_cache)
+    return NULL;
+
+  if (!RcCacheLoaded)
+  {
+    RcCacheLoaded = true;
+    rc_cache_load(c_config_cache);
+  }
+
+  return c_config_cache;
+}
+
+/**
+ * rc_cache_find - Find a valid cache entry for a config file
+ * @param path Absolute path of the config file
+ * @retval ptr  Entry whose lines can be replayed
+ * @retval NULL No valid entry, read the file normally
+ *
+ * An entry is only returned if the file's mtime and size still match and the
+ * lines were converted from the current `$config_charset`.
+ */
+struct RcFileCache *rc_cache_find(const char *path)
+{
+  if (!rc_cache_file())
+    return NULL;
+
+  struct RcFileCache *rfc = rc_cache_lookup(path);
+  if (!rfc)
+    return NULL;
+
+  struct stat st = { 0 };
+  if ((stat(path, &st) != 0) || (st.st_mtime != rfc->mtime) || (st.st_size != rfc->size))
+  {
+    rc_cache_remove(rfc);
+    return NULL;
+  }
+
+  const char *const c_config_charset = cs_subset_string(NeoMutt->sub, "config_charset");
+  if (!mutt_str_equal(c_config_charset, rfc->charset))
+  {
+    rc_cache_remove(rfc);
+    return NULL;
+  }
+
+  mutt_debug(LL_DEBUG2, "Replaying '%s' from the config cache\n", path);
+  return rfc;
+}
+
+/**
+ * rc_cache_record_start - Start recording a config file
+ * @param path Absolute path of the config file
+ * @retval ptr  New entry to record into
+ * @retval NULL Caching is disabled
+ *
+ * Any stale entry for the path is dropped.  The entry isn't part of the cache
+ * until rc_cache_record_finish() accepts it.
+ */
+struct RcFileCache *rc_cache_record_start(const char *path)
+{
+  if (!rc_cache_file())
+    return NULL;
+
+  struct RcFileCache *rfc = rc_cache_lookup(path);
+  if (rfc)
+    rc_cache_remove(rfc);
+
+  rfc = mutt_mem_calloc(1, sizeof(struct RcFileCache));
+  rfc->path = mutt_str_dup(path);
+  const char *const c_config_charset = cs_subset_string(NeoMutt->sub, "config_charset");
+  rfc->charset = mutt_str_dup(c_config_charset);
+  ARRAY_INIT(&rfc->lines);
+  return rfc;
+}
+
+/**
+ * rc_cache_record_line - Record one logical line of a config file
+ * @param rfc    Entry being recorded
+ * @param lineno Line number in the original file
+ * @param line   Logical line, after continuation joining and charset conversion
+ *
+ * Blank lines and whole-line comments are dropped: replaying them would be
+ * work for nothing.
+ */
+void rc_cache_record_line(struct RcFileCache *rfc, int lineno, const char *line)
+{
+  if (!rfc || !line)
+    return;
+
+  SKIPWS(line);
+  if ((line[0] == '\0') || (line[0] == '#'))
+    return;
+
+  struct RcCacheLine cl = { lineno, mutt_str_dup(line) };
+  ARRAY_ADD(&rfc->lines, cl);
+}
+
+/**
+ * rc_cache_record_finish - Accept a recorded config file into the cache
+ * @param rfc Entry that was recorded
+ *
+ * Called when the file was read without errors.  The file is stat'd now,
+ * after reading, so a write that lands mid-read invalidates the entry.
+ */
+void rc_cache_record_finish(struct RcFileCache *rfc)
+{
+  if (!rfc)
+    return;
+
+  struct stat st = { 0 };
+  if (stat(rfc->path, &st) != 0)
+  {
+    rc_file_cache_free(&rfc);
+    return;
+  }
+
+  rfc->mtime = st.st_mtime;
+  rfc->size = st.st_size;
+  ARRAY_ADD(&RcCache, rfc);
+  RcCacheDirty = true;
+}
+
+/**
+ * rc_cache_record_abort - Discard a recorded config file
+ * @param ptr Entry that was being recorded
+ *
+ * Called when reading the file hit errors - its lines may be incomplete.
+ */
+void rc_cache_record_abort(struct RcFileCache **ptr)
+{
+  rc_file_cache_free(ptr);
+}
+
+/**
+ * rc_cache_cleanup - Save the config cache and free it
+ */
+void rc_cache_cleanup(void)
+{
+  struct RcFileCache **rfcp = NULL;
+
+  if (RcCacheDirty)
+  {
+    const char *cache_file = rc_cache_file();
+    if (cache_file)
+    {
+      unlink(cache_file); // mutt_file_fopen() won't overwrite an existing file
+      FILE *fp = mutt_file_fopen(cache_file, "w");
+      if (fp)
+      {
+        ARRAY_FOREACH(rfcp, &RcCache)
+        {
+          struct RcFileCache *rfc = *rfcp;
+          fprintf(fp, "file %lld %lld %s %s\n", (long long) rfc->mtime,
+                  (long long) rfc->size, rfc->charset ? rfc->charset : "-", rfc->path);
+          struct RcCacheLine *cl = NULL;
+          ARRAY_FOREACH(cl, &rfc->lines)
+          {
+            fprintf(fp, "%d %s\n", cl->lineno, cl->text);
+          }
+        }
+        mutt_file_fclose(&fp);
+      }
+    }
+  }
+
+  ARRAY_FOREACH(rfcp, &RcCache)
+  {
+    rc_file_cache_free(rfcp);
+  }
+  ARRAY_FREE(&RcCache);
+}
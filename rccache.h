@@ -0,0 +1,59 @@
+/**
+ * @file
+ * Cache of preprocessed config file lines
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_RCCACHE_H
+#define MUTT_RCCACHE_H
+
+#include <sys/types.h>
+#include <time.h>
+#include "mutt/lib.h"
+
+/**
+ * struct RcCacheLine - One logical line of a cached config file
+ */
+struct RcCacheLine
+{
+  int lineno; ///< Line number in the original file, for error messages
+  char *text; ///< Logical line, continuations joined and charset converted
+};
+ARRAY_HEAD(RcCacheLineArray, struct RcCacheLine);
+
+/**
+ * struct RcFileCache - Cached contents of one config file
+ */
+struct RcFileCache
+{
+  char *path;                    ///< Absolute path of the config file
+  char *charset;                 ///< `$config_charset` the lines were converted from
+  time_t mtime;                  ///< Modification time of the file when cached
+  off_t size;                    ///< Size of the file when cached
+  struct RcCacheLineArray lines; ///< The preprocessed lines
+};
+
+void                rc_cache_cleanup      (void);
+struct RcFileCache *rc_cache_find         (const char *path);
+void                rc_cache_record_abort (struct RcFileCache **ptr);
+void                rc_cache_record_line  (struct RcFileCache *rfc, int lineno, const char *line);
+struct RcFileCache *rc_cache_record_start (const char *path);
+void                rc_cache_record_finish(struct RcFileCache *rfc);
+
+#endif /* MUTT_RCCACHE_H */
@@ -252,21 +252,29 @@ void attach_bounce_message(struct Mailbox *m, FILE *fp, struct AttachCtx *actx,
   int rc = 0;
   if (b)
   {
-    rc = mutt_bounce_message(fp, m, b->email, &al, NeoMutt->sub);
+    rc = mutt_bounce_message(fp, m, b->email, &al, NULL, NeoMutt->sub);
   }
   else
   {
+    /* share one SMTP connection across the batch */
+    struct SmtpSession *smtp = NULL;
+    const char *const c_smtp_url = cs_subset_string(NeoMutt->sub, "smtp_url");
+    if (c_smtp_url && (num_msg > 1))
+      smtp = mutt_smtp_session_open(NeoMutt->sub);
+
     for (short i = 0; i < actx->idxlen; i++)
     {
       if (actx->idx[i]->body->tagged)
       {
         if (mutt_bounce_message(actx->idx[i]->fp, m, actx->idx[i]->body->email,
-                                &al, NeoMutt->sub))
+                                &al, smtp, NeoMutt->sub))
         {
           rc = 1;
         }
       }
     }
+
+    mutt_smtp_session_close(&smtp);
   }
 
   if (rc == 0)
@@ -35,6 +35,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -45,6 +46,9 @@
 
 #define FLOWED_MAX 72
 
+/// Number of reflowed parts to remember, e.g. one part at a few widths
+#define FLOWED_CACHE_SIZE 4
+
 /**
  * struct FlowedState - State of a Format-Flowed line of text
  */
@@ -55,6 +59,32 @@ struct FlowedState
   bool delsp;
 };
 
+/**
+ * struct FlowedCacheEntry - Memoized reflow output for one Body part
+ *
+ * Reflowing is deterministic in the part's content, the wrap width and a
+ * couple of config settings; everything that influences the output is part
+ * of the key, so re-displaying a part at a known width replays the stored
+ * bytes instead of re-flowing.
+ */
+struct FlowedCacheEntry
+{
+  struct Body *body;       ///< Part that was reflowed
+  LOFF_T offset;           ///< Body offset, guards against a recycled pointer
+  size_t length;           ///< Body length, guards against a recycled pointer
+  int wraplen;             ///< State::wraplen the output was made for
+  short reflow_wrap;       ///< $reflow_wrap at the time
+  bool space_quotes;       ///< $reflow_space_quotes at the time
+  char *text;              ///< Reflowed output
+  size_t len;              ///< Length of text
+  unsigned int last_used;  ///< LRU counter
+};
+
+/// Memoized reflow output, most recently displayed parts
+static struct FlowedCacheEntry FlowedCache[FLOWED_CACHE_SIZE];
+/// Monotonic counter backing the LRU ordering of #FlowedCache
+static unsigned int FlowedCacheCounter = 0;
+
 /**
  * get_quote_level - Get the quote level of a line
  * @param line Text to examine
@@ -152,11 +182,14 @@ static size_t print_indent(int ql, struct State *state, int add_suffix)
       wid = mutt_strwidth(state->prefix);
     }
   }
-  for (int i = 0; i < ql; i++)
+  if (space_quotes(state))
+  {
+    for (int i = 0; i < ql; i++)
+      state_put(state, "> ", 2);
+  }
+  else
   {
-    state_putc(state, '>');
-    if (space_quotes(state))
-      state_putc(state, ' ');
+    state_pad(state, '>', ql);
   }
   if (add_suffix)
     state_putc(state, ' ');
@@ -247,21 +280,35 @@ static void print_flowed_line(char *line, struct State *state, int ql,
   mutt_debug(LL_DEBUG5, "f=f: line [%s], width = %ld, spaces = %zu\n", line,
              (long) width, fst->spaces);
 
-  for (words = 0; (p = mutt_str_sep(&line, " "));)
+  char *end = NULL;
+  bool sep = false;
+  for (words = 0, p = line; p && (*p != '\0'); p = end)
   {
-    mutt_debug(LL_DEBUG5, "f=f: word [%s], width: %zu, remaining = [%s]\n", p,
-               fst->width, line);
+    /* the separator consumed when cutting the previous word, plus any run of
+     * extra spaces, counted in one span instead of one empty token each */
+    if (sep)
+      fst->spaces++;
+    sep = false;
+    const size_t run = strspn(p, " ");
+    if (run > 0)
+    {
+      mutt_debug(LL_DEBUG3, "f=f: %zu additional spaces\n", run);
+      fst->spaces += run;
+      p += run;
+      if (*p == '\0')
+        break;
+    }
 
-    /* remember number of spaces */
-    if (*p == '\0')
+    /* cut the word at the next space */
+    end = strchr(p, ' ');
+    if (end)
     {
-      mutt_debug(LL_DEBUG3, "f=f: additional space\n");
-      fst->spaces++;
-      continue;
+      *end++ = '\0';
+      sep = true;
     }
-    /* there's exactly one space prior to every but the first word */
-    if (words)
-      fst->spaces++;
+
+    mutt_debug(LL_DEBUG5, "f=f: word [%s], width: %zu, remaining = [%s]\n", p,
+               fst->width, NONULL(end));
 
     w = mutt_strwidth(p);
     /* see if we need to break the line but make sure the first word is put on
@@ -276,8 +323,7 @@ static void print_flowed_line(char *line, struct State *state, int ql,
       /* only honor trailing spaces for format=flowed replies */
       const bool c_text_flowed = cs_subset_bool(NeoMutt->sub, "text_flowed");
       if (c_text_flowed)
-        for (; fst->spaces; fst->spaces--)
-          state_putc(state, ' ');
+        state_pad(state, ' ', fst->spaces);
       state_putc(state, '\n');
       fst->width = 0;
       fst->spaces = 0;
@@ -287,12 +333,16 @@ static void print_flowed_line(char *line, struct State *state, int ql,
     if (!words && !fst->width)
       fst->width = print_indent(ql, state, add_quote_suffix(state, ql));
     fst->width += w + fst->spaces;
-    for (; fst->spaces; fst->spaces--)
-      state_putc(state, ' ');
+    state_pad(state, ' ', fst->spaces);
+    fst->spaces = 0;
     state_puts(state, p);
     words++;
   }
 
+  /* a trailing separator carries over to the next line of the paragraph */
+  if (sep)
+    fst->spaces++;
+
   if (term)
     flush_par(state, fst);
 }
@@ -317,10 +367,12 @@ static void print_fixed_line(const char *line, struct State *state, int ql,
 }
 
 /**
- * rfc3676_handler - Handler for format=flowed - Implements ::handler_t - @ingroup handler_api
+ * rfc3676_render - Reflow a format=flowed part
+ * @param b_email Body of the email
+ * @param state   State of the flowed text
  * @retval 0 Always
  */
-int rfc3676_handler(struct Body *b_email, struct State *state)
+static int rfc3676_render(struct Body *b_email, struct State *state)
 {
   char *buf = NULL;
   unsigned int quotelevel = 0;
@@ -386,6 +438,117 @@ int rfc3676_handler(struct Body *b_email, struct State *state)
   return 0;
 }
 
+/**
+ * flowed_cache_find - Look up memoized reflow output
+ * @param b_email Body of the email
+ * @param state   State of the flowed text
+ * @retval ptr Matching cache entry
+ * @retval NULL Not cached
+ */
+static struct FlowedCacheEntry *flowed_cache_find(struct Body *b_email, struct State *state)
+{
+  const short c_reflow_wrap = cs_subset_number(NeoMutt->sub, "reflow_wrap");
+  const bool c_reflow_space_quotes = cs_subset_bool(NeoMutt->sub, "reflow_space_quotes");
+
+  for (int i = 0; i < FLOWED_CACHE_SIZE; i++)
+  {
+    struct FlowedCacheEntry *entry = &FlowedCache[i];
+    if ((entry->body == b_email) && (entry->offset == b_email->offset) &&
+        (entry->length == b_email->length) && (entry->wraplen == state->wraplen) &&
+        (entry->reflow_wrap == c_reflow_wrap) &&
+        (entry->space_quotes == c_reflow_space_quotes) && entry->text)
+    {
+      entry->last_used = ++FlowedCacheCounter;
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * flowed_cache_store - Memoize reflow output, evicting the oldest entry
+ * @param b_email Body of the email
+ * @param state   State of the flowed text
+ * @param text    Reflowed output, becomes owned by the cache
+ * @param len     Length of text
+ */
+static void flowed_cache_store(struct Body *b_email, struct State *state,
+                               char *text, size_t len)
+{
+  const short c_reflow_wrap = cs_subset_number(NeoMutt->sub, "reflow_wrap");
+  const bool c_reflow_space_quotes = cs_subset_bool(NeoMutt->sub, "reflow_space_quotes");
+
+  struct FlowedCacheEntry *entry = &FlowedCache[0];
+  for (int i = 1; i < FLOWED_CACHE_SIZE; i++)
+  {
+    if (FlowedCache[i].last_used < entry->last_used)
+      entry = &FlowedCache[i];
+  }
+
+  FREE(&entry->text);
+  entry->body = b_email;
+  entry->offset = b_email->offset;
+  entry->length = b_email->length;
+  entry->wraplen = state->wraplen;
+  entry->reflow_wrap = c_reflow_wrap;
+  entry->space_quotes = c_reflow_space_quotes;
+  entry->text = text;
+  entry->len = len;
+  entry->last_used = ++FlowedCacheCounter;
+}
+
+/**
+ * rfc3676_handler - Handler for format=flowed - Implements ::handler_t - @ingroup handler_api
+ * @retval 0 Always
+ *
+ * Displaying memoizes the reflowed output: the pager re-renders a message
+ * whenever the window width changes, and reflowing a long part again would
+ * produce byte-identical output for a (part, width, $reflow_wrap) it has
+ * already done.  Replying and piping are left uncached - their output also
+ * depends on the prefix and reply settings, and they aren't repeated.
+ */
+int rfc3676_handler(struct Body *b_email, struct State *state)
+{
+  if (!(state->flags & STATE_DISPLAY) || (state->flags & STATE_REPLYING) || state->prefix)
+    return rfc3676_render(b_email, state);
+
+  struct FlowedCacheEntry *entry = flowed_cache_find(b_email, state);
+  if (entry)
+  {
+    mutt_debug(LL_DEBUG2, "f=f: replaying %zu cached bytes\n", entry->len);
+    fwrite(entry->text, 1, entry->len, state->fp_out);
+    return 0;
+  }
+
+  char *text = NULL;
+  size_t len = 0;
+  FILE *fp_mem = open_memstream(&text, &len);
+  if (!fp_mem)
+    return rfc3676_render(b_email, state);
+
+  struct State render_state = *state;
+  render_state.fp_out = fp_mem;
+  int rc = rfc3676_render(b_email, &render_state);
+  mutt_file_fclose(&fp_mem);
+
+  fwrite(text, 1, len, state->fp_out);
+  flowed_cache_store(b_email, state, text, len);
+  return rc;
+}
+
+/**
+ * mutt_rfc3676_cleanup - Free the memoized reflow output
+ */
+void mutt_rfc3676_cleanup(void)
+{
+  for (int i = 0; i < FLOWED_CACHE_SIZE; i++)
+  {
+    FREE(&FlowedCache[i].text);
+    memset(&FlowedCache[i], 0, sizeof(FlowedCache[i]));
+  }
+}
+
 /**
  * mutt_rfc3676_is_format_flowed - Is the Email "format-flowed"?
  * @param b Email Body to examine
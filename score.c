@@ -50,15 +50,147 @@
  */
 struct Score
 {
-  char *str;
-  struct PatternList *pat;
-  int val;
-  bool exact;         ///< If this rule matches, don't evaluate any more
-  struct Score *next; ///< Linked list
+  char *str;               ///< Pattern string
+  struct PatternList *pat; ///< Compiled pattern
+  int val;                 ///< Score to apply
+  bool exact;              ///< If this rule matches, don't evaluate any more
+  bool immutable;          ///< Rule only reads attributes fixed at parse time
 };
+ARRAY_HEAD(ScoreArray, struct Score);
 
-/// Linked list of email scoring rules
-static struct Score *ScoreList = NULL;
+/// Email scoring rules, applied in order in a single pass
+static struct ScoreArray Scores = ARRAY_HEAD_INITIALIZER;
+
+/// Generation of the scoring rules - Email::score_gen records it per message
+static int ScoreGen = 1;
+
+/// Do all the rules depend only on immutable attributes?
+static bool ScoresImmutable = true;
+
+/// Cached value of $score_threshold_delete
+static short ThresholdDelete = 0;
+/// Cached value of $score_threshold_flag
+static short ThresholdFlag = 0;
+/// Cached value of $score_threshold_read
+static short ThresholdRead = 0;
+/// Is the threshold cache primed and its observer registered?
+static bool ThresholdsActive = false;
+
+/**
+ * score_config_observer - Notification that a Config Variable has changed - Implements ::observer_t - @ingroup observer_api
+ */
+static int score_config_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_CONFIG)
+    return 0;
+  if (!nc->event_data)
+    return -1;
+
+  struct EventConfig *ev_c = nc->event_data;
+  if (!ev_c->name || !ev_c->he)
+    return 0;
+
+  if (mutt_str_equal(ev_c->name, "score_threshold_delete"))
+    ThresholdDelete = (short) cs_subset_he_native_get(ev_c->sub, ev_c->he, NULL);
+  else if (mutt_str_equal(ev_c->name, "score_threshold_flag"))
+    ThresholdFlag = (short) cs_subset_he_native_get(ev_c->sub, ev_c->he, NULL);
+  else if (mutt_str_equal(ev_c->name, "score_threshold_read"))
+    ThresholdRead = (short) cs_subset_he_native_get(ev_c->sub, ev_c->he, NULL);
+
+  return 0;
+}
+
+/**
+ * score_thresholds_setup - Prime the cache of the $score_threshold_* config
+ *
+ * Scoring runs per message while a mailbox loads; caching the thresholds
+ * saves three config lookups for every Email.
+ */
+static void score_thresholds_setup(void)
+{
+  if (ThresholdsActive)
+    return;
+
+  notify_observer_add(NeoMutt->sub->notify, NT_CONFIG, score_config_observer, NULL);
+
+  ThresholdDelete = cs_subset_number(NeoMutt->sub, "score_threshold_delete");
+  ThresholdFlag = cs_subset_number(NeoMutt->sub, "score_threshold_flag");
+  ThresholdRead = cs_subset_number(NeoMutt->sub, "score_threshold_read");
+
+  ThresholdsActive = true;
+}
+
+/**
+ * score_pattern_immutable - Does a pattern depend only on fixed attributes?
+ * @param pats Compiled pattern
+ * @retval true Pattern only reads attributes set when the message was parsed
+ *
+ * Header, address, date and size attributes can't change once a message has
+ * been scored, so matches against them never need recalculating.  Flags,
+ * thread state, labels and the like can change at any time.
+ */
+static bool score_pattern_immutable(struct PatternList *pats)
+{
+  struct Pattern *pat = NULL;
+  SLIST_FOREACH(pat, pats, entries)
+  {
+    switch (pat->op)
+    {
+      case MUTT_PAT_AND:
+      case MUTT_PAT_OR:
+        if (!score_pattern_immutable(pat->child))
+          return false;
+        break;
+      case MUTT_PAT_ADDRESS:
+      case MUTT_PAT_BCC:
+      case MUTT_PAT_BODY:
+      case MUTT_PAT_CC:
+      case MUTT_PAT_DATE:
+      case MUTT_PAT_DATE_RECEIVED:
+      case MUTT_PAT_FROM:
+      case MUTT_PAT_HEADER:
+      case MUTT_PAT_HORMEL:
+      case MUTT_PAT_ID:
+      case MUTT_PAT_LIST:
+      case MUTT_PAT_MIMETYPE:
+      case MUTT_PAT_NEWSGROUPS:
+      case MUTT_PAT_PERSONAL_FROM:
+      case MUTT_PAT_PERSONAL_RECIP:
+      case MUTT_PAT_RECIPIENT:
+      case MUTT_PAT_REFERENCE:
+      case MUTT_PAT_SENDER:
+      case MUTT_PAT_SIZE:
+      case MUTT_PAT_SUBJECT:
+      case MUTT_PAT_SUBSCRIBED_LIST:
+      case MUTT_PAT_TO:
+      case MUTT_PAT_WHOLE_MSG:
+        if (pat->dynamic)
+          return false;
+        break;
+      default: // flags, threads, score, labels, tags, crypto, ...
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * scores_recalc_immutable - Recalculate whether every rule is immutable
+ */
+static void scores_recalc_immutable(void)
+{
+  ScoresImmutable = true;
+  struct Score *sc = NULL;
+  ARRAY_FOREACH(sc, &Scores)
+  {
+    if (!sc->immutable)
+    {
+      ScoresImmutable = false;
+      break;
+    }
+  }
+}
 
 /**
  * mutt_check_rescore - Do the emails need to have their scores recalculated?
@@ -90,7 +222,6 @@ void mutt_check_rescore(struct Mailbox *m)
 enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s,
                                     intptr_t data, struct Buffer *err)
 {
-  struct Score *ptr = NULL, *last = NULL;
   char *pattern = NULL, *pc = NULL;
 
   parse_extract_token(buf, s, TOKEN_NO_FLAGS);
@@ -108,12 +239,36 @@ enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s,
     return MUTT_CMD_WARNING;
   }
 
+  /* parse the score value first, so an error leaves the rules untouched */
+  pc = buf->data;
+  bool exact = false;
+  if (*pc == '=')
+  {
+    exact = true;
+    pc++;
+  }
+  int val = 0;
+  if (!mutt_str_atoi_full(pc, &val))
+  {
+    FREE(&pattern);
+    buf_strcpy(err, _("Error: score: invalid number"));
+    return MUTT_CMD_ERROR;
+  }
+
   /* look for an existing entry and update the value, else add it to the end
    * of the list */
-  for (ptr = ScoreList, last = NULL; ptr; last = ptr, ptr = ptr->next)
-    if (mutt_str_equal(pattern, ptr->str))
+  struct Score *ptr = NULL;
+  struct Score *sc = NULL;
+  ARRAY_FOREACH(sc, &Scores)
+  {
+    if (mutt_str_equal(pattern, sc->str))
+    {
+      ptr = sc;
       break;
+    }
+  }
 
+  bool changed = false;
   if (ptr)
   {
     /* 'buf' arg was cleared and 'pattern' holds the only reference;
@@ -131,27 +286,24 @@ enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s,
       FREE(&pattern);
       return MUTT_CMD_ERROR;
     }
-    ptr = mutt_mem_calloc(1, sizeof(struct Score));
-    if (last)
-      last->next = ptr;
-    else
-      ScoreList = ptr;
-    ptr->pat = pat;
-    ptr->str = pattern;
-  }
-  pc = buf->data;
-  if (*pc == '=')
-  {
-    ptr->exact = true;
-    pc++;
+    struct Score sc_new = { pattern, pat, 0, false, score_pattern_immutable(pat) };
+    ARRAY_ADD(&Scores, sc_new);
+    ptr = ARRAY_LAST(&Scores);
+    if (!ptr->immutable)
+      ScoresImmutable = false;
+    changed = true;
   }
-  if (!mutt_str_atoi_full(pc, &ptr->val))
+
+  changed |= ((ptr->val != val) || (ptr->exact != exact));
+  ptr->val = val;
+  ptr->exact = exact;
+
+  /* Re-sourcing an unchanged config mustn't trigger a full rescore */
+  if (changed)
   {
-    FREE(&pattern);
-    buf_strcpy(err, _("Error: score: invalid number"));
-    return MUTT_CMD_ERROR;
+    ScoreGen++;
+    OptNeedRescore = true;
   }
-  OptNeedRescore = true;
   return MUTT_CMD_SUCCESS;
 }
 
@@ -163,34 +315,37 @@ enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s,
  */
 void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
 {
-  struct Score *tmp = NULL;
+  /* Nothing this message is scored on has changed since it was last scored */
+  if (ScoresImmutable && (e->score_gen == ScoreGen))
+    return;
+
   struct PatternCache cache = { 0 };
 
   e->score = 0; /* in case of re-scoring */
-  for (tmp = ScoreList; tmp; tmp = tmp->next)
+  struct Score *sc = NULL;
+  ARRAY_FOREACH(sc, &Scores)
   {
-    if (mutt_pattern_exec(SLIST_FIRST(tmp->pat), MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
+    if (mutt_pattern_exec(SLIST_FIRST(sc->pat), MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
     {
-      if (tmp->exact || (tmp->val == 9999) || (tmp->val == -9999))
+      if (sc->exact || (sc->val == 9999) || (sc->val == -9999))
       {
-        e->score = tmp->val;
+        e->score = sc->val;
         break;
       }
-      e->score += tmp->val;
+      e->score += sc->val;
     }
   }
   if (e->score < 0)
     e->score = 0;
+  e->score_gen = ScoreGen;
 
-  const short c_score_threshold_delete = cs_subset_number(NeoMutt->sub, "score_threshold_delete");
-  const short c_score_threshold_flag = cs_subset_number(NeoMutt->sub, "score_threshold_flag");
-  const short c_score_threshold_read = cs_subset_number(NeoMutt->sub, "score_threshold_read");
+  score_thresholds_setup();
 
-  if (e->score <= c_score_threshold_delete)
+  if (e->score <= ThresholdDelete)
     mutt_set_flag(m, e, MUTT_DELETE, true, upd_mbox);
-  if (e->score <= c_score_threshold_read)
+  if (e->score <= ThresholdRead)
     mutt_set_flag(m, e, MUTT_READ, true, upd_mbox);
-  if (e->score >= c_score_threshold_flag)
+  if (e->score >= ThresholdFlag)
     mutt_set_flag(m, e, MUTT_FLAG, true, upd_mbox);
 }
 
@@ -200,40 +355,44 @@ void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
 enum CommandResult mutt_parse_unscore(struct Buffer *buf, struct Buffer *s,
                                       intptr_t data, struct Buffer *err)
 {
-  struct Score *tmp = NULL, *last = NULL;
+  struct Score *sc = NULL;
+  bool changed = false;
 
   while (MoreArgs(s))
   {
     parse_extract_token(buf, s, TOKEN_NO_FLAGS);
     if (mutt_str_equal("*", buf->data))
     {
-      for (tmp = ScoreList; tmp;)
+      changed |= !ARRAY_EMPTY(&Scores);
+      ARRAY_FOREACH(sc, &Scores)
       {
-        last = tmp;
-        tmp = tmp->next;
-        mutt_pattern_free(&last->pat);
-        FREE(&last);
+        mutt_pattern_free(&sc->pat);
+        FREE(&sc->str);
       }
-      ScoreList = NULL;
+      ARRAY_FREE(&Scores);
+      ScoresImmutable = true;
     }
     else
     {
-      for (tmp = ScoreList; tmp; last = tmp, tmp = tmp->next)
+      ARRAY_FOREACH(sc, &Scores)
       {
-        if (mutt_str_equal(buf->data, tmp->str))
+        if (mutt_str_equal(buf->data, sc->str))
         {
-          if (last)
-            last->next = tmp->next;
-          else
-            ScoreList = tmp->next;
-          mutt_pattern_free(&tmp->pat);
-          FREE(&tmp);
+          mutt_pattern_free(&sc->pat);
+          FREE(&sc->str);
+          ARRAY_REMOVE(&Scores, sc);
+          scores_recalc_immutable();
+          changed = true;
           /* there should only be one score per pattern, so we can stop here */
           break;
         }
       }
     }
   }
-  OptNeedRescore = true;
+  if (changed)
+  {
+    ScoreGen++;
+    OptNeedRescore = true;
+  }
   return MUTT_CMD_SUCCESS;
 }
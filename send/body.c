@@ -120,6 +120,47 @@ static void encode_base64(struct FgetConv *fc, FILE *fp_out, int istext)
   fputc('\n', fp_out);
 }
 
+/**
+ * encode_base64_stream - Base64-encode a file in large blocks
+ * @param fp_in  File to read from
+ * @param fp_out File to store the result
+ *
+ * Fast path for attachments that need no charset conversion and no CRLF
+ * fix-ups: read the input in bulk and encode 54-byte groups straight into
+ * 72-character output lines, the same shape encode_base64() produces a byte
+ * at a time.  On large binary attachments this is the difference between
+ * being stdio-call bound and memory-bandwidth bound.
+ */
+static void encode_base64_stream(FILE *fp_in, FILE *fp_out)
+{
+  char in[54 * 64];
+  char out[73 * 64 + 8];
+  size_t len;
+  bool wrote = false;
+
+  while ((len = fread(in, 1, sizeof(in), fp_in)) > 0)
+  {
+    if (SigInt)
+    {
+      SigInt = false;
+      return;
+    }
+
+    char *p = out;
+    for (size_t off = 0; off < len; off += 54)
+    {
+      const size_t n = MIN(54, len - off);
+      p += mutt_b64_encode(in + off, n, p, 77);
+      *p++ = '\n';
+    }
+    fwrite(out, 1, p - out, fp_out);
+    wrote = true;
+  }
+
+  if (!wrote)
+    fputc('\n', fp_out); // Match encode_base64() on empty input
+}
+
 /**
  * encode_8bit - Write the data as raw 8-bit data
  * @param fc     Cursor for converting a file's encoding
@@ -358,9 +399,16 @@ int mutt_write_mime_body(struct Body *b, FILE *fp, struct ConfigSubset *sub)
 
   mutt_sig_allow_interrupt(true);
   if (b->encoding == ENC_QUOTED_PRINTABLE)
+  {
     encode_quoted(fc, fp, write_as_text_part(b));
+  }
   else if (b->encoding == ENC_BASE64)
-    encode_base64(fc, fp, write_as_text_part(b));
+  {
+    if (!write_as_text_part(b) && ((b->type != TYPE_TEXT) || b->noconv))
+      encode_base64_stream(fp_in, fp);
+    else
+      encode_base64(fc, fp, write_as_text_part(b));
+  }
   else if ((b->type == TYPE_TEXT) && (!b->noconv))
     encode_8bit(fc, fp);
   else
@@ -1480,6 +1480,29 @@ struct Address *mutt_default_from(struct ConfigSubset *sub)
   return mutt_addr_create(NULL, mailbox);
 }
 
+/// Render messages up to this size in memory before spooling them
+#define MTA_MAX_MEM_SIZE (16 << 20)
+
+/**
+ * body_size - Total size of a Body tree's contents
+ * @param b Body to measure
+ * @retval num Size in bytes
+ *
+ * Multipart containers themselves have no length; their parts carry the
+ * sizes set when the attachments were encoded.
+ */
+static LOFF_T body_size(const struct Body *b)
+{
+  LOFF_T size = 0;
+  for (; b; b = b->next)
+  {
+    size += b->length;
+    if (b->parts)
+      size += body_size(b->parts);
+  }
+  return size;
+}
+
 /**
  * invoke_mta - Send an email
  * @param m   Mailbox
@@ -1491,30 +1514,61 @@ struct Address *mutt_default_from(struct ConfigSubset *sub)
 static int invoke_mta(struct Mailbox *m, struct Email *e, struct ConfigSubset *sub)
 {
   struct Buffer *tempfile = NULL;
+  char *mem = NULL;
+  size_t memlen = 0;
+  FILE *fp_mem = NULL;
+  FILE *fp_tmp = NULL;
   int rc = -1;
 
-  /* Write out the message in MIME form. */
   tempfile = buf_pool_get();
   buf_mktemp(tempfile);
-  FILE *fp_tmp = mutt_file_fopen(buf_string(tempfile), "w");
-  if (!fp_tmp)
-    goto cleanup;
+
+  /* Write out the message in MIME form.
+   *
+   * Ordinary messages are rendered into memory and flushed to the spool file
+   * with a single write; rendering piecemeal to the file costs many small
+   * writes, which hurts when temp files live on a networked filesystem.
+   * Oversized messages are streamed straight to disk as before. */
+  if (body_size(e->body) <= MTA_MAX_MEM_SIZE)
+    fp_mem = open_memstream(&mem, &memlen);
+  if (!fp_mem)
+  {
+    fp_tmp = mutt_file_fopen(buf_string(tempfile), "w");
+    if (!fp_tmp)
+      goto cleanup;
+  }
+  FILE *fp_out = fp_mem ? fp_mem : fp_tmp;
 
   const bool c_write_bcc = cs_subset_bool(sub, "write_bcc");
   const char *const c_smtp_url = cs_subset_string(sub, "smtp_url");
   if (c_smtp_url)
     cs_subset_str_native_set(sub, "write_bcc", false, NULL);
 
-  mutt_rfc822_write_header(fp_tmp, e->env, e->body, MUTT_WRITE_HEADER_NORMAL,
+  mutt_rfc822_write_header(fp_out, e->env, e->body, MUTT_WRITE_HEADER_NORMAL,
                            false, mutt_should_hide_protected_subject(e), sub);
 
   cs_subset_str_native_set(sub, "write_bcc", c_write_bcc, NULL);
 
-  fputc('\n', fp_tmp); /* tie off the header. */
+  fputc('\n', fp_out); /* tie off the header. */
 
-  if ((mutt_write_mime_body(e->body, fp_tmp, sub) == -1))
+  if ((mutt_write_mime_body(e->body, fp_out, sub) == -1))
     goto cleanup;
 
+  if (fp_mem)
+  {
+    if (mutt_file_fclose(&fp_mem) != 0)
+      goto cleanup;
+    fp_tmp = mutt_file_fopen(buf_string(tempfile), "w");
+    if (!fp_tmp)
+      goto cleanup;
+    if (fwrite(mem, 1, memlen, fp_tmp) != memlen)
+    {
+      mutt_perror("%s", buf_string(tempfile));
+      goto cleanup;
+    }
+    FREE(&mem);
+  }
+
   if (mutt_file_fclose(&fp_tmp) != 0)
   {
     mutt_perror("%s", buf_string(tempfile));
@@ -1536,6 +1590,8 @@ sendmail:
   rc = mutt_invoke_sendmail(m, &e->env->from, &e->env->to, &e->env->cc, &e->env->bcc,
                             buf_string(tempfile), (e->body->encoding == ENC_8BIT), sub);
 cleanup:
+  mutt_file_fclose(&fp_mem);
+  FREE(&mem);
   if (fp_tmp)
   {
     mutt_file_fclose(&fp_tmp);
@@ -30,7 +30,6 @@
  */
 
 #include "config.h"
-#include <ctype.h>
 #include <inttypes.h> // IWYU pragma: keep
 #include <limits.h>
 #include <stdbool.h>
@@ -61,130 +60,209 @@
 #include "sendmail.h"
 #include "smtp.h"
 
+/// Number of files checked by mime_types_path()
+#define MIME_TYPES_FILES 4
+
 /**
- * mutt_lookup_mime_type - Find the MIME type for an attachment
- * @param b    Email with attachment
- * @param path Path to attachment
- * @retval enum #ContentType, e.g. #TYPE_IMAGE
+ * struct MimeTypeEntry - Cached mime.types entry for one file extension
+ */
+struct MimeTypeEntry
+{
+  enum ContentType type; ///< Major type, e.g. #TYPE_IMAGE
+  char *subtype;         ///< Subtype, e.g. "jpeg"
+  char *xtype;           ///< Non-standard major type, or NULL
+};
+
+/// Map of file extension to MimeTypeEntry
+static struct HashTable *MimeTypes = NULL;
+/// At least one mime.types file was found
+static bool MimeTypesFound = false;
+/// mtimes of the mime.types files when the cache was built
+static time_t MimeTypesMtime[MIME_TYPES_FILES];
+
+/**
+ * mime_types_path - Get the path of one of the mime.types files
+ * @param count  Index of the file, 0 to #MIME_TYPES_FILES-1
+ * @param buf    Buffer for the path
+ * @param buflen Length of buffer
  *
- * Given a file at 'path', see if there is a registered MIME type.
- * Returns the major MIME type, and copies the subtype to "d".  First look
- * in a system mime.types if we can find one, then look for ~/.mime.types.
- * The longest match is used so that we can match 'ps.gz' when 'gz' also
- * exists.
+ * The files are ordered so that the last file to define an extension wins.
  */
-enum ContentType mutt_lookup_mime_type(struct Body *b, const char *path)
+static void mime_types_path(int count, char *buf, size_t buflen)
 {
-  FILE *fp = NULL;
-  char *p = NULL, *q = NULL, *ct = NULL;
-  char buf[PATH_MAX] = { 0 };
-  char subtype[256] = { 0 };
-  char xtype[256] = { 0 };
-  int sze, cur_sze = 0;
-  bool found_mimetypes = false;
-  enum ContentType type = TYPE_OTHER;
+  switch (count)
+  {
+    case 0:
+      /* check default unix mimetypes location first */
+      mutt_str_copy(buf, "/etc/mime.types", buflen);
+      break;
+    case 1:
+      mutt_str_copy(buf, SYSCONFDIR "/mime.types", buflen);
+      break;
+    case 2:
+      mutt_str_copy(buf, PKGDATADIR "/mime.types", buflen);
+      break;
+    case 3:
+      snprintf(buf, buflen, "%s/.mime.types", NONULL(HomeDir));
+      break;
+    default:
+      mutt_debug(LL_DEBUG1, "Internal error, count = %d\n", count);
+      buf[0] = '\0'; /* shouldn't happen */
+      break;
+  }
+}
 
-  int szf = mutt_str_len(path);
+/**
+ * mime_type_entry_free - Free a MimeTypeEntry - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void mime_type_entry_free(int type, void *obj, intptr_t data)
+{
+  struct MimeTypeEntry *me = obj;
+  FREE(&me->subtype);
+  FREE(&me->xtype);
+  FREE(&me);
+}
+
+/**
+ * mime_types_parse_file - Add the entries of one mime.types file to the cache
+ * @param file File to parse
+ * @retval true The file was found
+ *
+ * Entries are inserted keyed by extension, overwriting any earlier entry for
+ * the same extension.
+ */
+static bool mime_types_parse_file(const char *file)
+{
+  FILE *fp = mutt_file_fopen(file, "r");
+  if (!fp)
+    return false;
+
+  char buf[PATH_MAX] = { 0 };
 
-  for (int count = 0; count < 4; count++)
+  while (fgets(buf, sizeof(buf) - 1, fp))
   {
-    /* can't use strtok() because we use it in an inner loop below, so use
-     * a switch statement here instead.  */
-    switch (count)
-    {
-      /* last file with last entry to match wins type/xtype */
-      case 0:
-        /* check default unix mimetypes location first */
-        mutt_str_copy(buf, "/etc/mime.types", sizeof(buf));
-        break;
-      case 1:
-        mutt_str_copy(buf, SYSCONFDIR "/mime.types", sizeof(buf));
-        break;
-      case 2:
-        mutt_str_copy(buf, PKGDATADIR "/mime.types", sizeof(buf));
-        break;
-      case 3:
-        snprintf(buf, sizeof(buf), "%s/.mime.types", NONULL(HomeDir));
-        break;
-      default:
-        mutt_debug(LL_DEBUG1, "Internal error, count = %d\n", count);
-        goto bye; /* shouldn't happen */
-    }
+    /* weed out any comments */
+    char *p = strchr(buf, '#');
+    if (p)
+      *p = '\0';
 
-    fp = mutt_file_fopen(buf, "r");
-    if (fp)
-    {
-      found_mimetypes = true;
+    /* remove any leading space. */
+    char *ct = buf;
+    SKIPWS(ct);
+
+    /* position on the next field in this line */
+    p = strpbrk(ct, " \t");
+    if (!p)
+      continue;
+    *p++ = '\0';
+    SKIPWS(p);
+
+    /* get the content-type */
+    char *subtype = strchr(ct, '/');
+    if (!subtype)
+      continue; /* malformed line, just skip it. */
+    *subtype++ = '\0';
+
+    const enum ContentType type = mutt_check_mime_type(ct);
 
-      while (fgets(buf, sizeof(buf) - 1, fp))
+    /* cycle through the file extensions */
+    while ((p = strtok(p, " \t\n")))
+    {
+      struct MimeTypeEntry *me = mutt_hash_find(MimeTypes, p);
+      if (!me)
       {
-        /* weed out any comments */
-        p = strchr(buf, '#');
-        if (p)
-          *p = '\0';
-
-        /* remove any leading space. */
-        ct = buf;
-        SKIPWS(ct);
-
-        /* position on the next field in this line */
-        p = strpbrk(ct, " \t");
-        if (!p)
-          continue;
-        *p++ = 0;
-        SKIPWS(p);
-
-        /* cycle through the file extensions */
-        while ((p = strtok(p, " \t\n")))
-        {
-          sze = mutt_str_len(p);
-          if ((sze > cur_sze) && (szf >= sze) && mutt_istr_equal(path + szf - sze, p) &&
-              ((szf == sze) || (path[szf - sze - 1] == '.')))
-          {
-            /* get the content-type */
-
-            p = strchr(ct, '/');
-            if (!p)
-            {
-              /* malformed line, just skip it. */
-              break;
-            }
-            *p++ = 0;
-
-            for (q = p; *q && !isspace(*q); q++)
-              ; // do nothing
-
-            mutt_strn_copy(subtype, p, q - p, sizeof(subtype));
-
-            type = mutt_check_mime_type(ct);
-            if (type == TYPE_OTHER)
-              mutt_str_copy(xtype, ct, sizeof(xtype));
-
-            cur_sze = sze;
-          }
-          p = NULL;
-        }
+        me = mutt_mem_calloc(1, sizeof(*me));
+        mutt_hash_insert(MimeTypes, p, me);
       }
-      mutt_file_fclose(&fp);
+      me->type = type;
+      mutt_str_replace(&me->subtype, subtype);
+      mutt_str_replace(&me->xtype, (type == TYPE_OTHER) ? ct : NULL);
+      p = NULL;
     }
   }
+  mutt_file_fclose(&fp);
+  return true;
+}
 
-bye:
+/**
+ * mime_types_cache_update - Ensure the mime.types cache is up-to-date
+ *
+ * Build the extension map on first use and rebuild it if any of the
+ * mime.types files has changed; otherwise checking costs one stat() per file.
+ */
+static void mime_types_cache_update(void)
+{
+  char path[PATH_MAX] = { 0 };
+  struct stat st = { 0 };
+  time_t mtime[MIME_TYPES_FILES] = { 0 };
+  bool dirty = !MimeTypes;
+
+  for (int count = 0; count < MIME_TYPES_FILES; count++)
+  {
+    mime_types_path(count, path, sizeof(path));
+    if (stat(path, &st) == 0)
+      mtime[count] = st.st_mtime;
+    if (mtime[count] != MimeTypesMtime[count])
+      dirty = true;
+  }
+
+  if (!dirty)
+    return;
+
+  mutt_hash_free(&MimeTypes);
+  MimeTypes = mutt_hash_new(256, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+  mutt_hash_set_destructor(MimeTypes, mime_type_entry_free, 0);
+  MimeTypesFound = false;
+
+  /* last file with last entry to match wins type/xtype */
+  for (int count = 0; count < MIME_TYPES_FILES; count++)
+  {
+    mime_types_path(count, path, sizeof(path));
+    if (mime_types_parse_file(path))
+      MimeTypesFound = true;
+    MimeTypesMtime[count] = mtime[count];
+  }
+}
+
+/**
+ * mutt_lookup_mime_type - Find the MIME type for an attachment
+ * @param b    Email with attachment
+ * @param path Path to attachment
+ * @retval enum #ContentType, e.g. #TYPE_IMAGE
+ *
+ * Given a file at 'path', see if there is a registered MIME type.
+ * Returns the major MIME type, and copies the subtype to "d".  First look
+ * in a system mime.types if we can find one, then look for ~/.mime.types.
+ * The longest match is used so that we can match 'ps.gz' when 'gz' also
+ * exists.
+ */
+enum ContentType mutt_lookup_mime_type(struct Body *b, const char *path)
+{
+  mime_types_cache_update();
 
   /* no mime.types file found */
-  if (!found_mimetypes)
+  if (!MimeTypesFound)
   {
     mutt_error(_("Could not find any mime.types file"));
   }
 
-  if ((type != TYPE_OTHER) || (*xtype != '\0'))
+  /* The earliest candidate to match is the longest one,
+   * so 'ps.gz' wins over 'gz' */
+  struct MimeTypeEntry *me = mutt_hash_find(MimeTypes, path);
+  for (const char *p = path; !me && (p = strchr(p, '.')); )
   {
-    b->type = type;
-    mutt_str_replace(&b->subtype, subtype);
-    mutt_str_replace(&b->xtype, xtype);
+    p++;
+    me = mutt_hash_find(MimeTypes, p);
   }
 
-  return type;
+  if (!me)
+    return TYPE_OTHER;
+
+  b->type = me->type;
+  mutt_str_replace(&b->subtype, me->subtype);
+  mutt_str_replace(&b->xtype, me->xtype);
+
+  return me->type;
 }
 
 /**
@@ -754,17 +832,19 @@ char *mutt_gen_msgid(void)
 {
   const int ID_LEFT_LEN = 50;
   const int ID_RIGHT_LEN = 12;
-  char rnd_id_left[ID_LEFT_LEN + 1];
-  char rnd_id_right[ID_RIGHT_LEN + 1];
-  char buf[128] = { 0 };
 
-  mutt_rand_base32(rnd_id_left, sizeof(rnd_id_left) - 1);
-  mutt_rand_base32(rnd_id_right, sizeof(rnd_id_right) - 1);
-  rnd_id_left[ID_LEFT_LEN] = 0;
-  rnd_id_right[ID_RIGHT_LEN] = 0;
+  // "<left@right>" plus a terminating NUL
+  const size_t idlen = 1 + ID_LEFT_LEN + 1 + ID_RIGHT_LEN + 2;
+  char *buf = mutt_mem_malloc(idlen);
+
+  buf[0] = '<';
+  mutt_rand_base32(buf + 1, ID_LEFT_LEN);
+  buf[1 + ID_LEFT_LEN] = '@';
+  mutt_rand_base32(buf + 2 + ID_LEFT_LEN, ID_RIGHT_LEN);
+  buf[idlen - 2] = '>';
+  buf[idlen - 1] = '\0';
 
-  snprintf(buf, sizeof(buf), "<%s@%s>", rnd_id_left, rnd_id_right);
-  return mutt_str_dup(buf);
+  return buf;
 }
 
 /**
@@ -838,13 +918,15 @@ void mutt_unprepare_envelope(struct Envelope *env)
  * @param to          Address to bounce to
  * @param resent_from Address of new sender
  * @param env_from    Envelope of original sender
+ * @param smtp        SMTP session to reuse, or NULL to send stand-alone
  * @param sub         Config Subset
  * @retval  0 Success
  * @retval -1 Failure
  */
 static int bounce_message(FILE *fp, struct Mailbox *m, struct Email *e,
                           struct AddressList *to, const char *resent_from,
-                          struct AddressList *env_from, struct ConfigSubset *sub)
+                          struct AddressList *env_from, struct SmtpSession *smtp,
+                          struct ConfigSubset *sub)
 {
   if (!e)
     return -1;
@@ -888,7 +970,12 @@ static int bounce_message(FILE *fp, struct Mailbox *m, struct Email *e,
       return -1;
     }
     const char *const c_smtp_url = cs_subset_string(sub, "smtp_url");
-    if (c_smtp_url)
+    if (smtp)
+    {
+      rc = mutt_smtp_session_send(smtp, env_from, to, NULL, NULL,
+                                  buf_string(tempfile), (e->body->encoding == ENC_8BIT));
+    }
+    else if (c_smtp_url)
     {
       rc = mutt_smtp_send(env_from, to, NULL, NULL, buf_string(tempfile),
                           (e->body->encoding == ENC_8BIT), sub);
@@ -909,13 +996,18 @@ static int bounce_message(FILE *fp, struct Mailbox *m, struct Email *e,
  * @param fp  Handle of message
  * @param m   Mailbox
  * @param e   Email
- * @param to  AddressList to bounce to
- * @param sub Config Subset
+ * @param to   AddressList to bounce to
+ * @param smtp SMTP session to reuse, or NULL to send stand-alone
+ * @param sub  Config Subset
  * @retval  0 Success
  * @retval -1 Failure
+ *
+ * When bouncing several messages over SMTP, open a session with
+ * mutt_smtp_session_open() and pass it in, so they share one connection.
  */
 int mutt_bounce_message(FILE *fp, struct Mailbox *m, struct Email *e,
-                        struct AddressList *to, struct ConfigSubset *sub)
+                        struct AddressList *to, struct SmtpSession *smtp,
+                        struct ConfigSubset *sub)
 {
   if (!fp || !e || !to || TAILQ_EMPTY(to))
     return -1;
@@ -960,7 +1052,7 @@ int mutt_bounce_message(FILE *fp, struct Mailbox *m, struct Email *e,
   struct AddressList resent_to = TAILQ_HEAD_INITIALIZER(resent_to);
   mutt_addrlist_copy(&resent_to, to, false);
   rfc2047_encode_addrlist(&resent_to, "Resent-To");
-  int rc = bounce_message(fp, m, e, &resent_to, buf_string(resent_from), &from_list, sub);
+  int rc = bounce_message(fp, m, e, &resent_to, buf_string(resent_from), &from_list, smtp, sub);
   mutt_addrlist_clear(&resent_to);
   mutt_addrlist_clear(&from_list);
   buf_pool_release(&resent_from);
@@ -31,10 +31,11 @@
 struct AddressList;
 struct ConfigSubset;
 struct Mailbox;
+struct SmtpSession;
 
 #define MUTT_RANDTAG_LEN 16
 
-int              mutt_bounce_message     (FILE *fp, struct Mailbox *m, struct Email *e, struct AddressList *to, struct ConfigSubset *sub);
+int              mutt_bounce_message     (FILE *fp, struct Mailbox *m, struct Email *e, struct AddressList *to, struct SmtpSession *smtp, struct ConfigSubset *sub);
 const char *     mutt_fqdn               (bool may_hide_host, const struct ConfigSubset *sub);
 char *           mutt_gen_msgid          (void);
 enum ContentType mutt_lookup_mime_type   (struct Body *b, const char *path);
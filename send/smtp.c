@@ -87,7 +87,9 @@ typedef uint8_t SmtpCapFlags;          ///< Flags, e.g. #SMTP_CAP_STARTTLS
 #define SMTP_CAP_DSN          (1 << 2) ///< Server supports Delivery Status Notification
 #define SMTP_CAP_EIGHTBITMIME (1 << 3) ///< Server supports 8-bit MIME content
 #define SMTP_CAP_SMTPUTF8     (1 << 4) ///< Server accepts UTF-8 strings
-#define SMTP_CAP_ALL         ((1 << 5) - 1)
+#define SMTP_CAP_PIPELINING   (1 << 5) ///< Server supports command pipelining (RFC 2920)
+#define SMTP_CAP_CHUNKING     (1 << 6) ///< Server supports the BDAT command (RFC 3030)
+#define SMTP_CAP_ALL         ((1 << 7) - 1)
 // clang-format on
 
 /**
@@ -176,6 +178,14 @@ static int smtp_get_resp(struct SmtpAccountData *adata)
     {
       adata->capabilities |= SMTP_CAP_SMTPUTF8;
     }
+    else if (mutt_istr_startswith(s, "PIPELINING"))
+    {
+      adata->capabilities |= SMTP_CAP_PIPELINING;
+    }
+    else if (mutt_istr_startswith(s, "CHUNKING"))
+    {
+      adata->capabilities |= SMTP_CAP_CHUNKING;
+    }
 
     if (!valid_smtp_code(buf, &n))
       return SMTP_ERR_CODE;
@@ -232,13 +242,54 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
 }
 
 /**
- * smtp_data - Send data to an SMTP server
+ * smtp_add_rcpts - Append RCPT TO commands for an AddressList
+ * @param[in]     adata SMTP Account data
+ * @param[in]     al    AddressList to use
+ * @param[out]    cmds  Buffer to append the commands to
+ * @param[in,out] ncmds Number of commands appended
+ *
+ * Used when the server supports PIPELINING and the whole envelope is sent in
+ * one write.
+ */
+static void smtp_add_rcpts(struct SmtpAccountData *adata, const struct AddressList *al,
+                           struct Buffer *cmds, int *ncmds)
+{
+  if (!al)
+    return;
+
+  const char *const c_dsn_notify = cs_subset_string(adata->sub, "dsn_notify");
+
+  struct Address *a = NULL;
+  TAILQ_FOREACH(a, al, entries)
+  {
+    /* weed out group mailboxes, since those are for display only */
+    if (!a->mailbox || a->group)
+    {
+      continue;
+    }
+    if ((adata->capabilities & SMTP_CAP_DSN) && c_dsn_notify)
+    {
+      buf_add_printf(cmds, "RCPT TO:<%s> NOTIFY=%s\r\n",
+                     buf_string(a->mailbox), c_dsn_notify);
+    }
+    else
+    {
+      buf_add_printf(cmds, "RCPT TO:<%s>\r\n", buf_string(a->mailbox));
+    }
+    (*ncmds)++;
+  }
+}
+
+/**
+ * smtp_send_body - Stream the message body after a DATA command
  * @param adata   SMTP Account data
  * @param msgfile Filename containing data
  * @retval  0 Success
  * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ *
+ * The server must already have accepted a DATA command with a 354 response.
  */
-static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
+static int smtp_send_body(struct SmtpAccountData *adata, const char *msgfile)
 {
   char buf[1024] = { 0 };
   struct Progress *progress = NULL;
@@ -262,20 +313,6 @@ static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
   progress = progress_new(MUTT_PROGRESS_NET, size);
   progress_set_message(progress, _("Sending message..."));
 
-  snprintf(buf, sizeof(buf), "DATA\r\n");
-  if (mutt_socket_send(adata->conn, buf) == -1)
-  {
-    mutt_file_fclose(&fp);
-    goto done;
-  }
-  rc = smtp_get_resp(adata);
-  if (rc != 0)
-  {
-    mutt_file_fclose(&fp);
-    goto done;
-  }
-
-  rc = SMTP_ERR_WRITE;
   while (fgets(buf, sizeof(buf) - 1, fp))
   {
     buflen = mutt_str_len(buf);
@@ -316,6 +353,110 @@ done:
   return rc;
 }
 
+/**
+ * smtp_data - Send data to an SMTP server
+ * @param adata   SMTP Account data
+ * @param msgfile Filename containing data
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ */
+static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
+{
+  if (mutt_socket_send(adata->conn, "DATA\r\n") == -1)
+    return SMTP_ERR_WRITE;
+
+  int rc = smtp_get_resp(adata);
+  if (rc != 0)
+    return rc;
+
+  return smtp_send_body(adata, msgfile);
+}
+
+/**
+ * smtp_bdat - Send data to an SMTP server using CHUNKING
+ * @param adata   SMTP Account data
+ * @param msgfile Filename containing data
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ *
+ * The message is sent as a single BDAT chunk (RFC 3030), which needs no
+ * 354 round trip, no dot-stuffing and no terminating dot.
+ */
+static int smtp_bdat(struct SmtpAccountData *adata, const char *msgfile)
+{
+  char buf[1024] = { 0 };
+  struct Progress *progress = NULL;
+  int rc = SMTP_ERR_WRITE;
+  int term = 0;
+  size_t buflen = 0;
+
+  FILE *fp = mutt_file_fopen(msgfile, "r");
+  if (!fp)
+  {
+    mutt_error(_("SMTP session failed: unable to open %s"), msgfile);
+    return -1;
+  }
+  const long size = mutt_file_get_size_fp(fp);
+  if (size == 0)
+  {
+    mutt_file_fclose(&fp);
+    return -1;
+  }
+
+  /* BDAT needs the exact octet count up front, so measure the message as it
+   * will look once its line endings are CRLF */
+  size_t total = 0;
+  while (fgets(buf, sizeof(buf) - 1, fp))
+  {
+    buflen = mutt_str_len(buf);
+    term = buflen && (buf[buflen - 1] == '\n');
+    if (term && ((buflen == 1) || (buf[buflen - 2] != '\r')))
+      buflen++; /* room for the '\r' */
+    total += buflen;
+  }
+  if (!term && buflen)
+    total += 2; /* terminate the final line */
+  rewind(fp);
+
+  unlink(msgfile);
+  progress = progress_new(MUTT_PROGRESS_NET, size);
+  progress_set_message(progress, _("Sending message..."));
+
+  snprintf(buf, sizeof(buf), "BDAT %zu LAST\r\n", total);
+  if (mutt_socket_send(adata->conn, buf) == -1)
+  {
+    mutt_file_fclose(&fp);
+    goto done;
+  }
+
+  while (fgets(buf, sizeof(buf) - 1, fp))
+  {
+    buflen = mutt_str_len(buf);
+    term = buflen && buf[buflen - 1] == '\n';
+    if (term && ((buflen == 1) || (buf[buflen - 2] != '\r')))
+      snprintf(buf + buflen - 1, sizeof(buf) - buflen + 1, "\r\n");
+    if (mutt_socket_send_d(adata->conn, buf, MUTT_SOCK_LOG_FULL) == -1)
+    {
+      mutt_file_fclose(&fp);
+      goto done;
+    }
+    progress_update(progress, MAX(0, ftell(fp)), -1);
+  }
+  if (!term && buflen &&
+      (mutt_socket_send_d(adata->conn, "\r\n", MUTT_SOCK_LOG_FULL) == -1))
+  {
+    mutt_file_fclose(&fp);
+    goto done;
+  }
+  mutt_file_fclose(&fp);
+
+  rc = smtp_get_resp(adata);
+
+done:
+  progress_free(&progress);
+  return rc;
+}
+
 /**
  * smtp_get_field - Get connection login credentials - Implements ConnAccount::get_field() - @ingroup conn_account_get_field
  */
@@ -1086,39 +1227,76 @@ static int smtp_open(struct SmtpAccountData *adata, bool esmtp)
 }
 
 /**
- * mutt_smtp_send - Send a message using SMTP
+ * struct SmtpSession - An open SMTP session
+ *
+ * Lets a batch operation, e.g. bouncing tagged messages, send several
+ * messages over one connection instead of reconnecting (and
+ * re-authenticating) per message.
+ */
+struct SmtpSession
+{
+  struct SmtpAccountData adata; ///< Server connection data
+  bool opened;                  ///< Greeting, EHLO and authentication are done
+};
+
+/**
+ * mutt_smtp_session_open - Prepare an SMTP session from $smtp_url
+ * @param sub Config Subset
+ * @retval ptr  New SMTP session
+ * @retval NULL Error
+ *
+ * The connection is only established when the first message is sent.
+ * Free the result with mutt_smtp_session_close().
+ */
+struct SmtpSession *mutt_smtp_session_open(struct ConfigSubset *sub)
+{
+  struct SmtpSession *sess = mutt_mem_calloc(1, sizeof(struct SmtpSession));
+  struct ConnAccount cac = { { 0 } };
+
+  sess->adata.sub = sub;
+  sess->adata.fqdn = mutt_fqdn(false, sub);
+  if (!sess->adata.fqdn)
+    sess->adata.fqdn = NONULL(ShortHostname);
+
+  if (smtp_fill_account(&sess->adata, &cac) < 0)
+  {
+    FREE(&sess);
+    return NULL;
+  }
+
+  sess->adata.conn = mutt_conn_find(&cac);
+  if (!sess->adata.conn)
+  {
+    FREE(&sess);
+    return NULL;
+  }
+
+  return sess;
+}
+
+/**
+ * mutt_smtp_session_send - Send one message over an SMTP session
+ * @param sess     SMTP session
  * @param from     From Address
  * @param to       To Address
  * @param cc       Cc Address
  * @param bcc      Bcc Address
  * @param msgfile  Message to send to the server
  * @param eightbit If true, try for an 8-bit friendly connection
- * @param sub      Config Subset
  * @retval  0 Success
  * @retval -1 Error
+ *
+ * After an error the connection is closed and the session can't be reused.
  */
-int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
-                   const struct AddressList *cc, const struct AddressList *bcc,
-                   const char *msgfile, bool eightbit, struct ConfigSubset *sub)
+int mutt_smtp_session_send(struct SmtpSession *sess, const struct AddressList *from,
+                           const struct AddressList *to, const struct AddressList *cc,
+                           const struct AddressList *bcc, const char *msgfile, bool eightbit)
 {
-  struct SmtpAccountData adata = { 0 };
-  struct ConnAccount cac = { { 0 } };
+  struct SmtpAccountData *adata = &sess->adata;
   const char *envfrom = NULL;
   int rc = -1;
 
-  adata.sub = sub;
-  adata.fqdn = mutt_fqdn(false, adata.sub);
-  if (!adata.fqdn)
-    adata.fqdn = NONULL(ShortHostname);
-
-  const struct Address *c_envelope_from_address = cs_subset_address(adata.sub, "envelope_from_address");
-
-  if (smtp_fill_account(&adata, &cac) < 0)
-    return rc;
-
-  adata.conn = mutt_conn_find(&cac);
-  if (!adata.conn)
-    return -1;
+  const struct Address *c_envelope_from_address = cs_subset_address(adata->sub, "envelope_from_address");
 
   /* it might be better to synthesize an envelope from from user and host
    * but this condition is most likely arrived at accidentally */
@@ -1133,64 +1311,136 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   else
   {
     mutt_error(_("No from address given"));
-    mutt_socket_close(adata.conn);
+    mutt_socket_close(adata->conn);
     return -1;
   }
 
-  const char *const c_dsn_return = cs_subset_string(adata.sub, "dsn_return");
+  const char *const c_dsn_return = cs_subset_string(adata->sub, "dsn_return");
 
   struct Buffer *buf = buf_pool_get();
   do
   {
-    /* send our greeting */
-    rc = smtp_open(&adata, eightbit);
-    if (rc != 0)
-      break;
-    FREE(&adata.auth_mechs);
+    if (!sess->opened)
+    {
+      /* send our greeting */
+      rc = smtp_open(adata, eightbit);
+      if (rc != 0)
+        break;
+      FREE(&adata->auth_mechs);
+      sess->opened = true;
+    }
 
     /* send the sender's address */
     buf_printf(buf, "MAIL FROM:<%s>", envfrom);
-    if (eightbit && (adata.capabilities & SMTP_CAP_EIGHTBITMIME))
+    if (eightbit && (adata->capabilities & SMTP_CAP_EIGHTBITMIME))
       buf_addstr(buf, " BODY=8BITMIME");
 
-    if (c_dsn_return && (adata.capabilities & SMTP_CAP_DSN))
+    if (c_dsn_return && (adata->capabilities & SMTP_CAP_DSN))
       buf_add_printf(buf, " RET=%s", c_dsn_return);
 
-    if ((adata.capabilities & SMTP_CAP_SMTPUTF8) &&
+    if ((adata->capabilities & SMTP_CAP_SMTPUTF8) &&
         (mutt_addr_uses_unicode(envfrom) || mutt_addrlist_uses_unicode(to) ||
          mutt_addrlist_uses_unicode(cc) || mutt_addrlist_uses_unicode(bcc)))
     {
       buf_addstr(buf, " SMTPUTF8");
     }
     buf_addstr(buf, "\r\n");
-    if (mutt_socket_send(adata.conn, buf_string(buf)) == -1)
-    {
-      rc = SMTP_ERR_WRITE;
-      break;
-    }
-    rc = smtp_get_resp(&adata);
-    if (rc != 0)
-      break;
 
-    /* send the recipient list */
-    if ((rc = smtp_rcpt_to(&adata, to)) || (rc = smtp_rcpt_to(&adata, cc)) ||
-        (rc = smtp_rcpt_to(&adata, bcc)))
+    if (adata->capabilities & SMTP_CAP_PIPELINING)
     {
-      break;
+      /* RFC 2920: send the whole envelope in one write and collect the
+       * responses in bulk, instead of one round trip per recipient */
+      int ncmds = 1;
+      smtp_add_rcpts(adata, to, buf, &ncmds);
+      smtp_add_rcpts(adata, cc, buf, &ncmds);
+      smtp_add_rcpts(adata, bcc, buf, &ncmds);
+
+      /* DATA may conclude the pipelined group; BDAT carries its own data */
+      const bool chunking = (adata->capabilities & SMTP_CAP_CHUNKING);
+      if (!chunking)
+        buf_addstr(buf, "DATA\r\n");
+
+      if (mutt_socket_send(adata->conn, buf_string(buf)) == -1)
+      {
+        rc = SMTP_ERR_WRITE;
+        break;
+      }
+
+      /* drain every envelope response, remembering the first failure */
+      rc = 0;
+      for (int i = 0; i < ncmds; i++)
+      {
+        int rc2 = smtp_get_resp(adata);
+        if (rc2 == SMTP_ERR_READ)
+        {
+          rc = rc2;
+          break;
+        }
+        if ((rc2 != 0) && (rc == 0))
+          rc = rc2;
+      }
+      if (rc == SMTP_ERR_READ)
+        break;
+
+      if (!chunking)
+      {
+        int rc2 = smtp_get_resp(adata);
+        if (rc2 == SMTP_ERR_READ)
+        {
+          rc = rc2;
+          break;
+        }
+        if ((rc2 == 0) && (rc != 0))
+        {
+          /* The envelope failed but the server accepted DATA anyway -
+           * terminate an empty message to keep the session in sync */
+          mutt_socket_send(adata->conn, ".\r\n");
+          smtp_get_resp(adata);
+        }
+        if ((rc2 != 0) && (rc == 0))
+          rc = rc2;
+      }
+      if (rc != 0)
+        break;
+
+      rc = chunking ? smtp_bdat(adata, msgfile) : smtp_send_body(adata, msgfile);
+      if (rc != 0)
+        break;
     }
+    else
+    {
+      if (mutt_socket_send(adata->conn, buf_string(buf)) == -1)
+      {
+        rc = SMTP_ERR_WRITE;
+        break;
+      }
+      rc = smtp_get_resp(adata);
+      if (rc != 0)
+        break;
 
-    /* send the message data */
-    rc = smtp_data(&adata, msgfile);
-    if (rc != 0)
-      break;
+      /* send the recipient list */
+      if ((rc = smtp_rcpt_to(adata, to)) || (rc = smtp_rcpt_to(adata, cc)) ||
+          (rc = smtp_rcpt_to(adata, bcc)))
+      {
+        break;
+      }
 
-    mutt_socket_send(adata.conn, "QUIT\r\n");
+      /* send the message data */
+      rc = (adata->capabilities & SMTP_CAP_CHUNKING) ?
+               smtp_bdat(adata, msgfile) :
+               smtp_data(adata, msgfile);
+      if (rc != 0)
+        break;
+    }
 
     rc = 0;
   } while (false);
 
-  mutt_socket_close(adata.conn);
-  FREE(&adata.conn);
+  if (rc != 0)
+  {
+    mutt_socket_close(adata->conn);
+    sess->opened = false;
+  }
 
   if (rc == SMTP_ERR_READ)
     mutt_error(_("SMTP session failed: read error"));
@@ -1202,3 +1452,49 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   buf_pool_release(&buf);
   return rc;
 }
+
+/**
+ * mutt_smtp_session_close - Shut down an SMTP session
+ * @param ptr SMTP session
+ *
+ * The server is sent a QUIT if the connection is still usable.
+ */
+void mutt_smtp_session_close(struct SmtpSession **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct SmtpSession *sess = *ptr;
+  if (sess->opened)
+  {
+    mutt_socket_send(sess->adata.conn, "QUIT\r\n");
+    mutt_socket_close(sess->adata.conn);
+  }
+  FREE(&sess->adata.conn);
+  FREE(ptr);
+}
+
+/**
+ * mutt_smtp_send - Send a message using SMTP
+ * @param from     From Address
+ * @param to       To Address
+ * @param cc       Cc Address
+ * @param bcc      Bcc Address
+ * @param msgfile  Message to send to the server
+ * @param eightbit If true, try for an 8-bit friendly connection
+ * @param sub      Config Subset
+ * @retval  0 Success
+ * @retval -1 Error
+ */
+int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
+                   const struct AddressList *cc, const struct AddressList *bcc,
+                   const char *msgfile, bool eightbit, struct ConfigSubset *sub)
+{
+  struct SmtpSession *sess = mutt_smtp_session_open(sub);
+  if (!sess)
+    return -1;
+
+  int rc = mutt_smtp_session_send(sess, from, to, cc, bcc, msgfile, eightbit);
+  mutt_smtp_session_close(&sess);
+  return rc;
+}
@@ -29,10 +29,20 @@
 
 struct AddressList;
 struct ConfigSubset;
+struct SmtpSession;
 
 bool smtp_auth_is_valid(const char *authenticator);
 int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
                    const struct AddressList *cc, const struct AddressList *bcc,
                    const char *msgfile, bool eightbit, struct ConfigSubset *sub);
 
+struct SmtpSession *mutt_smtp_session_open (struct ConfigSubset *sub);
+int                 mutt_smtp_session_send (struct SmtpSession *sess,
+                                            const struct AddressList *from,
+                                            const struct AddressList *to,
+                                            const struct AddressList *cc,
+                                            const struct AddressList *bcc,
+                                            const char *msgfile, bool eightbit);
+void                mutt_smtp_session_close(struct SmtpSession **ptr);
+
 #endif /* MUTT_SEND_SMTP_H */
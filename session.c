@@ -0,0 +1,316 @@
+/**
+ * @file
+ * Save and restore the Index view between sessions
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_session Save and restore the Index view between sessions
+ *
+ * Remember how each mailbox was being viewed -- the limit pattern, which
+ * threads were collapsed and which email was selected -- in
+ * `$session_state_file`.  When the mailbox is opened again, the view is
+ * reapplied, so restarting NeoMutt feels like resuming it.
+ *
+ * The state is keyed by message-id, so it survives new mail arriving and
+ * doesn't depend on the sort order.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "email/lib.h"
+#include "menu/lib.h"
+#include "session.h"
+#include "mutt_thread.h"
+#include "mview.h"
+#include "mutt.h"
+#include "pattern/lib.h"
+
+/// Maximum number of mailboxes remembered in `$session_state_file`
+#define SESSION_MAX_ENTRIES 100
+
+/**
+ * struct SessionEntry - Saved view state for one mailbox
+ */
+struct SessionEntry
+{
+  char *folder;              ///< Mailbox path
+  char *limit;               ///< Limit pattern, or NULL
+  char *cursor;              ///< Message-id of the selected Email, or NULL
+  struct ListHead collapsed; ///< Message-ids of collapsed thread roots
+};
+
+ARRAY_HEAD(SessionArray, struct SessionEntry *);
+
+/// Saved view states, loaded from `$session_state_file`
+static struct SessionArray Sessions = ARRAY_HEAD_INITIALIZER;
+/// The states have changed and need saving
+static bool SessionsDirty = false;
+
+/**
+ * session_entry_free - Free a Session entry
+ * @param ptr Entry to free
+ */
+static void session_entry_free(struct SessionEntry **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct SessionEntry *se = *ptr;
+
+  FREE(&se->folder);
+  FREE(&se->limit);
+  FREE(&se->cursor);
+  mutt_list_free(&se->collapsed);
+
+  FREE(ptr);
+}
+
+/**
+ * session_entry_new - Create a Session entry for a mailbox
+ * @param folder Mailbox path
+ * @retval ptr New entry, added to the list
+ */
+static struct SessionEntry *session_entry_new(const char *folder)
+{
+  struct SessionEntry *se = mutt_mem_calloc(1, sizeof(struct SessionEntry));
+
+  se->folder = mutt_str_dup(folder);
+  STAILQ_INIT(&se->collapsed);
+
+  ARRAY_ADD(&Sessions, se);
+  return se;
+}
+
+/**
+ * session_find - Find the entry for a mailbox
+ * @param folder Mailbox path
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct SessionEntry *session_find(const char *folder)
+{
+  struct SessionEntry **sep = NULL;
+  ARRAY_FOREACH(sep, &Sessions)
+  {
+    if (mutt_str_equal((*sep)->folder, folder))
+      return *sep;
+  }
+  return NULL;
+}
+
+/**
+ * session_init - Load the saved view states
+ *
+ * `$session_state_file` holds one block of lines per mailbox.  Each line is a
+ * keyword and a value: `folder` starts a new block; `limit`, `cursor` and
+ * `collapse` fill in the view state.
+ */
+void session_init(void)
+{
+  const char *const c_session_state_file = cs_subset_path(NeoMutt->sub, "session_state_file");
+  FILE *fp = mutt_file_fopen(c_session_state_file, "r");
+  if (!fp)
+    return;
+
+  struct SessionEntry *se = NULL;
+  char *buf = NULL;
+  size_t size = 0;
+  while ((buf = mutt_file_read_line(buf, &size, fp, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    size_t plen = mutt_str_startswith(buf, "folder ");
+    if (plen != 0)
+    {
+      if (ARRAY_SIZE(&Sessions) >= SESSION_MAX_ENTRIES)
+        break;
+      se = session_entry_new(buf + plen);
+      continue;
+    }
+
+    if (!se)
+      continue;
+
+    if ((plen = mutt_str_startswith(buf, "limit ")))
+      mutt_str_replace(&se->limit, buf + plen);
+    else if ((plen = mutt_str_startswith(buf, "cursor ")))
+      mutt_str_replace(&se->cursor, buf + plen);
+    else if ((plen = mutt_str_startswith(buf, "collapse ")))
+      mutt_list_insert_tail(&se->collapsed, mutt_str_dup(buf + plen));
+  }
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+}
+
+/**
+ * session_cleanup - Save the view states and free them
+ */
+void session_cleanup(void)
+{
+  struct SessionEntry **sep = NULL;
+
+  if (SessionsDirty)
+  {
+    const char *const c_session_state_file = cs_subset_path(NeoMutt->sub, "session_state_file");
+    unlink(c_session_state_file); // mutt_file_fopen() won't overwrite an existing file
+    FILE *fp = mutt_file_fopen(c_session_state_file, "w");
+    if (fp)
+    {
+      ARRAY_FOREACH(sep, &Sessions)
+      {
+        struct SessionEntry *se = *sep;
+        if (!se->limit && !se->cursor && STAILQ_EMPTY(&se->collapsed))
+          continue; // nothing worth restoring
+
+        fprintf(fp, "folder %s\n", se->folder);
+        if (se->limit)
+          fprintf(fp, "limit %s\n", se->limit);
+        if (se->cursor)
+          fprintf(fp, "cursor %s\n", se->cursor);
+        struct ListNode *np = NULL;
+        STAILQ_FOREACH(np, &se->collapsed, entries)
+        {
+          fprintf(fp, "collapse %s\n", np->data);
+        }
+      }
+      mutt_file_fclose(&fp);
+    }
+  }
+
+  ARRAY_FOREACH(sep, &Sessions)
+  {
+    session_entry_free(sep);
+  }
+  ARRAY_FREE(&Sessions);
+}
+
+/**
+ * session_state_save - Remember how a mailbox is being viewed
+ * @param mv    Mailbox View
+ * @param e_cur Currently selected Email
+ *
+ * Call this just before the mailbox is closed.  The state is written out by
+ * session_cleanup() on exit.
+ */
+void session_state_save(struct MailboxView *mv, struct Email *e_cur)
+{
+  const char *const c_session_state_file = cs_subset_path(NeoMutt->sub, "session_state_file");
+  if (!c_session_state_file || !mv || !mv->mailbox)
+    return;
+
+  struct Mailbox *m = mv->mailbox;
+
+  struct SessionEntry *se = session_find(mailbox_path(m));
+  if (!se)
+    se = session_entry_new(mailbox_path(m));
+
+  mutt_str_replace(&se->limit, mv->pattern);
+
+  FREE(&se->cursor);
+  if (e_cur && e_cur->env)
+    se->cursor = mutt_str_dup(e_cur->env->message_id);
+
+  mutt_list_free(&se->collapsed);
+  STAILQ_INIT(&se->collapsed);
+  for (int i = 0; i < m->vcount; i++)
+  {
+    /* each collapsed thread is represented by its one visible email */
+    struct Email *e = mutt_get_virt_email(m, i);
+    if (e && e->collapsed && e->env && e->env->message_id)
+      mutt_list_insert_tail(&se->collapsed, mutt_str_dup(e->env->message_id));
+  }
+
+  SessionsDirty = true;
+}
+
+/**
+ * session_state_restore - Reapply the saved view of a mailbox
+ * @param mv   Mailbox View
+ * @param menu Index Menu
+ * @retval true Some state was restored
+ *
+ * Call this after the mailbox has been opened and sorted.  The saved limit
+ * pattern is reapplied, the saved threads are collapsed again and the cursor
+ * is put back on the email it was on.
+ */
+bool session_state_restore(struct MailboxView *mv, struct Menu *menu)
+{
+  const char *const c_session_state_file = cs_subset_path(NeoMutt->sub, "session_state_file");
+  if (!c_session_state_file || !mv || !mv->mailbox || !menu)
+    return false;
+
+  struct Mailbox *m = mv->mailbox;
+  if (m->msg_count == 0)
+    return false;
+
+  struct SessionEntry *se = session_find(mailbox_path(m));
+  if (!se)
+    return false;
+
+  bool restored = false;
+
+  if (se->limit)
+  {
+    mutt_str_replace(&mv->pattern, se->limit);
+    if (mutt_pattern_func(mv, MUTT_LIMIT, NULL) == 0)
+      restored = true;
+  }
+
+  struct Email *e_cur = NULL;
+  if (se->cursor || !STAILQ_EMPTY(&se->collapsed))
+  {
+    struct HashTable *id_hash = mutt_make_id_hash(m);
+
+    if (mutt_using_threads())
+    {
+      struct ListNode *np = NULL;
+      STAILQ_FOREACH(np, &se->collapsed, entries)
+      {
+        struct Email *e = mutt_hash_find(id_hash, np->data);
+        if (e && (e->vnum >= 0) && !e->collapsed && mutt_thread_can_collapse(e))
+        {
+          mutt_collapse_thread(e);
+          restored = true;
+        }
+      }
+      mutt_set_vnum(m);
+    }
+
+    if (se->cursor)
+      e_cur = mutt_hash_find(id_hash, se->cursor);
+
+    mutt_hash_free(&id_hash);
+  }
+
+  menu->max = m->vcount;
+  if (e_cur && (e_cur->vnum >= 0))
+  {
+    menu_set_index(menu, e_cur->vnum);
+    restored = true;
+  }
+
+  if (restored)
+    menu_queue_redraw(menu, MENU_REDRAW_INDEX);
+
+  return restored;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * Save and restore the Index view between sessions
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_SESSION_H
+#define MUTT_SESSION_H
+
+#include <stdbool.h>
+
+struct Email;
+struct MailboxView;
+struct Menu;
+
+void session_cleanup      (void);
+void session_init         (void);
+bool session_state_restore(struct MailboxView *mv, struct Menu *menu);
+void session_state_save   (struct MailboxView *mv, struct Email *e_cur);
+
+#endif /* MUTT_SESSION_H */
@@ -333,7 +333,8 @@ static int sb_config_observer(struct NotifyCallback *nc)
     return 0;
   }
 
-  // All the remaining config changes...
+  // All the remaining config changes may affect every rendered entry
+  sb_mark_dirty(sb_wdata_get(win), NULL);
   win->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "config done, request WA_RECALC\n");
   return 0;
@@ -386,6 +387,11 @@ static int sb_mailbox_observer(struct NotifyCallback *nc)
   {
     sb_remove_mailbox(wdata, ev_m->mailbox);
   }
+  else
+  {
+    // Only this Mailbox's entry needs re-rendering
+    sb_mark_dirty(wdata, ev_m->mailbox);
+  }
 
   win->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "mailbox done, request WA_RECALC\n");
@@ -44,6 +44,8 @@ struct SbEntry
   int depth;                      ///< Indentation depth
   struct Mailbox *mailbox;        ///< Mailbox this represents
   bool is_hidden;                 ///< Don't show, e.g. $sidebar_new_mail_only
+  bool dirty;                     ///< Display string needs re-rendering
+  int render_width;               ///< Width the display string was rendered to
   const struct AttrColor *color;  ///< Colour to use
 };
 ARRAY_HEAD(SbEntryArray, struct SbEntry *);
@@ -102,6 +104,7 @@ struct SidebarWindowData
 
 // sidebar.c
 void sb_add_mailbox        (struct SidebarWindowData *wdata, struct Mailbox *m);
+void sb_mark_dirty         (struct SidebarWindowData *wdata, const struct Mailbox *m);
 void sb_remove_mailbox     (struct SidebarWindowData *wdata, const struct Mailbox *m);
 void sb_set_current_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m);
 struct Mailbox *sb_get_highlight(struct MuttWindow *win);
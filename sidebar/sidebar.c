@@ -103,6 +103,7 @@ void sb_add_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
   struct IndexSharedData *shared = wdata->shared;
   struct SbEntry *entry = mutt_mem_calloc(1, sizeof(struct SbEntry));
   entry->mailbox = m;
+  entry->dirty = true;
 
   if (wdata->top_index < 0)
     wdata->top_index = ARRAY_SIZE(&wdata->entries);
@@ -117,6 +118,23 @@ void sb_add_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
   ARRAY_ADD(&wdata->entries, entry);
 }
 
+/**
+ * sb_mark_dirty - Mark Sidebar entries as needing re-rendering
+ * @param wdata Sidebar data
+ * @param m     Mailbox that changed, or NULL for all
+ *
+ * sb_recalc() only re-renders $sidebar_format for dirty entries.
+ */
+void sb_mark_dirty(struct SidebarWindowData *wdata, const struct Mailbox *m)
+{
+  struct SbEntry **sbep = NULL;
+  ARRAY_FOREACH(sbep, &wdata->entries)
+  {
+    if (!m || ((*sbep)->mailbox == m))
+      (*sbep)->dirty = true;
+  }
+}
+
 /**
  * sb_remove_mailbox - Remove a Mailbox from the Sidebar
  * @param wdata Sidebar data
@@ -829,11 +829,23 @@ int sb_recalc(struct MuttWindow *win)
     if (m_cur && (m_cur->realpath[0] != '\0') &&
         mutt_str_equal(m->realpath, m_cur->realpath))
     {
+      if ((m->msg_unread != m_cur->msg_unread) || (m->msg_count != m_cur->msg_count) ||
+          (m->msg_flagged != m_cur->msg_flagged))
+      {
+        entry->dirty = true;
+      }
       m->msg_unread = m_cur->msg_unread;
       m->msg_count = m_cur->msg_count;
       m->msg_flagged = m_cur->msg_flagged;
     }
 
+    // The rendered string is still good, e.g. another mailbox got new mail
+    if (!entry->dirty && (entry->render_width == width))
+    {
+      row++;
+      continue;
+    }
+
     const char *path = mailbox_path(m);
 
     const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
@@ -871,6 +883,8 @@ int sb_recalc(struct MuttWindow *win)
 
     mutt_str_copy(entry->box, short_path, sizeof(entry->box));
     make_sidebar_entry(entry->display, sizeof(entry->display), width, entry, shared);
+    entry->dirty = false;
+    entry->render_width = width;
     row++;
   }
 
@@ -47,6 +47,9 @@
 #include "mview.h"
 #include "mx.h"
 #include "score.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
 
 /**
  * struct EmailCompare - Context for compare_email_shim()
@@ -137,7 +140,9 @@ const char *mutt_get_name(const struct Address *a)
 
   if (a)
   {
-    const bool c_reverse_alias = cs_subset_bool(NeoMutt->sub, "reverse_alias");
+    // Memoized - this runs once per comparison when sorting by author
+    static struct ConfigMemo ReverseAliasMemo = CONFIG_MEMO_INIT("reverse_alias");
+    const bool c_reverse_alias = (bool) cs_subset_memo_native_get(NeoMutt->sub, &ReverseAliasMemo);
     if (c_reverse_alias && (ali = alias_reverse_lookup(a)) && ali->personal)
       return buf_string(ali->personal);
     if (a->personal)
@@ -342,6 +347,391 @@ int mutt_compare_emails(const struct Email *a, const struct Email *b,
   return rc;
 }
 
+/**
+ * struct EmailKey - Sort decoration for one Email
+ *
+ * Decorate-sort-undecorate: the textual sort keys are computed once per
+ * Email, rather than over and over inside qsort().
+ */
+struct EmailKey
+{
+  struct Email *email; ///< Email being sorted
+  char *k1;            ///< Primary textual sort key
+  char *k2;            ///< Secondary textual sort key
+};
+
+/**
+ * struct EmailKeyCompare - Context for compare_keyed_shim()
+ */
+struct EmailKeyCompare
+{
+  struct EmailCompare cmp; ///< Sort settings
+  bool keyed1;             ///< Primary sort reads EmailKey::k1 instead of the Email
+  bool keyed2;             ///< Secondary sort reads EmailKey::k2
+};
+
+/**
+ * sort_is_textual - Does a sort method compare strings derived from the Email?
+ * @param sort Sort type, see #SortType
+ * @retval true The method benefits from a precomputed key
+ */
+static bool sort_is_textual(short sort)
+{
+  switch (sort & SORT_MASK)
+  {
+    case SORT_FROM:
+    case SORT_SUBJECT:
+    case SORT_TO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * email_sort_key - Compute the textual sort key for an Email
+ * @param e    Email
+ * @param sort Sort type, see #SortType
+ * @retval ptr Sort key - caller must free it
+ * @retval NULL Email has no key (e.g. no subject)
+ *
+ * The keys mirror what the comparators read: compare_from() and compare_to()
+ * only look at the first 128 bytes of the name, so that's all that is kept.
+ */
+static char *email_sort_key(const struct Email *e, short sort)
+{
+  char name[128] = { 0 };
+
+  switch (sort & SORT_MASK)
+  {
+    case SORT_FROM:
+      mutt_str_copy(name, mutt_get_name(TAILQ_FIRST(&e->env->from)), sizeof(name));
+      return mutt_str_dup(name);
+    case SORT_SUBJECT:
+      return mutt_str_dup(e->env->real_subj);
+    case SORT_TO:
+      mutt_str_copy(name, mutt_get_name(TAILQ_FIRST(&e->env->to)), sizeof(name));
+      return mutt_str_dup(name);
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * compare_key - Compare the precomputed keys of two emails
+ * @param ka   First key
+ * @param kb   Second key
+ * @param ea   First email
+ * @param eb   Second email
+ * @param sort Sort type, see #SortType
+ * @retval <0 ka precedes kb
+ * @retval  0 ka and kb are identical
+ * @retval >0 kb precedes ka
+ *
+ * This must order exactly like the ::sort_mail_t the key was made for.
+ */
+static int compare_key(const char *ka, const char *kb, const struct Email *ea,
+                       const struct Email *eb, short sort)
+{
+  int rc;
+
+  if ((sort & SORT_MASK) == SORT_SUBJECT)
+  {
+    if (!ka)
+      rc = kb ? -1 : compare_date_sent(ea, eb, false);
+    else if (!kb)
+      rc = 1;
+    else
+      rc = mutt_istr_cmp(ka, kb);
+  }
+  else
+  {
+    rc = mutt_istrn_cmp(ka, kb, 128);
+  }
+  return (sort & SORT_REVERSE) ? -rc : rc;
+}
+
+/**
+ * compare_keyed_shim - Helper to sort decorated emails - Implements ::sort_t - @ingroup sort_api
+ */
+static int compare_keyed_shim(const void *a, const void *b, void *sdata)
+{
+  const struct EmailKey *ka = a;
+  const struct EmailKey *kb = b;
+  const struct EmailKeyCompare *kcmp = sdata;
+
+  int rc;
+  if (kcmp->keyed1)
+  {
+    rc = compare_key(ka->k1, kb->k1, ka->email, kb->email, kcmp->cmp.sort);
+  }
+  else
+  {
+    sort_mail_t func = get_sort_func(kcmp->cmp.sort & SORT_MASK, kcmp->cmp.type);
+    rc = func(ka->email, kb->email, (kcmp->cmp.sort & SORT_REVERSE) != 0);
+  }
+  if (rc == 0)
+  {
+    if (kcmp->keyed2)
+    {
+      rc = compare_key(ka->k2, kb->k2, ka->email, kb->email, kcmp->cmp.sort_aux);
+    }
+    else
+    {
+      sort_mail_t func = get_sort_func(kcmp->cmp.sort_aux & SORT_MASK, kcmp->cmp.type);
+      rc = func(ka->email, kb->email, (kcmp->cmp.sort_aux & SORT_REVERSE) != 0);
+    }
+  }
+  if (rc == 0)
+    rc = compare_order(ka->email, kb->email, false);
+  return rc;
+}
+
+/**
+ * sort_keyed - Sort the Mailbox's emails with precomputed keys
+ * @param m   Mailbox
+ * @param cmp Sort settings
+ * @retval true The emails have been sorted
+ * @retval false Neither sort method is textual, use plain qsort
+ *
+ * The textual comparators derive a string from the Email on every call -
+ * compare_from() may even do an alias lookup - which qsort() repeats
+ * O(n log n) times.  For those methods, compute the string once per Email,
+ * sort the decorated array, and copy the order back.
+ */
+static bool sort_keyed(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  struct EmailKeyCompare kcmp = { *cmp, sort_is_textual(cmp->sort),
+                                  sort_is_textual(cmp->sort_aux) };
+  if (!kcmp.keyed1 && !kcmp.keyed2)
+    return false;
+
+  struct EmailKey *keys = mutt_mem_calloc(m->msg_count, sizeof(struct EmailKey));
+
+  int count = 0;
+  for (; count < m->msg_count; count++)
+  {
+    struct Email *e = m->emails[count];
+    if (!e)
+      break;
+
+    keys[count].email = e;
+    if (kcmp.keyed1)
+      keys[count].k1 = email_sort_key(e, cmp->sort);
+    if (kcmp.keyed2)
+      keys[count].k2 = email_sort_key(e, cmp->sort_aux);
+  }
+
+  mutt_qsort_r(keys, count, sizeof(struct EmailKey), compare_keyed_shim, &kcmp);
+
+  for (int i = 0; i < count; i++)
+  {
+    m->emails[i] = keys[i].email;
+    FREE(&keys[i].k1);
+    FREE(&keys[i].k2);
+  }
+  FREE(&keys);
+  return true;
+}
+
+/**
+ * sort_merge_new - Merge newly arrived emails into an already-sorted Mailbox
+ * @param m   Mailbox
+ * @param cmp Sort settings
+ * @retval true The emails have been sorted
+ * @retval false The array isn't mostly sorted, use a full sort
+ *
+ * When new mail arrives, the existing emails are still in order; only the
+ * arrivals appended to Mailbox::emails are out of place.  Sort just that
+ * suffix and merge it into the sorted prefix, costing O(new log new + n)
+ * rather than the O(n log n) of a full resort - which matters when mail
+ * trickles in at every mailbox poll.
+ *
+ * The prefix is verified rather than tracked: the scan doubles as the
+ * detector for a first sort, changed sort settings or a reordered array,
+ * all of which fall back to the full sort.
+ */
+static bool sort_merge_new(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  int sorted = 1;
+  while ((sorted < m->msg_count) &&
+         (mutt_compare_emails(m->emails[sorted - 1], m->emails[sorted],
+                              cmp->type, cmp->sort, cmp->sort_aux) < 0))
+  {
+    sorted++;
+  }
+
+  const int added = m->msg_count - sorted;
+  if (added == 0)
+    return true; /* already fully sorted */
+
+  /* Mostly unsorted - merging would degenerate into an expensive full sort */
+  if (added > (m->msg_count / 2))
+    return false;
+
+  if (added > 1)
+  {
+    mutt_qsort_r((void *) (m->emails + sorted), added, sizeof(struct Email *),
+                 compare_email_shim, (void *) cmp);
+  }
+
+  struct Email **suffix = mutt_mem_calloc(added, sizeof(struct Email *));
+  memcpy(suffix, m->emails + sorted, added * sizeof(struct Email *));
+
+  /* Merge backwards, so the prefix can shift in place */
+  int i = sorted - 1;
+  int j = added - 1;
+  for (int k = m->msg_count - 1; j >= 0; k--)
+  {
+    if ((i >= 0) && (mutt_compare_emails(m->emails[i], suffix[j], cmp->type,
+                                         cmp->sort, cmp->sort_aux) > 0))
+    {
+      m->emails[k] = m->emails[i--];
+    }
+    else
+    {
+      m->emails[k] = suffix[j--];
+    }
+  }
+
+  FREE(&suffix);
+  return true;
+}
+
+#ifdef USE_HCACHE
+/// Header Cache key of the record holding the last sort order
+static const char SortCacheKey[] = "sort-order";
+
+/**
+ * sort_cache_open - Open the Header Cache holding a Mailbox's sort order
+ * @param m      Mailbox
+ * @param create Create the Header Cache if it doesn't exist
+ * @retval ptr Header Cache
+ *
+ * The cached order refers to the messages by their paths, so it's only kept
+ * for Mailbox types where each message is a separate file.
+ */
+static struct HeaderCache *sort_cache_open(struct Mailbox *m, bool create)
+{
+  const enum MailboxType type = mx_type(m);
+  if ((type != MUTT_MAILDIR) && (type != MUTT_MH))
+    return NULL;
+
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+  if (!c_header_cache)
+    return NULL;
+
+  return hcache_open(c_header_cache, mailbox_path(m), NULL, create, m->readonly);
+}
+
+/**
+ * sort_cache_restore - Apply a cached sort order to a Mailbox
+ * @param m   Mailbox
+ * @param cmp Sort settings
+ * @retval true The cached order was still valid and has been applied
+ *
+ * The record is only trusted if it was made with the same sort settings and
+ * its paths match the Mailbox's messages exactly.  Any new, expired or
+ * renamed message invalidates it and the caller sorts as usual.
+ */
+static bool sort_cache_restore(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  bool rc = false;
+  char *record = NULL;
+  struct HashTable *ht = NULL;
+  struct Email **sorted = NULL;
+
+  struct HeaderCache *hc = sort_cache_open(m, false);
+  if (!hc)
+    return false;
+
+  record = hcache_fetch_raw_str(hc, SortCacheKey, strlen(SortCacheKey));
+  if (!record)
+    goto done;
+
+  /* The first line holds the settings the order was computed with */
+  char *paths = strchr(record, '\n');
+  int sort = 0;
+  int sort_aux = 0;
+  int count = 0;
+  if (!paths || (sscanf(record, "%d %d %d", &sort, &sort_aux, &count) != 3) ||
+      (sort != cmp->sort) || (sort_aux != cmp->sort_aux) || (count != m->msg_count))
+  {
+    goto done;
+  }
+  paths++;
+
+  ht = mutt_hash_new(m->msg_count, MUTT_HASH_NO_FLAGS);
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->path)
+      goto done;
+    mutt_hash_insert(ht, e->path, e);
+  }
+
+  sorted = mutt_mem_calloc(m->msg_count, sizeof(struct Email *));
+  int num_sorted = 0;
+  for (char *line = paths; line && (line[0] != '\0');)
+  {
+    char *nl = strchr(line, '\n');
+    if (nl)
+      *nl = '\0';
+
+    struct Email *e = mutt_hash_find(ht, line);
+    if (!e || (num_sorted == m->msg_count))
+      goto done;
+    mutt_hash_delete(ht, line, e); /* each message may only appear once */
+    sorted[num_sorted++] = e;
+
+    line = nl ? (nl + 1) : NULL;
+  }
+
+  if (num_sorted != m->msg_count)
+    goto done;
+
+  memcpy(m->emails, sorted, m->msg_count * sizeof(struct Email *));
+  rc = true;
+
+done:
+  FREE(&sorted);
+  mutt_hash_free(&ht);
+  FREE(&record);
+  hcache_close(&hc);
+  return rc;
+}
+
+/**
+ * sort_cache_store - Record a Mailbox's sort order in the Header Cache
+ * @param m   Mailbox
+ * @param cmp Sort settings
+ */
+static void sort_cache_store(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  struct HeaderCache *hc = sort_cache_open(m, true);
+  if (!hc)
+    return;
+
+  struct Buffer *rec = buf_pool_get();
+  buf_printf(rec, "%d %d %d\n", cmp->sort, cmp->sort_aux, m->msg_count);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->path)
+      goto done;
+    buf_addstr(rec, e->path);
+    buf_addch(rec, '\n');
+  }
+
+  hcache_store_raw(hc, SortCacheKey, strlen(SortCacheKey), rec->data, buf_len(rec));
+
+done:
+  buf_pool_release(&rec);
+  hcache_close(&hc);
+}
+#endif /* USE_HCACHE */
+
 /**
  * mutt_sort_headers - Sort emails by their headers
  * @param mv    Mailbox View
@@ -397,7 +787,15 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
   const bool threaded = mutt_using_threads();
   if (threaded)
   {
+#ifdef USE_HCACHE
+    if (!mutt_thread_cache_restore(mv->threads))
+    {
+      mutt_sort_threads(mv->threads, init);
+      mutt_thread_cache_store(mv->threads);
+    }
+#else
     mutt_sort_threads(mv->threads, init);
+#endif
   }
   else
   {
@@ -405,8 +803,23 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
     cmp.type = mx_type(m);
     cmp.sort = cs_subset_sort(NeoMutt->sub, "sort");
     cmp.sort_aux = cs_subset_sort(NeoMutt->sub, "sort_aux");
-    mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
-                 compare_email_shim, &cmp);
+#ifdef USE_HCACHE
+    if (!sort_cache_restore(m, &cmp))
+    {
+      if (!sort_merge_new(m, &cmp) && !sort_keyed(m, &cmp))
+      {
+        mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
+                     compare_email_shim, &cmp);
+      }
+      sort_cache_store(m, &cmp);
+    }
+#else
+    if (!sort_merge_new(m, &cmp) && !sort_keyed(m, &cmp))
+    {
+      mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
+                   compare_email_shim, &cmp);
+    }
+#endif
   }
 
   /* adjust the virtual message numbers */
@@ -112,7 +112,7 @@ static void dbt_empty_init(DBT *dbt)
 /**
  * store_bdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_bdb_open(const char *path, bool create)
+static StoreHandle *store_bdb_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
@@ -124,14 +124,15 @@ static StoreHandle *store_bdb_open(const char *path, bool create)
   buf_printf(&sdata->lockfile, "%s-lock-hack", path);
 
   sdata->fd = open(buf_string(&sdata->lockfile),
-                   O_WRONLY | (create ? O_CREAT : 0), S_IRUSR | S_IWUSR);
+                   O_WRONLY | ((create || read_only) ? O_CREAT : 0), S_IRUSR | S_IWUSR);
   if (sdata->fd < 0)
   {
     bdb_sdata_free(&sdata);
     return NULL;
   }
 
-  if (mutt_file_lock(sdata->fd, true, true))
+  /* Readers share the lock amongst themselves; only writers exclude */
+  if (mutt_file_lock(sdata->fd, !read_only, true))
     goto fail_close;
 
   int rc = db_env_create(&sdata->env, 0);
@@ -147,10 +148,10 @@ static StoreHandle *store_bdb_open(const char *path, bool create)
   if (rc)
     goto fail_env;
 
-  uint32_t createflags = DB_CREATE;
+  uint32_t createflags = read_only ? DB_RDONLY : DB_CREATE;
   struct stat st = { 0 };
 
-  if ((stat(path, &st) != 0) && (errno == ENOENT))
+  if (!read_only && (stat(path, &st) != 0) && (errno == ENOENT))
   {
     createflags |= DB_EXCL;
     sdata->db->set_pagesize(sdata->db, pagesize);
@@ -250,6 +251,59 @@ static int store_bdb_delete_record(StoreHandle *store, const char *key, size_t k
   return sdata->db->del(sdata->db, NULL, &dkey, 0);
 }
 
+/**
+ * store_bdb_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_bdb_delete_batch(StoreHandle *store, const char **keys,
+                                  const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_bdb_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_bdb_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ *
+ * The database isn't opened in a transactional environment, so writes are
+ * batched by the database itself.
+ */
+static int store_bdb_txn_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_bdb_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_bdb_txn_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_bdb_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_bdb_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct BdbStoreData *sdata = store;
+
+  return sdata->db->compact(sdata->db, NULL, NULL, NULL, NULL, DB_FREE_SPACE, NULL);
+}
+
 /**
  * store_bdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -39,13 +39,20 @@
 /**
  * store_gdbm_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_gdbm_open(const char *path, bool create)
+static StoreHandle *store_gdbm_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
 
   const int pagesize = 4096;
 
+  if (read_only)
+  {
+    /* GDBM_READER takes no write lock, so we can't disturb a read-write owner */
+    GDBM_FILE db = gdbm_open((char *) path, pagesize, GDBM_READER, 00600, NULL);
+    return (StoreHandle *) db;
+  }
+
   GDBM_FILE db = gdbm_open((char *) path, pagesize,
                            create ? GDBM_WRCREAT : GDBM_WRITER, 00600, NULL);
   if (!db)
@@ -131,6 +138,57 @@ static int store_gdbm_delete_record(StoreHandle *store, const char *key, size_t
   return gdbm_delete(db, dkey);
 }
 
+/**
+ * store_gdbm_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_gdbm_delete_batch(StoreHandle *store, const char **keys,
+                                   const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_gdbm_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_gdbm_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ *
+ * GDBM has no transactions, so writes go straight to the database.
+ */
+static int store_gdbm_txn_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_gdbm_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_gdbm_txn_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_gdbm_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_gdbm_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  GDBM_FILE db = store;
+  return gdbm_reorganize(db);
+}
+
 /**
  * store_gdbm_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -38,7 +38,7 @@
 /**
  * store_kyotocabinet_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_kyotocabinet_open(const char *path, bool create)
+static StoreHandle *store_kyotocabinet_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
@@ -51,7 +51,8 @@ static StoreHandle *store_kyotocabinet_open(const char *path, bool create)
 
   buf_printf(kcdbpath, "%s#type=kct#opts=l#rcomp=lex", path);
 
-  if (!kcdbopen(db, buf_string(kcdbpath), KCOWRITER | (create ? KCOCREATE : 0)))
+  const uint32_t mode = read_only ? KCOREADER : (KCOWRITER | (create ? KCOCREATE : 0));
+  if (!kcdbopen(db, buf_string(kcdbpath), mode))
   {
     int ecode = kcdbecode(db);
     mutt_debug(LL_DEBUG2, "kcdbopen failed for %s: %s (ecode %d)\n",
@@ -128,6 +129,73 @@ static int store_kyotocabinet_delete_record(StoreHandle *store, const char *key,
   return 0;
 }
 
+/**
+ * store_kyotocabinet_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_kyotocabinet_delete_batch(StoreHandle *store, const char **keys,
+                                           const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_kyotocabinet_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_kyotocabinet_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_kyotocabinet_txn_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+  if (!kcdbbegintran(db, false))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * store_kyotocabinet_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_kyotocabinet_txn_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+  if (!kcdbendtran(db, true))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * store_kyotocabinet_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ *
+ * The Kyoto Cabinet C API has no compaction call; the TreeDB defragments
+ * itself incrementally via the `dfunit` tuning parameter instead.
+ */
+static int store_kyotocabinet_vacuum(StoreHandle *store)
+{
+  return -1;
+}
+
 /**
  * store_kyotocabinet_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
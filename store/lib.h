@@ -76,14 +76,19 @@ struct StoreOps
    * open - Open a connection to a Store
    * @param[in] path Path to the database file
    * @param[in] create Create the file if it's not there?
+   * @param[in] read_only Open the file for reading only?
    * @retval ptr  Success, Store pointer
    * @retval NULL Failure
    *
    * The open function has the purpose of opening a backend-specific
    * connection to the database file specified by the path parameter. Backends
    * MUST return non-NULL specific handle information on success.
+   *
+   * A read-only handle takes no write locks, so concurrent instances don't
+   * contend with the owner of the read-write handle.  Write operations on it
+   * fail and `create` is ignored.
    */
-  StoreHandle *(*open)(const char *path, bool create);
+  StoreHandle *(*open)(const char *path, bool create, bool read_only);
 
   /**
    * @defgroup store_fetch fetch()
@@ -137,6 +142,65 @@ struct StoreOps
    */
   int (*delete_record)(StoreHandle *store, const char *key, size_t klen);
 
+  /**
+   * @defgroup store_delete_batch delete_batch()
+   * @ingroup store_api
+   *
+   * delete_batch - Delete a set of records from the Store
+   * @param[in] store Store retrieved via open()
+   * @param[in] keys  Array of Key strings
+   * @param[in] klens Array of Key lengths
+   * @param[in] count Number of Keys
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * The deletes are applied as a single write batch where the backend supports
+   * it.  Otherwise this is equivalent to calling delete_record() for each Key.
+   */
+  int (*delete_batch)(StoreHandle *store, const char **keys, const size_t *klens, size_t count);
+
+  /**
+   * @defgroup store_txn_begin txn_begin()
+   * @ingroup store_api
+   *
+   * txn_begin - Start a batch of writes to the Store
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * All writes made before the matching txn_commit() may be deferred and
+   * committed to the database in one go.  Backends without native
+   * transactions treat this as a no-op.
+   */
+  int (*txn_begin)(StoreHandle *store);
+
+  /**
+   * @defgroup store_txn_commit txn_commit()
+   * @ingroup store_api
+   *
+   * txn_commit - Commit a batch of writes to the Store
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   */
+  int (*txn_commit)(StoreHandle *store);
+
+  /**
+   * @defgroup store_vacuum vacuum()
+   * @ingroup store_api
+   *
+   * vacuum - Reclaim space left by deleted records
+   * @param[in] store Store retrieved via open()
+   * @retval  0 Success
+   * @retval -1 Compaction isn't supported by this backend
+   * @retval num Error, a backend-specific error code
+   *
+   * Databases grow as records are deleted and rewritten; vacuum rewrites the
+   * store so it only occupies the space its live records need.  This may be
+   * slow and may briefly block other users of the database file.
+   */
+  int (*vacuum)(StoreHandle *store);
+
   /**
    * @defgroup store_close close()
    * @ingroup store_api
@@ -168,6 +232,10 @@ bool                   store_is_valid_backend(const char *str);
     .free           = store_##_name##_free,                                    \
     .store          = store_##_name##_store,                                   \
     .delete_record  = store_##_name##_delete_record,                           \
+    .delete_batch   = store_##_name##_delete_batch,                            \
+    .txn_begin      = store_##_name##_txn_begin,                               \
+    .txn_commit     = store_##_name##_txn_commit,                              \
+    .vacuum         = store_##_name##_vacuum,                                  \
     .close          = store_##_name##_close,                                   \
     .version        = store_##_name##_version,                                 \
   };
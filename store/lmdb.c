@@ -30,10 +30,14 @@
  */
 
 #include "config.h"
+#include <errno.h>
+#include <limits.h>
 #include <lmdb.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "lib.h"
@@ -69,6 +73,8 @@ struct LmdbStoreData
   MDB_txn *txn;
   MDB_dbi db;
   enum LmdbTxnMode txn_mode;
+  char *path;     ///< Path of the database file, for vacuum()
+  bool read_only; ///< Environment is mapped read-only
 };
 
 /**
@@ -77,6 +83,11 @@ struct LmdbStoreData
  */
 static void lmdb_sdata_free(struct LmdbStoreData **ptr)
 {
+  if (!ptr || !*ptr)
+    return;
+
+  struct LmdbStoreData *sdata = *ptr;
+  FREE(&sdata->path);
   FREE(ptr);
 }
 
@@ -126,6 +137,9 @@ static int lmdb_get_read_txn(struct LmdbStoreData *sdata)
  */
 static int lmdb_get_write_txn(struct LmdbStoreData *sdata)
 {
+  if (sdata->read_only)
+    return EACCES;
+
   if (sdata->txn)
   {
     if (sdata->txn_mode == TXN_WRITE)
@@ -145,31 +159,25 @@ static int lmdb_get_write_txn(struct LmdbStoreData *sdata)
 }
 
 /**
- * store_lmdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
+ * lmdb_env_setup - Open an LMDB environment and its database
+ * @param sdata LMDB store
+ * @retval num LMDB return code, e.g. MDB_SUCCESS
+ *
+ * On failure, any partially-created environment is torn down again.
  */
-static StoreHandle *store_lmdb_open(const char *path, bool create)
+static int lmdb_env_setup(struct LmdbStoreData *sdata)
 {
-  if (!path)
-    return NULL;
-
-  if (!create && access(path, F_OK) != 0)
-  {
-    return NULL;
-  }
-
-  struct LmdbStoreData *sdata = lmdb_sdata_new();
-
   int rc = mdb_env_create(&sdata->env);
   if (rc != MDB_SUCCESS)
   {
     mutt_debug(LL_DEBUG2, "mdb_env_create: %s\n", mdb_strerror(rc));
-    lmdb_sdata_free(&sdata);
-    return NULL;
+    return rc;
   }
 
   mdb_env_set_mapsize(sdata->env, LMDB_DB_SIZE);
 
-  rc = mdb_env_open(sdata->env, path, MDB_NOSUBDIR, 0644);
+  rc = mdb_env_open(sdata->env, sdata->path,
+                    MDB_NOSUBDIR | (sdata->read_only ? MDB_RDONLY : 0), 0644);
   if (rc != MDB_SUCCESS)
   {
     mutt_debug(LL_DEBUG2, "mdb_env_open: %s\n", mdb_strerror(rc));
@@ -183,7 +191,7 @@ static StoreHandle *store_lmdb_open(const char *path, bool create)
     goto fail_env;
   }
 
-  rc = mdb_dbi_open(sdata->txn, NULL, MDB_CREATE, &sdata->db);
+  rc = mdb_dbi_open(sdata->txn, NULL, sdata->read_only ? 0 : MDB_CREATE, &sdata->db);
   if (rc != MDB_SUCCESS)
   {
     mutt_debug(LL_DEBUG2, "mdb_dbi_open: %s\n", mdb_strerror(rc));
@@ -192,8 +200,7 @@ static StoreHandle *store_lmdb_open(const char *path, bool create)
 
   mdb_txn_reset(sdata->txn);
   sdata->txn_mode = TXN_UNINITIALIZED;
-  // Return an opaque pointer
-  return (StoreHandle *) sdata;
+  return MDB_SUCCESS;
 
 fail_dbi:
   mdb_txn_abort(sdata->txn);
@@ -202,8 +209,35 @@ fail_dbi:
 
 fail_env:
   mdb_env_close(sdata->env);
-  lmdb_sdata_free(&sdata);
-  return NULL;
+  sdata->env = NULL;
+  return rc;
+}
+
+/**
+ * store_lmdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
+ */
+static StoreHandle *store_lmdb_open(const char *path, bool create, bool read_only)
+{
+  if (!path)
+    return NULL;
+
+  if ((!create || read_only) && (access(path, F_OK) != 0))
+  {
+    return NULL;
+  }
+
+  struct LmdbStoreData *sdata = lmdb_sdata_new();
+  sdata->path = mutt_str_dup(path);
+  sdata->read_only = read_only;
+
+  if (lmdb_env_setup(sdata) != MDB_SUCCESS)
+  {
+    lmdb_sdata_free(&sdata);
+    return NULL;
+  }
+
+  // Return an opaque pointer
+  return (StoreHandle *) sdata;
 }
 
 /**
@@ -323,6 +357,146 @@ static int store_lmdb_delete_record(StoreHandle *store, const char *key, size_t
   return rc;
 }
 
+/**
+ * store_lmdb_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ *
+ * All the deletes share one write transaction, so expunging thousands of
+ * records costs a single commit.
+ */
+static int store_lmdb_delete_batch(StoreHandle *store, const char **keys,
+                                   const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  int rc = lmdb_get_write_txn(sdata);
+  if (rc != MDB_SUCCESS)
+  {
+    mutt_debug(LL_DEBUG2, "lmdb_get_write_txn: %s\n", mdb_strerror(rc));
+    return rc;
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    MDB_val dkey = { 0 };
+    dkey.mv_data = (void *) keys[i];
+    dkey.mv_size = klens[i];
+    rc = mdb_del(sdata->txn, sdata->db, &dkey, NULL);
+    if (rc == MDB_NOTFOUND)
+      rc = MDB_SUCCESS;
+    if (rc != MDB_SUCCESS)
+    {
+      mutt_debug(LL_DEBUG2, "mdb_del: %s\n", mdb_strerror(rc));
+      mdb_txn_abort(sdata->txn);
+      sdata->txn_mode = TXN_UNINITIALIZED;
+      sdata->txn = NULL;
+      return rc;
+    }
+  }
+
+  return MDB_SUCCESS;
+}
+
+/**
+ * store_lmdb_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_lmdb_txn_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  return lmdb_get_write_txn(sdata);
+}
+
+/**
+ * store_lmdb_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_lmdb_txn_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  if (!sdata->txn || (sdata->txn_mode != TXN_WRITE))
+    return MDB_SUCCESS; // Nothing to commit
+
+  int rc = mdb_txn_commit(sdata->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  sdata->txn_mode = TXN_UNINITIALIZED;
+  sdata->txn = NULL;
+
+  return rc;
+}
+
+/**
+ * store_lmdb_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ *
+ * LMDB never returns freed pages to the filesystem, so the database is
+ * copy-compacted to a temporary file which then replaces the original.
+ */
+static int store_lmdb_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  if (sdata->read_only)
+    return -1;
+
+  /* The copy is made from a snapshot, so all writes must be committed first */
+  if (sdata->txn)
+  {
+    if (sdata->txn_mode == TXN_WRITE)
+      mdb_txn_commit(sdata->txn);
+    else
+      mdb_txn_abort(sdata->txn);
+
+    sdata->txn_mode = TXN_UNINITIALIZED;
+    sdata->txn = NULL;
+  }
+
+  char tmp[PATH_MAX] = { 0 };
+  snprintf(tmp, sizeof(tmp), "%s-compact", sdata->path);
+  unlink(tmp);
+
+  int rc = mdb_env_copy2(sdata->env, tmp, MDB_CP_COMPACT);
+  if (rc != MDB_SUCCESS)
+  {
+    mutt_debug(LL_DEBUG2, "mdb_env_copy2: %s\n", mdb_strerror(rc));
+    unlink(tmp);
+    return rc;
+  }
+
+  /* Swap the compacted copy in and reopen the environment */
+  mdb_env_close(sdata->env);
+  sdata->env = NULL;
+
+  if (rename(tmp, sdata->path) != 0)
+  {
+    mutt_debug(LL_DEBUG2, "rename: %s\n", strerror(errno));
+    unlink(tmp);
+    rc = -1;
+  }
+
+  int rc2 = lmdb_env_setup(sdata);
+  if (rc2 != MDB_SUCCESS)
+    return rc2;
+
+  return rc;
+}
+
 /**
  * store_lmdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -39,12 +39,13 @@
 /**
  * store_qdbm_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_qdbm_open(const char *path, bool create)
+static StoreHandle *store_qdbm_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
 
-  VILLA *db = vlopen(path, VL_OWRITER | (create ? VL_OCREAT : 0), VL_CMPLEX);
+  const int mode = read_only ? VL_OREADER : (VL_OWRITER | (create ? VL_OCREAT : 0));
+  VILLA *db = vlopen(path, mode, VL_CMPLEX);
 
   // Return an opaque pointer
   return (StoreHandle *) db;
@@ -107,6 +108,58 @@ static int store_qdbm_delete_record(StoreHandle *store, const char *key, size_t
   return success ? 0 : dpecode ? dpecode : -1;
 }
 
+/**
+ * store_qdbm_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_qdbm_delete_batch(StoreHandle *store, const char **keys,
+                                   const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_qdbm_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_qdbm_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ *
+ * QDBM has no transactions, so writes go straight to the database.
+ */
+static int store_qdbm_txn_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_qdbm_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_qdbm_txn_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_qdbm_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_qdbm_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  VILLA *db = store;
+  bool success = vloptimize(db);
+  return success ? 0 : dpecode ? dpecode : -1;
+}
+
 /**
  * store_qdbm_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -74,7 +74,7 @@ static struct RocksDbStoreData *rocksdb_sdata_new(void)
 /**
  * store_rocksdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_rocksdb_open(const char *path, bool create)
+static StoreHandle *store_rocksdb_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
@@ -86,7 +86,7 @@ static StoreHandle *store_rocksdb_open(const char *path, bool create)
 
   /* setup generic options, create new db and limit log to one file */
   sdata->options = rocksdb_options_create();
-  if (create)
+  if (create && !read_only)
   {
     rocksdb_options_set_create_if_missing(sdata->options, 1);
   }
@@ -104,7 +104,10 @@ static StoreHandle *store_rocksdb_open(const char *path, bool create)
   rocksdb_options_set_compression(sdata->options, rocksdb_no_compression);
 
   /* open database and check for error in sdata->error */
-  sdata->db = rocksdb_open(sdata->options, path, &sdata->err);
+  if (read_only)
+    sdata->db = rocksdb_open_for_read_only(sdata->options, path, 0, &sdata->err);
+  else
+    sdata->db = rocksdb_open(sdata->options, path, &sdata->err);
   if (sdata->err)
   {
     rocksdb_options_destroy(sdata->options);
@@ -193,6 +196,70 @@ static int store_rocksdb_delete_record(StoreHandle *store, const char *key, size
   return 0;
 }
 
+/**
+ * store_rocksdb_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ *
+ * The deletes go into one native WriteBatch, applied atomically.
+ */
+static int store_rocksdb_delete_batch(StoreHandle *store, const char **keys,
+                                      const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  rocksdb_writebatch_t *wb = rocksdb_writebatch_create();
+  for (size_t i = 0; i < count; i++)
+    rocksdb_writebatch_delete(wb, keys[i], klens[i]);
+
+  rocksdb_write(sdata->db, sdata->write_options, wb, &sdata->err);
+  rocksdb_writebatch_destroy(wb);
+  if (sdata->err)
+  {
+    rocksdb_free(sdata->err);
+    sdata->err = NULL;
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * store_rocksdb_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ *
+ * RocksDB batches writes in its memtable, so there's nothing to do.
+ */
+static int store_rocksdb_txn_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_rocksdb_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_rocksdb_txn_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_rocksdb_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_rocksdb_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  // A NULL range compacts the whole database
+  rocksdb_compact_range(sdata->db, NULL, 0, NULL, 0);
+  return 0;
+}
+
 /**
  * store_rocksdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
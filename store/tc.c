@@ -31,6 +31,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <tcbdb.h>
 #include <tcutil.h>
 #include "mutt/lib.h"
@@ -39,7 +40,7 @@
 /**
  * store_tokyocabinet_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_tokyocabinet_open(const char *path, bool create)
+static StoreHandle *store_tokyocabinet_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
@@ -47,7 +48,8 @@ static StoreHandle *store_tokyocabinet_open(const char *path, bool create)
   TCBDB *db = tcbdbnew();
   if (!db)
     return NULL;
-  if (!tcbdbopen(db, path, BDBOWRITER | (create ? BDBOCREAT : 0)))
+  const int mode = read_only ? BDBOREADER : (BDBOWRITER | (create ? BDBOCREAT : 0));
+  if (!tcbdbopen(db, path, mode))
   {
     int ecode = tcbdbecode(db);
     mutt_debug(LL_DEBUG2, "tcbdbopen failed for %s: %s (ecode %d)\n", path,
@@ -122,6 +124,81 @@ static int store_tokyocabinet_delete_record(StoreHandle *store, const char *key,
   return 0;
 }
 
+/**
+ * store_tokyocabinet_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_tokyocabinet_delete_batch(StoreHandle *store, const char **keys,
+                                           const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_tokyocabinet_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_tokyocabinet_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_tokyocabinet_txn_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TCBDB *db = store;
+  if (!tcbdbtranbegin(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * store_tokyocabinet_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_tokyocabinet_txn_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TCBDB *db = store;
+  if (!tcbdbtrancommit(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * store_tokyocabinet_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_tokyocabinet_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TCBDB *db = store;
+  // Keep the current tuning parameters, just rewrite the file
+  if (!tcbdboptimize(db, 0, 0, 0, -1, -1, UINT8_MAX))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * store_tokyocabinet_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -39,7 +39,7 @@
 /**
  * store_tdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
-static StoreHandle *store_tdb_open(const char *path, bool create)
+static StoreHandle *store_tdb_open(const char *path, bool create, bool read_only)
 {
   if (!path)
     return NULL;
@@ -51,8 +51,8 @@ static StoreHandle *store_tdb_open(const char *path, bool create)
   const int flags = TDB_NOLOCK | TDB_INCOMPATIBLE_HASH | TDB_NOSYNC;
   const int hash_size = 33533; // Based on test timings for 100K emails
 
-  struct tdb_context *db = tdb_open(path, hash_size, flags,
-                                    (create ? O_CREAT : 0) | O_RDWR, 00600);
+  const int open_flags = read_only ? O_RDONLY : ((create ? O_CREAT : 0) | O_RDWR);
+  struct tdb_context *db = tdb_open(path, hash_size, flags, open_flags, 00600);
 
   // Return an opaque pointer
   return (StoreHandle *) db;
@@ -128,6 +128,65 @@ static int store_tdb_delete_record(StoreHandle *store, const char *key, size_t k
   return tdb_delete(db, dkey);
 }
 
+/**
+ * store_tdb_delete_batch - Delete a set of records from the Store - Implements StoreOps::delete_batch() - @ingroup store_delete_batch
+ */
+static int store_tdb_delete_batch(StoreHandle *store, const char **keys,
+                                  const size_t *klens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  int rc = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    int rc2 = store_tdb_delete_record(store, keys[i], klens[i]);
+    if (rc2 != 0)
+      rc = rc2;
+  }
+
+  return rc;
+}
+
+/**
+ * store_tdb_txn_begin - Start a batch of writes to the Store - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_tdb_txn_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct tdb_context *db = store;
+  return tdb_transaction_start(db);
+}
+
+/**
+ * store_tdb_txn_commit - Commit a batch of writes to the Store - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_tdb_txn_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct tdb_context *db = store;
+  return tdb_transaction_commit(db);
+}
+
+/**
+ * store_tdb_vacuum - Reclaim space left by deleted records - Implements StoreOps::vacuum() - @ingroup store_vacuum
+ */
+static int store_tdb_vacuum(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct tdb_context *db = store;
+  return tdb_repack(db);
+}
+
 /**
  * store_tdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
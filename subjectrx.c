@@ -27,6 +27,9 @@
  */
 
 #include "config.h"
+#include <ctype.h>
+#include <regex.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "mutt/lib.h"
@@ -40,6 +43,58 @@
 static struct ReplaceList SubjectRegexList = STAILQ_HEAD_INITIALIZER(SubjectRegexList);
 static struct Notify *SubjRxNotify = NULL; ///< Notifications: #NotifySubjRx
 
+/// Alternation of every subjectrx pattern, for a single-pass prefilter
+static regex_t SubjectRegexAll;
+static bool SubjectRegexAllOk = false;    ///< The combined regex is compiled and usable
+static bool SubjectRegexAllDirty = true;  ///< The rules changed; recompile before next use
+
+/**
+ * subjrx_compile_prefilter - Combine all the subjectrx patterns into one regex
+ *
+ * Most subjects aren't rewritten by any rule, but finding that out used to
+ * cost one regexec() per rule per subject.  The patterns are all compiled with
+ * the same flags, so they can be joined into a single alternation,
+ * `(rule1)|(rule2)|...`, which rejects a subject against every rule in one
+ * pass.  Only subjects it matches take the per-rule replacement walk.
+ *
+ * A pattern containing a backreference can't be combined - the alternation
+ * renumbers its groups - so such rule lists keep the per-rule walk.
+ */
+static void subjrx_compile_prefilter(void)
+{
+  if (SubjectRegexAllOk)
+    regfree(&SubjectRegexAll);
+  SubjectRegexAllOk = false;
+  SubjectRegexAllDirty = false;
+
+  if (STAILQ_EMPTY(&SubjectRegexList))
+    return;
+
+  struct Buffer *all = buf_pool_get();
+
+  struct Replace *np = NULL;
+  STAILQ_FOREACH(np, &SubjectRegexList, entries)
+  {
+    for (const char *p = np->regex->pattern; *p; p++)
+    {
+      if ((p[0] == '\\') && isdigit((unsigned char) p[1]))
+        goto done;
+    }
+
+    if (!buf_is_empty(all))
+      buf_addch(all, '|');
+    buf_addch(all, '(');
+    buf_addstr(all, np->regex->pattern);
+    buf_addch(all, ')');
+  }
+
+  if (REG_COMP(&SubjectRegexAll, buf_string(all), REG_ICASE | REG_NOSUB) == 0)
+    SubjectRegexAllOk = true;
+
+done:
+  buf_pool_release(&all);
+}
+
 /**
  * subjrx_cleanup - Free the Subject Regex List
  */
@@ -47,6 +102,10 @@ void subjrx_cleanup(void)
 {
   notify_free(&SubjRxNotify);
   mutt_replacelist_free(&SubjectRegexList);
+  if (SubjectRegexAllOk)
+    regfree(&SubjectRegexAll);
+  SubjectRegexAllOk = false;
+  SubjectRegexAllDirty = true;
 }
 
 /**
@@ -141,6 +200,17 @@ bool subjrx_apply_mods(struct Envelope *env)
   if (STAILQ_EMPTY(&SubjectRegexList))
     return false;
 
+  if (SubjectRegexAllDirty)
+    subjrx_compile_prefilter();
+
+  /* One pass over the subject checks it against every rule at once */
+  if (SubjectRegexAllOk &&
+      (regexec(&SubjectRegexAll, env->subject, 0, NULL, 0) == REG_NOMATCH))
+  {
+    env->disp_subj = mutt_str_dup(env->subject);
+    return true;
+  }
+
   env->disp_subj = mutt_replacelist_apply(&SubjectRegexList, env->subject);
   return true;
 }
@@ -176,6 +246,7 @@ enum CommandResult parse_subjectrx_list(struct Buffer *buf, struct Buffer *s,
   rc = parse_replace_list(buf, s, &SubjectRegexList, err);
   if (rc == MUTT_CMD_SUCCESS)
   {
+    SubjectRegexAllDirty = true;
     mutt_debug(LL_NOTIFY, "NT_SUBJRX_ADD: %s\n", buf->data);
     notify_send(SubjRxNotify, NT_SUBJRX, NT_SUBJRX_ADD, NULL);
   }
@@ -193,6 +264,7 @@ enum CommandResult parse_unsubjectrx_list(struct Buffer *buf, struct Buffer *s,
   rc = parse_unreplace_list(buf, s, &SubjectRegexList, err);
   if (rc == MUTT_CMD_SUCCESS)
   {
+    SubjectRegexAllDirty = true;
     mutt_debug(LL_NOTIFY, "NT_SUBJRX_DELETE: %s\n", buf->data);
     notify_send(SubjRxNotify, NT_SUBJRX, NT_SUBJRX_DELETE, NULL);
   }
@@ -221,6 +221,24 @@ static bool test_string_set(struct ConfigSubset *sub, struct Buffer *err)
     TEST_MSG("Expected error: %s", buf_string(err));
   }
 
+  name = "Damson";
+  buf_reset(err);
+  rc = cs_str_string_set(cs, name, "same@example.com", err);
+  if (!TEST_CHECK(CSR_RESULT(rc) == CSR_SUCCESS))
+  {
+    TEST_MSG("%s", buf_string(err));
+    return false;
+  }
+
+  buf_reset(err);
+  rc = cs_str_string_set(cs, name, "same@example.com", err);
+  if (!TEST_CHECK((rc & CSR_SUC_NO_CHANGE) != 0))
+  {
+    TEST_MSG("Value of %s changed", name);
+    return false;
+  }
+  TEST_MSG("Value of %s wasn't changed", name);
+
   log_line(__func__);
   return true;
 }
@@ -320,6 +338,16 @@ static bool test_native_set(struct ConfigSubset *sub, struct Buffer *err)
   addr = VarJackfruit ? VarJackfruit->mailbox : NULL;
   TEST_MSG("%s = '%s', set by NULL", name, buf_string(addr));
 
+  name = "Ilama";
+  buf_reset(err);
+  rc = cs_str_native_set(cs, name, (intptr_t) a, err);
+  if (!TEST_CHECK((rc & CSR_SUC_NO_CHANGE) != 0))
+  {
+    TEST_MSG("Value of %s changed", name);
+    goto tbns_out;
+  }
+  TEST_MSG("Value of %s wasn't changed", name);
+
   log_line(__func__);
   result = true;
 tbns_out:
@@ -0,0 +1,240 @@
+/**
+ * @file
+ * Microbenchmarks for core hot paths
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * These benchmarks run as part of the normal test suite with a tiny workload,
+ * so they double as smoke tests.  `make bench` reruns just them with a much
+ * larger workload (see $NEOMUTT_BENCH_SCALE) and prints ops/sec, so runs can
+ * be compared before and after a change.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "email/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#ifdef USE_HCACHE
+#include "hcache/serialize.h"
+#endif
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "auto_subscribe", DT_BOOL, false, 0, NULL },
+  { "autocrypt", DT_BOOL, false, 0, NULL },
+  { "idn_decode", DT_BOOL, true, 0, NULL },
+  { "reply_regex", DT_REGEX, IP "^((re)(\\[[0-9]+\\])*:[ \t]*)*", 0, NULL },
+  { "rfc2047_parameters", DT_BOOL, true, 0, NULL },
+  { "spam_separator", DT_STRING, IP ",", 0, NULL },
+  { "weed", DT_BOOL, true, 0, NULL },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * bench_init - Register the config the benchmarked code reads
+ */
+static void bench_init(void)
+{
+  static bool registered = false;
+  if (registered)
+    return;
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+  registered = true;
+}
+
+/**
+ * bench_scale - Number of operations to run per benchmark
+ * @retval num Workload size, from $NEOMUTT_BENCH_SCALE
+ *
+ * Defaults to a small number so the benchmarks stay cheap when they run as
+ * part of the ordinary test suite.
+ */
+static size_t bench_scale(void)
+{
+  const char *env = mutt_str_getenv("NEOMUTT_BENCH_SCALE");
+  size_t scale = env ? strtoul(env, NULL, 10) : 0;
+  return (scale == 0) ? 100 : scale;
+}
+
+/**
+ * bench_report - Print one benchmark result
+ * @param name Benchmark name
+ * @param ops  Number of operations performed
+ * @param nsec Elapsed time, in nanoseconds
+ */
+static void bench_report(const char *name, size_t ops, uint64_t nsec)
+{
+  if (nsec == 0)
+    nsec = 1;
+  printf("bench: %-24s %10zu ops %10.3f ms %12.0f ops/sec\n", name, ops,
+         (double) nsec / 1e6, ((double) ops * 1e9) / (double) nsec);
+}
+
+/**
+ * bench_email_new - Create a synthetic Email
+ * @param i Index, used to vary the generated fields
+ * @retval ptr New Email
+ */
+static struct Email *bench_email_new(size_t i)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+
+  char buf[128];
+  snprintf(buf, sizeof(buf), "[bench] message %zu, with a realistically long subject", i);
+  mutt_env_set_subject(e->env, buf);
+
+  snprintf(buf, sizeof(buf), "User Number %zu <user%zu@example.com>", i, i % 97);
+  mutt_addrlist_parse(&e->env->from, buf);
+  mutt_addrlist_parse(&e->env->to, "reader@example.net");
+
+  snprintf(buf, sizeof(buf), "<%zu@bench.example.com>", i);
+  e->env->message_id = mutt_str_dup(buf);
+
+  e->date_sent = 1000000000 + (i * 60);
+  e->received = e->date_sent;
+  e->lines = 42;
+
+  return e;
+}
+
+void bench_rfc822_read_header(void)
+{
+  bench_init();
+  const size_t n = bench_scale();
+
+  FILE *fp = tmpfile();
+  if (!TEST_CHECK(fp != NULL))
+    return;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    fprintf(fp,
+            "From: User Number %zu <user%zu@example.com>\n"
+            "To: reader@example.net\n"
+            "Cc: another.reader@example.org\n"
+            "Subject: [bench] message %zu, with a realistically long subject\n"
+            "Message-ID: <%zu@bench.example.com>\n"
+            "References: <%zu@bench.example.com> <%zu@bench.example.com>\n"
+            "Date: Thu, 1 Jan 2026 12:00:00 +0000\n"
+            "MIME-Version: 1.0\n"
+            "Content-Type: text/plain; charset=utf-8\n"
+            "\n",
+            i, i % 97, i, i, i / 2, i / 3);
+  }
+  rewind(fp);
+
+  const uint64_t t_start = perf_clock();
+  size_t parsed = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    struct Envelope *env = mutt_rfc822_read_header(fp, NULL, false, false);
+    if (env)
+      parsed++;
+    mutt_env_free(&env);
+  }
+  const uint64_t elapsed = perf_clock() - t_start;
+
+  TEST_CHECK(parsed == n);
+  bench_report("rfc822_read_header", parsed, elapsed);
+  fclose(fp);
+}
+
+void bench_pattern_exec(void)
+{
+  bench_init();
+  const size_t n = bench_scale();
+
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, "~s bench ~f example", 0, err);
+  if (!TEST_CHECK(pat != NULL))
+  {
+    TEST_MSG("%s", buf_string(err));
+    buf_pool_release(&err);
+    return;
+  }
+  buf_pool_release(&err);
+
+  struct EmailArray emails = ARRAY_HEAD_INITIALIZER;
+  for (size_t i = 0; i < n; i++)
+  {
+    struct Email *e = bench_email_new(i);
+    ARRAY_ADD(&emails, e);
+  }
+
+  const uint64_t t_start = perf_clock();
+  size_t matches = 0;
+  struct Email **ep = NULL;
+  ARRAY_FOREACH(ep, &emails)
+  {
+    if (mutt_pattern_exec(SLIST_FIRST(pat), 0, NULL, *ep, NULL))
+      matches++;
+  }
+  const uint64_t elapsed = perf_clock() - t_start;
+
+  TEST_CHECK(matches == n);
+  bench_report("pattern_exec", n, elapsed);
+
+  ARRAY_FOREACH(ep, &emails)
+  {
+    email_free(ep);
+  }
+  ARRAY_FREE(&emails);
+  mutt_pattern_free(&pat);
+}
+
+void bench_serialize_envelope(void)
+{
+#ifdef USE_HCACHE
+  const size_t n = bench_scale();
+
+  struct Email *e = bench_email_new(0);
+
+  const uint64_t t_start = perf_clock();
+  for (size_t i = 0; i < n; i++)
+  {
+    int off = 0;
+    unsigned char *d = mutt_mem_malloc(4096);
+    d = serial_dump_envelope(e->env, d, &off, false);
+
+    struct Envelope *env = mutt_env_new();
+    int roff = 0;
+    serial_restore_envelope(env, d, &roff, false);
+    TEST_CHECK(roff == off);
+
+    mutt_env_free(&env);
+    FREE(&d);
+  }
+  const uint64_t elapsed = perf_clock() - t_start;
+
+  bench_report("serialize_envelope", n, elapsed);
+  email_free(&e);
+#else
+  printf("bench: serialize_envelope skipped (no header cache support)\n");
+#endif
+}
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * Test code for buf_addbuf()
+ *
+ * @authors
+ * Copyright (C) 2025 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_buf_addbuf(void)
+{
+  // size_t buf_addbuf(struct Buffer *buf, const struct Buffer *src);
+
+  {
+    struct Buffer *buf = buf_pool_get();
+    TEST_CHECK(buf_addbuf(NULL, buf) == 0);
+    TEST_CHECK(buf_addbuf(buf, NULL) == 0);
+    buf_pool_release(&buf);
+  }
+
+  TEST_CASE("Adding to an empty Buffer");
+
+  {
+    struct Buffer *buf = buf_pool_get();
+    struct Buffer *src = buf_pool_get();
+    buf_addstr(src, "a quick brown fox");
+
+    TEST_CHECK(buf_addbuf(buf, src) == buf_len(src));
+    TEST_CHECK_STR_EQ(buf_string(buf), "a quick brown fox");
+
+    buf_pool_release(&src);
+    buf_pool_release(&buf);
+  }
+
+  TEST_CASE("Adding to a non-empty Buffer");
+
+  {
+    struct Buffer *buf = buf_pool_get();
+    struct Buffer *src = buf_pool_get();
+    buf_addstr(buf, "test");
+    buf_addstr(src, "a quick brown fox");
+
+    TEST_CHECK(buf_addbuf(buf, src) == buf_len(src));
+    TEST_CHECK_STR_EQ(buf_string(buf), "testa quick brown fox");
+
+    buf_pool_release(&src);
+    buf_pool_release(&buf);
+  }
+
+  TEST_CASE("Adding an empty Buffer");
+
+  {
+    struct Buffer *buf = buf_pool_get();
+    struct Buffer *src = buf_pool_get();
+    buf_addstr(buf, "test");
+
+    TEST_CHECK(buf_addbuf(buf, src) == 0);
+    TEST_CHECK_STR_EQ(buf_string(buf), "test");
+
+    buf_pool_release(&src);
+    buf_pool_release(&buf);
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file
+ * Test code for buf_move()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_buf_move(void)
+{
+  // void buf_move(struct Buffer *dst, struct Buffer *src);
+
+  {
+    buf_move(NULL, NULL);
+    TEST_CHECK_(true, "buf_move(NULL, NULL)");
+  }
+
+  {
+    struct Buffer *buf1 = buf_pool_get();
+
+    buf_move(buf1, NULL);
+    buf_move(NULL, buf1);
+    buf_move(buf1, buf1);
+    TEST_CHECK(buf_is_empty(buf1) == true);
+
+    buf_pool_release(&buf1);
+  }
+
+  {
+    // Move transfers the contents and empties the source
+    struct Buffer *src = buf_pool_get();
+    struct Buffer *dst = buf_pool_get();
+
+    buf_addstr(src, "hello");
+    const char *data = src->data;
+
+    buf_move(dst, src);
+
+    TEST_CHECK_STR_EQ(buf_string(dst), "hello");
+    TEST_CHECK(buf_is_empty(src) == true);
+    TEST_CHECK(dst->data == data); // the storage moved, no copy was made
+
+    buf_pool_release(&src);
+    buf_pool_release(&dst);
+  }
+
+  {
+    // The destination's old contents are discarded
+    struct Buffer *src = buf_pool_get();
+    struct Buffer *dst = buf_pool_get();
+
+    buf_addstr(src, "apple");
+    buf_addstr(dst, "banana");
+
+    buf_move(dst, src);
+
+    TEST_CHECK_STR_EQ(buf_string(dst), "apple");
+    TEST_CHECK(buf_is_empty(src) == true);
+
+    // The source is still usable afterwards
+    buf_addstr(src, "cherry");
+    TEST_CHECK_STR_EQ(buf_string(src), "cherry");
+
+    buf_pool_release(&src);
+    buf_pool_release(&dst);
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * Test code for buf_take_string()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_buf_take_string(void)
+{
+  // char *buf_take_string(struct Buffer *buf);
+
+  {
+    TEST_CHECK(buf_take_string(NULL) == NULL);
+  }
+
+  {
+    // An unallocated Buffer has no string to take
+    struct Buffer buf = { 0 };
+    TEST_CHECK(buf_take_string(&buf) == NULL);
+  }
+
+  {
+    struct Buffer *buf = buf_pool_get();
+    buf_addstr(buf, "hello");
+    const char *data = buf->data;
+
+    char *str = buf_take_string(buf);
+
+    TEST_CHECK_STR_EQ(str, "hello");
+    TEST_CHECK(str == data); // the storage was detached, no copy was made
+    TEST_CHECK(buf->data == NULL);
+    TEST_CHECK(buf->dsize == 0);
+
+    // The Buffer is still usable afterwards
+    buf_addstr(buf, "world");
+    TEST_CHECK_STR_EQ(buf_string(buf), "world");
+
+    FREE(&str);
+    buf_pool_release(&buf);
+  }
+}
@@ -188,6 +188,7 @@ void test_fini(void)
   config_cache_cleanup();
   test_neomutt_destroy();
   buf_pool_cleanup();
+  slab_cleanup();
 }
 
 struct IndexSharedData *index_shared_data_new(void)
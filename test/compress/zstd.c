@@ -77,6 +77,17 @@ void test_compress_zstd(void)
     MuttLogger = log_disp_terminal;
   }
 
+  {
+    // Dictionary: degenerate tests
+    TEST_CHECK(compr_ops->dict_load(NULL, NULL) == false);
+    TEST_CHECK(compr_ops->dict_train(NULL, NULL, NULL, NULL, 0) == false);
+
+    ComprHandle *compr_handle = compr_ops->open(MIN_COMP_LEVEL);
+    TEST_CHECK(compr_handle != NULL);
+    TEST_CHECK(compr_ops->dict_load(compr_handle, "/missing/dictionary") == false);
+    compr_ops->close(&compr_handle);
+  }
+
   {
     // Garbage data
     ComprHandle *compr_handle = compr_ops->open(MIN_COMP_LEVEL);
@@ -261,6 +261,34 @@ void test_config_subset(void)
     return;
   }
 
+  // Memoized handles
+  struct ConfigMemo memo = CONFIG_MEMO_INIT(name);
+
+  value = cs_subset_memo_native_get(NULL, &memo);
+  TEST_CHECK(value == INT_MIN);
+  value = cs_subset_memo_native_get(n->sub, NULL);
+  TEST_CHECK(value == INT_MIN);
+
+  cs_subset_str_native_set(n->sub, name, 42, NULL);
+  value = cs_subset_memo_native_get(n->sub, &memo);
+  TEST_CHECK(value == 42);
+
+  // A cache hit returns the same value
+  value = cs_subset_memo_native_get(n->sub, &memo);
+  TEST_CHECK(value == 42);
+
+  // Any config change invalidates the handle
+  cs_subset_str_native_set(n->sub, name, 99, NULL);
+  value = cs_subset_memo_native_get(n->sub, &memo);
+  TEST_CHECK(value == 99);
+
+  // A different Subset isn't served from the cache
+  cs_subset_str_native_set(sub_m, name, 123, NULL);
+  value = cs_subset_memo_native_get(sub_m, &memo);
+  TEST_CHECK(value == 123);
+  value = cs_subset_memo_native_get(n->sub, &memo);
+  TEST_CHECK(value == 99);
+
   cs_subset_free(&sub_m);
   cs_subset_free(&sub_a);
 
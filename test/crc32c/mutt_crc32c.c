@@ -0,0 +1,67 @@
+/**
+ * @file
+ * Test code for mutt_crc32c()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include <string.h>
+#include "mutt/lib.h"
+
+void test_mutt_crc32c(void)
+{
+  // uint32_t mutt_crc32c(uint32_t crc, const void *data, size_t len);
+
+  {
+    TEST_CHECK(mutt_crc32c(42, NULL, 10) == 42);
+    TEST_CHECK(mutt_crc32c(0, "", 0) == 0);
+  }
+
+  {
+    // Known-answer vectors from RFC 3720, Appendix B.4
+    const unsigned char zeros[32] = { 0 };
+    TEST_CHECK(mutt_crc32c(0, zeros, sizeof(zeros)) == 0x8a9136aa);
+
+    unsigned char ones[32];
+    memset(ones, 0xff, sizeof(ones));
+    TEST_CHECK(mutt_crc32c(0, ones, sizeof(ones)) == 0x62a8ab43);
+
+    TEST_CHECK(mutt_crc32c(0, "123456789", 9) == 0xe3069283);
+  }
+
+  {
+    // Checksumming in pieces matches one pass over the whole buffer
+    const char *str = "The quick brown fox jumps over the lazy dog";
+    const size_t len = strlen(str);
+    const uint32_t whole = mutt_crc32c(0, str, len);
+    for (size_t split = 0; split <= len; split++)
+    {
+      const uint32_t crc = mutt_crc32c(0, str, split);
+      TEST_CHECK(mutt_crc32c(crc, str + split, len - split) == whole);
+    }
+  }
+
+  {
+    // Different seeds must give different digests
+    TEST_CHECK(mutt_crc32c(0, "123456789", 9) != mutt_crc32c(1, "123456789", 9));
+  }
+}
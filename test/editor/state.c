@@ -24,11 +24,14 @@
 #include "config.h"
 #include "acutest.h"
 #include <stddef.h>
+#include <wchar.h>
 #include "editor/lib.h"
 
 void test_editor_state(void)
 {
   enter_state_resize(NULL, 16);
+  enter_state_insert(NULL, L'x');
+  enter_state_gap_close(NULL);
 
   struct EnterState *es = enter_state_new();
 
@@ -39,5 +42,31 @@ void test_editor_state(void)
 
   enter_state_free(&es);
 
+  es = enter_state_new();
+
+  // Insert at the end of the line
+  const wchar_t *str = L"hello";
+  for (size_t i = 0; str[i]; i++)
+    enter_state_insert(es, str[i]);
+
+  enter_state_gap_close(es);
+  TEST_CHECK(es->gap == 0);
+  TEST_CHECK(es->lastchar == 5);
+  TEST_CHECK(es->curpos == 5);
+  TEST_CHECK(wmemcmp(es->wbuf, L"hello", 5) == 0);
+
+  // Insert in the middle of the line
+  es->curpos = 2;
+  enter_state_insert(es, L'X');
+  enter_state_insert(es, L'Y');
+
+  enter_state_gap_close(es);
+  enter_state_gap_close(es); // harmless when there's no gap
+  TEST_CHECK(es->lastchar == 7);
+  TEST_CHECK(es->curpos == 4);
+  TEST_CHECK(wmemcmp(es->wbuf, L"heXYllo", 7) == 0);
+
+  enter_state_free(&es);
+
   enter_state_free(NULL);
 }
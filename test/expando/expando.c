@@ -142,4 +142,27 @@ void test_expando_expando(void)
     buf_pool_release(&err);
     expando_free(&exp);
   }
+
+  // bool expando_uses(const struct Expando *exp, int did, int uid);
+  {
+    const struct ExpandoDefinition TestFormatDef[] = {
+      // clang-format off
+      { "a", "from", ED_ENVELOPE, ED_ENV_FROM, E_TYPE_STRING, NULL },
+      { "b", "to",   ED_ENVELOPE, ED_ENV_TO,   E_TYPE_STRING, NULL },
+      { NULL, NULL, 0, -1, -1, NULL }
+      // clang-format on
+    };
+
+    struct Buffer *err = buf_pool_get();
+    struct Expando *exp = expando_parse("text %a %?b?yes&no?", TestFormatDef, err);
+    TEST_CHECK(exp != NULL);
+
+    TEST_CHECK(expando_uses(exp, ED_ENVELOPE, ED_ENV_FROM));
+    TEST_CHECK(expando_uses(exp, ED_ENVELOPE, ED_ENV_TO)); // inside a condition
+    TEST_CHECK(!expando_uses(exp, ED_ENVELOPE, ED_ENV_CC_ALL));
+    TEST_CHECK(!expando_uses(NULL, ED_ENVELOPE, ED_ENV_FROM));
+
+    buf_pool_release(&err);
+    expando_free(&exp);
+  }
 }
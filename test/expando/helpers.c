@@ -174,4 +174,19 @@ void test_expando_helpers(void)
 
     buf_pool_release(&buf);
   }
+
+  // void buf_lower_special_at(struct Buffer *buf, size_t offset);
+  {
+    struct Buffer *buf = buf_pool_get();
+
+    buf_strcpy(buf, "APPLE-BANANA");
+    buf_lower_special_at(buf, 6);
+    TEST_CHECK_STR_EQ(buf_string(buf), "APPLE-banana");
+
+    buf_strcpy(buf, "APPLE");
+    buf_lower_special_at(buf, 99); // Out of bounds
+    TEST_CHECK_STR_EQ(buf_string(buf), "APPLE");
+
+    buf_pool_release(&buf);
+  }
 }
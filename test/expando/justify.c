@@ -31,6 +31,7 @@
 #include "test_common.h"
 
 void buf_justify(struct Buffer *buf, enum FormatJustify justify, size_t cols, char pad_char);
+void buf_justify_at(struct Buffer *buf, size_t start, enum FormatJustify justify, size_t cols, char pad_char);
 
 struct TestCase
 {
@@ -103,4 +104,33 @@ void test_expando_justify(void)
 
     buf_pool_release(&buf);
   }
+
+  // void buf_justify_at(struct Buffer *buf, size_t start, enum FormatJustify justify, size_t cols, char pad_char);
+
+  {
+    struct Buffer *buf = buf_pool_get();
+
+    for (size_t i = 0; i < mutt_array_size(tests); i++)
+    {
+      const struct TestCase *test = &tests[i];
+      buf_reset(buf);
+      buf_addstr(buf, "prefix-");
+      buf_addstr(buf, test->str);
+
+      TEST_CASE_("'%s', %s, %d", test->str, name_format_justify(test->justify) + 8, test->cols);
+
+      buf_justify_at(buf, 7, test->justify, test->cols, pad_char);
+
+      TEST_CHECK(mutt_strn_equal(buf_string(buf), "prefix-", 7));
+      TEST_CHECK_STR_EQ(buf_string(buf) + 7, test->expected);
+    }
+
+    {
+      buf_strcpy(buf, "apple");
+      buf_justify_at(buf, 99, JUSTIFY_LEFT, 10, 'x'); // Out of bounds
+      TEST_CHECK_STR_EQ(buf_string(buf), "apple");
+    }
+
+    buf_pool_release(&buf);
+  }
 }
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * Test code for the IMAP MSN table
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "imap/edata.h"
+#include "imap/msn.h"
+#include "test_common.h" // IWYU pragma: keep
+
+void test_imap_msn(void)
+{
+  struct MSNArray msn = { 0 };
+  struct Email *emails[10] = { 0 };
+
+  imap_msn_reserve(&msn, 10);
+  for (size_t i = 0; i < 10; i++)
+  {
+    emails[i] = email_new();
+    emails[i]->edata = imap_edata_new();
+    emails[i]->edata_free = imap_edata_free;
+    imap_edata_get(emails[i])->msn = i + 1;
+    imap_msn_set(&msn, i, emails[i]);
+  }
+
+  TEST_CHECK(imap_msn_highest(&msn) == 10);
+  TEST_CHECK(imap_msn_get(&msn, 4) == emails[4]);
+
+  // Expunge MSN 3, then MSN 3 again - the server renumbers between EXPUNGEs
+  imap_msn_expunge(&msn, 2);
+  TEST_CHECK(imap_msn_highest(&msn) == 9);
+  TEST_CHECK(imap_msn_get(&msn, 2) == emails[3]);
+  imap_msn_expunge(&msn, 2);
+  TEST_CHECK(imap_msn_highest(&msn) == 8);
+  TEST_CHECK(imap_msn_get(&msn, 2) == emails[4]);
+  TEST_CHECK(imap_msn_get(&msn, 0) == emails[0]);
+  TEST_CHECK(imap_msn_get(&msn, 7) == emails[9]);
+  TEST_CHECK(imap_msn_get(&msn, 8) == NULL);
+
+  // Compaction renumbers the Emails above the holes
+  imap_msn_flush(&msn);
+  TEST_CHECK(imap_msn_highest(&msn) == 8);
+  TEST_CHECK(imap_msn_get(&msn, 2) == emails[4]);
+  TEST_CHECK(imap_edata_get(emails[4])->msn == 3);
+  TEST_CHECK(imap_edata_get(emails[9])->msn == 8);
+
+  // VANISHED punches by physical slot; the positions don't move mid-batch
+  imap_msn_punch(&msn, 0);
+  imap_msn_punch(&msn, 1);
+  TEST_CHECK(imap_msn_highest(&msn) == 6);
+  TEST_CHECK(imap_msn_peek(&msn, 2) == emails[4]);
+  TEST_CHECK(imap_msn_get(&msn, 0) == emails[4]);
+  imap_msn_flush(&msn);
+  TEST_CHECK(imap_edata_get(emails[4])->msn == 1);
+
+  // A plain remove leaves a live, empty slot
+  imap_msn_remove(&msn, 0);
+  TEST_CHECK(imap_msn_highest(&msn) == 6);
+  TEST_CHECK(imap_msn_get(&msn, 0) == NULL);
+
+  imap_msn_free(&msn);
+  for (size_t i = 0; i < 10; i++)
+    email_free(&emails[i]);
+}
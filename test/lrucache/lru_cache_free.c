@@ -0,0 +1,61 @@
+/**
+ * @file
+ * Test code for lru_cache_free()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+static int NumFreed = 0;
+
+static void free_evict(const char *key, void *data)
+{
+  NumFreed++;
+  FREE(&data);
+}
+
+void test_lru_cache_free(void)
+{
+  // void lru_cache_free(struct LruCache **ptr);
+
+  {
+    // All entries are evicted on free
+    NumFreed = 0;
+    struct LruCache *lc = lru_cache_new(8, 0, free_evict);
+
+    lru_cache_insert(lc, "one", mutt_str_dup("1"), 0);
+    lru_cache_insert(lc, "two", mutt_str_dup("2"), 0);
+    lru_cache_insert(lc, "three", mutt_str_dup("3"), 0);
+
+    lru_cache_free(&lc);
+    TEST_CHECK(lc == NULL);
+    TEST_CHECK(NumFreed == 3);
+  }
+
+  {
+    // Degenerate calls
+    lru_cache_free(NULL);
+    struct LruCache *lc = NULL;
+    lru_cache_free(&lc);
+  }
+}
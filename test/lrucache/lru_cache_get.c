@@ -0,0 +1,60 @@
+/**
+ * @file
+ * Test code for lru_cache_get()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_lru_cache_get(void)
+{
+  // void *lru_cache_get(struct LruCache *lc, const char *key);
+
+  {
+    struct LruCache *lc = lru_cache_new(8, 0, NULL);
+
+    TEST_CHECK(lru_cache_get(lc, "missing") == NULL);
+
+    lru_cache_insert(lc, "apple", "fruit", 0);
+    lru_cache_insert(lc, "carrot", "vegetable", 0);
+
+    TEST_CHECK_STR_EQ(lru_cache_get(lc, "apple"), "fruit");
+    TEST_CHECK_STR_EQ(lru_cache_get(lc, "carrot"), "vegetable");
+    TEST_CHECK(lru_cache_get(lc, "banana") == NULL);
+
+    // A hit refreshes the entry, repeatedly
+    for (int i = 0; i < 10; i++)
+      TEST_CHECK(lru_cache_get(lc, "apple") != NULL);
+
+    lru_cache_free(&lc);
+  }
+
+  {
+    // Degenerate calls
+    TEST_CHECK(lru_cache_get(NULL, "key") == NULL);
+    struct LruCache *lc = lru_cache_new(8, 0, NULL);
+    TEST_CHECK(lru_cache_get(lc, NULL) == NULL);
+    lru_cache_free(&lc);
+  }
+}
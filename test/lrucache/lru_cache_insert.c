@@ -0,0 +1,109 @@
+/**
+ * @file
+ * Test code for lru_cache_insert()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+static int NumEvicted = 0;
+static char LastKey[32];
+
+static void count_evict(const char *key, void *data)
+{
+  NumEvicted++;
+  mutt_str_copy(LastKey, key, sizeof(LastKey));
+}
+
+void test_lru_cache_insert(void)
+{
+  // void lru_cache_insert(struct LruCache *lc, const char *key, void *data, size_t size);
+
+  {
+    // Count-bounded eviction, oldest first
+    NumEvicted = 0;
+    struct LruCache *lc = lru_cache_new(3, 0, count_evict);
+
+    lru_cache_insert(lc, "one", "1", 0);
+    lru_cache_insert(lc, "two", "2", 0);
+    lru_cache_insert(lc, "three", "3", 0);
+    TEST_CHECK(lru_cache_count(lc) == 3);
+    TEST_CHECK(NumEvicted == 0);
+
+    lru_cache_insert(lc, "four", "4", 0);
+    TEST_CHECK(lru_cache_count(lc) == 3);
+    TEST_CHECK(NumEvicted == 1);
+    TEST_CHECK_STR_EQ(LastKey, "one");
+    TEST_CHECK(lru_cache_get(lc, "one") == NULL);
+    TEST_CHECK(lru_cache_get(lc, "two") != NULL);
+
+    // "two" is now the most recently used, so "three" goes next
+    lru_cache_insert(lc, "five", "5", 0);
+    TEST_CHECK(NumEvicted == 2);
+    TEST_CHECK_STR_EQ(LastKey, "three");
+
+    lru_cache_free(&lc);
+    TEST_CHECK(NumEvicted == 5);
+  }
+
+  {
+    // Size-bounded eviction
+    NumEvicted = 0;
+    struct LruCache *lc = lru_cache_new(0, 100, count_evict);
+
+    lru_cache_insert(lc, "one", "1", 40);
+    lru_cache_insert(lc, "two", "2", 40);
+    TEST_CHECK(NumEvicted == 0);
+
+    lru_cache_insert(lc, "three", "3", 40);
+    TEST_CHECK(NumEvicted == 1);
+    TEST_CHECK_STR_EQ(LastKey, "one");
+    TEST_CHECK(lru_cache_count(lc) == 2);
+
+    lru_cache_free(&lc);
+  }
+
+  {
+    // Replacing a key evicts the old data
+    NumEvicted = 0;
+    struct LruCache *lc = lru_cache_new(3, 0, count_evict);
+
+    lru_cache_insert(lc, "one", "1", 0);
+    lru_cache_insert(lc, "one", "uno", 0);
+    TEST_CHECK(NumEvicted == 1);
+    TEST_CHECK(lru_cache_count(lc) == 1);
+    TEST_CHECK_STR_EQ(lru_cache_get(lc, "one"), "uno");
+
+    lru_cache_free(&lc);
+  }
+
+  {
+    // Degenerate calls
+    lru_cache_insert(NULL, "key", NULL, 0);
+    struct LruCache *lc = lru_cache_new(3, 0, NULL);
+    lru_cache_insert(lc, NULL, NULL, 0);
+    TEST_CHECK(lru_cache_count(lc) == 0);
+    lru_cache_free(&lc);
+  }
+}
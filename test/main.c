@@ -95,12 +95,18 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_b64_decode)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_b64_encode)                                      \
                                                                                \
+  /* bench */                                                                  \
+  NEOMUTT_TEST_ITEM(bench_pattern_exec)                                        \
+  NEOMUTT_TEST_ITEM(bench_rfc822_read_header)                                  \
+  NEOMUTT_TEST_ITEM(bench_serialize_envelope)                                  \
+                                                                               \
   /* body */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_body_cmp_strict)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_body_free)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_body_new)                                        \
                                                                                \
   /* buffer */                                                                 \
+  NEOMUTT_TEST_ITEM(test_buf_addbuf)                                           \
   NEOMUTT_TEST_ITEM(test_buf_addch)                                            \
   NEOMUTT_TEST_ITEM(test_buf_addstr)                                           \
   NEOMUTT_TEST_ITEM(test_buf_addstr_n)                                         \
@@ -125,6 +131,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_buf_join_str)                                         \
   NEOMUTT_TEST_ITEM(test_buf_len)                                              \
   NEOMUTT_TEST_ITEM(test_buf_lower)                                            \
+  NEOMUTT_TEST_ITEM(test_buf_move)                                             \
   NEOMUTT_TEST_ITEM(test_buf_new)                                              \
   NEOMUTT_TEST_ITEM(test_buf_pool_cleanup)                                     \
   NEOMUTT_TEST_ITEM(test_buf_pool_get)                                         \
@@ -139,6 +146,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_buf_strdup)                                           \
   NEOMUTT_TEST_ITEM(test_buf_str_equal)                                        \
   NEOMUTT_TEST_ITEM(test_buf_substrcpy)                                        \
+  NEOMUTT_TEST_ITEM(test_buf_take_string)                                      \
                                                                                \
   /* charset */                                                                \
   NEOMUTT_TEST_ITEM(test_mutt_ch_canonical_charset)                            \
@@ -214,6 +222,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_dispatcher_get_retval_name)                           \
   NEOMUTT_TEST_ITEM(test_mutt_file_mkstemp_full)                               \
                                                                                \
+  /* crc32c */                                                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_crc32c)                                          \
+                                                                               \
   /* date */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_date_add_timeout)                                \
   NEOMUTT_TEST_ITEM(test_mutt_date_check_month)                                \
@@ -424,6 +435,7 @@ void test_fini(void);
                                                                                \
   /* imap */                                                                   \
   NEOMUTT_TEST_ITEM(test_imap_msg_set)                                         \
+  NEOMUTT_TEST_ITEM(test_imap_msn)                                             \
                                                                                \
   /* list */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_list_clear)                                      \
@@ -455,6 +467,11 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_log_queue_save)                                       \
   NEOMUTT_TEST_ITEM(test_log_queue_set_max_size)                               \
                                                                                \
+  /* lrucache */                                                               \
+  NEOMUTT_TEST_ITEM(test_lru_cache_free)                                       \
+  NEOMUTT_TEST_ITEM(test_lru_cache_get)                                        \
+  NEOMUTT_TEST_ITEM(test_lru_cache_insert)                                     \
+                                                                               \
   /* mailbox */                                                                \
   NEOMUTT_TEST_ITEM(test_mailbox_changed)                                      \
   NEOMUTT_TEST_ITEM(test_mailbox_find)                                         \
@@ -473,6 +490,7 @@ void test_fini(void);
                                                                                \
   /* mbyte */                                                                  \
   NEOMUTT_TEST_ITEM(test_buf_mb_wcstombs)                                      \
+  NEOMUTT_TEST_ITEM(test_mutt_mb_ascii_run)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_mb_charlen)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_mb_filter_unprintable)                           \
   NEOMUTT_TEST_ITEM(test_mutt_mb_get_initials)                                 \
@@ -560,9 +578,14 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_path_tilde)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_path_to_absolute)                                \
                                                                                \
+  /* perf */                                                                   \
+  NEOMUTT_TEST_ITEM(test_perf_count)                                           \
+  NEOMUTT_TEST_ITEM(test_perf_report)                                          \
+                                                                               \
   /* pattern */                                                                \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_comp)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_leak)                                    \
+  NEOMUTT_TEST_ITEM(test_pattern_trigram)                                      \
                                                                                \
   /* prex */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_prex_capture)                                    \
@@ -612,6 +635,11 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_sig_unblock)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_sig_unblock_system)                              \
                                                                                \
+  /* slab */                                                                   \
+  NEOMUTT_TEST_ITEM(test_slab_alloc)                                           \
+  NEOMUTT_TEST_ITEM(test_slab_cleanup)                                         \
+  NEOMUTT_TEST_ITEM(test_slab_free)                                            \
+                                                                               \
   /* slist */                                                                  \
   NEOMUTT_TEST_ITEM(test_slist_add_string)                                     \
   NEOMUTT_TEST_ITEM(test_slist_dup)                                            \
@@ -682,6 +710,10 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_break_thread)                                    \
   NEOMUTT_TEST_ITEM(test_unlink_message)                                       \
                                                                                \
+  /* tpool */                                                                  \
+  NEOMUTT_TEST_ITEM(test_tpool_new)                                            \
+  NEOMUTT_TEST_ITEM(test_tpool_submit)                                         \
+                                                                               \
   /* url */                                                                    \
   NEOMUTT_TEST_ITEM(test_url_check_scheme)                                     \
   NEOMUTT_TEST_ITEM(test_url_free)                                             \
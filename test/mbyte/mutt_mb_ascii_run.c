@@ -0,0 +1,82 @@
+/**
+ * @file
+ * Test code for mutt_mb_ascii_run()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+void test_mutt_mb_ascii_run(void)
+{
+  // size_t mutt_mb_ascii_run(const char *s, size_t n);
+
+  {
+    TEST_CHECK(mutt_mb_ascii_run("", 0) == 0);
+  }
+
+  {
+    // Short, pure-ASCII string, below the word-at-a-time threshold
+    TEST_CHECK(mutt_mb_ascii_run("apple", 5) == 5);
+  }
+
+  {
+    // Long, pure-ASCII string, exercising the word-at-a-time loop
+    const char *str = "The quick brown fox jumps over the lazy dog";
+    TEST_CHECK(mutt_mb_ascii_run(str, strlen(str)) == strlen(str));
+  }
+
+  {
+    // The run stops at a control character
+    TEST_CHECK(mutt_mb_ascii_run("apple\tbanana", 12) == 5);
+    TEST_CHECK(mutt_mb_ascii_run("apple\nbanana", 12) == 5);
+    TEST_CHECK(mutt_mb_ascii_run("\tapple", 6) == 0);
+  }
+
+  {
+    // The run stops at DEL
+    TEST_CHECK(mutt_mb_ascii_run("apple\x7f" "banana", 12) == 5);
+  }
+
+  {
+    // The run stops at the first non-ASCII byte
+    TEST_CHECK(mutt_mb_ascii_run("apple\303\251e", 8) == 5);
+    TEST_CHECK(mutt_mb_ascii_run("\303\251", 2) == 0);
+  }
+
+  {
+    // The non-ASCII byte is found wherever it falls within a word
+    const char buf[] = "abcdefghijklmnop";
+    for (size_t i = 0; i < sizeof(buf) - 1; i++)
+    {
+      char tmp[sizeof(buf)];
+      memcpy(tmp, buf, sizeof(buf));
+      tmp[i] = '\200';
+      TEST_CHECK(mutt_mb_ascii_run(tmp, sizeof(tmp) - 1) == i);
+    }
+  }
+
+  {
+    // The length limit is respected
+    TEST_CHECK(mutt_mb_ascii_run("apple banana", 5) == 5);
+  }
+}
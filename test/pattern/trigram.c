@@ -0,0 +1,84 @@
+/**
+ * @file
+ * Test code for the trigram prefilter
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdint.h>
+#include <string.h>
+#include "pattern/trigram.h"
+
+void test_pattern_trigram(void)
+{
+  uint32_t tris[TRIGRAM_QUERY_MAX] = { 0 };
+
+  // Plain strings require all their trigrams
+  TEST_CHECK(trigram_extract("hello", false, tris, TRIGRAM_QUERY_MAX) == 3);
+  TEST_CHECK(trigram_extract("abc", false, tris, TRIGRAM_QUERY_MAX) == 1);
+
+  // Too short to prefilter
+  TEST_CHECK(trigram_extract("ab", false, tris, TRIGRAM_QUERY_MAX) == 0);
+  TEST_CHECK(trigram_extract("", false, tris, TRIGRAM_QUERY_MAX) == 0);
+  TEST_CHECK(trigram_extract(NULL, false, tris, TRIGRAM_QUERY_MAX) == 0);
+
+  // Regexes: the longest required literal is used
+  TEST_CHECK(trigram_extract("foo.*barbaz", true, tris, TRIGRAM_QUERY_MAX) == 4);
+  TEST_CHECK(trigram_extract("^deadline", true, tris, TRIGRAM_QUERY_MAX) == 6);
+
+  // A quantifier makes the preceding character optional
+  TEST_CHECK(trigram_extract("abcd?", true, tris, TRIGRAM_QUERY_MAX) == 1);
+  TEST_CHECK(trigram_extract("abc?", true, tris, TRIGRAM_QUERY_MAX) == 0);
+
+  // Alternation means no literal is required
+  TEST_CHECK(trigram_extract("foobar|bazqux", true, tris, TRIGRAM_QUERY_MAX) == 0);
+
+  // An escape might be a character class, so it ends the literal
+  TEST_CHECK(trigram_extract("abc\\wdef", true, tris, TRIGRAM_QUERY_MAX) == 1);
+
+  // Signatures match the trigrams of the text they were built from
+  struct TrigramStream ts;
+  trigram_stream_init(&ts);
+  const char *text = "The quick brown fox jumps over the lazy dog";
+  trigram_stream_add(&ts, text, strlen(text));
+
+  int num = trigram_extract("quick brown", false, tris, TRIGRAM_QUERY_MAX);
+  TEST_CHECK(num > 0);
+  TEST_CHECK(trigram_sig_match(ts.sig, tris, num));
+
+  // Matching is case-insensitive
+  num = trigram_extract("LAZY DOG", false, tris, TRIGRAM_QUERY_MAX);
+  TEST_CHECK(num > 0);
+  TEST_CHECK(trigram_sig_match(ts.sig, tris, num));
+
+  // Absent literals are rejected
+  num = trigram_extract("zebra", false, tris, TRIGRAM_QUERY_MAX);
+  TEST_CHECK(num > 0);
+  TEST_CHECK(!trigram_sig_match(ts.sig, tris, num));
+
+  // Trigrams straddling a chunk boundary aren't lost
+  trigram_stream_init(&ts);
+  trigram_stream_add(&ts, "boun", 4);
+  trigram_stream_add(&ts, "dary", 4);
+  num = trigram_extract("boundary", false, tris, TRIGRAM_QUERY_MAX);
+  TEST_CHECK(num > 0);
+  TEST_CHECK(trigram_sig_match(ts.sig, tris, num));
+}
@@ -0,0 +1,47 @@
+/**
+ * @file
+ * Test code for perf_count()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_perf_count(void)
+{
+  // void perf_count(enum PerfCounter pc, uint64_t amount);
+  // void perf_time(enum PerfCounter pc, uint64_t start);
+
+  {
+    perf_count(PERF_NET_READ, 42);
+    perf_count(PERF_NET_READ, 0);
+    TEST_CHECK_(1, "perf_count(PERF_NET_READ, 42)");
+  }
+
+  {
+    const uint64_t t1 = perf_clock();
+    const uint64_t t2 = perf_clock();
+    TEST_CHECK(t2 >= t1); // clock is monotonic
+
+    perf_time(PERF_MBOX_OPEN, t1);
+    TEST_CHECK_(1, "perf_time(PERF_MBOX_OPEN, t1)");
+  }
+}
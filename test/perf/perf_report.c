@@ -0,0 +1,49 @@
+/**
+ * @file
+ * Test code for perf_report()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdio.h>
+#include "mutt/lib.h"
+
+void test_perf_report(void)
+{
+  // void perf_report(FILE *fp);
+
+  {
+    perf_report(NULL);
+    TEST_CHECK_(1, "perf_report(NULL)");
+  }
+
+  {
+    perf_count(PERF_HCACHE_HIT, 0);
+    perf_count(PERF_NET_WRITE, 123);
+
+    FILE *fp = tmpfile();
+    if (!fp)
+      return;
+    perf_report(fp);
+    TEST_CHECK(ftell(fp) > 0); // something was written
+    fclose(fp);
+  }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file
+ * Test code for slab_alloc()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+struct SlabTestObj
+{
+  void *ptr;
+  int num;
+};
+
+void test_slab_alloc(void)
+{
+  // void *slab_alloc(struct Slab *slab);
+
+  {
+    static struct Slab slab = SLAB_INITIALIZER(struct SlabTestObj);
+
+    // Allocate more objects than fit in one block
+    struct SlabTestObj *objs[1000] = { 0 };
+    for (size_t i = 0; i < mutt_array_size(objs); i++)
+    {
+      objs[i] = slab_alloc(&slab);
+      TEST_CHECK(objs[i] != NULL);
+      TEST_CHECK(objs[i]->ptr == NULL); // objects are zeroed
+      TEST_CHECK(objs[i]->num == 0);
+      objs[i]->num = i;
+    }
+
+    // The objects mustn't overlap
+    for (size_t i = 0; i < mutt_array_size(objs); i++)
+      TEST_CHECK(objs[i]->num == (int) i);
+
+    for (size_t i = 0; i < mutt_array_size(objs); i++)
+      slab_free(&slab, (void **) &objs[i]);
+    slab_cleanup();
+  }
+}
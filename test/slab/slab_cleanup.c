@@ -0,0 +1,55 @@
+/**
+ * @file
+ * Test code for slab_cleanup()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+struct SlabTestObj3
+{
+  void *ptr;
+  int num;
+};
+
+void test_slab_cleanup(void)
+{
+  // void slab_cleanup(void);
+
+  {
+    slab_cleanup(); // no Slabs in use
+
+    static struct Slab slab = SLAB_INITIALIZER(struct SlabTestObj3);
+
+    struct SlabTestObj3 *obj = slab_alloc(&slab);
+    TEST_CHECK(obj != NULL);
+    slab_free(&slab, (void **) &obj);
+    slab_cleanup();
+
+    // The Slab is usable again afterwards
+    obj = slab_alloc(&slab);
+    TEST_CHECK(obj != NULL);
+    slab_free(&slab, (void **) &obj);
+    slab_cleanup();
+  }
+}
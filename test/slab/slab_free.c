@@ -0,0 +1,64 @@
+/**
+ * @file
+ * Test code for slab_free()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+struct SlabTestObj2
+{
+  void *ptr;
+  int num;
+};
+
+void test_slab_free(void)
+{
+  // void slab_free(struct Slab *slab, void **ptr);
+
+  {
+    static struct Slab slab = SLAB_INITIALIZER(struct SlabTestObj2);
+
+    slab_free(NULL, NULL);
+
+    void *ptr = NULL;
+    slab_free(&slab, NULL);
+    slab_free(&slab, &ptr);
+
+    struct SlabTestObj2 *obj = slab_alloc(&slab);
+    TEST_CHECK(obj != NULL);
+    slab_free(&slab, (void **) &obj);
+    TEST_CHECK(obj == NULL);
+
+    // A released object is recycled by the next alloc
+    struct SlabTestObj2 *obj2 = slab_alloc(&slab);
+    struct SlabTestObj2 *obj3 = slab_alloc(&slab);
+    TEST_CHECK(obj2 != NULL);
+    TEST_CHECK(obj3 != NULL);
+    TEST_CHECK(obj2 != obj3);
+
+    slab_free(&slab, (void **) &obj2);
+    slab_free(&slab, (void **) &obj3);
+    slab_cleanup();
+  }
+}
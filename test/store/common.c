@@ -70,6 +70,9 @@ bool test_store_degenerate(const struct StoreOps *store_ops, const char *name)
   if (!TEST_CHECK(store_ops->delete_record(NULL, NULL, 0) != 0))
     return false;
 
+  if (!TEST_CHECK(store_ops->delete_batch(NULL, NULL, NULL, 0) != 0))
+    return false;
+
   store_ops->close(NULL);
   TEST_CHECK_(1, "store_ops->close(NULL)");
 
@@ -110,5 +113,27 @@ bool test_store_db(const struct StoreOps *store_ops, StoreHandle *store_handle)
   if (!TEST_CHECK(rc == 0))
     return false;
 
+  const char *keys[] = { "two", "three" };
+  size_t klens[] = { 3, 5 };
+
+  for (size_t i = 0; i < mutt_array_size(keys); i++)
+  {
+    rc = store_ops->store(store_handle, keys[i], klens[i], value, strlen(value));
+    if (!TEST_CHECK(rc == 0))
+      return false;
+  }
+
+  rc = store_ops->delete_batch(store_handle, keys, klens, mutt_array_size(keys));
+  if (!TEST_CHECK(rc == 0))
+    return false;
+
+  for (size_t i = 0; i < mutt_array_size(keys); i++)
+  {
+    vlen = 0;
+    data = store_ops->fetch(store_handle, keys[i], klens[i], &vlen);
+    if (!TEST_CHECK(data == NULL))
+      return false;
+  }
+
   return true;
 }
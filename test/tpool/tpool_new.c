@@ -0,0 +1,59 @@
+/**
+ * @file
+ * Test code for tpool_new()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+void test_tpool_new(void)
+{
+  // struct ThreadPool *tpool_new(int num_workers);
+  // void tpool_free(struct ThreadPool **ptr);
+
+  {
+    tpool_free(NULL);
+
+    struct ThreadPool *tp = NULL;
+    tpool_free(&tp);
+  }
+
+  {
+    struct ThreadPool *tp = tpool_new(2);
+    TEST_CHECK(tp != NULL);
+    TEST_CHECK(tpool_notify(tp) != NULL);
+    tpool_free(&tp);
+    TEST_CHECK(tp == NULL);
+  }
+
+  {
+    // Automatic worker count
+    struct ThreadPool *tp = tpool_new(0);
+    TEST_CHECK(tp != NULL);
+    tpool_free(&tp);
+  }
+
+  {
+    TEST_CHECK(tpool_notify(NULL) == NULL);
+  }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * Test code for tpool_submit()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <pthread.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+
+#define NUM_TASKS 100
+
+static pthread_mutex_t WorkMutex = PTHREAD_MUTEX_INITIALIZER;
+static int WorkCount = 0;     ///< Incremented by the work functions (workers)
+static int DoneCount = 0;     ///< Incremented by the done functions (drainer)
+static int ObserverCount = 0; ///< Incremented by the observer (drainer)
+
+static void task_work(void *wdata)
+{
+  pthread_mutex_lock(&WorkMutex);
+  WorkCount++;
+  pthread_mutex_unlock(&WorkMutex);
+
+  int *num = wdata;
+  *num += 1;
+}
+
+static void task_done(void *wdata)
+{
+  DoneCount++;
+}
+
+static int task_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_TPOOL)
+    return 0;
+
+  struct EventTPool *ev_t = nc->event_data;
+  if (ev_t->wdata)
+    ObserverCount++;
+
+  return 0;
+}
+
+void test_tpool_submit(void)
+{
+  // bool tpool_submit(struct ThreadPool *tp, tpool_work_t work, tpool_done_t done, void *wdata);
+  // void tpool_wait(struct ThreadPool *tp);
+  // int tpool_drain(struct ThreadPool *tp);
+
+  {
+    TEST_CHECK(!tpool_submit(NULL, task_work, NULL, NULL));
+    TEST_CHECK(tpool_drain(NULL) == 0);
+    tpool_wait(NULL);
+  }
+
+  {
+    struct ThreadPool *tp = tpool_new(4);
+    TEST_CHECK(tp != NULL);
+
+    TEST_CHECK(!tpool_submit(tp, NULL, NULL, NULL)); // work is mandatory
+
+    notify_observer_add(tpool_notify(tp), NT_TPOOL, task_observer, NULL);
+
+    int nums[NUM_TASKS] = { 0 };
+    for (int i = 0; i < NUM_TASKS; i++)
+      TEST_CHECK(tpool_submit(tp, task_work, task_done, &nums[i]));
+
+    tpool_wait(tp);
+    TEST_CHECK(WorkCount == NUM_TASKS);
+
+    // Every task ran exactly once, with its own data
+    for (int i = 0; i < NUM_TASKS; i++)
+      TEST_CHECK(nums[i] == 1);
+
+    // Completions only run when drained
+    TEST_CHECK(DoneCount == 0);
+    TEST_CHECK(tpool_drain(tp) == NUM_TASKS);
+    TEST_CHECK(DoneCount == NUM_TASKS);
+    TEST_CHECK(ObserverCount == NUM_TASKS);
+    TEST_CHECK(tpool_drain(tp) == 0); // nothing left
+
+    notify_observer_remove(tpool_notify(tp), task_observer, NULL);
+    tpool_free(&tp);
+  }
+
+  {
+    // Freeing the pool finishes and drains outstanding tasks
+    struct ThreadPool *tp = tpool_new(2);
+    TEST_CHECK(tp != NULL);
+
+    WorkCount = 0;
+    DoneCount = 0;
+    int nums[NUM_TASKS] = { 0 };
+    for (int i = 0; i < NUM_TASKS; i++)
+      TEST_CHECK(tpool_submit(tp, task_work, task_done, &nums[i]));
+
+    tpool_free(&tp);
+    TEST_CHECK(WorkCount == NUM_TASKS);
+    TEST_CHECK(DoneCount == NUM_TASKS);
+  }
+}